@@ -145,8 +145,7 @@ int             main(int argc, char **argv)
 	}
 	break;
       case 'n':
-	if((sscanf(optarg, "%d", &n) != 1) || (n < 4) ||
-	   (AlgBitIsPowerOfTwo(n) == 0))
+	if((sscanf(optarg, "%d", &n) != 1) || (n < 4))
 	{
 	  usage = 1;
 	}
@@ -167,6 +166,10 @@ int             main(int argc, char **argv)
 	break;
     }
   }
+  if((usage == 0) && realFlg && (d > 1) && ((n & 1) != 0))
+  {
+    usage = 1;
+  }
   ok = !usage;
   /* Allocate array(s) and set values. */
   if(ok)
@@ -434,7 +437,7 @@ int             main(int argc, char **argv)
     "  -T  Print execution times (value %s).\n"
     "  -Y  Use slightly asymetric data values (value %s).\n"
     "  -d  Number of dimensions (value %d).\n"
-    "  -n  Size of array, must be power or two (value %d)\n"
+    "  -n  Size of array, must be even for real transforms (value %d)\n"
     "  -z  Value any value less than the absolute value of this is\n"
     "      considered zero in output (value %lg)\n",
     *argv,
@@ -52,8 +52,8 @@ WlzBasisFnTransformObj - computes and applies Woolz basis function transforms.
 WlzBasisFnTransformObj [-o<out object>] [-p<tie points file>]
 		       [-m<min mesh dist>] [-M<max mesh dist>]
 		       [-b<basis fn transform>] [-Y<order of polynomial>]
-		       [-D<flags>] [-P<param>]
-		       [-d] [-g] [-h] [-q] [-Q] [-s] [-t] [-y]
+		       [-D<flags>] [-P<param>] [-e<tolerance>]
+		       [-d] [-g] [-h] [-k] [-q] [-Q] [-s] [-t] [-y]
 		       [-B] [-C] [-E] [-G] [-L] [-N] [-R] [-S] [-T]
 		       [<in object>]
 \endverbatim
@@ -88,6 +88,15 @@ WlzBasisFnTransformObj [-o<out object>] [-p<tie points file>]
     <td><b>-E</b></td>
     <td>Output evaluation times to stderr.</td>
   </tr>
+  <tr> 
+    <td><b>-e</b></td>
+    <td>Absolute error tolerance for the basis function values at the
+        mesh nodes. If greater than zero (the default is zero) the
+	contributions of clusters of distant control points are
+	approximated, which is much faster when there are many tie
+	points. Only used for Gaussian, multi-quadric, inverse
+	multi-quadric and thin plate spline basis functions.</td>
+  </tr>
   <tr> 
     <td><b>-G</b></td>
     <td>Gradient mesh generation method.</td>
@@ -145,6 +154,14 @@ WlzBasisFnTransformObj [-o<out object>] [-p<tie points file>]
     <td><b>-h</b></td>
     <td>Help, prints usage message.</td>
   </tr>
+  <tr> 
+    <td><b>-k</b></td>
+    <td>Use compactly supported basis function if tie points are given.
+        The design equations of this basis function are sparse and are
+	solved iteratively, so it may be used with very many tie points.
+	The basis function parameter is the radius of support relative
+	to the extent of the tie points (default 0.1).</td>
+  </tr>
   <tr> 
     <td><b>-P</b></td>
     <td>Basis function parameter (eg MQ delta value).</td>
@@ -291,7 +308,8 @@ int             main(int argc, char **argv)
 		usage = 0;
   double	basisFnParam = 0.001,
   		meshMinDist = 20.0,
-  		meshMaxDist = 40.0;
+  		meshMaxDist = 40.0,
+		evalTol = 0.0;
   WlzVertexP	vxA0,
   		vxA1;
   WlzObject	*inObj = NULL,
@@ -314,7 +332,7 @@ int             main(int argc, char **argv)
   struct timeval times[6];
   const int	delOut = 1;
   const char    *errMsg;
-  static char	optList[] = "b:m:o:p:t:D:M:P:Y:cdghqsyBCEGLNQRSTU",
+  static char	optList[] = "b:e:m:o:p:t:D:M:P:Y:cdghkqsyBCEGLNQRSTU",
   		inObjFileStrDef[] = "-",
 		outObjFileStrDef[] = "-";
 
@@ -348,6 +366,12 @@ int             main(int argc, char **argv)
 	  usage = 1;
 	}
 	break;
+      case 'e':
+        if((sscanf(optarg, "%lg", &evalTol) != 1) || (evalTol < 0.0))
+	{
+	  usage = 1;
+	}
+	break;
       case 'E':
         timer = 1;
 	break;
@@ -360,6 +384,9 @@ int             main(int argc, char **argv)
       case 'g':
         basisFnType = WLZ_FN_BASIS_2DGAUSS;
 	break;
+      case 'k':
+        basisFnType = WLZ_FN_BASIS_2DCS;
+	break;
       case 'G':
         meshGenMth = WLZ_MESH_GENMETHOD_GRADIENT;
 	break;
@@ -672,6 +699,9 @@ int             main(int argc, char **argv)
         case WLZ_FN_BASIS_2DMQ:
           basisFnType = WLZ_FN_BASIS_3DMQ;
 	  break;
+        case WLZ_FN_BASIS_2DCS:
+          basisFnType = WLZ_FN_BASIS_3DCS;
+	  break;
         default:
 	  errNum = WLZ_ERR_DOMAIN_TYPE;
 	  ok = 0;
@@ -769,6 +799,10 @@ int             main(int argc, char **argv)
     }
     gettimeofday(times + 1, NULL);
   }
+  if(ok && (basisTr != NULL))
+  {
+    basisTr->basisFn->evalTol = evalTol;
+  }
   if(ok)
   {
     if(outBasisTrFlag)
@@ -939,8 +973,8 @@ int             main(int argc, char **argv)
     " [-o<out object>] [-p<tie points file>]\n"
     "                  [-m<min mesh dist>] [-M<max mesh dist>]\n"
     "                  [-b<basis fn transform>] [-Y<order of polynomial>]\n"
-    "                  [-D<flags>] [-P<param>]\n"
-    "                  [-d] [-g] [-h] [-q] [-s] [-t] [-y]\n"
+    "                  [-D<flags>] [-P<param>] [-e<tolerance>]\n"
+    "                  [-d] [-g] [-h] [-k] [-q] [-s] [-t] [-y]\n"
     "                  [-B] [-C] [-E] [-G] [-L] [-N] [-Q] [-R] [-S] [-T]\n"
     "                  [<in object>]\n"
     "Version: ",
@@ -957,6 +991,9 @@ int             main(int argc, char **argv)
     "      These debug flags are only intended for use when debuging and\n"
     "      they may be combined by an or operation (eg 11 = 1 | 2 | 8).\n"
     "  -E  Output evaluation times to stderr.\n"
+    "  -e  Absolute error tolerance for the basis function values at the\n"
+    "      mesh nodes, if greater than zero clusters of distant tie points\n"
+    "      are approximated (default 0.0).\n"
     "  -G  Gradient mesh generation method (default).\n"
     "  -L  Use linear interpolation instead of nearest neighbour.\n"
     "  -m  Minimum mesh node separation distance (default 10.0)\n"
@@ -974,6 +1011,8 @@ int             main(int argc, char **argv)
     "      only (ie no least squares affine).\n"
     "  -g  Use Gaussian basis function if tie points are given.\n"
     "  -h  Help, prints this usage message.\n"
+    "  -k  Use compactly supported basis function if tie points are given,\n"
+    "      for which the parameter is the relative radius of support.\n"
     "  -q  Use multi-quadric basis function if tie points are given.\n"
     "  -P  Basis function parameter (eg MQ delta value).\n"
     "  -Q  Use inverse-multi-quadric basis function if tie points are given.\n"
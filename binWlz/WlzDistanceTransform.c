@@ -70,7 +70,7 @@ WlzDistanceTransform [-b] [-d#] [-D#] [-f#] [-p#] [-o#] [-h]
     <td><b>-d</b></td>
     <td>Distance function:
       <table width="500" border="0">
-      <tr> <td>0</td> <td>Euclidean (2D and 3D, unimplemented)</td></tr>
+      <tr> <td>0</td> <td>Euclidean (2D and 3D)</td></tr>
       <tr> <td>1</td> <td>octagonal (2D and 3D) - default</td></tr>
       <tr> <td>2</td> <td>approximate Euclidean (2D and 3D)</td></tr>
       <tr> <td>4</td> <td>4-connected (2D)</td></tr>
@@ -362,7 +362,7 @@ int		main(int argc, char *argv[])
     "Options:\n"
     "  -b  Use the boundary of the reference object.\n"
     "  -d  Distance function:\n"
-    "              0: Euclidean (2D and 3D, unimplemented)\n"
+    "              0: Euclidean (2D and 3D)\n"
     "              1: octagonal (2D and 3D) - default\n"
     "              2: approximate Euclidean (2D and 3D)\n"
     "              4: 4-connected (2D)\n"
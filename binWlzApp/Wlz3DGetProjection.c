@@ -53,7 +53,8 @@ Wlz3DGetProjection - projects a Woolz object using a view transform.
 Wlz3DGetProjection [-h]
                    [-a <pitch,yaw[,roll]>] [-b <parameter bibfile>]
 		   [-d <dist>] [-f <fx,fy,fz>] [-i <int mod>]
-		   [-m <mode>] [-o <output file>] [-r <vox rescale>]
+		   [-m <mode>] [-o <output file>] [-p <ray mode>]
+		   [-r <vox rescale>]
 		   [-s <scale>] [-u<ux,uy,uz>] [-D <den>] [-V <val lut>]
 		   [<3D object input file>]
 \endverbatim
@@ -93,6 +94,20 @@ Wlz3DGetProjection [-h]
     </table>
     </td>
   </tr>
+  <tr>
+    <td><b>-p</b></td>
+    <td>Ray cast projection mode, if given the projection is computed
+        by casting rays through the object and the integration mode,
+	domain density and value look up table are ignored.
+	Possible values:
+    <table width="500" border="0">
+    <tr> <td>x</td><td>maximum</td><td>maximum value along each ray</td> </tr>
+    <tr> <td>n</td><td>minimum</td><td>minimum value along each ray</td> </tr>
+    <tr> <td>m</td><td>mean</td><td>mean value along each ray</td> </tr>
+    <tr> <td>s</td><td>sum</td><td>sum of values along each ray</td> </tr>
+    </table>
+    </td>
+  </tr>
   <tr>
     <td><b>-r</b></td>
     <td>Voxel size rescaling mode flags:
@@ -149,6 +164,7 @@ writing the 2D object to standard output.
 \par See Also
 \ref BinWlzApp "WlzIntro(1)"
 \ref WlzProjectObjToPlane "WlzProjectObjToPlane(3)"
+\ref WlzProjectObjRays "WlzProjectObjRays(3)"
 */
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -174,7 +190,7 @@ static void ShowUsage(char *proc_str)
   (void )fprintf(stderr,
   "Usage:\t%s [-a <pitch,yaw[,roll]>] [-f <fx,fy,fz>] [-d <dist>]\n"
   "\t[-b <parameter bibfile>] [-m <mode>] [-s <scale>]\n"
-  "\t[-o <output file>] [-u<ux,uy,uz>] [-r<vox rescale>]\n"
+  "\t[-o <output file>] [-p <ray mode>] [-u<ux,uy,uz>] [-r<vox rescale>]\n"
   "\t[-i<int mod> [-D <den>] [-V <val lut>] [-t<depth>] [-h]\n"
   "\t[<3D object input file>]\n"
   "\tGet an arbitrary sliceprojection from a 3D object\n"
@@ -193,6 +209,13 @@ static void ShowUsage(char *proc_str)
       "\t                       mode = 1 - statue\n"
       "\t                       mode = 2 - absolute\n"
       "\t  -o<output file>    Output filename, default to stdout\n"
+      "\t  -p<ray mode>       Ray cast projection mode, if given the\n"
+      "\t                     integration mode, density and look up\n"
+      "\t                     table are ignored, possible values:\n"
+      "\t                       mode = x - maximum value along rays\n"
+      "\t                       mode = n - minimum value along rays\n"
+      "\t                       mode = m - mean value along rays\n"
+      "\t                       mode = s - sum of values along rays\n"
       "\t  -r<vox rescale>    Voxel size rescaling mode flags:\n"
       "\t                       bit 1 set - use voxel-size rescaling\n"
       "\t                       bit 2 set - enable global scaling\n"
@@ -222,16 +245,18 @@ int main(int	argc,
 
   int		tI,
   		usage = 0,
+		rayFlg = 0,
 		voxRescale = 0;
   WlzObject	*obj = NULL, *nobj = NULL;
   WlzProjectIntMode intMod = WLZ_PROJECT_INT_MODE_DOMAIN;
+  WlzProjectRayMode rayMod = WLZ_PROJECT_RAY_MODE_MAX;
   WlzUByte	denDom = 255;
   WlzUByte	denVal[256];
   FILE		*inFP, *outFP, *bibFP;
   char		*outFile = NULL,
                 *bibFile = NULL,
   		*lutFile = NULL;
-  char 		optList[] = "a:b:d:D:f:i:m:o:r:s:t:u:V:h";
+  char 		optList[] = "a:b:d:D:f:i:m:o:p:r:s:t:u:V:h";
   int		option;
   int		iVal;
   double	depth=0.0, dist=0.0, pitch=0.0, yaw=0.0, roll=0.0;
@@ -309,6 +334,28 @@ int main(int	argc,
       outFile = optarg;
       break;
 
+    case 'p':
+      rayFlg = 1;
+      switch(*optarg)
+      {
+        case 'x':
+	  rayMod = WLZ_PROJECT_RAY_MODE_MAX;
+	  break;
+        case 'n':
+	  rayMod = WLZ_PROJECT_RAY_MODE_MIN;
+	  break;
+        case 'm':
+	  rayMod = WLZ_PROJECT_RAY_MODE_MEAN;
+	  break;
+        case 's':
+	  rayMod = WLZ_PROJECT_RAY_MODE_SUM;
+	  break;
+	default:
+	  usage = 2;
+	  break;
+      }
+      break;
+
     case 'r':
       if( sscanf(optarg, "%d", &voxRescale) < 1 ){
         usage = 2;
@@ -402,7 +449,7 @@ int main(int	argc,
   }
 
   /* check for values density look up table */
-  if(intMod == WLZ_PROJECT_INT_MODE_VALUES)
+  if((rayFlg == 0) && (intMod == WLZ_PROJECT_INT_MODE_VALUES))
   {
     if(lutFile)
     {
@@ -530,8 +577,15 @@ int main(int	argc,
         viewStr->voxelSize[2] = obj->domain.p->voxel_size[2];
       }
       WlzInit3DViewStruct(viewStr, obj);
-      nobj = WlzProjectObjToPlane(obj, viewStr, intMod, denDom, denVal,
-      				  depth, &errNum);
+      if(rayFlg)
+      {
+        nobj = WlzProjectObjRays(obj, viewStr, rayMod, depth, &errNum);
+      }
+      else
+      {
+	nobj = WlzProjectObjToPlane(obj, viewStr, intMod, denDom, denVal,
+				    depth, &errNum);
+      }
       if( nobj != NULL){
 	WlzWriteObj(outFP, nobj);
       }
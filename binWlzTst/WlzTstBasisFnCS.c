@@ -0,0 +1,309 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstBasisFnCS_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstBasisFnCS.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the compactly supported basis functions.
+* 		Basis functions are computed using
+* 		WlzBasisFnCS2DFromCPts() and WlzBasisFnCS3DFromCPts()
+* 		from random control points with random displacements.
+* 		The basis functions must interpolate the control points,
+* 		and the values computed for random vertices using
+* 		WlzBasisFnValues2D() or WlzBasisFnValues3D() must match
+* 		those computed using WlzBasisFnValueCS2D() or
+* 		WlzBasisFnValueCS3D().
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <Wlz.h>
+
+static double			WlzTstBasisFnCSMaxDiff(
+				  int n,
+				  double *v0,
+				  double *v1);
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+
+int		main(int argc, char *argv[])
+{
+  int		option,
+		idR,
+		dim,
+  		ok = 1,
+		usage = 0,
+		verbose = 0,
+		repeats = 2,
+		nCPts = 1000,
+		nVx = 1000;
+  long		seed = 0;
+  double	support = 0.1,
+  		cPtTol = 1.0e-3,
+		valTol = 1.0e-6;
+  size_t	nBad = 0;
+  double	*sPts = NULL,
+  		*dPts = NULL,
+		*cPtV = NULL,
+		*vx = NULL,
+		*v0 = NULL,
+		*v1 = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const char	*errMsgStr;
+  const double	range = 1000.0,
+  		disp = 20.0;
+  static char   optList[] = "hvc:n:s:S:x:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'c':
+        usage = (sscanf(optarg, "%d", &nCPts) != 1) || (nCPts < 4);
+	break;
+      case 'n':
+        usage = (sscanf(optarg, "%d", &repeats) != 1) || (repeats < 1);
+	break;
+      case 's':
+        usage = (sscanf(optarg, "%ld", &seed) != 1);
+	break;
+      case 'S':
+        usage = (sscanf(optarg, "%lg", &support) != 1) ||
+	        (support <= 0.0) || (support > 1.0);
+	break;
+      case 'x':
+        usage = (sscanf(optarg, "%d", &nVx) != 1) || (nVx < 1);
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+        usage = 1;
+	break;
+    }
+  }
+  ok = (usage == 0) && (optind == argc);
+  usage = !ok;
+  if(ok)
+  {
+    if(((sPts = (double *)AlcMalloc(3 * nCPts * sizeof(double))) == NULL) ||
+       ((dPts = (double *)AlcMalloc(3 * nCPts * sizeof(double))) == NULL) ||
+       ((cPtV = (double *)AlcMalloc(3 * nCPts * sizeof(double))) == NULL) ||
+       ((vx = (double *)AlcMalloc(3 * nVx * sizeof(double))) == NULL) ||
+       ((v0 = (double *)AlcMalloc(3 * nVx * sizeof(double))) == NULL) ||
+       ((v1 = (double *)AlcMalloc(3 * nVx * sizeof(double))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    AlgRandSeed(seed);
+  }
+  for(idR = 0; (errNum == WLZ_ERR_NONE) && (idR < repeats); ++idR)
+  {
+    for(dim = 2; (errNum == WLZ_ERR_NONE) && (dim <= 3); ++dim)
+    {
+      int	idx,
+		bad = 0;
+      double	dif0 = 0.0,
+      		dif1 = 0.0;
+      WlzBasisFn *fn = NULL;
+
+      for(idx = 0; idx < dim * nCPts; ++idx)
+      {
+        dPts[idx] = range * AlgRandUniform();
+	sPts[idx] = dPts[idx] + disp * (AlgRandUniform() - 0.5);
+      }
+      for(idx = 0; idx < dim * nVx; ++idx)
+      {
+        vx[idx] = 1.1 * range * AlgRandUniform() - 0.05 * range;
+      }
+      if(dim == 2)
+      {
+	WlzDVertex2 *dP2,
+		    *cV2;
+
+	dP2 = (WlzDVertex2 *)dPts;
+	cV2 = (WlzDVertex2 *)cPtV;
+        fn = WlzBasisFnCS2DFromCPts(nCPts, dP2, (WlzDVertex2 *)sPts,
+				    support, &errNum);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  WlzDVertex2 *sV2,
+		      *v2;
+
+	  /* The basis function gives the displacement from the destination
+	   * to the source control points. */
+	  for(idx = 0; idx < nCPts; ++idx)
+	  {
+	    cV2[idx] = WlzBasisFnValueCS2D(fn, dP2[idx]);
+	    cV2[idx].vtX += dP2[idx].vtX;
+	    cV2[idx].vtY += dP2[idx].vtY;
+	  }
+	  sV2 = (WlzDVertex2 *)vx;
+	  v2 = (WlzDVertex2 *)v0;
+	  for(idx = 0; idx < nVx; ++idx)
+	  {
+	    v2[idx] = WlzBasisFnValueCS2D(fn, sV2[idx]);
+	  }
+	  errNum = WlzBasisFnValues2D(fn, nVx, sV2, (WlzDVertex2 *)v1);
+	}
+      }
+      else
+      {
+	WlzDVertex3 *dP3,
+		    *cV3;
+
+	dP3 = (WlzDVertex3 *)dPts;
+	cV3 = (WlzDVertex3 *)cPtV;
+        fn = WlzBasisFnCS3DFromCPts(nCPts, dP3, (WlzDVertex3 *)sPts,
+				    support, &errNum);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  WlzDVertex3 *sV3,
+		      *v3;
+
+	  for(idx = 0; idx < nCPts; ++idx)
+	  {
+	    cV3[idx] = WlzBasisFnValueCS3D(fn, dP3[idx]);
+	    WLZ_VTX_3_ADD(cV3[idx], cV3[idx], dP3[idx]);
+	  }
+	  sV3 = (WlzDVertex3 *)vx;
+	  v3 = (WlzDVertex3 *)v0;
+	  for(idx = 0; idx < nVx; ++idx)
+	  {
+	    v3[idx] = WlzBasisFnValueCS3D(fn, sV3[idx]);
+	  }
+	  errNum = WlzBasisFnValues3D(fn, nVx, sV3, (WlzDVertex3 *)v1);
+	}
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	dif0 = WlzTstBasisFnCSMaxDiff(dim * nCPts, sPts, cPtV);
+	dif1 = WlzTstBasisFnCSMaxDiff(dim * nVx, v0, v1);
+	bad = !(dif0 <= cPtTol) || !(dif1 <= valTol);
+	if(verbose)
+	{
+	  (void )printf("%dD compactly supported basis function, "
+	                "%d control points: maximum differences %g "
+			"(tolerance %g) at control points, %g "
+			"(tolerance %g) between evaluation functions%s\n",
+			dim, nCPts, dif0, cPtTol, dif1, valTol,
+			(bad)? " bad": "");
+	}
+	nBad += (bad != 0);
+      }
+      (void )WlzBasisFnFree(fn);
+    }
+  }
+  AlcFree(sPts);
+  AlcFree(dPts);
+  AlcFree(cPtV);
+  AlcFree(vx);
+  AlcFree(v0);
+  AlcFree(v1);
+  if(ok)
+  {
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to compute or evaluate compactly\n"
+		     "supported basis functions (%s).\n",
+		     *argv, errMsgStr);
+    }
+    else if(nBad > 0)
+    {
+      ok = 0;
+      (void )fprintf(stderr,
+		     "%s: %lu basis functions did not interpolate their\n"
+		     "control points or gave inconsistent values.\n",
+		     *argv, (unsigned long )nBad);
+    }
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v] [-c#] [-n#] [-s#] [-S#] [-x#]\n"
+    "Tests the 2D and 3D compactly supported basis functions computed\n"
+    "from random control points by checking that they interpolate\n"
+    "the control points and that the values computed for an array of\n"
+    "vertices match those computed for each vertex in turn.\n"
+    "Options are:\n"
+    "  -h  Prints this usage information.\n"
+    "  -v  Verbose output.\n"
+    "  -c  Number of control points (default %d).\n"
+    "  -n  Number of repeats (default %d).\n"
+    "  -s  Seed for the pseudo random number generator (default %ld).\n"
+    "  -S  Radius of support, normalized by the extent of the control\n"
+    "      points (default %g).\n"
+    "  -x  Number of vertices evaluated (default %d).\n",
+    *argv, nCPts, repeats, seed, support, nVx);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Maximum absolute difference.
+* \ingroup	BinWlzTst
+* \brief	Computes the maximum absolute difference between the
+* 		values of two arrays, with any NaN giving DBL_MAX.
+* \param	n			Number of values.
+* \param	v0			First array.
+* \param	v1			Second array.
+*/
+static double	WlzTstBasisFnCSMaxDiff(int n, double *v0, double *v1)
+{
+  int		idx;
+  double	d,
+  		dMax = 0.0;
+
+  for(idx = 0; idx < n; ++idx)
+  {
+    d = fabs(v0[idx] - v1[idx]);
+    if(!(d <= dMax))
+    {
+      dMax = (d > dMax)? d: DBL_MAX;
+    }
+  }
+  return(dMax);
+}
@@ -0,0 +1,414 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstBasisFnTree_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstBasisFnTree.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the evaluation of basis functions using basis
+* 		function trees. Basis functions with random control
+* 		points and coefficients are made for the 2D Gaussian,
+* 		multiquadric, inverse multiquadric and thin plate spline
+* 		and the 3D multiquadric and inverse multiquadric basis
+* 		functions. Each is evaluated at random vertices using
+* 		WlzBasisFnValues2D() or WlzBasisFnValues3D(), exactly
+* 		and with an evaluation tolerance. Every component of
+* 		the values computed using the tree must be within the
+* 		tolerance of the exact value. The tree must be kept with
+* 		the basis function and reused, giving the same values,
+* 		and must be made again when the tolerance is changed.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <Wlz.h>
+
+static WlzBasisFn		*WlzTstBasisFnTreeMakeFn(
+				  WlzFnType type,
+				  int dim,
+				  int nCPts,
+				  WlzErrorNum *dstErr);
+static double			WlzTstBasisFnTreeMaxDiff(
+				  int n,
+				  double *v0,
+				  double *v1);
+static int			WlzTstBasisFnTreeEval(
+				  WlzBasisFn *fn,
+				  int dim,
+				  int nVx,
+				  void *srcVx,
+				  void *dstVx,
+				  WlzErrorNum *dstErr);
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+
+int		main(int argc, char *argv[])
+{
+  int		option,
+		idR,
+		idT,
+  		ok = 1,
+		usage = 0,
+		verbose = 0,
+		repeats = 2,
+		nCPts = 4000,
+		nVx = 4000;
+  long		seed = 0;
+  double	tol = 0.01;
+  size_t	nBad = 0;
+  double	*vx = NULL,
+		*ex = NULL,
+		*ap0 = NULL,
+		*ap1 = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const char	*errMsgStr;
+  const int	nType = 6;
+  const WlzFnType type[6] = {
+  		WLZ_FN_BASIS_2DGAUSS,
+  		WLZ_FN_BASIS_2DMQ,
+  		WLZ_FN_BASIS_2DIMQ,
+  		WLZ_FN_BASIS_2DTPS,
+  		WLZ_FN_BASIS_3DMQ,
+  		WLZ_FN_BASIS_3DIMQ};
+  const double	range = 1000.0;
+  static char   optList[] = "hvc:n:s:t:x:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'c':
+        usage = (sscanf(optarg, "%d", &nCPts) != 1) || (nCPts < 4);
+	break;
+      case 'n':
+        usage = (sscanf(optarg, "%d", &repeats) != 1) || (repeats < 1);
+	break;
+      case 's':
+        usage = (sscanf(optarg, "%ld", &seed) != 1);
+	break;
+      case 't':
+        usage = (sscanf(optarg, "%lg", &tol) != 1) || (tol <= 0.0);
+	break;
+      case 'x':
+        usage = (sscanf(optarg, "%d", &nVx) != 1) || (nVx < 1);
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+        usage = 1;
+	break;
+    }
+  }
+  ok = (usage == 0) && (optind == argc);
+  usage = !ok;
+  if(ok)
+  {
+    if(((vx = (double *)AlcMalloc(3 * nVx * sizeof(double))) == NULL) ||
+       ((ex = (double *)AlcMalloc(3 * nVx * sizeof(double))) == NULL) ||
+       ((ap0 = (double *)AlcMalloc(3 * nVx * sizeof(double))) == NULL) ||
+       ((ap1 = (double *)AlcMalloc(3 * nVx * sizeof(double))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    AlgRandSeed(seed);
+  }
+  for(idR = 0; (errNum == WLZ_ERR_NONE) && (idR < repeats); ++idR)
+  {
+    for(idT = 0; (errNum == WLZ_ERR_NONE) && (idT < nType); ++idT)
+    {
+      int	idx,
+      		dim,
+		bad = 0;
+      double	dif0,
+      		dif1,
+		dif2;
+      WlzBasisFn *fn = NULL;
+      WlzBasisFnTree *tree = NULL;
+
+      dim = ((type[idT] == WLZ_FN_BASIS_3DMQ) ||
+             (type[idT] == WLZ_FN_BASIS_3DIMQ))? 3: 2;
+      fn = WlzTstBasisFnTreeMakeFn(type[idT], dim, nCPts, &errNum);
+      for(idx = 0; idx < dim * nVx; ++idx)
+      {
+        vx[idx] = 1.1 * range * AlgRandUniform() - 0.05 * range;
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	/* Exact values. */
+	fn->evalTol = 0.0;
+	bad |= WlzTstBasisFnTreeEval(fn, dim, nVx, vx, ex, &errNum);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	/* Values using a tree which must be kept with the basis function
+	 * and then reused. */
+	fn->evalTol = tol;
+	bad |= WlzTstBasisFnTreeEval(fn, dim, nVx, vx, ap0, &errNum);
+	tree = fn->evalTree;
+	bad |= (tree == NULL);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	bad |= WlzTstBasisFnTreeEval(fn, dim, nVx, vx, ap1, &errNum);
+	bad |= (fn->evalTree != tree) ||
+	       (memcmp(ap0, ap1, dim * nVx * sizeof(double)) != 0);
+	dif0 = WlzTstBasisFnTreeMaxDiff(dim * nVx, ex, ap0);
+	bad |= !(dif0 <= tol);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	/* Values using a new tree for a reduced tolerance. */
+	fn->evalTol = 0.1 * tol;
+	bad |= WlzTstBasisFnTreeEval(fn, dim, nVx, vx, ap1, &errNum);
+	bad |= (fn->evalTree == NULL) || (fn->evalTree->tol != fn->evalTol);
+	dif1 = WlzTstBasisFnTreeMaxDiff(dim * nVx, ex, ap1);
+	bad |= !(dif1 <= fn->evalTol);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	/* Exact values must not use the tree. */
+	fn->evalTol = 0.0;
+	bad |= WlzTstBasisFnTreeEval(fn, dim, nVx, vx, ap1, &errNum);
+	dif2 = WlzTstBasisFnTreeMaxDiff(dim * nVx, ex, ap1);
+	bad |= (dif2 != 0.0);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	if(verbose)
+	{
+	  (void )printf("%dD basis function type %d, %d control points: "
+	                "maximum differences %g (tolerance %g) "
+			"%g (tolerance %g) %g%s\n",
+			dim, (int )(type[idT]), nCPts,
+			dif0, tol, dif1, 0.1 * tol, dif2,
+			(bad)? " bad": "");
+	}
+	nBad += (bad != 0);
+      }
+      (void )WlzBasisFnFree(fn);
+    }
+  }
+  AlcFree(vx);
+  AlcFree(ex);
+  AlcFree(ap0);
+  AlcFree(ap1);
+  if(ok)
+  {
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s: Failed to evaluate basis functions (%s).\n",
+		     *argv, errMsgStr);
+    }
+    else if(nBad > 0)
+    {
+      ok = 0;
+      (void )fprintf(stderr,
+		     "%s: %lu basis functions were not evaluated within\n"
+		     "the tolerance or did not keep their trees.\n",
+		     *argv, (unsigned long )nBad);
+    }
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v] [-c#] [-n#] [-s#] [-t#] [-x#]\n"
+    "Tests the evaluation of basis functions to within a tolerance\n"
+    "using basis function trees, by comparing the values with those\n"
+    "computed exactly for the 2D Gaussian, multiquadric, inverse\n"
+    "multiquadric and thin plate spline and the 3D multiquadric and\n"
+    "inverse multiquadric basis functions. Also checks that the tree\n"
+    "is kept with the basis function until the tolerance is changed.\n"
+    "Options are:\n"
+    "  -h  Prints this usage information.\n"
+    "  -v  Verbose output.\n"
+    "  -c  Number of control points (default %d).\n"
+    "  -n  Number of repeats (default %d).\n"
+    "  -s  Seed for the pseudo random number generator (default %ld).\n"
+    "  -t  Evaluation tolerance (default %g).\n"
+    "  -x  Number of vertices evaluated (default %d).\n",
+    *argv, nCPts, repeats, seed, tol, nVx);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	New basis function or NULL on error.
+* \ingroup	BinWlzTst
+* \brief	Makes a basis function of the given type with random
+* 		control points within a cube (or square) of side 1000
+* 		and random coefficients. The coefficients are scaled so
+* 		that the values of each basis function have a similar
+* 		range.
+* \param	type			Basis function type.
+* \param	dim			Dimension, 2 or 3.
+* \param	nCPts			Number of control points.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzBasisFn *WlzTstBasisFnTreeMakeFn(WlzFnType type, int dim,
+					   int nCPts, WlzErrorNum *dstErr)
+{
+  int		idx,
+  		nPoly;
+  double	scale = 1.0;
+  double	*cPts,
+  		*wts,
+		*poly;
+  WlzBasisFn	*fn = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const double	range = 1000.0;
+
+  nPoly = dim + 1;
+  if(((fn = (WlzBasisFn *)AlcCalloc(1, sizeof(WlzBasisFn))) == NULL) ||
+     ((fn->vertices.v = AlcMalloc(dim * nCPts * sizeof(double))) == NULL) ||
+     ((fn->basis.v = AlcMalloc(dim * nCPts * sizeof(double))) == NULL) ||
+     ((fn->poly.v = AlcMalloc(dim * nPoly * sizeof(double))) == NULL) ||
+     ((fn->param = AlcMalloc(sizeof(double))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    fn->type = type;
+    fn->nPoly = nPoly;
+    fn->nBasis = fn->nVtx = fn->maxVx = nCPts;
+    switch(type)
+    {
+      case WLZ_FN_BASIS_2DGAUSS:
+	*(double *)(fn->param) = -1.0 / (50.0 * 50.0);
+	scale = 1.0;
+        break;
+      case WLZ_FN_BASIS_2DMQ: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DMQ:
+	*(double *)(fn->param) = 400.0;
+	scale = 1.0e-2;
+        break;
+      case WLZ_FN_BASIS_2DIMQ: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DIMQ:
+	*(double *)(fn->param) = 100.0;
+	scale = 10.0;
+        break;
+      default: /* WLZ_FN_BASIS_2DTPS */
+	*(double *)(fn->param) = 0.0;
+	scale = 1.0e-5;
+        break;
+    }
+    cPts = (double *)(fn->vertices.v);
+    wts = (double *)(fn->basis.v);
+    poly = (double *)(fn->poly.v);
+    for(idx = 0; idx < dim * nCPts; ++idx)
+    {
+      cPts[idx] = range * AlgRandUniform();
+      wts[idx] = scale * (AlgRandUniform() - 0.5);
+    }
+    for(idx = 0; idx < dim * nPoly; ++idx)
+    {
+      poly[idx] = AlgRandUniform();
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzBasisFnFree(fn);
+    fn = NULL;
+  }
+  *dstErr = errNum;
+  return(fn);
+}
+
+/*!
+* \return	Maximum absolute difference.
+* \ingroup	BinWlzTst
+* \brief	Computes the maximum absolute difference between the
+* 		values of two arrays.
+* \param	n			Number of values in each array.
+* \param	v0			First array.
+* \param	v1			Second array.
+*/
+static double	WlzTstBasisFnTreeMaxDiff(int n, double *v0, double *v1)
+{
+  int		idx;
+  double	dif = 0.0;
+
+  for(idx = 0; idx < n; ++idx)
+  {
+    double	d;
+
+    d = fabs(v0[idx] - v1[idx]);
+    if(!(d <= dif))
+    {
+      dif = (d == d)? d: DBL_MAX;
+    }
+  }
+  return(dif);
+}
+
+/*!
+* \return	Non-zero if the evaluation failed.
+* \ingroup	BinWlzTst
+* \brief	Evaluates the given basis function at each of the given
+* 		vertices.
+* \param	fn			Given basis function.
+* \param	dim			Dimension, 2 or 3.
+* \param	nVx			Number of vertices.
+* \param	srcVx			Vertices (WlzDVertex2 or WlzDVertex3).
+* \param	dstVx			Destination for the values.
+* \param	dstErr			Destination error pointer.
+*/
+static int	WlzTstBasisFnTreeEval(WlzBasisFn *fn, int dim, int nVx,
+				      void *srcVx, void *dstVx,
+				      WlzErrorNum *dstErr)
+{
+  if(dim == 2)
+  {
+    *dstErr = WlzBasisFnValues2D(fn, nVx, (WlzDVertex2 *)srcVx,
+    				 (WlzDVertex2 *)dstVx);
+  }
+  else
+  {
+    *dstErr = WlzBasisFnValues3D(fn, nVx, (WlzDVertex3 *)srcVx,
+    				 (WlzDVertex3 *)dstVx);
+  }
+  return(*dstErr != WLZ_ERR_NONE);
+}
@@ -0,0 +1,681 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstBenchmark_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstBenchmark.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Benchmarks for frequently used libWlz functions. A synthetic
+* 		2D or 3D domain object of given size and fragmentation is
+* 		generated and then each of the benchmarks is timed using
+* 		increasing numbers of threads. The results are output
+* 		as comma separated values so that they may easily be
+* 		compared between builds.
+* \ingroup	BinWlzTst
+*/
+
+#include <sys/time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <Wlz.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \struct	_WlzTstBenchCtx
+* \ingroup	BinWlzTst
+* \brief	Objects and parameters shared by the benchmarks.
+*/
+typedef struct _WlzTstBenchCtx
+{
+  int		dim;			/*!< Dimension of the objects. */
+  WlzObject	*bObj;			/*!< Box shaped object with values. */
+  WlzObject	*fObj;			/*!< Fragmented object with values. */
+  WlzAffineTransform *tr;		/*!< Transform for affine benchmark. */
+  WlzThreeDViewStruct *view;		/*!< View for section benchmark. */
+  FILE		*fP;			/*!< Temporary file holding the
+  					     fragmented object. */
+} WlzTstBenchCtx;
+
+typedef WlzErrorNum (*WlzTstBenchFn)(WlzTstBenchCtx *);
+
+/*!
+* \struct	_WlzTstBench
+* \ingroup	BinWlzTst
+* \brief	A named benchmark.
+*/
+typedef struct _WlzTstBench
+{
+  const char	*name;			/*!< Name of the benchmark. */
+  int		only3D;			/*!< Non-zero if only applicable to
+  					     3D objects. */
+  WlzTstBenchFn	fn;			/*!< Function which is timed. */
+} WlzTstBench;
+
+static double			WlzTstBenchTime(
+				  void);
+static WlzObject		*WlzTstBenchMakeObj(
+				  int dim,
+				  int size,
+				  int frag,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzTstBenchRead(
+				  WlzTstBenchCtx *ctx);
+static WlzErrorNum		WlzTstBenchWrite(
+				  WlzTstBenchCtx *ctx);
+static WlzErrorNum		WlzTstBenchScan(
+				  WlzTstBenchCtx *ctx);
+static WlzErrorNum		WlzTstBenchThreshold(
+				  WlzTstBenchCtx *ctx);
+static WlzErrorNum		WlzTstBenchAffine(
+				  WlzTstBenchCtx *ctx);
+static WlzErrorNum		WlzTstBenchSection(
+				  WlzTstBenchCtx *ctx);
+static WlzErrorNum		WlzTstBenchDistance(
+				  WlzTstBenchCtx *ctx);
+static WlzErrorNum		WlzTstBenchLabel(
+				  WlzTstBenchCtx *ctx);
+
+static WlzTstBench WlzTstBenchTbl[] =
+{
+  {"read",	0, WlzTstBenchRead},
+  {"write",	0, WlzTstBenchWrite},
+  {"scan",	0, WlzTstBenchScan},
+  {"threshold",	0, WlzTstBenchThreshold},
+  {"affine",	0, WlzTstBenchAffine},
+  {"section",	1, WlzTstBenchSection},
+  {"distance",	0, WlzTstBenchDistance},
+  {"label",	0, WlzTstBenchLabel}
+};
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+int		main(int argc, char *argv[])
+{
+  int		idB,
+  		option,
+  		ok = 1,
+		usage = 0,
+		dim = 3,
+		size = 0,
+		frag = 8,
+		repeats = 3,
+		maxThr = 1;
+  WlzLong	nItv = 0;
+  char		*benchStr = NULL,
+  		*outFileStr;
+  FILE		*fP = NULL;
+  const char	*errMsgStr;
+  WlzTstBenchCtx ctx;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const int	nBench = sizeof(WlzTstBenchTbl) / sizeof(WlzTstBench);
+  static char   optList[] = "b:d:f:o:r:s:t:h";
+  const char    defFile[] = "-";
+
+  opterr = 0;
+  outFileStr = (char *)defFile;
+  (void )memset(&ctx, 0, sizeof(WlzTstBenchCtx));
+#ifdef _OPENMP
+  maxThr = omp_get_max_threads();
+#endif
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'b':
+        benchStr = optarg;
+	break;
+      case 'd':
+        usage = (sscanf(optarg, "%d", &dim) != 1) || (dim < 2) || (dim > 3);
+	break;
+      case 'f':
+        usage = (sscanf(optarg, "%d", &frag) != 1) || (frag < 1);
+	break;
+      case 'o':
+        outFileStr = optarg;
+	break;
+      case 'r':
+        usage = (sscanf(optarg, "%d", &repeats) != 1) || (repeats < 1);
+	break;
+      case 's':
+        usage = (sscanf(optarg, "%d", &size) != 1) || (size < 4);
+	break;
+      case 't':
+        usage = (sscanf(optarg, "%d", &maxThr) != 1) || (maxThr < 1);
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if((usage == 0) && (optind != argc))
+  {
+    usage = 1;
+  }
+  ok = usage == 0;
+  if(ok)
+  {
+    ctx.dim = dim;
+    if(size == 0)
+    {
+      size = (dim == 2)? 2048: 256;
+    }
+    if((outFileStr == NULL) || (*outFileStr == '\0') ||
+       ((fP = (strcmp(outFileStr, "-")?
+              fopen(outFileStr, "w"): stdout)) == NULL))
+    {
+      ok = 0;
+      (void )fprintf(stderr, "%s: Failed to open output file %s.\n",
+                     *argv, outFileStr);
+    }
+  }
+  /* Create the synthetic objects, transform and view. */
+  if(ok)
+  {
+    ctx.bObj = WlzAssignObject(
+    	       WlzTstBenchMakeObj(dim, size, frag, &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzPixelV	tV;
+
+      tV.type = WLZ_GREY_INT;
+      tV.v.inv = 128;
+      ctx.fObj = WlzAssignObject(
+      		 WlzThreshold(ctx.bObj, tV, WLZ_THRESH_HIGH, &errNum), NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      nItv = WlzIntervalCountObj(ctx.fObj, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      double	c;
+
+      c = 0.5 * size;
+      ctx.tr = WlzAffineTransformFromPrimVal(
+      	       (dim == 2)? WLZ_TRANSFORM_2D_AFFINE: WLZ_TRANSFORM_3D_AFFINE,
+	       c, c, (dim == 2)? 0.0: c, 1.0, 0.3, (dim == 2)? 0.0: 0.2,
+	       0.0, 0.0, 0.0, 0, &errNum);
+    }
+    if((errNum == WLZ_ERR_NONE) && (dim == 3))
+    {
+      ctx.view = WlzMake3DViewStruct(WLZ_3D_VIEW_STRUCT, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        ctx.view->fixed.vtX = ctx.view->fixed.vtY =
+	  ctx.view->fixed.vtZ = 0.5 * size;
+        ctx.view->theta = 0.5;
+        ctx.view->phi = 0.7;
+	ctx.view->scale = 1.0;
+	ctx.view->view_mode = WLZ_UP_IS_UP_MODE;
+	ctx.view->up.vtZ = 1.0;
+	errNum = WlzInit3DViewStruct(ctx.view, ctx.fObj);
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if((ctx.fP = tmpfile()) == NULL)
+      {
+        errNum = WLZ_ERR_WRITE_EOF;
+      }
+      else
+      {
+        errNum = WlzWriteObj(ctx.fP, ctx.fObj);
+      }
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+                     "%s: Failed to create benchmark objects (%s).\n",
+		     *argv, errMsgStr);
+    }
+  }
+  /* Run the benchmarks. */
+  if(ok)
+  {
+    (void )fprintf(fP,
+                   "benchmark,dim,size,fragmentation,intervals,threads,"
+		   "repeats,min_s,mean_s\n");
+    for(idB = 0; ok && (idB < nBench); ++idB)
+    {
+      int	nThr;
+      WlzTstBench *b;
+
+      b = WlzTstBenchTbl + idB;
+      if((b->only3D && (dim != 3)) ||
+         (benchStr && (strstr(benchStr, b->name) == NULL)))
+      {
+        continue;
+      }
+      for(nThr = 1; ok && (nThr <= maxThr);
+          nThr = (nThr < maxThr) && (2 * nThr > maxThr)? maxThr: 2 * nThr)
+      {
+	int	idR;
+	double	t0,
+		t1,
+		tMin = 0.0,
+		tSum = 0.0;
+
+#ifdef _OPENMP
+	omp_set_num_threads(nThr);
+#endif
+	for(idR = 0; idR < repeats; ++idR)
+	{
+	  t0 = WlzTstBenchTime();
+	  errNum = (*(b->fn))(&ctx);
+	  t1 = WlzTstBenchTime() - t0;
+	  if(errNum != WLZ_ERR_NONE)
+	  {
+	    break;
+	  }
+	  tSum += t1;
+	  if((idR == 0) || (t1 < tMin))
+	  {
+	    tMin = t1;
+	  }
+	}
+	if(errNum != WLZ_ERR_NONE)
+	{
+	  ok = 0;
+	  (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+	  (void )fprintf(stderr,
+	                 "%s: Benchmark %s failed (%s).\n",
+			 *argv, b->name, errMsgStr);
+	}
+	else
+	{
+	  (void )fprintf(fP, "%s,%d,%d,%d,%lld,%d,%d,%g,%g\n",
+	                 b->name, dim, size, frag, (long long )nItv,
+			 nThr, repeats, tMin, tSum / repeats);
+	  (void )fflush(fP);
+	}
+	if(nThr == maxThr)
+	{
+	  break;
+	}
+      }
+    }
+  }
+  if(fP && strcmp(outFileStr, "-"))
+  {
+    (void )fclose(fP);
+  }
+  if(ctx.fP)
+  {
+    (void )fclose(ctx.fP);
+  }
+  (void )WlzFree3DViewStruct(ctx.view);
+  (void )WlzFreeAffineTransform(ctx.tr);
+  (void )WlzFreeObj(ctx.fObj);
+  (void )WlzFreeObj(ctx.bObj);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s%s",
+    *argv,
+    " [-b<benchmarks>] [-d<dim>] [-f<fragmentation>] [-o<output file>]\n"
+    "                        [-r<repeats>] [-s<size>] [-t<max threads>]"
+    " [-h]\n"
+    "Times frequently used Woolz functions on a synthetic object using\n"
+    "1, 2, 4, ... up to the maximum number of threads. The results are\n"
+    "output as comma separated values with the minimum and mean times\n"
+    "in seconds.\n"
+    "Options:\n"
+    "  -b  Comma separated list of benchmarks to run, the default is\n"
+    "      to run all of: read, write, scan, threshold, affine, section\n"
+    "      (3D only), distance and label.\n"
+    "  -d  Dimension of the synthetic object (2 or 3, default 3).\n"
+    "  -f  Fragmentation, the number of blobs along each axis of the\n"
+    "      synthetic object (default 8).\n"
+    "  -o  Output file (default standard output).\n"
+    "  -r  Number of times each benchmark is repeated (default 3).\n"
+    "  -s  Size of the synthetic object along each axis (default 2048\n"
+    "      for 2D and 256 for 3D).\n"
+    "  -t  Maximum number of threads (default is the number available).\n"
+    "  -h  Prints this usage information.\n");
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Wall clock time in seconds.
+* \ingroup	BinWlzTst
+* \brief	Gets the wall clock time.
+*/
+static double	WlzTstBenchTime(void)
+{
+  struct timeval tv;
+
+  (void )gettimeofday(&tv, NULL);
+  return(tv.tv_sec + (0.000001 * tv.tv_usec));
+}
+
+/*!
+* \return	New object.
+* \ingroup	BinWlzTst
+* \brief	Creates a rectangular (2D) or cuboid (3D) object with
+* 		unsigned byte values that vary periodically along each
+* 		axis so that thresholding the object at 128 gives frag
+* 		blobs along each axis. A small deterministic pseudo-random
+* 		perturbation is added to the values so that the blob
+* 		boundaries are ragged.
+* \param	dim			Dimension of object.
+* \param	size			Size along each axis.
+* \param	frag			Number of blobs along each axis.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *WlzTstBenchMakeObj(int dim, int size, int frag,
+				     WlzErrorNum *dstErr)
+{
+  int		idP,
+  		nParts = 0;
+  double	f;
+  WlzPixelV	bgdV;
+  WlzObject	*obj = NULL,
+  		*dObj = NULL;
+  WlzIntervalScanPart *parts = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  bgdV.type = WLZ_GREY_UBYTE;
+  bgdV.v.ubv = 0;
+  if(dim == 2)
+  {
+    dObj = WlzMakeRect(0, size - 1, 0, size - 1, WLZ_GREY_ERROR, NULL, bgdV,
+    		       NULL, NULL, &errNum);
+  }
+  else
+  {
+    dObj = WlzMakeCuboid(0, size - 1, 0, size - 1, 0, size - 1,
+    			 WLZ_GREY_ERROR, bgdV, NULL, NULL, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    obj = WlzNewObjectValues(dObj,
+                             WlzGreyTableType(WLZ_GREY_TAB_RAGR,
+			                      WLZ_GREY_UBYTE, NULL),
+			     bgdV, 0, bgdV, &errNum);
+  }
+  (void )WlzFreeObj(dObj);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    parts = WlzMakeIntervalScanParts(obj, 0, &nParts, &errNum);
+  }
+  f = (2.0 * ALG_M_PI * frag) / size;
+  for(idP = 0; (errNum == WLZ_ERR_NONE) && (idP < nParts); ++idP)
+  {
+    WlzObject	obj2D;
+    WlzIntervalWSpace iWSp;
+    WlzGreyWSpace gWSp;
+
+    errNum = WlzInitGreyScanPart(obj, parts + idP, &obj2D, &iWSp, &gWSp,
+    				 WLZ_RASTERDIR_ILIC, 0);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+      {
+	int	k;
+	double	cYZ;
+
+	cYZ = cos(f * (iWSp.linpos + 0.5));
+	if(dim == 3)
+	{
+	  cYZ *= cos(f * (iWSp.plnpos + 0.5));
+	}
+	for(k = iWSp.lftpos; k <= iWSp.rgtpos; ++k)
+	{
+	  unsigned int h;
+
+	  h = (unsigned int )(k * 73856093) ^
+	      (unsigned int )(iWSp.linpos * 19349663) ^
+	      (unsigned int )(iWSp.plnpos * 83492791);
+	  gWSp.u_grintptr.ubp[k - iWSp.lftpos] =
+	      (WlzUByte )WLZ_CLAMP(128.0 + (120.0 * cYZ * cos(f * (k + 0.5))) +
+	                           (int )(h % 17) - 8, 0.0, 255.0);
+	}
+      }
+      (void )WlzEndGreyScan(&iWSp, &gWSp);
+      if(errNum == WLZ_ERR_EOO)
+      {
+        errNum = WLZ_ERR_NONE;
+      }
+    }
+  }
+  AlcFree(parts);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(obj);
+    obj = NULL;
+  }
+  *dstErr = errNum;
+  return(obj);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	BinWlzTst
+* \brief	Reads the fragmented object from the temporary file.
+* \param	ctx			Benchmark context.
+*/
+static WlzErrorNum WlzTstBenchRead(WlzTstBenchCtx *ctx)
+{
+  WlzObject	*obj;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  rewind(ctx->fP);
+  obj = WlzReadObj(ctx->fP, &errNum);
+  (void )WlzFreeObj(obj);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	BinWlzTst
+* \brief	Writes the fragmented object to a temporary file.
+* \param	ctx			Benchmark context.
+*/
+static WlzErrorNum WlzTstBenchWrite(WlzTstBenchCtx *ctx)
+{
+  FILE		*fP;
+  WlzErrorNum	errNum = WLZ_ERR_WRITE_EOF;
+
+  if((fP = tmpfile()) != NULL)
+  {
+    errNum = WlzWriteObj(fP, ctx->fObj);
+    if(fflush(fP) != 0)
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+    (void )fclose(fP);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	BinWlzTst
+* \brief	Sums the values of the fragmented object using grey
+* 		interval scanning of independent parts of the object.
+* \param	ctx			Benchmark context.
+*/
+static WlzErrorNum WlzTstBenchScan(WlzTstBenchCtx *ctx)
+{
+  int		idP,
+  		nParts = 0;
+  WlzLong	sum = 0;
+  WlzIntervalScanPart *parts;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  parts = WlzMakeIntervalScanParts(ctx->fObj, 0, &nParts, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(+:sum)
+#endif
+    for(idP = 0; idP < nParts; ++idP)
+    {
+      WlzObject	obj2D;
+      WlzIntervalWSpace iWSp;
+      WlzGreyWSpace gWSp;
+
+      if(WlzInitGreyScanPart(ctx->fObj, parts + idP, &obj2D, &iWSp, &gWSp,
+			     WLZ_RASTERDIR_ILIC, 0) == WLZ_ERR_NONE)
+      {
+	while(WlzNextGreyInterval(&iWSp) == WLZ_ERR_NONE)
+	{
+	  int	k;
+
+	  for(k = 0; k < iWSp.colrmn; ++k)
+	  {
+	    sum += gWSp.u_grintptr.ubp[k];
+	  }
+	}
+	(void )WlzEndGreyScan(&iWSp, &gWSp);
+      }
+    }
+  }
+  AlcFree(parts);
+  if((errNum == WLZ_ERR_NONE) && (sum <= 0))
+  {
+    errNum = WLZ_ERR_GREY_DATA;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	BinWlzTst
+* \brief	Thresholds the box shaped object.
+* \param	ctx			Benchmark context.
+*/
+static WlzErrorNum WlzTstBenchThreshold(WlzTstBenchCtx *ctx)
+{
+  WlzObject	*obj;
+  WlzPixelV	tV;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  tV.type = WLZ_GREY_INT;
+  tV.v.inv = 128;
+  obj = WlzThreshold(ctx->bObj, tV, WLZ_THRESH_HIGH, &errNum);
+  (void )WlzFreeObj(obj);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	BinWlzTst
+* \brief	Affine transforms the fragmented object using linear
+* 		interpolation.
+* \param	ctx			Benchmark context.
+*/
+static WlzErrorNum WlzTstBenchAffine(WlzTstBenchCtx *ctx)
+{
+  WlzObject	*obj;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  obj = WlzAffineTransformObj(ctx->fObj, ctx->tr, WLZ_INTERPOLATION_LINEAR,
+  			      &errNum);
+  (void )WlzFreeObj(obj);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	BinWlzTst
+* \brief	Cuts an oblique section through the fragmented object using
+* 		linear interpolation.
+* \param	ctx			Benchmark context.
+*/
+static WlzErrorNum WlzTstBenchSection(WlzTstBenchCtx *ctx)
+{
+  WlzObject	*obj;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  obj = WlzGetSectionFromObject(ctx->fObj, ctx->view,
+  				WLZ_INTERPOLATION_LINEAR, &errNum);
+  (void )WlzFreeObj(obj);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	BinWlzTst
+* \brief	Computes the octagonal distance transform of the box shaped
+* 		object's domain from the fragmented object's domain.
+* \param	ctx			Benchmark context.
+*/
+static WlzErrorNum WlzTstBenchDistance(WlzTstBenchCtx *ctx)
+{
+  WlzObject	*obj;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  obj = WlzDistanceTransform(ctx->bObj, ctx->fObj, WLZ_OCTAGONAL_DISTANCE,
+  			     0.0, 0.0, &errNum);
+  (void )WlzFreeObj(obj);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	BinWlzTst
+* \brief	Labels the fragmented object's domain into it's connected
+* 		components.
+* \param	ctx			Benchmark context.
+*/
+static WlzErrorNum WlzTstBenchLabel(WlzTstBenchCtx *ctx)
+{
+  int		idO,
+  		nObj = 0;
+  WlzObject	**objs = NULL;
+  WlzErrorNum	errNum;
+
+  errNum = WlzLabel(ctx->fObj, &nObj, &objs, 1 << 20, 0,
+  		    (ctx->dim == 2)? WLZ_8_CONNECTED: WLZ_26_CONNECTED);
+  for(idO = 0; idO < nObj; ++idO)
+  {
+    (void )WlzFreeObj(objs[idO]);
+  }
+  AlcFree(objs);
+  return(errNum);
+}
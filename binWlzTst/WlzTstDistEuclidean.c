@@ -0,0 +1,392 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstDistEuclidean_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstDistEuclidean.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the exact Euclidean distance transform computed
+* 		by WlzDistanceTransform() with WLZ_EUCLIDEAN_DISTANCE.
+* 		Random 2D and 3D foreground and reference domains are
+* 		created and the distances are compared with those found
+* 		by a brute force search of the reference elements. The
+* 		3D objects have random voxel sizes and each transform
+* 		is computed both with and without a maximum distance.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <Wlz.h>
+
+static size_t			WlzTstDistEuclideanCompare(
+				  WlzObject *dObj,
+				  WlzUByte *msk,
+				  WlzIVertex3 org,
+				  WlzIVertex3 sz,
+				  double *vSz,
+				  double dMax,
+				  double tol,
+				  WlzErrorNum *dstErr);
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+
+int		main(int argc, char *argv[])
+{
+  int		option,
+		idR,
+		dim,
+  		ok = 1,
+		usage = 0,
+		verbose = 0,
+		repeats = 4;
+  long		seed = 0;
+  double	fill = 0.6,
+  		refFill = 0.005,
+		dMax = 4.5,
+		tol = 1.0e-4;
+  size_t	nBad = 0;
+  WlzUByte	*msk = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const char	*errMsgStr;
+  const size_t	maxVx = 48 * 48 * 24;
+  static char   optList[] = "hvf:m:n:r:s:t:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'f':
+        usage = (sscanf(optarg, "%lg", &fill) != 1) ||
+	        (fill < 0.0) || (fill > 1.0);
+	break;
+      case 'm':
+        usage = (sscanf(optarg, "%lg", &dMax) != 1) || (dMax <= 0.0);
+	break;
+      case 'n':
+        usage = (sscanf(optarg, "%d", &repeats) != 1) || (repeats < 1);
+	break;
+      case 'r':
+        usage = (sscanf(optarg, "%lg", &refFill) != 1) ||
+	        (refFill < 0.0) || (refFill > 1.0);
+	break;
+      case 's':
+        usage = (sscanf(optarg, "%ld", &seed) != 1);
+	break;
+      case 't':
+        usage = (sscanf(optarg, "%lg", &tol) != 1) || (tol < 0.0);
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+        usage = 1;
+	break;
+    }
+  }
+  ok = (usage == 0) && (optind == argc);
+  usage = !ok;
+  if(ok)
+  {
+    if((msk = (WlzUByte *)AlcMalloc(maxVx * sizeof(WlzUByte))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    AlgRandSeed(seed);
+  }
+  for(idR = 0; (errNum == WLZ_ERR_NONE) && (idR < repeats); ++idR)
+  {
+    for(dim = 2; (errNum == WLZ_ERR_NONE) && (dim <= 3); ++dim)
+    {
+      int	idM;
+      size_t	idx,
+      		nVx;
+      double	vSz[3];
+      WlzIVertex3 org,
+      		sz;
+      WlzPixelV	bgdV,
+      		thrV;
+      WlzObject	*gObj = NULL,
+      		*fObj = NULL,
+		*rObj = NULL;
+
+      /* Create random foreground and reference domains with an
+       * arbitrary origin. Mask values are 1 for foreground elements
+       * and 2 for reference elements, which are also in the
+       * foreground. */
+      bgdV.type = thrV.type = WLZ_GREY_UBYTE;
+      bgdV.v.ubv = 0;
+      org.vtX = (int )(AlgRandUniform() * 20.0) - 10;
+      org.vtY = (int )(AlgRandUniform() * 20.0) - 10;
+      org.vtZ = (dim == 2)? 0: (int )(AlgRandUniform() * 20.0) - 10;
+      sz.vtX = 8 + (int )(AlgRandUniform() * 40.0);
+      sz.vtY = 8 + (int )(AlgRandUniform() * 40.0);
+      sz.vtZ = (dim == 2)? 1: 4 + (int )(AlgRandUniform() * 20.0);
+      vSz[0] = vSz[1] = vSz[2] = 1.0;
+      if(dim == 3)
+      {
+	vSz[0] = 0.5 + AlgRandUniform() * 2.0;
+	vSz[1] = 0.5 + AlgRandUniform() * 2.0;
+	vSz[2] = 0.5 + AlgRandUniform() * 2.0;
+      }
+      nVx = (size_t )(sz.vtX) * sz.vtY * sz.vtZ;
+      for(idx = 0; idx < nVx; ++idx)
+      {
+	double	r;
+
+	r = AlgRandUniform();
+        msk[idx] = (r < refFill)? 2: (r < fill)? 1: 0;
+      }
+      msk[(size_t )(AlgRandUniform() * (nVx - 1))] = 2;
+      if(dim == 2)
+      {
+        gObj = WlzMakeRect(org.vtY, org.vtY + sz.vtY - 1,
+			   org.vtX, org.vtX + sz.vtX - 1,
+			   WLZ_GREY_UBYTE, (int *)msk, bgdV, NULL, NULL,
+			   &errNum);
+      }
+      else
+      {
+        gObj = WlzMakeCuboid(org.vtZ, org.vtZ + sz.vtZ - 1,
+			     org.vtY, org.vtY + sz.vtY - 1,
+			     org.vtX, org.vtX + sz.vtX - 1,
+			     WLZ_GREY_UBYTE, bgdV, NULL, NULL, &errNum);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  int	idP;
+
+	  for(idP = 0; idP < sz.vtZ; ++idP)
+	  {
+	    (void )memcpy(gObj->values.vox->values[idP].r->values.ubp,
+	                  msk + (idP * sz.vtX * sz.vtY), sz.vtX * sz.vtY);
+	  }
+	}
+      }
+      gObj = WlzAssignObject(gObj, NULL);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	thrV.v.ubv = 1;
+        fObj = WlzAssignObject(
+	       WlzThreshold(gObj, thrV, WLZ_THRESH_HIGH, &errNum), NULL);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	thrV.v.ubv = 2;
+        rObj = WlzAssignObject(
+	       WlzThreshold(gObj, thrV, WLZ_THRESH_HIGH, &errNum), NULL);
+      }
+      if((errNum == WLZ_ERR_NONE) && (dim == 3))
+      {
+	int	idV;
+
+	for(idV = 0; idV < 3; ++idV)
+	{
+	  fObj->domain.p->voxel_size[idV] = vSz[idV];
+	  rObj->domain.p->voxel_size[idV] = vSz[idV];
+	}
+      }
+      /* Compute the transform without and then with a maximum
+       * distance. */
+      for(idM = 0; (errNum == WLZ_ERR_NONE) && (idM < 2); ++idM)
+      {
+	size_t	nBadM = 0;
+	double	dM;
+	WlzObject *dObj = NULL;
+
+	dM = (idM == 0)? 0.0: dMax;
+	dObj = WlzAssignObject(
+	       WlzDistanceTransform(fObj, rObj, WLZ_EUCLIDEAN_DISTANCE,
+				    0.0, dM, &errNum), NULL);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  nBadM = WlzTstDistEuclideanCompare(dObj, msk, org, sz, vSz, dM,
+					     tol, &errNum);
+	  nBad += nBadM;
+	}
+	if(verbose)
+	{
+	  (void )printf("%dD %dx%dx%d voxel size %g,%g,%g "
+	                "maximum distance %g: %lu bad\n",
+			dim, sz.vtX, sz.vtY, sz.vtZ,
+			vSz[0], vSz[1], vSz[2], dM,
+			(unsigned long )nBadM);
+	}
+	(void )WlzFreeObj(dObj);
+      }
+      (void )WlzFreeObj(rObj);
+      (void )WlzFreeObj(fObj);
+      (void )WlzFreeObj(gObj);
+    }
+  }
+  AlcFree(msk);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    ok = 0;
+    (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+    (void )fprintf(stderr,
+                   "%s: Failed to compute distance transform (%s).\n",
+		   *argv, errMsgStr);
+  }
+  else if(nBad != 0)
+  {
+    ok = 0;
+    (void )fprintf(stderr,
+                   "%s: %lu distances differ from brute force distances.\n",
+		   *argv, (unsigned long )nBad);
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s%s",
+    *argv,
+    " [-h] [-v] [-f#] [-m#] [-n#] [-r#] [-s#] [-t#]\n"
+    "Test for the exact Euclidean distance transform. Distances within\n"
+    "random 2D and 3D domains are compared with those found by a brute\n"
+    "force search. The exit status is zero if the distances agree.\n"
+    "Options:\n"
+    "  -h  Prints this usage information.\n"
+    "  -v  Verbose output.\n"
+    "  -f  Fraction of the elements which are in the foreground.\n"
+    "  -m  Maximum distance used for the clamped transforms.\n"
+    "  -n  Number of 2D and 3D domains tested.\n"
+    "  -r  Fraction of the elements which are in the reference domain.\n"
+    "  -s  Seed for the random number generator.\n"
+    "  -t  Relative tolerance for the distances.\n");
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Number of elements at which the distances disagree.
+* \ingroup	BinWlzTst
+* \brief	Compares the distances of a distance object with those
+* 		found by a brute force search of the reference elements
+* 		of the mask.
+* \param	dObj			Distance object with float values.
+* \param	msk			The mask, 1 for foreground and 2 for
+* 					reference elements.
+* \param	org			Origin of the mask.
+* \param	sz			Size of the mask.
+* \param	vSz			Voxel size.
+* \param	dMax			Maximum distance if greater than zero.
+* \param	tol			Relative tolerance.
+* \param	dstErr			Destination error pointer.
+*/
+static size_t	WlzTstDistEuclideanCompare(WlzObject *dObj, WlzUByte *msk,
+					   WlzIVertex3 org, WlzIVertex3 sz,
+					   double *vSz, double dMax,
+					   double tol, WlzErrorNum *dstErr)
+{
+  int		idx,
+  		idR,
+  		nVx,
+		nRef = 0;
+  size_t	nBad = 0;
+  WlzIVertex3	*ref = NULL;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nVx = sz.vtX * sz.vtY * sz.vtZ;
+  if((ref = (WlzIVertex3 *)AlcMalloc(nVx * sizeof(WlzIVertex3))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    for(idx = 0; idx < nVx; ++idx)
+    {
+      if(msk[idx] == 2)
+      {
+	ref[nRef].vtX = idx % sz.vtX;
+	ref[nRef].vtY = (idx / sz.vtX) % sz.vtY;
+	ref[nRef].vtZ = idx / (sz.vtX * sz.vtY);
+	++nRef;
+      }
+    }
+    gVWSp = WlzGreyValueMakeWSp(dObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idx = 0; idx < nVx; ++idx)
+    {
+      if(msk[idx])
+      {
+	double	d,
+		dMin;
+	WlzIVertex3 p;
+
+	p.vtX = idx % sz.vtX;
+	p.vtY = (idx / sz.vtX) % sz.vtY;
+	p.vtZ = idx / (sz.vtX * sz.vtY);
+	dMin = DBL_MAX;
+	for(idR = 0; idR < nRef; ++idR)
+	{
+	  WlzDVertex3 q;
+
+	  q.vtX = (ref[idR].vtX - p.vtX) * vSz[0];
+	  q.vtY = (ref[idR].vtY - p.vtY) * vSz[1];
+	  q.vtZ = (ref[idR].vtZ - p.vtZ) * vSz[2];
+	  d = WLZ_VTX_3_SQRLEN(q);
+	  if(d < dMin)
+	  {
+	    dMin = d;
+	  }
+	}
+	dMin = sqrt(dMin);
+	if((dMax > 0.0) && (dMin > dMax))
+	{
+	  dMin = dMax;
+	}
+	WlzGreyValueGet(gVWSp, org.vtZ + p.vtZ, org.vtY + p.vtY,
+			org.vtX + p.vtX);
+	d = gVWSp->gVal[0].flv;
+	if(fabs(d - dMin) > tol * WLZ_MAX(1.0, dMin))
+	{
+	  ++nBad;
+	}
+      }
+    }
+  }
+  WlzGreyValueFreeWSp(gVWSp);
+  AlcFree(ref);
+  *dstErr = errNum;
+  return(nBad);
+}
@@ -0,0 +1,675 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstLabelUF_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstLabelUF.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for WlzLabelUF(). Random 2D and 3D domains are
+* 		labelled using WlzLabelUF() with each of the 2D (4 and 8)
+* 		and 3D (6, 18 and 26) connectivities and the labelling is
+* 		compared with that found by a brute force flood fill of
+* 		a dense array. The labellings must have the same number
+* 		of components and there must be a one to one
+* 		correspondence between the labels of the two.
+* 		The component statistics computed by WlzLabelUFStats()
+* 		are compared with those computed for each component
+* 		object using WlzArea(), WlzVolume(), WlzBoundingBox3I(),
+* 		WlzCentreOfMass2D(), WlzCentreOfMass3D() and
+* 		WlzGreyStats(), and the second order moments with those
+* 		computed from the flood fill labels.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <Wlz.h>
+
+static int			WlzTstLabelUFFlood(
+				  int *lbl,
+				  WlzUByte *msk,
+				  int dim,
+				  WlzIVertex3 sz,
+				  WlzConnectType con,
+				  int *stk);
+static size_t			WlzTstLabelUFCompare(
+				  WlzObject *lObj,
+				  int nLbl,
+				  int *lbl,
+				  int nFlood,
+				  WlzUByte *msk,
+				  WlzIVertex3 org,
+				  WlzIVertex3 sz,
+				  WlzErrorNum *dstErr);
+static size_t			WlzTstLabelUFStatsCompare(
+				  WlzObject *fObj,
+				  WlzConnectType con,
+				  int dim,
+				  int *lbl,
+				  int nFlood,
+				  WlzUByte *msk,
+				  WlzIVertex3 sz,
+				  WlzErrorNum *dstErr);
+static int			WlzTstLabelUFDiff(
+				  double v0,
+				  double v1);
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+
+int		main(int argc, char *argv[])
+{
+  int		option,
+		idR,
+		dim,
+  		ok = 1,
+		usage = 0,
+		verbose = 0,
+		repeats = 4;
+  long		seed = 0;
+  double	fill = 0.35;
+  size_t	nBad = 0;
+  int		*lbl = NULL,
+  		*stk = NULL;
+  WlzUByte	*msk = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const char	*errMsgStr;
+  const size_t	maxVx = 64 * 64 * 32;
+  static char   optList[] = "hvf:n:s:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'f':
+        usage = (sscanf(optarg, "%lg", &fill) != 1) ||
+	        (fill < 0.0) || (fill > 1.0);
+	break;
+      case 'n':
+        usage = (sscanf(optarg, "%d", &repeats) != 1) || (repeats < 1);
+	break;
+      case 's':
+        usage = (sscanf(optarg, "%ld", &seed) != 1);
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+        usage = 1;
+	break;
+    }
+  }
+  ok = (usage == 0) && (optind == argc);
+  usage = !ok;
+  if(ok)
+  {
+    if(((msk = (WlzUByte *)AlcMalloc(maxVx * sizeof(WlzUByte))) == NULL) ||
+       ((lbl = (int *)AlcMalloc(maxVx * sizeof(int))) == NULL) ||
+       ((stk = (int *)AlcMalloc(maxVx * sizeof(int))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    AlgRandSeed(seed);
+  }
+  for(idR = 0; (errNum == WLZ_ERR_NONE) && (idR < repeats); ++idR)
+  {
+    for(dim = 2; (errNum == WLZ_ERR_NONE) && (dim <= 3); ++dim)
+    {
+      int	idC,
+		nCon;
+      size_t	idx,
+      		nVx;
+      WlzIVertex3 org,
+      		sz;
+      WlzPixelV	bgdV,
+      		thrV;
+      WlzObject	*gObj = NULL,
+      		*fObj = NULL;
+      int	nbr[3];
+      WlzConnectType con[3];
+
+      /* Create a random domain with an arbitrary origin and random
+       * grey values within it. */
+      bgdV.type = thrV.type = WLZ_GREY_UBYTE;
+      bgdV.v.ubv = 0;
+      thrV.v.ubv = 1;
+      org.vtX = (int )(AlgRandUniform() * 20.0) - 10;
+      org.vtY = (int )(AlgRandUniform() * 20.0) - 10;
+      org.vtZ = (dim == 2)? 0: (int )(AlgRandUniform() * 20.0) - 10;
+      sz.vtX = 16 + (int )(AlgRandUniform() * 48.0);
+      sz.vtY = 16 + (int )(AlgRandUniform() * 48.0);
+      sz.vtZ = (dim == 2)? 1: 4 + (int )(AlgRandUniform() * 28.0);
+      nVx = (size_t )(sz.vtX) * sz.vtY * sz.vtZ;
+      for(idx = 0; idx < nVx; ++idx)
+      {
+        msk[idx] = (AlgRandUniform() < fill)?
+		   1 + (int )(AlgRandUniform() * 254.0): 0;
+      }
+      if(dim == 2)
+      {
+	nCon = 2;
+	con[0] = WLZ_4_CONNECTED;
+	con[1] = WLZ_8_CONNECTED;
+	nbr[0] = 4;
+	nbr[1] = 8;
+        gObj = WlzMakeRect(org.vtY, org.vtY + sz.vtY - 1,
+			   org.vtX, org.vtX + sz.vtX - 1,
+			   WLZ_GREY_UBYTE, (int *)msk, bgdV, NULL, NULL,
+			   &errNum);
+      }
+      else
+      {
+	nCon = 3;
+	con[0] = WLZ_6_CONNECTED;
+	con[1] = WLZ_18_CONNECTED;
+	con[2] = WLZ_26_CONNECTED;
+	nbr[0] = 6;
+	nbr[1] = 18;
+	nbr[2] = 26;
+        gObj = WlzMakeCuboid(org.vtZ, org.vtZ + sz.vtZ - 1,
+			     org.vtY, org.vtY + sz.vtY - 1,
+			     org.vtX, org.vtX + sz.vtX - 1,
+			     WLZ_GREY_UBYTE, bgdV, NULL, NULL, &errNum);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  int	idP;
+
+	  for(idP = 0; idP < sz.vtZ; ++idP)
+	  {
+	    (void )memcpy(gObj->values.vox->values[idP].r->values.ubp,
+	                  msk + (idP * sz.vtX * sz.vtY), sz.vtX * sz.vtY);
+	  }
+	}
+      }
+      gObj = WlzAssignObject(gObj, NULL);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        fObj = WlzAssignObject(
+	       WlzThreshold(gObj, thrV, WLZ_THRESH_HIGH, &errNum), NULL);
+      }
+      for(idC = 0; (errNum == WLZ_ERR_NONE) && (idC < nCon); ++idC)
+      {
+        int	nLbl = 0,
+		nFlood;
+	size_t	nBadC = 0,
+		nBadS = 0;
+	WlzObject *lObj = NULL;
+
+	nFlood = WlzTstLabelUFFlood(lbl, msk, dim, sz, con[idC], stk);
+	if(fObj->type != WLZ_EMPTY_OBJ)
+	{
+	  lObj = WlzAssignObject(
+		 WlzLabelUF(fObj, con[idC], 1, &nLbl, &errNum), NULL);
+	}
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  nBadC = WlzTstLabelUFCompare(lObj, nLbl, lbl, nFlood, msk,
+	                               org, sz, &errNum);
+	  nBad += nBadC;
+	}
+	if((errNum == WLZ_ERR_NONE) && (fObj->type != WLZ_EMPTY_OBJ))
+	{
+	  nBadS = WlzTstLabelUFStatsCompare(fObj, con[idC], dim, lbl, nFlood,
+	  				    msk, sz, &errNum);
+	  nBad += nBadS;
+	}
+	if(verbose)
+	{
+	  (void )printf("%dD %dx%dx%d %d connected: "
+	                "%d labels, %d flood filled, %lu bad, "
+			"%lu bad statistics\n",
+			dim, sz.vtX, sz.vtY, sz.vtZ, nbr[idC],
+			nLbl, nFlood, (unsigned long )nBadC,
+			(unsigned long )nBadS);
+	}
+	(void )WlzFreeObj(lObj);
+      }
+      (void )WlzFreeObj(fObj);
+      (void )WlzFreeObj(gObj);
+    }
+  }
+  AlcFree(msk);
+  AlcFree(lbl);
+  AlcFree(stk);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    ok = 0;
+    (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+    (void )fprintf(stderr,
+                   "%s: Failed to label objects (%s).\n",
+		   *argv, errMsgStr);
+  }
+  else if(nBad != 0)
+  {
+    ok = 0;
+    (void )fprintf(stderr,
+                   "%s: %lu labels differ from flood fill labels or\n"
+		   "component statistics differ.\n",
+		   *argv, (unsigned long )nBad);
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s%s",
+    *argv,
+    " [-h] [-v] [-f#] [-n#] [-s#]\n"
+    "Test for WlzLabelUF(). Random 2D and 3D domains are labelled with\n"
+    "each connectivity and the labelling is compared with a brute force\n"
+    "flood fill. The component statistics from WlzLabelUFStats() are\n"
+    "compared with those computed for each component. The exit status\n"
+    "is zero if the labellings and statistics agree.\n"
+    "Options:\n"
+    "  -h  Prints this usage information.\n"
+    "  -v  Verbose output.\n"
+    "  -f  Fraction of the voxels which are in the domains.\n"
+    "  -n  Number of 2D and 3D domains tested.\n"
+    "  -s  Seed for the random number generator.\n");
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Number of components.
+* \ingroup	BinWlzTst
+* \brief	Labels the connected components of a dense mask using a
+* 		flood fill. Labels start at one, with zero for elements
+* 		which are not in the mask.
+* \param	lbl			Destination for the labels.
+* \param	msk			The mask, non-zero within the domain.
+* \param	dim			Dimension, 2 or 3.
+* \param	sz			Size of the mask.
+* \param	con			Connectivity.
+* \param	stk			Workspace for the flood fill stack.
+*/
+static int	WlzTstLabelUFFlood(int *lbl, WlzUByte *msk, int dim,
+				   WlzIVertex3 sz, WlzConnectType con,
+				   int *stk)
+{
+  int		idx,
+  		nLbl = 0,
+		nVx;
+
+  nVx = sz.vtX * sz.vtY * sz.vtZ;
+  (void )memset(lbl, 0, nVx * sizeof(int));
+  for(idx = 0; idx < nVx; ++idx)
+  {
+    if(msk[idx] && (lbl[idx] == 0))
+    {
+      int	nStk = 0;
+
+      lbl[idx] = ++nLbl;
+      stk[nStk++] = idx;
+      while(nStk > 0)
+      {
+	int	dx,
+		dy,
+		dz,
+		dz0,
+		dz1,
+		p;
+	WlzIVertex3 pos;
+
+	p = stk[--nStk];
+	pos.vtX = p % sz.vtX;
+	pos.vtY = (p / sz.vtX) % sz.vtY;
+	pos.vtZ = p / (sz.vtX * sz.vtY);
+	dz0 = (dim == 2)? 0: -1;
+	dz1 = (dim == 2)? 0: 1;
+	for(dz = dz0; dz <= dz1; ++dz)
+	{
+	  for(dy = -1; dy <= 1; ++dy)
+	  {
+	    for(dx = -1; dx <= 1; ++dx)
+	    {
+	      int	d,
+	      		q;
+	      WlzIVertex3 nPos;
+
+	      /* Number of non-zero offsets, which determines whether
+	       * the neighbour is connected. */
+	      d = (dx != 0) + (dy != 0) + (dz != 0);
+	      if((d == 0) ||
+	         (((con == WLZ_4_CONNECTED) ||
+		   (con == WLZ_6_CONNECTED)) && (d > 1)) ||
+		 ((con == WLZ_18_CONNECTED) && (d > 2)))
+	      {
+	        continue;
+	      }
+	      nPos.vtX = pos.vtX + dx;
+	      nPos.vtY = pos.vtY + dy;
+	      nPos.vtZ = pos.vtZ + dz;
+	      if((nPos.vtX < 0) || (nPos.vtX >= sz.vtX) ||
+	         (nPos.vtY < 0) || (nPos.vtY >= sz.vtY) ||
+	         (nPos.vtZ < 0) || (nPos.vtZ >= sz.vtZ))
+	      {
+	        continue;
+	      }
+	      q = (nPos.vtZ * sz.vtY + nPos.vtY) * sz.vtX + nPos.vtX;
+	      if(msk[q] && (lbl[q] == 0))
+	      {
+	        lbl[q] = nLbl;
+		stk[nStk++] = q;
+	      }
+	    }
+	  }
+	}
+      }
+    }
+  }
+  return(nLbl);
+}
+
+/*!
+* \return	Number of elements at which the labellings disagree.
+* \ingroup	BinWlzTst
+* \brief	Compares the labelling of an index object from WlzLabelUF()
+* 		with a flood fill labelling. The number of labels must be
+* 		the same and each flood fill label must correspond to a
+* 		single distinct index.
+* \param	lObj			Index object, may be NULL if there
+* 					are no components.
+* \param	nLbl			Number of components of the index
+* 					object.
+* \param	lbl			Flood fill labels.
+* \param	nFlood			Number of flood fill labels.
+* \param	msk			The mask.
+* \param	org			Origin of the mask.
+* \param	sz			Size of the mask.
+* \param	dstErr			Destination error pointer.
+*/
+static size_t	WlzTstLabelUFCompare(WlzObject *lObj, int nLbl, int *lbl,
+				     int nFlood, WlzUByte *msk,
+				     WlzIVertex3 org, WlzIVertex3 sz,
+				     WlzErrorNum *dstErr)
+{
+  int		idx,
+  		nVx;
+  size_t	nBad = 0;
+  int		*fwd = NULL,
+  		*bwd = NULL;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(nLbl != nFlood)
+  {
+    nBad = (nLbl > nFlood)? nLbl - nFlood: nFlood - nLbl;
+  }
+  else if(nLbl > 0)
+  {
+    if(((fwd = (int *)AlcMalloc((nLbl + 1) * sizeof(int))) == NULL) ||
+       ((bwd = (int *)AlcMalloc((nLbl + 1) * sizeof(int))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      gVWSp = WlzGreyValueMakeWSp(lObj, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      for(idx = 0; idx <= nLbl; ++idx)
+      {
+	fwd[idx] = bwd[idx] = -1;
+      }
+      nVx = sz.vtX * sz.vtY * sz.vtZ;
+      for(idx = 0; idx < nVx; ++idx)
+      {
+	if(msk[idx])
+	{
+	  int	u,
+		  f;
+
+	  u = WlzGreyValueGetI(gVWSp,
+			       org.vtZ + (idx / (sz.vtX * sz.vtY)),
+			       org.vtY + ((idx / sz.vtX) % sz.vtY),
+			       org.vtX + (idx % sz.vtX));
+	  f = lbl[idx];
+	  if((u < 1) || (u > nLbl))
+	  {
+	    ++nBad;
+	  }
+	  else if((fwd[f] < 0) && (bwd[u] < 0))
+	  {
+	    fwd[f] = u;
+	    bwd[u] = f;
+	  }
+	  else if((fwd[f] != u) || (bwd[u] != f))
+	  {
+	    ++nBad;
+	  }
+	}
+      }
+    }
+    WlzGreyValueFreeWSp(gVWSp);
+  }
+  AlcFree(fwd);
+  AlcFree(bwd);
+  *dstErr = errNum;
+  return(nBad);
+}
+
+/*!
+* \return	Number of components with statistics which differ.
+* \ingroup	BinWlzTst
+* \brief	Compares the component statistics computed by
+* 		WlzLabelUFStats() with those computed for each of the
+* 		component objects by WlzArea() or WlzVolume(),
+* 		WlzBoundingBox3I(), WlzCentreOfMass2D() or
+* 		WlzCentreOfMass3D() and WlzGreyStats(). The second order
+* 		moments are compared with those computed from the flood
+* 		fill labels, which are in the same (raster) order as the
+* 		components.
+* \param	fObj			Given domain object with grey values.
+* \param	con			Connectivity.
+* \param	dim			Dimension, 2 or 3.
+* \param	lbl			Flood fill labels for the connectivity.
+* \param	nFlood			Number of flood fill labels.
+* \param	msk			The mask.
+* \param	sz			Size of the mask.
+* \param	dstErr			Destination error pointer.
+*/
+static size_t	WlzTstLabelUFStatsCompare(WlzObject *fObj,
+					  WlzConnectType con, int dim,
+					  int *lbl, int nFlood,
+					  WlzUByte *msk, WlzIVertex3 sz,
+					  WlzErrorNum *dstErr)
+{
+  int		idx,
+  		nVx;
+  size_t	nBad = 0;
+  double	*sum = NULL;
+  WlzObject	*cObj = NULL;
+  WlzCompoundArray *cpd = NULL;
+  WlzLabelStats	*stats = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const int	nSum = 10;
+
+  stats = WlzLabelUFStats(fObj, con, 1, 0, &cObj, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    cObj = WlzAssignObject(cObj, NULL);
+    cpd = (WlzCompoundArray *)cObj;
+    if((cObj->type != WLZ_COMPOUND_ARR_1) ||
+       (stats->nLbl != cpd->n) || (stats->nLbl != nFlood) ||
+       (stats->grey == 0) || (stats->gType != WLZ_GREY_UBYTE))
+    {
+      nBad = WLZ_MAX(stats->nLbl, 1);
+    }
+    else if((sum = (double *)AlcCalloc(nSum * WLZ_MAX(nFlood, 1),
+    				       sizeof(double))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (nBad == 0))
+  {
+    /* Moments about the mask origin from the flood fill labels. */
+    nVx = sz.vtX * sz.vtY * sz.vtZ;
+    for(idx = 0; idx < nVx; ++idx)
+    {
+      if(msk[idx])
+      {
+	double	x,
+		y,
+		z;
+	double	*s;
+
+	s = sum + nSum * (lbl[idx] - 1);
+	x = idx % sz.vtX;
+	y = (idx / sz.vtX) % sz.vtY;
+	z = idx / (sz.vtX * sz.vtY);
+	s[0] += 1.0;
+	s[1] += x;
+	s[2] += y;
+	s[3] += z;
+	s[4] += x * x;
+	s[5] += y * y;
+	s[6] += z * z;
+	s[7] += x * y;
+	s[8] += x * z;
+	s[9] += y * z;
+      }
+    }
+    for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < nFlood); ++idx)
+    {
+      int	bad = 0;
+      WlzLong	vol;
+      double	mass = 0.0,
+		gMin = 0.0,
+		gMax = 0.0,
+		gSum = 0.0,
+		gSumSq = 0.0,
+		gMean = 0.0,
+		gStdDev = 0.0;
+      double	*s;
+      WlzDVertex3 c,
+      		cen;
+      WlzIBox3	bBox;
+      WlzGreyType gType = WLZ_GREY_ERROR;
+      WlzObject	*obj;
+      WlzLabelStat *st;
+      double	mom[6];
+
+      obj = cpd->o[idx];
+      st = stats->stat + idx;
+      s = sum + nSum * idx;
+      if(dim == 2)
+      {
+	WlzDVertex2 cen2;
+
+        vol = WlzArea(obj, &errNum);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  cen2 = WlzCentreOfMass2D(obj, 1, &mass, &errNum);
+	  cen.vtX = cen2.vtX;
+	  cen.vtY = cen2.vtY;
+	  cen.vtZ = 0.0;
+	}
+      }
+      else
+      {
+        vol = WlzVolume(obj, &errNum);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  cen = WlzCentreOfMass3D(obj, 1, &mass, &errNum);
+	}
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+        bBox = WlzBoundingBox3I(obj, &errNum);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+        (void )WlzGreyStats(obj, &gType, &gMin, &gMax, &gSum, &gSumSq,
+			    &gMean, &gStdDev, &errNum);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	c.vtX = s[1] / s[0];
+	c.vtY = s[2] / s[0];
+	c.vtZ = s[3] / s[0];
+	mom[0] = (s[4] / s[0]) - (c.vtX * c.vtX);
+	mom[1] = (s[5] / s[0]) - (c.vtY * c.vtY);
+	mom[2] = (s[6] / s[0]) - (c.vtZ * c.vtZ);
+	mom[3] = (s[7] / s[0]) - (c.vtX * c.vtY);
+	mom[4] = (s[8] / s[0]) - (c.vtX * c.vtZ);
+	mom[5] = (s[9] / s[0]) - (c.vtY * c.vtZ);
+	bad = (st->vol != (double )vol) || (s[0] != (double )vol) ||
+	      (st->bBox.xMin != bBox.xMin) || (st->bBox.xMax != bBox.xMax) ||
+	      (st->bBox.yMin != bBox.yMin) || (st->bBox.yMax != bBox.yMax) ||
+	      (st->bBox.zMin != bBox.zMin) || (st->bBox.zMax != bBox.zMax) ||
+	      WlzTstLabelUFDiff(st->cen.vtX, cen.vtX) ||
+	      WlzTstLabelUFDiff(st->cen.vtY, cen.vtY) ||
+	      WlzTstLabelUFDiff(st->cen.vtZ, cen.vtZ) ||
+	      WlzTstLabelUFDiff(st->mom[0], mom[0]) ||
+	      WlzTstLabelUFDiff(st->mom[1], mom[1]) ||
+	      WlzTstLabelUFDiff(st->mom[2], mom[2]) ||
+	      WlzTstLabelUFDiff(st->mom[3], mom[3]) ||
+	      WlzTstLabelUFDiff(st->mom[4], mom[4]) ||
+	      WlzTstLabelUFDiff(st->mom[5], mom[5]) ||
+	      (st->gMin != gMin) || (st->gMax != gMax) ||
+	      (st->gSum != gSum) || (st->gSumSq != gSumSq) ||
+	      WlzTstLabelUFDiff(st->gMean, gMean) ||
+	      WlzTstLabelUFDiff(st->gStdDev, gStdDev);
+	nBad += (bad != 0);
+      }
+    }
+  }
+  AlcFree(sum);
+  (void )WlzFreeObj(cObj);
+  (void )WlzFreeLabelStats(stats);
+  *dstErr = errNum;
+  return(nBad);
+}
+
+/*!
+* \return	Non-zero if the values differ.
+* \ingroup	BinWlzTst
+* \brief	Compares two floating point values allowing for rounding
+* 		errors.
+* \param	v0			First value.
+* \param	v1			Second value.
+*/
+static int	WlzTstLabelUFDiff(double v0, double v1)
+{
+  double	d;
+
+  d = fabs(v0 - v1);
+  return(!(d <= 1.0e-9 * (1.0 + fabs(v0) + fabs(v1))));
+}
@@ -0,0 +1,493 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstSectionCache_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstSectionCache.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the section cache, see WlzSectionCacheGet().
+* 		Sections are cut from a random 3D object through a
+* 		cache which can hold only a few sections. Each section
+* 		is compared with one cut directly using the snapped
+* 		view, views within the quanta must be found in the
+* 		cache and the hit, miss and eviction counts must be
+* 		those expected. Removing the object from the cache and
+* 		freeing the cache must release all of the cache's
+* 		references to the object.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Wlz.h>
+
+static int			WlzTstSectionCacheCmpSec(
+				  WlzObject *sec0,
+				  WlzObject *sec1,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzTstSectionCacheCut(
+				  WlzObject *obj,
+				  WlzThreeDViewStruct *view,
+				  double angQ,
+				  double distQ,
+				  WlzErrorNum *dstErr);
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+
+int		main(int argc, char *argv[])
+{
+  int		option,
+		idV,
+  		ok = 1,
+		usage = 0,
+		verbose = 0,
+		maxSec = 4,
+		nView = 12;
+  long		seed = 0;
+  size_t	nBad = 0,
+  		hits = 0,
+		misses = 0;
+  double	angQ = 0.01,
+  		distQ = 0.5;
+  WlzIVertex3	sz;
+  WlzPixelV	bgdV;
+  WlzObject	*obj = NULL;
+  WlzObject	**secs = NULL;
+  WlzThreeDViewStruct **views = NULL;
+  WlzSectionCache *cache = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const char	*errMsgStr;
+  static char   optList[] = "hvc:n:s:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'c':
+        usage = (sscanf(optarg, "%d", &maxSec) != 1) || (maxSec < 1);
+	break;
+      case 'n':
+        usage = (sscanf(optarg, "%d", &nView) != 1) || (nView < 1);
+	break;
+      case 's':
+        usage = (sscanf(optarg, "%ld", &seed) != 1);
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+        usage = 1;
+	break;
+    }
+  }
+  ok = (usage == 0) && (optind == argc);
+  usage = !ok;
+  /* Create a 3D object with random values. */
+  if(ok)
+  {
+    AlgRandSeed(seed);
+    sz.vtX = 48;
+    sz.vtY = 40;
+    sz.vtZ = 32;
+    bgdV.type = WLZ_GREY_UBYTE;
+    bgdV.v.ubv = 0;
+    obj = WlzAssignObject(
+	  WlzMakeCuboid(-3, sz.vtZ - 4, 5, sz.vtY + 4, -7, sz.vtX - 8,
+			WLZ_GREY_UBYTE, bgdV, NULL, NULL, &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      int	idP;
+
+      for(idP = 0; idP < sz.vtZ; ++idP)
+      {
+	size_t	idx;
+	WlzUByte *ubp;
+
+	ubp = obj->values.vox->values[idP].r->values.ubp;
+	for(idx = 0; idx < (size_t )(sz.vtX) * sz.vtY; ++idx)
+	{
+	  ubp[idx] = (WlzUByte )(1 + AlgRandUniform() * 254.0);
+	}
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if(((secs = (WlzObject **)
+                  AlcCalloc(nView, sizeof(WlzObject *))) == NULL) ||
+         ((views = (WlzThreeDViewStruct **)
+	           AlcCalloc(nView,
+		             sizeof(WlzThreeDViewStruct *))) == NULL))
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      cache = WlzMakeSectionCache(maxSec, 1L << 30, angQ, distQ, 0.01,
+      				  &errNum);
+    }
+  }
+  /* Cut sections for distinct random views, each must be a miss
+   * and must match the section cut directly using the snapped
+   * view. */
+  for(idV = 0; (errNum == WLZ_ERR_NONE) && (idV < nView); ++idV)
+  {
+    WlzThreeDViewStruct *view;
+
+    if((view = WlzMake3DViewStruct(WLZ_3D_VIEW_STRUCT, &errNum)) != NULL)
+    {
+      views[idV] = view;
+      view->view_mode = WLZ_UP_IS_UP_MODE;
+      view->up.vtX = view->up.vtY = 0.0; view->up.vtZ = 1.0;
+      view->scale = 1.0;
+      view->theta = AlgRandUniform() * ALG_M_PI;
+      view->phi = AlgRandUniform() * ALG_M_PI;
+      view->zeta = 0.0;
+      view->fixed.vtX = 16.0;
+      view->fixed.vtY = 24.0;
+      view->fixed.vtZ = 12.0;
+      /* Distances differ by more than the quantum so the views
+       * are distinct. */
+      view->dist = (idV - (nView / 2)) * 2.0 * distQ +
+                   (AlgRandUniform() - 0.5) * 0.5 * distQ;
+      secs[idV] = WlzSectionCacheGet(cache, obj, view,
+      				     WLZ_INTERPOLATION_NEAREST, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzObject	*rSec;
+
+      ++misses;
+      rSec = WlzAssignObject(
+             WlzTstSectionCacheCut(obj, view, angQ, distQ, &errNum), NULL);
+      if((errNum == WLZ_ERR_NONE) &&
+         WlzTstSectionCacheCmpSec(secs[idV], rSec, &errNum))
+      {
+	++nBad;
+	if(verbose)
+	{
+	  (void )printf("view %d: section differs from direct section\n",
+	                idV);
+	}
+      }
+      (void )WlzFreeObj(rSec);
+    }
+  }
+  /* Views perturbed within the quanta must be found in the cache if
+   * they are among the most recently used, otherwise they must be
+   * cut again. */
+  for(idV = nView - 1; (errNum == WLZ_ERR_NONE) && (idV >= 0); --idV)
+  {
+    WlzObject	*sec;
+    WlzThreeDViewStruct *view;
+
+    view = WlzMake3DViewStructCopy(views[idV], &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      size_t	hits0;
+
+      view->theta = WLZ_NINT(view->theta / angQ) * angQ + 0.2 * angQ;
+      view->phi = WLZ_NINT(view->phi / angQ) * angQ - 0.2 * angQ;
+      view->dist = WLZ_NINT(view->dist / distQ) * distQ + 0.2 * distQ;
+      hits0 = cache->hits;
+      sec = WlzSectionCacheGet(cache, obj, view,
+      			       WLZ_INTERPOLATION_NEAREST, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	int	expectHit;
+
+	expectHit = idV >= nView - maxSec;
+	if(expectHit)
+	{
+	  ++hits;
+	}
+	else
+	{
+	  ++misses;
+	}
+	if((expectHit != (cache->hits > hits0)) ||
+	   (expectHit && (sec != secs[idV])) ||
+	   WlzTstSectionCacheCmpSec(sec, secs[idV], &errNum))
+	{
+	  ++nBad;
+	  if(verbose)
+	  {
+	    (void )printf("view %d: %s expected but not found\n",
+			  idV, (expectHit)? "hit": "miss");
+	  }
+	}
+      }
+      (void )WlzFreeObj(sec);
+      (void )WlzFree3DViewStruct(view);
+    }
+  }
+  /* Check the counts. Each miss adds a section, so all but the
+   * most recent sections must have been evicted. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    size_t	evictions;
+
+    evictions = (misses > (size_t )maxSec)? misses - maxSec: 0;
+    if(verbose)
+    {
+      (void )printf("hits %lu (%lu), misses %lu (%lu), "
+                    "evictions %lu (%lu)\n",
+		    (unsigned long )(cache->hits), (unsigned long )hits,
+		    (unsigned long )(cache->misses), (unsigned long )misses,
+		    (unsigned long )(cache->evictions),
+		    (unsigned long )evictions);
+    }
+    if((cache->hits != hits) || (cache->misses != misses) ||
+       (cache->evictions != evictions))
+    {
+      ++nBad;
+    }
+  }
+  /* Removing the object must evict all of its sections, leaving the
+   * sections held by the caller valid. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzSectionCacheRemoveObj(cache, obj);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((cache->evictions != misses) || (obj->linkcount != 1))
+    {
+      ++nBad;
+      if(verbose)
+      {
+        (void )printf("evictions %lu (%lu) after removal, "
+	              "object link count %d\n",
+		      (unsigned long )(cache->evictions),
+		      (unsigned long )misses, obj->linkcount);
+      }
+    }
+  }
+  /* A view which was cached before the removal must now be a
+   * miss and freeing the cache must release the object. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzObject	*sec;
+
+    sec = WlzSectionCacheGet(cache, obj, views[nView - 1],
+    			     WLZ_INTERPOLATION_NEAREST, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if((cache->misses != misses + 1) ||
+         WlzTstSectionCacheCmpSec(sec, secs[nView - 1], &errNum))
+      {
+        ++nBad;
+      }
+    }
+    (void )WlzFreeObj(sec);
+  }
+  if(cache)
+  {
+    (void )WlzFreeSectionCache(cache);
+    if((errNum == WLZ_ERR_NONE) && (obj->linkcount != 1))
+    {
+      ++nBad;
+    }
+  }
+  if(secs)
+  {
+    for(idV = 0; idV < nView; ++idV)
+    {
+      (void )WlzFreeObj(secs[idV]);
+      if(views[idV])
+      {
+	(void )WlzFree3DViewStruct(views[idV]);
+      }
+    }
+    AlcFree(secs);
+    AlcFree(views);
+  }
+  (void )WlzFreeObj(obj);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    ok = 0;
+    (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+    (void )fprintf(stderr,
+                   "%s: Failed to test section cache (%s).\n",
+		   *argv, errMsgStr);
+  }
+  else if(nBad != 0)
+  {
+    ok = 0;
+    (void )fprintf(stderr,
+                   "%s: %lu section cache tests failed.\n",
+		   *argv, (unsigned long )nBad);
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s%s",
+    *argv,
+    " [-h] [-v] [-c#] [-n#] [-s#]\n"
+    "Test for the section cache. Sections are cut from a random 3D\n"
+    "object through a small cache and compared with sections cut\n"
+    "directly. The exit status is zero if all the tests pass.\n"
+    "Options:\n"
+    "  -h  Prints this usage information.\n"
+    "  -v  Verbose output.\n"
+    "  -c  Maximum number of cached sections.\n"
+    "  -n  Number of views.\n"
+    "  -s  Seed for the random number generator.\n");
+  }
+  return(!ok);
+}
+
+/*!
+* \return	New section or NULL on error.
+* \ingroup	BinWlzTst
+* \brief	Cuts a section directly from the given object using a
+* 		copy of the given view with its angles and distance
+* 		snapped to the given quanta.
+* \param	obj			Given object.
+* \param	view			Given view.
+* \param	angQ			Quantum for the angles.
+* \param	distQ			Quantum for the distance and fixed
+* 					point.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *WlzTstSectionCacheCut(WlzObject *obj,
+				WlzThreeDViewStruct *view,
+				double angQ, double distQ,
+				WlzErrorNum *dstErr)
+{
+  WlzObject	*sec = NULL;
+  WlzThreeDViewStruct *qView;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  qView = WlzMake3DViewStructCopy(view, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    qView->theta = WLZ_NINT(view->theta / angQ) * angQ;
+    qView->phi = WLZ_NINT(view->phi / angQ) * angQ;
+    qView->zeta = WLZ_NINT(view->zeta / angQ) * angQ;
+    qView->dist = WLZ_NINT(view->dist / distQ) * distQ;
+    qView->fixed.vtX = WLZ_NINT(view->fixed.vtX / distQ) * distQ;
+    qView->fixed.vtY = WLZ_NINT(view->fixed.vtY / distQ) * distQ;
+    qView->fixed.vtZ = WLZ_NINT(view->fixed.vtZ / distQ) * distQ;
+    errNum = WlzInit3DViewStruct(qView, obj);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      sec = WlzGetSectionFromObject(obj, qView,
+      				    WLZ_INTERPOLATION_NEAREST, &errNum);
+    }
+    (void )WlzFree3DViewStruct(qView);
+  }
+  *dstErr = errNum;
+  return(sec);
+}
+
+/*!
+* \return	Non-zero if the sections differ.
+* \ingroup	BinWlzTst
+* \brief	Compares two sections, which must have the same type,
+* 		the same domain and the same values.
+* \param	sec0			First section.
+* \param	sec1			Second section.
+* \param	dstErr			Destination error pointer.
+*/
+static int	WlzTstSectionCacheCmpSec(WlzObject *sec0, WlzObject *sec1,
+				         WlzErrorNum *dstErr)
+{
+  int		differ = 0;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((sec0 == NULL) || (sec1 == NULL) || (sec0->type != sec1->type))
+  {
+    differ = 1;
+  }
+  else if(sec0->type == WLZ_2D_DOMAINOBJ)
+  {
+    WlzIBox2	box0,
+    		box1;
+
+    box0 = WlzBoundingBox2I(sec0, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      box1 = WlzBoundingBox2I(sec1, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      differ = (box0.xMin != box1.xMin) || (box0.xMax != box1.xMax) ||
+               (box0.yMin != box1.yMin) || (box0.yMax != box1.yMax) ||
+	       (WlzArea(sec0, NULL) != WlzArea(sec1, NULL));
+    }
+    if((errNum == WLZ_ERR_NONE) && !differ)
+    {
+      gVWSp = WlzGreyValueMakeWSp(sec1, &errNum);
+    }
+    if((errNum == WLZ_ERR_NONE) && !differ)
+    {
+      WlzIntervalWSpace iWSp;
+      WlzGreyWSpace gWSp;
+
+      errNum = WlzInitGreyScan(sec0, &iWSp, &gWSp);
+      while((errNum == WLZ_ERR_NONE) &&
+            ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
+      {
+	int	k;
+
+	for(k = 0; k < iWSp.colrmn; ++k)
+	{
+	  int	kol;
+
+	  kol = iWSp.lftpos + k;
+	  WlzGreyValueGet(gVWSp, 0, iWSp.linpos, kol);
+	  if(!WlzInsideDomain(sec1, 0.0, iWSp.linpos, kol, NULL) ||
+	     (gVWSp->gVal[0].ubv != gWSp.u_grintptr.ubp[k]))
+	  {
+	    differ = 1;
+	  }
+	}
+      }
+      if(errNum == WLZ_ERR_EOO)
+      {
+        errNum = WLZ_ERR_NONE;
+      }
+    }
+    WlzGreyValueFreeWSp(gVWSp);
+  }
+  *dstErr = errNum;
+  return(differ);
+}
@@ -0,0 +1,407 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstTiledCompress_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstTiledCompress.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Round trip test for tiled values with compressed tiles.
+* 		A synthetic 3D object with tiled values is written with
+* 		compressed tiles and read back. Some of the values of the
+* 		object read are then modified through a small tile cache,
+* 		so that modified tiles are evicted and decoded again, and
+* 		the object is written and read once more. The values are
+* 		compared with those of an uncompressed copy of the object
+* 		to which the same modifications are made.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <Wlz.h>
+
+static int			WlzTstTiledCmpValue(
+				  int pl,
+				  int ln,
+				  int kl);
+static int			WlzTstTiledCmpModify(
+				  int pl,
+				  int ln,
+				  int kl);
+static WlzObject		*WlzTstTiledCmpRoundTrip(
+				  WlzObject *obj,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzTstTiledCmpSet(
+				  WlzObject *obj,
+				  int modify);
+static size_t			WlzTstTiledCmpCompare(
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  WlzErrorNum *dstErr);
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+
+int		main(int argc, char *argv[])
+{
+  int		option,
+  		ok = 1,
+		usage = 0,
+		verbose = 0;
+  unsigned int	maxTiles = 2;
+  size_t	nBad = 0;
+  WlzPixelV	bgdV;
+  WlzObject	*obj = NULL,
+  		*tlObj = NULL,
+		*rdObj = NULL,
+		*wrObj = NULL;
+  WlzTiledValuesCache *cache = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const char	*errMsgStr;
+  const size_t	tlSz = 4096;
+  static char   optList[] = "hvc:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'c':
+        usage = (sscanf(optarg, "%u", &maxTiles) != 1) || (maxTiles < 1);
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+        usage = 1;
+	break;
+    }
+  }
+  ok = (usage == 0) && (optind == argc);
+  usage = !ok;
+  if(ok)
+  {
+    /* Create an object with tiled values which are to be written with
+     * compressed tiles. */
+    bgdV.type = WLZ_GREY_UBYTE;
+    bgdV.v.ubv = 0;
+    obj = WlzAssignObject(
+	  WlzMakeCuboid(0, 31, 0, 39, 0, 47, WLZ_GREY_UBYTE, bgdV,
+	                NULL, NULL, &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzTstTiledCmpSet(obj, 0);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      tlObj = WlzAssignObject(
+	      WlzMakeTiledValuesFromObj(obj, tlSz, 1, WLZ_GREY_UBYTE, bgdV,
+					&errNum), NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      tlObj->values.t->compression = WLZ_TILED_COMPRESS_DELTA_RLE;
+      rdObj = WlzTstTiledCmpRoundTrip(tlObj, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      nBad = WlzTstTiledCmpCompare(obj, rdObj, &errNum);
+      if(verbose)
+      {
+	(void )printf("read compressed: %lu bad values\n",
+		      (unsigned long )nBad);
+      }
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+                     "%s: Failed to write and read compressed tiles (%s).\n",
+		     *argv, errMsgStr);
+    }
+  }
+  if(ok && (nBad == 0))
+  {
+    /* Modify the values through a small cache so that modified tiles are
+     * evicted, written back and then decoded again. */
+    cache = WlzMakeTiledValuesCache(maxTiles,
+                                    (maxTiles * tlSz * sizeof(WlzUByte)) + 1,
+				    &errNum);
+    if((errNum == WLZ_ERR_NONE) && (rdObj->values.t->cTiles != NULL))
+    {
+      /* Without memory mapping all of the tiles are decoded when read. */
+      errNum = WlzTiledValuesCacheAttach(rdObj->values.t, cache);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzTstTiledCmpSet(obj, 1);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzTstTiledCmpSet(rdObj, 1);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      nBad = WlzTstTiledCmpCompare(obj, rdObj, &errNum);
+      if(verbose)
+      {
+	(void )printf("modified: %lu bad values, %lu evictions\n",
+		      (unsigned long )nBad,
+		      (unsigned long )(cache->evictions));
+      }
+    }
+    if((errNum == WLZ_ERR_NONE) && (nBad == 0))
+    {
+      wrObj = WlzTstTiledCmpRoundTrip(rdObj, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	nBad = WlzTstTiledCmpCompare(obj, wrObj, &errNum);
+	if(verbose)
+	{
+	  (void )printf("modified and read compressed: %lu bad values\n",
+			(unsigned long )nBad);
+	}
+      }
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+                     "%s: Failed to modify compressed tiles (%s).\n",
+		     *argv, errMsgStr);
+    }
+  }
+  if(ok && (nBad != 0))
+  {
+    ok = 0;
+    (void )fprintf(stderr,
+                   "%s: %lu values differ after round trip.\n",
+		   *argv, (unsigned long )nBad);
+  }
+  if(cache)
+  {
+    (void )WlzFreeTiledValuesCache(cache);
+  }
+  (void )WlzFreeObj(wrObj);
+  (void )WlzFreeObj(rdObj);
+  (void )WlzFreeObj(tlObj);
+  (void )WlzFreeObj(obj);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s%s",
+    *argv,
+    " [-h] [-v] [-c#]\n"
+    "Round trip test for tiled values with compressed tiles. A synthetic\n"
+    "object with tiled values is written with compressed tiles and read\n"
+    "back, then some of it's values are modified and it is written and\n"
+    "read again. The exit status is zero if all values are preserved.\n"
+    "Options:\n"
+    "  -h  Prints this usage information.\n"
+    "  -v  Verbose output.\n"
+    "  -c  Maximum number of tiles in the cache used while modifying\n"
+    "      values.\n");
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Value for the given position.
+* \ingroup	BinWlzTst
+* \brief	Computes the initial test value at a position, which
+* 		varies smoothly with some noise.
+* \param	pl			Plane coordinate.
+* \param	ln			Line coordinate.
+* \param	kl			Column coordinate.
+*/
+static int	WlzTstTiledCmpValue(int pl, int ln, int kl)
+{
+  int		v;
+
+  v = (kl + (2 * ln) + (3 * pl) + (((kl * 7) ^ (ln * 13)) & 0x3)) & 0xff;
+  return(v);
+}
+
+/*!
+* \return	Non-zero if the value at the position is modified.
+* \ingroup	BinWlzTst
+* \brief	Decides whether the value at a position is to be modified.
+* \param	pl			Plane coordinate.
+* \param	ln			Line coordinate.
+* \param	kl			Column coordinate.
+*/
+static int	WlzTstTiledCmpModify(int pl, int ln, int kl)
+{
+  return((((kl * ln) + pl) % 11) == 0);
+}
+
+/*!
+* \return	Object read back.
+* \ingroup	BinWlzTst
+* \brief	Writes the given object to a temporary file and reads
+* 		it back.
+* \param	obj			Given object.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *WlzTstTiledCmpRoundTrip(WlzObject *obj,
+				WlzErrorNum *dstErr)
+{
+  FILE		*fP;
+  WlzObject	*rObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((fP = tmpfile()) == NULL)
+  {
+    errNum = WLZ_ERR_FILE_OPEN;
+  }
+  else
+  {
+    errNum = WlzWriteObj(fP, obj);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      rewind(fP);
+      rObj = WlzAssignObject(WlzReadObj(fP, &errNum), NULL);
+    }
+    (void )fclose(fP);
+  }
+  *dstErr = errNum;
+  return(rObj);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	BinWlzTst
+* \brief	Sets the values of the given 3D cuboid object, either
+* 		all to their initial values or just those which are to
+* 		be modified to 7.
+* \param	obj			Given object.
+* \param	modify			Only set modified values if non-zero.
+*/
+static WlzErrorNum WlzTstTiledCmpSet(WlzObject *obj, int modify)
+{
+  int		pl,
+  		ln,
+		kl;
+  WlzIBox3	box;
+  WlzGreyValueWSpace *gVWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  box = WlzBoundingBox3I(obj, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gVWSp = WlzGreyValueMakeWSp(obj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(pl = box.zMin; pl <= box.zMax; ++pl)
+    {
+      for(ln = box.yMin; ln <= box.yMax; ++ln)
+      {
+	for(kl = box.xMin; kl <= box.xMax; ++kl)
+	{
+	  if(modify == 0)
+	  {
+	    WlzGreyValueGet(gVWSp, pl, ln, kl);
+	    *(gVWSp->gPtr[0].ubp) = WlzTstTiledCmpValue(pl, ln, kl);
+	  }
+	  else if(WlzTstTiledCmpModify(pl, ln, kl))
+	  {
+	    WlzGreyValueGet(gVWSp, pl, ln, kl);
+	    *(gVWSp->gPtr[0].ubp) = 7;
+	  }
+	}
+      }
+    }
+    WlzGreyValueFreeWSp(gVWSp);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Number of values which differ.
+* \ingroup	BinWlzTst
+* \brief	Compares the values of two 3D objects throughout the
+* 		bounding box of the first.
+* \param	obj0			First object.
+* \param	obj1			Second object.
+* \param	dstErr			Destination error pointer.
+*/
+static size_t	WlzTstTiledCmpCompare(WlzObject *obj0, WlzObject *obj1,
+				      WlzErrorNum *dstErr)
+{
+  int		pl,
+  		ln,
+		kl;
+  size_t	nBad = 0;
+  WlzIBox3	box;
+  WlzGreyValueWSpace *gVWSp0 = NULL,
+  		*gVWSp1 = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  box = WlzBoundingBox3I(obj0, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gVWSp0 = WlzGreyValueMakeWSp(obj0, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gVWSp1 = WlzGreyValueMakeWSp(obj1, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(pl = box.zMin; pl <= box.zMax; ++pl)
+    {
+      for(ln = box.yMin; ln <= box.yMax; ++ln)
+      {
+	for(kl = box.xMin; kl <= box.xMax; ++kl)
+	{
+	  WlzGreyValueGet(gVWSp0, pl, ln, kl);
+	  WlzGreyValueGet(gVWSp1, pl, ln, kl);
+	  if(gVWSp0->gVal[0].ubv != gVWSp1->gVal[0].ubv)
+	  {
+	    ++nBad;
+	  }
+	}
+      }
+    }
+  }
+  WlzGreyValueFreeWSp(gVWSp0);
+  WlzGreyValueFreeWSp(gVWSp1);
+  *dstErr = errNum;
+  return(nBad);
+}
@@ -48,6 +48,7 @@ static char _AlcFreeStack_c[] = "University of Edinburgh $Id$";
 typedef struct _AlcFreeStack
 {
   void		*data;
+  void		(*freeFn)(void *);
   struct _AlcFreeStack *prev;
 } AlcFreeStack;
 
@@ -63,6 +64,29 @@ typedef struct _AlcFreeStack
 *					may be NULL
 */
 void 		*AlcFreeStackPush(void *prev, void *data, AlcErrno *dstErr)
+{
+  return(AlcFreeStackPushFn(prev, data, NULL, dstErr));
+}
+
+/*!
+* \return	New free stack pointer or NULL on error.
+* \ingroup	AlcFreeStack
+* \brief	Push's the given pointer onto the free stack on top
+*		of the previous free stack pointer, along with a function
+*		which will be used to free the data in place of AlcFree().
+*		This allows data which has not been allocated using
+*		AlcMalloc(), eg memory mapped data, to be kept on a free
+*		stack.
+* \param	prev 			Previous free stack pointer.
+* \param	data 			New pointer to push onto the
+*					free stack.
+* \param	freeFn			Function to free the data, if NULL
+*					then AlcFree() is used.
+* \param	dstErr 			Destination error pointer,
+*					may be NULL
+*/
+void 		*AlcFreeStackPushFn(void *prev, void *data,
+				    void (*freeFn)(void *), AlcErrno *dstErr)
 {
   AlcFreeStack *fPtr = NULL;
   AlcErrno	errNum = ALC_ER_NONE;
@@ -74,6 +98,7 @@ void 		*AlcFreeStackPush(void *prev, void *data, AlcErrno *dstErr)
   else
   {
     fPtr->data = data;
+    fPtr->freeFn = freeFn;
     fPtr->prev = (AlcFreeStack *)prev;
   }
   if(dstErr)
@@ -148,7 +173,14 @@ AlcErrno	AlcFreeStackFree(void *stack)
       entry0 = entry1->prev;
       if(entry1->data)
       {
-        AlcFree(entry1->data);
+	if(entry1->freeFn)
+	{
+	  (*(entry1->freeFn))(entry1->data);
+	}
+	else
+	{
+          AlcFree(entry1->data);
+	}
       }
       AlcFree(entry1);
     }
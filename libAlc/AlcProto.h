@@ -444,6 +444,11 @@ extern void            		*AlcFreeStackPush(
 				  void *prev,
 				  void *data,
 				  AlcErrno *dstErr);
+extern void            		*AlcFreeStackPushFn(
+				  void *prev,
+				  void *data,
+				  void (*freeFn)(void *),
+				  AlcErrno *dstErr);
 extern void			*AlcFreeStackPop(
 				  void *prev,
 				  void **dstData,
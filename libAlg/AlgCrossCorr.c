@@ -46,12 +46,22 @@ static char _AlgCrossCorr_c[] = "University of Edinburgh $Id$";
 #include <float.h>
 
 
+static void			AlgCrossCorrSpectra2D(
+				  double **data0,
+				  double **data1,
+				  int nX,
+				  int nY);
+
 /*!
 * \return	Error code.
 * \ingroup	AlgCorr
 * \brief	Cross correlates the given 2D double arrays leaving
 *		the result in the first of the two arrays.
 *		The cross correlation data are un-normalized.
+*		The transforms use the cached kernels of AlgFourReal2D(),
+*		callers which cross correlate many arrays of the same
+*		size may instead make a plan once and use
+*		AlgCrossCorrelate2DPlan().
 * \param	data0			Data for/with obj0's FFT 
 *					(source: AlcDouble2Malloc)
 *					which holds the cross	
@@ -59,16 +69,107 @@ static char _AlgCrossCorr_c[] = "University of Edinburgh $Id$";
 * \param	data1			Data for/with obj1's FFT 
 *					(source: AlcDouble2Malloc).
 * \param	nX			Number of columns in each of the
-*					data arrays.
+*					data arrays, which must be even
+*					(see AlgFourNextFastSize()).
 * \param	nY			Number of lines in each of the
-*					data arrays.
+*					data arrays, which must be even.
 */
 AlgError	AlgCrossCorrelate2D(double **data0, double **data1,
 			            int nX, int nY)
 {
-  int		tI0,
-		tI1,
-		idX,
+  AlgError	errNum = ALG_ERR_NONE;
+  const int	minN = 8,
+  		maxN = 1048576;
+
+  if((data0 == NULL) || (data1 == NULL) ||
+     (nX < minN) || (nX > maxN) || (nY < minN) || (nY > maxN) ||
+     ((nX & 1) != 0) || ((nY & 1) != 0))
+  {
+     errNum = ALG_ERR_FUNC;
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourReal2D(data0, 0, nX, nY);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourReal2D(data1, 0, nX, nY);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    AlgCrossCorrSpectra2D(data0, data1, nX, nY);
+    errNum = AlgFourRealInv2D(data0, 0, nX, nY);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgCorr
+* \brief	Cross correlates the given 2D double arrays using the
+*		given plan, leaving the result in the first of the two
+*		arrays. This is equivalent to AlgCrossCorrelate2D() but
+*		avoids getting the transform kernels for each call.
+*		The cross correlation data are un-normalized.
+* \param	plan			Two dimensional real plan made by
+*					AlgFourPlanMake() for the size of
+*					the data arrays, which must both
+*					be even.
+* \param	data0			Data for/with obj0's FFT 
+*					(source: AlcDouble2Malloc)
+*					which holds the cross	
+*					correlation data on return.
+* \param	data1			Data for/with obj1's FFT 
+*					(source: AlcDouble2Malloc).
+*/
+AlgError	AlgCrossCorrelate2DPlan(const AlgFourPlan *plan,
+					double **data0, double **data1)
+{
+  AlgError	errNum = ALG_ERR_NONE;
+  const int	minN = 8,
+  		maxN = 1048576;
+
+  if((plan == NULL) || (plan->dim != 2) || (plan->real == 0) ||
+     (data0 == NULL) || (data1 == NULL) ||
+     (plan->num[0] < minN) || (plan->num[0] > maxN) ||
+     (plan->num[1] < minN) || (plan->num[1] > maxN) ||
+     ((plan->num[0] & 1) != 0) || ((plan->num[1] & 1) != 0))
+  {
+     errNum = ALG_ERR_FUNC;
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourPlanExec2D(plan, data0, NULL, 0);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFourPlanExec2D(plan, data1, NULL, 0);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    AlgCrossCorrSpectra2D(data0, data1, plan->num[0], plan->num[1]);
+    errNum = AlgFourPlanExec2D(plan, data0, NULL, 1);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	void
+* \ingroup	AlgCorr
+* \brief	Multiplies the transform of the first array by the
+*		complex conjugate of the transform of the second array,
+*		leaving the product in the first array. The transforms
+*		have the layout of AlgFourReal2D().
+* \param	data0			Transform of the first array which
+*					holds the product on return.
+* \param	data1			Transform of the second array.
+* \param	nX			Number of columns in each array.
+* \param	nY			Number of lines in each array.
+*/
+static void	AlgCrossCorrSpectra2D(double **data0, double **data1,
+				      int nX, int nY)
+{
+  int		idX,
 		idY,
   		nX2,
 		nY2;
@@ -78,67 +179,43 @@ AlgError	AlgCrossCorrelate2D(double **data0, double **data1,
 		tD4;
   double	*tDP1,
 		*tDP2;
-  AlgError	errNum = ALG_ERR_NONE;
-  const int	minN = 8,
-  		maxN = 1048576;
 
-  if((data0 == NULL) || (data1 == NULL) ||
-     (nX < minN) || (nX > maxN) || (nY < minN) || (nY > maxN))
-  {
-     errNum = ALG_ERR_FUNC;
-  }
-  else
+  nX2 = nX / 2;
+  nY2 = nY / 2;
+  for(idY = 0; idY < nY; ++idY)
   {
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&tI0, nX);
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&tI1, nY);
-    if((tI0 != nX) || (tI1 != nY))
+    tDP1 = *(data0 + idY) + 1;
+    tDP2 = *(data1 + idY) + 1;
+    for(idX = 1; idX < nX2; ++idX)
     {
-      errNum = ALG_ERR_FUNC;
+      tD1 = *tDP1;
+      tD2 = *(tDP1 + nX2);
+      tD3 = *tDP2;
+      tD4 = -*(tDP2 + nX2);
+      *tDP1 = tD1 * tD3 - tD2 * tD4;
+      *(tDP1 + nX2) = tD1 * tD4 + tD2 * tD3;
+      ++tDP1;
+      ++tDP2;
     }
   }
-  if(errNum == ALG_ERR_NONE)
+  for(idX = 0; idX < nX; idX += nX2)
   {
-    AlgFourReal2D(data0, 1, nX, nY);
-    AlgFourReal2D(data1, 1, nX, nY);
-    nX2 = nX / 2;
-    nY2 = nY / 2;
-    for(idY = 0; idY < nY; ++idY)
+    for(idY = 1; idY < nY2; ++idY)
     {
-      tDP1 = *(data0 + idY) + 1;
-      tDP2 = *(data1 + idY) + 1;
-      for(idX = 1; idX < nX2; ++idX)
-      {
-	tD1 = *tDP1;
-	tD2 = *(tDP1 + nX2);
-	tD3 = *tDP2;
-	tD4 = -*(tDP2 + nX2);
-	*tDP1 = tD1 * tD3 - tD2 * tD4;
-	*(tDP1 + nX2) = tD1 * tD4 + tD2 * tD3;
-	++tDP1;
-	++tDP2;
-      }
+      tDP1 = *(data0 + idY) + idX;
+      tDP2 = *(data0 + nY2 + idY) + idX;
+      tD1 = *tDP1;
+      tD2 = *tDP2;
+      tD3 = *(*(data1 + idY) + idX);
+      tD4 = -*(*(data1 + nY2 + idY) + idX);
+      *tDP1 = tD1 * tD3 - tD2 * tD4;
+      *tDP2 = tD1 * tD4 + tD2 * tD3;
     }
-    for(idX = 0; idX < nX; idX += nX2)
-    {
-      for(idY = 1; idY < nY2; ++idY)
-      {
-	tDP1 = *(data0 + idY) + idX;
-	tDP2 = *(data0 + nY2 + idY) + idX;
-	tD1 = *tDP1;
-	tD2 = *tDP2;
-	tD3 = *(*(data1 + idY) + idX);
-	tD4 = -*(*(data1 + nY2 + idY) + idX);
-	*tDP1 = tD1 * tD3 - tD2 * tD4;
-	*tDP2 = tD1 * tD4 + tD2 * tD3;
-      }
-    }
-    **data0 *= **data1;
-    **(data0 + nY2) *= **(data1 + nY2);
-    *(*data0 + nX2) *= *(*data1 + nX2);
-    *(*(data0 + nY2) + nX2) *= *(*(data1 + nY2) + nX2);
-    AlgFourRealInv2D(data0, 1, nX, nY);
   }
-  return(errNum);
+  **data0 *= **data1;
+  **(data0 + nY2) *= **(data1 + nY2);
+  *(*data0 + nX2) *= *(*data1 + nX2);
+  *(*(data0 + nY2) + nX2) *= *(*(data1 + nY2) + nX2);
 }
 
 /*!
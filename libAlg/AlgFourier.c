@@ -67,13 +67,24 @@ static char _AlgFourier_c[] = "University of Edinburgh $Id$";
 				  libAlg for Woolz.</td>
 		  </tr>
 </table>
-* 		The multi-dimensional transform routines may be supplied
-*		with a use buffers flag, which if set will allocate
-*		buffers sufficient to hold copies of the data to
-*		ensure the transforms are only computed for contiguous
-*		data. Using buffers can result in an order of magnitude
-*		lower run times depending on whether the array fit into
-*		the fastest caches of the CPUs.
+* 		The multi-dimensional transforms are computed using plans
+*		which hold the kernels for each axis. The rows are
+*		transformed in place while columns and planes are copied,
+*		in blocks of ALG_FOUR_BLK adjacent lines, to contiguous
+*		buffers before being transformed, with the lines shared
+*		between threads. Plans made using AlgFourPlanMake() may be
+*		reused for many transforms of the same size.
+* \par
+*		Fourier transforms of data with lengths that are an
+*		integer power of two are computed using the fast Hartley
+*		transform. Other lengths are computed using cached kernels
+*		with a mixed radix (2, 3, 4, 5 and other small primes)
+*		algorithm, falling back to Bluestein's algorithm for lengths
+*		with large prime factors. The transformed data have the
+*		same layout and scaling for all lengths, but the Hartley
+*		transforms themselves are only valid for integer power of
+*		two lengths. AlgFourNextFastSize() gives efficient lengths
+*		for padding data.
 * \ingroup      AlgFourier
 * \todo         -
 * \bug          None known.
@@ -107,38 +118,112 @@ typedef enum _AlgFourAxis
   ALG_FOUR_AXIS_Z = 2
 } AlgFourAxis;
 
-static AlgError			AlgFourRepXY1D(
-				  double **real,
-				  double **imag,
-			          AlgFourAxis axis,
-				  int useBuf,
-			          int numX,
-				  int numY,
-				  AlgFourDir dir);
-static AlgError			AlgFourRepXYReal1D(
-				  double **data,
-				  AlgFourAxis axis,
-				  int useBuf,
+/*!
+* \def		ALG_FOUR_MAX_RADIX
+* \brief	Largest radix for which a mixed radix butterfly is used,
+*		lengths with larger prime factors use Bluestein's
+*		algorithm.
+*/
+#define ALG_FOUR_MAX_RADIX	(13)
+
+/*!
+* \def		ALG_FOUR_BLK
+* \brief	Number of adjacent columns which are copied together to
+*		and from contiguous buffers when transforming columns and
+*		planes, so that each row access reads a whole cache line.
+*/
+#define ALG_FOUR_BLK		(8)
+
+/*!
+* \brief	Cache of kernels for lengths that are not integer powers
+*		of two, accessed only within the AlgFourKernelCache critical
+*		section.
+*/
+static AlgFourKernel	*algFourKernelCache = NULL;
+
+static int			AlgFourSmoothSize(
+				  int num,
+				  int even);
+static int			AlgFourUseKernel(
+				  int num);
+static AlgFourKernel		*AlgFourKernelGet(
+				  int num,
+				  int real);
+static AlgFourKernel		*AlgFourKernelMake(
+				  int num,
+				  int real);
+static void			AlgFourKernelFree(
+				  AlgFourKernel *ker);
+static void			AlgFourKernelCpx(
+				  const AlgFourKernel *ker,
+				  ComplexD *dat,
+				  ComplexD *wrk);
+static void			AlgFourKernelMR(
+				  ComplexD *out,
+				  const ComplexD *in,
+				  int fStride,
+				  const int *fac,
+				  const ComplexD *tw,
+				  int num);
+static void			AlgFourKernelLine(
+				  const AlgFourKernel *ker,
+				  double *real,
+				  double *imag,
+				  int step,
+				  AlgFourDir dir,
+				  ComplexD *wrk);
+static void			AlgFourKernelCpx1D(
+				  const AlgFourKernel *ker,
+				  double *real,
+				  double *imag,
+				  int step,
+				  AlgFourDir dir,
+				  ComplexD *dat);
+static void			AlgFourKernelReal1D(
+				  const AlgFourKernel *ker,
+				  double *real,
+				  int step,
+				  AlgFourDir dir,
+				  ComplexD *dat);
+static AlgError			AlgFourPlanInit(
+				  AlgFourPlan *plan,
+				  int dim,
+				  int real,
 				  int numX,
 				  int numY,
-				  AlgFourDir dir);
-static AlgError			AlgFourRepXYZ1D(
-				  double ***real,
-				  double ***imag,
-			          AlgFourAxis axis,
-				  int useBuf,
-			          int numX,
-				  int numY,
 				  int numZ,
+				  int own);
+static AlgError			AlgFourPlanExec(
+				  const AlgFourPlan *plan,
+				  double *real,
+				  double *imag,
 				  AlgFourDir dir);
-static AlgError			AlgFourRepXYZReal1D(
-				  double ***data,
+static void			AlgFourPlanAxis(
+				  const AlgFourPlan *plan,
+				  double *real,
+				  double *imag,
 				  AlgFourAxis axis,
-				  int useBuf,
-				  int numX,
-				  int numY,
-				  int numZ,
-				  AlgFourDir dir);
+				  AlgFourDir dir,
+				  double *buf,
+				  ComplexD *wrk);
+static void			AlgFourPlanBlock(
+				  const AlgFourKernel *ker,
+				  int num,
+				  int step,
+				  int nBlk,
+				  double *real,
+				  double *imag,
+				  AlgFourDir dir,
+				  double *buf,
+				  ComplexD *wrk);
+static void			AlgFourPlanLine(
+				  const AlgFourKernel *ker,
+				  int num,
+				  double *real,
+				  double *imag,
+				  int step,
+				  AlgFourDir dir,
+				  ComplexD *wrk);
 
 /*!
 * \return	void
@@ -146,7 +231,8 @@ static AlgError			AlgFourRepXYZReal1D(
 * \brief	Computes the Hartley transform of the given one
 *		dimensional data, and does it in place.
 * \param	data		Given data.
-* \param	num		Number of data.
+* \param	num		Number of data, which must be an integer
+*				power of two.
 * \param	step		Offset in data elements between
 *				the data to be transformed.
 */
@@ -665,7 +751,8 @@ void		AlgFourHart1D(double *data, int num, int step)
 * \return	Error code, may be set if buffers can not be allocated.
 * \ingroup      AlgFourier
 * \brief	Computes the Hartley transform of the given two
-*		dimensional data, and does it in place.
+*		dimensional data, and does it in place. The number of
+*		data in each row and column must be integer powers of two.
 * \param	data			Given data.
 * \param	useBuf			Allocate private buffers to make
 * 					columns contiguous.
@@ -787,45 +874,53 @@ void		AlgFour1D(double *real, double *imag, int num, int step)
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFour1D FE %p %p %d %d\n",
 	   real, imag, num, step));
-  tRp0 = real + step;
-  tRp1 = real + ((num - 1) * step);
-  tIp0 = imag + step;
-  tIp1 = imag + ((num - 1) * step);
-  count = (num / 2) - 1;
-  while(count-- > 0)
-  {
-    tD1 = *tRp0;
-    tD0 = *tRp1;
-    tD2 = tD1 - tD0;
-    tD1 += tD0;
-    tD3 = *tIp0;
-    tD0 = *tIp1;
-    tD4 = tD3 - tD0;
-    tD3 += tD0;
-    *tRp0 = (tD1 + tD4) * 0.5;
-    tRp0 += step;
-    *tRp1 = (tD1 - tD4) * 0.5;
-    tRp1 -= step;
-    *tIp0 = (tD3 - tD2) * 0.5;
-    tIp0 += step;
-    *tIp1 = (tD3 + tD2) * 0.5;
-    tIp1 -= step;
+  if(AlgFourUseKernel(num))
+  {
+    AlgFourKernelLine(AlgFourKernelGet(num, 0), real, imag, step,
+		      ALG_FOUR_DIR_FWD, NULL);
   }
+  else
+  {
+    tRp0 = real + step;
+    tRp1 = real + ((num - 1) * step);
+    tIp0 = imag + step;
+    tIp1 = imag + ((num - 1) * step);
+    count = (num / 2) - 1;
+    while(count-- > 0)
+    {
+      tD1 = *tRp0;
+      tD0 = *tRp1;
+      tD2 = tD1 - tD0;
+      tD1 += tD0;
+      tD3 = *tIp0;
+      tD0 = *tIp1;
+      tD4 = tD3 - tD0;
+      tD3 += tD0;
+      *tRp0 = (tD1 + tD4) * 0.5;
+      tRp0 += step;
+      *tRp1 = (tD1 - tD4) * 0.5;
+      tRp1 -= step;
+      *tIp0 = (tD3 - tD2) * 0.5;
+      tIp0 += step;
+      *tIp1 = (tD3 + tD2) * 0.5;
+      tIp1 -= step;
+    }
 #ifdef _OPENMP
 #pragma omp parallel sections
 #endif
-  {
+    {
 #ifdef _OPENMP
 #pragma omp section
 #endif
-    {
-      AlgFourHart1D(real, num, step);
-    }
+      {
+	AlgFourHart1D(real, num, step);
+      }
 #ifdef _OPENMP
 #pragma omp section
 #endif
-    {
-      AlgFourHart1D(imag, num, step);
+      {
+	AlgFourHart1D(imag, num, step);
+      }
     }
   }
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
@@ -861,48 +956,56 @@ void		AlgFourInv1D(double *real, double *imag, int num, int step)
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourInv1D FE %p %p %d %d\n",
 	   real, imag, num, step));
+  if(AlgFourUseKernel(num))
+  {
+    AlgFourKernelLine(AlgFourKernelGet(num, 0), real, imag, step,
+		      ALG_FOUR_DIR_INV, NULL);
+  }
+  else
+  {
 #ifdef _OPENMP
 #pragma omp parallel sections
 #endif
-  {
+    {
 #ifdef _OPENMP
 #pragma omp section
 #endif
-    {
-      AlgFourHart1D(real, num, step);
-    }
+      {
+	AlgFourHart1D(real, num, step);
+      }
 #ifdef _OPENMP
 #pragma omp section
 #endif
+      {
+	AlgFourHart1D(imag, num, step);
+      }
+    }
+    tRp0 = real + step;
+    tRp1 = real + ((num - 1) * step);
+    tIp0 = imag + step;
+    tIp1 = imag + ((num - 1) * step);
+    count = (num / 2) - 1;
+    while(count-- > 0)
     {
-      AlgFourHart1D(imag, num, step);
+      tD1 = *tRp0;
+      tD0 = *tRp1;
+      tD2 = tD1 - tD0;
+      tD1 += tD0;
+
+      tD3 = *tIp0;
+      tD0 = *tIp1;
+      tD4 = tD3 - tD0;
+      tD3 += tD0;
+      *tRp0 = (tD1 - tD4) * 0.5;
+      tRp0 += step;
+      *tRp1 = (tD1 + tD4) * 0.5;
+      tRp1 -= step;
+      *tIp0 = (tD3 + tD2) * 0.5;
+      tIp0 += step;
+      *tIp1 = (tD3 - tD2) * 0.5;
+      tIp1 -= step;
     }
   }
-  tRp0 = real + step;
-  tRp1 = real + ((num - 1) * step);
-  tIp0 = imag + step;
-  tIp1 = imag + ((num - 1) * step);
-  count = (num / 2) - 1;
-  while(count-- > 0)
-  {
-    tD1 = *tRp0;
-    tD0 = *tRp1;
-    tD2 = tD1 - tD0;
-    tD1 += tD0;
-
-    tD3 = *tIp0;
-    tD0 = *tIp1;
-    tD4 = tD3 - tD0;
-    tD3 += tD0;
-    *tRp0 = (tD1 - tD4) * 0.5;
-    tRp0 += step;
-    *tRp1 = (tD1 + tD4) * 0.5;
-    tRp1 -= step;
-    *tIp0 = (tD3 + tD2) * 0.5;
-    tIp0 += step;
-    *tIp1 = (tD3 - tD2) * 0.5;
-    tIp1 -= step;
-  }
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourInv1D FX\n"));
 }
@@ -926,7 +1029,9 @@ void		AlgFourInv1D(double *real, double *imag, int num, int step)
 		| ...      |
 		| i(M - 1) |
 *		where the real and imaginary components are indexed as in
-*		the arrays computed with AlgFour1D().
+*		the arrays computed with AlgFour1D(). For odd N (with
+*		2M + 1 = N) the layout is the same except that there
+*		is an additional imaginary component iM.
 *		The transformed values data are scaled by a factor
 *		of \f$\sqrt{n}\f$.
 * \param	real			Given real data.
@@ -945,31 +1050,39 @@ void		AlgFourReal1D(double *real, int num, int step)
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourReal1D FE %p %d %d\n",
 	   real, num, step));
-  tRp0 = real + step;
-  tRp1 = real + ((num - 1) * step);
-  count = num / 2;
-  AlgFourHart1D(real, num, step);
-  while(--count > 0)
-  {
-    tD0 = *tRp0;
-    tD1 = *tRp1;
-    *tRp0 = (tD0 + tD1) * 0.5;
-    *tRp1 = (tD0 - tD1) * 0.5;
-    tRp0 += step;
-    tRp1 -= step;
+  if(AlgFourUseKernel(num))
+  {
+    AlgFourKernelLine(AlgFourKernelGet(num, 1), real, NULL, step,
+		      ALG_FOUR_DIR_FWD, NULL);
   }
-  count = (num / 2);
-  tRp0 = real + ((count + 1) * step);
-  tRp1 = real + ((num - 1) * step);
-  while(count > 0)
-  {
-    tD0 = -(*tRp0);
-    tD1 = -(*tRp1);
-    *tRp0 = tD1;
-    *tRp1 = tD0;
-    tRp0 += step;
-    tRp1 -= step;
-    count -= 2;
+  else
+  {
+    tRp0 = real + step;
+    tRp1 = real + ((num - 1) * step);
+    count = num / 2;
+    AlgFourHart1D(real, num, step);
+    while(--count > 0)
+    {
+      tD0 = *tRp0;
+      tD1 = *tRp1;
+      *tRp0 = (tD0 + tD1) * 0.5;
+      *tRp1 = (tD0 - tD1) * 0.5;
+      tRp0 += step;
+      tRp1 -= step;
+    }
+    count = (num / 2);
+    tRp0 = real + ((count + 1) * step);
+    tRp1 = real + ((num - 1) * step);
+    while(count > 0)
+    {
+      tD0 = -(*tRp0);
+      tD1 = -(*tRp1);
+      *tRp0 = tD1;
+      *tRp1 = tD0;
+      tRp0 += step;
+      tRp1 -= step;
+      count -= 2;
+    }
   }
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourReal1D FX\n"));
@@ -1000,32 +1113,40 @@ void		AlgFourRealInv1D(double *real, int num, int step)
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourRealInv1D FE %p %d %d\n",
 	   real, num, step));
-  count = (num / 2);
-  tRp0 = real + ((count + 1) * step);
-  tRp1 = real + ((num - 1) * step);
-  while(count > 0)
-  {
-    tD0 = -(*tRp0);
-    tD1 = -(*tRp1);
-    *tRp0 = tD1;
-    *tRp1 = tD0;
-    tRp0 += step;
-    tRp1 -= step;
-    count -= 2;
+  if(AlgFourUseKernel(num))
+  {
+    AlgFourKernelLine(AlgFourKernelGet(num, 1), real, NULL, step,
+		      ALG_FOUR_DIR_INV, NULL);
   }
-  tRp0 = real + step;
-  tRp1 = real + ((num - 1) * step);
-  count = num / 2;
-  while(--count > 0)
-  {
-    tD0 = *tRp0;
-    tD1 = *tRp1;
-    *tRp0 = (tD0 + tD1);
-    *tRp1 = (tD0 - tD1);
-    tRp0 += step;
-    tRp1 -= step;
+  else
+  {
+    count = (num / 2);
+    tRp0 = real + ((count + 1) * step);
+    tRp1 = real + ((num - 1) * step);
+    while(count > 0)
+    {
+      tD0 = -(*tRp0);
+      tD1 = -(*tRp1);
+      *tRp0 = tD1;
+      *tRp1 = tD0;
+      tRp0 += step;
+      tRp1 -= step;
+      count -= 2;
+    }
+    tRp0 = real + step;
+    tRp1 = real + ((num - 1) * step);
+    count = num / 2;
+    while(--count > 0)
+    {
+      tD0 = *tRp0;
+      tD1 = *tRp1;
+      *tRp0 = (tD0 + tD1);
+      *tRp1 = (tD0 - tD1);
+      tRp0 += step;
+      tRp1 -= step;
+    }
+    AlgFourHart1D(real, num, step);
   }
-  AlgFourHart1D(real, num, step);
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourRealInv1D FX\n"));
 }
@@ -1034,30 +1155,31 @@ void		AlgFourRealInv1D(double *real, int num, int step)
 * \return	Error code, may be set if buffers can not be allocated.
 * \ingroup   	AlgFourier
 * \brief	Computes the Fourier transform of the given two
-*		dimensional complex data, and does it in place.
+*		dimensional complex data, and does it in place. The arrays must
+*		be contiguous, as allocated by AlcDouble2Malloc().
 *		The transformed values data are scaled by a factor
 *		of \f$\sqrt{n_x} \sqrt{n_y}\f$.
 * \param	real			Given real data.
 * \param	imag			Given imaginary data.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
+* \param	useBuf			Ignored, columns and planes are
+*					always transformed in blocks
+*					copied to contiguous buffers.
 * \param	numX			Number of data in each row.
 * \param	numY			Number of data in each column.
 */
 AlgError	AlgFour2D(double **real, double **imag,
 			  int useBuf, int numX, int numY)
 {
+  AlgFourPlan	plan;
   AlgError	errNum;
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFour2D FE %p %p %d %d %d\n",
 	   real, imag, useBuf, numX, numY));
-  errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_X, useBuf,
-                          numX, numY, ALG_FOUR_DIR_FWD);
+  errNum = AlgFourPlanInit(&plan, 2, 0, numX, numY, 1, 0);
   if(errNum == ALG_ERR_NONE)
   {
-    errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_Y, useBuf,
-                            numX, numY, ALG_FOUR_DIR_FWD);
+    errNum = AlgFourPlanExec(&plan, *real, *imag, ALG_FOUR_DIR_FWD);
   }
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFour2D FX\n"));
@@ -1068,30 +1190,31 @@ AlgError	AlgFour2D(double **real, double **imag,
 * \return	Error code, may be set if buffers can not be allocated.
 * \ingroup   	AlgFourier
 * \brief	Computes the inverse Fourier transform of the given two
-*		dimensional complex data, and does it in place.
+*		dimensional complex data, and does it in place. The arrays must
+*		be contiguous, as allocated by AlcDouble2Malloc().
 *		The transformed values data are scaled by a factor
 *		of \f$\sqrt{n_x} \sqrt{n_y}\f$.
 * \param	real			Given real data.
 * \param	imag			Given imaginary data.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
+* \param	useBuf			Ignored, columns and planes are
+*					always transformed in blocks
+*					copied to contiguous buffers.
 * \param	numX			Number of data in each row.
 * \param	numY			Number of data in each column.
 */
 AlgError	AlgFourInv2D(double **real, double **imag,
 			     int useBuf, int numX, int numY)
 {
+  AlgFourPlan	plan;
   AlgError	errNum;
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourInv2D FE %p %p %d %d %d\n",
 	   real, imag, useBuf, numX, numY));
-  errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_Y, useBuf,
-                          numX, numY, ALG_FOUR_DIR_INV);
+  errNum = AlgFourPlanInit(&plan, 2, 0, numX, numY, 1, 0);
   if(errNum == ALG_ERR_NONE)
   {
-    errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_X, useBuf,
-                            numX, numY, ALG_FOUR_DIR_INV);
+    errNum = AlgFourPlanExec(&plan, *real, *imag, ALG_FOUR_DIR_INV);
   }
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourInv2D FX\n"));
@@ -1102,7 +1225,8 @@ AlgError	AlgFourInv2D(double **real, double **imag,
 * \return	Error code, may be set if buffers can not be allocated.
 * \ingroup   	AlgFourier
 * \brief	Computes the Fourier transform of the given two
-*		dimensional real data, and does it in place.
+*		dimensional real data, and does it in place. The arrays must
+*		be contiguous, as allocated by AlcDouble2Malloc().
 *
 *		The layout of the array is similar to that in AlgFourReal1D()
 *		and as shown in the table (with 2M = N, r = real,
@@ -1117,45 +1241,29 @@ AlgError	AlgFourInv2D(double **real, double **imag,
 	...    |...     |...|...         |...    |...     |...|...
 	i(M-1)0|r(2M-1)1|...|r(2M-1)(M-1)|i(M-1)M|i(2M-1)1|...|i(2M-1)(M-1)
 
-*		Using contiguous buffers has a large effect for
-*		data larger than a CPU's fastest cache and little
-*		cost for smaller data arrays.
-*		The times below were measured for on a Lenovo T430s
-*		with a i7-2640M with 4kB cache. Data sizes are the
-*		number of double values. These times include buffer
-*		allocation but not array allocation or file I/O
-*		and are the mean of 5 runs using elapsed (wall
-*		clock) time.
-*	data sz | tm (no buf, 1 thr) | tm (buf, 1 thr) | tm (buf, 2 thr)
- 	--------|--------------------|-----------------|-------------
-          256^2 |     3ms            |    3ms          |    2ms
-          512^2 |    12ms            |    6ms          |    4ms
-         1024^2 |   120ms            |   44ms          |   35ms
-         2048^2 |   600ms            |  170ms          |  110ms
-         4096^2 |  3300ms            |  764ms          |  460ms
-         8192^2 | 17000ms            | 3600ms          | 2100ms
+*		The number of data in each row must be even.
 *		The transformed values data are scaled by a factor
 *		of \f$\sqrt{n_x} \sqrt{n_y}\f$.
 * \param	real			Given real data.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
+* \param	useBuf			Ignored, columns and planes are
+*					always transformed in blocks
+*					copied to contiguous buffers.
 * \param	numX			Number of data in each row.
 * \param	numY			Number of data in each column.
 */
 AlgError	AlgFourReal2D(double **real,
 			      int useBuf, int numX, int numY)
 {
+  AlgFourPlan	plan;
   AlgError	errNum;
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourReal2D FE %p %d %d %d\n",
 	   real, useBuf, numX, numY));
-  errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_X, useBuf, numX, numY,
-                              ALG_FOUR_DIR_FWD);
+  errNum = AlgFourPlanInit(&plan, 2, 1, numX, numY, 1, 0);
   if(errNum == ALG_ERR_NONE)
   {
-    errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_Y, useBuf, numX, numY,
-    				ALG_FOUR_DIR_FWD);
+    errNum = AlgFourPlanExec(&plan, *real, NULL, ALG_FOUR_DIR_FWD);
   }
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourReal2D FX\n"));
@@ -1167,28 +1275,29 @@ AlgError	AlgFourReal2D(double **real,
 * \ingroup   	AlgFourier
 * \brief	Computes the Fourier transform of the given two
 *		dimensional data which resulted from a transform using
-*		AlgFourReal2D(), and does it in place.
+*		AlgFourReal2D(), and does it in place. The arrays must
+*		be contiguous, as allocated by AlcDouble2Malloc().
 *		The transformed values data are scaled by a factor
 *		of \f$\sqrt{n_x} \sqrt{n_y}\f$.
 * \param	real			Given real/complex data.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
+* \param	useBuf			Ignored, columns and planes are
+*					always transformed in blocks
+*					copied to contiguous buffers.
 * \param	numX			Number of data in each row.
 * \param	numY			Number of data in each column.
 */
 AlgError	AlgFourRealInv2D(double **real,
 				 int useBuf, int numX, int numY)
 {
+  AlgFourPlan	plan;
   AlgError	errNum;
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourRealInv2D FE %p %d %d %d\n",
 	   real, useBuf, numX, numY));
-  errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_Y, useBuf, numX, numY,
-                              ALG_FOUR_DIR_INV);
+  errNum = AlgFourPlanInit(&plan, 2, 1, numX, numY, 1, 0);
   if(errNum == ALG_ERR_NONE)
   {
-    errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_X, useBuf, numX, numY,
-  				ALG_FOUR_DIR_INV);
+    errNum = AlgFourPlanExec(&plan, *real, NULL, ALG_FOUR_DIR_INV);
   }
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourRealInv2D FX\n"));
@@ -1199,17 +1308,15 @@ AlgError	AlgFourRealInv2D(double **real,
 * \return	Error code, may be set if buffers can not be allocated.
 * \ingroup   	AlgFourier
 * \brief	Computes the Fourier transform of the given three
-*		dimensional complex data, and does it in place.
+*		dimensional complex data, and does it in place. The arrays must
+*		be contiguous, as allocated by AlcDouble3Malloc().
 *		The transformed values data are scaled by a factor
 *		of \f$\sqrt{n_x} \sqrt{n_y} \sqrt{n_z}\f$.
-*
-*		Using contiguous buffers has a large effect for
-*		data larger than a CPU's fastest cache and little
-*		cost for smaller data arrays.
 * \param	real			Given real data.
 * \param	imag			Given imaginary data.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
+* \param	useBuf			Ignored, columns and planes are
+*					always transformed in blocks
+*					copied to contiguous buffers.
 * \param	numX			Number of data in each row.
 * \param	numY			Number of data in each column.
 * \param	numZ			Number of data in each plane.
@@ -1217,22 +1324,16 @@ AlgError	AlgFourRealInv2D(double **real,
 AlgError	AlgFour3D(double ***real, double ***imag,
 			  int useBuf, int numX, int numY, int numZ)
 {
+  AlgFourPlan	plan;
   AlgError	errNum;
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFour3D FE %p %p %d %d %d %d\n",
 	   real, imag, useBuf, numX, numY, numZ));
-  errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_X, useBuf,
-                           numX, numY, numZ, ALG_FOUR_DIR_FWD);
+  errNum = AlgFourPlanInit(&plan, 3, 0, numX, numY, numZ, 0);
   if(errNum == ALG_ERR_NONE)
   {
-    errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_Y, useBuf,
-                             numX, numY, numZ, ALG_FOUR_DIR_FWD);
-  }
-  if(errNum == ALG_ERR_NONE)
-  {
-    errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_Z, useBuf,
-                             numX, numY, numZ, ALG_FOUR_DIR_FWD);
+    errNum = AlgFourPlanExec(&plan, **real, **imag, ALG_FOUR_DIR_FWD);
   }
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFour3D FX\n"));
@@ -1243,13 +1344,15 @@ AlgError	AlgFour3D(double ***real, double ***imag,
 * \return	Error code, may be set if buffers can not be allocated.
 * \ingroup   	AlgFourier
 * \brief	Computes the inverse Fourier transform of the given three
-*		dimensional complex data, and does it in place.
+*		dimensional complex data, and does it in place. The arrays must
+*		be contiguous, as allocated by AlcDouble3Malloc().
 *		The transformed values data are scaled by a factor
 *		of \f$\sqrt{n_x} \sqrt{n_y} \sqrt{n_z}\f$.
 * \param	real			Given real data.
 * \param	imag			Given imaginary data.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
+* \param	useBuf			Ignored, columns and planes are
+*					always transformed in blocks
+*					copied to contiguous buffers.
 * \param	numX			Number of data in each row.
 * \param	numY			Number of data in each column.
 * \param	numZ			Number of data in each plane.
@@ -1257,22 +1360,16 @@ AlgError	AlgFour3D(double ***real, double ***imag,
 AlgError	AlgFourInv3D(double ***real, double ***imag,
 			     int useBuf, int numX, int numY, int numZ)
 {
+  AlgFourPlan	plan;
   AlgError	errNum;
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourInv3D FE %p %p %d %d %d %d\n",
 	   real, imag, useBuf, numX, numY, numZ));
-  errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_Z, useBuf,
-                          numX, numY, numZ, ALG_FOUR_DIR_INV);
-  if(errNum == ALG_ERR_NONE)
-  {
-    errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_Y, useBuf,
-                            numX, numY, numZ, ALG_FOUR_DIR_INV);
-  }
+  errNum = AlgFourPlanInit(&plan, 3, 0, numX, numY, numZ, 0);
   if(errNum == ALG_ERR_NONE)
   {
-    errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_X, useBuf,
-                            numX, numY, numZ, ALG_FOUR_DIR_INV);
+    errNum = AlgFourPlanExec(&plan, **real, **imag, ALG_FOUR_DIR_INV);
   }
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourInv3D FX\n"));
@@ -1283,15 +1380,14 @@ AlgError	AlgFourInv3D(double ***real, double ***imag,
 * \return	Error code, may be set if buffers can not be allocated.
 * \ingroup   	AlgFourier
 * \brief	Computes the Fourier transform of the given three
-*		dimensional real data, and does it in place.
+*		dimensional real data, and does it in place. The arrays must
+*		be contiguous, as allocated by AlcDouble3Malloc().
 *		The transformed values data are scaled by a factor
 *		of \f$\sqrt{n_x} \sqrt{n_y} \sqrt{n_z}\f$.
-*
-*		Using contiguous buffers has a large effect for
-*		data larger than a CPU's fastest cache and little
 * \param	real			Given real data.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
+* \param	useBuf			Ignored, columns and planes are
+*					always transformed in blocks
+*					copied to contiguous buffers.
 * \param	numX			Number of data in each row.
 * \param	numY			Number of data in each column.
 * \param	numZ			Number of data in each plane.
@@ -1299,22 +1395,16 @@ AlgError	AlgFourInv3D(double ***real, double ***imag,
 AlgError	AlgFourReal3D(double ***real,
 			      int useBuf, int numX, int numY, int numZ)
 {
+  AlgFourPlan	plan;
   AlgError	errNum;
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourReal3D FE %p %d %d %d %d\n",
 	   real, useBuf, numX, numY, numZ));
-  errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_X, useBuf,
-                               numX, numY, numZ, ALG_FOUR_DIR_FWD);
-  if(errNum == ALG_ERR_NONE)
-  {
-    errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_Y, useBuf,
-                                 numX, numY, numZ, ALG_FOUR_DIR_FWD);
-  }
+  errNum = AlgFourPlanInit(&plan, 3, 1, numX, numY, numZ, 0);
   if(errNum == ALG_ERR_NONE)
   {
-    errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_Z, useBuf,
-    				 numX, numY, numZ, ALG_FOUR_DIR_FWD);
+    errNum = AlgFourPlanExec(&plan, **real, NULL, ALG_FOUR_DIR_FWD);
   }
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourReal3D FX\n"));
@@ -1326,12 +1416,14 @@ AlgError	AlgFourReal3D(double ***real,
 * \ingroup   	AlgFourier
 * \brief	Computes the Fourier transform of the given three
 *		dimensional data which resulted from a transform using
-*		AlgFourReal3D(), and does it in place.
+*		AlgFourReal3D(), and does it in place. The arrays must
+*		be contiguous, as allocated by AlcDouble3Malloc().
 *		The transformed values data are scaled by a factor
 *		of \f$\sqrt{n_x} \sqrt{n_y} \sqrt{n_z}\f$.
 * \param	real			Given real/complex data.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
+* \param	useBuf			Ignored, columns and planes are
+*					always transformed in blocks
+*					copied to contiguous buffers.
 * \param	numX			Number of data in each row.
 * \param	numY			Number of data in each column.
 * \param	numZ			Number of data in each plane.
@@ -1339,21 +1431,15 @@ AlgError	AlgFourReal3D(double ***real,
 AlgError	AlgFourRealInv3D(double ***real,
 				 int useBuf, int numX, int numY, int numZ)
 {
+  AlgFourPlan	plan;
   AlgError	errNum;
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourRealInv3D FE %p %d %d %d %d\n",
 	   real, useBuf, numX, numY, numZ));
-  errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_Z, useBuf,
-                               numX, numY, numZ, ALG_FOUR_DIR_INV);
-  if(errNum == ALG_ERR_NONE)
-  {
-    errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_Y, useBuf,
-                                 numX, numY, numZ, ALG_FOUR_DIR_INV);
-  }
+  errNum = AlgFourPlanInit(&plan, 3, 1, numX, numY, numZ, 0);
   if(errNum == ALG_ERR_NONE)
   {
-    errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_X, useBuf,
-                                 numX, numY, numZ, ALG_FOUR_DIR_INV);
+    errNum = AlgFourPlanExec(&plan, **real, NULL, ALG_FOUR_DIR_INV);
   }
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourRealInv3D FX\n"));
@@ -1361,916 +1447,1397 @@ AlgError	AlgFourRealInv3D(double ***real,
 }
 
 /*!
-* \return	Error code, may be set if buffers can not be allocated.
-* \brief	Computes repeated Fourier transforms of a 1D complex
-*	 	array within a complex array 2D.
-* \param	real			Given real 2D data array.
-* \param	imag			Given imaginary 2D data array.
-* \param	axis			Axis for partial evaluation.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
-* \param	numX			Number of data columns in given
-*					data array.
-* \param	numY			Number of data rows in given
-*					data array.
-* \param	dir			Forward or inverse transform.
+* \return	Transform length.
+* \ingroup   	AlgFourier
+* \brief	Computes the smallest even length, not less than the
+*		given length, which has no prime factors greater than
+*		seven. Transforms of these lengths are computed
+*		efficiently using the mixed radix algorithm and are
+*		valid for both the complex and real transforms. This
+*		length can be used in place of the next integer power
+*		of two when padding data for a transform.
+* \param	num			Given length.
 */
-static AlgError	AlgFourRepXY1D(double **real, double **imag,
-			       AlgFourAxis axis, int useBuf,
-			       int numX, int numY, AlgFourDir dir)
+int		AlgFourNextFastSize(int num)
 {
-  AlgError	errNum = ALG_ERR_NONE;
-
-  if(axis == ALG_FOUR_AXIS_X)                              /* Transform rows */
-  {
-    if(dir == ALG_FOUR_DIR_FWD)
-    {
-      int	idY;
+  return(AlgFourSmoothSize(num, 1));
+}
 
+/*!
+* \return	void
+* \ingroup   	AlgFourier
+* \brief	Frees all kernels cached for transforms with lengths that
+*		are not an integer power of two. Kernels are made again if
+*		they are needed by subsequent transforms. Plans made by
+*		AlgFourPlanMake() own their kernels and are not affected.
+*		This function must not be called while any transform
+*		without an explicit plan is being computed.
+*/
+void		AlgFourPlanCacheFree(void)
+{
 #ifdef _OPENMP
-#pragma omp parallel for private(idY)
+#pragma omp critical (AlgFourKernelCache)
 #endif
-      for(idY = 0; idY < numY; ++idY)
-      {
-	AlgFour1D(*(real + idY), *(imag + idY), numX, 1);
-      }
-    }
-    else
+  {
+    while(algFourKernelCache != NULL)
     {
-      int	idY;
+      AlgFourKernel *ker;
 
-#ifdef _OPENMP
-#pragma omp parallel for private(idY)
-#endif
-      for(idY = 0; idY < numY; ++idY)
-      {
-	AlgFourInv1D(*(real + idY), *(imag + idY), numX, 1);
-      }
+      ker = algFourKernelCache;
+      algFourKernelCache = ker->next;
+      AlgFourKernelFree(ker);
     }
   }
-  else /* axis == ALG_FOUR_AXIS_Y */                    /* Transform columns */
-  {
-    if(useBuf)	                           /* Use column buffers if provided */
-    {
-      int	nThr = 1;
-      double	*bufBase = NULL;
-
-#ifdef _OPENMP
-#pragma omp parallel
-      {
-#pragma omp master
-        {
-	  nThr = omp_get_num_threads();
-	}
-      }
-#endif
-      if((bufBase = AlcMalloc(sizeof(double) * numY * 2 * nThr)) == NULL)
-      {
-	errNum = ALG_ERR_MALLOC;
-      }
-      if(errNum == ALG_ERR_NONE)
-      {
-        int	idX;
+}
 
-#ifdef _OPENMP
-#pragma omp parallel for private(idX) num_threads(nThr)
-#endif
-	for(idX = 0; idX < numX; ++idX)
-	{
-	  int	  idY,
-	  	  thrId = 0;
-	  double  *reBuf,
-		  *imBuf;
+/*!
+* \return	New plan or NULL on error.
+* \ingroup   	AlgFourier
+* \brief	Makes a plan for repeated Fourier transforms of data
+*		with the given dimension and size. The plan owns its
+*		kernels, is not affected by AlgFourPlanCacheFree() and
+*		should be freed using AlgFourPlanFree(). For real
+*		transforms the number of data in each row must be even
+*		unless it is an integer power of two.
+* \param	dim			Dimension of the data: 1, 2 or 3.
+* \param	real			Non-zero for real transforms with the
+*					layout of AlgFourReal1D(),
+*					AlgFourReal2D() and AlgFourReal3D().
+* \param	numX			Number of data in each row.
+* \param	numY			Number of data in each column,
+*					ignored for one dimensional data.
+* \param	numZ			Number of data in each plane,
+*					ignored for one and two dimensional
+*					data.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+AlgFourPlan	*AlgFourPlanMake(int dim, int real,
+				 int numX, int numY, int numZ,
+				 AlgError *dstErr)
+{
+  AlgFourPlan	*plan;
+  AlgError	errNum = ALG_ERR_NONE;
 
-#ifdef _OPENMP
-	  thrId = omp_get_thread_num();
-#endif
-	  reBuf = bufBase + (2 * numY * thrId);
-	  imBuf = reBuf + numY;
-	  /* Copy to buffer. */
-	  for(idY = 0; idY < numY; ++idY)
-	  {
-	    *(reBuf + idY) = *(*(real + idY) + idX);
-	    *(imBuf + idY) = *(*(imag + idY) + idX);
-	  }
-	  /* Transform buffer. */
-	  if(dir == ALG_FOUR_DIR_FWD)
-	  {
-	    AlgFour1D(reBuf, imBuf, numY, 1);
-	  }
-	  else
-	  {
-	    AlgFourInv1D(reBuf, imBuf, numY, 1);
-	  }
-	  /* Copy back from buffer. */
-	  for(idY = 0; idY < numY; ++idY)
-	  {
-	    *(*(real + idY) + idX) = *(reBuf + idY);
-	    *(*(imag + idY) + idX) = *(imBuf + idY);
-	  }
-	}
-	AlcFree(bufBase);
-      }
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourPlanMake FE %d %d %d %d %d %p\n",
+	   dim, real, numX, numY, numZ, dstErr));
+  if((plan = (AlgFourPlan *)AlcMalloc(sizeof(AlgFourPlan))) == NULL)
+  {
+    errNum = ALG_ERR_MALLOC;
+  }
+  else
+  {
+    errNum = AlgFourPlanInit(plan, dim, real, numX, numY, numZ, 1);
+    if(errNum != ALG_ERR_NONE)
+    {
+      AlgFourPlanFree(plan);
+      plan = NULL;
     }
-    else              /* If no column buffers transform the columns in place */
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourPlanMake FX %p\n",
+	   plan));
+  return(plan);
+}
+
+/*!
+* \return	void
+* \ingroup   	AlgFourier
+* \brief	Frees a plan made by AlgFourPlanMake().
+* \param	plan			Given plan, may be NULL.
+*/
+void		AlgFourPlanFree(AlgFourPlan *plan)
+{
+  if(plan)
+  {
+    if(plan->own)
     {
-      int	idX;
+      int	idA;
 
-      if(dir == ALG_FOUR_DIR_FWD)
-      {
-#ifdef _OPENMP
-#pragma omp parallel for private(idX)
-#endif
-	for(idX = 0; idX < numX; ++idX)
-	{
-	  AlgFour1D(*real + idX, *imag + idX, numY, numX);
-        }
-      }
-      else
+      for(idA = 0; idA < 3; ++idA)
       {
-#ifdef _OPENMP
-#pragma omp parallel for private(idX)
-#endif
-	for(idX = 0; idX < numX; ++idX)
-	{
-	  AlgFourInv1D(*real + idX, *imag + idX, numY, numX);
-        }
+	AlgFourKernelFree(plan->cpx[idA]);
+	AlgFourKernelFree(plan->rel[idA]);
       }
     }
+    AlcFree(plan);
+  }
+}
+
+/*!
+* \return	Error code.
+* \ingroup   	AlgFourier
+* \brief	Computes the forward or inverse Fourier transform of the
+*		given one dimensional data in place using the given plan.
+*		The transformed data have the same layout and scaling as
+*		those computed by AlgFour1D() or AlgFourReal1D().
+* \param	plan			Given one dimensional plan.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data, ignored for
+*					real plans.
+* \param	inv			Non-zero for the inverse transform.
+*/
+AlgError	AlgFourPlanExec1D(const AlgFourPlan *plan,
+				  double *real, double *imag, int inv)
+{
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if((plan == NULL) || (plan->dim != 1) || (real == NULL) ||
+     ((plan->real == 0) && (imag == NULL)))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else
+  {
+    errNum = AlgFourPlanExec(plan, real, (plan->real)? NULL: imag,
+                             (inv)? ALG_FOUR_DIR_INV: ALG_FOUR_DIR_FWD);
   }
   return(errNum);
 }
 
 /*!
-* \return	Error code, may be set if buffers can not be allocated.
-* \brief	Computes repeated the Fourier transforms of the given
-*	 	one dimensional real data array.
-* \brief	Computes repeated Fourier transforms of a 1D real/
-*	 	complex conjugate array within a 2D real/complex conjugate
-*	 	array.
-* \param	data			Given 2D data array.
-* \param	axis			Axis for partial evaluation.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
-* \param	numX			Number of data columns in given
-*					data array.
-* \param	numY			Number of data rows in given
-*					data array.
-* \param	dir			Forward or inverse transform.
+* \return	Error code.
+* \ingroup   	AlgFourier
+* \brief	Computes the forward or inverse Fourier transform of the
+*		given two dimensional data in place using the given plan.
+*		The transformed data have the same layout and scaling as
+*		those computed by AlgFour2D() or AlgFourReal2D(). The
+*		arrays must be contiguous, as allocated by
+*		AlcDouble2Malloc().
+* \param	plan			Given two dimensional plan.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data, ignored for
+*					real plans.
+* \param	inv			Non-zero for the inverse transform.
 */
-static AlgError	AlgFourRepXYReal1D(double **data, AlgFourAxis axis, int useBuf,
-				   int numX, int numY, AlgFourDir dir)
+AlgError	AlgFourPlanExec2D(const AlgFourPlan *plan,
+				  double **real, double **imag, int inv)
 {
   AlgError	errNum = ALG_ERR_NONE;
 
-  if(axis == ALG_FOUR_AXIS_X)			 	   /* Transform rows */
+  if((plan == NULL) || (plan->dim != 2) || (real == NULL) ||
+     ((plan->real == 0) && (imag == NULL)))
   {
-    if(dir == ALG_FOUR_DIR_FWD)
-    {
-      int 	idY;
+    errNum = ALG_ERR_FUNC;
+  }
+  else
+  {
+    errNum = AlgFourPlanExec(plan, *real, (plan->real)? NULL: *imag,
+                             (inv)? ALG_FOUR_DIR_INV: ALG_FOUR_DIR_FWD);
+  }
+  return(errNum);
+}
 
-#ifdef _OPENMP
-#pragma omp parallel for private(idY)
-#endif
-      for(idY = 0; idY < numY; ++idY)
-      {
-	AlgFourReal1D(*(data + idY), numX, 1);
-      }
-    }
-    else
-    {
-      int	idY;
+/*!
+* \return	Error code.
+* \ingroup   	AlgFourier
+* \brief	Computes the forward or inverse Fourier transform of the
+*		given three dimensional data in place using the given
+*		plan. The transformed data have the same layout and
+*		scaling as those computed by AlgFour3D() or
+*		AlgFourReal3D(). The arrays must be contiguous, as
+*		allocated by AlcDouble3Malloc().
+* \param	plan			Given three dimensional plan.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data, ignored for
+*					real plans.
+* \param	inv			Non-zero for the inverse transform.
+*/
+AlgError	AlgFourPlanExec3D(const AlgFourPlan *plan,
+				  double ***real, double ***imag, int inv)
+{
+  AlgError	errNum = ALG_ERR_NONE;
 
-#ifdef _OPENMP
-#pragma omp parallel for private(idY)
-#endif
-      for(idY = 0; idY < numY; ++idY)
-      {
-	AlgFourRealInv1D(*(data + idY), numX, 1);
-      }
-    }
+  if((plan == NULL) || (plan->dim != 3) || (real == NULL) ||
+     ((plan->real == 0) && (imag == NULL)))
+  {
+    errNum = ALG_ERR_FUNC;
   }
-  else /* axis == ALG_FOUR_AXIS_Y */			/* Transform columns */
+  else
   {
-    int		halfData;
+    errNum = AlgFourPlanExec(plan, **real, (plan->real)? NULL: **imag,
+                             (inv)? ALG_FOUR_DIR_INV: ALG_FOUR_DIR_FWD);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Smallest integer not less than the given integer which has
+*		no prime factors greater than seven.
+* \brief	Finds the smallest integer not less than the given integer
+*		which has no prime factors greater than seven and, if
+*		required, is even.
+* \param	num			Given integer.
+* \param	even			Non-zero if the integer must be even.
+*/
+static int	AlgFourSmoothSize(int num, int even)
+{
+  int		n,
+  		r;
+  const int	primes[4] = {2, 3, 5, 7};
 
-    halfData = numX / 2;
-    if(useBuf)
+  num = ALG_MAX(num, (even)? 2: 1);
+  for(;;)
+  {
+    if(!even || ((num & 1) == 0))
     {
-      int	nThr = 1;
-      double	*bufBase = NULL;
+      int	idP;
 
-#ifdef _OPENMP
-#pragma omp parallel
+      r = num;
+      for(idP = 0; idP < 4; ++idP)
       {
-#pragma omp master
-        {
-          nThr = omp_get_num_threads();
+	while((n = r / primes[idP]) * primes[idP] == r)
+	{
+	  r = n;
 	}
       }
-#endif
-      if((bufBase = AlcMalloc(sizeof(double) * numY * 2 * nThr)) == NULL)
+      if(r == 1)
       {
-	errNum = ALG_ERR_MALLOC;
+	break;
       }
-      if(errNum == ALG_ERR_NONE)
-      {
-#ifdef _OPENMP
-#pragma omp parallel sections
-#endif
-	{
-#ifdef _OPENMP
-#pragma omp section
-#endif
-	  {
-	    int	    idY,
-		    thrId = 0;
-	    double  *reBuf;
+    }
+    ++num;
+  }
+  return(num);
+}
 
-#ifdef _OPENMP
-	    thrId = omp_get_thread_num();
-#endif
-	    reBuf = bufBase + (numY * thrId);
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      *(reBuf + idY) = **(data + idY);
-	    }
-	    if(dir == ALG_FOUR_DIR_FWD)
-	    {
-	      AlgFourReal1D(reBuf, numY, 1);
-	    }
-	    else
-	    {
-	      AlgFourRealInv1D(reBuf, numY, 1);
-	    }
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      **(data + idY) = *(reBuf + idY);
-	    }
-	  }
-#ifdef _OPENMP
-#pragma omp section
-#endif
-	  {
-	    int	    idY,
-		    thrId = 0;
-	    double  *reBuf;
+/*!
+* \return	Non-zero if a kernel must be used for the given length.
+* \brief	Checks whether a transform of the given length must be
+*		computed using a kernel rather than the fast Hartley
+*		transform, which is only valid for lengths that are an
+*		integer power of two not less than four.
+* \param	num			Transform length.
+*/
+static int	AlgFourUseKernel(int num)
+{
+  return((num == 2) || ((num > 2) && (AlgBitIsPowerOfTwo(num) == 0)));
+}
+
+/*!
+* \return	Kernel for the given length or NULL on error.
+* \brief	Gets a kernel for the given length from the cache, making
+*		it and adding it to the cache if it is not already there.
+*		Cached kernels are owned by the cache and should not be
+*		freed.
+* \param	num			Transform length.
+* \param	real			Non-zero for a kernel for real data.
+*/
+static AlgFourKernel *AlgFourKernelGet(int num, int real)
+{
+  AlgFourKernel	*ker;
 
 #ifdef _OPENMP
-	    thrId = omp_get_thread_num();
+#pragma omp critical (AlgFourKernelCache)
 #endif
-	    reBuf = bufBase + (numY * thrId);
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      *(reBuf + idY) = *(*(data + idY) + halfData);
-	    }
-	    if(dir == ALG_FOUR_DIR_FWD)
-	    {
-	      AlgFourReal1D(reBuf, numY, 1);
-	    }
-	    else
-	    {
-	      AlgFourRealInv1D(reBuf, numY, 1);
-	    }
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      *(*(data + idY) + halfData) = *(reBuf + idY);
-	    }
-	  }
+  {
+    ker = algFourKernelCache;
+    while((ker != NULL) && ((ker->num != num) || (ker->real != real)))
+    {
+      ker = ker->next;
+    }
+    if((ker == NULL) && ((ker = AlgFourKernelMake(num, real)) != NULL))
+    {
+      ker->next = algFourKernelCache;
+      algFourKernelCache = ker;
+    }
+  }
+  return(ker);
+}
+
+/*!
+* \return	New kernel or NULL on error.
+* \brief	Makes a new kernel for the given length. Lengths with no
+*		prime factors greater than ALG_FOUR_MAX_RADIX use a
+*		mixed radix algorithm, all other lengths use Bluestein's
+*		algorithm with a mixed radix convolution. Kernels for even
+*		length real data use a complex kernel of half the length.
+* \param	num			Transform length.
+* \param	real			Non-zero for a kernel for real data.
+*/
+static AlgFourKernel *AlgFourKernelMake(int num, int real)
+{
+  int		idN;
+  AlgFourKernel	*ker;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if((ker = (AlgFourKernel *)AlcCalloc(1, sizeof(AlgFourKernel))) == NULL)
+  {
+    errNum = ALG_ERR_MALLOC;
+  }
+  else
+  {
+    ker->num = num;
+    ker->real = real;
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    if(real)
+    {
+      if((num & 1) == 0)
+      {
+	int	half;
+
+	half = num / 2;
+	if(((ker->sub = AlgFourKernelMake(half, 0)) == NULL) ||
+	   ((ker->tw = (ComplexD *)
+	                AlcMalloc(sizeof(ComplexD) * half)) == NULL))
+	{
+	  errNum = ALG_ERR_MALLOC;
 	}
+	else
 	{
-	  int	idX;
-
-#ifdef _OPENMP
-#pragma omp parallel for private(idX)
-#endif
-	  for(idX = 1; idX < halfData; ++idX)
+	  for(idN = 0; idN < half; ++idN)
 	  {
-	    int	   idY,
-		   thrId = 0;
-	    double *reBuf,
-		   *imBuf;
+	    double	a;
 
-#ifdef _OPENMP
-	    thrId = omp_get_thread_num();
-#endif
-	    reBuf = bufBase + (2 * numY * thrId);
-	    imBuf = reBuf + numY;
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      *(reBuf + idY) = *(*(data + idY) + idX);
-	      *(imBuf + idY) = *(*(data + idY) + halfData + idX);
-	    }
-	    if(dir == ALG_FOUR_DIR_FWD)
-	    {
-	      AlgFour1D(reBuf, imBuf, numY, 1);
-	    }
-	    else
-	    {
-	      AlgFourInv1D(reBuf, imBuf, numY, 1);
-	    }
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      *(*(data + idY) + idX) = *(reBuf + idY);
-	      *(*(data + idY) + halfData + idX) = *(imBuf + idY);
-	    }
+	    a = (2.0 * ALG_M_PI * idN) / num;
+	    ker->tw[idN].re = cos(a);
+	    ker->tw[idN].im = -sin(a);
 	  }
+	  ker->wrkNum = half + ker->sub->wrkNum;
+	}
+      }
+      else
+      {
+	if((ker->sub = AlgFourKernelMake(num, 0)) == NULL)
+	{
+	  errNum = ALG_ERR_MALLOC;
+	}
+	else
+	{
+	  ker->wrkNum = num + ker->sub->wrkNum;
 	}
       }
     }
     else
     {
-      /* If no column buffers then just transform the columns in place this
-       * is done by: transforming column 0, transform column numX/2 and then
-       * transforming the remaining columns. */
-      if(dir == ALG_FOUR_DIR_FWD)
+      int	n,
+      		p;
+
+      /* Factorize using radix 4 first then the remaining primes. */
+      n = num;
+      p = 4;
+      while((n > 1) && (p <= ALG_FOUR_MAX_RADIX))
       {
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
+	if((n % p) == 0)
 	{
-	  int	idX;
-#ifdef _OPENMP
-#pragma omp sections
-#endif
-	  {
-#ifdef _OPENMP
-#pragma omp section
-#endif
-	    {
-	      AlgFourReal1D(*data, numY, numX);
-	    }
-#ifdef _OPENMP
-#pragma omp section
-#endif
-	    {
-	      AlgFourReal1D(*data + halfData, numY, numX);
-	    }
-	  }
-#ifdef _OPENMP
-#pragma omp for private(idX)
-#endif
-	  for(idX = 1; idX < halfData; ++idX)
-	  {
-	    AlgFour1D(*data + idX, *data + halfData + idX, numY, numX);
-	  }
+	  n /= p;
+	  ker->fac[2 * ker->nFac] = p;
+	  ker->fac[(2 * ker->nFac) + 1] = n;
+	  ++(ker->nFac);
+	}
+	else
+	{
+	  p = (p == 4)? 2: (p == 2)? 3: p + 2;
 	}
       }
+      if((ker->tw = (ComplexD *)
+                     AlcMalloc(sizeof(ComplexD) * num)) == NULL)
+      {
+	errNum = ALG_ERR_MALLOC;
+      }
       else
       {
-        int 	idX;
+	for(idN = 0; idN < num; ++idN)
+	{
+	  double	a;
 
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
+	  a = (2.0 * ALG_M_PI * idN) / num;
+	  ker->tw[idN].re = cos(a);
+	  ker->tw[idN].im = -sin(a);
+	}
+	ker->wrkNum = num;
+      }
+      if((errNum == ALG_ERR_NONE) && (n > 1))
+      {
+	/* Length has a large prime factor so use Bluestein's algorithm
+	 * with a convolution length that can be computed using the
+	 * mixed radix algorithm. */
+	ComplexD *wrk = NULL;
+
+	ker->nFac = 0;
+	ker->bsNum = AlgFourSmoothSize((2 * num) - 1, 0);
+	if(((ker->bsChirp = (ComplexD *)
+	                     AlcMalloc(sizeof(ComplexD) * num)) == NULL) ||
+	   ((ker->bsFilter = (ComplexD *)
+	                      AlcCalloc(ker->bsNum,
+				        sizeof(ComplexD))) == NULL) ||
+	   ((ker->sub = AlgFourKernelMake(ker->bsNum, 0)) == NULL) ||
+	   ((wrk = (ComplexD *)
+	           AlcMalloc(sizeof(ComplexD) *
+			     ker->sub->wrkNum)) == NULL))
 	{
-#ifdef _OPENMP
-#pragma omp sections
-#endif
+	  errNum = ALG_ERR_MALLOC;
+	}
+	else
+	{
+	  double	s;
+	  long long	n2;
+
+	  n2 = 2 * (long long )num;
+	  for(idN = 0; idN < num; ++idN)
 	  {
-#ifdef _OPENMP
-#pragma omp section
-#endif
-	    {
-	      AlgFourRealInv1D(*data, numY, numX);
-	    }
-#ifdef _OPENMP
-#pragma omp section
-#endif
-	    {
-	      AlgFourRealInv1D(*data + halfData, numY, numX);
-	    }
+	    double	a;
+
+	    a = (ALG_M_PI * (double )(((long long )idN * idN) % n2)) / num;
+	    ker->bsChirp[idN].re = cos(a);
+	    ker->bsChirp[idN].im = -sin(a);
 	  }
-#ifdef _OPENMP
-#pragma omp for private(idX)
-#endif
-	  for(idX = 1; idX < halfData; ++idX)
+	  ker->bsFilter[0].re = 1.0;
+	  for(idN = 1; idN < num; ++idN)
 	  {
-	    AlgFourInv1D(*data + idX, *data + halfData + idX, numY,
-		numX);
+	    ker->bsFilter[idN].re = ker->bsChirp[idN].re;
+	    ker->bsFilter[idN].im = -(ker->bsChirp[idN].im);
+	    ker->bsFilter[ker->bsNum - idN] = ker->bsFilter[idN];
 	  }
+	  AlgFourKernelCpx(ker->sub, ker->bsFilter, wrk);
+	  s = 1.0 / ker->bsNum;
+	  for(idN = 0; idN < ker->bsNum; ++idN)
+	  {
+	    ker->bsFilter[idN].re *= s;
+	    ker->bsFilter[idN].im *= s;
+	  }
+	  ker->wrkNum = (2 * ker->bsNum) + ker->sub->wrkNum;
 	}
+	AlcFree(wrk);
       }
     }
   }
-  return(errNum);
+  if(errNum != ALG_ERR_NONE)
+  {
+    AlgFourKernelFree(ker);
+    ker = NULL;
+  }
+  return(ker);
 }
 
 /*!
-* \return	Error code, may be set if buffers can not be allocated.
-* \brief	Computes repeated Fourier transforms of a 1D complex
-*	 	array within a complex array 3D.
-* \param	real			Given 3D real data array.
-* \param	imag			Given 3D imaginary data array.
-* \param	axis			Axis for partial evaluation.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
-* \param	numX			Number of data columns in given
-*					data array.
-* \param	numY			Number of data rows in given
-*					data array.
-* \param	numZ			Number of data planes in given
-*					data array.
-* \param	dir			Forward or inverse transform.
+* \return	void
+* \brief	Frees a kernel along with any kernel that it owns.
+* \param	kernel			Given kernel, may be NULL.
 */
-static AlgError	AlgFourRepXYZ1D(double ***real, double ***imag,
-			        AlgFourAxis axis, int useBuf,
-			        int numX, int numY, int numZ, AlgFourDir dir)
+static void	AlgFourKernelFree(AlgFourKernel *ker)
 {
-  int		idX,
-  		idY,
-		idZ;
-  AlgError	errNum = ALG_ERR_NONE;
+  if(ker)
+  {
+    AlgFourKernelFree(ker->sub);
+    AlcFree(ker->tw);
+    AlcFree(ker->bsChirp);
+    AlcFree(ker->bsFilter);
+    AlcFree(ker);
+  }
+}
+
+/*!
+* \return	void
+* \brief	Computes the forward unscaled Fourier transform of the
+*		given contiguous complex data in place using the given
+*		complex kernel.
+* \param	kernel			Given complex kernel.
+* \param	dat			Given data.
+* \param	wrk			Work space with at least
+*					kernel->wrkNum elements.
+*/
+static void	AlgFourKernelCpx(const AlgFourKernel *ker, ComplexD *dat,
+			       ComplexD *wrk)
+{
+  int		idN;
 
-  switch(axis)
+  if(ker->bsNum > 0)
   {
-    case ALG_FOUR_AXIS_X:
-      /* Transform rows */
-#ifdef _OPENMP
-#pragma omp parallel for private(idY,idZ)
-#endif
-      for(idZ = 0; idZ < numZ; ++idZ)
+    ComplexD	*cnv;
+
+    /* Bluestein: chirp multiply, convolve with the filter and chirp
+     * multiply again. The inverse convolution transform is computed
+     * using the forward transform of the conjugate. */
+    cnv = wrk + ker->bsNum;
+    for(idN = 0; idN < ker->num; ++idN)
+    {
+      ComplexD	d,
+      		c;
+
+      d = dat[idN];
+      c = ker->bsChirp[idN];
+      cnv[idN].re = (d.re * c.re) - (d.im * c.im);
+      cnv[idN].im = (d.re * c.im) + (d.im * c.re);
+    }
+    for(idN = ker->num; idN < ker->bsNum; ++idN)
+    {
+      cnv[idN].re = cnv[idN].im = 0.0;
+    }
+    AlgFourKernelCpx(ker->sub, cnv, wrk + (2 * ker->bsNum));
+    for(idN = 0; idN < ker->bsNum; ++idN)
+    {
+      ComplexD	d,
+      		f;
+
+      d = cnv[idN];
+      f = ker->bsFilter[idN];
+      cnv[idN].re = (d.re * f.re) - (d.im * f.im);
+      cnv[idN].im = -((d.re * f.im) + (d.im * f.re));
+    }
+    AlgFourKernelCpx(ker->sub, cnv, wrk + (2 * ker->bsNum));
+    for(idN = 0; idN < ker->num; ++idN)
+    {
+      ComplexD	d,
+      		c;
+
+      d = cnv[idN];
+      d.im = -(d.im);
+      c = ker->bsChirp[idN];
+      dat[idN].re = (d.re * c.re) - (d.im * c.im);
+      dat[idN].im = (d.re * c.im) + (d.im * c.re);
+    }
+  }
+  else if(ker->nFac > 0)
+  {
+    for(idN = 0; idN < ker->num; ++idN)
+    {
+      wrk[idN] = dat[idN];
+    }
+    AlgFourKernelMR(dat, wrk, 1, ker->fac, ker->tw, ker->num);
+  }
+}
+
+/*!
+* \return	void
+* \brief	Recursive decimation in time mixed radix forward Fourier
+*		transform with radix 2, 3, 4, 5 and generic butterflies.
+* \param	out			Destination for the transformed data.
+* \param	in			Given data, distinct from out.
+* \param	fStride			Stride through the given data and
+*					twiddle factors at this level.
+* \param	fac			Radix and remaining length pairs
+*					for this and subsequent levels.
+* \param	tw			Twiddle factors.
+* \param	num			Transform length of the kernel.
+*/
+static void	AlgFourKernelMR(ComplexD *out, const ComplexD *in, int fStride,
+			      const int *fac, const ComplexD *tw, int num)
+{
+  int		idK,
+  		idQ,
+		p,
+		m;
+
+  p = fac[0];
+  m = fac[1];
+  if(m == 1)
+  {
+    for(idQ = 0; idQ < p; ++idQ)
+    {
+      out[idQ] = in[idQ * fStride];
+    }
+  }
+  else
+  {
+    for(idQ = 0; idQ < p; ++idQ)
+    {
+      AlgFourKernelMR(out + (idQ * m), in + (idQ * fStride), fStride * p,
+		    fac + 2, tw, num);
+    }
+  }
+  switch(p)
+  {
+    case 2:
+      for(idK = 0; idK < m; ++idK)
       {
-	for(idY = 0; idY < numY; ++idY)
-	{
-	  if(dir == ALG_FOUR_DIR_FWD)
-	  {
-	    AlgFour1D(*(*(real + idZ) + idY), *(*(imag + idZ) + idY),
-		numX, 1);
-	  }
-	  else
-	  {
-	    AlgFourInv1D(*(*(real + idZ) + idY), *(*(imag + idZ) + idY),
-		numX, 1);
-	  }
-	}
+	ComplexD	t,
+			w;
+
+	w = tw[idK * fStride];
+	t.re = (out[m + idK].re * w.re) - (out[m + idK].im * w.im);
+	t.im = (out[m + idK].re * w.im) + (out[m + idK].im * w.re);
+	out[m + idK].re = out[idK].re - t.re;
+	out[m + idK].im = out[idK].im - t.im;
+	out[idK].re += t.re;
+	out[idK].im += t.im;
       }
       break;
-    case ALG_FOUR_AXIS_Y:
-      /* Transform columns */
-      if(useBuf)
+    case 3:
       {
-	int	nThr = 1;
-	double	*bufBase = NULL;
+	double	e;
 
-#ifdef _OPENMP
-#pragma omp parallel
-	{
-#pragma omp master
-	  {
-	    nThr = omp_get_num_threads();
-	  }
-	}
-#endif
-	if((bufBase = AlcMalloc(sizeof(double) * numY * 2 * nThr)) == NULL)
+	e = tw[fStride * m].im;
+	for(idK = 0; idK < m; ++idK)
 	{
-	  errNum = ALG_ERR_MALLOC;
-	}
-	if(errNum == ALG_ERR_NONE)
-	{
-#ifdef _OPENMP
-#pragma omp parallel for private(idX,idY,idZ) num_threads(nThr)
-#endif
-	  for(idZ = 0; idZ < numZ; ++idZ)
-	  {
-	    int	    thrId = 0;
-	    double  *reBuf,
-		    *imBuf;
-
-#ifdef _OPENMP
-	    thrId = omp_get_thread_num();
-#endif
-	    reBuf = bufBase + (2 * numY * thrId);
-	    imBuf = reBuf + numY;
-	    for(idX = 0; idX < numX; ++idX)
-	    {
-	      /* Copy to buffer. */
-	      for(idY = 0; idY < numY; ++idY)
-	      {
-		*(reBuf + idY) = *(*(*(real + idZ) + idY) + idX);
-		*(imBuf + idY) = *(*(*(imag + idZ) + idY) + idX);
-	      }
-	      /* Transform buffer. */
-	      if(dir == ALG_FOUR_DIR_FWD)
-	      {
-		AlgFour1D(reBuf, imBuf, numY, 1);
-	      }
-	      else
-	      {
-		AlgFourInv1D(reBuf, imBuf, numY, 1);
-	      }
-	      /* Copy back from buffer. */
-	      for(idY = 0; idY < numY; ++idY)
-	      {
-		*(*(*(real + idZ) + idY) + idX) = *(reBuf + idY);
-		*(*(*(imag + idZ) + idY) + idX) = *(imBuf + idY);
-	      }
-	    }
-	  }
-	  AlcFree(bufBase);
+	  ComplexD	s[4],
+	  		w[2],
+			*f[3];
+
+	  f[0] = out + idK;
+	  f[1] = f[0] + m;
+	  f[2] = f[1] + m;
+	  w[0] = tw[idK * fStride];
+	  w[1] = tw[2 * idK * fStride];
+	  s[1].re = (f[1]->re * w[0].re) - (f[1]->im * w[0].im);
+	  s[1].im = (f[1]->re * w[0].im) + (f[1]->im * w[0].re);
+	  s[2].re = (f[2]->re * w[1].re) - (f[2]->im * w[1].im);
+	  s[2].im = (f[2]->re * w[1].im) + (f[2]->im * w[1].re);
+	  s[3].re = s[1].re + s[2].re;
+	  s[3].im = s[1].im + s[2].im;
+	  s[0].re = (s[1].re - s[2].re) * e;
+	  s[0].im = (s[1].im - s[2].im) * e;
+	  f[1]->re = f[0]->re - (0.5 * s[3].re);
+	  f[1]->im = f[0]->im - (0.5 * s[3].im);
+	  f[0]->re += s[3].re;
+	  f[0]->im += s[3].im;
+	  f[2]->re = f[1]->re + s[0].im;
+	  f[2]->im = f[1]->im - s[0].re;
+	  f[1]->re -= s[0].im;
+	  f[1]->im += s[0].re;
 	}
       }
-      else
+      break;
+    case 4:
+      for(idK = 0; idK < m; ++idK)
       {
-#ifdef _OPENMP
-#pragma omp parallel for private(idX,idY,idZ)
-#endif
-	for(idZ = 0; idZ < numZ; ++idZ)
-	{
-	  for(idX = 0; idX < numX; ++idX)
-	  {
-	    if(dir == ALG_FOUR_DIR_FWD)
-	    {
-	      AlgFour1D(**(real + idZ) + idX, **(imag + idZ) + idX,
-		  numY, numX);
-	    }
-	    else
-	    {
-	      AlgFourInv1D(**(real + idZ) + idX, **(imag + idZ) + idX,
-		  numY, numX);
-	    }
-	  }
-	}
+	ComplexD	s[6],
+			w[3],
+			*f[4];
+
+	f[0] = out + idK;
+	f[1] = f[0] + m;
+	f[2] = f[1] + m;
+	f[3] = f[2] + m;
+	w[0] = tw[idK * fStride];
+	w[1] = tw[2 * idK * fStride];
+	w[2] = tw[3 * idK * fStride];
+	s[0].re = (f[1]->re * w[0].re) - (f[1]->im * w[0].im);
+	s[0].im = (f[1]->re * w[0].im) + (f[1]->im * w[0].re);
+	s[1].re = (f[2]->re * w[1].re) - (f[2]->im * w[1].im);
+	s[1].im = (f[2]->re * w[1].im) + (f[2]->im * w[1].re);
+	s[2].re = (f[3]->re * w[2].re) - (f[3]->im * w[2].im);
+	s[2].im = (f[3]->re * w[2].im) + (f[3]->im * w[2].re);
+	s[5].re = f[0]->re - s[1].re;
+	s[5].im = f[0]->im - s[1].im;
+	f[0]->re += s[1].re;
+	f[0]->im += s[1].im;
+	s[3].re = s[0].re + s[2].re;
+	s[3].im = s[0].im + s[2].im;
+	s[4].re = s[0].re - s[2].re;
+	s[4].im = s[0].im - s[2].im;
+	f[2]->re = f[0]->re - s[3].re;
+	f[2]->im = f[0]->im - s[3].im;
+	f[0]->re += s[3].re;
+	f[0]->im += s[3].im;
+	f[1]->re = s[5].re + s[4].im;
+	f[1]->im = s[5].im - s[4].re;
+	f[3]->re = s[5].re - s[4].im;
+	f[3]->im = s[5].im + s[4].re;
       }
       break;
-    case ALG_FOUR_AXIS_Z:
-      /* Transform columns */
-      if(useBuf)
+    case 5:
       {
-	int	nThr = 1;
-	double	*bufBase = NULL;
+	ComplexD	ya,
+			yb;
 
-#ifdef _OPENMP
-#pragma omp parallel
+	ya = tw[fStride * m];
+	yb = tw[2 * fStride * m];
+	for(idK = 0; idK < m; ++idK)
 	{
-#pragma omp master
+	  int		idF;
+	  ComplexD	s[13],
+			*f[5];
+
+	  f[0] = out + idK;
+	  s[0] = *f[0];
+	  for(idF = 1; idF < 5; ++idF)
 	  {
-	    nThr = omp_get_num_threads();
+	    ComplexD	w;
+
+	    f[idF] = f[idF - 1] + m;
+	    w = tw[idF * idK * fStride];
+	    s[idF].re = (f[idF]->re * w.re) - (f[idF]->im * w.im);
+	    s[idF].im = (f[idF]->re * w.im) + (f[idF]->im * w.re);
 	  }
+	  s[7].re = s[1].re + s[4].re;
+	  s[7].im = s[1].im + s[4].im;
+	  s[10].re = s[1].re - s[4].re;
+	  s[10].im = s[1].im - s[4].im;
+	  s[8].re = s[2].re + s[3].re;
+	  s[8].im = s[2].im + s[3].im;
+	  s[9].re = s[2].re - s[3].re;
+	  s[9].im = s[2].im - s[3].im;
+	  f[0]->re += s[7].re + s[8].re;
+	  f[0]->im += s[7].im + s[8].im;
+	  s[5].re = s[0].re + (s[7].re * ya.re) + (s[8].re * yb.re);
+	  s[5].im = s[0].im + (s[7].im * ya.re) + (s[8].im * yb.re);
+	  s[6].re = (s[10].im * ya.im) + (s[9].im * yb.im);
+	  s[6].im = -(s[10].re * ya.im) - (s[9].re * yb.im);
+	  f[1]->re = s[5].re - s[6].re;
+	  f[1]->im = s[5].im - s[6].im;
+	  f[4]->re = s[5].re + s[6].re;
+	  f[4]->im = s[5].im + s[6].im;
+	  s[11].re = s[0].re + (s[7].re * yb.re) + (s[8].re * ya.re);
+	  s[11].im = s[0].im + (s[7].im * yb.re) + (s[8].im * ya.re);
+	  s[12].re = -(s[10].im * yb.im) + (s[9].im * ya.im);
+	  s[12].im = (s[10].re * yb.im) - (s[9].re * ya.im);
+	  f[2]->re = s[11].re + s[12].re;
+	  f[2]->im = s[11].im + s[12].im;
+	  f[3]->re = s[11].re - s[12].re;
+	  f[3]->im = s[11].im - s[12].im;
 	}
-#endif
-	if((bufBase = AlcMalloc(sizeof(double) * numZ * 2 * nThr)) == NULL)
+      }
+      break;
+    default:
+      for(idK = 0; idK < m; ++idK)
+      {
+	int		idF,
+			idW,
+			idT;
+	ComplexD	s[ALG_FOUR_MAX_RADIX];
+
+	for(idF = 0; idF < p; ++idF)
 	{
-	  errNum = ALG_ERR_MALLOC;
+	  s[idF] = out[idK + (idF * m)];
 	}
-	if(errNum == ALG_ERR_NONE)
+	for(idF = 0; idF < p; ++idF)
 	{
-#ifdef _OPENMP
-#pragma omp parallel for private(idX,idY,idZ) num_threads(nThr)
-#endif
-	  for(idY = 0; idY < numY; ++idY)
-	  {
-	    int	    thrId = 0;
-	    double  *reBuf,
-		    *imBuf;
+	  ComplexD	a;
 
-#ifdef _OPENMP
-	    thrId = omp_get_thread_num();
-#endif
-	    reBuf = bufBase + (2 * numZ * thrId);
-	    imBuf = reBuf + numZ;
-	    for(idX = 0; idX < numX; ++idX)
+	  idW = idK + (idF * m);
+	  idT = 0;
+	  a = s[0];
+	  for(idQ = 1; idQ < p; ++idQ)
+	  {
+	    idT += fStride * idW;
+	    if(idT >= num)
 	    {
-	      /* Copy to buffer. */
-	      for(idZ = 0; idZ < numZ; ++idZ)
-	      {
-		*(reBuf + idZ) = *(*(*(real + idZ) + idY) + idX);
-		*(imBuf + idZ) = *(*(*(imag + idZ) + idY) + idX);
-	      }
-	      /* Transform buffer. */
-	      if(dir == ALG_FOUR_DIR_FWD)
-	      {
-		AlgFour1D(reBuf, imBuf, numZ, 1);
-	      }
-	      else
-	      {
-		AlgFourInv1D(reBuf, imBuf, numZ, 1);
-	      }
-	      /* Copy back from buffer. */
-	      for(idZ = 0; idZ < numZ; ++idZ)
-	      {
-		*(*(*(real + idZ) + idY) + idX) = *(reBuf + idZ);
-		*(*(*(imag + idZ) + idY) + idX) = *(imBuf + idZ);
-	      }
+	      idT -= num;
 	    }
+	    a.re += (s[idQ].re * tw[idT].re) - (s[idQ].im * tw[idT].im);
+	    a.im += (s[idQ].re * tw[idT].im) + (s[idQ].im * tw[idT].re);
 	  }
-	  AlcFree(bufBase);
+	  out[idW] = a;
 	}
       }
-      else
-      {
-#ifdef _OPENMP
-#pragma omp parallel for private(idX,idY)
-#endif
-	for(idY = 0; idY < numY; ++idY)
-	{
-	  for(idX = 0; idX < numX; ++idX)
-	  {
-	    if(dir == ALG_FOUR_DIR_FWD)
-	    {
-	      AlgFour1D(*(*real + idY) + idX, *(*imag + idY) + idX,
-		  numZ, numX * numY);
-	    }
-	    else
-	    {
-	      AlgFourInv1D(*(*real + idY) + idX, *(*imag + idY) + idX,
-		  numZ, numX * numY);
-	    }
-	  }
-	}
-      }
-      break;
-    default:
       break;
   }
-  return(errNum);
 }
 
 /*!
-* \return	Error code, may be set if buffers can not be allocated.
-* \brief	Computes repeated the Fourier transforms of the given
-*	 	one dimensional real data array.
-* \brief	Computes repeated Fourier transforms of a 1D real/
-*	 	complex conjugate array within a 3D real/complex conjugate
-*	 	array.
-* \param	data			Given 2D data array.
-* \param	axis			Axis for partial evaluation.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
-* \param	numX			Number of data columns in given
-*					data array.
-* \param	numY			Number of data rows in given
-*					data array.
-* \param	numZ			Number of data planes in given
-*					data array.
+* \return	void
+* \brief	Computes the unscaled forward or inverse Fourier transform
+*		of the given one dimensional data in place using the given
+*		kernel.
+* \param	ker			Given kernel, if NULL the data are not
+*					modified.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data, NULL for real
+*					data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
 * \param	dir			Forward or inverse transform.
+* \param	wrk			Work space with at least
+*					ker->num + ker->wrkNum elements,
+*					if NULL work space is allocated.
 */
-static AlgError	AlgFourRepXYZReal1D(double ***data, AlgFourAxis axis,
-				    int useBuf,
-				    int numX, int numY, int numZ,
-				    AlgFourDir dir)
+static void	AlgFourKernelLine(const AlgFourKernel *ker,
+				  double *real, double *imag, int step,
+				  AlgFourDir dir, ComplexD *wrk)
 {
-  int		idX,
-		idY,
-		idZ,
-		halfData;
-  AlgError	errNum = ALG_ERR_NONE;
+  ComplexD	*buf;
 
-  switch(axis)
+  buf = wrk;
+  if((ker != NULL) &&
+     ((buf != NULL) ||
+      ((buf = (ComplexD *)AlcMalloc(sizeof(ComplexD) *
+                                    (ker->num + ker->wrkNum))) != NULL)))
   {
-    case  ALG_FOUR_AXIS_X:
-      /* Transform rows */
-#ifdef _OPENMP
-#pragma omp parallel for private(idX,idY,idZ)
-#endif
-      for(idZ = 0; idZ < numZ; ++idZ)
+    if(imag)
+    {
+      AlgFourKernelCpx1D(ker, real, imag, step, dir, buf);
+    }
+    else
+    {
+      AlgFourKernelReal1D(ker, real, step, dir, buf);
+    }
+    if(wrk == NULL)
+    {
+      AlcFree(buf);
+    }
+  }
+}
+
+/*!
+* \return	void
+* \brief	Computes the unscaled forward or inverse Fourier transform
+*		of the given one dimensional complex data in place using
+*		the given complex kernel. The inverse transform is computed
+*		as the conjugate of the forward transform of the conjugate.
+* \param	ker			Given complex kernel.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
+* \param	dir			Forward or inverse transform.
+* \param	dat			Work space with at least
+*					ker->num + ker->wrkNum elements.
+*/
+static void	AlgFourKernelCpx1D(const AlgFourKernel *ker,
+				   double *real, double *imag, int step,
+				   AlgFourDir dir, ComplexD *dat)
+{
+  int		idN;
+  double	sgn;
+
+  sgn = (dir == ALG_FOUR_DIR_FWD)? 1.0: -1.0;
+  for(idN = 0; idN < ker->num; ++idN)
+  {
+    dat[idN].re = real[idN * step];
+    dat[idN].im = sgn * imag[idN * step];
+  }
+  AlgFourKernelCpx(ker, dat, dat + ker->num);
+  for(idN = 0; idN < ker->num; ++idN)
+  {
+    real[idN * step] = dat[idN].re;
+    imag[idN * step] = sgn * dat[idN].im;
+  }
+}
+
+/*!
+* \return	void
+* \brief	Computes the unscaled forward or inverse Fourier transform
+*		of the given one dimensional real data in place using
+*		the given real kernel. The transformed data have the layout
+*		described for AlgFourReal1D(). For even lengths the
+*		real data are packed into complex data of half the
+*		length and the transform of the packed data is split
+*		using the kernel's twiddle factors.
+* \param	kernel			Given real kernel, if NULL the data are
+*					not modified.
+* \param	real			Given real data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
+* \param	dir			Forward or inverse transform.
+*/
+static void	AlgFourKernelReal1D(const AlgFourKernel *ker,
+				    double *real, int step, AlgFourDir dir,
+				    ComplexD *dat)
+{
+  int		idN,
+  		num,
+		half;
+
+  num = ker->num;
+  half = num / 2;
+  if((num & 1) == 0)
+  {
+    if(dir == ALG_FOUR_DIR_FWD)
+    {
+      for(idN = 0; idN < half; ++idN)
       {
-	for(idY = 0; idY < numY; ++idY)
-	{
-	  if(dir == ALG_FOUR_DIR_FWD)
-	  {
-	    AlgFourReal1D(*(*(data + idZ) + idY), numX, 1);
-	  }
-	  else
-	  {
-	    AlgFourRealInv1D(*(*(data + idZ) + idY), numX, 1);
-	  }
-	}
+	dat[idN].re = real[2 * idN * step];
+	dat[idN].im = real[((2 * idN) + 1) * step];
       }
-      break;
-    case  ALG_FOUR_AXIS_Y:
-      /* Transform columns */
-      halfData = numY / 2;
-      if(useBuf)
+      AlgFourKernelCpx(ker->sub, dat, dat + half);
+      real[0] = dat[0].re + dat[0].im;
+      real[half * step] = dat[0].re - dat[0].im;
+      for(idN = 1; idN < half; ++idN)
+      {
+	ComplexD	z,
+			c,
+			e,
+			o,
+			w;
+
+	z = dat[idN];
+	c = dat[half - idN];
+	c.im = -(c.im);
+	e.re = 0.5 * (z.re + c.re);
+	e.im = 0.5 * (z.im + c.im);
+	o.re = 0.5 * (z.im - c.im);
+	o.im = -0.5 * (z.re - c.re);
+	w = ker->tw[idN];
+	real[idN * step] = e.re + (w.re * o.re) - (w.im * o.im);
+	real[(half + idN) * step] = e.im + (w.re * o.im) + (w.im * o.re);
+      }
+    }
+    else
+    {
+      for(idN = 0; idN < half; ++idN)
+      {
+	ComplexD	x,
+			c,
+			s,
+			d,
+			w;
+
+	x.re = real[idN * step];
+	x.im = (idN > 0)? real[(half + idN) * step]: 0.0;
+	c.re = real[(half - idN) * step];
+	c.im = (idN > 0)? -real[(num - idN) * step]: 0.0;
+	s.re = x.re + c.re;
+	s.im = x.im + c.im;
+	d.re = x.re - c.re;
+	d.im = x.im - c.im;
+	/* Z = s + i d conj(w), stored conjugated for the inverse. */
+	w = ker->tw[idN];
+	dat[idN].re = s.re + (d.re * w.im) - (d.im * w.re);
+	dat[idN].im = -(s.im + ((d.re * w.re) + (d.im * w.im)));
+      }
+      AlgFourKernelCpx(ker->sub, dat, dat + half);
+      for(idN = 0; idN < half; ++idN)
       {
-	int	nThr = 1;
-	double	*bufBase = NULL;
+	real[2 * idN * step] = dat[idN].re;
+	real[((2 * idN) + 1) * step] = -(dat[idN].im);
+      }
+    }
+  }
+  else
+  {
+    if(dir == ALG_FOUR_DIR_FWD)
+    {
+      for(idN = 0; idN < num; ++idN)
+      {
+	dat[idN].re = real[idN * step];
+	dat[idN].im = 0.0;
+      }
+      AlgFourKernelCpx(ker->sub, dat, dat + num);
+      for(idN = 0; idN <= half; ++idN)
+      {
+	real[idN * step] = dat[idN].re;
+      }
+      for(idN = 1; idN <= half; ++idN)
+      {
+	real[(half + idN) * step] = dat[idN].im;
+      }
+    }
+    else
+    {
+      dat[0].re = real[0];
+      dat[0].im = 0.0;
+      for(idN = 1; idN <= half; ++idN)
+      {
+	dat[idN].re = dat[num - idN].re = real[idN * step];
+	dat[idN].im = -real[(half + idN) * step];
+	dat[num - idN].im = -(dat[idN].im);
+      }
+      AlgFourKernelCpx(ker->sub, dat, dat + num);
+      for(idN = 0; idN < num; ++idN)
+      {
+	real[idN * step] = dat[idN].re;
+      }
+    }
+  }
+}
 
-#ifdef _OPENMP
-#pragma omp parallel
+/*!
+* \return	Error code.
+* \brief	Initialises the given plan, getting the kernels needed for
+*		the lengths which are not integer powers of two.
+* \param	plan			Given plan to initialise.
+* \param	dim			Dimension of the data: 1, 2 or 3.
+* \param	real			Non-zero for real transforms.
+* \param	numX			Number of data in each row.
+* \param	numY			Number of data in each column.
+* \param	numZ			Number of data in each plane.
+* \param	own			Non-zero if the plan should make and
+*					own its kernels, zero if it should
+*					share cached kernels.
+*/
+static AlgError	AlgFourPlanInit(AlgFourPlan *plan, int dim, int real,
+				int numX, int numY, int numZ, int own)
+{
+  int		idA;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  plan->dim = dim;
+  plan->real = (real != 0);
+  plan->own = own;
+  plan->num[0] = numX;
+  plan->num[1] = (dim > 1)? numY: 1;
+  plan->num[2] = (dim > 2)? numZ: 1;
+  plan->wrkNum = 0;
+  for(idA = 0; idA < 3; ++idA)
+  {
+    plan->cpx[idA] = NULL;
+    plan->rel[idA] = NULL;
+  }
+  if((dim < 1) || (dim > 3) ||
+     (plan->num[0] < 1) || (plan->num[1] < 1) || (plan->num[2] < 1) ||
+     (plan->real && AlgFourUseKernel(numX) && ((numX & 1) != 0)))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  for(idA = 0; (errNum == ALG_ERR_NONE) && (idA < dim); ++idA)
+  {
+    int		num;
+
+    num = plan->num[idA];
+    if(AlgFourUseKernel(num))
+    {
+      /* Real transforms use real kernels for the rows and both real and
+       * complex kernels for the columns and planes. */
+      if((plan->real == 0) || (idA > 0))
+      {
+	plan->cpx[idA] = (own)? AlgFourKernelMake(num, 0):
+				AlgFourKernelGet(num, 0);
+	if(plan->cpx[idA] == NULL)
 	{
-#pragma omp master
-	  {
-	    nThr = omp_get_num_threads();
-	  }
+	  errNum = ALG_ERR_MALLOC;
 	}
-#endif
-	if((bufBase = AlcMalloc(sizeof(double) * numY * 2 * nThr)) == NULL)
+	else
+	{
+	  plan->wrkNum = ALG_MAX(plan->wrkNum,
+	                         num + plan->cpx[idA]->wrkNum);
+	}
+      }
+      if((errNum == ALG_ERR_NONE) && plan->real)
+      {
+	plan->rel[idA] = (own)? AlgFourKernelMake(num, 1):
+				AlgFourKernelGet(num, 1);
+	if(plan->rel[idA] == NULL)
 	{
 	  errNum = ALG_ERR_MALLOC;
 	}
-	if(errNum == ALG_ERR_NONE)
+	else
 	{
+	  plan->wrkNum = ALG_MAX(plan->wrkNum,
+	                         num + plan->rel[idA]->wrkNum);
+	}
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \brief	Computes the forward or inverse Fourier transform of the
+*		given contiguous data in place using the given plan.
+*		Forward transforms are computed along the x, y and then z
+*		axes and inverse transforms in the reverse order. Each
+*		thread allocates its buffers once and then the lines along
+*		each axis are shared between the threads.
+* \param	plan			Given plan.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data, NULL for real
+*					transforms.
+* \param	dir			Forward or inverse transform.
+*/
+static AlgError	AlgFourPlanExec(const AlgFourPlan *plan,
+				double *real, double *imag, AlgFourDir dir)
+{
+  int		maxNum;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  maxNum = ALG_MAX3(plan->num[0], plan->num[1], plan->num[2]);
 #ifdef _OPENMP
-#pragma omp parallel for private(idX,idY,idZ)
+#pragma omp parallel
 #endif
-	  for(idZ = 0; idZ < numZ; ++idZ)
-	  {
-	    int	thrId = 0;
-	    double  *reBuf,
-	    	    *imBuf;
+  {
+    int		idA;
+    double	*buf;
+    ComplexD	*wrk = NULL;
+
+    buf = (double *)AlcMalloc(sizeof(double) * 2 * ALG_FOUR_BLK * maxNum);
+    if(plan->wrkNum > 0)
+    {
+      wrk = (ComplexD *)AlcMalloc(sizeof(ComplexD) * plan->wrkNum);
+    }
+    if((buf == NULL) || ((plan->wrkNum > 0) && (wrk == NULL)))
+    {
 #ifdef _OPENMP
-	    thrId = omp_get_thread_num();
+#pragma omp critical (AlgFourPlanExec)
 #endif
-	    reBuf = bufBase + (2 * numY * thrId);
-	    imBuf = reBuf + numY;
-	    /* Copy to buffer. */
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      *(reBuf + idY) = **(*(data + idZ) + idY);
-	      *(imBuf + idY) = *(*(*(data + idZ) + idY) + halfData);
-	    }
-	    if(dir == ALG_FOUR_DIR_FWD)
-	    {
-	      AlgFourReal1D(reBuf, numY, 1);
-	      AlgFourReal1D(imBuf, numY, 1);
-	    }
-	    else
-	    {
-	      AlgFourRealInv1D(reBuf, numY, 1);
-	      AlgFourRealInv1D(imBuf, numY, 1);
-	    }
-	    /* Copy back from buffer again. */
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      **(*(data + idZ) + idY) = *(reBuf + idY);
-	      *(*(*(data + idZ) + idY) + halfData) = *(imBuf + idY);
-	    }
-	    for(idX = 1; idX < halfData; ++idX)
-	    {
-	      /* Copy to buffer. */
-	      for(idY = 0; idY < numY; ++idY)
-	      {
-		*(reBuf + idY) = *(*(*(data + idZ) + idY) + idX);
-		*(imBuf + idY) = *(*(*(data + idZ) + idY) + halfData + idX);
-	      }
-	      if(dir == ALG_FOUR_DIR_FWD)
-	      {
-		AlgFour1D(reBuf, imBuf, numY, 1);
-	      }
-	      else
-	      {
-		AlgFourInv1D(reBuf, imBuf, numY, 1);
-	      }
-	      /* Copy back. */
-	      for(idY = 0; idY < numY; ++idY)
-	      {
-		*(*(*(data + idZ) + idY) + idX) = *(reBuf + idY);
-		*(*(*(data + idZ) + idY) + halfData + idX) = *(imBuf + idY);
-	      }
-	    }
-	  }
-	  AlcFree(bufBase);
-        }
-      }
-      else
       {
+	errNum = ALG_ERR_MALLOC;
+      }
+    }
 #ifdef _OPENMP
-#pragma omp parallel for private(idX,idY,idZ)
+#pragma omp barrier
 #endif
-	for(idZ = 0; idZ < numZ; ++idZ)
-	{
-	  if(dir == ALG_FOUR_DIR_FWD)
-	  {
-	    AlgFourReal1D(**(data + idZ), numY, numX);
-	    AlgFourReal1D(**(data + idZ) + halfData, numY, numX);
-	    for(idX = 1; idX < halfData; ++idX)
-	    {
-	      AlgFour1D(**(data + idZ) + idX,
-		  **(data + idZ) + halfData + idX, numY, numX);
-	    }
-	  }
-	  else
-	  {
-	    AlgFourRealInv1D(**(data + idZ), numY, numX);
-	    AlgFourRealInv1D(**(data + idZ) + halfData, numY, numX);
-	    for(idX = 1; idX < halfData; ++idX)
-	    {
-	      AlgFourInv1D(**(data + idZ) + idX,
-		  **(data + idZ) + halfData + idX, numY, numX);
-	    }
-	  }
-	}
-      }
-      break;
-    case  ALG_FOUR_AXIS_Z:
-      /* Transform planes */
-      halfData = numX / 2;
-      if(useBuf)
+    if(errNum == ALG_ERR_NONE)
+    {
+      for(idA = 0; idA < plan->dim; ++idA)
       {
-	int	nThr = 1;
-	double	*bufBase = NULL;
+	AlgFourAxis axis;
+
+	axis = (AlgFourAxis )((dir == ALG_FOUR_DIR_FWD)?
+	                      idA: plan->dim - 1 - idA);
+	AlgFourPlanAxis(plan, real, imag, axis, dir, buf, wrk);
+      }
+    }
+    AlcFree(buf);
+    AlcFree(wrk);
+  }
+  return(errNum);
+}
 
+/*!
+* \return	void
+* \brief	Computes the forward or inverse Fourier transforms along
+*		the given axis. This function must be called by all threads
+*		of the enclosing parallel region since it shares the lines
+*		between them. Rows are transformed in place, while columns
+*		and planes are transformed in blocks of ALG_FOUR_BLK
+*		adjacent lines which are copied to and from contiguous
+*		buffers. For real transforms the columns and planes at
+*		x = 0 and x = numX / 2 are real and the remaining lines
+*		are complex with the real part at x and the imaginary part
+*		at numX / 2 + x.
+* \param	plan			Given plan.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data, NULL for real
+*					transforms.
+* \param	axis			Axis along which to transform.
+* \param	dir			Forward or inverse transform.
+* \param	buf			Buffer for this thread with room for
+*					2 ALG_FOUR_BLK lines of the longest
+*					axis.
+* \param	wrk			Kernel work space for this thread.
+*/
+static void	AlgFourPlanAxis(const AlgFourPlan *plan,
+				double *real, double *imag,
+				AlgFourAxis axis, AlgFourDir dir,
+				double *buf, ComplexD *wrk)
+{
+  int		num,
+  		numX,
+		numXY;
+
+  numX = plan->num[0];
+  numXY = numX * plan->num[1];
+  num = plan->num[axis];
+  if(num > 1)
+  {
+    if(axis == ALG_FOUR_AXIS_X)
+    {
+      int	idL,
+      		nLn;
+
+      nLn = plan->num[1] * plan->num[2];
 #ifdef _OPENMP
-#pragma omp parallel
-	{
-#pragma omp master
-	  {
-	    nThr = omp_get_num_threads();
-	  }
-	}
+#pragma omp for schedule(static)
 #endif
-	if((bufBase = AlcMalloc(sizeof(double) * numZ * 2 * nThr)) == NULL)
+      for(idL = 0; idL < nLn; ++idL)
+      {
+	if(plan->real)
 	{
-	  errNum = ALG_ERR_MALLOC;
+	  AlgFourPlanLine(plan->rel[0], num, real + (idL * numX), NULL, 1,
+	                  dir, wrk);
 	}
-	if(errNum == ALG_ERR_NONE)
+	else
 	{
-#ifdef _OPENMP
-#pragma omp parallel for private(idX,idY,idZ)
-#endif
-	  for(idY = 0; idY < numY; ++idY)
-	  {
-	    int	thrId = 0;
-	    double  *reBuf,
-	    	    *imBuf;
-#ifdef _OPENMP
-	    thrId = omp_get_thread_num();
-#endif
-	    reBuf = bufBase + (2 * numZ * thrId);
-	    imBuf = reBuf + numZ;
-	    /* Copy to buffer. */
-	    for(idZ = 0; idZ < numZ; ++idZ)
-	    {
-	      *(reBuf + idZ) = **(*(data + idZ) + idY);
-	      *(imBuf + idZ) = *(*(*(data + idZ) + idY) + halfData);
-	    }
-	    if(dir == ALG_FOUR_DIR_FWD)
-	    {
-	      AlgFourReal1D(reBuf, numZ, 1);
-	      AlgFourReal1D(imBuf, numZ, 1);
-	    }
-	    else
-	    {
-	      AlgFourRealInv1D(reBuf, numZ, 1);
-	      AlgFourRealInv1D(imBuf, numZ, 1);
-	    }
-	    /* Copy back from buffer. */
-	    for(idZ = 0; idZ < numZ; ++idZ)
-	    {
-	      **(*(data + idZ) + idY) = *(reBuf + idZ);
-	      *(*(*(data + idZ) + idY) + halfData) = *(imBuf + idZ);
-	    }
-	    for(idX = 1; idX < halfData; ++idX)
-	    {
-	      /* Copy to buffer. */
-	      for(idZ = 0; idZ < numZ; ++idZ)
-	      {
-	        *(reBuf + idZ) = *(*(*(data + idZ) + idY) + idX);
-	        *(imBuf + idZ) = *(*(*(data + idZ) + idY) + halfData + idX);
-	      }
-	      if(dir == ALG_FOUR_DIR_FWD)
-	      {
-		AlgFour1D(reBuf, imBuf, numZ, 1);
-	      }
-	      else
-	      {
-		AlgFourInv1D(reBuf, imBuf, numZ, 1);
-	      }
-	      /* Copy back from buffer. */
-	      for(idZ = 0; idZ < numZ; ++idZ)
-	      {
-	        *(*(*(data + idZ) + idY) + idX) = *(reBuf + idZ);
-		*(*(*(data + idZ) + idY) + halfData + idX) = *(imBuf + idZ);
-	      }
-	    }
-
-	  }
-	  AlcFree(bufBase);
+	  AlgFourPlanLine(plan->cpx[0], num, real + (idL * numX),
+	  		  imag + (idL * numX), 1, dir, wrk);
 	}
       }
+    }
+    else
+    {
+      int	idT,
+      		step,
+		nOut,
+		outStep,
+		x0,
+		x1,
+		half,
+		nBlk,
+		nTsk;
+
+      if(axis == ALG_FOUR_AXIS_Y)
+      {
+	step = numX;
+	nOut = plan->num[2];
+	outStep = numXY;
+      }
       else
       {
+	step = numXY;
+	nOut = plan->num[1];
+	outStep = numX;
+      }
+      half = numX / 2;
+      if(plan->real)
+      {
+	x0 = 1;
+	x1 = half;
+      }
+      else
+      {
+	x0 = 0;
+	x1 = numX;
+      }
+      nBlk = (x1 > x0)? (x1 - x0 + ALG_FOUR_BLK - 1) / ALG_FOUR_BLK: 0;
+      /* Each outer line has the blocks of complex lines and, for real
+       * transforms, a task for the real lines. */
+      nTsk = nBlk + plan->real;
 #ifdef _OPENMP
-#pragma omp parallel for private(idX,idY,idZ)
+#pragma omp for schedule(dynamic)
 #endif
-	for(idY = 0; idY < numY; ++idY)
+      for(idT = 0; idT < nOut * nTsk; ++idT)
+      {
+	int	idB,
+		off;
+
+	idB = idT % nTsk;
+	off = (idT / nTsk) * outStep;
+	if(idB < nBlk)
 	{
-	  if(dir == ALG_FOUR_DIR_FWD)
-	  {
-	    AlgFourReal1D(*(*data + idY), numZ, numX * numY);
-	    AlgFourReal1D(*(*data + idY) + halfData, numZ, numX * numY);
-	    for(idX = 1; idX < halfData; ++idX)
-	    {
-	      AlgFour1D(*(*data + idY) + idX,
-		  *(*data + idY) + halfData + idX, numZ, numX * numY);
-	    }
-	  }
-	  else
+	  int	xS,
+	  	nB;
+
+	  xS = x0 + (idB * ALG_FOUR_BLK);
+	  nB = ALG_MIN(ALG_FOUR_BLK, x1 - xS);
+	  AlgFourPlanBlock(plan->cpx[axis], num, step, nB,
+	                   real + off + xS,
+			   (plan->real)? real + off + half + xS:
+			                 imag + off + xS,
+			   dir, buf, wrk);
+	}
+	else
+	{
+	  AlgFourPlanBlock(plan->rel[axis], num, step, 1,
+	                   real + off, NULL, dir, buf, wrk);
+	  if(half > 0)
 	  {
-	    AlgFourRealInv1D(*(*data + idY), numZ, numX * numY);
-	    AlgFourRealInv1D(*(*data + idY) + halfData, numZ, numX * numY);
-	    for(idX = 1; idX < halfData; ++idX)
-	    {
-	      AlgFourInv1D(*(*data + idY) + idX,
-		  *(*data + idY) + halfData + idX, numZ, numX * numY);
-	    }
+	    AlgFourPlanBlock(plan->rel[axis], num, step, 1,
+			     real + off + half, NULL, dir, buf, wrk);
 	  }
 	}
       }
-      break;
-    default:
-      break;
+    }
+  }
+}
+
+/*!
+* \return	void
+* \brief	Copies a block of adjacent strided lines to a contiguous
+*		buffer, transforms them and then copies them back.
+* \param	ker			Kernel for the lines, NULL for integer
+*					power of two lengths.
+* \param	num			Number of data in each line.
+* \param	step			Offset in data elements between the
+*					data of each line.
+* \param	nBlk			Number of adjacent lines, not more
+*					than ALG_FOUR_BLK.
+* \param	real			Real data of the first line.
+* \param	imag			Imaginary data of the first line, NULL
+*					for real lines.
+* \param	dir			Forward or inverse transform.
+* \param	buf			Buffer with room for 2 ALG_FOUR_BLK
+*					lines.
+* \param	wrk			Kernel work space.
+*/
+static void	AlgFourPlanBlock(const AlgFourKernel *ker, int num, int step,
+				 int nBlk, double *real, double *imag,
+				 AlgFourDir dir, double *buf, ComplexD *wrk)
+{
+  int		idB,
+  		idN;
+  double	*reBuf,
+  		*imBuf;
+
+  reBuf = buf;
+  imBuf = buf + (ALG_FOUR_BLK * num);
+  for(idN = 0; idN < num; ++idN)
+  {
+    double	*rp;
+
+    rp = real + (idN * step);
+    for(idB = 0; idB < nBlk; ++idB)
+    {
+      reBuf[(idB * num) + idN] = rp[idB];
+    }
+  }
+  if(imag)
+  {
+    for(idN = 0; idN < num; ++idN)
+    {
+      double	*ip;
+
+      ip = imag + (idN * step);
+      for(idB = 0; idB < nBlk; ++idB)
+      {
+	imBuf[(idB * num) + idN] = ip[idB];
+      }
+    }
+  }
+  for(idB = 0; idB < nBlk; ++idB)
+  {
+    AlgFourPlanLine(ker, num, reBuf + (idB * num),
+		    (imag)? imBuf + (idB * num): NULL, 1, dir, wrk);
+  }
+  for(idN = 0; idN < num; ++idN)
+  {
+    double	*rp;
+
+    rp = real + (idN * step);
+    for(idB = 0; idB < nBlk; ++idB)
+    {
+      rp[idB] = reBuf[(idB * num) + idN];
+    }
+  }
+  if(imag)
+  {
+    for(idN = 0; idN < num; ++idN)
+    {
+      double	*ip;
+
+      ip = imag + (idN * step);
+      for(idB = 0; idB < nBlk; ++idB)
+      {
+	ip[idB] = imBuf[(idB * num) + idN];
+      }
+    }
+  }
+}
+
+/*!
+* \return	void
+* \brief	Computes the forward or inverse Fourier transform of a
+*		single line using the given kernel or, if the kernel is
+*		NULL, the fast Hartley transform based functions.
+* \param	ker			Kernel for the line, NULL for integer
+*					power of two lengths.
+* \param	num			Number of data in the line.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data, NULL for real
+*					data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
+* \param	dir			Forward or inverse transform.
+* \param	wrk			Kernel work space.
+*/
+static void	AlgFourPlanLine(const AlgFourKernel *ker, int num,
+				double *real, double *imag, int step,
+				AlgFourDir dir, ComplexD *wrk)
+{
+  if(num > 1)
+  {
+    if(ker)
+    {
+      AlgFourKernelLine(ker, real, imag, step, dir, wrk);
+    }
+    else if(imag)
+    {
+      if(dir == ALG_FOUR_DIR_FWD)
+      {
+	AlgFour1D(real, imag, num, step);
+      }
+      else
+      {
+	AlgFourInv1D(real, imag, num, step);
+      }
+    }
+    else
+    {
+      if(dir == ALG_FOUR_DIR_FWD)
+      {
+	AlgFourReal1D(real, num, step);
+      }
+      else
+      {
+	AlgFourRealInv1D(real, num, step);
+      }
+    }
   }
-  return(errNum);
 }
@@ -129,6 +129,10 @@ extern AlgError        		AlgCrossCorrelate2D(
 				  double **data1,
 				  int nX,
 				  int nY);
+extern AlgError			AlgCrossCorrelate2DPlan(
+				  const AlgFourPlan *plan,
+				  double **data0,
+				  double **data1);
 extern void            		AlgCrossCorrPeakXY(
 				  int *dstMaxX,
 				  int *dstMaxY,
@@ -224,6 +228,34 @@ extern AlgError        		AlgFourRealInv3D(
 				  int numX,
 				  int numY,
 				  int numZ);
+extern int			AlgFourNextFastSize(
+				  int num);
+extern void			AlgFourPlanCacheFree(
+				  void);
+extern AlgFourPlan		*AlgFourPlanMake(
+				  int dim,
+				  int real,
+				  int numX,
+				  int numY,
+				  int numZ,
+				  AlgError *dstErr);
+extern void			AlgFourPlanFree(
+				  AlgFourPlan *plan);
+extern AlgError			AlgFourPlanExec1D(
+				  const AlgFourPlan *plan,
+				  double *real,
+				  double *imag,
+				  int inv);
+extern AlgError			AlgFourPlanExec2D(
+				  const AlgFourPlan *plan,
+				  double **real,
+				  double **imag,
+				  int inv);
+extern AlgError			AlgFourPlanExec3D(
+				  const AlgFourPlan *plan,
+				  double ***real,
+				  double ***imag,
+				  int inv);
 
 /* From AlgGamma.c */
 extern double			AlgGammaLog(
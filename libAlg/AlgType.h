@@ -240,6 +240,69 @@ typedef struct _ComplexD
   double	im;
 } ComplexD;
 
+/*!
+* \def		ALG_FOUR_MAX_FAC
+* \brief	Maximum number of radix factors in a mixed radix Fourier
+*		transform kernel.
+*/
+#define ALG_FOUR_MAX_FAC	(32)
+
+/*!
+* \struct	_AlgFourKernel
+* \brief	Precomputed factors and twiddles for the one dimensional
+*		Fourier transform of data with a length that is not an
+*		integer power of two. Kernels are immutable once made and
+*		so may be used concurrently by any number of threads.
+*		Typedef: ::AlgFourKernel.
+*/
+typedef struct _AlgFourKernel
+{
+  int		num;		/*!< Transform length. */
+  int		real;		/*!< Non-zero for a kernel for real data,
+  				     which uses a complex kernel of half
+				     the length if the length is even. */
+  int		nFac;		/*!< Number of radix factors, zero if
+  				     Bluestein's algorithm is used. */
+  int		fac[2 * ALG_FOUR_MAX_FAC]; /*!< Radix and remaining
+  				     length pairs. */
+  int		wrkNum;		/*!< Number of complex work space elements
+  				     needed to execute the kernel. */
+  ComplexD	*tw;		/*!< Twiddle factors. */
+  int		bsNum;		/*!< Bluestein convolution length. */
+  ComplexD	*bsChirp;	/*!< Bluestein chirp. */
+  ComplexD	*bsFilter;	/*!< Transformed and scaled Bluestein
+  				     convolution filter. */
+  struct _AlgFourKernel *sub;	/*!< Bluestein convolution kernel or
+  				     complex kernel for real data. */
+  struct _AlgFourKernel *next;	/*!< Next kernel in the cache. */
+} AlgFourKernel;
+
+/*!
+* \struct	_AlgFourPlan
+* \brief	A plan for repeated one, two or three dimensional Fourier
+*		transforms of data with a fixed size. Plans are made once
+*		for a size using AlgFourPlanMake() and may then be executed
+*		any number of times, including concurrently by different
+*		threads on different data.
+*		Typedef: ::AlgFourPlan.
+*/
+typedef struct _AlgFourPlan
+{
+  int		dim;		/*!< Dimension of the data: 1, 2 or 3. */
+  int		real;		/*!< Non-zero for real data. */
+  int		own;		/*!< Non-zero if the plan owns its kernels
+  				     rather than sharing cached kernels. */
+  int		num[3];		/*!< Number of data along the x, y and z
+  				     axes, with unused axes having one
+				     datum. */
+  AlgFourKernel	*cpx[3];	/*!< Complex kernels for each axis, NULL
+  				     for integer power of two lengths. */
+  AlgFourKernel	*rel[3];	/*!< Real kernels for each axis, NULL
+  				     for integer power of two lengths. */
+  int		wrkNum;		/*!< Number of complex work space elements
+  				     needed by each thread. */
+} AlgFourPlan;
+
 
 /*
 * \enum		_AlgError
@@ -54,6 +54,62 @@ static char _Wlz3DProjection_c[] = "University of Edinburgh $Id$";
 #include <omp.h>
 #endif
 
+/*!
+* \struct	_WlzProjectRayItv
+* \ingroup	WlzTransform
+* \brief	A single interval of the domain of a 3D object being
+* 		projected along rays.
+*/
+typedef struct _WlzProjectRayItv
+{
+  int		kol1;			/*!< First column of the interval. */
+  int		lastkl;			/*!< Last column of the interval. */
+  WlzGreyP	gP;			/*!< Values of the interval, with
+  					     gP[0] being the value at
+					     kol1, NULL unless the values
+					     can be accessed directly. */
+} WlzProjectRayItv;
+
+/*!
+* \struct	_WlzProjectRayVol
+* \ingroup	WlzTransform
+* \brief	The intervals of a 3D domain object being projected along
+* 		rays, indexed by their plane and line so that rays can
+* 		skip the space outside of the domain.
+*/
+typedef struct _WlzProjectRayVol
+{
+  WlzIBox3	bBox;			/*!< Bounding box of the object's
+  					     plane domain. */
+  int		nLn;			/*!< Number of lines per plane. */
+  int		*rows;			/*!< Index of the first interval of
+  					     each line, with line l of plane
+					     p being row
+					     (p - zMin) * nLn + l - yMin and
+					     a final entry for the total
+					     number of intervals. */
+  WlzProjectRayItv *itvs;		/*!< The intervals of the domain. */
+  WlzGreyType	gType;			/*!< Grey type of the values,
+  					     WLZ_GREY_ERROR if the object
+					     has no values. */
+  int		tiled;			/*!< Non-zero if the values are tiled
+  					     and so can only be accessed
+					     using a grey value workspace. */
+} WlzProjectRayVol;
+
+/*!
+* \struct	_WlzProjectRayAcc
+* \ingroup	WlzTransform
+* \brief	Accumulates the values along a single ray.
+*/
+typedef struct _WlzProjectRayAcc
+{
+  int		n;			/*!< Number of voxels on the ray. */
+  double	sum;			/*!< Sum of the voxel values. */
+  double	min;			/*!< Minimum voxel value. */
+  double	max;			/*!< Maximum voxel value. */
+} WlzProjectRayAcc;
+
 static void			WlzProjectObjLine(
 				  WlzUByte **ary,
 				  WlzIVertex2 p0,
@@ -73,6 +129,27 @@ static void			WlzProjectObjLineVal(
 				  double vMZY,
 				  WlzIVertex3 p0,
 				  WlzIVertex3 p1);
+static void			WlzProjectRay(
+				  WlzProjectRayVol *vol,
+				  WlzGreyValueWSpace *gVWSp,
+				  WlzDVertex3 org,
+				  WlzDVertex3 dir,
+				  int s0,
+				  int s1,
+				  int stop,
+				  WlzProjectRayAcc *acc);
+static int			WlzProjectRayLast(
+				  double org,
+				  double dir,
+				  int s0,
+				  int s1,
+				  double lo,
+				  double hi);
+static void			WlzProjectRayFreeVol(
+				  WlzProjectRayVol *vol);
+static WlzProjectRayVol		*WlzProjectRayMakeVol(
+				  WlzObject *obj,
+				  WlzErrorNum *dstErr);
 
 /*! 
 * \return       projection object
@@ -112,7 +189,7 @@ WlzObject *WlzGetProjectionFromObject(
   double		*s_to_y=NULL;
   double		*s_to_z=NULL;
   int			k, xp, yp, s, sp;
-  int			length = 0, size = 0, occupiedFlg;
+  int			length = 0, size = 0;
   WlzErrorNum 	errNum=WLZ_ERR_NONE;
 
   /* check inputs */
@@ -133,8 +210,34 @@ WlzObject *WlzGetProjectionFromObject(
     errNum = WLZ_ERR_OBJECT_NULL;
   }
 
+  /* if there is no integration function then the projection is just the
+     shadow domain, which is found by casting rays through the intervals
+     of the domain */
+  if( (errNum == WLZ_ERR_NONE) && (intFunc == NULL) ){
+    values.core = NULL;
+    if((obj1 = WlzAssignObject(
+	       WlzMakeMain(WLZ_3D_DOMAINOBJ, obj->domain, values, NULL, NULL,
+			   &errNum), NULL)) != NULL){
+      WlzObject	*prjObj;
+
+      if((prjObj = WlzAssignObject(
+		   WlzProjectObjRays(obj1, viewStr, WLZ_PROJECT_RAY_MODE_MAX,
+				     0.0, &errNum), NULL)) != NULL){
+	if( prjObj->type == WLZ_2D_DOMAINOBJ ){
+	  rtnObj = WlzMakeMain(WLZ_2D_DOMAINOBJ, prjObj->domain, values,
+			       NULL, NULL, &errNum);
+	}
+	else {
+	  rtnObj = WlzMakeEmpty(&errNum);
+	}
+	WlzFreeObj(prjObj);
+      }
+      WlzFreeObj(obj1);
+    }
+  }
+
   /* create new view transform */
-  if( errNum == WLZ_ERR_NONE ){
+  if( (errNum == WLZ_ERR_NONE) && (intFunc) ){
     if((viewStr1 = WlzMake3DViewStruct(WLZ_3D_VIEW_STRUCT, &errNum)) != NULL){
       /* need to worry about fixed line mode here sometime */
       viewStr1->fixed = viewStr->fixed;
@@ -161,7 +264,7 @@ WlzObject *WlzGetProjectionFromObject(
   }
 
   /* set up orthogonal line parameters & luts */
-  if( errNum == WLZ_ERR_NONE ){
+  if( (errNum == WLZ_ERR_NONE) && (intFunc) ){
     length = WLZ_NINT(viewStr1->maxvals.vtZ) -
       WLZ_NINT(viewStr1->minvals.vtZ) + 1;
     s_to_x = (double *) AlcMalloc(sizeof(double) * length );
@@ -230,7 +333,7 @@ WlzObject *WlzGetProjectionFromObject(
   }
 
   /* create rectangular projection image */
-  if( errNum == WLZ_ERR_NONE ){
+  if( (errNum == WLZ_ERR_NONE) && (intFunc) ){
     if((domain.i = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_RECT,
 				     WLZ_NINT(viewStr1->minvals.vtY),
 				     WLZ_NINT(viewStr1->maxvals.vtY),
@@ -264,10 +367,10 @@ WlzObject *WlzGetProjectionFromObject(
   }
 
   /* scan image setting values */
-  if( errNum == WLZ_ERR_NONE ){
+  if( (errNum == WLZ_ERR_NONE) && (intFunc) ){
     errNum = WlzInitGreyScan(rtnObj, &iwsp, &gwsp);
   }
-  if( errNum == WLZ_ERR_NONE ){
+  if( (errNum == WLZ_ERR_NONE) && (intFunc) ){
     while( (errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE ){
       yp = iwsp.linpos - WLZ_NINT(viewStr1->minvals.vtY);
       for(k=iwsp.lftpos; k <= iwsp.rgtpos; k++){
@@ -276,74 +379,44 @@ WlzObject *WlzGetProjectionFromObject(
 	vtx.vtY = viewStr1->xp_to_y[xp] + viewStr1->yp_to_y[yp];
 	vtx.vtZ = viewStr1->xp_to_z[xp] + viewStr1->yp_to_z[yp];
 
-	/* get the projection values */
-	/* if no function then just check for occupancy */
-	if( intFunc == NULL ){
-	  occupiedFlg = 0;
-	  sp = (int )(viewStr1->dist - WLZ_NINT(viewStr1->minvals.vtZ));
-	  for(; !occupiedFlg && (sp < length); sp++){
-	    x = vtx.vtX + s_to_x[sp];
-	    y = vtx.vtY + s_to_y[sp];
-	    z = vtx.vtZ + s_to_z[sp];
-	    if( WlzInsideDomain(obj, z, y, x, &errNum) ){
-	      occupiedFlg = 1;
-	    }
-	  }
-	  sp = (int )(viewStr1->dist - WLZ_NINT(viewStr1->minvals.vtZ) - 1);
-	  for(; !occupiedFlg && (sp >= 0); sp--){
-	    x = vtx.vtX + s_to_x[sp];
-	    y = vtx.vtY + s_to_y[sp];
-	    z = vtx.vtZ + s_to_z[sp];
-	    if( WlzInsideDomain(obj, z, y, x, &errNum) ){
-	      occupiedFlg = 1;
-	    }
-	  }
-
-	  /* set the integrated value - only WlzUByte at the moment */
-	  *(gwsp.u_grintptr.ubp) = (WlzUByte )occupiedFlg;
-	  gwsp.u_grintptr.ubp++;
-	}
-	/* use integration function */
-	else {
-	  /* set array of pixel values */
-	  for(sp=0; sp < length; sp++){
-	    x = vtx.vtX + s_to_x[sp];
-	    y = vtx.vtY + s_to_y[sp];
-	    z = vtx.vtZ + s_to_z[sp];
-	    WlzGreyValueGet(gVWSp, WLZ_NINT(z), WLZ_NINT(y),
-			    WLZ_NINT(x));
-	    switch( srcGType ){
-	    case WLZ_GREY_LONG:
-	      pixptr.p.lnp[sp] = gVWSp->gVal[0].lnv;
-	      break;
-	    case WLZ_GREY_INT:
-	      pixptr.p.inp[sp] = gVWSp->gVal[0].inv;
-	      break;
-	    case WLZ_GREY_SHORT:
-	      pixptr.p.shp[sp] = gVWSp->gVal[0].shv;
-	      break;
-	    case WLZ_GREY_UBYTE:
-	      pixptr.p.ubp[sp] = gVWSp->gVal[0].ubv;
-	      break;
-	    case WLZ_GREY_FLOAT:
-	      pixptr.p.flp[sp] = gVWSp->gVal[0].flv;
-	      break;
-	    case WLZ_GREY_DOUBLE:
-	      pixptr.p.dbp[sp] = gVWSp->gVal[0].dbv;
-	      break;
-	    case WLZ_GREY_RGBA:
-	      pixptr.p.rgbp[sp] = gVWSp->gVal[0].rgbv;
-	      break;
-	    default:
-	      errNum = WLZ_ERR_GREY_TYPE;
-	      break;
-	    }
+	/* set array of pixel values */
+	for(sp=0; sp < length; sp++){
+	  x = vtx.vtX + s_to_x[sp];
+	  y = vtx.vtY + s_to_y[sp];
+	  z = vtx.vtZ + s_to_z[sp];
+	  WlzGreyValueGet(gVWSp, WLZ_NINT(z), WLZ_NINT(y),
+			  WLZ_NINT(x));
+	  switch( srcGType ){
+	  case WLZ_GREY_LONG:
+	    pixptr.p.lnp[sp] = gVWSp->gVal[0].lnv;
+	    break;
+	  case WLZ_GREY_INT:
+	    pixptr.p.inp[sp] = gVWSp->gVal[0].inv;
+	    break;
+	  case WLZ_GREY_SHORT:
+	    pixptr.p.shp[sp] = gVWSp->gVal[0].shv;
+	    break;
+	  case WLZ_GREY_UBYTE:
+	    pixptr.p.ubp[sp] = gVWSp->gVal[0].ubv;
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    pixptr.p.flp[sp] = gVWSp->gVal[0].flv;
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    pixptr.p.dbp[sp] = gVWSp->gVal[0].dbv;
+	    break;
+	  case WLZ_GREY_RGBA:
+	    pixptr.p.rgbp[sp] = gVWSp->gVal[0].rgbv;
+	    break;
+	  default:
+	    errNum = WLZ_ERR_GREY_TYPE;
+	    break;
 	  }
-	  /* call integration function and seet value */
-	  intFunc(pixptr, length, (int )(viewStr1->dist -
-		                         WLZ_NINT(viewStr1->minvals.vtZ)),
-		  intFuncData, &errNum);
 	}
+	/* call integration function and seet value */
+	intFunc(pixptr, length, (int )(viewStr1->dist -
+				       WLZ_NINT(viewStr1->minvals.vtZ)),
+		intFuncData, &errNum);
       }
     }
     (void )WlzEndGreyScan(&iwsp, &gwsp);
@@ -351,24 +424,6 @@ WlzObject *WlzGetProjectionFromObject(
     {
       errNum = WLZ_ERR_NONE;
     }
-
-    /* if no integration function then threshold - binary only */
-    if( intFunc == NULL ){
-      pixval.v.ubv = 1;
-      rtnObj = WlzAssignObject(rtnObj, NULL);
-      if((obj1 = WlzThreshold(rtnObj, pixval, WLZ_THRESH_HIGH,
-                              &errNum)) != NULL){
-	WlzFreeObj(rtnObj);
-	values.core = NULL;
-	rtnObj = WlzMakeMain(WLZ_2D_DOMAINOBJ, obj1->domain, values, NULL, NULL,
-			     &errNum);
-	WlzFreeObj(obj1);
-      }
-      else {
-	WlzFreeObj(rtnObj);
-	rtnObj = NULL;
-      }
-    }
   }
 
   /* clear space */
@@ -993,6 +1048,369 @@ struct timeval	times[3];
   return(prjObj);
 }
 
+/*!
+* \return	New 2D domain object with the projection.
+* \ingroup	WlzTransform
+* \brief	Projects a 3D domain object onto the plane of the given
+* 		view by combining the voxel values along rays which are
+* 		perpendicular to the plane. A ray is cast for each pixel
+* 		of the plane and is sampled at unit intervals using nearest
+* 		neighbour interpolation, as in WlzGetProjectionFromObject().
+* 		Rays visit the intervals of the object's domain, skipping
+* 		the space between them, and are cast in parallel.
+* 		The domain of the projection is the set of pixels with
+* 		rays which meet the object's domain and the values are
+* 		given by the mode:
+*		WLZ_PROJECT_RAY_MODE_MAX - the maximum voxel value,
+*		WLZ_PROJECT_RAY_MODE_MIN - the minimum voxel value,
+*		WLZ_PROJECT_RAY_MODE_MEAN - the mean voxel value,
+*		WLZ_PROJECT_RAY_MODE_SUM - the sum of the voxel values.
+*		The maximum and minimum have the grey type of the object's
+*		values while the mean and sum are of type WLZ_GREY_DOUBLE.
+*		If the object has no values then every voxel of the domain
+*		is taken to have the value one, so the maximum and minimum
+*		are a WLZ_GREY_UBYTE shadow of the domain and the sum is
+*		the number of samples within the domain.
+* \param	obj			Given 3D domain object, with either
+* 					no values or values of any grey
+* 					type other than WLZ_GREY_RGBA.
+* \param	vStr			Given view structure defining the
+* 					projection plane.
+* \param	mode			Projection mode.
+* \param	depth			If greater than zero, the projection
+* 					depth perpendicular to the viewing
+* 					plane.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzProjectObjRays(WlzObject *obj, WlzThreeDViewStruct *vStr,
+				WlzProjectRayMode mode, double depth,
+				WlzErrorNum *dstErr)
+{
+  int		s0 = 0,
+  		s1 = -1,
+		stop = 0;
+  WlzIBox2	prjBox = {0};
+  WlzDVertex3	dir;
+  WlzGreyType	gType = WLZ_GREY_UBYTE;
+  WlzObject	*mObj = NULL,
+		*rObj = NULL,
+		*prjObj = NULL;
+  WlzValues	nullVal;
+  WlzThreeDViewStruct *vStr1 = NULL;
+  WlzProjectRayVol *vol = NULL;
+  WlzGreyValueWSpPool *gVWSpPool = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const double	eps = 0.000001;
+
+  nullVal.core = NULL;
+  if(obj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(obj->type != WLZ_3D_DOMAINOBJ)
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if(obj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(obj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else if(vStr == NULL)
+  {
+    errNum = WLZ_ERR_TRANSFORM_NULL;
+  }
+  else
+  {
+    switch(mode)
+    {
+      case WLZ_PROJECT_RAY_MODE_MAX:  /* FALLTHROUGH */
+      case WLZ_PROJECT_RAY_MODE_MIN:  /* FALLTHROUGH */
+      case WLZ_PROJECT_RAY_MODE_MEAN: /* FALLTHROUGH */
+      case WLZ_PROJECT_RAY_MODE_SUM:
+        break;
+      default:
+        errNum = WLZ_ERR_PARAM_DATA;
+	break;
+    }
+  }
+  /* Make and initialise a copy of the view so that the given view is
+   * not modified. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    vStr1 = WlzMake3DViewStructCopy(vStr, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzInit3DViewStruct(vStr1, obj);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    vol = WlzProjectRayMakeVol(obj, &errNum);
+  }
+  /* Compute the ray direction, the range of samples along the rays and
+   * the bounding box of the projection. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzDVertex3	org;
+
+    dir.vtX = 0.0;
+    dir.vtY = 0.0;
+    dir.vtZ = 1.0;
+    org.vtX = 0.0;
+    org.vtY = 0.0;
+    org.vtZ = 0.0;
+    errNum = Wlz3DSectionTransformInvVtx(&dir, vStr1);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = Wlz3DSectionTransformInvVtx(&org, vStr1);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WLZ_VTX_3_SUB(dir, dir, org);
+      prjBox.xMin = WLZ_NINT(vStr1->minvals.vtX);
+      prjBox.yMin = WLZ_NINT(vStr1->minvals.vtY);
+      prjBox.xMax = WLZ_NINT(vStr1->maxvals.vtX);
+      prjBox.yMax = WLZ_NINT(vStr1->maxvals.vtY);
+      s0 = (int )(WLZ_NINT(vStr1->minvals.vtZ) - vStr1->dist);
+      s1 = s0 + WLZ_NINT(vStr1->maxvals.vtZ) - WLZ_NINT(vStr1->minvals.vtZ);
+      if(depth > eps)
+      {
+	int	d;
+
+	d = (int )floor(depth);
+	s0 = ALG_MAX(s0, -d);
+	s1 = ALG_MIN(s1, d);
+      }
+      if(vol->gType == WLZ_GREY_ERROR)
+      {
+        gType = WLZ_GREY_UBYTE;
+      }
+      else if(vol->gType == WLZ_GREY_RGBA)
+      {
+        errNum = WLZ_ERR_GREY_TYPE;
+      }
+      else
+      {
+        gType = vol->gType;
+      }
+      if((mode == WLZ_PROJECT_RAY_MODE_MEAN) ||
+         (mode == WLZ_PROJECT_RAY_MODE_SUM))
+      {
+        gType = WLZ_GREY_DOUBLE;
+      }
+      /* Without values only the sum depends on more than whether the
+       * ray meets the domain. */
+      stop = (vol->gType == WLZ_GREY_ERROR) &&
+             (mode != WLZ_PROJECT_RAY_MODE_SUM);
+    }
+  }
+  /* Create rectangular objects for the projected values and for a mask
+   * of the rays which meet the domain. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzDomain	dom;
+
+    dom.i = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_RECT,
+    				  prjBox.yMin, prjBox.yMax,
+				  prjBox.xMin, prjBox.xMax, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      rObj = WlzAssignObject(
+      	     WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, nullVal, NULL, NULL,
+	                 &errNum), NULL);
+      if(rObj == NULL)
+      {
+        (void )WlzFreeDomain(dom);
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      mObj = WlzAssignObject(
+      	     WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, nullVal, NULL, NULL,
+	                 &errNum), NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzPixelV	bgd;
+      WlzValues	val;
+
+      bgd.type = WLZ_GREY_INT;
+      bgd.v.inv = 0;
+      (void )WlzValueConvertPixel(&bgd, bgd, gType);
+      val.v = WlzNewValueTb(rObj, WlzGreyTableType(WLZ_GREY_TAB_RECT,
+      					gType, NULL), bgd, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        rObj->values = WlzAssignValues(val, NULL);
+	(void )WlzValueConvertPixel(&bgd, bgd, WLZ_GREY_UBYTE);
+	val.v = WlzNewValueTb(mObj, WlzGreyTableType(WLZ_GREY_TAB_RECT,
+					  WLZ_GREY_UBYTE, NULL), bgd, &errNum);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+        mObj->values = WlzAssignValues(val, NULL);
+      }
+    }
+  }
+  /* If the values are tiled create a grey value workspace per thread. */
+  if((errNum == WLZ_ERR_NONE) && vol->tiled)
+  {
+    gVWSpPool = WlzGreyValueMakeWSpPool(obj, 0, &errNum);
+  }
+  /* Cast the rays, in parallel over the lines of the projection. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		nX,
+		nY;
+    WlzRectValues *rVal,
+    		*mVal;
+
+    nX = prjBox.xMax - prjBox.xMin + 1;
+    nY = prjBox.yMax - prjBox.yMin + 1;
+    rVal = rObj->values.r;
+    mVal = mObj->values.r;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      int	idY;
+      WlzGreyValueWSpace *gVWSp = NULL,
+      		*gVWSpPrv = NULL;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      /* Use a private work space if the pool has too few for the
+       * team. */
+      if(vol->tiled &&
+         ((gVWSp = WlzGreyValueWSpPoolGet(gVWSpPool)) == NULL))
+      {
+        gVWSp = gVWSpPrv = WlzGreyValueMakeWSp(obj, &errNum2);
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+      for(idY = 0; idY < nY; ++idY)
+      {
+        if(errNum2 == WLZ_ERR_NONE)
+	{
+	  int	idX;
+	  size_t	off;
+	  WlzUByte	*mP;
+
+	  off = (size_t )idY * rVal->width;
+	  mP = mVal->values.ubp + (size_t )idY * mVal->width;
+	  for(idX = 0; idX < nX; ++idX)
+	  {
+	    double	v = 0.0;
+	    WlzDVertex3 org;
+	    WlzProjectRayAcc acc;
+
+	    org.vtX = vStr1->xp_to_x[idX] + vStr1->yp_to_x[idY];
+	    org.vtY = vStr1->xp_to_y[idX] + vStr1->yp_to_y[idY];
+	    org.vtZ = vStr1->xp_to_z[idX] + vStr1->yp_to_z[idY];
+	    WlzProjectRay(vol, gVWSp, org, dir, s0, s1, stop, &acc);
+	    mP[idX] = (WlzUByte )(acc.n > 0);
+	    if(acc.n > 0)
+	    {
+	      switch(mode)
+	      {
+		case WLZ_PROJECT_RAY_MODE_MAX:
+		  v = acc.max;
+		  break;
+		case WLZ_PROJECT_RAY_MODE_MIN:
+		  v = acc.min;
+		  break;
+		case WLZ_PROJECT_RAY_MODE_MEAN:
+		  v = acc.sum / acc.n;
+		  break;
+		case WLZ_PROJECT_RAY_MODE_SUM:
+		  v = acc.sum;
+		  break;
+	      }
+	    }
+	    switch(gType)
+	    {
+	      case WLZ_GREY_LONG:
+		rVal->values.lnp[off + idX] = (WlzLong )v;
+		break;
+	      case WLZ_GREY_INT:
+		rVal->values.inp[off + idX] = (int )v;
+		break;
+	      case WLZ_GREY_SHORT:
+		rVal->values.shp[off + idX] = (short )v;
+		break;
+	      case WLZ_GREY_UBYTE:
+		rVal->values.ubp[off + idX] = (WlzUByte )v;
+		break;
+	      case WLZ_GREY_FLOAT:
+		rVal->values.flp[off + idX] = (float )v;
+		break;
+	      case WLZ_GREY_DOUBLE:
+		rVal->values.dbp[off + idX] = v;
+		break;
+	      default:
+		break;
+	    }
+	  }
+	}
+      }
+      WlzGreyValueFreeWSp(gVWSpPrv);
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzProjectObjRays)
+#endif
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	  }
+	}
+      }
+    }
+  }
+  /* Make the projection using the mask for it's domain. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzPixelV	tV;
+    WlzObject	*tObj;
+
+    tV.type = WLZ_GREY_UBYTE;
+    tV.v.ubv = 1;
+    tObj = WlzAssignObject(
+    	   WlzThreshold(mObj, tV, WLZ_THRESH_HIGH, &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if((tObj->type == WLZ_2D_DOMAINOBJ) && (tObj->domain.core != NULL))
+      {
+	prjObj = WlzMakeMain(WLZ_2D_DOMAINOBJ, tObj->domain, rObj->values,
+			     NULL, NULL, &errNum);
+      }
+      else
+      {
+        prjObj = WlzMakeEmpty(&errNum);
+      }
+    }
+    (void )WlzFreeObj(tObj);
+  }
+  WlzGreyValueFreeWSpPool(gVWSpPool);
+  WlzProjectRayFreeVol(vol);
+  (void )WlzFreeObj(mObj);
+  (void )WlzFreeObj(rObj);
+  if(vStr1)
+  {
+    (void )WlzFree3DViewStruct(vStr1);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(prjObj);
+}
+
 /*!
 * \ingroup	WlzTransform
 * \brief	Sets values in the array to 1 on the straight line segment
@@ -1232,3 +1650,519 @@ static void	WlzProjectObjLineVal(int **ary, WlzUByte lut[256],
     }
   }
 }
+
+/*!
+* \ingroup	WlzTransform
+* \brief	Casts a single ray through a 3D domain object, sampling the
+* 		ray at org + s dir for s = s0, ..., s1, using nearest
+* 		neighbour interpolation. The ray is first clipped to the
+* 		bounding box of the object. Samples within the domain are
+* 		then accumulated, with the row (plane and line) and the
+* 		interval of the previous sample being checked first. When
+* 		a sample is outside of the domain the ray skips to where
+* 		it either enters the next interval of the row or leaves
+* 		the row.
+* \param	vol			Intervals of the object.
+* \param	gVWSp			Grey value workspace used if the
+* 					values are tiled.
+* \param	org			Origin of the ray.
+* \param	dir			Direction of the ray, which is also
+* 					the step between samples.
+* \param	s0			First sample.
+* \param	s1			Last sample.
+* \param	stop			If non-zero the ray stops at the first
+* 					sample within the domain.
+* \param	acc			Destination for the accumulated
+* 					values of the ray.
+*/
+static void	WlzProjectRay(WlzProjectRayVol *vol,
+			      WlzGreyValueWSpace *gVWSp,
+			      WlzDVertex3 org, WlzDVertex3 dir,
+			      int s0, int s1, int stop,
+			      WlzProjectRayAcc *acc)
+{
+  int		idA,
+  		s,
+		r = -1,
+		i0 = 0,
+		i1 = 0,
+		idI = 0,
+		n = 0;
+  double	sum = 0.0,
+  		min = DBL_MAX,
+		max = -DBL_MAX;
+  const double	eps = 1.0e-12;
+
+  /* Clip the ray to the bounding box of the object. */
+  for(idA = 0; (s0 <= s1) && (idA < 3); ++idA)
+  {
+    double	o,
+    		d,
+		lo,
+		hi;
+
+    switch(idA)
+    {
+      case 0:
+	o = org.vtX;
+	d = dir.vtX;
+        lo = vol->bBox.xMin - 0.5;
+	hi = vol->bBox.xMax + 0.5;
+	break;
+      case 1:
+	o = org.vtY;
+	d = dir.vtY;
+        lo = vol->bBox.yMin - 0.5;
+	hi = vol->bBox.yMax + 0.5;
+	break;
+      default:
+	o = org.vtZ;
+	d = dir.vtZ;
+        lo = vol->bBox.zMin - 0.5;
+	hi = vol->bBox.zMax + 0.5;
+	break;
+    }
+    if(fabs(d) < eps)
+    {
+      if((o < lo) || (o > hi))
+      {
+        s1 = s0 - 1;
+      }
+    }
+    else
+    {
+      double	t0,
+      		t1;
+
+      t0 = (lo - o) / d;
+      t1 = (hi - o) / d;
+      if(t0 > t1)
+      {
+        double	t;
+
+	t = t0; t0 = t1; t1 = t;
+      }
+      t0 = floor(t0);
+      t1 = ceil(t1);
+      if(t0 > s1)
+      {
+        s1 = s0 - 1;
+      }
+      else if(t0 > s0)
+      {
+        s0 = (int )t0;
+      }
+      if(t1 < s0)
+      {
+        s1 = s0 - 1;
+      }
+      else if(t1 < s1)
+      {
+        s1 = (int )t1;
+      }
+    }
+  }
+  /* Walk along the ray. */
+  s = s0;
+  while(s <= s1)
+  {
+    int		p,
+    		l,
+		k,
+		in = 0,
+		inRow = 0;
+
+    p = WLZ_NINT(org.vtZ + (s * dir.vtZ));
+    l = WLZ_NINT(org.vtY + (s * dir.vtY));
+    k = WLZ_NINT(org.vtX + (s * dir.vtX));
+    if((p >= vol->bBox.zMin) && (p <= vol->bBox.zMax) &&
+       (l >= vol->bBox.yMin) && (l <= vol->bBox.yMax))
+    {
+      int	r1;
+
+      r1 = ((p - vol->bBox.zMin) * vol->nLn) + l - vol->bBox.yMin;
+      if(r1 != r)
+      {
+	r = r1;
+	i0 = idI = vol->rows[r];
+	i1 = vol->rows[r + 1];
+      }
+      if((idI >= i1) ||
+         (vol->itvs[idI].kol1 > k) || (vol->itvs[idI].lastkl < k))
+      {
+	int	iHi;
+
+	/* Find the first interval of the row which doesn't end before k. */
+	idI = i0;
+	iHi = i1;
+	while(idI < iHi)
+	{
+	  int	iMid;
+
+	  iMid = (idI + iHi) / 2;
+	  if(vol->itvs[iMid].lastkl < k)
+	  {
+	    idI = iMid + 1;
+	  }
+	  else
+	  {
+	    iHi = iMid;
+	  }
+	}
+      }
+      inRow = 1;
+      in = (idI < i1) && (vol->itvs[idI].kol1 <= k);
+    }
+    if(in)
+    {
+      double	v = 1.0;
+      WlzProjectRayItv *itv;
+
+      itv = vol->itvs + idI;
+      if(gVWSp)
+      {
+	WlzGreyValueGet(gVWSp, p, l, k);
+	switch(gVWSp->gType)
+	{
+	  case WLZ_GREY_LONG:
+	    v = gVWSp->gVal[0].lnv;
+	    break;
+	  case WLZ_GREY_INT:
+	    v = gVWSp->gVal[0].inv;
+	    break;
+	  case WLZ_GREY_SHORT:
+	    v = gVWSp->gVal[0].shv;
+	    break;
+	  case WLZ_GREY_UBYTE:
+	    v = gVWSp->gVal[0].ubv;
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    v = gVWSp->gVal[0].flv;
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    v = gVWSp->gVal[0].dbv;
+	    break;
+	  default:
+	    break;
+	}
+      }
+      else if(itv->gP.v)
+      {
+	switch(vol->gType)
+	{
+	  case WLZ_GREY_LONG:
+	    v = itv->gP.lnp[k - itv->kol1];
+	    break;
+	  case WLZ_GREY_INT:
+	    v = itv->gP.inp[k - itv->kol1];
+	    break;
+	  case WLZ_GREY_SHORT:
+	    v = itv->gP.shp[k - itv->kol1];
+	    break;
+	  case WLZ_GREY_UBYTE:
+	    v = itv->gP.ubp[k - itv->kol1];
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    v = itv->gP.flp[k - itv->kol1];
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    v = itv->gP.dbp[k - itv->kol1];
+	    break;
+	  default:
+	    break;
+	}
+      }
+      ++n;
+      sum += v;
+      if(v < min)
+      {
+	min = v;
+      }
+      if(v > max)
+      {
+	max = v;
+      }
+      if(stop)
+      {
+        break;
+      }
+      ++s;
+    }
+    else
+    {
+      int	sR;
+
+      /* Skip to where the ray either leaves the row or enters the next
+       * interval of the row along it's direction. */
+      sR = WlzProjectRayLast(org.vtZ, dir.vtZ, s, s1, p, p);
+      sR = WlzProjectRayLast(org.vtY, dir.vtY, s, sR, l, l);
+      if(inRow)
+      {
+	if((dir.vtX > 0.0) && (idI < i1))
+	{
+	  sR = WlzProjectRayLast(org.vtX, dir.vtX, s, sR,
+				 -DBL_MAX, vol->itvs[idI].kol1 - 1);
+	}
+	else if((dir.vtX < 0.0) && (idI > i0))
+	{
+	  sR = WlzProjectRayLast(org.vtX, dir.vtX, s, sR,
+				 vol->itvs[idI - 1].lastkl + 1, DBL_MAX);
+	}
+      }
+      s = sR + 1;
+    }
+  }
+  acc->n = n;
+  acc->sum = sum;
+  acc->min = min;
+  acc->max = max;
+}
+
+/*!
+* \return	Last sample of the run.
+* \ingroup	WlzTransform
+* \brief	Given that the sample at s0 of the coordinate org + s dir
+* 		rounds to a value in the range [lo, hi], finds the last
+* 		sample s in [s0, s1] for which the coordinate of every
+* 		sample from s0 to s rounds to a value in the range.
+* 		Because the coordinates are monotone in s the last sample
+* 		is estimated from where the coordinate crosses the range
+* 		boundary and the estimate is then corrected using the
+* 		same arithmetic as is used to compute the coordinates.
+* \param	org			Coordinate at s = 0.
+* \param	dir			Step in the coordinate per sample.
+* \param	s0			First sample of the run.
+* \param	s1			Last possible sample of the run.
+* \param	lo			Lowest value in the range.
+* \param	hi			Highest value in the range.
+*/
+static int	WlzProjectRayLast(double org, double dir, int s0, int s1,
+				  double lo, double hi)
+{
+  int		s;
+  double	t;
+
+  if(dir > 0.0)
+  {
+    t = floor((hi + 0.5 - org) / dir);
+  }
+  else if(dir < 0.0)
+  {
+    t = floor((lo - 0.5 - org) / dir);
+  }
+  else
+  {
+    return(s1);
+  }
+  s = (t >= s1)? s1: (t <= s0)? s0: (int )t;
+  while(s > s0)
+  {
+    double	v;
+
+    v = WLZ_NINT(org + (s * dir));
+    if((v >= lo) && (v <= hi))
+    {
+      break;
+    }
+    --s;
+  }
+  while(s < s1)
+  {
+    double	v;
+
+    v = WLZ_NINT(org + ((s + 1) * dir));
+    if((v < lo) || (v > hi))
+    {
+      break;
+    }
+    ++s;
+  }
+  return(s);
+}
+
+/*!
+* \ingroup	WlzTransform
+* \brief	Frees the intervals of an object being projected along
+* 		rays.
+* \param	vol			Given intervals, may be NULL.
+*/
+static void	WlzProjectRayFreeVol(WlzProjectRayVol *vol)
+{
+  if(vol)
+  {
+    AlcFree(vol->rows);
+    AlcFree(vol->itvs);
+    AlcFree(vol);
+  }
+}
+
+/*!
+* \return	New intervals of the object or NULL on error.
+* \ingroup	WlzTransform
+* \brief	Makes an index of the intervals of the given 3D domain
+* 		object by plane and line for projecting the object along
+* 		rays. Unless the object's values are tiled each interval
+* 		is given a pointer to it's values. If the object has a
+* 		voxel value table then planes without values are treated
+* 		as being outside the domain.
+* \param	obj			Given 3D domain object.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzProjectRayVol *WlzProjectRayMakeVol(WlzObject *obj,
+					WlzErrorNum *dstErr)
+{
+  int		idP,
+  		idR,
+		nPl,
+		nRow,
+  		pass,
+		direct = 0;
+  WlzPlaneDomain *pDom;
+  WlzProjectRayVol *vol;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  pDom = obj->domain.p;
+  if((vol = (WlzProjectRayVol *)
+            AlcCalloc(1, sizeof(WlzProjectRayVol))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    vol->bBox.xMin = pDom->kol1;
+    vol->bBox.xMax = pDom->lastkl;
+    vol->bBox.yMin = pDom->line1;
+    vol->bBox.yMax = pDom->lastln;
+    vol->bBox.zMin = pDom->plane1;
+    vol->bBox.zMax = pDom->lastpl;
+    vol->nLn = pDom->lastln - pDom->line1 + 1;
+    vol->gType = WLZ_GREY_ERROR;
+    if(obj->values.core != NULL)
+    {
+      if(WlzGreyTableIsTiled(obj->values.core->type))
+      {
+	vol->tiled = 1;
+	vol->gType = WlzGreyTableTypeToGreyType(obj->values.core->type,
+						&errNum);
+      }
+      else if(obj->values.core->type == WLZ_VOXELVALUETABLE_GREY)
+      {
+	direct = 1;
+	vol->gType = WlzGreyTypeFromObj(obj, &errNum);
+      }
+      else
+      {
+        errNum = WLZ_ERR_VALUES_TYPE;
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    nPl = pDom->lastpl - pDom->plane1 + 1;
+    nRow = nPl * vol->nLn;
+    if((vol->rows = (int *)AlcCalloc(nRow + 1, sizeof(int))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Count the intervals of each row in the first pass and then set the
+   * intervals in the second pass. Rows are visited in order so the
+   * intervals of each row are contiguous. */
+  for(pass = 0; (errNum == WLZ_ERR_NONE) && (pass < 2); ++pass)
+  {
+    int		nItv = 0;
+
+    if(pass == 1)
+    {
+      for(idR = 0; idR < nRow; ++idR)
+      {
+        vol->rows[idR + 1] += vol->rows[idR];
+      }
+      if((vol->rows[nRow] > 0) &&
+         ((vol->itvs = (WlzProjectRayItv *)
+                       AlcMalloc(vol->rows[nRow] *
+				 sizeof(WlzProjectRayItv))) == NULL))
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+    for(idP = 0; (errNum == WLZ_ERR_NONE) && (idP < nPl); ++idP)
+    {
+      WlzDomain	dom;
+      WlzValues	val;
+
+      dom = pDom->domains[idP];
+      val.core = NULL;
+      if(direct)
+      {
+        val = obj->values.vox->values[idP];
+      }
+      if((dom.core != NULL) && (dom.core->type != WLZ_EMPTY_DOMAIN) &&
+         ((direct == 0) ||
+	  ((val.core != NULL) && (val.core->type != WLZ_EMPTY_OBJ))))
+      {
+	WlzObject *obj2;
+	WlzGreyWSpace gWSp;
+	WlzIntervalWSpace iWSp;
+
+	if((pass == 0) || (direct == 0))
+	{
+	  val.core = NULL;
+	}
+	obj2 = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, val, NULL, NULL, &errNum);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  if(val.core)
+	  {
+	    errNum = WlzInitGreyScan(obj2, &iWSp, &gWSp);
+	  }
+	  else
+	  {
+	    errNum = WlzInitRasterScan(obj2, &iWSp, WLZ_RASTERDIR_ILIC);
+	  }
+	}
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  while(((val.core == NULL) &&
+		 ((errNum = WlzNextInterval(&iWSp)) == WLZ_ERR_NONE)) ||
+		((val.core != NULL) &&
+		 ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)))
+	  {
+	    if(pass == 0)
+	    {
+	      ++(vol->rows[(idP * vol->nLn) + iWSp.linpos - pDom->line1 + 1]);
+	    }
+	    else
+	    {
+	      WlzProjectRayItv *itv;
+
+	      itv = vol->itvs + nItv++;
+	      itv->kol1 = iWSp.lftpos;
+	      itv->lastkl = iWSp.rgtpos;
+	      itv->gP.v = (val.core)? gWSp.u_grintptr.v: NULL;
+	    }
+	  }
+	  if(val.core)
+	  {
+	    (void )WlzEndGreyScan(&iWSp, &gWSp);
+	  }
+	  if(errNum == WLZ_ERR_EOO)
+	  {
+	    errNum = WLZ_ERR_NONE;
+	  }
+	}
+	(void )WlzFreeObj(obj2);
+      }
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    WlzProjectRayFreeVol(vol);
+    vol = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(vol);
+}
@@ -44,6 +44,117 @@ static char _Wlz3DSubSection_c[] = "University of Edinburgh $Id$";
 
 #include <Wlz.h>
 
+/*!
+* \struct	_WlzSubSectionItv
+* \ingroup	WlzSectionTransform
+* \brief	An interval of a section with a pointer to it's grey values.
+*/
+typedef struct _WlzSubSectionItv
+{
+  int		line;			/*!< Line of the interval. */
+  int		lft;			/*!< Left column of the interval. */
+  int		rgt;			/*!< Right column of the interval. */
+  int		midPl;			/*!< Plane of the voxel at the middle
+  					     of the interval. */
+  int		midLn;			/*!< Line of the voxel at the middle
+  					     of the interval. */
+  WlzGreyP	gP;			/*!< Grey values of the interval. */
+  WlzThreeDViewStruct *view;		/*!< View transform of the section
+  					     the interval is in. */
+} WlzSubSectionItv;
+
+/*!
+* \struct	_WlzSubSectionPlane
+* \ingroup	WlzSectionTransform
+* \brief	Direct access to the grey values of a single plane of
+* 		a 3D domain object.
+*/
+typedef struct _WlzSubSectionPlane
+{
+  int		empty;			/*!< Non-zero if the plane has no
+  					     domain or no values. */
+  int		line1;			/*!< First line of the domain. */
+  int		lastln;			/*!< Last line of the domain. */
+  int		kol1;			/*!< First column of the domain. */
+  int		lastkl;			/*!< Last column of the domain. */
+  int		vLine1;			/*!< First line of the values. */
+  int		vKol1;			/*!< First column of the values. */
+  int		width;			/*!< Width of the values. */
+  WlzGreyP	gP;			/*!< The plane's values, NULL unless
+  					     both the domain and values
+					     of the plane are
+					     rectangular. */
+} WlzSubSectionPlane;
+
+/*!
+* \struct	_WlzSubSectionVol
+* \ingroup	WlzSectionTransform
+* \brief	Information about the 3D domain object being sectioned
+* 		which is shared by all the intervals of the section.
+*/
+typedef struct _WlzSubSectionVol
+{
+  WlzIBox3	bBox;			/*!< Bounding box of the object's
+  					     plane domain. */
+  int		uniform;		/*!< Non-zero if every plane has
+  					     rectangular domain and values
+					     with the domain covering the
+					     bounding box. */
+  WlzSubSectionPlane *planes;		/*!< Per plane direct access, NULL
+  					     unless the object has a voxel
+					     value table. */
+} WlzSubSectionVol;
+
+static void 	WlzGetSubSectionClip(
+  double		*tab,
+  double		off,
+  int			nearest,
+  int			lo,
+  int			hi,
+  int			*dstA,
+  int			*dstB);
+static WlzErrorNum WlzGetSubSectionItv(
+  WlzSubSectionVol	*vol,
+  WlzGreyValueWSpace	*gVWSp,
+  WlzThreeDViewStruct	*viewStr,
+  WlzInterpolationType	interp,
+  WlzSubSectionItv	*itv);
+static WlzErrorNum WlzGetSubSectionItvRect(
+  WlzSubSectionVol	*vol,
+  WlzGreyValueWSpace	*gVWSp,
+  WlzThreeDViewStruct	*viewStr,
+  WlzInterpolationType	interp,
+  WlzSubSectionItv	*itv);
+static WlzErrorNum WlzGetSubSectionItvGen(
+  WlzGreyValueWSpace	*gVWSp,
+  WlzThreeDViewStruct	*viewStr,
+  WlzInterpolationType	interp,
+  WlzSubSectionItv	*itv);
+static WlzSubSectionPlane *WlzGetSubSectionPlanes(
+  WlzObject		*obj,
+  int			*dstUniform,
+  WlzErrorNum		*dstErr);
+static int		WlzGetSubSectionItvCmp(
+  const void		*p0,
+  const void		*p1);
+static WlzErrorNum 	WlzGetSubSectionAddItvs(
+  WlzObject		*secObj,
+  WlzThreeDViewStruct	*viewStr,
+  int			*nItv,
+  int			*maxItv,
+  WlzSubSectionItv	**itvs);
+static WlzErrorNum 	WlzGetSubSectionSetItvs(
+  WlzObject		*obj,
+  WlzInterpolationType	interp,
+  int			nItv,
+  WlzSubSectionItv	*itvs);
+static WlzObject 	*WlzGetSubSectionNewObj(
+  WlzObject 		*obj,
+  WlzObject		*subDomain,
+  WlzThreeDViewStruct 	*viewStr,
+  WlzInterpolationType	interp,
+  int			greyFlg,
+  WlzErrorNum 		*dstErr);
 static WlzObject *WlzGetSubSectionFrom3DDomObj(
   WlzObject 		*obj,
   WlzObject		*subDomain,
@@ -113,6 +224,103 @@ WlzObject 	*WlzGetSubSectionFromObject(
   return(newObj);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzSectionTransform
+* \brief	Cuts a section from the given 3D object for each of the
+* 		given views. The sections are the same as those returned
+* 		by WlzGetSectionFromObject() for the views, but for 3D
+* 		domain objects with values the grey value work spaces
+* 		and the object's plane access tables are only set up
+* 		once. The intervals of all of the sections are then
+* 		processed together (in parallel), ordered by the plane
+* 		of the object that they are (mostly) cut from so that
+* 		nearby voxels are accessed together, which is
+* 		particularly effective for tiled value tables.
+* 		The views must have already been initialised, eg by
+* 		WlzInit3DViewStruct().
+* \param	obj			Given 3D object.
+* \param	nView			Number of views.
+* \param	views			Array of nView views.
+* \param	interp			Interpolation type, either nearest
+* 					neighbour or linear.
+* \param	dstSecs			Array of nView destination pointers
+* 					for the new sections. On error all
+* 					of these are set to NULL.
+*/
+WlzErrorNum	WlzGetSectionsFromObject(WlzObject *obj, int nView,
+				     WlzThreeDViewStruct **views,
+				     WlzInterpolationType interp,
+				     WlzObject **dstSecs)
+{
+  int		idV,
+  		nItv = 0,
+  		maxItv = 0;
+  WlzSubSectionItv *itvs = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(nView < 0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((views == NULL) || (dstSecs == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(obj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(obj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else
+  {
+    for(idV = 0; idV < nView; ++idV)
+    {
+      dstSecs[idV] = NULL;
+    }
+    if((obj->type != WLZ_3D_DOMAINOBJ) || (obj->values.core == NULL))
+    {
+      /* Nothing can be shared between the sections. */
+      for(idV = 0; (errNum == WLZ_ERR_NONE) && (idV < nView); ++idV)
+      {
+	dstSecs[idV] = WlzGetSectionFromObject(obj, views[idV], interp,
+					       &errNum);
+      }
+    }
+    else
+    {
+      for(idV = 0; (errNum == WLZ_ERR_NONE) && (idV < nView); ++idV)
+      {
+	dstSecs[idV] = WlzGetSubSectionNewObj(obj, NULL, views[idV], interp,
+					      1, &errNum);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  errNum = WlzGetSubSectionAddItvs(dstSecs[idV], views[idV],
+					   &nItv, &maxItv, &itvs);
+	}
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	qsort(itvs, nItv, sizeof(WlzSubSectionItv), WlzGetSubSectionItvCmp);
+	errNum = WlzGetSubSectionSetItvs(obj, interp, nItv, itvs);
+      }
+      AlcFree(itvs);
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      for(idV = 0; idV < nView; ++idV)
+      {
+	(void )WlzFreeObj(dstSecs[idV]);
+	dstSecs[idV] = NULL;
+      }
+    }
+  }
+  return(errNum);
+}
+
 #define WLZ_GETSUBSEC_POS(P,V,X,Y) \
   (P).vtX = (V)->xp_to_x[(X)] + (Y).vtX; \
   (P).vtY = (V)->xp_to_y[(X)] + (Y).vtY; \
@@ -128,6 +336,14 @@ WlzObject 	*WlzGetSubSectionFromObject(
   WlzGreyValueGet((G), WLZ_NINT(p.vtZ), WLZ_NINT(p.vtY), WLZ_NINT(p.vtX)); \
 }
 
+#define WLZ_GETSUBSEC_FRAC(F0,F1,P) \
+  (F0).vtX = (P).vtX - WLZ_NINT((P).vtX - 0.5); \
+  (F0).vtY = (P).vtY - WLZ_NINT((P).vtY - 0.5); \
+  (F0).vtZ = (P).vtZ - WLZ_NINT((P).vtZ - 0.5); \
+  (F1).vtX = 1.0 - (F0).vtX; \
+  (F1).vtY = 1.0 - (F0).vtY; \
+  (F1).vtZ = 1.0 - (F0).vtZ; \
+
 #define WLZ_GETSUBSEC_CONVAL(G,F0,F1,V,K,Y) \
 { \
   int		x; \
@@ -136,53 +352,965 @@ WlzObject 	*WlzGetSubSectionFromObject(
   x = k - WLZ_NINT((V)->minvals.vtX); \
   WLZ_GETSUBSEC_POS(p,(V),x,(Y)) \
   WlzGreyValueGetCon((G), p.vtZ, p.vtY, p.vtX); \
-  (F0).vtX = p.vtX - WLZ_NINT(p.vtX - 0.5); \
-  (F0).vtY = p.vtY - WLZ_NINT(p.vtY - 0.5); \
-  (F0).vtZ = p.vtZ - WLZ_NINT(p.vtZ - 0.5); \
-  (F1).vtX = 1.0 - (F0).vtX; \
-  (F1).vtY = 1.0 - (F0).vtY; \
-  (F1).vtZ = 1.0 - (F0).vtZ; \
+  WLZ_GETSUBSEC_FRAC((F0),(F1),p) \
 }
 
+#define WLZ_GETSUBSEC_LINVAL(G,F0,F1) \
+  (((G)[0] * (F1).vtX * (F1).vtY * (F1).vtZ) + \
+   ((G)[1] * (F0).vtX * (F1).vtY * (F1).vtZ) + \
+   ((G)[2] * (F1).vtX * (F0).vtY * (F1).vtZ) + \
+   ((G)[3] * (F0).vtX * (F0).vtY * (F1).vtZ) + \
+   ((G)[4] * (F1).vtX * (F1).vtY * (F0).vtZ) + \
+   ((G)[5] * (F0).vtX * (F1).vtY * (F0).vtZ) + \
+   ((G)[6] * (F1).vtX * (F0).vtY * (F0).vtZ) + \
+   ((G)[7] * (F0).vtX * (F0).vtY * (F0).vtZ))
+
+#define WLZ_GETSUBSEC_INRECT(S,L,K,N) \
+  (((S)->gP.v != NULL) && \
+   ((L) >= (S)->line1) && ((L) + (N) <= (S)->lastln) && \
+   ((K) >= (S)->kol1) && ((K) + (N) <= (S)->lastkl))
+
+#define WLZ_GETSUBSEC_RECTOFF(S,L,K) \
+  (((size_t )((L) - (S)->vLine1) * (S)->width) + (K) - (S)->vKol1)
+
+#define WLZ_GETSUBSEC_NN_RECT(GM,GV) \
+  for(k = itv->lft; k <= itv->rgt; ++k) \
+  { \
+    int		pl, \
+    		ln, \
+		kl; \
+    WlzDVertex3	p; \
+    WlzSubSectionPlane *sP; \
+ \
+    WLZ_GETSUBSEC_POS(p, viewStr, k - xOff, vty) \
+    pl = WLZ_NINT(p.vtZ); \
+    ln = WLZ_NINT(p.vtY); \
+    kl = WLZ_NINT(p.vtX); \
+    sP = vol->planes + pl - vol->bBox.zMin; \
+    if(vol->uniform || WLZ_GETSUBSEC_INRECT(sP, ln, kl, 0)) \
+    { \
+      *(gP.GM)++ = sP->gP.GM[WLZ_GETSUBSEC_RECTOFF(sP, ln, kl)]; \
+    } \
+    else if((sP->gP.v != NULL) || sP->empty) \
+    { \
+      *(gP.GM)++ = gVWSp->gBkd.GV; \
+    } \
+    else \
+    { \
+      WlzGreyValueGet(gVWSp, pl, ln, kl); \
+      *(gP.GM)++ = gVWSp->gVal[0].GV; \
+    } \
+  }
+
+#define WLZ_GETSUBSEC_LIN_RECT(GM,GV,ST) \
+  for(k = itv->lft; k <= itv->rgt; ++k) \
+  { \
+    int		pl, \
+    		ln, \
+		kl; \
+    double	tD0; \
+    double	g[8]; \
+    WlzDVertex3	p, \
+    		f0, \
+		f1; \
+    WlzSubSectionPlane *sP0, \
+    		*sP1; \
+ \
+    WLZ_GETSUBSEC_POS(p, viewStr, k - xOff, vty) \
+    pl = (int )(p.vtZ); \
+    ln = (int )(p.vtY); \
+    kl = (int )(p.vtX); \
+    sP0 = vol->planes + pl - vol->bBox.zMin; \
+    sP1 = sP0 + 1; \
+    if(vol->uniform || \
+       (WLZ_GETSUBSEC_INRECT(sP0, ln, kl, 1) && \
+        WLZ_GETSUBSEC_INRECT(sP1, ln, kl, 1))) \
+    { \
+      size_t	o0, \
+      		o1; \
+ \
+      o0 = WLZ_GETSUBSEC_RECTOFF(sP0, ln, kl); \
+      o1 = WLZ_GETSUBSEC_RECTOFF(sP1, ln, kl); \
+      g[0] = sP0->gP.GM[o0]; \
+      g[1] = sP0->gP.GM[o0 + 1]; \
+      g[2] = sP0->gP.GM[o0 + sP0->width]; \
+      g[3] = sP0->gP.GM[o0 + sP0->width + 1]; \
+      g[4] = sP1->gP.GM[o1]; \
+      g[5] = sP1->gP.GM[o1 + 1]; \
+      g[6] = sP1->gP.GM[o1 + sP1->width]; \
+      g[7] = sP1->gP.GM[o1 + sP1->width + 1]; \
+    } \
+    else \
+    { \
+      int	idG; \
+ \
+      WlzGreyValueGetCon(gVWSp, p.vtZ, p.vtY, p.vtX); \
+      for(idG = 0; idG < 8; ++idG) \
+      { \
+        g[idG] = gVWSp->gVal[idG].GV; \
+      } \
+    } \
+    WLZ_GETSUBSEC_FRAC(f0, f1, p) \
+    tD0 = WLZ_GETSUBSEC_LINVAL(g, f0, f1); \
+    ST; \
+  }
+
+#define WLZ_GETSUBSEC_IDX(T,O,N,X) \
+  ((N)? WLZ_NINT((T)[(X)] + (O)): (int )((T)[(X)] + (O)))
+
 /*!
-* \return	New sub-section object.
+* \return	Woolz error code.
 * \ingroup	WlzSectionTransform
-* \brief	Computes a section through the given 3D domain object.
-* \param	obj			Given 3D object.
+* \brief	Sets the grey values of a single interval of a section.
+* 		The interval is first clipped (in constant time for
+* 		each interval) to the columns for which some of the
+* 		voxels used lie within the bounding box of the object,
+* 		with the columns outside of this set to the background
+* 		value without any per voxel tests. The remaining columns
+* 		for which all of the voxels used lie within the bounding
+* 		box are set by WlzGetSubSectionItvRect() if the object's
+* 		planes can be accessed directly, with any others set by
+* 		WlzGetSubSectionItvGen().
+* \param	vol			Information about the object being
+* 					sectioned.
+* \param	gVWSp			Grey value work space for the 3D
+* 					object.
+* \param	viewStr			Given view transform.
+* \param	interp			Interpolation, should be either
+* 					WLZ_INTERPOLATION_NEAREST or
+* 					WLZ_INTERPOLATION_LINEAR.
+* \param	itv			The interval with it's grey pointer.
+*/
+static WlzErrorNum WlzGetSubSectionItv(
+  WlzSubSectionVol	*vol,
+  WlzGreyValueWSpace	*gVWSp,
+  WlzThreeDViewStruct	*viewStr,
+  WlzInterpolationType	interp,
+  WlzSubSectionItv	*itv)
+{
+  int		nearest,
+  		xOff,
+		yp,
+		aA,
+		aB,
+		iA,
+		iB;
+  WlzDVertex3	vty;
+  WlzSubSectionItv sub;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nearest = (interp == WLZ_INTERPOLATION_NEAREST);
+  if(!nearest && (gVWSp->gType == WLZ_GREY_RGBA))
+  {
+    return(WLZ_ERR_GREY_TYPE);
+  }
+  xOff = WLZ_NINT(viewStr->minvals.vtX);
+  yp = itv->line - WLZ_NINT(viewStr->minvals.vtY);
+  vty.vtX = viewStr->yp_to_x[yp];
+  vty.vtY = viewStr->yp_to_y[yp];
+  vty.vtZ = viewStr->yp_to_z[yp];
+  /* Find the columns [aA, aB] for which any of the voxels used are within
+   * the bounding box and within these the columns [iA, iB] for which all
+   * of them are. */
+  aA = itv->lft - xOff;
+  aB = itv->rgt - xOff;
+  WlzGetSubSectionClip(viewStr->xp_to_x, vty.vtX, nearest,
+		       vol->bBox.xMin - !nearest, vol->bBox.xMax, &aA, &aB);
+  WlzGetSubSectionClip(viewStr->xp_to_y, vty.vtY, nearest,
+		       vol->bBox.yMin - !nearest, vol->bBox.yMax, &aA, &aB);
+  WlzGetSubSectionClip(viewStr->xp_to_z, vty.vtZ, nearest,
+		       vol->bBox.zMin - !nearest, vol->bBox.zMax, &aA, &aB);
+  iA = aA;
+  iB = aB;
+  if(!nearest)
+  {
+    WlzGetSubSectionClip(viewStr->xp_to_x, vty.vtX, 0,
+			 vol->bBox.xMin, vol->bBox.xMax - 1, &iA, &iB);
+    WlzGetSubSectionClip(viewStr->xp_to_y, vty.vtY, 0,
+			 vol->bBox.yMin, vol->bBox.yMax - 1, &iA, &iB);
+    WlzGetSubSectionClip(viewStr->xp_to_z, vty.vtZ, 0,
+			 vol->bBox.zMin, vol->bBox.zMax - 1, &iA, &iB);
+  }
+  aA += xOff;
+  aB += xOff;
+  iA += xOff;
+  iB += xOff;
+  if(aA > aB)
+  {
+    WlzValueSetGrey(itv->gP, 0, gVWSp->gBkd, gVWSp->gType,
+		    itv->rgt - itv->lft + 1);
+  }
+  else
+  {
+    if(iA > iB)
+    {
+      iA = aB + 1;
+      iB = aB;
+    }
+    WlzValueSetGrey(itv->gP, 0, gVWSp->gBkd, gVWSp->gType, aA - itv->lft);
+    WlzValueSetGrey(itv->gP, aB + 1 - itv->lft, gVWSp->gBkd, gVWSp->gType,
+		    itv->rgt - aB);
+    sub.line = itv->line;
+    if(aA < iA)
+    {
+      sub.lft = aA;
+      sub.rgt = iA - 1;
+      sub.gP = WlzValueSetGreyP(itv->gP, gVWSp->gType, aA - itv->lft);
+      errNum = WlzGetSubSectionItvGen(gVWSp, viewStr, interp, &sub);
+    }
+    if((errNum == WLZ_ERR_NONE) && (iA <= iB))
+    {
+      sub.lft = iA;
+      sub.rgt = iB;
+      sub.gP = WlzValueSetGreyP(itv->gP, gVWSp->gType, iA - itv->lft);
+      errNum = (vol->planes)?
+	       WlzGetSubSectionItvRect(vol, gVWSp, viewStr, interp, &sub):
+	       WlzGetSubSectionItvGen(gVWSp, viewStr, interp, &sub);
+    }
+    if((errNum == WLZ_ERR_NONE) && (iB < aB))
+    {
+      sub.lft = iB + 1;
+      sub.rgt = aB;
+      sub.gP = WlzValueSetGreyP(itv->gP, gVWSp->gType, iB + 1 - itv->lft);
+      errNum = WlzGetSubSectionItvGen(gVWSp, viewStr, interp, &sub);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzSectionTransform
+* \brief	Clips the given range of section columns to those for
+* 		which the voxel index along a single axis is within the
+* 		given limits. Because the coordinates in the look up
+* 		table are monotonic along the columns so are the voxel
+* 		indices, so the clipped range is contiguous and its
+* 		limits are found exactly by bisection.
+* \param	tab			Look up table of coordinates for the
+* 					axis, indexed by column relative to
+* 					the first column of the view.
+* \param	off			Offset added to the look up table
+* 					coordinates for the line.
+* \param	nearest			Non-zero if the voxel index is the
+* 					nearest integer to the coordinate,
+* 					otherwise the coordinate is
+* 					truncated.
+* \param	lo			Lowest permitted voxel index.
+* \param	hi			Highest permitted voxel index.
+* \param	dstA			Given and destination first column
+* 					of the range.
+* \param	dstB			Given and destination last column
+* 					of the range, which is less than the
+* 					first if the range is empty.
+*/
+static void 	WlzGetSubSectionClip(double *tab, double off, int nearest,
+				     int lo, int hi, int *dstA, int *dstB)
+{
+  int		a,
+  		b,
+		l,
+		m,
+		r,
+		fA,
+		fB;
+
+  a = *dstA;
+  b = *dstB;
+  if(a <= b)
+  {
+    fA = WLZ_GETSUBSEC_IDX(tab, off, nearest, a);
+    fB = WLZ_GETSUBSEC_IDX(tab, off, nearest, b);
+    if(fA <= fB)
+    {
+      if((fB < lo) || (fA > hi))
+      {
+	b = a - 1;
+      }
+      else
+      {
+	if(fA < lo)
+	{
+	  /* Find the first column with index >= lo. */
+	  l = a;
+	  r = b;
+	  while(r - l > 1)
+	  {
+	    m = (l + r) / 2;
+	    if(WLZ_GETSUBSEC_IDX(tab, off, nearest, m) >= lo)
+	    {
+	      r = m;
+	    }
+	    else
+	    {
+	      l = m;
+	    }
+	  }
+	  a = r;
+	}
+	if(WLZ_GETSUBSEC_IDX(tab, off, nearest, a) > hi)
+	{
+	  b = a - 1;
+	}
+	else if(fB > hi)
+	{
+	  /* Find the last column with index <= hi. */
+	  l = a;
+	  r = b;
+	  while(r - l > 1)
+	  {
+	    m = (l + r) / 2;
+	    if(WLZ_GETSUBSEC_IDX(tab, off, nearest, m) <= hi)
+	    {
+	      l = m;
+	    }
+	    else
+	    {
+	      r = m;
+	    }
+	  }
+	  b = l;
+	}
+      }
+    }
+    else
+    {
+      if((fA < lo) || (fB > hi))
+      {
+	b = a - 1;
+      }
+      else
+      {
+	if(fA > hi)
+	{
+	  /* Find the first column with index <= hi. */
+	  l = a;
+	  r = b;
+	  while(r - l > 1)
+	  {
+	    m = (l + r) / 2;
+	    if(WLZ_GETSUBSEC_IDX(tab, off, nearest, m) <= hi)
+	    {
+	      r = m;
+	    }
+	    else
+	    {
+	      l = m;
+	    }
+	  }
+	  a = r;
+	}
+	if(WLZ_GETSUBSEC_IDX(tab, off, nearest, a) < lo)
+	{
+	  b = a - 1;
+	}
+	else if(fB < lo)
+	{
+	  /* Find the last column with index >= lo. */
+	  l = a;
+	  r = b;
+	  while(r - l > 1)
+	  {
+	    m = (l + r) / 2;
+	    if(WLZ_GETSUBSEC_IDX(tab, off, nearest, m) >= lo)
+	    {
+	      l = m;
+	    }
+	    else
+	    {
+	      r = m;
+	    }
+	  }
+	  b = l;
+	}
+      }
+    }
+    *dstA = a;
+    *dstB = b;
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzSectionTransform
+* \brief	Sets the grey values of a single interval of a section
+* 		for which all of the voxels used are known to lie within
+* 		the bounding box of the object and the object's planes
+* 		can be accessed directly. There is a separate inner
+* 		loop for each grey type in which the values are read
+* 		directly from rectangular planes, with the grey value
+* 		work space only used for other planes.
+* \param	vol			Information about the object being
+* 					sectioned.
+* \param	gVWSp			Grey value work space for the 3D
+* 					object.
+* \param	viewStr			Given view transform.
+* \param	interp			Interpolation, should be either
+* 					WLZ_INTERPOLATION_NEAREST or
+* 					WLZ_INTERPOLATION_LINEAR.
+* \param	itv			The interval with it's grey pointer.
+*/
+static WlzErrorNum WlzGetSubSectionItvRect(
+  WlzSubSectionVol	*vol,
+  WlzGreyValueWSpace	*gVWSp,
+  WlzThreeDViewStruct	*viewStr,
+  WlzInterpolationType	interp,
+  WlzSubSectionItv	*itv)
+{
+  int		k,
+  		xOff,
+		yp;
+  WlzGreyP	gP;
+  WlzDVertex3	vty;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  gP = itv->gP;
+  xOff = WLZ_NINT(viewStr->minvals.vtX);
+  yp = itv->line - WLZ_NINT(viewStr->minvals.vtY);
+  vty.vtX = viewStr->yp_to_x[yp];
+  vty.vtY = viewStr->yp_to_y[yp];
+  vty.vtZ = viewStr->yp_to_z[yp];
+  switch(interp)
+  {
+    case WLZ_INTERPOLATION_NEAREST:
+      switch(gVWSp->gType)
+      {
+	case WLZ_GREY_INT:
+	  WLZ_GETSUBSEC_NN_RECT(inp, inv)
+	  break;
+	case WLZ_GREY_SHORT:
+	  WLZ_GETSUBSEC_NN_RECT(shp, shv)
+	  break;
+	case WLZ_GREY_UBYTE:
+	  WLZ_GETSUBSEC_NN_RECT(ubp, ubv)
+	  break;
+	case WLZ_GREY_FLOAT:
+	  WLZ_GETSUBSEC_NN_RECT(flp, flv)
+	  break;
+	case WLZ_GREY_DOUBLE:
+	  WLZ_GETSUBSEC_NN_RECT(dbp, dbv)
+	  break;
+	case WLZ_GREY_RGBA:
+	  WLZ_GETSUBSEC_NN_RECT(rgbp, rgbv)
+	  break;
+	default:
+	  errNum = WLZ_ERR_GREY_TYPE;
+	  break;
+      }
+      break;
+    case WLZ_INTERPOLATION_LINEAR:
+      switch(gVWSp->gType)
+      {
+	case WLZ_GREY_INT:
+	  WLZ_GETSUBSEC_LIN_RECT(inp, inv,
+	      *(gP.inp)++ = WLZ_NINT(WLZ_CLAMP(tD0, INT_MIN, INT_MAX)))
+	  break;
+	case WLZ_GREY_SHORT:
+	  WLZ_GETSUBSEC_LIN_RECT(shp, shv,
+	      *(gP.shp)++ = WLZ_NINT(WLZ_CLAMP(tD0, SHRT_MIN, SHRT_MAX)))
+	  break;
+	case WLZ_GREY_UBYTE:
+	  WLZ_GETSUBSEC_LIN_RECT(ubp, ubv,
+	      *(gP.ubp)++ = WLZ_NINT(WLZ_CLAMP(tD0, 0, 255)))
+	  break;
+	case WLZ_GREY_FLOAT:
+	  WLZ_GETSUBSEC_LIN_RECT(flp, flv,
+	      *(gP.flp)++ = WLZ_CLAMP(tD0, -FLT_MAX, FLT_MAX))
+	  break;
+	case WLZ_GREY_DOUBLE:
+	  WLZ_GETSUBSEC_LIN_RECT(dbp, dbv,
+	      *(gP.dbp)++ = tD0)
+	  break;
+	default:
+	  errNum = WLZ_ERR_GREY_TYPE;
+	  break;
+      }
+      break;
+    default:
+      errNum = WLZ_ERR_UNIMPLEMENTED;
+      break;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzSectionTransform
+* \brief	Sets the grey values of a single interval of a section
+* 		using the grey value work space for every voxel.
+* \param	gVWSp			Grey value work space for the 3D
+* 					object.
+* \param	viewStr			Given view transform.
+* \param	interp			Interpolation, should be either
+* 					WLZ_INTERPOLATION_NEAREST or
+* 					WLZ_INTERPOLATION_LINEAR.
+* \param	itv			The interval with it's grey pointer.
+*/
+static WlzErrorNum WlzGetSubSectionItvGen(
+  WlzGreyValueWSpace	*gVWSp,
+  WlzThreeDViewStruct	*viewStr,
+  WlzInterpolationType	interp,
+  WlzSubSectionItv	*itv)
+{
+  int		k,
+  		yp,
+		lft,
+		rgt;
+  WlzGreyP	gP;
+  WlzDVertex3	vty;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  gP = itv->gP;
+  lft = itv->lft;
+  rgt = itv->rgt;
+  yp = itv->line - WLZ_NINT(viewStr->minvals.vtY);
+  vty.vtX = viewStr->yp_to_x[yp];
+  vty.vtY = viewStr->yp_to_y[yp];
+  vty.vtZ = viewStr->yp_to_z[yp];
+  switch(interp)
+  {
+    case WLZ_INTERPOLATION_NEAREST:
+      switch(gVWSp->gType){
+	case WLZ_GREY_INT:
+	  for(k = lft; k <= rgt; ++k)
+	  {
+	    WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
+	    *(gP.inp)++ = gVWSp->gVal[0].inv;
+	  }
+	  break;
+	case WLZ_GREY_SHORT:
+	  for(k=lft; k <= rgt; k++)
+	  {
+	    WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
+	    *(gP.shp)++ = gVWSp->gVal[0].shv;
+	  }
+	  break;
+	case WLZ_GREY_UBYTE:
+	  for(k = lft; k <= rgt; ++k)
+	  {
+	    WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
+	    *(gP.ubp)++ = gVWSp->gVal[0].ubv;
+	  }
+	  break;
+	case WLZ_GREY_FLOAT:
+	  for(k = lft; k <= rgt; ++k)
+	  {
+	    WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
+	    *(gP.flp)++ = gVWSp->gVal[0].flv;
+	  }
+	  break;
+	case WLZ_GREY_DOUBLE:
+	  for(k = lft; k <= rgt; ++k)
+	  {
+	    WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
+	    *(gP.dbp)++ = gVWSp->gVal[0].dbv;
+	  }
+	  break;
+	case WLZ_GREY_RGBA:
+	  for(k = lft; k <= rgt; ++k)
+	  {
+	    WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
+	    *(gP.rgbp)++ = gVWSp->gVal[0].rgbv;
+	  }
+	  break;
+	default:
+	  break;
+      }
+      break;
+    case WLZ_INTERPOLATION_LINEAR:
+      {
+	double            tD0;
+	WlzDVertex3       tDV0,
+			  tDV1;
+
+	switch(gVWSp->gType){
+	  case WLZ_GREY_INT:
+	    for(k = lft; k <= rgt; ++k)
+	    {
+	      WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
+	      tD0 =
+		((gVWSp->gVal[0]).inv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[1]).inv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[2]).inv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[3]).inv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[4]).inv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[5]).inv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[6]).inv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[7]).inv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+	      tD0 = WLZ_CLAMP(tD0, INT_MIN, INT_MAX);
+	      *(gP.inp)++ = WLZ_NINT(tD0);
+	    }
+	    break;
+	  case WLZ_GREY_SHORT:
+	    for(k = lft; k <= rgt; ++k)
+	    {
+	      WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
+	      tD0 =
+		((gVWSp->gVal[0]).shv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[1]).shv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[2]).shv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[3]).shv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[4]).shv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[5]).shv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[6]).shv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[7]).shv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+	      tD0 = WLZ_CLAMP(tD0, SHRT_MIN, SHRT_MAX);
+	      *(gP.shp)++ = WLZ_NINT(tD0);
+	    }
+	    break;
+	  case WLZ_GREY_UBYTE:
+	    for(k = lft; k <= rgt; ++k)
+	    {
+	      WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
+	      tD0 =
+		((gVWSp->gVal[0]).ubv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[1]).ubv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[2]).ubv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[3]).ubv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[4]).ubv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[5]).ubv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[6]).ubv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[7]).ubv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+	      tD0 = WLZ_CLAMP(tD0, 0, 255);
+	      *(gP.ubp)++ = WLZ_NINT(tD0);
+	    }
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    for(k = lft; k <= rgt; ++k)
+	    {
+	      WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
+	      tD0 =
+		((gVWSp->gVal[0]).flv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[1]).flv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[2]).flv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[3]).flv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[4]).flv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[5]).flv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[6]).flv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[7]).flv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+	      *(gP.flp)++ = WLZ_CLAMP(tD0, -FLT_MAX, FLT_MAX);
+	    }
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    for(k = lft; k <= rgt; ++k)
+	    {
+	      WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
+	      tD0 =
+		((gVWSp->gVal[0]).dbv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[1]).dbv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[2]).dbv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[3]).dbv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		((gVWSp->gVal[4]).dbv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[5]).dbv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[6]).dbv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		((gVWSp->gVal[7]).dbv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+	      *(gP.dbp)++ = tD0;
+	    }
+	    break;
+	  default:
+	    errNum = WLZ_ERR_GREY_TYPE;
+	    break;
+	}
+      }
+      break;
+    default:
+      errNum = WLZ_ERR_UNIMPLEMENTED;
+      break;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Array of per plane direct access or NULL if the object does
+* 		not have a voxel value table.
+* \ingroup	WlzSectionTransform
+* \brief	Makes an array with an entry for each plane of the given
+* 		3D domain object which allows the grey values of planes
+* 		with rectangular domains and rectangular value tables to
+* 		be read directly.
+* \param	obj			Given 3D domain object.
+* \param	dstUniform		Destination pointer, set non-zero
+* 					if every plane has a rectangular
+* 					domain and value table with the
+* 					domain covering the bounding box of
+* 					the object's plane domain.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzSubSectionPlane *WlzGetSubSectionPlanes(WlzObject *obj,
+					int *dstUniform, WlzErrorNum *dstErr)
+{
+  int		idP,
+  		nPl,
+		uniform = 0;
+  WlzPlaneDomain *pDom;
+  WlzSubSectionPlane *planes = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  pDom = obj->domain.p;
+  if((obj->values.core != NULL) &&
+     (obj->values.core->type == WLZ_VOXELVALUETABLE_GREY))
+  {
+    nPl = pDom->lastpl - pDom->plane1 + 1;
+    if((planes = (WlzSubSectionPlane *)
+                 AlcCalloc(nPl, sizeof(WlzSubSectionPlane))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      uniform = 1;
+      for(idP = 0; idP < nPl; ++idP)
+      {
+	WlzDomain	dom;
+	WlzValues	val;
+	WlzSubSectionPlane *sP;
+
+	sP = planes + idP;
+	dom = pDom->domains[idP];
+	val = obj->values.vox->values[idP];
+	if((dom.core == NULL) || (dom.core->type == WLZ_EMPTY_DOMAIN) ||
+	   (val.core == NULL) || (val.core->type == WLZ_EMPTY_OBJ))
+	{
+	  sP->empty = 1;
+	  uniform = 0;
+	}
+	else
+	{
+	  sP->line1 = dom.i->line1;
+	  sP->lastln = dom.i->lastln;
+	  sP->kol1 = dom.i->kol1;
+	  sP->lastkl = dom.i->lastkl;
+	  if((dom.i->type == WLZ_INTERVALDOMAIN_RECT) &&
+	     (WlzGreyTableTypeToTableType(val.core->type,
+	                                  NULL) == WLZ_GREY_TAB_RECT))
+	  {
+	    sP->vLine1 = val.r->line1;
+	    sP->vKol1 = val.r->kol1;
+	    sP->width = val.r->width;
+	    sP->gP = val.r->values;
+	  }
+	  uniform = uniform && (sP->gP.v != NULL) &&
+	            (sP->line1 == pDom->line1) && (sP->lastln == pDom->lastln) &&
+		    (sP->kol1 == pDom->kol1) && (sP->lastkl == pDom->lastkl);
+	}
+      }
+    }
+  }
+  *dstUniform = uniform;
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(planes);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzSectionTransform
+* \brief	Compares the order of two section intervals, by the
+* 		plane and then the line of the voxels at their middles.
+* \param	p0			Pointer to first interval.
+* \param	p1			Pointer to second interval.
+*/
+static int	WlzGetSubSectionItvCmp(const void *p0, const void *p1)
+{
+  int		cmp;
+  const WlzSubSectionItv *i0,
+  		*i1;
+
+  i0 = (const WlzSubSectionItv *)p0;
+  i1 = (const WlzSubSectionItv *)p1;
+  if((cmp = i0->midPl - i1->midPl) == 0)
+  {
+    cmp = i0->midLn - i1->midLn;
+  }
+  return(cmp);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzSectionTransform
+* \brief	Appends the intervals of the given new section object
+* 		to the given array of intervals, reallocating the array
+* 		as required.
+* \param	secObj			New section object with a
+* 					rectangular value table.
+* \param	viewStr			View transform of the section.
+* \param	nItv			Number of intervals in the array,
+* 					updated on return.
+* \param	maxItv			Number of intervals allocated,
+* 					updated on return.
+* \param	itvs			The array of intervals, updated
+* 					on return.
+*/
+static WlzErrorNum WlzGetSubSectionAddItvs(WlzObject *secObj,
+					   WlzThreeDViewStruct *viewStr,
+					   int *nItv, int *maxItv,
+					   WlzSubSectionItv **itvs)
+{
+  int		xOff,
+  		yOff;
+  WlzIntervalWSpace iwsp;
+  WlzGreyWSpace	gwsp;
+  WlzErrorNum	errNum;
+
+  xOff = WLZ_NINT(viewStr->minvals.vtX);
+  yOff = WLZ_NINT(viewStr->minvals.vtY);
+  errNum = WlzInitGreyScan(secObj, &iwsp, &gwsp);
+  while((errNum == WLZ_ERR_NONE) && 
+	((errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE))
+  {
+    int		xm,
+    		yp;
+    WlzSubSectionItv *itv;
+
+    if(*nItv >= *maxItv)
+    {
+      WlzSubSectionItv *newItvs;
+
+      *maxItv = (*maxItv < 1024)? 1024: 2 * *maxItv;
+      if((newItvs = (WlzSubSectionItv *)
+		    AlcRealloc(*itvs,
+			       *maxItv * sizeof(WlzSubSectionItv))) == NULL)
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+	break;
+      }
+      *itvs = newItvs;
+    }
+    itv = *itvs + *nItv;
+    itv->line = iwsp.linpos;
+    itv->lft = iwsp.lftpos;
+    itv->rgt = iwsp.rgtpos;
+    itv->gP = gwsp.u_grintptr;
+    itv->view = viewStr;
+    xm = ((iwsp.lftpos + iwsp.rgtpos) / 2) - xOff;
+    yp = iwsp.linpos - yOff;
+    itv->midPl = WLZ_NINT(viewStr->xp_to_z[xm] + viewStr->yp_to_z[yp]);
+    itv->midLn = WLZ_NINT(viewStr->xp_to_y[xm] + viewStr->yp_to_y[yp]);
+    ++*nItv;
+  }
+  if(errNum == WLZ_ERR_EOO)	   /* Reset error from end of intervals */ 
+  {
+    errNum = WLZ_ERR_NONE;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzSectionTransform
+* \brief	Sets the grey values of the given section intervals from
+* 		the given 3D domain object. The intervals are processed
+* 		in parallel, with each thread using it's own grey value
+* 		work space. The intervals may be from more than one
+* 		section.
+* \param	obj			Given 3D domain object with values.
+* \param	interp			Interpolation, should be either
+* 					WLZ_INTERPOLATION_NEAREST or
+* 					WLZ_INTERPOLATION_LINEAR.
+* \param	nItv			Number of intervals.
+* \param	itvs			The intervals.
+*/
+static WlzErrorNum WlzGetSubSectionSetItvs(WlzObject *obj,
+					   WlzInterpolationType interp,
+					   int nItv, WlzSubSectionItv *itvs)
+{
+  WlzSubSectionVol vol;
+  WlzGreyValueWSpPool *gVWSpPool = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  vol.planes = NULL;
+  gVWSpPool = WlzGreyValueMakeWSpPool(obj, 0, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    vol.bBox.xMin = obj->domain.p->kol1;
+    vol.bBox.xMax = obj->domain.p->lastkl;
+    vol.bBox.yMin = obj->domain.p->line1;
+    vol.bBox.yMax = obj->domain.p->lastln;
+    vol.bBox.zMin = obj->domain.p->plane1;
+    vol.bBox.zMax = obj->domain.p->lastpl;
+    vol.planes = WlzGetSubSectionPlanes(obj, &(vol.uniform), &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      int	idx;
+      WlzGreyValueWSpace *gVWSp,
+      		*gVWSpPrv = NULL;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      /* The pool may have fewer work spaces than there are threads,
+       * eg with nested parallelism, in which case a private work space
+       * is used. */
+      if((gVWSp = WlzGreyValueWSpPoolGet(gVWSpPool)) == NULL)
+      {
+	gVWSp = gVWSpPrv = WlzGreyValueMakeWSp(obj, &errNum2);
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for(idx = 0; idx < nItv; ++idx)
+      {
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  errNum2 = WlzGetSubSectionItv(&vol, gVWSp, itvs[idx].view,
+					interp, itvs + idx);
+	}
+      }
+      WlzGreyValueFreeWSp(gVWSpPrv);
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzGetSubSectionSetItvs)
+#endif
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	  }
+	}
+      }
+    }
+  }
+  WlzGreyValueFreeWSpPool(gVWSpPool);
+  AlcFree(vol.planes);
+  return(errNum);
+}
+
+/*!
+* \return	New section object.
+* \ingroup	WlzSectionTransform
+* \brief	Checks the parameters and then creates a new section
+* 		object, with a rectangular value table of the 3D object's
+* 		grey type if required, but with it's values not set.
+* \param	obj			Given 3D domain object.
 * \param	subDomain		Given 2D domain within which to
-* 					restrict the section. If NULL
-* 					returned section will be have a
-* 					rectangular domain which is the maximum
-* 					for the given object and view
-* 					transform.
-* \param	view			Given view transform.
+* 					restrict the section, may be NULL.
+* \param	viewStr			Given view transform.
 * \param	interp			Interpolation, should be either
 * 					WLZ_INTERPOLATION_NEAREST or
 * 					WLZ_INTERPOLATION_LINEAR.
-* \param	maskRtn			Destination pointer for returned
-* 					domain mask.
+* \param	greyFlg			Non-zero if a value table is
+* 					required.
 * \param	dstErr			Destination error pointer, may be NULL.
 */
-static WlzObject *WlzGetSubSectionFrom3DDomObj(
+static WlzObject *WlzGetSubSectionNewObj(
   WlzObject		*obj,
   WlzObject		*subDomain,
   WlzThreeDViewStruct	*viewStr,
   WlzInterpolationType	interp,
-  WlzObject		**maskRtn,
+  int			greyFlg,
   WlzErrorNum		*dstErr)
 {
-  WlzObject		*newObj = NULL,
-			*mask = NULL;
+  WlzObject		*newObj = NULL;
   WlzDomain		domain;
   WlzValues		values;
-  WlzGreyValueWSpace	*gVWSp = NULL;
-  WlzIntervalWSpace	iwsp;
-  WlzGreyWSpace		gwsp;
-  int			maskFlg = 0,
-  			greyFlg = 0;
-  WlzErrorNum		errNum=WLZ_ERR_NONE;
+  WlzErrorNum		errNum = WLZ_ERR_NONE;
 
-  newObj = NULL;
   domain.core = NULL;
   values.core = NULL;
   /* Check parameters */
@@ -236,9 +1364,6 @@ static WlzObject *WlzGetSubSectionFrom3DDomObj(
     subBox.xMax = WLZ_NINT(viewStr->maxvals.vtX);
     subBox.yMin = WLZ_NINT(viewStr->minvals.vtY);
     subBox.yMax = WLZ_NINT(viewStr->maxvals.vtY);
-    /* Sort out return object requirements */
-    greyFlg = (obj->values.core != NULL);
-    maskFlg = (obj->values.core == NULL) || (maskRtn != NULL);
     /* Create a new return object - domain only. */
     if(subDomain)
     {
@@ -283,6 +1408,54 @@ static WlzObject *WlzGetSubSectionFrom3DDomObj(
       newObj->values = WlzAssignValues(values, &errNum);
     }
   }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(newObj);
+}
+
+/*!
+* \return	New sub-section object.
+* \ingroup	WlzSectionTransform
+* \brief	Computes a section through the given 3D domain object.
+* \param	obj			Given 3D object.
+* \param	subDomain		Given 2D domain within which to
+* 					restrict the section. If NULL
+* 					returned section will be have a
+* 					rectangular domain which is the maximum
+* 					for the given object and view
+* 					transform.
+* \param	view			Given view transform.
+* \param	interp			Interpolation, should be either
+* 					WLZ_INTERPOLATION_NEAREST or
+* 					WLZ_INTERPOLATION_LINEAR.
+* \param	maskRtn			Destination pointer for returned
+* 					domain mask.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzGetSubSectionFrom3DDomObj(
+  WlzObject		*obj,
+  WlzObject		*subDomain,
+  WlzThreeDViewStruct	*viewStr,
+  WlzInterpolationType	interp,
+  WlzObject		**maskRtn,
+  WlzErrorNum		*dstErr)
+{
+  WlzObject		*newObj = NULL,
+			*mask = NULL;
+  WlzValues		values;
+  WlzIntervalWSpace	iwsp;
+  WlzGreyWSpace		gwsp;
+  int			maskFlg = 0,
+  			greyFlg = 0;
+  WlzErrorNum		errNum=WLZ_ERR_NONE;
+
+  values.core = NULL;
+  greyFlg = (obj != NULL) && (obj->values.core != NULL);
+  maskFlg = (obj != NULL) && ((obj->values.core == NULL) || (maskRtn != NULL));
+  newObj = WlzGetSubSectionNewObj(obj, subDomain, viewStr, interp, greyFlg,
+				  &errNum);
   /* Check if mask required */
   if((errNum == WLZ_ERR_NONE) && maskFlg)
   {
@@ -305,180 +1478,20 @@ static WlzObject *WlzGetSubSectionFrom3DDomObj(
       newObj = NULL;
     }
   }
-  /* Scan object setting values */
+  /* Scan object setting values. The intervals are collected first so
+   * that their values can then be set in parallel. */
   if((errNum == WLZ_ERR_NONE) && greyFlg)
   {
-    if((gVWSp = WlzGreyValueMakeWSp(obj, &errNum)))
-    {
-      errNum = WlzInitGreyScan(newObj, &iwsp, &gwsp);
-      while((errNum == WLZ_ERR_NONE) && 
-	    ((errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE))
-      {
-        int 	k,
-		yp;
-	WlzDVertex3 vty;
+    int		nItv = 0,
+    		maxItv = 0;
+    WlzSubSectionItv *itvs = NULL;
 
-	yp = iwsp.linpos - WLZ_NINT(viewStr->minvals.vtY);
-	vty.vtX = viewStr->yp_to_x[yp];
-	vty.vtY = viewStr->yp_to_y[yp];
-	vty.vtZ = viewStr->yp_to_z[yp];
-	switch(interp)
-	{
-	  case WLZ_INTERPOLATION_NEAREST:
-	    switch(gVWSp->gType){
-	      case WLZ_GREY_INT:
-	        for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		{
-                  WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
-	          *(gwsp.u_grintptr.inp)++ = gVWSp->gVal[0].inv;
-		}
-		break;
-	      case WLZ_GREY_SHORT:
-	        for(k=iwsp.lftpos; k <= iwsp.rgtpos; k++)
-		{
-                  WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
-	          *(gwsp.u_grintptr.shp)++ = gVWSp->gVal[0].shv;
-		}
-		break;
-	      case WLZ_GREY_UBYTE:
-	        for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		{
-                  WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
-	          *(gwsp.u_grintptr.ubp)++ = gVWSp->gVal[0].ubv;
-		}
-		break;
-	      case WLZ_GREY_FLOAT:
-	        for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		{
-                  WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
-	          *(gwsp.u_grintptr.flp)++ = gVWSp->gVal[0].flv;
-		}
-		break;
-	      case WLZ_GREY_DOUBLE:
-	        for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		{
-                  WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
-	          *(gwsp.u_grintptr.dbp)++ = gVWSp->gVal[0].dbv;
-		}
-		break;
-	      case WLZ_GREY_RGBA:
-	        for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		{
-                  WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
-	          *(gwsp.u_grintptr.rgbp)++ = gVWSp->gVal[0].rgbv;
-		}
-		break;
-	      default:
-		break;
-	    }
-	    break;
-	  case WLZ_INTERPOLATION_LINEAR:
-	    {
-	      double		tD0;
-	      WlzDVertex3	tDV0,
-				tDV1;
-
-	      switch(gVWSp->gType){
-		case WLZ_GREY_INT:
-		  for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		  {
-		    WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
-		    tD0 =
-		      ((gVWSp->gVal[0]).inv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[1]).inv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[2]).inv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[3]).inv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[4]).inv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[5]).inv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[6]).inv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[7]).inv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		    tD0 = WLZ_CLAMP(tD0, INT_MIN, INT_MAX);
-		    *(gwsp.u_grintptr.inp)++ = WLZ_NINT(tD0);
-		  }
-		  break;
-		case WLZ_GREY_SHORT:
-		  for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		  {
-		    WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
-		    tD0 =
-		      ((gVWSp->gVal[0]).shv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[1]).shv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[2]).shv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[3]).shv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[4]).shv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[5]).shv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[6]).shv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[7]).shv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		    tD0 = WLZ_CLAMP(tD0, SHRT_MIN, SHRT_MAX);
-		    *(gwsp.u_grintptr.shp)++ = WLZ_NINT(tD0);
-		  }
-		  break;
-		case WLZ_GREY_UBYTE:
-		  for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		  {
-		    WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
-		    tD0 =
-		      ((gVWSp->gVal[0]).ubv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[1]).ubv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[2]).ubv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[3]).ubv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[4]).ubv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[5]).ubv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[6]).ubv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[7]).ubv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		    tD0 = WLZ_CLAMP(tD0, 0, 255);
-		    *(gwsp.u_grintptr.ubp)++ = WLZ_NINT(tD0);
-		  }
-		  break;
-		case WLZ_GREY_FLOAT:
-		  for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		  {
-		    WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
-		    tD0 =
-		      ((gVWSp->gVal[0]).flv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[1]).flv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[2]).flv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[3]).flv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[4]).flv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[5]).flv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[6]).flv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[7]).flv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		    *(gwsp.u_grintptr.flp)++ = WLZ_CLAMP(tD0, FLT_MIN, FLT_MAX);
-		  }
-		  break;
-		case WLZ_GREY_DOUBLE:
-		  for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		  {
-		    WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
-		    tD0 =
-		      ((gVWSp->gVal[0]).dbv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[1]).dbv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[2]).dbv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[3]).dbv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[4]).dbv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[5]).dbv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[6]).dbv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[7]).dbv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		    *(gwsp.u_grintptr.dbp)++ = WLZ_NINT(tD0);
-		  }
-		  break;
-		default:
-		  errNum = WLZ_ERR_GREY_TYPE;
-		  break;
-	      }
-	    }
-	    break;
-	  default:
-	    errNum = WLZ_ERR_UNIMPLEMENTED;
-	    break;
-	}
-      }
-      if(errNum == WLZ_ERR_EOO)	   /* Reset error from end of intervals */ 
-      {
-	errNum = WLZ_ERR_NONE;
-      }
-      WlzGreyValueFreeWSp(gVWSp);
+    errNum = WlzGetSubSectionAddItvs(newObj, viewStr, &nItv, &maxItv, &itvs);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzGetSubSectionSetItvs(obj, interp, nItv, itvs);
     }
+    AlcFree(itvs);
   }
 
   /* Check if mask required */
@@ -51,6 +51,9 @@ static char _WlzAffineTransform_c[] = "University of Edinburgh $Id$";
 
 #include <Wlz.h>
 
+/* Number of vertices gathered into a block for transforming together. */
+#define WLZ_AFFINETRANSFORM_VTXBLKSZ	(256)
+
 static int			WlzAffineTransformIsTranslate2(
 				  WlzAffineTransform *trans,
 				  WlzObject *obj,
@@ -107,6 +110,31 @@ static WlzErrorNum 		WlzAffineTransformPrimSet3(
 static void			WlzAffineTransformPrimGet2(
 				  WlzAffineTransform *tr,
 				  WlzAffineTransformPrim *prim);
+static void			WlzAffineTransformVtxArrayD2(
+				  WlzAffineTransform *tr,
+				  int nVtx,
+				  WlzDVertex2 *vtx);
+static void			WlzAffineTransformVtxArrayD3(
+				  WlzAffineTransform *tr,
+				  int dim,
+				  int nVtx,
+				  WlzDVertex3 *vtx);
+static void			WlzAffineTransformGMVertexBlk(
+				  WlzGMModel *model,
+				  WlzAffineTransform *tr,
+				  int trDim,
+				  int idx0,
+				  int idx1);
+static void			WlzAffineTransformCMeshNodBlk(
+				  WlzCMeshP mesh,
+				  WlzAffineTransform *tr,
+				  int trDim,
+				  int idx0,
+				  int idx1);
+static void			WlzAffineTransformCMeshNods(
+				  WlzCMeshP mesh,
+				  WlzAffineTransform *tr,
+				  int maxNod);
 
 /*!
 * \ingroup	WlzTransform
@@ -443,23 +471,15 @@ static WlzObject *WlzAffineTransformIntTranslate(WlzObject *srcObj,
 static WlzCMesh2D *WlzAffineTransformCMesh2D(WlzCMesh2D *srcMesh,
 				WlzAffineTransform *trans, WlzErrorNum *dstErr)
 {
-  int		idN;
+  WlzCMeshP	mesh;
   WlzCMesh2D	*dstMesh = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   dstMesh = WlzCMeshCopy2D(srcMesh, 0, 0, NULL, NULL, &errNum);
   if(errNum == WLZ_ERR_NONE)
   {
-    for(idN = 0; idN < dstMesh->res.nod.maxEnt; ++idN)
-    {
-      WlzCMeshNod2D *nod;
-
-      nod = (WlzCMeshNod2D *)AlcVectorItemGet(dstMesh->res.nod.vec, idN);
-      if(nod->idx >= 0)
-      {
-        nod->pos = WlzAffineTransformVertexD2(trans, nod->pos, NULL);
-      }
-    }
+    mesh.m2 = dstMesh;
+    WlzAffineTransformCMeshNods(mesh, trans, dstMesh->res.nod.maxEnt);
     WlzCMeshUpdateBBox2D(dstMesh);
     errNum = WlzCMeshReassignGridCells2D(dstMesh, 0);
   }
@@ -486,23 +506,15 @@ static WlzCMesh2D *WlzAffineTransformCMesh2D(WlzCMesh2D *srcMesh,
 static WlzCMesh2D5 *WlzAffineTransformCMesh2D5(WlzCMesh2D5 *srcMesh,
 				WlzAffineTransform *trans, WlzErrorNum *dstErr)
 {
-  int		idN;
+  WlzCMeshP	mesh;
   WlzCMesh2D5	*dstMesh = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   dstMesh = WlzCMeshCopy2D5(srcMesh, 0, 0, NULL, NULL, &errNum);
   if(errNum == WLZ_ERR_NONE)
   {
-    for(idN = 0; idN < dstMesh->res.nod.maxEnt; ++idN)
-    {
-      WlzCMeshNod2D5 *nod;
-
-      nod = (WlzCMeshNod2D5 *)AlcVectorItemGet(dstMesh->res.nod.vec, idN);
-      if(nod->idx >= 0)
-      {
-        nod->pos = WlzAffineTransformVertexD3(trans, nod->pos, NULL);
-      }
-    }
+    mesh.m2d5 = dstMesh;
+    WlzAffineTransformCMeshNods(mesh, trans, dstMesh->res.nod.maxEnt);
     WlzCMeshUpdateBBox2D5(dstMesh);
     errNum = WlzCMeshReassignGridCells2D5(dstMesh, 0);
   }
@@ -529,23 +541,15 @@ static WlzCMesh2D5 *WlzAffineTransformCMesh2D5(WlzCMesh2D5 *srcMesh,
 static WlzCMesh3D *WlzAffineTransformCMesh3D(WlzCMesh3D *srcMesh,
 				WlzAffineTransform *trans, WlzErrorNum *dstErr)
 {
-  int		idN;
+  WlzCMeshP	mesh;
   WlzCMesh3D	*dstMesh = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   dstMesh = WlzCMeshCopy3D(srcMesh, 0, 0, NULL, NULL, &errNum);
   if(errNum == WLZ_ERR_NONE)
   {
-    for(idN = 0; idN < dstMesh->res.nod.maxEnt; ++idN)
-    {
-      WlzCMeshNod3D *nod;
-
-      nod = (WlzCMeshNod3D *)AlcVectorItemGet(dstMesh->res.nod.vec, idN);
-      if(nod->idx >= 0)
-      {
-        nod->pos = WlzAffineTransformVertexD3(trans, nod->pos, NULL);
-      }
-    }
+    mesh.m3 = dstMesh;
+    WlzAffineTransformCMeshNods(mesh, trans, dstMesh->res.nod.maxEnt);
     WlzCMeshUpdateBBox3D(dstMesh);
     errNum = WlzCMeshReassignGridCells3D(dstMesh, 0);
   }
@@ -800,7 +804,10 @@ WlzGMModel	*WlzAffineTransformGMModel(WlzGMModel *srcM,
 					   WlzErrorNum *dstErr)
 {
   int		idx,
-  		cnt;
+		cnt,
+		nBlk,
+		mDim,
+		trDim = 0;
   AlcVector	*vec;
   WlzGMModel 	*dstM = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -811,72 +818,44 @@ WlzGMModel	*WlzAffineTransformGMModel(WlzGMModel *srcM,
   }
   dstM = (newModFlg)? WlzGMModelCopy(srcM, &errNum):
   		      WlzAssignGMModel(srcM, &errNum);
+  /* Check the transform is valid for the model. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(tr == NULL)
+    {
+      errNum = WLZ_ERR_DOMAIN_NULL;
+    }
+    else
+    {
+      trDim = WlzAffineTransformDimension(tr, &errNum);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    mDim = WlzGMModelGetDimension(dstM, &errNum);
+    if((errNum == WLZ_ERR_NONE) && (mDim == 2) && (trDim != 2))
+    {
+      errNum = WLZ_ERR_TRANSFORM_TYPE;
+    }
+  }
   if(errNum == WLZ_ERR_NONE)
   {
-    /* Transform vertex geometries. */
-    vec = dstM->res.vertexG.vec;
+    /* Transform vertex geometries in blocks. */
     cnt = (int )(dstM->res.vertexG.numIdx);
+    nBlk = (cnt + WLZ_AFFINETRANSFORM_VTXBLKSZ - 1) /
+           WLZ_AFFINETRANSFORM_VTXBLKSZ;
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-    for(idx = 0; idx < cnt; ++idx)
+    for(idx = 0; idx < nBlk; ++idx)
     {
-      if(errNum == WLZ_ERR_NONE)
-      {
-        WlzGMElemP	elmP;
+      int	idx0;
 
-	elmP.core = (WlzGMCore *)AlcVectorItemGet(vec, (size_t )idx);
-	if(elmP.core && (elmP.core->idx >= 0))
-	{
-	  WlzErrorNum	errNum2 = WLZ_ERR_NONE;
-
-	  switch(dstM->type)
-	  {
-	    case WLZ_GMMOD_2I:
-	      elmP.vertexG2I->vtx = WlzAffineTransformVertexI2(tr,
-					  elmP.vertexG2I->vtx, &errNum2);
-	      break;
-	    case WLZ_GMMOD_2D:
-	      elmP.vertexG2D->vtx = WlzAffineTransformVertexD2(tr,
-					  elmP.vertexG2D->vtx, &errNum2);
-	      break;
-	    case WLZ_GMMOD_2N:
-	      elmP.vertexG2N->vtx = WlzAffineTransformVertexD2(tr,
-					  elmP.vertexG2N->vtx, &errNum2);
-	      elmP.vertexG2N->nrm = WlzAffineTransformNormalD2(tr,
-					  elmP.vertexG2N->nrm, &errNum2);
-	      break;
-	    case WLZ_GMMOD_3I:
-	      elmP.vertexG3I->vtx = WlzAffineTransformVertexI3(tr,
-					  elmP.vertexG3I->vtx, &errNum2);
-	      break;
-	    case WLZ_GMMOD_3D:
-	      elmP.vertexG3D->vtx = WlzAffineTransformVertexD3(tr,
-					  elmP.vertexG3D->vtx, &errNum2);
-	      break;
-	    case WLZ_GMMOD_3N:
-	      elmP.vertexG3N->vtx = WlzAffineTransformVertexD3(tr,
-					  elmP.vertexG3N->vtx, &errNum2);
-	      elmP.vertexG3N->nrm = WlzAffineTransformNormalD3(tr,
-					  elmP.vertexG3N->nrm, &errNum2);
-	      break;
-	    default:
-	      errNum2 = WLZ_ERR_DOMAIN_TYPE;
-	      break;
-	  }
-#ifdef _OPENMP
-#pragma omp critical
-	  {
-#endif
-	    if((errNum == WLZ_ERR_NONE) && (errNum2 != WLZ_ERR_NONE))
-	    {
-	      errNum = errNum2;
-	    }
-#ifdef _OPENMP
-	  }
-#endif
-	}
-      }
+      idx0 = idx * WLZ_AFFINETRANSFORM_VTXBLKSZ;
+      WlzAffineTransformGMVertexBlk(dstM, tr, trDim, idx0,
+                                    ALG_MIN(idx0 +
+				            WLZ_AFFINETRANSFORM_VTXBLKSZ,
+					    cnt));
     }
   }
   if(errNum == WLZ_ERR_NONE)
@@ -3609,6 +3588,424 @@ WlzDVertex3	WlzAffineTransformVertexD3(WlzAffineTransform *trans,
   return(dstVtx);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzTransform
+* \brief	Transforms the given array of WlzDVertex2 in place.
+* 		This is equivalent to calling WlzAffineTransformVertexD2()
+* 		for each of the vertices, but the transform is only
+* 		checked once and the vertices are transformed by a
+* 		simple loop which the compiler is able to vectorise.
+* \param	tr			Affine transform to apply.
+* \param	nVtx			Number of vertices.
+* \param	vtx			Array of vertices.
+*/
+WlzErrorNum	WlzAffineTransformVerticesD2(WlzAffineTransform *tr,
+					     int nVtx, WlzDVertex2 *vtx)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tr == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(WlzAffineTransformDimension(tr, NULL) != 2)
+  {
+    errNum = WLZ_ERR_TRANSFORM_TYPE;
+  }
+  else if((nVtx > 0) && (vtx == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(nVtx > 0)
+  {
+    WlzAffineTransformVtxArrayD2(tr, nVtx, vtx);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzTransform
+* \brief	Transforms the given array of WlzDVertex3 in place.
+* 		This is equivalent to calling WlzAffineTransformVertexD3()
+* 		for each of the vertices, but the transform is only
+* 		checked once and the vertices are transformed by a
+* 		simple loop which the compiler is able to vectorise.
+* 		If the transform is a 2D transform then the z
+* 		coordinates of the vertices are not changed.
+* \param	tr			Affine transform to apply.
+* \param	nVtx			Number of vertices.
+* \param	vtx			Array of vertices.
+*/
+WlzErrorNum	WlzAffineTransformVerticesD3(WlzAffineTransform *tr,
+					     int nVtx, WlzDVertex3 *vtx)
+{
+  int		dim = 0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tr == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if((nVtx > 0) && (vtx == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    dim = WlzAffineTransformDimension(tr, &errNum);
+  }
+  if((errNum == WLZ_ERR_NONE) && (nVtx > 0))
+  {
+    WlzAffineTransformVtxArrayD3(tr, dim, nVtx, vtx);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzTransform
+* \brief	Transforms the given array of WlzDVertex2 in place.
+* 		The matrix elements are held in local variables so that
+* 		the loop is free of aliasing and may be vectorised.
+* 		Because this is a static function the parameters are
+* 		not checked.
+* \param	tr			Given 2D affine transform.
+* \param	nVtx			Number of vertices.
+* \param	vtx			Array of vertices.
+*/
+static void	WlzAffineTransformVtxArrayD2(WlzAffineTransform *tr,
+					     int nVtx, WlzDVertex2 *vtx)
+{
+  int		idx;
+  double	m00,
+  		m01,
+		m02,
+		m10,
+		m11,
+		m12;
+
+  m00 = tr->mat[0][0]; m01 = tr->mat[0][1]; m02 = tr->mat[0][2];
+  m10 = tr->mat[1][0]; m11 = tr->mat[1][1]; m12 = tr->mat[1][2];
+  for(idx = 0; idx < nVtx; ++idx)
+  {
+    double	x,
+    		y;
+
+    x = vtx[idx].vtX;
+    y = vtx[idx].vtY;
+    vtx[idx].vtX = (m00 * x) + (m01 * y) + m02;
+    vtx[idx].vtY = (m10 * x) + (m11 * y) + m12;
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzTransform
+* \brief	Transforms the given array of WlzDVertex3 in place.
+* 		The matrix elements are held in local variables so that
+* 		the loop is free of aliasing and may be vectorised.
+* 		Because this is a static function the parameters are
+* 		not checked.
+* \param	tr			Given affine transform.
+* \param	dim			Dimension of the transform, if 2
+* 					then the z coordinates are not
+* 					changed.
+* \param	nVtx			Number of vertices.
+* \param	vtx			Array of vertices.
+*/
+static void	WlzAffineTransformVtxArrayD3(WlzAffineTransform *tr, int dim,
+					     int nVtx, WlzDVertex3 *vtx)
+{
+  int		idx;
+
+  if(dim == 2)
+  {
+    double	m00,
+		m01,
+		m02,
+		m10,
+		m11,
+		m12;
+
+    m00 = tr->mat[0][0]; m01 = tr->mat[0][1]; m02 = tr->mat[0][2];
+    m10 = tr->mat[1][0]; m11 = tr->mat[1][1]; m12 = tr->mat[1][2];
+    for(idx = 0; idx < nVtx; ++idx)
+    {
+      double	x,
+		y;
+
+      x = vtx[idx].vtX;
+      y = vtx[idx].vtY;
+      vtx[idx].vtX = (m00 * x) + (m01 * y) + m02;
+      vtx[idx].vtY = (m10 * x) + (m11 * y) + m12;
+    }
+  }
+  else
+  {
+    double	m00,
+		m01,
+		m02,
+		m03,
+		m10,
+		m11,
+		m12,
+		m13,
+		m20,
+		m21,
+		m22,
+		m23;
+
+    m00 = tr->mat[0][0]; m01 = tr->mat[0][1];
+    m02 = tr->mat[0][2]; m03 = tr->mat[0][3];
+    m10 = tr->mat[1][0]; m11 = tr->mat[1][1];
+    m12 = tr->mat[1][2]; m13 = tr->mat[1][3];
+    m20 = tr->mat[2][0]; m21 = tr->mat[2][1];
+    m22 = tr->mat[2][2]; m23 = tr->mat[2][3];
+    for(idx = 0; idx < nVtx; ++idx)
+    {
+      double	x,
+		y,
+		z;
+
+      x = vtx[idx].vtX;
+      y = vtx[idx].vtY;
+      z = vtx[idx].vtZ;
+      vtx[idx].vtX = (m00 * x) + (m01 * y) + (m02 * z) + m03;
+      vtx[idx].vtY = (m10 * x) + (m11 * y) + (m12 * z) + m13;
+      vtx[idx].vtZ = (m20 * x) + (m21 * y) + (m22 * z) + m23;
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzTransform
+* \brief	Transforms the vertex geometries of a block of the given
+* 		model's vertex geometry elements in place. The vertices
+* 		are gathered into a contiguous buffer, transformed
+* 		together and then scattered back into the model.
+* 		Because this is a static function the parameters are
+* 		not checked, the transform must be valid for the model.
+* \param	model			Given model.
+* \param	tr			Given affine transform.
+* \param	trDim			Dimension of the affine transform.
+* \param	idx0			First vertex geometry element index.
+* \param	idx1			One past the last vertex geometry
+* 					element index.
+*/
+static void	WlzAffineTransformGMVertexBlk(WlzGMModel *model,
+					      WlzAffineTransform *tr,
+					      int trDim, int idx0, int idx1)
+{
+  int		idx,
+		nVtx = 0;
+  WlzGMElemP	elmP;
+  WlzGMElemP	elm[WLZ_AFFINETRANSFORM_VTXBLKSZ];
+  WlzDVertex2	vtx2[WLZ_AFFINETRANSFORM_VTXBLKSZ];
+  WlzDVertex3	vtx3[WLZ_AFFINETRANSFORM_VTXBLKSZ];
+
+  for(idx = idx0; idx < idx1; ++idx)
+  {
+    elmP.core = (WlzGMCore *)AlcVectorItemGet(model->res.vertexG.vec,
+                                              (size_t )idx);
+    if(elmP.core && (elmP.core->idx >= 0))
+    {
+      switch(model->type)
+      {
+	case WLZ_GMMOD_2I:
+	  elmP.vertexG2I->vtx = WlzAffineTransformVertexI2(tr,
+				      elmP.vertexG2I->vtx, NULL);
+	  break;
+	case WLZ_GMMOD_2D:
+	  vtx2[nVtx] = elmP.vertexG2D->vtx;
+	  elm[nVtx++] = elmP;
+	  break;
+	case WLZ_GMMOD_2N:
+	  vtx2[nVtx] = elmP.vertexG2N->vtx;
+	  elmP.vertexG2N->nrm = WlzAffineTransformNormalD2(tr,
+				      elmP.vertexG2N->nrm, NULL);
+	  elm[nVtx++] = elmP;
+	  break;
+	case WLZ_GMMOD_3I:
+	  elmP.vertexG3I->vtx = WlzAffineTransformVertexI3(tr,
+				      elmP.vertexG3I->vtx, NULL);
+	  break;
+	case WLZ_GMMOD_3D:
+	  vtx3[nVtx] = elmP.vertexG3D->vtx;
+	  elm[nVtx++] = elmP;
+	  break;
+	case WLZ_GMMOD_3N:
+	  vtx3[nVtx] = elmP.vertexG3N->vtx;
+	  elmP.vertexG3N->nrm = WlzAffineTransformNormalD3(tr,
+				      elmP.vertexG3N->nrm, NULL);
+	  elm[nVtx++] = elmP;
+	  break;
+	default:
+	  break;
+      }
+    }
+  }
+  if(nVtx > 0)
+  {
+    switch(model->type)
+    {
+      case WLZ_GMMOD_2D:
+	WlzAffineTransformVtxArrayD2(tr, nVtx, vtx2);
+	for(idx = 0; idx < nVtx; ++idx)
+	{
+	  elm[idx].vertexG2D->vtx = vtx2[idx];
+	}
+	break;
+      case WLZ_GMMOD_2N:
+	WlzAffineTransformVtxArrayD2(tr, nVtx, vtx2);
+	for(idx = 0; idx < nVtx; ++idx)
+	{
+	  elm[idx].vertexG2N->vtx = vtx2[idx];
+	}
+	break;
+      case WLZ_GMMOD_3D:
+	WlzAffineTransformVtxArrayD3(tr, trDim, nVtx, vtx3);
+	for(idx = 0; idx < nVtx; ++idx)
+	{
+	  elm[idx].vertexG3D->vtx = vtx3[idx];
+	}
+	break;
+      case WLZ_GMMOD_3N:
+	WlzAffineTransformVtxArrayD3(tr, trDim, nVtx, vtx3);
+	for(idx = 0; idx < nVtx; ++idx)
+	{
+	  elm[idx].vertexG3N->vtx = vtx3[idx];
+	}
+	break;
+      default:
+	break;
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzTransform
+* \brief	Transforms the positions of a block of the given
+* 		conforming mesh's nodes in place. The positions are
+* 		gathered into a contiguous buffer, transformed together
+* 		and then scattered back into the mesh.
+* 		Because this is a static function the parameters are
+* 		not checked, the transform must be valid for the mesh.
+* \param	mesh			Given mesh.
+* \param	tr			Given affine transform.
+* \param	trDim			Dimension of the affine transform.
+* \param	idx0			First node index.
+* \param	idx1			One past the last node index.
+*/
+static void	WlzAffineTransformCMeshNodBlk(WlzCMeshP mesh,
+					      WlzAffineTransform *tr,
+					      int trDim, int idx0, int idx1)
+{
+  int		idx,
+		nVtx = 0;
+  WlzCMeshNodP	nod[WLZ_AFFINETRANSFORM_VTXBLKSZ];
+  WlzDVertex2	vtx2[WLZ_AFFINETRANSFORM_VTXBLKSZ];
+  WlzDVertex3	vtx3[WLZ_AFFINETRANSFORM_VTXBLKSZ];
+
+  switch(mesh.m2->type)
+  {
+    case WLZ_CMESH_2D:
+      for(idx = idx0; idx < idx1; ++idx)
+      {
+	nod[nVtx].n2 = (WlzCMeshNod2D *)AlcVectorItemGet(mesh.m2->res.nod.vec,
+							 (size_t )idx);
+	if(nod[nVtx].n2->idx >= 0)
+	{
+	  vtx2[nVtx] = nod[nVtx].n2->pos;
+	  ++nVtx;
+	}
+      }
+      WlzAffineTransformVtxArrayD2(tr, nVtx, vtx2);
+      for(idx = 0; idx < nVtx; ++idx)
+      {
+        nod[idx].n2->pos = vtx2[idx];
+      }
+      break;
+    case WLZ_CMESH_2D5:
+      for(idx = idx0; idx < idx1; ++idx)
+      {
+	nod[nVtx].n2d5 = (WlzCMeshNod2D5 *)
+			 AlcVectorItemGet(mesh.m2d5->res.nod.vec,
+			                  (size_t )idx);
+	if(nod[nVtx].n2d5->idx >= 0)
+	{
+	  vtx3[nVtx] = nod[nVtx].n2d5->pos;
+	  ++nVtx;
+	}
+      }
+      WlzAffineTransformVtxArrayD3(tr, trDim, nVtx, vtx3);
+      for(idx = 0; idx < nVtx; ++idx)
+      {
+        nod[idx].n2d5->pos = vtx3[idx];
+      }
+      break;
+    case WLZ_CMESH_3D:
+      for(idx = idx0; idx < idx1; ++idx)
+      {
+	nod[nVtx].n3 = (WlzCMeshNod3D *)AlcVectorItemGet(mesh.m3->res.nod.vec,
+							 (size_t )idx);
+	if(nod[nVtx].n3->idx >= 0)
+	{
+	  vtx3[nVtx] = nod[nVtx].n3->pos;
+	  ++nVtx;
+	}
+      }
+      WlzAffineTransformVtxArrayD3(tr, trDim, nVtx, vtx3);
+      for(idx = 0; idx < nVtx; ++idx)
+      {
+        nod[idx].n3->pos = vtx3[idx];
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzTransform
+* \brief	Transforms the positions of all the nodes of the given
+* 		conforming mesh in place, with blocks of nodes being
+* 		transformed in parallel.
+* 		Because this is a static function the parameters are
+* 		not checked, the transform must be valid for the mesh.
+* \param	mesh			Given mesh.
+* \param	tr			Given affine transform.
+* \param	maxNod			Number of node entries in the mesh.
+*/
+static void	WlzAffineTransformCMeshNods(WlzCMeshP mesh,
+					    WlzAffineTransform *tr,
+					    int maxNod)
+{
+  int		idB,
+  		nBlk,
+		trDim;
+
+  trDim = WlzAffineTransformDimension(tr, NULL);
+  nBlk = (maxNod + WLZ_AFFINETRANSFORM_VTXBLKSZ - 1) /
+         WLZ_AFFINETRANSFORM_VTXBLKSZ;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for(idB = 0; idB < nBlk; ++idB)
+  {
+    int		idx0;
+
+    idx0 = idB * WLZ_AFFINETRANSFORM_VTXBLKSZ;
+    WlzAffineTransformCMeshNodBlk(mesh, tr, trDim, idx0,
+                                  ALG_MIN(idx0 + WLZ_AFFINETRANSFORM_VTXBLKSZ,
+				          maxNod));
+  }
+}
+
 /*!
 * \ingroup	WlzTransform
 * \return				Transformed vertex.
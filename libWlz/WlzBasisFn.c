@@ -47,6 +47,10 @@ static char _WlzBasisFn_c[] = "University of Edinburgh $Id$";
 #include <math.h>
 #include <Wlz.h>
 
+/* Number of vertices evaluated together by WlzBasisFnValues2D() and
+ * WlzBasisFnValues3D(). */
+#define WLZ_BASISFN_VTXBLKSZ	(64)
+
 /*!
 * \struct	_WlzBasisFnMapData3D
 * \ingroup	WlzFunction
@@ -134,12 +138,41 @@ static WlzDVertex2 		WlzBasisFnValueRedPoly2D(
 static WlzDVertex3      	WlzBasisFnValueRedPoly3D(
                                   WlzDVertex3 *poly,
 				  WlzDVertex3 srcVx);
+static int			WlzBasisFnTreeUsable(
+				  WlzBasisFn *basisFn);
+static WlzBasisFnTree		*WlzBasisFnTreeGet(
+				  WlzBasisFn *basisFn,
+				  WlzErrorNum *dstErr);
+static void			WlzBasisFnValuesBlk2D(
+				  WlzBasisFn *basisFn,
+				  int nVx,
+				  WlzDVertex2 *srcVx,
+				  WlzDVertex2 *dstVx);
+static void			WlzBasisFnValuesBlk3D(
+				  WlzBasisFn *basisFn,
+				  int nVx,
+				  WlzDVertex3 *srcVx,
+				  WlzDVertex3 *dstVx);
 static WlzHistogramDomain 	*WlzBasisFnScalarMOS3DEvalTb(
 				  int nPts,
 				  WlzDVertex3 *cPts,
 				  double delta,
 				  double tau,
 				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzBasisFnCSFit(
+				  int dim,
+				  int nPts,
+				  WlzDVertex3 *pts,
+				  WlzDVertex3 *dsp,
+				  double support,
+				  WlzDVertex3 *poly,
+				  WlzDVertex3 *basis,
+				  double *dstSup);
+static void			WlzBasisFnCSPrecond(
+				  void *data,
+				  AlgMatrix aM,
+				  double *rV,
+				  double *zV);
 /*!
 * \return	Woolz error number.
 * \ingroup	WlzFunction
@@ -170,6 +203,7 @@ WlzErrorNum	WlzBasisFnFree(WlzBasisFn *basisFn)
       }
       AlcFree(basisFn->distMap);
     }
+    (void )WlzBasisFnTreeFree(basisFn->evalTree);
     AlcFree(basisFn);
   }
   return(errNum);
@@ -782,6 +816,716 @@ double          WlzBasisFnValueMOSPhi(double r, double delta, double tau)
   return(phi);
 }
 
+/*!
+* \return	New vertex value.
+* \ingroup	WlzFunction
+* \brief	Calculates the value for the given vertex using
+*		a 2D compactly supported basis function. This is
+*		Wendland's function
+*		\f[
+		\phi(r) = (1 - \frac{r}{s})_+^4 (4 \frac{r}{s} + 1)
+		\f]
+*		where \f$s\f$ is the radius of support, so only the
+*		control points within \f$s\f$ of the vertex contribute
+*		to its value.
+* \param	basisFn			Basis function.
+* \param	srcVx			Source vertex.
+*/
+WlzDVertex2 	WlzBasisFnValueCS2D(WlzBasisFn *basisFn, WlzDVertex2 srcVx)
+{
+  int           idx;
+  double        tD0,
+		tD1,
+		sup,
+		supSq;
+  WlzDVertex2    *basisCo,
+		*cPts;
+  WlzDVertex2    polyVx,
+  		newVx;
+
+  newVx.vtX = 0.0;
+  newVx.vtY = 0.0;
+  cPts = basisFn->vertices.d2;
+  basisCo = basisFn->basis.d2;
+  sup = *((double *)(basisFn->param));
+  supSq = sup * sup;
+  for(idx = 0; idx < basisFn->nVtx; ++idx)
+  {
+    tD0 = srcVx.vtX - cPts->vtX;
+    tD1 = srcVx.vtY - cPts->vtY;
+    tD0 = (tD0 * tD0) + (tD1 * tD1);
+    if(tD0 < supSq)
+    {
+      tD0 = sqrt(tD0) / sup;
+      tD1 = 1.0 - tD0;
+      tD1 *= tD1;
+      tD1 = tD1 * tD1 * ((4.0 * tD0) + 1.0);
+      newVx.vtX += basisCo->vtX * tD1;
+      newVx.vtY += basisCo->vtY * tD1;
+    }
+    ++cPts;
+    ++basisCo;
+  }
+  polyVx = WlzBasisFnValueRedPoly2D(basisFn->poly.d2, srcVx);
+  newVx.vtX = newVx.vtX + polyVx.vtX;
+  newVx.vtY = newVx.vtY + polyVx.vtY;
+  return(newVx);
+}
+
+/*!
+* \return	New vertex value.
+* \ingroup	WlzFunction
+* \brief	Calculates the displacement value for the given vertex using
+*		a 3D compactly supported basis function, see
+*		WlzBasisFnValueCS2D().
+* \param	basisFn			Basis function.
+* \param	srcVx			Source vertex.
+*/
+WlzDVertex3 	WlzBasisFnValueCS3D(WlzBasisFn *basisFn, WlzDVertex3 srcVx)
+{
+  int           idx;
+  double        tD0,
+		tD1,
+		tD2,
+		sup,
+		supSq;
+  WlzDVertex3   *basisCo,
+		*cPts;
+  WlzDVertex3    polyVx,
+  		 newVx;
+
+  newVx.vtX = 0.0;
+  newVx.vtY = 0.0;
+  newVx.vtZ = 0.0;
+  cPts    = basisFn->vertices.d3;
+  basisCo = basisFn->basis.d3;
+  sup = *((double *)(basisFn->param));
+  supSq = sup * sup;
+  for(idx = 0; idx < basisFn->nVtx; ++idx)
+  {
+    tD0 = srcVx.vtX - cPts->vtX;
+    tD1 = srcVx.vtY - cPts->vtY;
+    tD2 = srcVx.vtZ - cPts->vtZ;
+    tD0 = (tD0 * tD0) + (tD1 * tD1) + (tD2 * tD2);
+    if(tD0 < supSq)
+    {
+      tD0 = sqrt(tD0) / sup;
+      tD1 = 1.0 - tD0;
+      tD1 *= tD1;
+      tD1 = tD1 * tD1 * ((4.0 * tD0) + 1.0);
+      newVx.vtX += basisCo->vtX * tD1;
+      newVx.vtY += basisCo->vtY * tD1;
+      newVx.vtZ += basisCo->vtZ * tD1;
+    }
+    ++cPts;
+    ++basisCo;
+  }
+  polyVx = WlzBasisFnValueRedPoly3D(basisFn->poly.d3, srcVx);
+  newVx.vtX = newVx.vtX + polyVx.vtX;
+  newVx.vtY = newVx.vtY + polyVx.vtY;
+  newVx.vtZ = newVx.vtZ + polyVx.vtZ;
+  return(newVx);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzFunction
+* \brief	Calculates the values of the given 2D basis function for
+* 		an array of vertices. This is equivalent to calling
+* 		the appropriate 2D basis function value function (eg
+* 		WlzBasisFnValueMQ2D()) for each vertex, but for
+* 		Gaussian, multiquadric, inverse multiquadric and
+* 		compactly supported basis functions using Euclidean
+* 		distances blocks of vertices are evaluated together
+* 		with the control points in the outer loop, so that
+* 		the radial basis function summations are vectorised
+* 		over the vertices. Control points which are not within
+* 		the support of a compactly supported basis function
+* 		for any vertex of a block are skipped.
+* 		If the basis function's evaluation tolerance is greater
+* 		than zero then Gaussian, multiquadric, inverse
+* 		multiquadric and thin plate spline basis functions using
+* 		Euclidean distances are evaluated to within the tolerance
+* 		using a basis function tree (see WlzBasisFnTreeMake()),
+* 		which is made on the first call and then kept with the
+* 		basis function.
+* 		The given and value arrays may be the same array.
+* \param	basisFn			Basis function.
+* \param	nVx			Number of vertices.
+* \param	srcVx			Array of vertices.
+* \param	dstVx			Array for the values.
+*/
+WlzErrorNum	WlzBasisFnValues2D(WlzBasisFn *basisFn, int nVx,
+				   WlzDVertex2 *srcVx, WlzDVertex2 *dstVx)
+{
+  int		idB,
+  		nBlk;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(basisFn == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if((nVx > 0) && ((srcVx == NULL) || (dstVx == NULL)))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    switch(basisFn->type)
+    {
+      case WLZ_FN_BASIS_2DGAUSS:     /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DIMQ:       /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DMQ:        /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DTPS:       /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DPOLY:      /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DCONF_POLY: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DCS:
+        break;
+      default:
+        errNum = WLZ_ERR_TRANSFORM_TYPE;
+	break;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (nVx > 0) &&
+     WlzBasisFnTreeUsable(basisFn))
+  {
+    WlzBasisFnTree *tree;
+
+    tree = WlzBasisFnTreeGet(basisFn, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzBasisFnTreeValues2D(tree, nVx, srcVx, dstVx);
+    }
+  }
+  else if((errNum == WLZ_ERR_NONE) && (nVx > 0))
+  {
+    nBlk = (nVx + WLZ_BASISFN_VTXBLKSZ - 1) / WLZ_BASISFN_VTXBLKSZ;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(idB = 0; idB < nBlk; ++idB)
+    {
+      int	off;
+
+      off = idB * WLZ_BASISFN_VTXBLKSZ;
+      WlzBasisFnValuesBlk2D(basisFn,
+                            ALG_MIN(nVx - off, WLZ_BASISFN_VTXBLKSZ),
+			    srcVx + off, dstVx + off);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzFunction
+* \brief	Calculates the values of the given 3D basis function for
+* 		an array of vertices. This is equivalent to calling
+* 		the appropriate 3D basis function value function (eg
+* 		WlzBasisFnValueMQ3D()) for each vertex, but for
+* 		multiquadric, inverse multiquadric and compactly
+* 		supported basis functions using Euclidean distances
+* 		blocks of vertices are evaluated together with the
+* 		control points in the outer loop, so that the radial
+* 		basis function summations are vectorised over the
+* 		vertices. Control points which are not within the
+* 		support of a compactly supported basis function for
+* 		any vertex of a block are skipped.
+* 		If the basis function's evaluation tolerance is greater
+* 		than zero then multiquadric and inverse multiquadric basis
+* 		functions using Euclidean distances are evaluated to
+* 		within the tolerance using a basis function tree (see
+* 		WlzBasisFnTreeMake()), which is made on the first call
+* 		and then kept with the basis function.
+* 		The given and value arrays may be the same array.
+* \param	basisFn			Basis function.
+* \param	nVx			Number of vertices.
+* \param	srcVx			Array of vertices.
+* \param	dstVx			Array for the values.
+*/
+WlzErrorNum	WlzBasisFnValues3D(WlzBasisFn *basisFn, int nVx,
+				   WlzDVertex3 *srcVx, WlzDVertex3 *dstVx)
+{
+  int		idB,
+  		nBlk;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(basisFn == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if((nVx > 0) && ((srcVx == NULL) || (dstVx == NULL)))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    switch(basisFn->type)
+    {
+      case WLZ_FN_BASIS_3DIMQ: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DMQ:  /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DMOS: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DCS:
+        break;
+      default:
+        errNum = WLZ_ERR_TRANSFORM_TYPE;
+	break;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (nVx > 0) &&
+     WlzBasisFnTreeUsable(basisFn))
+  {
+    WlzBasisFnTree *tree;
+
+    tree = WlzBasisFnTreeGet(basisFn, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzBasisFnTreeValues3D(tree, nVx, srcVx, dstVx);
+    }
+  }
+  else if((errNum == WLZ_ERR_NONE) && (nVx > 0))
+  {
+    nBlk = (nVx + WLZ_BASISFN_VTXBLKSZ - 1) / WLZ_BASISFN_VTXBLKSZ;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(idB = 0; idB < nBlk; ++idB)
+    {
+      int	off;
+
+      off = idB * WLZ_BASISFN_VTXBLKSZ;
+      WlzBasisFnValuesBlk3D(basisFn,
+                            ALG_MIN(nVx - off, WLZ_BASISFN_VTXBLKSZ),
+			    srcVx + off, dstVx + off);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Non-zero if the basis function should be evaluated using
+* 		a basis function tree.
+* \ingroup	WlzFunction
+* \brief	Checks whether the given basis function has a non-zero
+* 		evaluation tolerance and is of a type, using distances,
+* 		that can be evaluated by a basis function tree.
+* \param	basisFn			Given basis function.
+*/
+static int	WlzBasisFnTreeUsable(WlzBasisFn *basisFn)
+{
+  int		usable = 0;
+
+  if((basisFn->evalTol > 0.0) && (basisFn->evalFn == NULL))
+  {
+    switch(basisFn->type)
+    {
+      case WLZ_FN_BASIS_2DGAUSS: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DIMQ:   /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DMQ:
+	usable = (basisFn->distFn == NULL) ||
+		 (basisFn->distFn == WlzBasisFnEucDistFn2D);
+	break;
+      case WLZ_FN_BASIS_2DTPS:
+	usable = (basisFn->distFn == NULL);
+	break;
+      case WLZ_FN_BASIS_3DIMQ: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DMQ:
+	usable = (basisFn->distFn == NULL) ||
+		 (basisFn->distFn == WlzBasisFnEucDistFn3D);
+	break;
+      default:
+	break;
+    }
+  }
+  return(usable);
+}
+
+/*!
+* \return	Basis function tree or NULL on error.
+* \ingroup	WlzFunction
+* \brief	Gets the basis function tree of the given basis function,
+* 		making it if the basis function does not yet have a tree
+* 		or if its tree was made for a different evaluation
+* 		tolerance. The tree is owned by the basis function and
+* 		is freed by WlzBasisFnFree().
+* \param	basisFn			Given basis function.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzBasisFnTree *WlzBasisFnTreeGet(WlzBasisFn *basisFn,
+					 WlzErrorNum *dstErr)
+{
+  WlzBasisFnTree *tree;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+#ifdef _OPENMP
+#pragma omp critical (WlzBasisFnTreeGet)
+#endif
+  {
+    if((basisFn->evalTree != NULL) &&
+       (basisFn->evalTree->tol != basisFn->evalTol))
+    {
+      (void )WlzBasisFnTreeFree(basisFn->evalTree);
+      basisFn->evalTree = NULL;
+    }
+    if(basisFn->evalTree == NULL)
+    {
+      basisFn->evalTree = WlzBasisFnTreeMake(basisFn, basisFn->evalTol,
+					     &errNum);
+    }
+    tree = basisFn->evalTree;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(tree);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Calculates the values of the given 2D basis function for
+* 		a block of at most WLZ_BASISFN_VTXBLKSZ vertices.
+* 		The summations are done in the same order as for a
+* 		single vertex so the values are identical to those of
+* 		the single vertex functions.
+* 		Because this is a static function the parameters are
+* 		not checked.
+* \param	basisFn			Basis function.
+* \param	nVx			Number of vertices.
+* \param	srcVx			Array of vertices.
+* \param	dstVx			Array for the values.
+*/
+static void	WlzBasisFnValuesBlk2D(WlzBasisFn *basisFn, int nVx,
+				      WlzDVertex2 *srcVx, WlzDVertex2 *dstVx)
+{
+  int		idC,
+  		idV,
+		nC;
+  double	cX,
+  		cY,
+		bX,
+		bY,
+		delta;
+  WlzDVertex2	polyVx;
+  WlzDBox2	bBox;
+  WlzDVertex2	*basisCo,
+  		*cPts;
+  double	pX[WLZ_BASISFN_VTXBLKSZ],
+  		pY[WLZ_BASISFN_VTXBLKSZ],
+		sX[WLZ_BASISFN_VTXBLKSZ],
+		sY[WLZ_BASISFN_VTXBLKSZ];
+
+  if(((basisFn->type == WLZ_FN_BASIS_2DGAUSS) ||
+      (basisFn->type == WLZ_FN_BASIS_2DIMQ) ||
+      (basisFn->type == WLZ_FN_BASIS_2DMQ) ||
+      (basisFn->type == WLZ_FN_BASIS_2DCS)) &&
+     ((basisFn->distFn == NULL) ||
+      (basisFn->distFn == WlzBasisFnEucDistFn2D)))
+  {
+    nC = basisFn->nVtx;
+    cPts = basisFn->vertices.d2;
+    basisCo = basisFn->basis.d2;
+    delta = *((double *)(basisFn->param));
+    bBox.xMin = bBox.xMax = srcVx[0].vtX;
+    bBox.yMin = bBox.yMax = srcVx[0].vtY;
+    for(idV = 0; idV < nVx; ++idV)
+    {
+      pX[idV] = srcVx[idV].vtX;
+      pY[idV] = srcVx[idV].vtY;
+      sX[idV] = 0.0;
+      sY[idV] = 0.0;
+      bBox.xMin = ALG_MIN(bBox.xMin, pX[idV]);
+      bBox.xMax = ALG_MAX(bBox.xMax, pX[idV]);
+      bBox.yMin = ALG_MIN(bBox.yMin, pY[idV]);
+      bBox.yMax = ALG_MAX(bBox.yMax, pY[idV]);
+    }
+    for(idC = 0; idC < nC; ++idC)
+    {
+      cX = cPts[idC].vtX;
+      cY = cPts[idC].vtY;
+      bX = basisCo[idC].vtX;
+      bY = basisCo[idC].vtY;
+      switch(basisFn->type)
+      {
+        case WLZ_FN_BASIS_2DCS:
+	  /* Here delta is the radius of support. */
+	  if((cX > bBox.xMin - delta) && (cX < bBox.xMax + delta) &&
+	     (cY > bBox.yMin - delta) && (cY < bBox.yMax + delta))
+	  {
+	    for(idV = 0; idV < nVx; ++idV)
+	    {
+	      double	tD0,
+			tD1;
+
+	      tD0 = pX[idV] - cX;
+	      tD1 = pY[idV] - cY;
+	      tD0 = sqrt((tD0 * tD0) + (tD1 * tD1)) / delta;
+	      tD1 = (tD0 < 1.0)? 1.0 - tD0: 0.0;
+	      tD1 *= tD1;
+	      tD1 = tD1 * tD1 * ((4.0 * tD0) + 1.0);
+	      sX[idV] += bX * tD1;
+	      sY[idV] += bY * tD1;
+	    }
+	  }
+	  break;
+        case WLZ_FN_BASIS_2DGAUSS:
+	  for(idV = 0; idV < nVx; ++idV)
+	  {
+	    double	tD0,
+	    		tD1;
+
+	    tD0 = pX[idV] - cX;
+	    tD1 = pY[idV] - cY;
+	    tD0 = (tD0 * tD0) + (tD1 * tD1);
+	    tD1 = (tD0 > DBL_EPSILON)? exp(tD0 * delta): 1.0;
+	    sX[idV] += bX * tD1;
+	    sY[idV] += bY * tD1;
+	  }
+	  break;
+        case WLZ_FN_BASIS_2DIMQ:
+	  for(idV = 0; idV < nVx; ++idV)
+	  {
+	    double	tD0,
+	    		tD1;
+
+	    tD0 = pX[idV] - cX;
+	    tD1 = pY[idV] - cY;
+	    tD0 = (tD0 * tD0) + (tD1 * tD1);
+	    tD0 = 1.0 / sqrt(tD0 + delta);
+	    sX[idV] += bX * tD0;
+	    sY[idV] += bY * tD0;
+	  }
+	  break;
+        default: /* WLZ_FN_BASIS_2DMQ */
+	  for(idV = 0; idV < nVx; ++idV)
+	  {
+	    double	tD0,
+	    		tD1;
+
+	    tD0 = pX[idV] - cX;
+	    tD1 = pY[idV] - cY;
+	    tD0 = (tD0 * tD0) + (tD1 * tD1);
+	    tD0 = sqrt(tD0 + delta);
+	    sX[idV] += bX * tD0;
+	    sY[idV] += bY * tD0;
+	  }
+	  break;
+      }
+    }
+    for(idV = 0; idV < nVx; ++idV)
+    {
+      polyVx = WlzBasisFnValueRedPoly2D(basisFn->poly.d2, srcVx[idV]);
+      dstVx[idV].vtX = sX[idV] + polyVx.vtX;
+      dstVx[idV].vtY = sY[idV] + polyVx.vtY;
+    }
+  }
+  else
+  {
+    for(idV = 0; idV < nVx; ++idV)
+    {
+      switch(basisFn->type)
+      {
+	case WLZ_FN_BASIS_2DGAUSS:
+	  dstVx[idV] = WlzBasisFnValueGauss2D(basisFn, srcVx[idV]);
+	  break;
+	case WLZ_FN_BASIS_2DIMQ:
+	  dstVx[idV] = WlzBasisFnValueIMQ2D(basisFn, srcVx[idV]);
+	  break;
+	case WLZ_FN_BASIS_2DMQ:
+	  dstVx[idV] = WlzBasisFnValueMQ2D(basisFn, srcVx[idV]);
+	  break;
+	case WLZ_FN_BASIS_2DTPS:
+	  dstVx[idV] = WlzBasisFnValueTPS2D(basisFn, srcVx[idV]);
+	  break;
+	case WLZ_FN_BASIS_2DPOLY:
+	  dstVx[idV] = WlzBasisFnValuePoly2D(basisFn, srcVx[idV]);
+	  break;
+	case WLZ_FN_BASIS_2DCONF_POLY:
+	  dstVx[idV] = WlzBasisFnValueConf2D(basisFn, srcVx[idV]);
+	  break;
+	case WLZ_FN_BASIS_2DCS:
+	  dstVx[idV] = WlzBasisFnValueCS2D(basisFn, srcVx[idV]);
+	  break;
+	default:
+	  break;
+      }
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Calculates the values of the given 3D basis function for
+* 		a block of at most WLZ_BASISFN_VTXBLKSZ vertices.
+* 		The summations are done in the same order as for a
+* 		single vertex so the values are identical to those of
+* 		the single vertex functions.
+* 		Because this is a static function the parameters are
+* 		not checked.
+* \param	basisFn			Basis function.
+* \param	nVx			Number of vertices.
+* \param	srcVx			Array of vertices.
+* \param	dstVx			Array for the values.
+*/
+static void	WlzBasisFnValuesBlk3D(WlzBasisFn *basisFn, int nVx,
+				      WlzDVertex3 *srcVx, WlzDVertex3 *dstVx)
+{
+  int		idC,
+  		idV,
+		nC;
+  double	cX,
+  		cY,
+		cZ,
+		bX,
+		bY,
+		bZ,
+		delta;
+  WlzDVertex3	polyVx;
+  WlzDBox3	bBox;
+  WlzDVertex3	*basisCo,
+  		*cPts;
+  double	pX[WLZ_BASISFN_VTXBLKSZ],
+  		pY[WLZ_BASISFN_VTXBLKSZ],
+  		pZ[WLZ_BASISFN_VTXBLKSZ],
+		sX[WLZ_BASISFN_VTXBLKSZ],
+		sY[WLZ_BASISFN_VTXBLKSZ],
+		sZ[WLZ_BASISFN_VTXBLKSZ];
+
+  if(((basisFn->type == WLZ_FN_BASIS_3DIMQ) ||
+      (basisFn->type == WLZ_FN_BASIS_3DMQ) ||
+      (basisFn->type == WLZ_FN_BASIS_3DCS)) &&
+     ((basisFn->distFn == NULL) ||
+      (basisFn->distFn == WlzBasisFnEucDistFn3D)))
+  {
+    nC = basisFn->nVtx;
+    cPts = basisFn->vertices.d3;
+    basisCo = basisFn->basis.d3;
+    delta = *((double *)(basisFn->param));
+    bBox.xMin = bBox.xMax = srcVx[0].vtX;
+    bBox.yMin = bBox.yMax = srcVx[0].vtY;
+    bBox.zMin = bBox.zMax = srcVx[0].vtZ;
+    for(idV = 0; idV < nVx; ++idV)
+    {
+      pX[idV] = srcVx[idV].vtX;
+      pY[idV] = srcVx[idV].vtY;
+      pZ[idV] = srcVx[idV].vtZ;
+      sX[idV] = 0.0;
+      sY[idV] = 0.0;
+      sZ[idV] = 0.0;
+      bBox.xMin = ALG_MIN(bBox.xMin, pX[idV]);
+      bBox.xMax = ALG_MAX(bBox.xMax, pX[idV]);
+      bBox.yMin = ALG_MIN(bBox.yMin, pY[idV]);
+      bBox.yMax = ALG_MAX(bBox.yMax, pY[idV]);
+      bBox.zMin = ALG_MIN(bBox.zMin, pZ[idV]);
+      bBox.zMax = ALG_MAX(bBox.zMax, pZ[idV]);
+    }
+    for(idC = 0; idC < nC; ++idC)
+    {
+      cX = cPts[idC].vtX;
+      cY = cPts[idC].vtY;
+      cZ = cPts[idC].vtZ;
+      bX = basisCo[idC].vtX;
+      bY = basisCo[idC].vtY;
+      bZ = basisCo[idC].vtZ;
+      if(basisFn->type == WLZ_FN_BASIS_3DCS)
+      {
+	/* Here delta is the radius of support. */
+	if((cX > bBox.xMin - delta) && (cX < bBox.xMax + delta) &&
+	   (cY > bBox.yMin - delta) && (cY < bBox.yMax + delta) &&
+	   (cZ > bBox.zMin - delta) && (cZ < bBox.zMax + delta))
+	{
+	  for(idV = 0; idV < nVx; ++idV)
+	  {
+	    double	tD0,
+			tD1,
+			tD2;
+
+	    tD0 = pX[idV] - cX;
+	    tD1 = pY[idV] - cY;
+	    tD2 = pZ[idV] - cZ;
+	    tD0 = sqrt((tD0 * tD0) + (tD1 * tD1) + (tD2 * tD2)) / delta;
+	    tD1 = (tD0 < 1.0)? 1.0 - tD0: 0.0;
+	    tD1 *= tD1;
+	    tD1 = tD1 * tD1 * ((4.0 * tD0) + 1.0);
+	    sX[idV] += bX * tD1;
+	    sY[idV] += bY * tD1;
+	    sZ[idV] += bZ * tD1;
+	  }
+	}
+      }
+      else if(basisFn->type == WLZ_FN_BASIS_3DIMQ)
+      {
+	for(idV = 0; idV < nVx; ++idV)
+	{
+	  double	tD0,
+			tD1,
+			tD2;
+
+	  tD0 = pX[idV] - cX;
+	  tD1 = pY[idV] - cY;
+	  tD2 = pZ[idV] - cZ;
+	  tD0 = (tD0 * tD0) + (tD1 * tD1) + (tD2 * tD2);
+	  tD0 = 1.0 / sqrt(tD0 + delta);
+	  sX[idV] += bX * tD0;
+	  sY[idV] += bY * tD0;
+	  sZ[idV] += bZ * tD0;
+	}
+      }
+      else
+      {
+	for(idV = 0; idV < nVx; ++idV)
+	{
+	  double	tD0,
+			tD1,
+			tD2;
+
+	  tD0 = pX[idV] - cX;
+	  tD1 = pY[idV] - cY;
+	  tD2 = pZ[idV] - cZ;
+	  tD0 = (tD0 * tD0) + (tD1 * tD1) + (tD2 * tD2);
+	  tD0 = sqrt(tD0 + delta);
+	  sX[idV] += bX * tD0;
+	  sY[idV] += bY * tD0;
+	  sZ[idV] += bZ * tD0;
+	}
+      }
+    }
+    for(idV = 0; idV < nVx; ++idV)
+    {
+      polyVx = WlzBasisFnValueRedPoly3D(basisFn->poly.d3, srcVx[idV]);
+      dstVx[idV].vtX = sX[idV] + polyVx.vtX;
+      dstVx[idV].vtY = sY[idV] + polyVx.vtY;
+      dstVx[idV].vtZ = sZ[idV] + polyVx.vtZ;
+    }
+  }
+  else
+  {
+    for(idV = 0; idV < nVx; ++idV)
+    {
+      switch(basisFn->type)
+      {
+	case WLZ_FN_BASIS_3DIMQ:
+	  dstVx[idV] = WlzBasisFnValueIMQ3D(basisFn, srcVx[idV]);
+	  break;
+	case WLZ_FN_BASIS_3DMQ:
+	  dstVx[idV] = WlzBasisFnValueMQ3D(basisFn, srcVx[idV]);
+	  break;
+	case WLZ_FN_BASIS_3DMOS:
+	  dstVx[idV] = WlzBasisFnValueMOS3D(basisFn, srcVx[idV]);
+	  break;
+	case WLZ_FN_BASIS_3DCS:
+	  dstVx[idV] = WlzBasisFnValueCS3D(basisFn, srcVx[idV]);
+	  break;
+	default:
+	  break;
+      }
+    }
+  }
+}
+
 /*!
 * \return	Distance from given position to control point.
 * \ingroup	WlzFunction
@@ -1161,6 +1905,7 @@ WlzBasisFn *WlzBasisFnGauss2DFromCPts(int nPts, WlzDVertex2 *dPts,
 	  prvBasisFn->param = NULL;
 	  prvBasisFn->mesh.v = NULL;
 	  prvBasisFn->distMap = NULL;
+	  newBasisFn->evalTree = NULL;
 	  if(newBasisFn->distMap != NULL)
 	  {
 	    tI0 = ALG_MIN(newBasisFn->nVtx, prvBasisFn->nVtx);
@@ -1761,6 +2506,7 @@ WlzBasisFn *WlzBasisFnMQ2DFromCPts(int nPts, WlzDVertex2 *dPts,
 	  prvBasisFn->param = NULL;
 	  prvBasisFn->mesh.v = NULL;
 	  prvBasisFn->distMap = NULL;
+	  newBasisFn->evalTree = NULL;
 	  newBasisFn->maxVx = newMaxVx;
 	  newBasisFn->nVtx = nPts;
 	  if(newBasisFn->distMap != NULL)
@@ -2116,6 +2862,7 @@ WlzBasisFn *WlzBasisFnMQ3DFromCPts(int nPts, WlzDVertex3 *dPts,
 	  prvBasisFn->param = NULL;
 	  prvBasisFn->mesh.v = NULL;
 	  prvBasisFn->distMap = NULL;
+	  newBasisFn->evalTree = NULL;
 	  newBasisFn->maxVx = newMaxVx;
 	  newBasisFn->nVtx = nPts;
 	  if(newBasisFn->distMap != NULL)
@@ -2522,6 +3269,7 @@ WlzBasisFn *WlzBasisFnIMQ2DFromCPts(int nPts, WlzDVertex2 *dPts,
 	  prvBasisFn->param = NULL;
 	  prvBasisFn->mesh.v = NULL;
 	  prvBasisFn->distMap = NULL;
+	  newBasisFn->evalTree = NULL;
 	  newBasisFn->maxVx = newMaxVx;
 	  newBasisFn->nVtx = nPts;
 	  if(newBasisFn->distMap != NULL)
@@ -2877,6 +3625,7 @@ WlzBasisFn *WlzBasisFnIMQ3DFromCPts(int nPts, WlzDVertex3 *dPts,
 	  prvBasisFn->param = NULL;
 	  prvBasisFn->mesh.v = NULL;
 	  prvBasisFn->distMap = NULL;
+	  newBasisFn->evalTree = NULL;
 	  newBasisFn->maxVx = newMaxVx;
 	  newBasisFn->nVtx = nPts;
 	  if(newBasisFn->distMap != NULL)
@@ -3263,6 +4012,7 @@ WlzBasisFn *WlzBasisFnTPS2DFromCPts(int nPts,
           prvBasisFn->param = NULL;
           prvBasisFn->mesh.v = NULL;
           prvBasisFn->distMap = NULL;
+          newBasisFn->evalTree = NULL;
           if(newBasisFn->distMap != NULL)
           {
             tI0 = ALG_MIN(newBasisFn->nVtx, prvBasisFn->nVtx);
@@ -3824,6 +4574,197 @@ WlzBasisFn *WlzBasisFnScalarMOS3DFromCPts(int nPts,
   return(basisFn);
 }
 
+/*!
+* \return	New basis function.
+* \ingroup	WlzFunction
+* \brief	Creates a new 2D compactly supported basis function
+* 		(see WlzBasisFnValueCS2D()).
+*
+*		Unlike the other radial basis functions, the design
+*		matrix of a compactly supported basis function is
+*		sparse, with non-zero entries only for pairs of control
+*		points within the radius of support. The matrix is
+*		stored as a linked list row matrix and the design
+*		equations are solved using the conjugate gradient
+*		method with symmetric Gauss-Seidel preconditioning,
+*		so that basis functions with many thousands of control
+*		points can be computed. The reduced polynomial is first
+*		fitted to the displacements by least squares and the
+*		basis function then interpolates the residuals.
+* \param	nPts			Number of control point pairs.
+* \param	dPts			Destination control points.
+* \param	sPts			Source control points.
+* \param	support			Radius of support, normalized by the
+* 					extent of the destination control
+* 					points, in the range [> 0.0, <= 1.0].
+* 					The number of non-zero entries in the
+* 					design matrix is proportional to the
+* 					number of control points within this
+* 					radius of each.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzBasisFn *WlzBasisFnCS2DFromCPts(int nPts, WlzDVertex2 *dPts,
+				   WlzDVertex2 *sPts, double support,
+				   WlzErrorNum *dstErr)
+{
+  int		idN;
+  WlzDVertex3	*pts = NULL,
+  		*dsp = NULL,
+		*basis = NULL;
+  WlzBasisFn	*basisFn = NULL;
+  WlzDVertex3	poly[4];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((nPts <= 0) || (support <= 0.0) || (support > 1.0))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((dPts == NULL) || (sPts == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(((basisFn = (WlzBasisFn *)AlcCalloc(sizeof(WlzBasisFn),
+					      1)) == NULL) ||
+	  ((basisFn->poly.v = AlcMalloc(sizeof(WlzDVertex2) * 3)) == NULL) ||
+	  ((basisFn->basis.v = AlcMalloc(sizeof(WlzDVertex2) *
+					 nPts)) == NULL) ||
+	  ((basisFn->vertices.v = AlcMalloc(sizeof(WlzDVertex2) *
+					    nPts)) == NULL) ||
+	  ((basisFn->param = AlcMalloc(sizeof(double))) == NULL) ||
+	  ((pts = (WlzDVertex3 *)
+		  AlcMalloc(sizeof(WlzDVertex3) * nPts)) == NULL) ||
+	  ((dsp = (WlzDVertex3 *)
+		  AlcMalloc(sizeof(WlzDVertex3) * nPts)) == NULL) ||
+	  ((basis = (WlzDVertex3 *)
+		    AlcMalloc(sizeof(WlzDVertex3) * nPts)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idN = 0; idN < nPts; ++idN)
+    {
+      pts[idN].vtX = dPts[idN].vtX;
+      pts[idN].vtY = dPts[idN].vtY;
+      pts[idN].vtZ = 0.0;
+      dsp[idN].vtX = sPts[idN].vtX - dPts[idN].vtX;
+      dsp[idN].vtY = sPts[idN].vtY - dPts[idN].vtY;
+      dsp[idN].vtZ = 0.0;
+    }
+    errNum = WlzBasisFnCSFit(2, nPts, pts, dsp, support, poly, basis,
+                             (double *)(basisFn->param));
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    basisFn->type = WLZ_FN_BASIS_2DCS;
+    basisFn->nPoly = 2;
+    basisFn->nBasis = nPts;
+    basisFn->nVtx = nPts;
+    basisFn->maxVx = nPts;
+    WlzValueCopyDVertexToDVertex(basisFn->vertices.d2, dPts, nPts);
+    for(idN = 0; idN < 3; ++idN)
+    {
+      basisFn->poly.d2[idN].vtX = poly[idN].vtX;
+      basisFn->poly.d2[idN].vtY = poly[idN].vtY;
+    }
+    for(idN = 0; idN < nPts; ++idN)
+    {
+      basisFn->basis.d2[idN].vtX = basis[idN].vtX;
+      basisFn->basis.d2[idN].vtY = basis[idN].vtY;
+    }
+  }
+  AlcFree(pts);
+  AlcFree(dsp);
+  AlcFree(basis);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzBasisFnFree(basisFn);
+    basisFn = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(basisFn);
+}
+
+/*!
+* \return	New basis function.
+* \ingroup	WlzFunction
+* \brief	Creates a new 3D compactly supported basis function
+* 		(see WlzBasisFnValueCS3D()). The design equations
+* 		are sparse and are solved iteratively as described
+* 		for WlzBasisFnCS2DFromCPts().
+* \param	nPts			Number of control point pairs.
+* \param	dPts			Destination control points.
+* \param	sPts			Source control points.
+* \param	support			Radius of support, normalized by the
+* 					extent of the destination control
+* 					points, in the range [> 0.0, <= 1.0].
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzBasisFn *WlzBasisFnCS3DFromCPts(int nPts, WlzDVertex3 *dPts,
+				   WlzDVertex3 *sPts, double support,
+				   WlzErrorNum *dstErr)
+{
+  int		idN;
+  WlzDVertex3	*dsp = NULL;
+  WlzBasisFn	*basisFn = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((nPts <= 0) || (support <= 0.0) || (support > 1.0))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((dPts == NULL) || (sPts == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(((basisFn = (WlzBasisFn *)AlcCalloc(sizeof(WlzBasisFn),
+					      1)) == NULL) ||
+	  ((basisFn->poly.v = AlcMalloc(sizeof(WlzDVertex3) * 4)) == NULL) ||
+	  ((basisFn->basis.v = AlcMalloc(sizeof(WlzDVertex3) *
+					 nPts)) == NULL) ||
+	  ((basisFn->vertices.v = AlcMalloc(sizeof(WlzDVertex3) *
+					    nPts)) == NULL) ||
+	  ((basisFn->param = AlcMalloc(sizeof(double))) == NULL) ||
+	  ((dsp = (WlzDVertex3 *)
+		  AlcMalloc(sizeof(WlzDVertex3) * nPts)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idN = 0; idN < nPts; ++idN)
+    {
+      WLZ_VTX_3_SUB(dsp[idN], sPts[idN], dPts[idN]);
+    }
+    errNum = WlzBasisFnCSFit(3, nPts, dPts, dsp, support,
+                             basisFn->poly.d3, basisFn->basis.d3,
+                             (double *)(basisFn->param));
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    basisFn->type = WLZ_FN_BASIS_3DCS;
+    basisFn->nPoly = 2;
+    basisFn->nBasis = nPts;
+    basisFn->nVtx = nPts;
+    basisFn->maxVx = nPts;
+    WlzValueCopyDVertexToDVertex3(basisFn->vertices.d3, dPts, nPts);
+  }
+  AlcFree(dsp);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzBasisFnFree(basisFn);
+    basisFn = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(basisFn);
+}
+
 /*!
 * \return	New histogram domain look up table.
 * \ingroup	WlzFunction
@@ -4486,3 +5427,412 @@ static void	WlzBasisFnEditSV(int n, double *vV)
     }
   }
 }
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzFunction
+* \brief	Fits a compactly supported basis function with a reduced
+* 		polynomial to the given displacements. The coordinates
+* 		are first normalized by the extent of the control
+* 		points. The reduced polynomial is fitted by least
+* 		squares and then the basis function coefficients which
+* 		interpolate the residual displacements are found by
+* 		solving the sparse (symmetric positive definite) design
+* 		equations using the preconditioned conjugate gradient
+* 		method. The control points are binned into cells no
+* 		smaller than the radius of support, both to find the
+* 		pairs of control points within the support and to order
+* 		the equations so that nearby control points are close
+* 		together, which makes the preconditioning more effective.
+* \param	dim			Dimension, either 2 or 3 (the z
+* 					components are ignored for 2).
+* \param	nPts			Number of control points.
+* \param	pts			Control points.
+* \param	dsp			Displacements at the control points.
+* \param	support			Normalized radius of support.
+* \param	poly			Destination for the dim + 1 reduced
+* 					polynomial coefficients.
+* \param	basis			Destination for the basis function
+* 					coefficients.
+* \param	dstSup			Destination for the (unnormalized)
+* 					radius of support.
+*/
+static WlzErrorNum WlzBasisFnCSFit(int dim, int nPts,
+				   WlzDVertex3 *pts, WlzDVertex3 *dsp,
+				   double support, WlzDVertex3 *poly,
+				   WlzDVertex3 *basis, double *dstSup)
+{
+  int		idC,
+  		idK,
+		idN,
+		nCell = 1,
+  		nSys;
+  double	range,
+  		supSq;
+  int		*cell = NULL,
+  		*cOff = NULL,
+		*ord = NULL;
+  double	*bV = NULL,
+  		*xV = NULL,
+		*rV = NULL;
+  WlzDVertex3	*qPts = NULL;
+  AlgMatrix	aM,
+  		vM,
+		lM,
+		wM;
+  WlzDBox3	extentDB;
+  int		nG[3];
+  double	gSc[3],
+  		ext[3],
+		wV[4];
+  double	aff[3][4];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const int	maxItr = 10000;
+  const double	tol = 1.0e-10;
+
+  aM.core = NULL;
+  vM.core = NULL;
+  lM.core = NULL;
+  wM.core = NULL;
+  nSys = dim + 1;
+  WlzBasisFnVxExtent3D(&extentDB, pts, pts, nPts);
+  ext[0] = extentDB.xMax - extentDB.xMin;
+  ext[1] = extentDB.yMax - extentDB.yMin;
+  ext[2] = (dim == 3)? extentDB.zMax - extentDB.zMin: 0.0;
+  range = ALG_MAX3(ext[0], ext[1], ext[2]);
+  if(range <= 1.0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if(((qPts = (WlzDVertex3 *)
+                   AlcMalloc(sizeof(WlzDVertex3) * nPts)) == NULL) ||
+	  ((rV = (double *)AlcMalloc(sizeof(double) * 3 * nPts)) == NULL) ||
+	  ((bV = (double *)AlcMalloc(sizeof(double) * nPts)) == NULL) ||
+	  ((xV = (double *)AlcMalloc(sizeof(double) * nPts)) == NULL) ||
+	  ((cell = (int *)AlcMalloc(sizeof(int) * nPts)) == NULL) ||
+	  ((ord = (int *)AlcMalloc(sizeof(int) * nPts)) == NULL) ||
+	  ((aM.rect = AlgMatrixRectNew(nSys, nSys, NULL)) == NULL) ||
+	  ((vM.rect = AlgMatrixRectNew(nSys, nSys, NULL)) == NULL) ||
+	  ((wM.rect = AlgMatrixRectNew(4, nPts, NULL)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    double	**aA;
+    double	e[4];
+
+    /* Normalize the control points and fit the reduced polynomial to
+     * the displacements using the normal equations. */
+    aA = aM.rect->array;
+    for(idK = 0; idK < nSys; ++idK)
+    {
+      for(idC = 0; idC < nSys; ++idC)
+      {
+        aA[idK][idC] = 0.0;
+      }
+      aff[0][idK] = aff[1][idK] = aff[2][idK] = 0.0;
+    }
+    for(idN = 0; idN < nPts; ++idN)
+    {
+      qPts[idN].vtX = (pts[idN].vtX - extentDB.xMin) / range;
+      qPts[idN].vtY = (pts[idN].vtY - extentDB.yMin) / range;
+      qPts[idN].vtZ = (dim == 3)? (pts[idN].vtZ - extentDB.zMin) / range: 0.0;
+      e[0] = 1.0;
+      e[1] = qPts[idN].vtX;
+      e[2] = qPts[idN].vtY;
+      e[3] = qPts[idN].vtZ;
+      for(idK = 0; idK < nSys; ++idK)
+      {
+        for(idC = 0; idC < nSys; ++idC)
+	{
+	  aA[idK][idC] += e[idK] * e[idC];
+	}
+	aff[0][idK] += e[idK] * dsp[idN].vtX;
+	aff[1][idK] += e[idK] * dsp[idN].vtY;
+	aff[2][idK] += e[idK] * dsp[idN].vtZ;
+      }
+    }
+    errNum = WlzErrorFromAlg(AlgMatrixSVDecomp(aM, wV, vM));
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzBasisFnEditSV(nSys, wV);
+      for(idC = 0; (errNum == WLZ_ERR_NONE) && (idC < dim); ++idC)
+      {
+        errNum = WlzErrorFromAlg(AlgMatrixSVBackSub(aM, wV, vM, aff[idC]));
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if(dim == 2)
+      {
+	aff[0][3] = aff[1][3] = 0.0;
+	aff[2][0] = aff[2][1] = aff[2][2] = aff[2][3] = 0.0;
+      }
+      for(idN = 0; idN < nPts; ++idN)
+      {
+	WlzDVertex3 q;
+
+	q = qPts[idN];
+	rV[idN] = dsp[idN].vtX - (aff[0][0] + (aff[0][1] * q.vtX) +
+	                          (aff[0][2] * q.vtY) + (aff[0][3] * q.vtZ));
+	rV[nPts + idN] = dsp[idN].vtY -
+	                 (aff[1][0] + (aff[1][1] * q.vtX) +
+	                  (aff[1][2] * q.vtY) + (aff[1][3] * q.vtZ));
+	rV[(2 * nPts) + idN] = dsp[idN].vtZ -
+	                       (aff[2][0] + (aff[2][1] * q.vtX) +
+	                        (aff[2][2] * q.vtY) + (aff[2][3] * q.vtZ));
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		maxG;
+
+    /* Bin the control points into cells with sides no smaller than the
+     * radius of support, with no more than about four cells per control
+     * point. */
+    maxG = (int )ceil(pow(4.0 * nPts, 1.0 / dim));
+    for(idC = 0; idC < 3; ++idC)
+    {
+      double	e;
+
+      e = ext[idC] / range;
+      nG[idC] = ALG_MIN((int )floor(e / support), maxG);
+      nG[idC] = ALG_MAX(nG[idC], 1);
+      gSc[idC] = (e > DBL_EPSILON)? nG[idC] / e: 0.0;
+      nCell *= nG[idC];
+    }
+    if((cOff = (int *)AlcCalloc(nCell + 1, sizeof(int))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idN = 0; idN < nPts; ++idN)
+    {
+      int	kX,
+      		kY,
+		kZ;
+
+      kX = ALG_MIN((int )(qPts[idN].vtX * gSc[0]), nG[0] - 1);
+      kY = ALG_MIN((int )(qPts[idN].vtY * gSc[1]), nG[1] - 1);
+      kZ = ALG_MIN((int )(qPts[idN].vtZ * gSc[2]), nG[2] - 1);
+      cell[idN] = (((kZ * nG[1]) + kY) * nG[0]) + kX;
+      ++(cOff[cell[idN] + 1]);
+    }
+    for(idC = 0; idC < nCell; ++idC)
+    {
+      cOff[idC + 1] += cOff[idC];
+    }
+    for(idN = 0; idN < nPts; ++idN)
+    {
+      ord[cOff[cell[idN]]++] = idN;
+    }
+    for(idC = nCell; idC > 0; --idC)
+    {
+      cOff[idC] = cOff[idC - 1];
+    }
+    cOff[0] = 0;
+    if((lM.llr = AlgMatrixLLRNew(nPts, nPts, 32 * nPts, DBL_EPSILON,
+                                 NULL)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Build the design matrix with the equations in cell order. The
+     * neighbouring cells and the control points within them are visited
+     * in decreasing order so that each entry is inserted at the head of
+     * its row. */
+    supSq = support * support;
+    for(idK = 0; (errNum == WLZ_ERR_NONE) && (idK < nPts); ++idK)
+    {
+      int	dX,
+      		dY,
+		dZ,
+		c,
+		i,
+		kX,
+		kY,
+		kZ;
+
+      i = ord[idK];
+      c = cell[i];
+      kX = c % nG[0];
+      kY = (c / nG[0]) % nG[1];
+      kZ = c / (nG[0] * nG[1]);
+      for(dZ = 1; dZ >= -1; --dZ)
+      {
+	if((kZ + dZ < 0) || (kZ + dZ >= nG[2]))
+	{
+	  continue;
+	}
+	for(dY = 1; dY >= -1; --dY)
+	{
+	  if((kY + dY < 0) || (kY + dY >= nG[1]))
+	  {
+	    continue;
+	  }
+	  for(dX = 1; dX >= -1; --dX)
+	  {
+	    int	idL,
+	    	cN;
+
+	    if((kX + dX < 0) || (kX + dX >= nG[0]))
+	    {
+	      continue;
+	    }
+	    cN = ((((kZ + dZ) * nG[1]) + kY + dY) * nG[0]) + kX + dX;
+	    for(idL = cOff[cN + 1] - 1; idL >= cOff[cN]; --idL)
+	    {
+	      double	r,
+	      		t;
+	      WlzDVertex3 d;
+
+	      WLZ_VTX_3_SUB(d, qPts[i], qPts[ord[idL]]);
+	      r = WLZ_VTX_3_SQRLEN(d);
+	      if(r < supSq)
+	      {
+		r = sqrt(r) / support;
+		t = 1.0 - r;
+		t *= t;
+		t = t * t * ((4.0 * r) + 1.0);
+		if(t > DBL_EPSILON)
+		{
+		  errNum = WlzErrorFromAlg(
+		           AlgMatrixLLRSet(lM.llr, idK, idL, t));
+		}
+	      }
+	    }
+	  }
+	}
+      }
+    }
+  }
+  /* Solve the design equations for each component. */
+  for(idC = 0; (errNum == WLZ_ERR_NONE) && (idC < dim); ++idC)
+  {
+    double	*r;
+
+    r = rV + (idC * nPts);
+    for(idK = 0; idK < nPts; ++idK)
+    {
+      bV[idK] = r[ord[idK]];
+      xV[idK] = 0.0;
+    }
+    errNum = WlzErrorFromAlg(
+	     AlgMatrixCGSolve(lM, xV, bV, wM, WlzBasisFnCSPrecond, NULL,
+	                      tol, maxItr, NULL, NULL));
+    for(idK = 0; idK < nPts; ++idK)
+    {
+      r[ord[idK]] = xV[idK];
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Recover the polynomial coefficients for unnormalized coordinates
+     * and the basis function coefficients. */
+    poly[0].vtX = aff[0][0] - (((aff[0][1] * extentDB.xMin) +
+                                (aff[0][2] * extentDB.yMin) +
+                                (aff[0][3] * extentDB.zMin)) / range);
+    poly[0].vtY = aff[1][0] - (((aff[1][1] * extentDB.xMin) +
+                                (aff[1][2] * extentDB.yMin) +
+                                (aff[1][3] * extentDB.zMin)) / range);
+    poly[0].vtZ = aff[2][0] - (((aff[2][1] * extentDB.xMin) +
+                                (aff[2][2] * extentDB.yMin) +
+                                (aff[2][3] * extentDB.zMin)) / range);
+    for(idK = 1; idK < nSys; ++idK)
+    {
+      poly[idK].vtX = aff[0][idK] / range;
+      poly[idK].vtY = aff[1][idK] / range;
+      poly[idK].vtZ = aff[2][idK] / range;
+    }
+    for(idN = 0; idN < nPts; ++idN)
+    {
+      basis[idN].vtX = rV[idN];
+      basis[idN].vtY = rV[nPts + idN];
+      basis[idN].vtZ = (dim == 3)? rV[(2 * nPts) + idN]: 0.0;
+    }
+    *dstSup = support * range;
+  }
+  AlcFree(qPts);
+  AlcFree(rV);
+  AlcFree(bV);
+  AlcFree(xV);
+  AlcFree(cell);
+  AlcFree(cOff);
+  AlcFree(ord);
+  (void )AlgMatrixFree(aM);
+  (void )AlgMatrixFree(vM);
+  (void )AlgMatrixFree(lM);
+  (void )AlgMatrixFree(wM);
+  return(errNum);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Symmetric Gauss-Seidel preconditioner for the conjugate
+* 		gradient solution of the compactly supported basis
+* 		function design equations, solving
+* 		\f$(D + L) D^{-1} (D + U) \mathbf{z} = \mathbf{r}\f$
+* 		with one forward and one backward sweep, where
+* 		\f$D\f$, \f$L\f$ and \f$U\f$ are the diagonal, strictly
+* 		lower and strictly upper parts of the design matrix.
+* 		This relies on the entries of each row of the linked list
+* 		row matrix being in increasing column order.
+* \param	data			Unused.
+* \param	aM			The design matrix, which must be a
+* 					linked list row matrix.
+* \param	rV			Given vector.
+* \param	zV			Destination vector.
+*/
+static void	WlzBasisFnCSPrecond(void *data, AlgMatrix aM,
+				    double *rV, double *zV)
+{
+  size_t	idR,
+  		nR;
+  AlgMatrixLLRE	*p;
+
+  nR = aM.llr->nR;
+  for(idR = 0; idR < nR; ++idR)
+  {
+    double	d = 1.0,
+    		s;
+
+    s = rV[idR];
+    for(p = aM.llr->tbl[idR]; (p != NULL) && (p->col <= idR); p = p->nxt)
+    {
+      if(p->col < idR)
+      {
+        s -= p->val * zV[p->col];
+      }
+      else
+      {
+        d = p->val;
+      }
+    }
+    zV[idR] = s / d;
+  }
+  for(idR = nR; idR-- > 0;)
+  {
+    double	d = 1.0,
+    		s = 0.0;
+
+    for(p = aM.llr->tbl[idR]; p != NULL; p = p->nxt)
+    {
+      if(p->col > idR)
+      {
+        s += p->val * zV[p->col];
+      }
+      else if(p->col == idR)
+      {
+        d = p->val;
+      }
+    }
+    zV[idR] -= s / d;
+  }
+}
@@ -150,9 +150,12 @@ WlzBasisFnTransform *WlzBasisFnTrFromCPts2D(WlzFnType type,
 *		and thin-plate spline).
 *		Additional basis functions parameters may be supplied via
 *		the nParam and param parameters. Currently this is only used to
-*		supply the multi-quadric delta or gauss parameter scaling.
-*		The default values of multi-quadric delta = 0.001 and
-*		gauss param = 0.9 are used if nParam <= 0 or param == NULL.
+*		supply the multi-quadric delta, gauss parameter scaling or
+*		the normalized radius of support of compactly supported
+*		basis functions.
+*		The default values of multi-quadric delta = 0.001,
+*		gauss param = 0.9 and radius of support = 0.1 are used if
+*		nParam <= 0 or param == NULL.
 * \param	type			Required basis function type.
 * \param	order			Order of polynomial, only used for
 * 					WLZ_FN_BASIS_2DPOLY.
@@ -189,7 +192,8 @@ WlzBasisFnTransform *WlzBasisFnTrFromCPts2DParam(WlzFnType type,
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   const double	deltaMQ = 0.001,
 		deltaIMQ = 0.300,
-  		paramGauss = 0.9;
+  		paramGauss = 0.9,
+		supportCS = 0.1;
 
   if((nDPts != nSPts) || (nDPts <= 0))
   {
@@ -254,6 +258,13 @@ WlzBasisFnTransform *WlzBasisFnTrFromCPts2DParam(WlzFnType type,
 					order, dPts, sPts,
 				        &errNum);
 	break;
+      case WLZ_FN_BASIS_2DCS:
+	basisTr->basisFn = WlzBasisFnCS2DFromCPts(nDPts,
+					dPts, sPts,
+					((nParam > 0) && (param != NULL))?
+					*param: supportCS,
+					&errNum);
+	break;
       default:
 	 errNum = WLZ_ERR_TRANSFORM_TYPE;
 	 break;
@@ -283,9 +294,12 @@ WlzBasisFnTransform *WlzBasisFnTrFromCPts2DParam(WlzFnType type,
 *		and thin-plate spline).
 *		Additional basis functions parameters may be supplied via
 *		the nParam and param parameters. Currently this is only used to
-*		supply the multi-quadric delta or gauss parameter scaling.
-*		The default values of multi-quadric delta = 0.001 and
-*		gauss param = 0.9 are used if nParam <= 0 or param == NULL.
+*		supply the multi-quadric delta, gauss parameter scaling or
+*		the normalized radius of support of compactly supported
+*		basis functions.
+*		The default values of multi-quadric delta = 0.001,
+*		gauss param = 0.9 and radius of support = 0.1 are used if
+*		nParam <= 0 or param == NULL.
 * \param	type			Required basis function type.
 * \param	order			Order of polynomial, only used for
 * 					WLZ_FN_BASIS_3DPOLY.
@@ -321,7 +335,8 @@ WlzBasisFnTransform *WlzBasisFnTrFromCPts3DParam(WlzFnType type,
   WlzBasisFnTransform *basisTr = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   const double	deltaMQ = 0.001,
-		deltaIMQ = 0.100;
+		deltaIMQ = 0.100,
+		supportCS = 0.1;
 
   if((nDPts != nSPts) || (nDPts <= 0))
   {
@@ -364,6 +379,13 @@ WlzBasisFnTransform *WlzBasisFnTrFromCPts3DParam(WlzFnType type,
 					*param: deltaMQ,
 					NULL, mesh, &errNum);
 	break;
+      case WLZ_FN_BASIS_3DCS:
+	basisTr->basisFn = WlzBasisFnCS3DFromCPts(nDPts,
+					dPts, sPts,
+					((nParam > 0) && (param != NULL))?
+					*param: supportCS,
+					&errNum);
+	break;
       default:
 	 errNum = WLZ_ERR_TRANSFORM_TYPE;
 	 break;
@@ -430,9 +452,12 @@ WlzErrorNum	WlzBasisFnTPS2DChangeCPts(WlzBasisFnTransform *basisTr,
 *		The full list of control points must be given.
 *		Additional basis functions parameters may be supplied via
 *		the nParam and param parameters. Currently this is only used to
-*		supply the multi-quadric delta or gauss parameter scaling.
-*		The default values of multi-quadric delta = 0.001 and
-*		gauss param = 0.9 are used if nParam <= 0 or param == NULL.
+*		supply the multi-quadric delta, gauss parameter scaling or
+*		the normalized radius of support of compactly supported
+*		basis functions.
+*		The default values of multi-quadric delta = 0.001,
+*		gauss param = 0.9 and radius of support = 0.1 are used if
+*		nParam <= 0 or param == NULL.
 * \param	basisTr			Existing basis function transform.
 * \param	nDPts			Number of destination control points.
 * \param	dPts			Destination control points.
@@ -456,7 +481,8 @@ WlzErrorNum	WlzBasisFnTPS2DChangeCPtsParam(WlzBasisFnTransform *basisTr,
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   const double	deltaMQ = 0.001,
 		deltaIMQ = 0.300,
-  		paramGauss = 0.900;
+  		paramGauss = 0.900,
+		supportCS = 0.1;
 
   if((nDPts != nSPts) || (nDPts <= 0))
   {
@@ -518,6 +544,11 @@ WlzErrorNum	WlzBasisFnTPS2DChangeCPtsParam(WlzBasisFnTransform *basisTr,
 					dPts, sPts,
 				        &errNum);
 	break;
+      case WLZ_FN_BASIS_2DCS:
+	newBasisFn = WlzBasisFnCS2DFromCPts(nDPts, dPts, sPts,
+			  ((nParam > 0) && (param != NULL))?
+			  *param: supportCS, &errNum);
+	break;
       default:
 	 errNum = WLZ_ERR_TRANSFORM_TYPE;
 	 break;
@@ -588,8 +619,8 @@ WlzBasisFnTransform *WlzBasisFnTrFromCPts3D(WlzFnType type,
 WlzErrorNum    	WlzBasisFnSetMesh(WlzMeshTransform *mesh,
 				  WlzBasisFnTransform *basisTr)
 {
-  int		nodCnt;
-  WlzMeshNode	*nod;
+  int		idN;
+  WlzDVertex2	*pos = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   if((mesh == NULL) || (basisTr == NULL))
@@ -601,64 +632,29 @@ WlzErrorNum    	WlzBasisFnSetMesh(WlzMeshTransform *mesh,
   {
     errNum = WLZ_ERR_TRANSFORM_TYPE;
   }
-  else
+  else if(mesh->nNodes > 0)
   {
-    nod = mesh->nodes;
-    nodCnt = mesh->nNodes;
-    switch(basisTr->basisFn->type)
+    if((pos = (WlzDVertex2 *)
+              AlcMalloc(sizeof(WlzDVertex2) * mesh->nNodes)) == NULL)
     {
-      case WLZ_FN_BASIS_2DGAUSS:
-	while(nodCnt-- > 0)
-	{
-	  nod->displacement = WlzBasisFnValueGauss2D(basisTr->basisFn,
-	  				nod->position);
-	  ++nod;
-	}
-	break;
-      case WLZ_FN_BASIS_2DPOLY:
-	while(nodCnt-- > 0)
-	{
-	  nod->displacement = WlzBasisFnValuePoly2D(basisTr->basisFn,
-	  				nod->position);
-	  ++nod;
-	}
-	break;
-      case WLZ_FN_BASIS_2DIMQ:
-	while(nodCnt-- > 0)
-	{
-	  nod->displacement = WlzBasisFnValueIMQ2D(basisTr->basisFn,
-	  				nod->position);
-	  ++nod;
-	}
-	break;
-      case WLZ_FN_BASIS_2DMQ:
-	while(nodCnt-- > 0)
-	{
-	  nod->displacement = WlzBasisFnValueMQ2D(basisTr->basisFn,
-	  				nod->position);
-	  ++nod;
-	}
-	break;
-      case WLZ_FN_BASIS_2DTPS:
-	while(nodCnt-- > 0)
-	{
-	  nod->displacement = WlzBasisFnValueTPS2D(basisTr->basisFn,
-	  				nod->position);
-	  ++nod;
-	}
-	break;
-    case WLZ_FN_BASIS_2DCONF_POLY:
-	while(nodCnt-- > 0)
-	{
-	  nod->displacement = WlzBasisFnValueConf2D(basisTr->basisFn,
-	  				nod->position);
-	  ++nod;
-	}
-	break;
-      default:
-	errNum = WLZ_ERR_TRANSFORM_TYPE;
-	break;
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      for(idN = 0; idN < mesh->nNodes; ++idN)
+      {
+	pos[idN] = mesh->nodes[idN].position;
+      }
+      errNum = WlzBasisFnValues2D(basisTr->basisFn, mesh->nNodes, pos, pos);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      for(idN = 0; idN < mesh->nNodes; ++idN)
+      {
+	mesh->nodes[idN].displacement = pos[idN];
+      }
     }
+    AlcFree(pos);
   }
   return(errNum);
 }
@@ -721,9 +717,11 @@ WlzErrorNum    	WlzBasisFnSetCMesh2D(WlzObject *mObj,
 				     WlzBasisFnTransform *basisTr)
 {
   int		idN,
+		nPos = 0,
   		maxNodIdx;
+  int		*nodIdx = NULL;
   double	*dsp;
-  WlzDVertex2	dspV;
+  WlzDVertex2	*pos = NULL;
   WlzCMeshNod2D	*nod;
   WlzCMesh2D	*mesh;
   WlzIndexedValues *ixv;
@@ -768,74 +766,55 @@ WlzErrorNum    	WlzBasisFnSetCMesh2D(WlzObject *mObj,
   {
     switch(basisTr->basisFn->type)
     {
-      case WLZ_FN_BASIS_2DGAUSS:
-#ifdef _OPENMP
-#pragma omp parallel for private(dsp, dspV, nod)
-#endif
-	for(idN = 0; idN < maxNodIdx; ++idN)
-	{
-	  nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	  if(nod->idx >= 0)
-	  {
-	    dsp = (double *)WlzIndexedValueGet(ixv, idN);
-	    dspV = WlzBasisFnValueGauss2D(basisTr->basisFn, nod->pos);
-	    dsp[0] = dspV.vtX;
-	    dsp[1] = dspV.vtY;
-	  }
-	}
+      case WLZ_FN_BASIS_2DGAUSS: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DIMQ:   /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DMQ:    /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DTPS:   /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DCS:
         break;
-      case WLZ_FN_BASIS_2DIMQ:
-#ifdef _OPENMP
-#pragma omp parallel for private(dsp, dspV, nod)
-#endif
-	for(idN = 0; idN < maxNodIdx; ++idN)
-	{
-	  nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	  if(nod->idx >= 0)
-	  {
-	    dsp = (double *)WlzIndexedValueGet(ixv, idN);
-	    dspV = WlzBasisFnValueIMQ2D(basisTr->basisFn, nod->pos);
-	    dsp[0] = dspV.vtX;
-	    dsp[1] = dspV.vtY;
-	  }
-	}
+      default:
+	errNum = WLZ_ERR_DOMAIN_TYPE;
         break;
-      case WLZ_FN_BASIS_2DMQ:
-#ifdef _OPENMP
-#pragma omp parallel for private(dsp, dspV, nod)
-#endif
-	for(idN = 0; idN < maxNodIdx; ++idN)
+    }
+  }
+  /* Gather the node positions, compute the displacements for all of them
+   * together and then scatter the displacements into the indexed
+   * values. */
+  if((errNum == WLZ_ERR_NONE) && (maxNodIdx > 0))
+  {
+    if(((pos = (WlzDVertex2 *)
+               AlcMalloc(maxNodIdx * sizeof(WlzDVertex2))) == NULL) ||
+       ((nodIdx = (int *)AlcMalloc(maxNodIdx * sizeof(int))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      for(idN = 0; idN < maxNodIdx; ++idN)
+      {
+	nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+	if(nod->idx >= 0)
 	{
-	  nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	  if(nod->idx >= 0)
-	  {
-	    dsp = (double *)WlzIndexedValueGet(ixv, idN);
-	    dspV = WlzBasisFnValueMQ2D(basisTr->basisFn, nod->pos);
-	    dsp[0] = dspV.vtX;
-	    dsp[1] = dspV.vtY;
-	  }
+	  pos[nPos] = nod->pos;
+	  nodIdx[nPos++] = idN;
 	}
-        break;
-      case WLZ_FN_BASIS_2DTPS:
+      }
+      errNum = WlzBasisFnValues2D(basisTr->basisFn, nPos, pos, pos);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
 #ifdef _OPENMP
-#pragma omp parallel for private(dsp, dspV, nod)
+#pragma omp parallel for private(dsp)
 #endif
-	for(idN = 0; idN < maxNodIdx; ++idN)
-	{
-	  nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	  if(nod->idx >= 0)
-	  {
-	    dsp = (double *)WlzIndexedValueGet(ixv, idN);
-	    dspV = WlzBasisFnValueTPS2D(basisTr->basisFn, nod->pos);
-	    dsp[0] = dspV.vtX;
-	    dsp[1] = dspV.vtY;
-	  }
-	}
-        break;
-      default:
-	errNum = WLZ_ERR_DOMAIN_TYPE;
-        break;
+      for(idN = 0; idN < nPos; ++idN)
+      {
+	dsp = (double *)WlzIndexedValueGet(ixv, nodIdx[idN]);
+	dsp[0] = pos[idN].vtX;
+	dsp[1] = pos[idN].vtY;
+      }
     }
+    AlcFree(pos);
+    AlcFree(nodIdx);
   }
 #ifdef WLZ_CMESH_DEBUG_MESH_DSP_ERR
   if(errNum == WLZ_ERR_NONE)
@@ -885,6 +864,9 @@ WlzErrorNum    	WlzBasisFnSetCMesh2D(WlzObject *mObj,
           case WLZ_FN_BASIS_2DTPS:
 	    cDspB = WlzBasisFnValueTPS2D(basisTr->basisFn, cPos);
 	    break;
+          case WLZ_FN_BASIS_2DCS:
+	    cDspB = WlzBasisFnValueCS2D(basisTr->basisFn, cPos);
+	    break;
 	  default:
 	    WLZ_VTX_2_ZERO(cDspB);   /* Mainly to silence compiler warnings! */
 	    break;
@@ -918,9 +900,11 @@ WlzErrorNum    	WlzBasisFnSetCMesh3D(WlzObject *mObj,
 				     WlzBasisFnTransform *basisTr)
 {
   int		idN,
+		nPos = 0,
   		maxNodIdx;
+  int		*nodIdx = NULL;
   double	*dsp;
-  WlzDVertex3	dspV;
+  WlzDVertex3	*pos = NULL;
   WlzCMeshNod3D	*nod;
   WlzCMesh3D	*mesh;
   WlzIndexedValues *ixv;
@@ -965,44 +949,54 @@ WlzErrorNum    	WlzBasisFnSetCMesh3D(WlzObject *mObj,
   {
     switch(basisTr->basisFn->type)
     {
-      case WLZ_FN_BASIS_3DIMQ:
-#ifdef _OPENMP
-#pragma omp parallel for private(dsp, dspV, nod)
-#endif
-        for(idN = 0; idN < maxNodIdx; ++idN)
+      case WLZ_FN_BASIS_3DIMQ: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DMQ:  /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DCS:
+        break;
+      default:
+	errNum = WLZ_ERR_VALUES_TYPE;
+        break;
+    }
+  }
+  /* Gather the node positions, compute the displacements for all of them
+   * together and then scatter the displacements into the indexed
+   * values. */
+  if((errNum == WLZ_ERR_NONE) && (maxNodIdx > 0))
+  {
+    if(((pos = (WlzDVertex3 *)
+               AlcMalloc(maxNodIdx * sizeof(WlzDVertex3))) == NULL) ||
+       ((nodIdx = (int *)AlcMalloc(maxNodIdx * sizeof(int))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      for(idN = 0; idN < maxNodIdx; ++idN)
+      {
+	nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+	if(nod->idx >= 0)
 	{
-	  nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	  if(nod->idx >= 0)
-	  {
-	    dsp = (double *)WlzIndexedValueGet(ixv, idN);
-	    dspV = WlzBasisFnValueIMQ3D(basisTr->basisFn, nod->pos);
-	    dsp[0] = dspV.vtX;
-	    dsp[1] = dspV.vtY;
-	    dsp[2] = dspV.vtZ;
-	  }
+	  pos[nPos] = nod->pos;
+	  nodIdx[nPos++] = idN;
 	}
-	break;
-      case WLZ_FN_BASIS_3DMQ:
+      }
+      errNum = WlzBasisFnValues3D(basisTr->basisFn, nPos, pos, pos);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
 #ifdef _OPENMP
-#pragma omp parallel for private(dsp, dspV, nod)
+#pragma omp parallel for private(dsp)
 #endif
-        for(idN = 0; idN < maxNodIdx; ++idN)
-	{
-	  nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	  if(nod->idx >= 0)
-	  {
-	    dsp = (double *)WlzIndexedValueGet(ixv, idN);
-	    dspV = WlzBasisFnValueMQ3D(basisTr->basisFn, nod->pos);
-	    dsp[0] = dspV.vtX;
-	    dsp[1] = dspV.vtY;
-	    dsp[2] = dspV.vtZ;
-	  }
-	}
-	break;
-      default:
-        errNum = WLZ_ERR_VALUES_TYPE;
-	break;
+      for(idN = 0; idN < nPos; ++idN)
+      {
+	dsp = (double *)WlzIndexedValueGet(ixv, nodIdx[idN]);
+	dsp[0] = pos[idN].vtX;
+	dsp[1] = pos[idN].vtY;
+	dsp[2] = pos[idN].vtZ;
+      }
     }
+    AlcFree(pos);
+    AlcFree(nodIdx);
   }
 #ifdef WLZ_CMESH_DEBUG_MESH_DSP_ERR
   if(errNum == WLZ_ERR_NONE)
@@ -1046,6 +1040,9 @@ WlzErrorNum    	WlzBasisFnSetCMesh3D(WlzObject *mObj,
           case WLZ_FN_BASIS_3DMQ:
 	    cDspB = WlzBasisFnValueMQ3D(basisTr->basisFn, cPos);
 	    break;
+          case WLZ_FN_BASIS_3DCS:
+	    cDspB = WlzBasisFnValueCS3D(basisTr->basisFn, cPos);
+	    break;
 	  default:
 	    WLZ_VTX_3_ZERO(cDspB);   /* Mainly to silence compiler warnings! */
 	    break;
@@ -1425,7 +1422,13 @@ WlzObject 	*WlzBasisFnInvertMakeCMeshTr3D(
 *		to transform an object using a basis function and mesh. In most
 *		cases WlzMeshFromObj(), WlzBasisFnSetMesh() and
 *		WlzMeshTransformObj() would be called allowing a mesh to be
-*		reused.
+*		reused. The basis function is only evaluated at the mesh
+*		nodes, with displacements interpolated between them. 3D
+*		domain objects are transformed using a conforming mesh
+*		(see WlzCMeshTransformFromObj() and WlzBasisFnSetCMesh()).
+*		Setting the basis function's evaluation tolerance allows
+*		the mesh displacements to be approximated using a basis
+*		function tree when there are many control points.
 * \param	srcObj			Object to be transformed.
 * \param	basisTr			Basis function transform to apply.
 * \param	interp			Level of interpolation to use.
@@ -1436,7 +1439,8 @@ WlzObject	*WlzBasisFnTransformObj(WlzObject *srcObj,
 					WlzInterpolationType interp,
 					WlzErrorNum *dstErr)
 {
-  WlzObject	*dstObj = NULL;
+  WlzObject	*dstObj = NULL,
+  		*mObj = NULL;
   WlzDomain	dstDom;
   WlzValues	dumVal;
   WlzMeshTransform *mesh = NULL;
@@ -1457,8 +1461,7 @@ WlzObject	*WlzBasisFnTransformObj(WlzObject *srcObj,
 	  errNum = WLZ_ERR_MEM_ALLOC;
 	}
 	break;
-      case WLZ_2D_DOMAINOBJ: /* FALLTHROUGH */
-      case WLZ_3D_DOMAINOBJ:
+      case WLZ_2D_DOMAINOBJ:
 	mesh = WlzMeshFromObj(srcObj, WLZ_MESH_GENMETHOD_BLOCK, 100.0, 100.0,
 	                      &errNum);
 	if(errNum == WLZ_ERR_NONE)
@@ -1474,6 +1477,19 @@ WlzObject	*WlzBasisFnTransformObj(WlzObject *srcObj,
 	  WlzMeshFreeTransform(mesh);
 	}
         break;
+      case WLZ_3D_DOMAINOBJ:
+	mObj = WlzCMeshTransformFromObj(srcObj, WLZ_MESH_GENMETHOD_CONFORM,
+					20.0, 40.0, NULL, 1, &errNum);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  errNum = WlzBasisFnSetCMesh(mObj, basisTr);
+	}
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  dstObj = WlzCMeshTransformObj(srcObj, mObj, interp, &errNum);
+	}
+	(void )WlzFreeObj(mObj);
+        break;
       case WLZ_2D_POLYGON: /* FALLTHROUGH */
       case WLZ_BOUNDLIST: /* FALLTHROUGH */
       case WLZ_CONTOUR:
@@ -1541,13 +1557,15 @@ WlzPolygonDomain *WlzBasisFnTransformPoly2(WlzPolygonDomain *srcPoly,
 					   int newPoly,
 					   WlzErrorNum *dstErr)
 {
-  int		idN;
+  int		idN,
+  		nVtx;
   WlzVertexP	sVP,
-  		dVP;
-  WlzDVertex2	tD;
+  		dVP,
+		tVP;
   WlzPolygonDomain *dstPoly = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
+  tVP.v = NULL;
   if(srcPoly == NULL)
   {
     errNum = WLZ_ERR_DOMAIN_NULL;
@@ -1577,59 +1595,66 @@ WlzPolygonDomain *WlzBasisFnTransformPoly2(WlzPolygonDomain *srcPoly,
     {
       dVP.v = srcPoly->vtx;
     }
+    nVtx = srcPoly->nvertices;
     switch(srcPoly->type)
     {
-      case WLZ_POLYGON_INT:
-	tD.vtX = sVP.i2->vtX;
-	tD.vtY = sVP.i2->vtY;
-	tD = WlzBasisFnTransformVertexD(basisTr, tD, &errNum);
+      case WLZ_POLYGON_INT: /* FALLTHROUGH */
+      case WLZ_POLYGON_FLOAT:
+	if((nVtx > 0) &&
+	   ((tVP.d2 = (WlzDVertex2 *)
+	              AlcMalloc(nVtx * sizeof(WlzDVertex2))) == NULL))
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
 	if(errNum == WLZ_ERR_NONE)
 	{
-	  dVP.i2->vtX = (int )(tD.vtX);
-	  dVP.i2->vtY = (int )(tD.vtY);
-	  for(idN = 1; idN < srcPoly->nvertices; ++idN)
+	  if(srcPoly->type == WLZ_POLYGON_INT)
+	  {
+	    for(idN = 0; idN < nVtx; ++idN)
+	    {
+	      tVP.d2[idN].vtX = sVP.i2[idN].vtX;
+	      tVP.d2[idN].vtY = sVP.i2[idN].vtY;
+	    }
+	  }
+	  else
 	  {
-	    ++(sVP.i2);
-	    ++(dVP.i2);
-	    tD.vtX = sVP.i2->vtX;
-	    tD.vtY = sVP.i2->vtY;
-	    tD = WlzBasisFnTransformVertexD(basisTr, tD, NULL);
-	    dVP.i2->vtX = (int )(tD.vtX);
-	    dVP.i2->vtY = (int )(tD.vtY);
+	    for(idN = 0; idN < nVtx; ++idN)
+	    {
+	      tVP.d2[idN].vtX = sVP.f2[idN].vtX;
+	      tVP.d2[idN].vtY = sVP.f2[idN].vtY;
+	    }
 	  }
+	  errNum = WlzBasisFnTransformVertices(basisTr, WLZ_VERTEX_D2,
+	  				       nVtx, tVP);
 	}
-        break;
-      case WLZ_POLYGON_FLOAT:
-	tD.vtX = sVP.f2->vtX;
-	tD.vtY = sVP.f2->vtY;
-	tD = WlzBasisFnTransformVertexD(basisTr, tD, &errNum);
 	if(errNum == WLZ_ERR_NONE)
 	{
-	  dVP.f2->vtX = (float )(tD.vtX);
-	  dVP.f2->vtY = (float )(tD.vtY);
-	  for(idN = 1; idN < srcPoly->nvertices; ++idN)
+	  if(srcPoly->type == WLZ_POLYGON_INT)
+	  {
+	    for(idN = 0; idN < nVtx; ++idN)
+	    {
+	      dVP.i2[idN].vtX = (int )(tVP.d2[idN].vtX);
+	      dVP.i2[idN].vtY = (int )(tVP.d2[idN].vtY);
+	    }
+	  }
+	  else
 	  {
-	    ++(sVP.f2);
-	    ++(dVP.f2);
-	    tD.vtX = sVP.f2->vtX;
-	    tD.vtY = sVP.f2->vtY;
-	    tD = WlzBasisFnTransformVertexD(basisTr, tD, NULL);
-	    dVP.f2->vtX = (float )(tD.vtX);
-	    dVP.f2->vtY = (float )(tD.vtY);
+	    for(idN = 0; idN < nVtx; ++idN)
+	    {
+	      dVP.f2[idN].vtX = (float )(tVP.d2[idN].vtX);
+	      dVP.f2[idN].vtY = (float )(tVP.d2[idN].vtY);
+	    }
 	  }
 	}
+	AlcFree(tVP.v);
         break;
       case WLZ_POLYGON_DOUBLE:
-	*(dVP.d2) = WlzBasisFnTransformVertexD(basisTr, *(sVP.d2), &errNum);
-	if(errNum == WLZ_ERR_NONE)
+	if(newPoly && (nVtx > 0))
 	{
-	  for(idN = 1; idN < srcPoly->nvertices; ++idN)
-	  {
-	    ++(sVP.d2);
-	    ++(dVP.d2);
-	    *(dVP.d2) = WlzBasisFnTransformVertexD(basisTr, *(sVP.d2), NULL);
-	  }
+	  (void )memcpy(dVP.v, sVP.v, nVtx * sizeof(WlzDVertex2));
 	}
+	errNum = WlzBasisFnTransformVertices(basisTr, WLZ_VERTEX_D2,
+					     nVtx, dVP);
         break;
       default:
         errNum = WLZ_ERR_DOMAIN_TYPE;
@@ -1808,16 +1833,75 @@ WlzGMModel	*WlzBasisFnTransformGMModel(WlzGMModel *srcM,
 					    int newModel, WlzErrorNum *dstErr)
 {
   int		idx,
-  		cnt;
-  WlzDVertex2	tD;
+  		cnt,
+		nVtx = 0;
   AlcVector	*vec;
+  WlzVertexP	vtx;
   WlzGMElemP	elmP;
+  WlzGMElemP	*elm = NULL;
   WlzGMModel	*dstM = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
+  vtx.v = NULL;
   dstM = (newModel)? WlzGMModelCopy(srcM, &errNum): srcM;
-  /* Transform vertex geometries. */
-  if(errNum == WLZ_ERR_NONE)
+  /* Gather the vertex geometries of 2D models into an array so that they
+   * may be transformed together. */
+  if((errNum == WLZ_ERR_NONE) &&
+     ((dstM->type == WLZ_GMMOD_2I) || (dstM->type == WLZ_GMMOD_2D)))
+  {
+    vec = dstM->res.vertexG.vec;
+    cnt = dstM->res.vertexG.numIdx;
+    if(cnt > 0)
+    {
+      if(((vtx.d2 = (WlzDVertex2 *)
+                    AlcMalloc(cnt * sizeof(WlzDVertex2))) == NULL) ||
+         ((elm = (WlzGMElemP *)AlcMalloc(cnt * sizeof(WlzGMElemP))) == NULL))
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      nVtx = 0;
+      for(idx = 0; idx < cnt; ++idx)
+      {
+	elmP.core = (WlzGMCore *)AlcVectorItemGet(vec, idx);
+	if(elmP.core && (elmP.core->idx >= 0))
+	{
+	  if(dstM->type == WLZ_GMMOD_2I)
+	  {
+	    vtx.d2[nVtx].vtX = elmP.vertexG2I->vtx.vtX;
+	    vtx.d2[nVtx].vtY = elmP.vertexG2I->vtx.vtY;
+	  }
+	  else
+	  {
+	    vtx.d2[nVtx] = elmP.vertexG2D->vtx;
+	  }
+	  elm[nVtx++] = elmP;
+	}
+      }
+      errNum = WlzBasisFnTransformVertices(basisTr, WLZ_VERTEX_D2, nVtx, vtx);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      for(idx = 0; idx < nVtx; ++idx)
+      {
+        if(dstM->type == WLZ_GMMOD_2I)
+	{
+	  elm[idx].vertexG2I->vtx.vtX = WLZ_NINT(vtx.d2[idx].vtX);
+	  elm[idx].vertexG2I->vtx.vtY = WLZ_NINT(vtx.d2[idx].vtY);
+	}
+	else
+	{
+	  elm[idx].vertexG2D->vtx = vtx.d2[idx];
+	}
+      }
+    }
+    AlcFree(vtx.v);
+    AlcFree(elm);
+  }
+  /* Transform vertex geometries with normals. */
+  else if(errNum == WLZ_ERR_NONE)
   {
     idx = 0;
     vec = dstM->res.vertexG.vec;
@@ -1829,17 +1913,6 @@ WlzGMModel	*WlzBasisFnTransformGMModel(WlzGMModel *srcM,
       {
         switch(dstM->type)
         {
-          case WLZ_GMMOD_2I:
-	    tD.vtX = elmP.vertexG2I->vtx.vtX;
-	    tD.vtY = elmP.vertexG2I->vtx.vtY;
-	    tD = WlzBasisFnTransformVertexD(basisTr, tD, &errNum);
-	    elmP.vertexG2I->vtx.vtX = WLZ_NINT(tD.vtX);
-	    elmP.vertexG2I->vtx.vtY = WLZ_NINT(tD.vtY);
-            break;
-          case WLZ_GMMOD_2D:
-	    elmP.vertexG2D->vtx = WlzBasisFnTransformVertexD(basisTr,
-	    				elmP.vertexG2D->vtx, &errNum);
-            break;
           case WLZ_GMMOD_2N:
 	    elmP.vertexG2N->nrm = WlzBasisFnTransformNormalD(basisTr,
 					elmP.vertexG2N->vtx,
@@ -2012,6 +2085,11 @@ WlzDVertex2	WlzBasisFnTransformVertexD(WlzBasisFnTransform *basisTr,
 	dstVx.vtX += srcVx.vtX;
 	dstVx.vtY += srcVx.vtY;
 	break;
+      case WLZ_FN_BASIS_2DCS:
+	dstVx = WlzBasisFnValueCS2D(basisTr->basisFn, srcVx);
+	dstVx.vtX += srcVx.vtX;
+	dstVx.vtY += srcVx.vtY;
+	break;
       default:
 	errNum = WLZ_ERR_TRANSFORM_TYPE;
 	break;
@@ -2073,3 +2151,83 @@ WlzIVertex2	WlzBasisFnTransformVertexI(WlzBasisFnTransform *basisTr,
   dstVxI.vtY = WLZ_NINT(dstVxD.vtY);
   return(dstVxI);
 }
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzTransform
+* \brief	Transforms the given array of vertices in place. This is
+* 		equivalent to calling WlzBasisFnTransformVertexD() for
+* 		each of the vertices, but the basis function values are
+* 		computed for all the vertices together using
+* 		WlzBasisFnValues2D() or WlzBasisFnValues3D().
+* \param	basisTr			Basis function transform to apply.
+* \param	vType			Vertex type, which must be
+* 					WLZ_VERTEX_D2 for a 2D transform or
+* 					WLZ_VERTEX_D3 for a 3D transform.
+* \param	nVtx			Number of vertices.
+* \param	vtx			Array of vertices.
+*/
+WlzErrorNum	WlzBasisFnTransformVertices(WlzBasisFnTransform *basisTr,
+					    WlzVertexType vType,
+					    int nVtx, WlzVertexP vtx)
+{
+  int		idx;
+  WlzVertexP	dsp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dsp.v = NULL;
+  if((basisTr == NULL) || (basisTr->basisFn == NULL))
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if((nVtx > 0) && (vtx.v == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(!(((basisTr->type == WLZ_TRANSFORM_2D_BASISFN) &&
+             (vType == WLZ_VERTEX_D2)) ||
+	    ((basisTr->type == WLZ_TRANSFORM_3D_BASISFN) &&
+	     (vType == WLZ_VERTEX_D3))))
+  {
+    errNum = WLZ_ERR_TRANSFORM_TYPE;
+  }
+  else if(nVtx > 0)
+  {
+    if((dsp.v = AlcMalloc(nVtx * ((vType == WLZ_VERTEX_D2)?
+                                  sizeof(WlzDVertex2):
+				  sizeof(WlzDVertex3)))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (nVtx > 0))
+  {
+    if(vType == WLZ_VERTEX_D2)
+    {
+      errNum = WlzBasisFnValues2D(basisTr->basisFn, nVtx, vtx.d2, dsp.d2);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	for(idx = 0; idx < nVtx; ++idx)
+	{
+	  vtx.d2[idx].vtX = dsp.d2[idx].vtX + vtx.d2[idx].vtX;
+	  vtx.d2[idx].vtY = dsp.d2[idx].vtY + vtx.d2[idx].vtY;
+	}
+      }
+    }
+    else
+    {
+      errNum = WlzBasisFnValues3D(basisTr->basisFn, nVtx, vtx.d3, dsp.d3);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	for(idx = 0; idx < nVtx; ++idx)
+	{
+	  vtx.d3[idx].vtX = dsp.d3[idx].vtX + vtx.d3[idx].vtX;
+	  vtx.d3[idx].vtY = dsp.d3[idx].vtY + vtx.d3[idx].vtY;
+	  vtx.d3[idx].vtZ = dsp.d3[idx].vtZ + vtx.d3[idx].vtZ;
+	}
+      }
+    }
+  }
+  AlcFree(dsp.v);
+  return(errNum);
+}
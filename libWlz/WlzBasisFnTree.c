@@ -0,0 +1,1534 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzBasisFnTree_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzBasisFnTree.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Tree accelerated evaluation of radial basis functions.
+*
+* 		The control points of a radial basis function
+* 		\f$f(x) = \sum_i w_i \phi(|x - p_i|^2) + P(x)\f$
+* 		are partitioned into a binary tree of clusters, by
+* 		recursively splitting them at the median of their
+* 		widest extent. Each cluster is enclosed by a sphere
+* 		of radius \f$\rho\f$ about a centre \f$c\f$. With
+* 		\f$v = x - c\f$, \f$y_i = p_i - c\f$ and
+* 		\f$u = |v|^2\f$, expanding
+* 		\f$\phi(u - 2 v \cdot y + |y|^2)\f$ about \f$u\f$
+* 		gives the Taylor expansion of order \f$n\f$ in \f$y\f$
+* 		\f[
+* 		\sum_i w_i \phi(|v - y_i|^2) \approx
+* 		\sum_{j, \alpha : |\alpha| + 2j \leq n}
+* 		\frac{(-2)^{|\alpha|}}{j!} \phi^{(|\alpha| + j)}(u)
+* 		v^\alpha M_{j,\alpha}
+* 		\f]
+* 		with the cluster moments
+* 		\f$M_{j,\alpha} = \sum_i w_i |y_i|^{2j}
+* 		                   y_i^\alpha / \alpha!\f$.
+* 		Along the ray from \f$c\f$ to \f$p_i\f$ only the first
+* 		two derivatives of the squared distance are non-zero, so
+* 		by Faa di Bruno's formula the \f$(n + 1)\f$th derivative
+* 		of the basis function along the ray, and hence the
+* 		remainder of the expansion, can be bounded for
+* 		\f$d - \rho \leq |x - p| \leq d + \rho\f$ where
+* 		\f$d = |v| > \rho\f$. The expansion of a cluster is
+* 		used only when this bound is no more than the tolerance
+* 		multiplied by the cluster's fraction of
+* 		\f$\sum_i |w_i|\f$, so the total error of each value
+* 		component is within the tolerance. Otherwise the
+* 		children of the cluster are visited or, for a leaf
+* 		cluster, its control points are summed directly.
+* 		Because the bound decreases with distance, the distance
+* 		beyond which each cluster's expansion may be used is
+* 		found once when the tree is made. Vertices are then
+* 		evaluated in blocks of nearby vertices, with a single
+* 		traversal of the tree for each block.
+* \ingroup	WlzFunction
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+#include <Wlz.h>
+
+/*!
+* \def		WLZ_BASISFN_TREE_ORDER
+* \ingroup	WlzFunction
+* \brief	Order of the cluster expansions, which must be at least 2.
+*/
+#define WLZ_BASISFN_TREE_ORDER	(6)
+
+/*!
+* \def		WLZ_BASISFN_TREE_LEAFSZ
+* \ingroup	WlzFunction
+* \brief	Maximum number of control points in a leaf node.
+*/
+#define WLZ_BASISFN_TREE_LEAFSZ	(64)
+
+/*!
+* \def		WLZ_BASISFN_TREE_MAXDEPTH
+* \ingroup	WlzFunction
+* \brief	Size of the node stack used for evaluation, which is
+* 		more than twice the depth of any tree, since the
+* 		trees are balanced.
+*/
+#define WLZ_BASISFN_TREE_MAXDEPTH (128)
+
+/*!
+* \def		WLZ_BASISFN_TREE_VTXBLKSZ
+* \ingroup	WlzFunction
+* \brief	Maximum number of vertices in each block of vertices
+* 		which are evaluated together.
+*/
+#define WLZ_BASISFN_TREE_VTXBLKSZ (64)
+
+static int			WlzBasisFnTreeBuild(
+				  WlzBasisFnTree *tree,
+				  double *sPts,
+				  int *perm,
+				  int i0,
+				  int i1);
+static void			WlzBasisFnTreePartition(
+				  int dim,
+				  double *qPts,
+				  int *perm,
+				  int i0,
+				  int i1,
+				  int *blk,
+				  int *nBlk);
+static int			WlzBasisFnTreeBBox(
+				  int dim,
+				  double *sPts,
+				  int *perm,
+				  int i0,
+				  int i1,
+				  double *cen);
+static void			WlzBasisFnTreeSelect(
+				  double *sPts,
+				  int dim,
+				  int ax,
+				  int *perm,
+				  int i0,
+				  int i1,
+				  int m);
+static void			WlzBasisFnTreeMoments(
+				  WlzBasisFnTree *tree,
+				  int idN);
+static void			WlzBasisFnTreeAccDist(
+				  WlzBasisFnTree *tree,
+				  WlzBasisFnTreeNode *nod,
+				  double tolW);
+static double			WlzBasisFnTreeBound(
+				  WlzBasisFnTree *tree,
+				  double uLo);
+static WlzErrorNum		WlzBasisFnTreeValues(
+				  WlzBasisFnTree *tree,
+				  int nVx,
+				  double *qPts);
+static void			WlzBasisFnTreeBlkEval(
+				  WlzBasisFnTree *tree,
+				  int n,
+				  double bP[3][WLZ_BASISFN_TREE_VTXBLKSZ],
+				  double bV[3][WLZ_BASISFN_TREE_VTXBLKSZ]);
+static void			WlzBasisFnTreeBlkDirect(
+				  WlzBasisFnTree *tree,
+				  WlzBasisFnTreeNode *nod,
+				  int n,
+				  double bP[3][WLZ_BASISFN_TREE_VTXBLKSZ],
+				  double bV[3][WLZ_BASISFN_TREE_VTXBLKSZ]);
+static void			WlzBasisFnTreeBlkExpand(
+				  WlzBasisFnTree *tree,
+				  int idN,
+				  int n,
+				  double bP[3][WLZ_BASISFN_TREE_VTXBLKSZ],
+				  double bV[3][WLZ_BASISFN_TREE_VTXBLKSZ]);
+
+/*!
+* \return	New basis function tree or NULL on error.
+* \ingroup	WlzFunction
+* \brief	Makes a tree of the control points of the given radial
+* 		basis function which may then be used to evaluate the
+* 		basis function to within the given absolute error
+* 		tolerance using WlzBasisFnTreeValues2D() or
+* 		WlzBasisFnTreeValues3D(). The tree is a copy of the
+* 		basis function's control points and coefficients and
+* 		so remains valid until the basis function is changed.
+* 		Distances are always Euclidean. The valid basis function
+* 		types are: WLZ_FN_BASIS_2DGAUSS, WLZ_FN_BASIS_2DIMQ,
+* 		WLZ_FN_BASIS_2DMQ, WLZ_FN_BASIS_2DTPS, WLZ_FN_BASIS_3DIMQ
+* 		and WLZ_FN_BASIS_3DMQ.
+* \param	basisFn			Given basis function.
+* \param	tol			Absolute error tolerance for each
+* 					component of the evaluated values,
+* 					if zero the basis function is
+* 					evaluated exactly (apart from
+* 					rounding errors).
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzBasisFnTree			*WlzBasisFnTreeMake(
+				  WlzBasisFn *basisFn,
+				  double tol,
+				  WlzErrorNum *dstErr)
+{
+  int		idx,
+  		idC,
+		nP = 1,
+  		dim = 0;
+  int		*perm = NULL;
+  double	*sPts = NULL;
+  WlzBasisFnTree *tree = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(basisFn == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(tol < 0.0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    switch(basisFn->type)
+    {
+      case WLZ_FN_BASIS_2DGAUSS: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DIMQ:   /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DMQ:    /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DTPS:
+        dim = 2;
+	break;
+      case WLZ_FN_BASIS_3DIMQ:   /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DMQ:
+        dim = 3;
+	break;
+      default:
+        errNum = WLZ_ERR_TRANSFORM_TYPE;
+	break;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) &&
+     ((basisFn->nVtx < 0) ||
+      ((basisFn->nVtx > 0) && ((basisFn->vertices.v == NULL) ||
+                               (basisFn->basis.v == NULL))) ||
+      (basisFn->poly.v == NULL) ||
+      ((basisFn->type != WLZ_FN_BASIS_2DTPS) && (basisFn->param == NULL))))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    nP = ALG_MAX(basisFn->nVtx, 1);
+    if(((tree = (WlzBasisFnTree *)
+                AlcCalloc(1, sizeof(WlzBasisFnTree))) == NULL) ||
+       ((tree->trm = (int *)AlcMalloc(sizeof(int) * 4 *
+                       (WLZ_BASISFN_TREE_ORDER + 1) *
+                       (WLZ_BASISFN_TREE_ORDER + 1) *
+                       (WLZ_BASISFN_TREE_ORDER + 1))) == NULL) ||
+       ((tree->trmK = (double *)AlcMalloc(sizeof(double) *
+                       (WLZ_BASISFN_TREE_ORDER + 1) *
+                       (WLZ_BASISFN_TREE_ORDER + 1) *
+                       (WLZ_BASISFN_TREE_ORDER + 1))) == NULL) ||
+       ((tree->pts = (double *)AlcMalloc(sizeof(double) * dim * nP)) == NULL) ||
+       ((tree->wts = (double *)AlcMalloc(sizeof(double) * dim * nP)) == NULL) ||
+       ((tree->nod = (WlzBasisFnTreeNode *)
+                     AlcMalloc(sizeof(WlzBasisFnTreeNode) * 2 * nP)) == NULL) ||
+       ((sPts = (double *)AlcMalloc(sizeof(double) * dim * nP)) == NULL) ||
+       ((perm = (int *)AlcMalloc(sizeof(int) * nP)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		j,
+    		m,
+		a,
+		b,
+		c;
+    double	jFac = 1.0;
+
+    tree->type = basisFn->type;
+    tree->dim = dim;
+    tree->order = WLZ_BASISFN_TREE_ORDER;
+    tree->nPts = basisFn->nVtx;
+    tree->tol = tol;
+    if(basisFn->type != WLZ_FN_BASIS_2DTPS)
+    {
+      tree->delta = *((double *)(basisFn->param));
+    }
+    /* Terms (a, b, c, j) with a + b + c + 2j <= order and the constant
+     * factor (-2)^(a + b + c) / j! of each. */
+    for(j = 0; 2 * j <= tree->order; ++j)
+    {
+      double	mFac = 1.0;
+
+      jFac *= (j > 0)? j: 1;
+      for(m = 0; m + (2 * j) <= tree->order; ++m)
+      {
+	for(a = m; a >= 0; --a)
+	{
+	  for(b = m - a; b >= 0; --b)
+	  {
+	    c = m - a - b;
+	    if((dim == 3) || (c == 0))
+	    {
+	      int	*t;
+
+	      t = tree->trm + 4 * tree->nTerm;
+	      t[0] = a;
+	      t[1] = b;
+	      t[2] = c;
+	      t[3] = j;
+	      tree->trmK[tree->nTerm] = mFac / jFac;
+	      ++(tree->nTerm);
+	    }
+	  }
+	}
+	mFac *= -2.0;
+      }
+    }
+    for(idx = 0; idx <= dim; ++idx)
+    {
+      if(dim == 2)
+      {
+	tree->poly[3 * idx + 0] = basisFn->poly.d2[idx].vtX;
+	tree->poly[3 * idx + 1] = basisFn->poly.d2[idx].vtY;
+      }
+      else
+      {
+	tree->poly[3 * idx + 0] = basisFn->poly.d3[idx].vtX;
+	tree->poly[3 * idx + 1] = basisFn->poly.d3[idx].vtY;
+	tree->poly[3 * idx + 2] = basisFn->poly.d3[idx].vtZ;
+      }
+    }
+    for(idx = 0; idx < tree->nPts; ++idx)
+    {
+      perm[idx] = idx;
+      if(dim == 2)
+      {
+        sPts[2 * idx + 0] = basisFn->vertices.d2[idx].vtX;
+        sPts[2 * idx + 1] = basisFn->vertices.d2[idx].vtY;
+      }
+      else
+      {
+        sPts[3 * idx + 0] = basisFn->vertices.d3[idx].vtX;
+        sPts[3 * idx + 1] = basisFn->vertices.d3[idx].vtY;
+        sPts[3 * idx + 2] = basisFn->vertices.d3[idx].vtZ;
+      }
+    }
+    (void )WlzBasisFnTreeBuild(tree, sPts, perm, 0, tree->nPts);
+    for(idx = 0; idx < tree->nPts; ++idx)
+    {
+      int	idP;
+
+      idP = perm[idx];
+      for(idC = 0; idC < dim; ++idC)
+      {
+        tree->pts[idC * tree->nPts + idx] = sPts[dim * idP + idC];
+      }
+      if(dim == 2)
+      {
+        tree->wts[idx] = basisFn->basis.d2[idP].vtX;
+        tree->wts[tree->nPts + idx] = basisFn->basis.d2[idP].vtY;
+      }
+      else
+      {
+        tree->wts[idx] = basisFn->basis.d3[idP].vtX;
+        tree->wts[tree->nPts + idx] = basisFn->basis.d3[idP].vtY;
+        tree->wts[(2 * tree->nPts) + idx] = basisFn->basis.d3[idP].vtZ;
+      }
+    }
+    if((tree->mom = (double *)AlcMalloc(sizeof(double) * dim *
+                                        tree->nTerm * tree->nNod)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idN;
+    double	tolW;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idN = 0; idN < tree->nNod; ++idN)
+    {
+      WlzBasisFnTreeMoments(tree, idN);
+    }
+    /* Each node is allowed its fraction of the total of the absolute
+     * coefficients of the tolerance. */
+    tolW = (tree->nod[0].wAbs > 0.0)? tree->tol / tree->nod[0].wAbs: 0.0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idN = 0; idN < tree->nNod; ++idN)
+    {
+      WlzBasisFnTreeAccDist(tree, tree->nod + idN, tolW);
+    }
+  }
+  AlcFree(perm);
+  AlcFree(sPts);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzBasisFnTreeFree(tree);
+    tree = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(tree);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzFunction
+* \brief	Frees the given basis function tree.
+* \param	tree			Given basis function tree, may be NULL.
+*/
+WlzErrorNum			WlzBasisFnTreeFree(
+				  WlzBasisFnTree *tree)
+{
+  if(tree)
+  {
+    AlcFree(tree->trm);
+    AlcFree(tree->trmK);
+    AlcFree(tree->pts);
+    AlcFree(tree->wts);
+    AlcFree(tree->mom);
+    AlcFree(tree->nod);
+    AlcFree(tree);
+  }
+  return(WLZ_ERR_NONE);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzFunction
+* \brief	Evaluates a 2D basis function for an array of vertices
+* 		using the given basis function tree. Each component of
+* 		each value is within the tree's tolerance of the value
+* 		computed by the basis function value functions (eg
+* 		WlzBasisFnValueMQ2D()). The given and value arrays may
+* 		be the same array.
+* \param	tree			Given 2D basis function tree.
+* \param	nVx			Number of vertices.
+* \param	srcVx			Array of vertices.
+* \param	dstVx			Array for the values.
+*/
+WlzErrorNum			WlzBasisFnTreeValues2D(
+				  WlzBasisFnTree *tree,
+				  int nVx,
+				  WlzDVertex2 *srcVx,
+				  WlzDVertex2 *dstVx)
+{
+  int		idx;
+  double	*qPts = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((tree == NULL) ||
+     ((nVx > 0) && ((srcVx == NULL) || (dstVx == NULL))))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(tree->dim != 2)
+  {
+    errNum = WLZ_ERR_TRANSFORM_TYPE;
+  }
+  else if(nVx > 0)
+  {
+    if((qPts = (double *)AlcMalloc(sizeof(double) * 2 * nVx)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      for(idx = 0; idx < nVx; ++idx)
+      {
+	qPts[2 * idx + 0] = srcVx[idx].vtX;
+	qPts[2 * idx + 1] = srcVx[idx].vtY;
+      }
+      errNum = WlzBasisFnTreeValues(tree, nVx, qPts);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      for(idx = 0; idx < nVx; ++idx)
+      {
+	dstVx[idx].vtX = qPts[2 * idx + 0];
+	dstVx[idx].vtY = qPts[2 * idx + 1];
+      }
+    }
+    AlcFree(qPts);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzFunction
+* \brief	Evaluates a 3D basis function for an array of vertices
+* 		using the given basis function tree. Each component of
+* 		each value is within the tree's tolerance of the value
+* 		computed by the basis function value functions (eg
+* 		WlzBasisFnValueMQ3D()). The given and value arrays may
+* 		be the same array.
+* \param	tree			Given 3D basis function tree.
+* \param	nVx			Number of vertices.
+* \param	srcVx			Array of vertices.
+* \param	dstVx			Array for the values.
+*/
+WlzErrorNum			WlzBasisFnTreeValues3D(
+				  WlzBasisFnTree *tree,
+				  int nVx,
+				  WlzDVertex3 *srcVx,
+				  WlzDVertex3 *dstVx)
+{
+  int		idx;
+  double	*qPts = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((tree == NULL) ||
+     ((nVx > 0) && ((srcVx == NULL) || (dstVx == NULL))))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(tree->dim != 3)
+  {
+    errNum = WLZ_ERR_TRANSFORM_TYPE;
+  }
+  else if(nVx > 0)
+  {
+    if((qPts = (double *)AlcMalloc(sizeof(double) * 3 * nVx)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      for(idx = 0; idx < nVx; ++idx)
+      {
+	qPts[3 * idx + 0] = srcVx[idx].vtX;
+	qPts[3 * idx + 1] = srcVx[idx].vtY;
+	qPts[3 * idx + 2] = srcVx[idx].vtZ;
+      }
+      errNum = WlzBasisFnTreeValues(tree, nVx, qPts);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      for(idx = 0; idx < nVx; ++idx)
+      {
+	dstVx[idx].vtX = qPts[3 * idx + 0];
+	dstVx[idx].vtY = qPts[3 * idx + 1];
+	dstVx[idx].vtZ = qPts[3 * idx + 2];
+      }
+    }
+    AlcFree(qPts);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzFunction
+* \brief	Evaluates the basis function of the given tree for an
+* 		array of vertices, replacing each vertex with its value.
+* 		The vertices are partitioned into blocks of nearby
+* 		vertices and the tree is then traversed once for each
+* 		block, in parallel.
+* \param	tree			Given basis function tree.
+* \param	nVx			Number of vertices.
+* \param	qPts			Array of vertices with tree->dim
+* 					coordinates for each, overwritten
+* 					by their values.
+*/
+static WlzErrorNum		WlzBasisFnTreeValues(
+				  WlzBasisFnTree *tree,
+				  int nVx,
+				  double *qPts)
+{
+  int		idx,
+  		idB,
+		dim,
+  		nBlk = 0;
+  int		*perm = NULL,
+  		*blk = NULL;
+  double	*qVal = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dim = tree->dim;
+  if(((perm = (int *)AlcMalloc(sizeof(int) * nVx)) == NULL) ||
+     ((blk = (int *)AlcMalloc(sizeof(int) * 2 * nVx)) == NULL) ||
+     ((qVal = (double *)AlcMalloc(sizeof(double) * dim * nVx)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idx = 0; idx < nVx; ++idx)
+    {
+      perm[idx] = idx;
+    }
+    WlzBasisFnTreePartition(dim, qPts, perm, 0, nVx, blk, &nBlk);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idB = 0; idB < nBlk; ++idB)
+    {
+      int	idC,
+      		idK,
+		idQ,
+      		n;
+      int	*bPerm;
+      double	bP[3][WLZ_BASISFN_TREE_VTXBLKSZ],
+      		bV[3][WLZ_BASISFN_TREE_VTXBLKSZ];
+
+      n = blk[2 * idB + 1] - blk[2 * idB];
+      bPerm = perm + blk[2 * idB];
+      for(idQ = 0; idQ < n; ++idQ)
+      {
+        bP[2][idQ] = 0.0;
+	for(idC = 0; idC < dim; ++idC)
+	{
+	  bP[idC][idQ] = qPts[dim * bPerm[idQ] + idC];
+	}
+	bV[0][idQ] = bV[1][idQ] = bV[2][idQ] = 0.0;
+      }
+      WlzBasisFnTreeBlkEval(tree, n, bP, bV);
+      for(idQ = 0; idQ < n; ++idQ)
+      {
+	for(idC = 0; idC < dim; ++idC)
+	{
+	  double t;
+
+	  t = bV[idC][idQ] + tree->poly[idC];
+	  for(idK = 0; idK < dim; ++idK)
+	  {
+	    t += tree->poly[3 * (idK + 1) + idC] * bP[idK][idQ];
+	  }
+	  qVal[dim * bPerm[idQ] + idC] = t;
+	}
+      }
+    }
+    (void )memcpy(qPts, qVal, sizeof(double) * dim * nVx);
+  }
+  AlcFree(perm);
+  AlcFree(blk);
+  AlcFree(qVal);
+  return(errNum);
+}
+
+/*!
+* \return	Index of the new node.
+* \ingroup	WlzFunction
+* \brief	Recursively builds the nodes of a basis function tree for
+* 		the control points perm[i0] to perm[i1 - 1], reordering
+* 		the permutation so that the control points of each node
+* 		are contiguous. The node's moments are not computed.
+* \param	tree			Tree with space for the nodes.
+* \param	sPts			Control points in their original order.
+* \param	perm			Permutation of the control points.
+* \param	i0			First index of the node's points.
+* \param	i1			One past the last index.
+*/
+static int			WlzBasisFnTreeBuild(
+				  WlzBasisFnTree *tree,
+				  double *sPts,
+				  int *perm,
+				  int i0,
+				  int i1)
+{
+  int		ax,
+		iN,
+		c0,
+		c1;
+  WlzBasisFnTreeNode *nod;
+
+  iN = tree->nNod++;
+  nod = tree->nod + iN;
+  nod->idx[0] = i0;
+  nod->idx[1] = i1;
+  nod->child[0] = nod->child[1] = -1;
+  ax = WlzBasisFnTreeBBox(tree->dim, sPts, perm, i0, i1, nod->cen);
+  if((i1 - i0) > WLZ_BASISFN_TREE_LEAFSZ)
+  {
+    int		m;
+
+    m = (i0 + i1) / 2;
+    WlzBasisFnTreeSelect(sPts, tree->dim, ax, perm, i0, i1, m);
+    c0 = WlzBasisFnTreeBuild(tree, sPts, perm, i0, m);
+    c1 = WlzBasisFnTreeBuild(tree, sPts, perm, m, i1);
+    nod = tree->nod + iN;
+    nod->child[0] = c0;
+    nod->child[1] = c1;
+  }
+  return(iN);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Recursively partitions the vertices perm[i0] to
+* 		perm[i1 - 1] into blocks of at most
+* 		WLZ_BASISFN_TREE_VTXBLKSZ nearby vertices, in the same
+* 		way as the control points of a tree are partitioned.
+* \param	dim			Dimension of the vertices.
+* \param	qPts			Vertices in their original order.
+* \param	perm			Permutation of the vertices.
+* \param	i0			First index.
+* \param	i1			One past the last index.
+* \param	blk			Destination for the first index and
+* 					one past the last index of each
+* 					block.
+* \param	nBlk			Number of blocks, incremented for
+* 					each block.
+*/
+static void			WlzBasisFnTreePartition(
+				  int dim,
+				  double *qPts,
+				  int *perm,
+				  int i0,
+				  int i1,
+				  int *blk,
+				  int *nBlk)
+{
+  if((i1 - i0) > WLZ_BASISFN_TREE_VTXBLKSZ)
+  {
+    int		ax,
+    		m;
+    double	cen[3];
+
+    ax = WlzBasisFnTreeBBox(dim, qPts, perm, i0, i1, cen);
+    m = (i0 + i1) / 2;
+    WlzBasisFnTreeSelect(qPts, dim, ax, perm, i0, i1, m);
+    WlzBasisFnTreePartition(dim, qPts, perm, i0, m, blk, nBlk);
+    WlzBasisFnTreePartition(dim, qPts, perm, m, i1, blk, nBlk);
+  }
+  else if(i1 > i0)
+  {
+    blk[2 * *nBlk] = i0;
+    blk[(2 * *nBlk) + 1] = i1;
+    ++*nBlk;
+  }
+}
+
+/*!
+* \return	Coordinate of the widest extent of the bounding box.
+* \ingroup	WlzFunction
+* \brief	Computes the bounding box of the points perm[i0] to
+* 		perm[i1 - 1] and sets the given centre to the centre
+* 		of the box.
+* \param	dim			Dimension of the points.
+* \param	sPts			Points in their original order.
+* \param	perm			Permutation of the points.
+* \param	i0			First index.
+* \param	i1			One past the last index.
+* \param	cen			Destination for the centre, with
+* 					three values (the third is zero
+* 					in 2D).
+*/
+static int			WlzBasisFnTreeBBox(
+				  int dim,
+				  double *sPts,
+				  int *perm,
+				  int i0,
+				  int i1,
+				  double *cen)
+{
+  int		idx,
+  		idC,
+		ax = 0;
+  double	bMin[3],
+  		bMax[3];
+
+  bMin[0] = bMin[1] = bMin[2] = 0.0;
+  bMax[0] = bMax[1] = bMax[2] = 0.0;
+  if(i1 > i0)
+  {
+    for(idC = 0; idC < dim; ++idC)
+    {
+      bMin[idC] = bMax[idC] = sPts[dim * perm[i0] + idC];
+    }
+    for(idx = i0 + 1; idx < i1; ++idx)
+    {
+      for(idC = 0; idC < dim; ++idC)
+      {
+	double	p;
+
+	p = sPts[dim * perm[idx] + idC];
+	if(p < bMin[idC])
+	{
+	  bMin[idC] = p;
+	}
+	else if(p > bMax[idC])
+	{
+	  bMax[idC] = p;
+	}
+      }
+    }
+  }
+  for(idC = 0; idC < 3; ++idC)
+  {
+    cen[idC] = 0.5 * (bMin[idC] + bMax[idC]);
+    if((bMax[idC] - bMin[idC]) > (bMax[ax] - bMin[ax]))
+    {
+      ax = idC;
+    }
+  }
+  return(ax);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Partially sorts perm[i0] to perm[i1 - 1] so that the
+* 		point at index m is the one which would be there if
+* 		they were sorted by the given coordinate, with none
+* 		before it greater and none after it less.
+* \param	sPts			Points in their original order.
+* \param	dim			Dimension of the points.
+* \param	ax			Coordinate to sort by.
+* \param	perm			Permutation of the points.
+* \param	i0			First index.
+* \param	i1			One past the last index.
+* \param	m			Index to select.
+*/
+static void			WlzBasisFnTreeSelect(
+				  double *sPts,
+				  int dim,
+				  int ax,
+				  int *perm,
+				  int i0,
+				  int i1,
+				  int m)
+{
+  int		lo,
+  		hi,
+		i,
+		j,
+		t;
+  double	pv;
+
+  lo = i0;
+  hi = i1 - 1;
+  while(lo < hi)
+  {
+    pv = sPts[dim * perm[(lo + hi) / 2] + ax];
+    i = lo;
+    j = hi;
+    while(i <= j)
+    {
+      while(sPts[dim * perm[i] + ax] < pv)
+      {
+        ++i;
+      }
+      while(sPts[dim * perm[j] + ax] > pv)
+      {
+        --j;
+      }
+      if(i <= j)
+      {
+        t = perm[i];
+	perm[i] = perm[j];
+	perm[j] = t;
+	++i;
+	--j;
+      }
+    }
+    if(m <= j)
+    {
+      hi = j;
+    }
+    else if(m >= i)
+    {
+      lo = i;
+    }
+    else
+    {
+      break;
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Computes the radius and moments of a basis function tree
+* 		node from the tree's ordered control points and
+* 		coefficients.
+* \param	tree			The tree.
+* \param	idN			Index of the node.
+*/
+static void			WlzBasisFnTreeMoments(
+				  WlzBasisFnTree *tree,
+				  int idN)
+{
+  int		idx,
+  		idC,
+		idT,
+		idE,
+		dim;
+  double	r2Max = 0.0;
+  double	*mom;
+  WlzBasisFnTreeNode *nod;
+  double	yE[WLZ_BASISFN_TREE_ORDER + 1][3],
+  		r2J[WLZ_BASISFN_TREE_ORDER + 1];
+
+  dim = tree->dim;
+  nod = tree->nod + idN;
+  mom = tree->mom + dim * tree->nTerm * idN;
+  nod->wAbs = 0.0;
+  nod->wRadN = 0.0;
+  for(idT = 0; idT < dim * tree->nTerm; ++idT)
+  {
+    mom[idT] = 0.0;
+  }
+  yE[0][0] = yE[0][1] = yE[0][2] = 1.0;
+  yE[1][2] = 0.0;
+  for(idx = nod->idx[0]; idx < nod->idx[1]; ++idx)
+  {
+    double	r2 = 0.0,
+    		wMax = 0.0;
+    double	w[3];
+
+    for(idC = 0; idC < dim; ++idC)
+    {
+      yE[1][idC] = tree->pts[idC * tree->nPts + idx] - nod->cen[idC];
+      w[idC] = tree->wts[idC * tree->nPts + idx];
+      r2 += yE[1][idC] * yE[1][idC];
+      wMax = ALG_MAX(wMax, fabs(w[idC]));
+    }
+    /* Powers of the offset components divided by their factorials and
+     * powers of the squared offset. */
+    r2J[0] = 1.0;
+    r2J[1] = r2;
+    for(idE = 2; idE <= tree->order; ++idE)
+    {
+      for(idC = 0; idC < 3; ++idC)
+      {
+        yE[idE][idC] = yE[idE - 1][idC] * yE[1][idC] / idE;
+      }
+      r2J[idE] = r2J[idE - 1] * r2;
+    }
+    for(idT = 0; idT < tree->nTerm; ++idT)
+    {
+      int	*t;
+      double	m;
+
+      t = tree->trm + 4 * idT;
+      m = yE[t[0]][0] * yE[t[1]][1] * yE[t[2]][2] * r2J[t[3]];
+      for(idC = 0; idC < dim; ++idC)
+      {
+        mom[dim * idT + idC] += w[idC] * m;
+      }
+    }
+    nod->wAbs += wMax;
+    nod->wRadN += wMax * pow(sqrt(r2), tree->order + 1);
+    r2Max = ALG_MAX(r2Max, r2);
+  }
+  nod->rad = sqrt(r2Max);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Computes the minimum distance between a vertex and the
+* 		enclosing sphere of the given node at which the node's
+* 		expansion is within its share of the tolerance. Since
+* 		the remainder bound decreases with distance this is
+* 		found by bisection.
+* \param	tree			The tree.
+* \param	nod			The node, with its moments computed.
+* \param	tolW			Tolerance per unit absolute
+* 					coefficient.
+*/
+static void			WlzBasisFnTreeAccDist(
+				  WlzBasisFnTree *tree,
+				  WlzBasisFnTreeNode *nod,
+				  double tolW)
+{
+  int		itr;
+  double	tgt,
+  		lo = 0.0,
+		hi;
+
+  if((nod->wAbs <= 0.0) || (nod->wRadN <= 0.0))
+  {
+    nod->accDist = 0.0;
+  }
+  else
+  {
+    nod->accDist = DBL_MAX;
+    tgt = tolW * nod->wAbs / nod->wRadN;
+    if(tgt > 0.0)
+    {
+      hi = ALG_MAX(nod->rad, 1.0);
+      while((hi < 1.0e100) && (WlzBasisFnTreeBound(tree, hi * hi) > tgt))
+      {
+	hi *= 2.0;
+      }
+      if(hi < 1.0e100)
+      {
+	for(itr = 0; itr < 64; ++itr)
+	{
+	  double mid;
+
+	  mid = 0.5 * (lo + hi);
+	  if(WlzBasisFnTreeBound(tree, mid * mid) > tgt)
+	  {
+	    lo = mid;
+	  }
+	  else
+	  {
+	    hi = mid;
+	  }
+	}
+	nod->accDist = hi;
+      }
+    }
+  }
+}
+
+/*!
+* \return	Bound on the expansion remainder per unit coefficient.
+* \ingroup	WlzFunction
+* \brief	Computes an upper bound on
+* 		\f$|g^{(n)}(t)| / n!\f$, with \f$n\f$ one more than the
+* 		tree's expansion order, where
+* 		\f$g(t) = \phi(u(t))\f$ and \f$u(t)\f$ is the square of
+* 		the distance from the vertex to a point moving along a
+* 		straight line. Since \f$|u'| \leq 2 \sqrt{u}\f$,
+* 		\f$u'' = 2\f$ and all higher derivatives of \f$u\f$ are
+* 		zero, Faa di Bruno's formula gives
+* 		\f[
+* 		|g^{(n)}| \leq \sum_{j = 0}^{\lfloor n / 2 \rfloor}
+* 		\frac{n!}{j! (n - 2j)!} |\phi^{(n - j)}(u)|
+* 		(2 \sqrt{u})^{n - 2j}
+* 		\f]
+* 		which is then bounded for all \f$u \geq u_{lo}\f$.
+* 		The bound is non-increasing with \f$u_{lo}\f$ and is
+* 		DBL_MAX for Gaussian basis functions with a positive
+* 		parameter, since these grow with distance.
+* \param	tree			The tree.
+* \param	uLo			Minimum square of the distance.
+*/
+static double			WlzBasisFnTreeBound(
+				  WlzBasisFnTree *tree,
+				  double uLo)
+{
+  int		j,
+		k,
+  		n;
+  double	s,
+		t,
+		c,
+		phiK,
+		b = 0.0,
+		delta;
+
+  n = tree->order + 1;
+  delta = tree->delta;
+  if((tree->type == WLZ_FN_BASIS_2DGAUSS) && (delta > 0.0))
+  {
+    b = DBL_MAX;
+  }
+  else
+  {
+    for(j = 0; 2 * j <= n; ++j)
+    {
+      /* c = 2^(n - 2j) / (j! (n - 2j)!), the n! cancels. */
+      c = 1.0;
+      for(k = 2; k <= j; ++k)
+      {
+	c /= k;
+      }
+      for(k = 1; k <= n - (2 * j); ++k)
+      {
+	c *= 2.0 / k;
+      }
+      /* phiK is |phi^(n - j)| without its dependence on u, which
+       * together with u^(n / 2 - j) is bounded by s. */
+      k = n - j;
+      phiK = 1.0;
+      switch(tree->type)
+      {
+	case WLZ_FN_BASIS_2DGAUSS:
+	  /* |phi^(k)| = |delta|^k exp(delta u), delta <= 0 */
+	  for(; k > 0; --k)
+	  {
+	    phiK *= -delta;
+	  }
+	  t = (delta < 0.0)? ALG_MAX((0.5 * n - j) / -delta, uLo): uLo;
+	  s = exp(delta * t) * pow(t, 0.5 * n - j);
+	  break;
+	case WLZ_FN_BASIS_2DMQ: /* FALLTHROUGH */
+	case WLZ_FN_BASIS_3DMQ:
+	  /* |phi^(k)| = prod_{i < k} |1/2 - i| (u + delta)^(1/2 - k) */
+	  for(; k > 0; --k)
+	  {
+	    phiK *= fabs(1.5 - k);
+	  }
+	  s = pow(uLo + delta, 0.5 * (1 - n));
+	  break;
+	case WLZ_FN_BASIS_2DIMQ: /* FALLTHROUGH */
+	case WLZ_FN_BASIS_3DIMQ:
+	  /* |phi^(k)| = prod_{i < k} (1/2 + i) (u + delta)^(-1/2 - k) */
+	  for(; k > 0; --k)
+	  {
+	    phiK *= k - 0.5;
+	  }
+	  s = pow(uLo + delta, -0.5 * (1 + n));
+	  break;
+	case WLZ_FN_BASIS_2DTPS:
+	  /* |phi^(k)| = (k - 2)! u^(1 - k) / 2 for k >= 2 */
+	  for(k -= 2; k > 1; --k)
+	  {
+	    phiK *= k;
+	  }
+	  phiK *= 0.5;
+	  s = pow(uLo, 1.0 - (0.5 * n));
+	  break;
+	default:
+	  s = DBL_MAX;
+	  break;
+      }
+      b += c * phiK * s;
+    }
+  }
+  return(b);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Adds the radial basis function sums for a block of
+* 		vertices by traversing the tree, using the expansion of
+* 		each node that is far enough from all of the vertices,
+* 		summing the control points of leaf nodes that are not
+* 		and otherwise visiting the node's children.
+* \param	tree			The tree.
+* \param	n			Number of vertices in the block.
+* \param	bP			Vertex coordinates (the z coordinates
+* 					are zero in 2D).
+* \param	bV			Values to be added to.
+*/
+static void			WlzBasisFnTreeBlkEval(
+				  WlzBasisFnTree *tree,
+				  int n,
+				  double bP[3][WLZ_BASISFN_TREE_VTXBLKSZ],
+				  double bV[3][WLZ_BASISFN_TREE_VTXBLKSZ])
+{
+  int		idC,
+  		idQ,
+		nStk = 0;
+  double	bR2 = 0.0;
+  double	bMin[3],
+  		bMax[3],
+		bC[3];
+  int		stk[WLZ_BASISFN_TREE_MAXDEPTH];
+
+  /* Block centre and radius. */
+  for(idC = 0; idC < 3; ++idC)
+  {
+    bMin[idC] = bMax[idC] = bP[idC][0];
+    for(idQ = 1; idQ < n; ++idQ)
+    {
+      bMin[idC] = ALG_MIN(bMin[idC], bP[idC][idQ]);
+      bMax[idC] = ALG_MAX(bMax[idC], bP[idC][idQ]);
+    }
+    bC[idC] = 0.5 * (bMin[idC] + bMax[idC]);
+  }
+  for(idQ = 0; idQ < n; ++idQ)
+  {
+    double	r2 = 0.0;
+
+    for(idC = 0; idC < 3; ++idC)
+    {
+      double	t;
+
+      t = bP[idC][idQ] - bC[idC];
+      r2 += t * t;
+    }
+    bR2 = ALG_MAX(bR2, r2);
+  }
+  if(tree->nPts > 0)
+  {
+    stk[nStk++] = 0;
+  }
+  while(nStk > 0)
+  {
+    int		idN;
+    double	d2 = 0.0;
+    WlzBasisFnTreeNode *nod;
+
+    idN = stk[--nStk];
+    nod = tree->nod + idN;
+    if(nod->wAbs <= 0.0)
+    {
+      continue;
+    }
+    for(idC = 0; idC < 3; ++idC)
+    {
+      double	t;
+
+      t = bC[idC] - nod->cen[idC];
+      d2 += t * t;
+    }
+    if((sqrt(d2) - sqrt(bR2) - nod->rad) > nod->accDist)
+    {
+      WlzBasisFnTreeBlkExpand(tree, idN, n, bP, bV);
+    }
+    else if(nod->child[0] >= 0)
+    {
+      stk[nStk++] = nod->child[1];
+      stk[nStk++] = nod->child[0];
+    }
+    else
+    {
+      WlzBasisFnTreeBlkDirect(tree, nod, n, bP, bV);
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Adds the radial basis function sums of the control
+* 		points of the given node for a block of vertices, with
+* 		the vertices in the inner loops so that these may be
+* 		vectorised.
+* \param	tree			The tree.
+* \param	nod			The node.
+* \param	n			Number of vertices in the block.
+* \param	bP			Vertex coordinates.
+* \param	bV			Values to be added to.
+*/
+static void			WlzBasisFnTreeBlkDirect(
+				  WlzBasisFnTree *tree,
+				  WlzBasisFnTreeNode *nod,
+				  int n,
+				  double bP[3][WLZ_BASISFN_TREE_VTXBLKSZ],
+				  double bV[3][WLZ_BASISFN_TREE_VTXBLKSZ])
+{
+  int		idx,
+  		idQ,
+		nP;
+  double	delta;
+  double	*bX,
+  		*bY,
+		*bZ;
+  double	phi[WLZ_BASISFN_TREE_VTXBLKSZ];
+
+  nP = tree->nPts;
+  delta = tree->delta;
+  bX = bP[0];
+  bY = bP[1];
+  bZ = bP[2];
+  for(idx = nod->idx[0]; idx < nod->idx[1]; ++idx)
+  {
+    double	cX,
+    		cY,
+		cZ,
+		wX,
+		wY,
+		wZ;
+
+    cX = tree->pts[idx];
+    cY = tree->pts[nP + idx];
+    wX = tree->wts[idx];
+    wY = tree->wts[nP + idx];
+    if(tree->dim == 3)
+    {
+      cZ = tree->pts[(2 * nP) + idx];
+      wZ = tree->wts[(2 * nP) + idx];
+    }
+    else
+    {
+      cZ = wZ = 0.0;
+    }
+    switch(tree->type)
+    {
+      case WLZ_FN_BASIS_2DGAUSS:
+	for(idQ = 0; idQ < n; ++idQ)
+	{
+	  double u,
+	  	 tX,
+	  	 tY,
+		 tZ;
+
+	  tX = bX[idQ] - cX;
+	  tY = bY[idQ] - cY;
+	  tZ = bZ[idQ] - cZ;
+	  u = (tX * tX) + (tY * tY) + (tZ * tZ);
+	  phi[idQ] = (u > DBL_EPSILON)? exp(u * delta): 1.0;
+	}
+	break;
+      case WLZ_FN_BASIS_2DMQ: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DMQ:
+	for(idQ = 0; idQ < n; ++idQ)
+	{
+	  double u,
+	  	 tX,
+	  	 tY,
+		 tZ;
+
+	  tX = bX[idQ] - cX;
+	  tY = bY[idQ] - cY;
+	  tZ = bZ[idQ] - cZ;
+	  u = (tX * tX) + (tY * tY) + (tZ * tZ);
+	  phi[idQ] = sqrt(u + delta);
+	}
+	break;
+      case WLZ_FN_BASIS_2DIMQ: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DIMQ:
+	for(idQ = 0; idQ < n; ++idQ)
+	{
+	  double u,
+	  	 tX,
+	  	 tY,
+		 tZ;
+
+	  tX = bX[idQ] - cX;
+	  tY = bY[idQ] - cY;
+	  tZ = bZ[idQ] - cZ;
+	  u = (tX * tX) + (tY * tY) + (tZ * tZ);
+	  phi[idQ] = 1.0 / sqrt(u + delta);
+	}
+	break;
+      case WLZ_FN_BASIS_2DTPS:
+	for(idQ = 0; idQ < n; ++idQ)
+	{
+	  double u,
+	  	 tX,
+	  	 tY;
+
+	  tX = bX[idQ] - cX;
+	  tY = bY[idQ] - cY;
+	  u = (tX * tX) + (tY * tY);
+	  phi[idQ] = (u > DBL_EPSILON)? 0.5 * u * log(u): 0.0;
+	}
+	break;
+      default:
+	for(idQ = 0; idQ < n; ++idQ)
+	{
+	  phi[idQ] = 0.0;
+	}
+	break;
+    }
+    for(idQ = 0; idQ < n; ++idQ)
+    {
+      bV[0][idQ] += wX * phi[idQ];
+      bV[1][idQ] += wY * phi[idQ];
+      bV[2][idQ] += wZ * phi[idQ];
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Adds the expansion of the given node for a block of
+* 		vertices, with the vertices in the inner loops so that
+* 		these may be vectorised.
+* \param	tree			The tree.
+* \param	idN			Index of the node.
+* \param	n			Number of vertices in the block.
+* \param	bP			Vertex coordinates.
+* \param	bV			Values to be added to.
+*/
+static void			WlzBasisFnTreeBlkExpand(
+				  WlzBasisFnTree *tree,
+				  int idN,
+				  int n,
+				  double bP[3][WLZ_BASISFN_TREE_VTXBLKSZ],
+				  double bV[3][WLZ_BASISFN_TREE_VTXBLKSZ])
+{
+  int		idC,
+  		idK,
+		idQ,
+		idT,
+		dim;
+  double	delta;
+  double	*mom;
+  WlzBasisFnTreeNode *nod;
+  double	u[WLZ_BASISFN_TREE_VTXBLKSZ];
+  double	phi[WLZ_BASISFN_TREE_ORDER + 1][WLZ_BASISFN_TREE_VTXBLKSZ],
+  		vE[WLZ_BASISFN_TREE_ORDER + 1][3][WLZ_BASISFN_TREE_VTXBLKSZ];
+
+  dim = tree->dim;
+  delta = tree->delta;
+  nod = tree->nod + idN;
+  mom = tree->mom + dim * tree->nTerm * idN;
+  /* Powers of the vertex offsets from the centre. */
+  for(idQ = 0; idQ < n; ++idQ)
+  {
+    u[idQ] = 0.0;
+  }
+  for(idC = 0; idC < 3; ++idC)
+  {
+    double	c;
+
+    c = nod->cen[idC];
+    for(idQ = 0; idQ < n; ++idQ)
+    {
+      double	t;
+
+      t = bP[idC][idQ] - c;
+      vE[0][idC][idQ] = 1.0;
+      vE[1][idC][idQ] = t;
+      u[idQ] += t * t;
+    }
+    for(idK = 2; idK <= tree->order; ++idK)
+    {
+      for(idQ = 0; idQ < n; ++idQ)
+      {
+	vE[idK][idC][idQ] = vE[idK - 1][idC][idQ] * vE[1][idC][idQ];
+      }
+    }
+  }
+  /* Derivatives of the basis function with respect to the squared
+   * distance. */
+  switch(tree->type)
+  {
+    case WLZ_FN_BASIS_2DGAUSS:
+      for(idQ = 0; idQ < n; ++idQ)
+      {
+	phi[0][idQ] = (u[idQ] > DBL_EPSILON)? exp(u[idQ] * delta): 1.0;
+      }
+      for(idK = 1; idK <= tree->order; ++idK)
+      {
+	for(idQ = 0; idQ < n; ++idQ)
+	{
+	  phi[idK][idQ] = phi[idK - 1][idQ] * delta;
+	}
+      }
+      break;
+    case WLZ_FN_BASIS_2DMQ: /* FALLTHROUGH */
+    case WLZ_FN_BASIS_3DMQ:
+      for(idQ = 0; idQ < n; ++idQ)
+      {
+	double	t;
+
+	t = u[idQ] + delta;
+	phi[0][idQ] = sqrt(t);
+	u[idQ] = 1.0 / t;
+      }
+      for(idK = 1; idK <= tree->order; ++idK)
+      {
+	for(idQ = 0; idQ < n; ++idQ)
+	{
+	  phi[idK][idQ] = phi[idK - 1][idQ] * (1.5 - idK) * u[idQ];
+	}
+      }
+      break;
+    case WLZ_FN_BASIS_2DIMQ: /* FALLTHROUGH */
+    case WLZ_FN_BASIS_3DIMQ:
+      for(idQ = 0; idQ < n; ++idQ)
+      {
+	double	t;
+
+	t = u[idQ] + delta;
+	phi[0][idQ] = 1.0 / sqrt(t);
+	u[idQ] = 1.0 / t;
+      }
+      for(idK = 1; idK <= tree->order; ++idK)
+      {
+	for(idQ = 0; idQ < n; ++idQ)
+	{
+	  phi[idK][idQ] = phi[idK - 1][idQ] * (0.5 - idK) * u[idQ];
+	}
+      }
+      break;
+    case WLZ_FN_BASIS_2DTPS:
+      for(idQ = 0; idQ < n; ++idQ)
+      {
+	double	t;
+
+	t = log(u[idQ]);
+	phi[0][idQ] = 0.5 * u[idQ] * t;
+	phi[1][idQ] = 0.5 * (t + 1.0);
+	u[idQ] = 1.0 / u[idQ];
+	phi[2][idQ] = 0.5 * u[idQ];
+      }
+      for(idK = 3; idK <= tree->order; ++idK)
+      {
+	for(idQ = 0; idQ < n; ++idQ)
+	{
+	  phi[idK][idQ] = phi[idK - 1][idQ] * (2 - idK) * u[idQ];
+	}
+      }
+      break;
+    default:
+      for(idK = 0; idK <= tree->order; ++idK)
+      {
+	for(idQ = 0; idQ < n; ++idQ)
+	{
+	  phi[idK][idQ] = 0.0;
+	}
+      }
+      break;
+  }
+  /* Sum the terms of the expansion. */
+  for(idT = 0; idT < tree->nTerm; ++idT)
+  {
+    int		*t;
+    double	k,
+    		mX,
+		mY,
+		mZ;
+    double	*p,
+    		*eX,
+		*eY,
+		*eZ;
+
+    t = tree->trm + 4 * idT;
+    k = tree->trmK[idT];
+    p = phi[t[0] + t[1] + t[2] + t[3]];
+    eX = vE[t[0]][0];
+    eY = vE[t[1]][1];
+    eZ = vE[t[2]][2];
+    mX = mom[dim * idT];
+    mY = mom[dim * idT + 1];
+    mZ = (dim == 3)? mom[dim * idT + 2]: 0.0;
+    for(idQ = 0; idQ < n; ++idQ)
+    {
+      double	c;
+
+      c = k * p[idQ] * eX[idQ] * eY[idQ] * eZ[idQ];
+      bV[0][idQ] += c * mX;
+      bV[1][idQ] += c * mY;
+      bV[2][idQ] += c * mZ;
+    }
+  }
+}
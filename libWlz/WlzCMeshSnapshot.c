@@ -0,0 +1,507 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzCMeshSnapshot_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzCMeshSnapshot.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Compact snapshots of conforming meshes in which the
+* 		node positions, element nodes and node adjacency are
+* 		held in contiguous arrays.
+* \ingroup	WlzMesh
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <Wlz.h>
+
+static WlzErrorNum		WlzCMeshSnapshotNod2D(
+				  WlzCMeshSnapshot *snap,
+				  WlzCMesh2D *mesh);
+static WlzErrorNum		WlzCMeshSnapshotNod3D(
+				  WlzCMeshSnapshot *snap,
+				  WlzCMesh3D *mesh);
+static void			WlzCMeshSnapshotElm2D(
+				  WlzCMeshSnapshot *snap,
+				  WlzCMesh2D *mesh);
+static void			WlzCMeshSnapshotElm3D(
+				  WlzCMeshSnapshot *snap,
+				  WlzCMesh3D *mesh);
+
+/*!
+* \return	New mesh snapshot or NULL on error.
+* \ingroup	WlzMesh
+* \brief	Makes a compact read-only snapshot of the given 2D or
+* 		3D conforming mesh. The snapshot holds the node
+* 		positions in separate contiguous coordinate arrays, the
+* 		nodes of each element as node indices and the node
+* 		adjacency in compressed sparse row form, so that node
+* 		and element loops need not chase pointers through the
+* 		mesh. All entities keep their mesh indices, with
+* 		deleted entities marked as invalid.
+*
+* 		The neighbours of node \f$i\f$ are
+* 		\f$nbr[nbrOff[i]], \ldots, nbr[nbrOff[i + 1] - 1]\f$ and
+* 		are in the order of the edge uses directed from the
+* 		node, with one entry for each edge use. Neighbours
+* 		connected by edges shared by several 3D faces will
+* 		appear more than once.
+*
+* 		The snapshot is not updated if the mesh is modified.
+* 		Positions computed in the snapshot may be copied back
+* 		to the mesh using WlzCMeshSnapshotSetNodPos().
+* \param	mesh			Given mesh.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzCMeshSnapshot *WlzCMeshSnapshotMake(WlzCMeshP mesh, WlzErrorNum *dstErr)
+{
+  int		dim = 0;
+  WlzCMeshEntRes *nRes = NULL,
+  		*eRes = NULL;
+  WlzCMeshSnapshot *snap = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(mesh.v == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else
+  {
+    switch(mesh.m2->type)
+    {
+      case WLZ_CMESH_2D:
+        dim = 2;
+	nRes = &(mesh.m2->res.nod);
+	eRes = &(mesh.m2->res.elm);
+	break;
+      case WLZ_CMESH_3D:
+        dim = 3;
+	nRes = &(mesh.m3->res.nod);
+	eRes = &(mesh.m3->res.elm);
+	break;
+      default:
+        errNum = WLZ_ERR_DOMAIN_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((snap = (WlzCMeshSnapshot *)
+               AlcCalloc(1, sizeof(WlzCMeshSnapshot))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      snap->type = (WlzObjectType )(mesh.m2->type);
+      snap->nNod = nRes->maxEnt;
+      snap->nElm = eRes->maxEnt;
+      snap->nElmNod = dim + 1;
+      if(((snap->pos[0] = (double *)
+                          AlcMalloc(sizeof(double) * dim *
+			            (snap->nNod + 1))) == NULL) ||
+	 ((snap->nodFlags = (unsigned int *)
+	                    AlcMalloc(sizeof(unsigned int) *
+			              (snap->nNod + 1))) == NULL) ||
+	 ((snap->nodValid = (WlzUByte *)
+	                    AlcMalloc(sizeof(WlzUByte) *
+			              (snap->nNod + 1))) == NULL) ||
+	 ((snap->nbrOff = (int *)
+	                  AlcMalloc(sizeof(int) *
+			            (snap->nNod + 1))) == NULL) ||
+	 ((snap->elmNod = (int *)
+	                  AlcMalloc(sizeof(int) * snap->nElmNod *
+			            (snap->nElm + 1))) == NULL))
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+        snap->pos[1] = snap->pos[0] + snap->nNod;
+	if(dim == 3)
+	{
+	  snap->pos[2] = snap->pos[1] + snap->nNod;
+	}
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(dim == 2)
+    {
+      errNum = WlzCMeshSnapshotNod2D(snap, mesh.m2);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        WlzCMeshSnapshotElm2D(snap, mesh.m2);
+      }
+    }
+    else
+    {
+      errNum = WlzCMeshSnapshotNod3D(snap, mesh.m3);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        WlzCMeshSnapshotElm3D(snap, mesh.m3);
+      }
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzCMeshSnapshotFree(snap);
+    snap = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(snap);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Frees the given mesh snapshot.
+* \param	snap			Given mesh snapshot, may be NULL.
+*/
+WlzErrorNum	WlzCMeshSnapshotFree(WlzCMeshSnapshot *snap)
+{
+  if(snap)
+  {
+    AlcFree(snap->pos[0]);
+    AlcFree(snap->nodFlags);
+    AlcFree(snap->nodValid);
+    AlcFree(snap->nbrOff);
+    AlcFree(snap->nbr);
+    AlcFree(snap->elmNod);
+    AlcFree(snap);
+  }
+  return(WLZ_ERR_NONE);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Sets the positions of all valid nodes of the given mesh
+* 		from those of the snapshot. The snapshot must have been
+* 		made from the mesh and the mesh must not have had nodes
+* 		added or deleted since. As with WlzCMeshSetVertices()
+* 		the mesh will still need to have it's bounding box,
+* 		maximum edge length and grid cells updated.
+* \param	mesh			Given mesh.
+* \param	snap			Snapshot of the mesh.
+*/
+WlzErrorNum	WlzCMeshSnapshotSetNodPos(WlzCMeshP mesh,
+					  WlzCMeshSnapshot *snap)
+{
+  int		idN;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(mesh.v == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(snap == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(mesh.m2->type != snap->type)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else
+  {
+    switch(snap->type)
+    {
+      case WLZ_CMESH_2D:
+	if(mesh.m2->res.nod.maxEnt != snap->nNod)
+	{
+	  errNum = WLZ_ERR_DOMAIN_DATA;
+	}
+	else
+	{
+	  for(idN = 0; idN < snap->nNod; ++idN)
+	  {
+	    if(snap->nodValid[idN])
+	    {
+	      WlzCMeshNod2D *nod;
+
+	      nod = (WlzCMeshNod2D *)
+	            AlcVectorItemGet(mesh.m2->res.nod.vec, idN);
+	      nod->pos.vtX = snap->pos[0][idN];
+	      nod->pos.vtY = snap->pos[1][idN];
+	    }
+	  }
+	}
+        break;
+      case WLZ_CMESH_3D:
+	if(mesh.m3->res.nod.maxEnt != snap->nNod)
+	{
+	  errNum = WLZ_ERR_DOMAIN_DATA;
+	}
+	else
+	{
+	  for(idN = 0; idN < snap->nNod; ++idN)
+	  {
+	    if(snap->nodValid[idN])
+	    {
+	      WlzCMeshNod3D *nod;
+
+	      nod = (WlzCMeshNod3D *)
+	            AlcVectorItemGet(mesh.m3->res.nod.vec, idN);
+	      nod->pos.vtX = snap->pos[0][idN];
+	      nod->pos.vtY = snap->pos[1][idN];
+	      nod->pos.vtZ = snap->pos[2][idN];
+	    }
+	  }
+	}
+        break;
+      default:
+        errNum = WLZ_ERR_DOMAIN_TYPE;
+	break;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Fills in the node positions, flags and adjacency of a
+* 		snapshot of a 2D mesh. The node arrays of the snapshot
+* 		must have been allocated.
+* \param	snap			Snapshot being made.
+* \param	mesh			Given mesh.
+*/
+static WlzErrorNum WlzCMeshSnapshotNod2D(WlzCMeshSnapshot *snap,
+                                         WlzCMesh2D *mesh)
+{
+  int		idN,
+  		nNbr = 0;
+  WlzCMeshNod2D	*nod;
+  WlzCMeshEdgU2D *edu0,
+  		*edu1;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  /* Copy the node positions and flags and count the neighbours. */
+  for(idN = 0; idN < snap->nNod; ++idN)
+  {
+    snap->nbrOff[idN] = nNbr;
+    nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+    if(nod && (nod->idx >= 0))
+    {
+      snap->nodValid[idN] = 1;
+      snap->nodFlags[idN] = nod->flags;
+      snap->pos[0][idN] = nod->pos.vtX;
+      snap->pos[1][idN] = nod->pos.vtY;
+      if((edu0 = edu1 = nod->edu) != NULL)
+      {
+	do
+	{
+	  ++nNbr;
+	  edu1 = edu1->nnxt;
+	} while(edu0 != edu1);
+      }
+    }
+    else
+    {
+      snap->nodValid[idN] = 0;
+      snap->nodFlags[idN] = WLZ_CMESH_NOD_FLAG_NONE;
+      snap->pos[0][idN] = snap->pos[1][idN] = 0.0;
+    }
+  }
+  snap->nbrOff[snap->nNod] = nNbr;
+  /* Fill in the neighbours. */
+  if((snap->nbr = (int *)AlcMalloc(sizeof(int) * (nNbr + 1))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    nNbr = 0;
+    for(idN = 0; idN < snap->nNod; ++idN)
+    {
+      if(snap->nodValid[idN])
+      {
+	nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+	if((edu0 = edu1 = nod->edu) != NULL)
+	{
+	  do
+	  {
+	    snap->nbr[nNbr++] = edu1->next->nod->idx;
+	    edu1 = edu1->nnxt;
+	  } while(edu0 != edu1);
+	}
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Fills in the node positions, flags and adjacency of a
+* 		snapshot of a 3D mesh. The node arrays of the snapshot
+* 		must have been allocated.
+* \param	snap			Snapshot being made.
+* \param	mesh			Given mesh.
+*/
+static WlzErrorNum WlzCMeshSnapshotNod3D(WlzCMeshSnapshot *snap,
+                                         WlzCMesh3D *mesh)
+{
+  int		idN,
+  		nNbr = 0;
+  WlzCMeshNod3D	*nod;
+  WlzCMeshEdgU3D *edu0,
+  		*edu1;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  /* Copy the node positions and flags and count the neighbours. */
+  for(idN = 0; idN < snap->nNod; ++idN)
+  {
+    snap->nbrOff[idN] = nNbr;
+    nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+    if(nod && (nod->idx >= 0))
+    {
+      snap->nodValid[idN] = 1;
+      snap->nodFlags[idN] = nod->flags;
+      snap->pos[0][idN] = nod->pos.vtX;
+      snap->pos[1][idN] = nod->pos.vtY;
+      snap->pos[2][idN] = nod->pos.vtZ;
+      if((edu0 = edu1 = nod->edu) != NULL)
+      {
+	do
+	{
+	  ++nNbr;
+	  edu1 = edu1->nnxt;
+	} while(edu0 != edu1);
+      }
+    }
+    else
+    {
+      snap->nodValid[idN] = 0;
+      snap->nodFlags[idN] = WLZ_CMESH_NOD_FLAG_NONE;
+      snap->pos[0][idN] = snap->pos[1][idN] = snap->pos[2][idN] = 0.0;
+    }
+  }
+  snap->nbrOff[snap->nNod] = nNbr;
+  /* Fill in the neighbours. */
+  if((snap->nbr = (int *)AlcMalloc(sizeof(int) * (nNbr + 1))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    nNbr = 0;
+    for(idN = 0; idN < snap->nNod; ++idN)
+    {
+      if(snap->nodValid[idN])
+      {
+	nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+	if((edu0 = edu1 = nod->edu) != NULL)
+	{
+	  do
+	  {
+	    snap->nbr[nNbr++] = edu1->next->nod->idx;
+	    edu1 = edu1->nnxt;
+	  } while(edu0 != edu1);
+	}
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzMesh
+* \brief	Fills in the element node indices of a snapshot of a
+* 		2D mesh. Deleted elements have all their node indices
+* 		set to -1.
+* \param	snap			Snapshot being made.
+* \param	mesh			Given mesh.
+*/
+static void WlzCMeshSnapshotElm2D(WlzCMeshSnapshot *snap,
+                                  WlzCMesh2D *mesh)
+{
+  int		idE;
+  int		*eN;
+  WlzCMeshElm2D	*elm;
+
+  for(idE = 0; idE < snap->nElm; ++idE)
+  {
+    eN = snap->elmNod + (3 * idE);
+    elm = (WlzCMeshElm2D *)AlcVectorItemGet(mesh->res.elm.vec, idE);
+    if(elm && (elm->idx >= 0))
+    {
+      eN[0] = WLZ_CMESH_ELM2D_GET_NODE_0(elm)->idx;
+      eN[1] = WLZ_CMESH_ELM2D_GET_NODE_1(elm)->idx;
+      eN[2] = WLZ_CMESH_ELM2D_GET_NODE_2(elm)->idx;
+    }
+    else
+    {
+      eN[0] = eN[1] = eN[2] = -1;
+    }
+  }
+}
+
+/*!
+* \ingroup	WlzMesh
+* \brief	Fills in the element node indices of a snapshot of a
+* 		3D mesh. Deleted elements have all their node indices
+* 		set to -1.
+* \param	snap			Snapshot being made.
+* \param	mesh			Given mesh.
+*/
+static void WlzCMeshSnapshotElm3D(WlzCMeshSnapshot *snap,
+                                  WlzCMesh3D *mesh)
+{
+  int		idE;
+  int		*eN;
+  WlzCMeshElm3D	*elm;
+
+  for(idE = 0; idE < snap->nElm; ++idE)
+  {
+    eN = snap->elmNod + (4 * idE);
+    elm = (WlzCMeshElm3D *)AlcVectorItemGet(mesh->res.elm.vec, idE);
+    if(elm && (elm->idx >= 0))
+    {
+      eN[0] = WLZ_CMESH_ELM3D_GET_NODE_0(elm)->idx;
+      eN[1] = WLZ_CMESH_ELM3D_GET_NODE_1(elm)->idx;
+      eN[2] = WLZ_CMESH_ELM3D_GET_NODE_2(elm)->idx;
+      eN[3] = WLZ_CMESH_ELM3D_GET_NODE_3(elm)->idx;
+    }
+    else
+    {
+      eN[0] = eN[1] = eN[2] = eN[3] = -1;
+    }
+  }
+}
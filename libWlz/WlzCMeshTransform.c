@@ -1475,6 +1475,9 @@ WlzErrorNum	WlzCMeshTransformVtxAry2D5(WlzObject *mObj,
 *		transform. If a vertex is outside the mest it is
 *		displaced using the displacement of the closest node
 *		in the mesh.
+*		The vertex array is transformed in parallel, in blocks
+*		of consecutive vertices so that each block can make use
+*		of the walk search from the previous enclosing element.
 * \param	mObj			The mesh transform object.
 * \param	nVtx			Number of vertices in the array.
 * \param	vtx			Array of vertices.
@@ -1482,51 +1485,80 @@ WlzErrorNum	WlzCMeshTransformVtxAry2D5(WlzObject *mObj,
 WlzErrorNum	WlzCMeshTransformVtxAry3D(WlzObject *mObj,
 					 int nVtx, WlzDVertex3 *vtx)
 {
-  int		idN,
-		nearNod,
-  		lastElmIdx;
-  double	*dsp;
-  WlzDVertex3	tVtx;
+  int		idB,
+  		nBlk;
   WlzCMesh3D	*mesh;
   WlzIndexedValues *ixv;
-  WlzCMeshScanElm3D sE;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const int	blkSz = 1024;
   
-  nearNod = -1;
-  lastElmIdx = -1;
   mesh = mObj->domain.cm3;
   ixv = mObj->values.x;
-  for(idN = 0; idN < nVtx; ++idN)
+  nBlk = (nVtx + blkSz - 1) / blkSz;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if(nBlk > 1)
+#endif
+  for(idB = 0; idB < nBlk; ++idB)
   {
-    if(((sE.idx = WlzCMeshElmEnclosingPos3D(mesh, lastElmIdx,
-    			vtx[idN].vtX, vtx[idN].vtY, vtx[idN].vtZ,
-			0, &nearNod)) < 0) && (nearNod < 0))
-    {
-      errNum = WLZ_ERR_DOMAIN_DATA;
-      break;
-    }
-    if(sE.idx > 0)
-    {
-      if((sE.idx != lastElmIdx) || ((sE.flags & WLZ_CMESH_SCANELM_FWD) == 0))
+    int		idN,
+    		lastIdN,
+		nearNod,
+  		lastElmIdx;
+    double	*dsp;
+    WlzDVertex3	tVtx;
+    WlzCMeshScanElm3D sE;
+    WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+
+    nearNod = -1;
+    lastElmIdx = -1;
+    lastIdN = ALG_MIN((idB + 1) * blkSz, nVtx);
+    for(idN = idB * blkSz; idN < lastIdN; ++idN)
+    {
+      if(((sE.idx = WlzCMeshElmEnclosingPos3D(mesh, lastElmIdx,
+			  vtx[idN].vtX, vtx[idN].vtY, vtx[idN].vtZ,
+			  0, &nearNod)) < 0) && (nearNod < 0))
       {
-	WlzCMeshUpdateScanElm3D(mObj, &sE, 1);
-	lastElmIdx = sE.idx;
+	errNum2 = WLZ_ERR_DOMAIN_DATA;
+	break;
       }
-      tVtx.vtX = (sE.tr[ 0] * vtx[idN].vtX) + (sE.tr[ 1] * vtx[idN].vtY) +
-		 (sE.tr[ 2] * vtx[idN].vtZ) +  sE.tr[ 3];
-      tVtx.vtY = (sE.tr[ 4] * vtx[idN].vtX) + (sE.tr[ 5] * vtx[idN].vtY) +
-		 (sE.tr[ 6] * vtx[idN].vtZ) +  sE.tr[ 7];
-      tVtx.vtZ = (sE.tr[ 8] * vtx[idN].vtX) + (sE.tr[ 9] * vtx[idN].vtY) +
-		 (sE.tr[10] * vtx[idN].vtZ) +  sE.tr[11];
+      if(sE.idx > 0)
+      {
+	if((sE.idx != lastElmIdx) ||
+	   ((sE.flags & WLZ_CMESH_SCANELM_FWD) == 0))
+	{
+	  WlzCMeshUpdateScanElm3D(mObj, &sE, 1);
+	  lastElmIdx = sE.idx;
+	}
+	tVtx.vtX = (sE.tr[ 0] * vtx[idN].vtX) + (sE.tr[ 1] * vtx[idN].vtY) +
+		   (sE.tr[ 2] * vtx[idN].vtZ) +  sE.tr[ 3];
+	tVtx.vtY = (sE.tr[ 4] * vtx[idN].vtX) + (sE.tr[ 5] * vtx[idN].vtY) +
+		   (sE.tr[ 6] * vtx[idN].vtZ) +  sE.tr[ 7];
+	tVtx.vtZ = (sE.tr[ 8] * vtx[idN].vtX) + (sE.tr[ 9] * vtx[idN].vtY) +
+		   (sE.tr[10] * vtx[idN].vtZ) +  sE.tr[11];
+      }
+      else
+      {
+	dsp = (double *)WlzIndexedValueGet(ixv, nearNod);
+	tVtx.vtX = vtx[idN].vtX + dsp[0];
+	tVtx.vtY = vtx[idN].vtY + dsp[1];
+	tVtx.vtZ = vtx[idN].vtZ + dsp[2];
+      }
+      vtx[idN] = tVtx;
     }
-    else
+    if(errNum2 != WLZ_ERR_NONE)
     {
-      dsp = (double *)WlzIndexedValueGet(ixv, nearNod);
-      tVtx.vtX = vtx[idN].vtX + dsp[0];
-      tVtx.vtY = vtx[idN].vtY + dsp[1];
-      tVtx.vtZ = vtx[idN].vtZ + dsp[2];
+#ifdef _OPENMP
+#pragma omp critical
+      {
+#endif
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  errNum = errNum2;
+	}
+#ifdef _OPENMP
+      }
+#endif
     }
-    vtx[idN] = tVtx;
   }
   return(errNum);
 }
@@ -1574,48 +1574,53 @@ WlzErrorNum	WlzCMeshLaplacianSmooth2D(WlzCMesh2D *mesh,
 {
   int		idI,
   		idN,
+		idM,
   		nCnt;
+  double	*pX,
+  		*pY;
   WlzDVertex2	nPos;
-  WlzCMeshNod2D *nod,
-  		*oNod;
-  WlzCMeshEdgU2D *edu0,
-  		*edu1;
+  WlzCMeshP	meshP;
+  WlzCMeshSnapshot *snap = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   if(mesh && (mesh->type == WLZ_CMESH_2D))
   {
-    for(idI = 0; idI < itr; ++idI)
+    /* Smooth using a compact snapshot of the mesh. The nodes are still
+     * visited in index order, with each node using the already updated
+     * positions of any lower index neighbours. */
+    meshP.m2 = mesh;
+    snap = WlzCMeshSnapshotMake(meshP, &errNum);
+    if(errNum == WLZ_ERR_NONE)
     {
-      for(idN = 0; idN < mesh->res.nod.maxEnt; ++idN)
+      pX = snap->pos[0];
+      pY = snap->pos[1];
+      for(idI = 0; idI < itr; ++idI)
       {
-	nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	if(nod->idx >= 0)
+	for(idN = 0; idN < snap->nNod; ++idN)
 	{
-          if(doBnd || ((nod->flags & WLZ_CMESH_NOD_FLAG_BOUNDARY) == 0))
+	  if(snap->nodValid[idN] &&
+	     (doBnd ||
+	      ((snap->nodFlags[idN] & WLZ_CMESH_NOD_FLAG_BOUNDARY) == 0)))
 	  {
-	    nCnt = 0;
 	    nPos.vtX = nPos.vtY = 0.0;
-	    edu0 = edu1 = nod->edu;
-	    do
+	    for(idM = snap->nbrOff[idN]; idM < snap->nbrOff[idN + 1]; ++idM)
 	    {
-	      oNod = edu1->next->nod;
-	      nPos.vtX += oNod->pos.vtX;
-	      nPos.vtY += oNod->pos.vtY;
-	      ++nCnt;
-	      edu1 = edu1->nnxt;
-	    } while(edu0 != edu1);
+	      nPos.vtX += pX[snap->nbr[idM]];
+	      nPos.vtY += pY[snap->nbr[idM]];
+	    }
+	    nCnt = snap->nbrOff[idN + 1] - snap->nbrOff[idN];
 	    if(nCnt > 0)
 	    {
-	      nod->pos.vtX = (1.0 - alpha) * nod->pos.vtX + 
-			     alpha * nPos.vtX / nCnt;
-	      nod->pos.vtY = (1.0 - alpha) * nod->pos.vtY + 
-			     alpha * nPos.vtY / nCnt;
+	      pX[idN] = (1.0 - alpha) * pX[idN] + alpha * nPos.vtX / nCnt;
+	      pY[idN] = (1.0 - alpha) * pY[idN] + alpha * nPos.vtY / nCnt;
 	    }
 	  }
 	}
       }
+      errNum = WlzCMeshSnapshotSetNodPos(meshP, snap);
+      (void )WlzCMeshSnapshotFree(snap);
     }
-    if(update)
+    if((errNum == WLZ_ERR_NONE) && update)
     {
       WlzCMeshUpdateBBox2D(mesh);
       WlzCMeshUpdateMaxSqEdgLen2D(mesh);
@@ -1645,51 +1650,56 @@ WlzErrorNum	WlzCMeshLaplacianSmooth3D(WlzCMesh3D *mesh,
 {
   int		idI,
   		idN,
+		idM,
   		nCnt;
+  double	*pX,
+  		*pY,
+		*pZ;
   WlzDVertex3	nPos;
-  WlzCMeshNod3D *nod,
-  		*oNod;
-  WlzCMeshEdgU3D *edu0,
-  		*edu1;
+  WlzCMeshP	meshP;
+  WlzCMeshSnapshot *snap = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   if(mesh && (mesh->type == WLZ_CMESH_3D))
   {
-    for(idI = 0; idI < itr; ++idI)
+    /* As for WlzCMeshLaplacianSmooth2D() the nodes are visited in index
+     * order using a compact snapshot of the mesh. */
+    meshP.m3 = mesh;
+    snap = WlzCMeshSnapshotMake(meshP, &errNum);
+    if(errNum == WLZ_ERR_NONE)
     {
-      for(idN = 0; idN < mesh->res.nod.maxEnt; ++idN)
+      pX = snap->pos[0];
+      pY = snap->pos[1];
+      pZ = snap->pos[2];
+      for(idI = 0; idI < itr; ++idI)
       {
-	nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	if(nod->idx >= 0)
+	for(idN = 0; idN < snap->nNod; ++idN)
 	{
-          if(doBnd || ((nod->flags & WLZ_CMESH_NOD_FLAG_BOUNDARY) == 0))
+	  if(snap->nodValid[idN] &&
+	     (doBnd ||
+	      ((snap->nodFlags[idN] & WLZ_CMESH_NOD_FLAG_BOUNDARY) == 0)))
 	  {
-	    nCnt = 0;
 	    nPos.vtX = nPos.vtY = nPos.vtZ = 0.0;
-	    edu0 = edu1 = nod->edu;
-	    do
+	    for(idM = snap->nbrOff[idN]; idM < snap->nbrOff[idN + 1]; ++idM)
 	    {
-	      oNod = edu1->next->nod;
-	      nPos.vtX += oNod->pos.vtX;
-	      nPos.vtY += oNod->pos.vtY;
-	      nPos.vtZ += oNod->pos.vtZ;
-	      ++nCnt;
-	      edu1 = edu1->nnxt;
-	    } while(edu0 != edu1);
+	      nPos.vtX += pX[snap->nbr[idM]];
+	      nPos.vtY += pY[snap->nbr[idM]];
+	      nPos.vtZ += pZ[snap->nbr[idM]];
+	    }
+	    nCnt = snap->nbrOff[idN + 1] - snap->nbrOff[idN];
 	    if(nCnt > 0)
 	    {
-	      nod->pos.vtX = (1.0 - alpha) * nod->pos.vtX + 
-			     alpha * nPos.vtX / nCnt;
-	      nod->pos.vtY = (1.0 - alpha) * nod->pos.vtY + 
-			     alpha * nPos.vtY / nCnt;
-	      nod->pos.vtZ = (1.0 - alpha) * nod->pos.vtZ + 
-			     alpha * nPos.vtZ / nCnt;
+	      pX[idN] = (1.0 - alpha) * pX[idN] + alpha * nPos.vtX / nCnt;
+	      pY[idN] = (1.0 - alpha) * pY[idN] + alpha * nPos.vtY / nCnt;
+	      pZ[idN] = (1.0 - alpha) * pZ[idN] + alpha * nPos.vtZ / nCnt;
 	    }
 	  }
 	}
       }
+      errNum = WlzCMeshSnapshotSetNodPos(meshP, snap);
+      (void )WlzCMeshSnapshotFree(snap);
     }
-    if(update)
+    if((errNum == WLZ_ERR_NONE) && update)
     {
       WlzCMeshUpdateBBox3D(mesh);
       WlzCMeshUpdateMaxSqEdgLen3D(mesh);
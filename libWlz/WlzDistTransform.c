@@ -44,17 +44,67 @@ static char _WlzDistTransform_c[] = "University of Edinburgh $Id$";
 #include <stdio.h>
 #include <stdlib.h>
 #include <float.h>
+#include <math.h>
 #include <Wlz.h>
 
+/*!
+* \struct	_WlzDistEuclideanWSp
+* \brief	Workspace for the exact Euclidean distance transform,
+* 		which is computed in slabs of columns of the bounding
+* 		box of the foreground and reference objects.
+* 		Typedef: ::WlzDistEuclideanWSp
+*/
+typedef struct _WlzDistEuclideanWSp
+{
+  int		x0;			/*!< First column of the slab. */
+  int		nX;			/*!< Number of columns in the slab. */
+  WlzIBox3	bBox;			/*!< Bounding box of both objects. */
+  WlzIVertex3	sz;			/*!< Size of the bounding box. */
+  double	vSz[3];			/*!< Voxel size. */
+  double	dMax;			/*!< Maximum distance, distances are
+  					     clamped if it is greater than
+					     zero. */
+  float		*dSq;			/*!< Squared distances within the
+  					     slab, for each line of each
+					     plane of the bounding box. */
+} WlzDistEuclideanWSp;
+
+static void			WlzDistEuclideanLine(
+				  float *ln,
+				  int n,
+				  int lft,
+				  int rgt,
+				  double s);
+static void			WlzDistEuclidean1D(
+				  float *f,
+				  float *d,
+				  int *v,
+				  double *z,
+				  int n,
+				  double s);
 static WlzObject 		*WlzDistSample(
 				  WlzObject *obj,
 				  int dim,
 				  double scale,
     			          WlzErrorNum *dstErr);
+static WlzObject 		*WlzDistEuclidean(
+				  WlzObject *forObj,
+				  WlzObject *refObj,
+				  double dMax,
+    			          WlzErrorNum *dstErr);
+static WlzErrorNum		WlzDistEuclideanRefPart(
+				  WlzObject *refObj,
+				  WlzIntervalScanPart *part,
+				  WlzDistEuclideanWSp *wSp);
+static WlzErrorNum		WlzDistEuclideanDstPart(
+				  WlzObject *dstObj,
+				  WlzIntervalScanPart *part,
+				  WlzDistEuclideanWSp *wSp);
 
 /*!
 * \return	Distance object which shares the given foreground object's
-*		domain and has integer distance values, null on error.
+*		domain and has integer (float for WLZ_EUCLIDEAN_DISTANCE)
+*		distance values, null on error.
 * \ingroup	WlzMorphologyOps
 * \brief	Computes the distance of every pixel/voxel in the foreground
 * 		object from the reference object.
@@ -90,6 +140,20 @@ static WlzObject 		*WlzDistSample(
 * 		reference domain using a sphere with a radius having the same
 * 		value as the scale parameter and then finaly sampling the
 * 		scaled distances.
+*
+*		An exact Euclidean distance transform may be computed using
+*		WLZ_EUCLIDEAN_DISTANCE. This uses separable passes along
+*		the lines, columns and planes of the objects' bounding box
+*		in which each pass computes the lower envelope of parabolas.
+*		See: P. Felzenszwalb and D. Huttenlocher. "Distance
+*		Transforms of Sampled Functions" Theory of Computing
+*		8:415-428, 2012. The run time is linear in the bounding box
+*		volume and independent of the distances. Unlike the other
+*		distance functions the distances are not constrained to
+*		paths within the foreground domain, the voxel size of 3D
+*		objects is respected, the distance values are floating
+*		point and distances greater than the given maximum
+*		distance are clamped to the maximum.
 * \param	forObj			Foreground object.
 * \param	refObj			Reference object.
 * \param	dFn			Distance function which must be
@@ -214,6 +278,7 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
 	  case WLZ_4_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_8_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_OCTAGONAL_DISTANCE: /* FALLTHROUGH */
+	  case WLZ_EUCLIDEAN_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_APX_EUCLIDEAN_DISTANCE:
 	    dim = 2;
 	    break;
@@ -229,6 +294,7 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
 	  case WLZ_18_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_26_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_OCTAGONAL_DISTANCE: /* FALLTHROUGH */
+	  case WLZ_EUCLIDEAN_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_APX_EUCLIDEAN_DISTANCE:
 	    dim = 3;
 	    break;
@@ -272,13 +338,36 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
 	}
 	break;
       case WLZ_EUCLIDEAN_DISTANCE:
-	errNum = WLZ_ERR_UNIMPLEMENTED;
+        con = (dim == 2)? WLZ_8_CONNECTED: WLZ_26_CONNECTED;
 	break;
       default:
         errNum = WLZ_ERR_PARAM_DATA;
 	break;
     }
   }
+  /* The exact Euclidean distance transform does not use dilation. */
+  if((errNum == WLZ_ERR_NONE) && (dFn == WLZ_EUCLIDEAN_DISTANCE))
+  {
+    if(refObj->type == WLZ_POINTS)
+    {
+      sRefObj = WlzAssignObject(
+                WlzPointsToDomObj(refObj->domain.pts, 1.0, &errNum), NULL);
+    }
+    else
+    {
+      sRefObj = WlzAssignObject(refObj, NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      dstObj = WlzDistEuclidean(forObj, sRefObj, dMax, &errNum);
+    }
+    (void )WlzFreeObj(sRefObj);
+    if(dstErr)
+    {
+      *dstErr = errNum;
+    }
+    return(dstObj);
+  }
   /* Create scaled domains and a sphere domain for structual erosion if the
    * distance function is approximate Euclidean. */
   if(errNum == WLZ_ERR_NONE)
@@ -575,3 +664,600 @@ static WlzObject *WlzDistSample(WlzObject *obj, int dim, double scale,
   }
   return(sObj);
 }
+
+/*!
+* \return	Distance object which shares the given foreground object's
+*		domain and has float distance values, null on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the exact Euclidean distance of every pixel/voxel
+*		in the foreground object from the reference object, see
+*		WlzDistanceTransform(). Squared distances are computed
+*		within the bounding box of both objects using a pass
+*		along each line followed by lower envelope passes along
+*		each column and then each plane. The passes along the
+*		columns and planes are independent for each column of the
+*		bounding box, so the bounding box is processed in slabs of
+*		columns with the size of each slab's buffer limited. The
+*		line pass for each slab is computed directly from the
+*		reference object's intervals, including those outside of
+*		the slab. Each pass is parallel over the independent
+*		parts, columns or planes.
+* \param	forObj			Foreground object.
+* \param	refObj			Reference object which must be a
+*					domain object of the same type as
+*					the foreground object.
+* \param	dMax			Maximum distance, distances greater
+*					than this are clamped if it is
+*					greater than zero.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzDistEuclidean(WlzObject *forObj, WlzObject *refObj,
+				   double dMax, WlzErrorNum *dstErr)
+{
+  int		idP,
+		nRefParts = 0,
+		nDstParts = 0,
+		nBuf;
+  size_t	nLn;
+  WlzIBox3	rBox;
+  WlzPixelV	bgdV;
+  WlzValues	dstVal;
+  WlzObject	*dstObj = NULL;
+  WlzIntervalScanPart *refParts = NULL,
+  		*dstParts = NULL;
+  WlzObjectType	dstGType;
+  WlzDistEuclideanWSp wSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const size_t	maxSlabSz = 1 << 26;
+  const double	dEps = 1.0e-6;
+
+  dstVal.core = NULL;
+  wSp.dSq = NULL;
+  wSp.dMax = dMax;
+  if(refObj->type != forObj->type)
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else
+  {
+    wSp.bBox = WlzBoundingBox3I(forObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rBox = WlzBoundingBox3I(refObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    wSp.vSz[0] = wSp.vSz[1] = wSp.vSz[2] = 1.0;
+    if(forObj->type == WLZ_3D_DOMAINOBJ)
+    {
+      wSp.vSz[0] = forObj->domain.p->voxel_size[0];
+      wSp.vSz[1] = forObj->domain.p->voxel_size[1];
+      wSp.vSz[2] = forObj->domain.p->voxel_size[2];
+      if((wSp.vSz[0] < dEps) || (wSp.vSz[1] < dEps) || (wSp.vSz[2] < dEps))
+      {
+        errNum = WLZ_ERR_DOMAIN_DATA;
+      }
+    }
+    else
+    {
+      wSp.bBox.zMin = wSp.bBox.zMax = rBox.zMin = rBox.zMax = 0;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    wSp.bBox.xMin = WLZ_MIN(wSp.bBox.xMin, rBox.xMin);
+    wSp.bBox.yMin = WLZ_MIN(wSp.bBox.yMin, rBox.yMin);
+    wSp.bBox.zMin = WLZ_MIN(wSp.bBox.zMin, rBox.zMin);
+    wSp.bBox.xMax = WLZ_MAX(wSp.bBox.xMax, rBox.xMax);
+    wSp.bBox.yMax = WLZ_MAX(wSp.bBox.yMax, rBox.yMax);
+    wSp.bBox.zMax = WLZ_MAX(wSp.bBox.zMax, rBox.zMax);
+    wSp.sz.vtX = wSp.bBox.xMax - wSp.bBox.xMin + 1;
+    wSp.sz.vtY = wSp.bBox.yMax - wSp.bBox.yMin + 1;
+    wSp.sz.vtZ = wSp.bBox.zMax - wSp.bBox.zMin + 1;
+    nLn = (size_t )(wSp.sz.vtY) * wSp.sz.vtZ;
+    nBuf = WLZ_MAX(wSp.sz.vtY, wSp.sz.vtZ);
+    wSp.nX = (int )WLZ_MIN((size_t )(wSp.sz.vtX),
+                           WLZ_MAX(maxSlabSz / nLn, 1));
+    if((wSp.dSq = (float *)AlcMalloc(nLn * wSp.nX * sizeof(float))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Create the distance object. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    bgdV.type = WLZ_GREY_FLOAT;
+    bgdV.v.flv = 0.0f;
+    dstGType = WlzGreyTableType(WLZ_GREY_TAB_RAGR, WLZ_GREY_FLOAT, NULL);
+    if(forObj->type == WLZ_2D_DOMAINOBJ)
+    {
+      dstVal.v = WlzNewValueTb(forObj, dstGType, bgdV, &errNum);
+    }
+    else
+    {
+      dstVal.vox = WlzNewValuesVox(forObj, dstGType, bgdV, &errNum);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    dstObj = WlzMakeMain(forObj->type, forObj->domain, dstVal,
+			 NULL, NULL, &errNum);
+    if(dstObj == NULL)
+    {
+      (void )WlzFreeValues(dstVal);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    refParts = WlzMakeIntervalScanParts(refObj, 0, &nRefParts, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    dstParts = WlzMakeIntervalScanParts(dstObj, 0, &nDstParts, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		nSlabX;
+
+    nSlabX = wSp.nX;
+    for(wSp.x0 = wSp.bBox.xMin;
+        (errNum == WLZ_ERR_NONE) && (wSp.x0 <= wSp.bBox.xMax);
+	wSp.x0 += nSlabX)
+    {
+      size_t	idx,
+		nPl,
+		nSlab;
+
+      wSp.nX = WLZ_MIN(nSlabX, wSp.bBox.xMax - wSp.x0 + 1);
+      nPl = (size_t )(wSp.nX) * wSp.sz.vtY;
+      nSlab = nPl * wSp.sz.vtZ;
+      /* Line pass: set the squared distance to the nearest reference
+       * pixel in each line, with lines that have no reference pixels
+       * set to infinity. */
+      for(idx = 0; idx < nSlab; ++idx)
+      {
+	wSp.dSq[idx] = FLT_MAX;
+      }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for(idP = 0; idP < nRefParts; ++idP)
+      {
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  WlzErrorNum errNum2;
+
+	  errNum2 = WlzDistEuclideanRefPart(refObj, refParts + idP, &wSp);
+	  if(errNum2 != WLZ_ERR_NONE)
+	  {
+#ifdef _OPENMP
+#pragma omp critical (WlzDistEuclidean)
+#endif
+	    {
+	      if(errNum == WLZ_ERR_NONE)
+	      {
+		errNum = errNum2;
+	      }
+	    }
+	  }
+	}
+      }
+      /* Column and plane passes: lower envelope of parabolas. */
+      if(errNum == WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+	{
+	  int	*v = NULL;
+	  float	*f = NULL;
+	  double *z = NULL;
+	  long	idC;
+
+	  if(((v = (int *)AlcMalloc(nBuf * sizeof(int))) == NULL) ||
+	     ((f = (float *)AlcMalloc(2 * nBuf * sizeof(float))) == NULL) ||
+	     ((z = (double *)AlcMalloc((nBuf + 1) * sizeof(double))) == NULL))
+	  {
+#ifdef _OPENMP
+#pragma omp critical (WlzDistEuclidean)
+#endif
+	    {
+	      errNum = WLZ_ERR_MEM_ALLOC;
+	    }
+	  }
+#ifdef _OPENMP
+#pragma omp barrier
+#endif
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+#ifdef _OPENMP
+#pragma omp for
+#endif
+	    for(idC = 0; idC < (long )(wSp.nX) * wSp.sz.vtZ; ++idC)
+	    {
+	      int	k;
+	      float	*col;
+
+	      col = wSp.dSq + ((idC / wSp.nX) * nPl) + (idC % wSp.nX);
+	      for(k = 0; k < wSp.sz.vtY; ++k)
+	      {
+		f[k] = col[k * wSp.nX];
+	      }
+	      WlzDistEuclidean1D(f, f + nBuf, v, z, wSp.sz.vtY, wSp.vSz[1]);
+	      for(k = 0; k < wSp.sz.vtY; ++k)
+	      {
+		col[k * wSp.nX] = f[nBuf + k];
+	      }
+	    }
+	    if(wSp.sz.vtZ > 1)
+	    {
+#ifdef _OPENMP
+#pragma omp for
+#endif
+	      for(idC = 0; idC < (long )nPl; ++idC)
+	      {
+		int	k;
+		float	*col;
+
+		col = wSp.dSq + idC;
+		for(k = 0; k < wSp.sz.vtZ; ++k)
+		{
+		  f[k] = col[k * nPl];
+		}
+		WlzDistEuclidean1D(f, f + nBuf, v, z, wSp.sz.vtZ,
+				   wSp.vSz[2]);
+		for(k = 0; k < wSp.sz.vtZ; ++k)
+		{
+		  col[k * nPl] = f[nBuf + k];
+		}
+	      }
+	    }
+	  }
+	  AlcFree(v);
+	  AlcFree(f);
+	  AlcFree(z);
+	}
+      }
+      /* Set the distance values within the slab. */
+      if(errNum == WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+	for(idP = 0; idP < nDstParts; ++idP)
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    WlzErrorNum errNum2;
+
+	    errNum2 = WlzDistEuclideanDstPart(dstObj, dstParts + idP, &wSp);
+	    if(errNum2 != WLZ_ERR_NONE)
+	    {
+#ifdef _OPENMP
+#pragma omp critical (WlzDistEuclidean)
+#endif
+	      {
+		if(errNum == WLZ_ERR_NONE)
+		{
+		  errNum = errNum2;
+		}
+	      }
+	    }
+	  }
+	}
+      }
+    }
+  }
+  AlcFree(refParts);
+  AlcFree(dstParts);
+  AlcFree(wSp.dSq);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(dstObj);
+    dstObj = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(dstObj);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the line pass of the exact Euclidean distance
+*		transform for the current slab and the lines of a single
+*		part of the reference object. Reference pixels within the
+*		slab are set to zero, then the squared distances of the
+*		other pixels in the slab are set from the nearest
+*		reference pixels in the line, which may lie outside the
+*		slab.
+* \param	refObj			Reference object.
+* \param	part			Part of the reference object.
+* \param	wSp			Distance transform workspace.
+*/
+static WlzErrorNum WlzDistEuclideanRefPart(WlzObject *refObj,
+					   WlzIntervalScanPart *part,
+					   WlzDistEuclideanWSp *wSp)
+{
+  int		x1,
+		lft = 0,
+		rgt = 0,
+  		pln = 0,
+		lin = 0;
+  float		*ln = NULL;
+  WlzObject	obj2D;
+  WlzIntervalWSpace iWSp;
+  WlzErrorNum	errNum;
+
+  x1 = wSp->x0 + wSp->nX - 1;
+  errNum = WlzInitRasterScanPart(refObj, part, &obj2D, &iWSp,
+  				 WLZ_RASTERDIR_ILIC);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    while((errNum = WlzNextInterval(&iWSp)) == WLZ_ERR_NONE)
+    {
+      if((ln == NULL) || (iWSp.plnpos != pln) || (iWSp.linpos != lin))
+      {
+	if(ln)
+	{
+	  WlzDistEuclideanLine(ln, wSp->nX, lft, rgt, wSp->vSz[0]);
+	}
+	pln = iWSp.plnpos;
+	lin = iWSp.linpos;
+	ln = wSp->dSq +
+	     ((((size_t )(pln - wSp->bBox.zMin) * wSp->sz.vtY) +
+	       (lin - wSp->bBox.yMin)) * wSp->nX);
+	lft = rgt = 0;
+      }
+      if(iWSp.rgtpos < wSp->x0)
+      {
+	if((lft == 0) || (iWSp.rgtpos - wSp->x0 > lft))
+	{
+	  lft = iWSp.rgtpos - wSp->x0;
+	}
+      }
+      else if(iWSp.lftpos > x1)
+      {
+	if((rgt == 0) || (iWSp.lftpos - wSp->x0 < rgt))
+	{
+	  rgt = iWSp.lftpos - wSp->x0;
+	}
+      }
+      else
+      {
+	int	k,
+		k1;
+
+	k = WLZ_MAX(iWSp.lftpos, wSp->x0) - wSp->x0;
+	k1 = WLZ_MIN(iWSp.rgtpos, x1) - wSp->x0;
+	while(k <= k1)
+	{
+	  ln[k++] = 0.0f;
+	}
+      }
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      if(ln)
+      {
+	WlzDistEuclideanLine(ln, wSp->nX, lft, rgt, wSp->vSz[0]);
+      }
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzMorphologyOps
+* \brief	Sets the squared distances of the pixels in a line of
+*		a slab, in which the reference pixels have already been
+*		set to zero and all others to infinity, given the
+*		nearest reference pixels to either side of the slab.
+* \param	ln			Line of the slab.
+* \param	n			Number of pixels in the line.
+* \param	lft			Position, relative to the slab, of
+*					the nearest reference pixel to the
+*					left of the slab which is negative,
+*					or zero if there is none.
+* \param	rgt			Position, relative to the slab, of
+*					the nearest reference pixel to the
+*					right of the slab which is greater
+*					than or equal to n, or zero if there
+*					is none.
+* \param	s			Pixel spacing along the line.
+*/
+static void	WlzDistEuclideanLine(float *ln, int n, int lft, int rgt,
+				     double s)
+{
+  int		k,
+  		nrst,
+		fnd;
+
+  nrst = lft;
+  fnd = (lft < 0);
+  for(k = 0; k < n; ++k)
+  {
+    if(ln[k] < 0.5f)
+    {
+      nrst = k;
+      fnd = 1;
+    }
+    else if(fnd)
+    {
+      ln[k] = k - nrst;
+    }
+  }
+  nrst = rgt;
+  fnd = (rgt > 0);
+  for(k = n - 1; k >= 0; --k)
+  {
+    if(ln[k] < 0.5f)
+    {
+      nrst = k;
+      fnd = 1;
+    }
+    else if(fnd && (nrst - k < ln[k]))
+    {
+      ln[k] = nrst - k;
+    }
+  }
+  for(k = 0; k < n; ++k)
+  {
+    if(ln[k] < FLT_MAX)
+    {
+      double  d;
+
+      d = ln[k] * s;
+      ln[k] = d * d;
+    }
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Sets the distance values of the exact Euclidean distance
+*		transform for the pixels of a single part of the distance
+*		object which lie within the current slab.
+* \param	dstObj			Distance object.
+* \param	part			Part of the distance object.
+* \param	wSp			Distance transform workspace.
+*/
+static WlzErrorNum WlzDistEuclideanDstPart(WlzObject *dstObj,
+					   WlzIntervalScanPart *part,
+					   WlzDistEuclideanWSp *wSp)
+{
+  int		x1;
+  WlzObject	obj2D;
+  WlzIntervalWSpace iWSp;
+  WlzGreyWSpace gWSp;
+  WlzErrorNum	errNum;
+  const double	dEps = 1.0e-6;
+
+  x1 = wSp->x0 + wSp->nX - 1;
+  errNum = WlzInitGreyScanPart(dstObj, part, &obj2D, &iWSp, &gWSp,
+  			       WLZ_RASTERDIR_ILIC, 0);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+    {
+      int	k,
+		k0,
+		k1;
+      float	*ln,
+		*gP;
+
+      k0 = WLZ_MAX(iWSp.lftpos, wSp->x0);
+      k1 = WLZ_MIN(iWSp.rgtpos, x1);
+      if(k0 <= k1)
+      {
+	ln = wSp->dSq +
+	     ((((size_t )(iWSp.plnpos - wSp->bBox.zMin) * wSp->sz.vtY) +
+	       (iWSp.linpos - wSp->bBox.yMin)) * wSp->nX) - wSp->x0;
+	gP = gWSp.u_grintptr.flp - iWSp.lftpos;
+	for(k = k0; k <= k1; ++k)
+	{
+	  double d;
+
+	  d = (ln[k] < FLT_MAX)? sqrt(ln[k]): FLT_MAX;
+	  if((wSp->dMax > dEps) && (d > wSp->dMax))
+	  {
+	    d = wSp->dMax;
+	  }
+	  gP[k] = d;
+	}
+      }
+    }
+    (void )WlzEndGreyScan(&iWSp, &gWSp);
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the one dimensional squared Euclidean distance
+*		transform of a sampled function, as the lower envelope of
+*		the parabolas rooted at the samples. Samples with a value
+*		of FLT_MAX are not included in the envelope.
+* \param	f			Sampled function (squared distances).
+* \param	d			Destination for the transformed
+*					squared distances.
+* \param	v			Workspace for the envelope parabola
+*					indices, length n.
+* \param	z			Workspace for the envelope boundaries,
+*					length n + 1.
+* \param	n			Number of samples.
+* \param	s			Sample spacing.
+*/
+static void	WlzDistEuclidean1D(float *f, float *d, int *v, double *z,
+				   int n, double s)
+{
+  int		k = -1,
+  		q;
+
+  for(q = 0; q < n; ++q)
+  {
+    if(f[q] < FLT_MAX)
+    {
+      double	x,
+      		fq;
+
+      x = q * s;
+      fq = f[q] + (x * x);
+      if(k < 0)
+      {
+        k = 0;
+	v[0] = q;
+	z[0] = -DBL_MAX;
+      }
+      else
+      {
+	double	xk,
+		i;
+
+	do
+	{
+	  xk = v[k] * s;
+	  i = (fq - (f[v[k]] + (xk * xk))) / (2.0 * (x - xk));
+	}
+	while((i <= z[k]) && (--k >= 0));
+	++k;
+	v[k] = q;
+	z[k] = i;
+      }
+      z[k + 1] = DBL_MAX;
+    }
+  }
+  if(k < 0)
+  {
+    for(q = 0; q < n; ++q)
+    {
+      d[q] = FLT_MAX;
+    }
+  }
+  else
+  {
+    k = 0;
+    for(q = 0; q < n; ++q)
+    {
+      double	x,
+      		xk;
+
+      x = q * s;
+      while(z[k + 1] < x)
+      {
+        ++k;
+      }
+      xk = v[k] * s;
+      d[q] = ((x - xk) * (x - xk)) + f[v[k]];
+    }
+  }
+}
@@ -64,7 +64,7 @@ static WlzCompoundArray 	*WlzFourierTransformObjCpx3D(
 * \brief	Computes either the forward or inverse Fourier transform
 * 		of a domain object with real (ie not complex) values.
 * 		When computing a transform the object will be padded
-* 		to an integer power of two size.
+* 		to the size given by AlgFourNextFastSize().
 * 		The object's values can have any single valued type
 * 		(and therefore RGBA is not acceptable). For forward
 * 		transforms the objects frequently have their grey
@@ -184,14 +184,10 @@ static WlzObject *WlzFourierTransformObj2D(WlzObject *iObj, int fwd,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    unsigned int t0;
-
     iSz.vtX = bBox.xMax - bBox.xMin + 1;
     iSz.vtY = bBox.yMax - bBox.yMin + 1;
-    (void )AlgBitNextPowerOfTwo(&t0, iSz.vtX);
-    oSz.vtX = t0;
-    (void )AlgBitNextPowerOfTwo(&t0, iSz.vtY);
-    oSz.vtY = t0;
+    oSz.vtX = AlgFourNextFastSize(iSz.vtX);
+    oSz.vtY = AlgFourNextFastSize(iSz.vtY);
     org.vtX = bBox.xMin - (oSz.vtX - iSz.vtX) / 2;
     org.vtY = bBox.yMin - (oSz.vtY - iSz.vtY) / 2;
     errNum = WlzToArray2D(&array, iObj, oSz, org, 0, WLZ_GREY_DOUBLE);
@@ -274,17 +270,12 @@ static WlzObject *WlzFourierTransformObj3D(WlzObject *iObj, int fwd,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    unsigned int t0;
-
     iSz.vtX = bBox.xMax - bBox.xMin + 1;
     iSz.vtY = bBox.yMax - bBox.yMin + 1;
     iSz.vtZ = bBox.zMax - bBox.zMin + 1;
-    (void )AlgBitNextPowerOfTwo(&t0, iSz.vtX);
-    oSz.vtX = t0;
-    (void )AlgBitNextPowerOfTwo(&t0, iSz.vtY);
-    oSz.vtY = t0;
-    (void )AlgBitNextPowerOfTwo(&t0, iSz.vtZ);
-    oSz.vtZ = t0;
+    oSz.vtX = AlgFourNextFastSize(iSz.vtX);
+    oSz.vtY = AlgFourNextFastSize(iSz.vtY);
+    oSz.vtZ = AlgFourNextFastSize(iSz.vtZ);
     org.vtX = bBox.xMin - (oSz.vtX - iSz.vtX) / 2;
     org.vtY = bBox.yMin - (oSz.vtY - iSz.vtY) / 2;
     org.vtZ = bBox.zMin - (oSz.vtZ - iSz.vtZ) / 2;
@@ -387,15 +378,10 @@ static WlzCompoundArray *WlzFourierTransformObjCpx2D(WlzCompoundArray *iObj,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-
-    unsigned int t0;
-
     iSz.vtX = bBox[0].xMax - bBox[0].xMin + 1;
     iSz.vtY = bBox[0].yMax - bBox[0].yMin + 1;
-    (void )AlgBitNextPowerOfTwo(&t0, iSz.vtX);
-    oSz.vtX = t0;
-    (void )AlgBitNextPowerOfTwo(&t0, iSz.vtY);
-    oSz.vtY = t0;
+    oSz.vtX = AlgFourNextFastSize(iSz.vtX);
+    oSz.vtY = AlgFourNextFastSize(iSz.vtY);
     org.vtX = bBox[0].xMin - (oSz.vtX - iSz.vtX) / 2;
     org.vtY = bBox[0].yMin - (oSz.vtY - iSz.vtY) / 2;
     errNum = WlzToArray2D(&real, iObj->o[0], oSz, org, 0, WLZ_GREY_DOUBLE);
@@ -522,18 +508,12 @@ static WlzCompoundArray *WlzFourierTransformObjCpx3D(WlzCompoundArray *iObj,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-
-    unsigned int t0;
-
     iSz.vtX = bBox[0].xMax - bBox[0].xMin + 1;
     iSz.vtY = bBox[0].yMax - bBox[0].yMin + 1;
     iSz.vtZ = bBox[0].zMax - bBox[0].zMin + 1;
-    (void )AlgBitNextPowerOfTwo(&t0, iSz.vtX);
-    oSz.vtX = t0;
-    (void )AlgBitNextPowerOfTwo(&t0, iSz.vtY);
-    oSz.vtY = t0;
-    (void )AlgBitNextPowerOfTwo(&t0, iSz.vtZ);
-    oSz.vtZ = t0;
+    oSz.vtX = AlgFourNextFastSize(iSz.vtX);
+    oSz.vtY = AlgFourNextFastSize(iSz.vtY);
+    oSz.vtZ = AlgFourNextFastSize(iSz.vtZ);
     org.vtX = bBox[0].xMin - (oSz.vtX - iSz.vtX) / 2;
     org.vtY = bBox[0].yMin - (oSz.vtY - iSz.vtY) / 2;
     org.vtZ = bBox[0].zMin - (oSz.vtZ - iSz.vtZ) / 2;
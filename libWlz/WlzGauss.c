@@ -48,6 +48,115 @@ static char _WlzGauss_c[] = "University of Edinburgh $Id$";
 
 #define AFACTOR	100
 
+/* Number of values convolved at a time by Wlz1DConv(). */
+#define WLZ_GAUSS_CONV_BLKSZ	(256)
+
+/*!
+* \ingroup	WlzValuesFilters
+* \brief	Convolves the CNT values of the line IN (of type T and
+* 		length LEN) from I0 onwards with the mask MSK, which is
+* 		centred on its zeroth element and has half width N,
+* 		accumulating the sums in ACC. Values beyond the line are those at
+* 		its ends. The sum for each value is formed in the same
+* 		order as by a direct convolution, but the loop over the
+* 		block is innermost so that it may be vectorised, with
+* 		two pairs of mask values applied in each pass over the
+* 		block. If S is non-zero then symmetric and antisymmetric
+* 		pairs of mask values are applied to the sum or difference
+* 		of the data, which is only exact for integer arithmetic.
+* 		J and K are integer loop counters.
+*/
+#define WLZ_GAUSS_CONV_BLK(ACC,T,IN,MSK,N,LEN,I0,CNT,S,J,K) \
+{ \
+  for((K)=0;(K)<(CNT);++(K)) \
+  { \
+    (ACC)[(K)]=(IN)[(I0)+(K)]*(MSK)[0]; \
+  } \
+  if(((I0)>=(N))&&((I0)+(CNT)+(N)<=(LEN))) \
+  { \
+    for((J)=1;(J)<(N);(J)+=2) \
+    { \
+      int	WlzGaussML0=(MSK)[-(J)], \
+		WlzGaussMR0=(MSK)[(J)], \
+		WlzGaussML1=(MSK)[-(J)-1], \
+		WlzGaussMR1=(MSK)[(J)+1]; \
+      T		*WlzGaussPL0=(IN)+(I0)-(J), \
+		*WlzGaussPR0=(IN)+(I0)+(J), \
+		*WlzGaussPL1=(IN)+(I0)-(J)-1, \
+		*WlzGaussPR1=(IN)+(I0)+(J)+1; \
+      if((S)&&(WlzGaussML0==WlzGaussMR0)&&(WlzGaussML1==WlzGaussMR1)) \
+      { \
+	for((K)=0;(K)<(CNT);++(K)) \
+	{ \
+	  (ACC)[(K)]+=(WlzGaussPR0[(K)]+WlzGaussPL0[(K)])*WlzGaussMR0+ \
+		      (WlzGaussPR1[(K)]+WlzGaussPL1[(K)])*WlzGaussMR1; \
+	} \
+      } \
+      else if((S)&&(WlzGaussML0==-WlzGaussMR0)&& \
+	      (WlzGaussML1==-WlzGaussMR1)) \
+      { \
+	for((K)=0;(K)<(CNT);++(K)) \
+	{ \
+	  (ACC)[(K)]+=(WlzGaussPR0[(K)]-WlzGaussPL0[(K)])*WlzGaussMR0+ \
+		      (WlzGaussPR1[(K)]-WlzGaussPL1[(K)])*WlzGaussMR1; \
+	} \
+      } \
+      else \
+      { \
+	for((K)=0;(K)<(CNT);++(K)) \
+	{ \
+	  (ACC)[(K)]+=WlzGaussPR0[(K)]*WlzGaussMR0; \
+	  (ACC)[(K)]+=WlzGaussPL0[(K)]*WlzGaussML0; \
+	  (ACC)[(K)]+=WlzGaussPR1[(K)]*WlzGaussMR1; \
+	  (ACC)[(K)]+=WlzGaussPL1[(K)]*WlzGaussML1; \
+	} \
+      } \
+    } \
+    if((J)==(N)) \
+    { \
+      int	WlzGaussML=(MSK)[-(J)], \
+		WlzGaussMR=(MSK)[(J)]; \
+      T		*WlzGaussPL=(IN)+(I0)-(J), \
+		*WlzGaussPR=(IN)+(I0)+(J); \
+      for((K)=0;(K)<(CNT);++(K)) \
+      { \
+	(ACC)[(K)]+=WlzGaussPR[(K)]*WlzGaussMR; \
+	(ACC)[(K)]+=WlzGaussPL[(K)]*WlzGaussML; \
+      } \
+    } \
+  } \
+  else \
+  { \
+    int	WlzGaussIL, \
+	WlzGaussIR; \
+    for((J)=1;(J)<=(N);++(J)) \
+    { \
+      for((K)=0;(K)<(CNT);++(K)) \
+      { \
+	WlzGaussIL=(I0)+(K)-(J); \
+	WlzGaussIR=(I0)+(K)+(J); \
+	WlzGaussIL=(WlzGaussIL<0)?0:WlzGaussIL; \
+	WlzGaussIR=(WlzGaussIR>=(LEN))?(LEN)-1:WlzGaussIR; \
+	(ACC)[(K)]+=(IN)[WlzGaussIR]*(MSK)[(J)]; \
+	(ACC)[(K)]+=(IN)[WlzGaussIL]*(MSK)[-(J)]; \
+      } \
+    } \
+  } \
+}
+
+static WlzErrorNum 		WlzGaussConvStoreI(
+				  WlzPixelP outbuf,
+				  int off,
+				  int *blk,
+				  int cnt,
+				  int factor);
+static WlzErrorNum 		WlzGaussConvStoreD(
+				  WlzPixelP outbuf,
+				  int off,
+				  double *blk,
+				  int cnt,
+				  int factor);
+
 /* function:     WlzGauss2    */
 /*! 
 * \ingroup      WlzValuesFilters
@@ -279,11 +388,12 @@ WlzErrorNum Wlz1DConv(
   void			*params)
 {
   Wlz1DConvMask	*convParams = (Wlz1DConvMask *) params;
-  int 		i, j, n, *mask, factor, length;
-  int		intSum;
-  double	dblSum;
+  int 		i, j, k, n, *mask, factor, length, blkSz;
+  int		intBlk[WLZ_GAUSS_CONV_BLKSZ];
+  double	dblBlk[WLZ_GAUSS_CONV_BLKSZ];
   WlzGreyP	inbuf, outbuf;
   WlzUInt	red, green, blue;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
     
   /* set some local parameters */
   n = convParams->mask_size / 2;
@@ -297,554 +407,58 @@ WlzErrorNum Wlz1DConv(
      double otherwise, separate rgb values each use WlzUInt */
   switch( stwspc->inbuf.type ){
 
-  case WLZ_GREY_INT:
-
-    /* first convolve up to the half-width of the mask */
-    for(i=0; (i < n) && (i < length); i++){
-      intSum = *inbuf.inp * mask[0];
-      for(j=1; j <= n; j++){
-	intSum += inbuf.inp[(j+i)>(length-1)?-i+length-1:j] * mask[j];
-	intSum += inbuf.inp[-((i>j)?j:i)] * mask[-j];
-      }
-      inbuf.inp++;
-      switch( stwspc->outbuf.type ){
-      case WLZ_GREY_INT:
-	*outbuf.inp++ = intSum/factor;
-	break;
-      case WLZ_GREY_SHORT:
-	*outbuf.shp++ = (short )(intSum/factor);
-	break;
-      case WLZ_GREY_UBYTE:
-	*outbuf.ubp++ = (WlzUByte )(intSum/factor);
-	break;
-      case WLZ_GREY_FLOAT:
-	*outbuf.flp++ = (float )(intSum/factor);
-	break;
-      case WLZ_GREY_DOUBLE:
-	*outbuf.dbp++ = intSum/factor;
-	break;
-      case WLZ_GREY_RGBA:
-	red = (WlzUInt )WLZ_CLAMP(intSum/factor, 0, 255);
-	WLZ_RGBA_RGBA_SET(*outbuf.rgbp, red, red, red, 255);
-	outbuf.rgbp++;
-	break;
-      default:
-        return WLZ_ERR_GREY_TYPE;
-	break;
-      }
-    }
-
-    /* now the central portion */
-    while( i < (length-n-1) ){
-      intSum = *inbuf.inp * mask[0];
-      for(j=1; j <= n; j++){
-	intSum += inbuf.inp[j] * mask[j];
-	intSum += inbuf.inp[-j] * mask[-j];
-      }
-      inbuf.inp++;
-      i++;
-      switch( stwspc->outbuf.type ){
-      case WLZ_GREY_INT:
-	*outbuf.inp++ = intSum/factor;
-	break;
-      case WLZ_GREY_SHORT:
-	*outbuf.shp++ = (short )(intSum/factor);
-	break;
-      case WLZ_GREY_UBYTE:
-	*outbuf.ubp++ = (WlzUByte )(intSum/factor);
-	break;
-      case WLZ_GREY_FLOAT:
-	*outbuf.flp++ = (float )(intSum/factor);
-	break;
-      case WLZ_GREY_DOUBLE:
-	*outbuf.dbp++ = intSum/factor;
-	break;
-      case WLZ_GREY_RGBA:
-	red = (WlzUInt )WLZ_CLAMP(intSum/factor, 0, 255);
-	WLZ_RGBA_RGBA_SET(*outbuf.rgbp, red, red, red, 255);
-	outbuf.rgbp++;
-	break;
-      default:
-        return WLZ_ERR_GREY_TYPE;
-	break;
-      }
-    }   
-
-    /* now the last bit within a half-width of the end */
-    while( i < length ){
-      intSum = *inbuf.inp * mask[0];
-      for(j=1; j <= n; j++){
-	intSum += inbuf.inp[(j+i)>(length-1)?-i+length-1:j] * mask[j];
-	intSum += inbuf.inp[-j] * mask[-j];
-      }
-      inbuf.inp++;
-      i++;
-      switch( stwspc->outbuf.type ){
-      case WLZ_GREY_INT:
-	*outbuf.inp++ = intSum/factor;
-	break;
-      case WLZ_GREY_SHORT:
-	*outbuf.shp++ = (short )(intSum/factor);
-	break;
-      case WLZ_GREY_UBYTE:
-	*outbuf.ubp++ = (WlzUByte )(intSum/factor);
-	break;
-      case WLZ_GREY_FLOAT:
-	*outbuf.flp++ = (float )(intSum/factor);
-	break;
-      case WLZ_GREY_DOUBLE:
-	*outbuf.dbp++ = intSum/factor;
-	break;
-      case WLZ_GREY_RGBA:
-	red = (WlzUInt )WLZ_CLAMP(intSum/factor, 0, 255);
-	WLZ_RGBA_RGBA_SET(*outbuf.rgbp, red, red, red, 255);
-	outbuf.rgbp++;
-	break;
-      default:
-        return WLZ_ERR_GREY_TYPE;
-	break;
-      }
-    }      
-    break;
-
-  case WLZ_GREY_SHORT:
-
-    /* first convolve up to the half-width of the mask */
-    for(i=0; (i < n) && (i < length); i++){
-      intSum = *inbuf.shp * mask[0];
-      for(j=1; j <= n; j++){
-	intSum += inbuf.shp[(j+i)>(length-1)?-i+length-1:j] * mask[j];
-	intSum += inbuf.shp[-((i>j)?j:i)] * mask[-j];
-      }
-      inbuf.shp++;
-      switch( stwspc->outbuf.type ){
-      case WLZ_GREY_INT:
-	*outbuf.inp++ = intSum/factor;
-	break;
-      case WLZ_GREY_SHORT:
-	*outbuf.shp++ = (short )(intSum/factor);
-	break;
-      case WLZ_GREY_UBYTE:
-	*outbuf.ubp++ = (WlzUByte )(intSum/factor);
-	break;
-      case WLZ_GREY_FLOAT:
-	*outbuf.flp++ = (float )(intSum/factor);
-	break;
-      case WLZ_GREY_DOUBLE:
-	*outbuf.dbp++ = intSum/factor;
-	break;
-      case WLZ_GREY_RGBA:
-	red = (WlzUInt )WLZ_CLAMP(intSum/factor, 0, 255);
-	WLZ_RGBA_RGBA_SET(*outbuf.rgbp, red, red, red, 255);
-	outbuf.rgbp++;
-	break;
-      default:
-        return WLZ_ERR_GREY_TYPE;
-	break;
-      }
-    }
-
-    /* now the central portion */
-    while( i < (length-n-1) ){
-      intSum = *inbuf.shp * mask[0];
-      for(j=1; j <= n; j++){
-	intSum += inbuf.shp[j] * mask[j];
-	intSum += inbuf.shp[-j] * mask[-j];
-      }
-      inbuf.shp++;
-      i++;
-      switch( stwspc->outbuf.type ){
-      case WLZ_GREY_INT:
-	*outbuf.inp++ = intSum/factor;
-	break;
-      case WLZ_GREY_SHORT:
-	*outbuf.shp++ = (short )(intSum/factor);
-	break;
-      case WLZ_GREY_UBYTE:
-	*outbuf.ubp++ = (WlzUByte )(intSum/factor);
-	break;
-      case WLZ_GREY_FLOAT:
-	*outbuf.flp++ =(float )( intSum/factor);
-	break;
-      case WLZ_GREY_DOUBLE:
-	*outbuf.dbp++ = intSum/factor;
-	break;
-      case WLZ_GREY_RGBA:
-	red = (WlzUInt )WLZ_CLAMP(intSum/factor, 0, 255);
-	WLZ_RGBA_RGBA_SET(*outbuf.rgbp, red, red, red, 255);
-	outbuf.rgbp++;
-	break;
-      default:
-        return WLZ_ERR_GREY_TYPE;
-	break;
-      }
-    }   
-
-    /* now the last bit within a half-width of the end */
-    while( i < length ){
-      intSum = *inbuf.shp * mask[0];
-      for(j=1; j <= n; j++){
-	intSum += inbuf.shp[(j+i)>(length-1)?-i+length-1:j] * mask[j];
-	intSum += inbuf.shp[-j] * mask[-j];
-      }
-      inbuf.shp++;
-      i++;
-      switch( stwspc->outbuf.type ){
-      case WLZ_GREY_INT:
-	*outbuf.inp++ = intSum/factor;
-	break;
-      case WLZ_GREY_SHORT:
-	*outbuf.shp++ = (short )(intSum/factor);
-	break;
-      case WLZ_GREY_UBYTE:
-	*outbuf.ubp++ = (WlzUByte )(intSum/factor);
-	break;
-      case WLZ_GREY_FLOAT:
-	*outbuf.flp++ = (float )(intSum/factor);
-	break;
-      case WLZ_GREY_DOUBLE:
-	*outbuf.dbp++ = intSum/factor;
-	break;
-      case WLZ_GREY_RGBA:
-	red = (WlzUInt )WLZ_CLAMP(intSum/factor, 0, 255);
-	WLZ_RGBA_RGBA_SET(*outbuf.rgbp, red, red, red, 255);
-	outbuf.rgbp++;
-	break;
-      default:
-        return WLZ_ERR_GREY_TYPE;
-	break;
-      }
-    }      
-    break;
-
+  case WLZ_GREY_INT:    /* FALLTHROUGH */
+  case WLZ_GREY_SHORT:  /* FALLTHROUGH */
   case WLZ_GREY_UBYTE:
-
-    /* first convolve up to the half-width of the mask */
-    for(i=0; (i < n) && (i < length); i++){
-      intSum = *inbuf.ubp * mask[0];
-      for(j=1; j <= n; j++){
-	intSum += inbuf.ubp[(j+i)>(length-1)?-i+length-1:j] * mask[j];
-	intSum += inbuf.ubp[-((i>j)?j:i)] * mask[-j];
-      }
-      inbuf.ubp++;
-      switch( stwspc->outbuf.type ){
-      case WLZ_GREY_INT:
-	*outbuf.inp++ = intSum/factor;
-	break;
-      case WLZ_GREY_SHORT:
-	*outbuf.shp++ = (short )(intSum/factor);
-	break;
-      case WLZ_GREY_UBYTE:
-	*outbuf.ubp++ = (WlzUByte )(intSum/factor);
-	break;
-      case WLZ_GREY_FLOAT:
-	*outbuf.flp++ = (float )(intSum/factor);
-	break;
-      case WLZ_GREY_DOUBLE:
-	*outbuf.dbp++ = intSum/factor;
-	break;
-      case WLZ_GREY_RGBA:
-	red = (WlzUInt )WLZ_CLAMP(intSum/factor, 0, 255);
-	WLZ_RGBA_RGBA_SET(*outbuf.rgbp, red, red, red, 255);
-	outbuf.rgbp++;
-	break;
-      default:
-        return WLZ_ERR_GREY_TYPE;
-	break;
-      }
-    }
-
-    /* now the central portion */
-    while( i < (length-n-1) ){
-      intSum = *inbuf.ubp * mask[0];
-      for(j=1; j <= n; j++){
-	intSum += inbuf.ubp[j] * mask[j];
-	intSum += inbuf.ubp[-j] * mask[-j];
-      }
-      inbuf.ubp++;
-      i++;
-      switch( stwspc->outbuf.type ){
-      case WLZ_GREY_INT:
-	*outbuf.inp++ = intSum/factor;
-	break;
-      case WLZ_GREY_SHORT:
-	*outbuf.shp++ = (short )(intSum/factor);
-	break;
-      case WLZ_GREY_UBYTE:
-	*outbuf.ubp++ = (WlzUByte )(intSum/factor);
-	break;
-      case WLZ_GREY_FLOAT:
-	*outbuf.flp++ = (float )(intSum/factor);
-	break;
-      case WLZ_GREY_DOUBLE:
-	*outbuf.dbp++ = intSum/factor;
-	break;
-      case WLZ_GREY_RGBA:
-	red = (WlzUInt )WLZ_CLAMP(intSum/factor, 0, 255);
-	WLZ_RGBA_RGBA_SET(*outbuf.rgbp, red, red, red, 255);
-	outbuf.rgbp++;
-	break;
-      default:
-        return WLZ_ERR_GREY_TYPE;
-	break;
-      }
-    }   
-
-    /* now the last bit within a half-width of the end */
-    while( i < length ){
-      intSum = *inbuf.ubp * mask[0];
-      for(j=1; j <= n; j++){
-	intSum += inbuf.ubp[(j+i)>(length-1)?-i+length-1:j] * mask[j];
-	intSum += inbuf.ubp[-j] * mask[-j];
-      }
-      inbuf.ubp++;
-      i++;
-      switch( stwspc->outbuf.type ){
-      case WLZ_GREY_INT:
-	*outbuf.inp++ = intSum/factor;
-	break;
-      case WLZ_GREY_SHORT:
-	*outbuf.shp++ = (short )(intSum/factor);
-	break;
-      case WLZ_GREY_UBYTE:
-	*outbuf.ubp++ = (WlzUByte )(intSum/factor);
-	break;
-      case WLZ_GREY_FLOAT:
-	*outbuf.flp++ = (float )(intSum/factor);
-	break;
-      case WLZ_GREY_DOUBLE:
-	*outbuf.dbp++ = intSum/factor;
-	break;
-      case WLZ_GREY_RGBA:
-	red = (WlzUInt )WLZ_CLAMP(intSum/factor, 0, 255);
-	WLZ_RGBA_RGBA_SET(*outbuf.rgbp, red, red, red, 255);
-	outbuf.rgbp++;
-	break;
-      default:
-        return WLZ_ERR_GREY_TYPE;
-	break;
-      }
-    }      
-    break;
-
-  case WLZ_GREY_FLOAT:
-
-    /* first convolve up to the half-width of the mask */
-    for(i=0; (i < n) && (i < length); i++){
-      dblSum = *inbuf.flp * mask[0];
-      for(j=1; j <= n; j++){
-	dblSum += inbuf.flp[(j+i)>(length-1)?-i+length-1:j] * mask[j];
-	dblSum += inbuf.flp[-((i>j)?j:i)] * mask[-j];
-      }
-      inbuf.flp++;
-      switch( stwspc->outbuf.type ){
-      case WLZ_GREY_INT:
-	*outbuf.inp++ = (int )(dblSum/factor);
-	break;
-      case WLZ_GREY_SHORT:
-	*outbuf.shp++ = (short )(dblSum/factor);
-	break;
-      case WLZ_GREY_UBYTE:
-	*outbuf.ubp++ = (WlzUByte )(dblSum/factor);
-	break;
-      case WLZ_GREY_FLOAT:
-	*outbuf.flp++ = (float )(dblSum/factor);
-	break;
-      case WLZ_GREY_DOUBLE:
-	*outbuf.dbp++ = dblSum/factor;
-	break;
-      case WLZ_GREY_RGBA:
-	red = (WlzUInt )WLZ_CLAMP(dblSum/factor, 0, 255);
-	WLZ_RGBA_RGBA_SET(*outbuf.rgbp, red, red, red, 255);
-	outbuf.rgbp++;
-	break;
-      default:
-        return WLZ_ERR_GREY_TYPE;
-	break;
-      }
+    /* Integer sums are accumulated a block at a time, one mask element
+     * at a time over the block, so that the inner loops vectorise. */
+    for(i = 0; (errNum == WLZ_ERR_NONE) && (i < length);
+        i += WLZ_GAUSS_CONV_BLKSZ)
+    {
+      if((blkSz = length - i) > WLZ_GAUSS_CONV_BLKSZ)
+      {
+	blkSz = WLZ_GAUSS_CONV_BLKSZ;
+      }
+      switch(stwspc->inbuf.type)
+      {
+	case WLZ_GREY_INT:
+	  WLZ_GAUSS_CONV_BLK(intBlk, int, inbuf.inp, mask, n, length,
+			     i, blkSz, 1, j, k);
+	  break;
+	case WLZ_GREY_SHORT:
+	  WLZ_GAUSS_CONV_BLK(intBlk, short, inbuf.shp, mask, n, length,
+			     i, blkSz, 1, j, k);
+	  break;
+	default:
+	  WLZ_GAUSS_CONV_BLK(intBlk, WlzUByte, inbuf.ubp, mask, n, length,
+			     i, blkSz, 1, j, k);
+	  break;
+      }
+      errNum = WlzGaussConvStoreI(stwspc->outbuf, i, intBlk, blkSz, factor);
     }
-
-    /* now the central portion */
-    while( i < (length-n-1) ){
-      dblSum = *inbuf.flp * mask[0];
-      for(j=1; j <= n; j++){
-	dblSum += inbuf.flp[j] * mask[j];
-	dblSum += inbuf.flp[-j] * mask[-j];
-      }
-      inbuf.flp++;
-      i++;
-      switch( stwspc->outbuf.type ){
-      case WLZ_GREY_INT:
-	*outbuf.inp++ = (int )(dblSum/factor);
-	break;
-      case WLZ_GREY_SHORT:
-	*outbuf.shp++ = (short )(dblSum/factor);
-	break;
-      case WLZ_GREY_UBYTE:
-	*outbuf.ubp++ = (WlzUByte )(dblSum/factor);
-	break;
-      case WLZ_GREY_FLOAT:
-	*outbuf.flp++ = (float )(dblSum/factor);
-	break;
-      case WLZ_GREY_DOUBLE:
-	*outbuf.dbp++ = dblSum/factor;
-	break;
-      case WLZ_GREY_RGBA:
-	red = (WlzUInt )WLZ_CLAMP(dblSum/factor, 0, 255);
-	WLZ_RGBA_RGBA_SET(*outbuf.rgbp, red, red, red, 255);
-	outbuf.rgbp++;
-	break;
-      default:
-        return WLZ_ERR_GREY_TYPE;
-	break;
-      }
-    }   
-
-    /* now the last bit within a half-width of the end */
-    while( i < length ){
-      dblSum = *inbuf.flp * mask[0];
-      for(j=1; j <= n; j++){
-	dblSum += inbuf.flp[(j+i)>(length-1)?-i+length-1:j] * mask[j];
-	dblSum += inbuf.flp[-j] * mask[-j];
-      }
-      inbuf.flp++;
-      i++;
-      switch( stwspc->outbuf.type ){
-      case WLZ_GREY_INT:
-	*outbuf.inp++ = (int )(dblSum/factor);
-	break;
-      case WLZ_GREY_SHORT:
-	*outbuf.shp++ = (short )(dblSum/factor);
-	break;
-      case WLZ_GREY_UBYTE:
-	*outbuf.ubp++ = (WlzUByte )(dblSum/factor);
-	break;
-      case WLZ_GREY_FLOAT:
-	*outbuf.flp++ = (float )(dblSum/factor);
-	break;
-      case WLZ_GREY_DOUBLE:
-	*outbuf.dbp++ = dblSum/factor;
-	break;
-      case WLZ_GREY_RGBA:
-	red = (WlzUInt )WLZ_CLAMP(dblSum/factor, 0, 255);
-	WLZ_RGBA_RGBA_SET(*outbuf.rgbp, red, red, red, 255);
-	outbuf.rgbp++;
-	break;
-      default:
-        return WLZ_ERR_GREY_TYPE;
-	break;
-      }
-    }      
     break;
 
+  case WLZ_GREY_FLOAT:  /* FALLTHROUGH */
   case WLZ_GREY_DOUBLE:
-
-    /* first convolve up to the half-width of the mask */
-    for(i=0; (i < n) && (i < length); i++){
-      dblSum = *inbuf.dbp * mask[0];
-      for(j=1; j <= n; j++){
-	dblSum += inbuf.dbp[(j+i)>(length-1)?-i+length-1:j] * mask[j];
-	dblSum += inbuf.dbp[-((i>j)?j:i)] * mask[-j];
-      }
-      inbuf.dbp++;
-      switch( stwspc->outbuf.type ){
-      case WLZ_GREY_INT:
-	*outbuf.inp++ = (int )(dblSum/factor);
-	break;
-      case WLZ_GREY_SHORT:
-	*outbuf.shp++ = (short )(dblSum/factor);
-	break;
-      case WLZ_GREY_UBYTE:
-	*outbuf.ubp++ = (WlzUByte )(dblSum/factor);
-	break;
-      case WLZ_GREY_FLOAT:
-	*outbuf.flp++ = (float )(dblSum/factor);
-	break;
-      case WLZ_GREY_DOUBLE:
-	*outbuf.dbp++ = dblSum/factor;
-	break;
-      case WLZ_GREY_RGBA:
-	red = (WlzUInt )WLZ_CLAMP(dblSum/factor, 0, 255);
-	WLZ_RGBA_RGBA_SET(*outbuf.rgbp, red, red, red, 255);
-	outbuf.rgbp++;
-	break;
-      default:
-        return WLZ_ERR_GREY_TYPE;
-	break;
-      }
+    for(i = 0; (errNum == WLZ_ERR_NONE) && (i < length);
+        i += WLZ_GAUSS_CONV_BLKSZ)
+    {
+      if((blkSz = length - i) > WLZ_GAUSS_CONV_BLKSZ)
+      {
+	blkSz = WLZ_GAUSS_CONV_BLKSZ;
+      }
+      if(stwspc->inbuf.type == WLZ_GREY_FLOAT)
+      {
+	WLZ_GAUSS_CONV_BLK(dblBlk, float, inbuf.flp, mask, n, length,
+			   i, blkSz, 0, j, k);
+      }
+      else
+      {
+	WLZ_GAUSS_CONV_BLK(dblBlk, double, inbuf.dbp, mask, n, length,
+			   i, blkSz, 0, j, k);
+      }
+      errNum = WlzGaussConvStoreD(stwspc->outbuf, i, dblBlk, blkSz, factor);
     }
-
-    /* now the central portion */
-    while( i < (length-n-1) ){
-      dblSum = *inbuf.dbp * mask[0];
-      for(j=1; j <= n; j++){
-	dblSum += inbuf.dbp[j] * mask[j];
-	dblSum += inbuf.dbp[-j] * mask[-j];
-      }
-      inbuf.dbp++;
-      i++;
-      switch( stwspc->outbuf.type ){
-      case WLZ_GREY_INT:
-	*outbuf.inp++ = (int )(dblSum/factor);
-	break;
-      case WLZ_GREY_SHORT:
-	*outbuf.shp++ = (short )(dblSum/factor);
-	break;
-      case WLZ_GREY_UBYTE:
-	*outbuf.ubp++ = (WlzUByte )(dblSum/factor);
-	break;
-      case WLZ_GREY_FLOAT:
-	*outbuf.flp++ = (float )(dblSum/factor);
-	break;
-      case WLZ_GREY_DOUBLE:
-	*outbuf.dbp++ = dblSum/factor;
-	break;
-      case WLZ_GREY_RGBA:
-	red = (WlzUInt )WLZ_CLAMP(dblSum/factor, 0, 255);
-	WLZ_RGBA_RGBA_SET(*outbuf.rgbp, red, red, red, 255);
-	outbuf.rgbp++;
-	break;
-      default:
-        return WLZ_ERR_GREY_TYPE;
-	break;
-      }
-    }   
-
-    /* now the last bit within a half-width of the end */
-    while( i < length ){
-      dblSum = *inbuf.dbp * mask[0];
-      for(j=1; j <= n; j++){
-	dblSum += inbuf.dbp[(j+i)>(length-1)?-i+length-1:j] * mask[j];
-	dblSum += inbuf.dbp[-j] * mask[-j];
-      }
-      inbuf.dbp++;
-      i++;
-      switch( stwspc->outbuf.type ){
-      case WLZ_GREY_INT:
-	*outbuf.inp++ = (int )(dblSum/factor);
-	break;
-      case WLZ_GREY_SHORT:
-	*outbuf.shp++ = (short )(dblSum/factor);
-	break;
-      case WLZ_GREY_UBYTE:
-	*outbuf.ubp++ = (WlzUByte )(dblSum/factor);
-	break;
-      case WLZ_GREY_FLOAT:
-	*outbuf.flp++ = (float )(dblSum/factor);
-	break;
-      case WLZ_GREY_DOUBLE:
-	*outbuf.dbp++ = dblSum/factor;
-	break;
-      case WLZ_GREY_RGBA:
-	red = (WlzUInt )WLZ_CLAMP(dblSum/factor, 0, 255);
-	WLZ_RGBA_RGBA_SET(*outbuf.rgbp, red, red, red, 255);
-	outbuf.rgbp++;
-	break;
-      default:
-        return WLZ_ERR_GREY_TYPE;
-	break;
-      }
-    }      
     break;
 
   case WLZ_GREY_RGBA:
@@ -992,5 +606,143 @@ WlzErrorNum Wlz1DConv(
     break;
   }
 
-  return WLZ_ERR_NONE;
+  return errNum;
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Normalises a block of integer convolution sums and stores
+* 		them in the output buffer of the separable transform
+* 		workspace.
+* \param	outbuf			Output buffer.
+* \param	off			Offset of the block in the output
+* 					buffer.
+* \param	blk			Block of sums.
+* \param	cnt			Number of sums in the block.
+* \param	factor			Normalisation factor.
+*/
+static WlzErrorNum WlzGaussConvStoreI(WlzPixelP outbuf, int off,
+				      int *blk, int cnt, int factor)
+{
+  int		k;
+  double	dFactor;
+  WlzUInt	red;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  /* The quotient of two integers with magnitudes less than 2^53 is
+   * truncated to the same integer by double precision division as by
+   * integer division, but double precision division vectorises. */
+  dFactor = factor;
+
+  switch(outbuf.type)
+  {
+    case WLZ_GREY_INT:
+      for(k = 0; k < cnt; ++k)
+      {
+	outbuf.p.inp[off + k] = (int )(blk[k] / dFactor);
+      }
+      break;
+    case WLZ_GREY_SHORT:
+      for(k = 0; k < cnt; ++k)
+      {
+	outbuf.p.shp[off + k] = (short )((int )(blk[k] / dFactor));
+      }
+      break;
+    case WLZ_GREY_UBYTE:
+      for(k = 0; k < cnt; ++k)
+      {
+	outbuf.p.ubp[off + k] = (WlzUByte )((int )(blk[k] / dFactor));
+      }
+      break;
+    case WLZ_GREY_FLOAT:
+      for(k = 0; k < cnt; ++k)
+      {
+	outbuf.p.flp[off + k] = (float )((int )(blk[k] / dFactor));
+      }
+      break;
+    case WLZ_GREY_DOUBLE:
+      for(k = 0; k < cnt; ++k)
+      {
+	outbuf.p.dbp[off + k] = (int )(blk[k] / dFactor);
+      }
+      break;
+    case WLZ_GREY_RGBA:
+      for(k = 0; k < cnt; ++k)
+      {
+	red = (WlzUInt )WLZ_CLAMP((int )(blk[k] / dFactor), 0, 255);
+	WLZ_RGBA_RGBA_SET(outbuf.p.rgbp[off + k], red, red, red, 255);
+      }
+      break;
+    default:
+      errNum = WLZ_ERR_GREY_TYPE;
+      break;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Normalises a block of floating point convolution sums
+* 		and stores them in the output buffer of the separable
+* 		transform workspace.
+* \param	outbuf			Output buffer.
+* \param	off			Offset of the block in the output
+* 					buffer.
+* \param	blk			Block of sums.
+* \param	cnt			Number of sums in the block.
+* \param	factor			Normalisation factor.
+*/
+static WlzErrorNum WlzGaussConvStoreD(WlzPixelP outbuf, int off,
+				      double *blk, int cnt, int factor)
+{
+  int		k;
+  WlzUInt	red;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  switch(outbuf.type)
+  {
+    case WLZ_GREY_INT:
+      for(k = 0; k < cnt; ++k)
+      {
+	outbuf.p.inp[off + k] = (int )(blk[k] / factor);
+      }
+      break;
+    case WLZ_GREY_SHORT:
+      for(k = 0; k < cnt; ++k)
+      {
+	outbuf.p.shp[off + k] = (short )(blk[k] / factor);
+      }
+      break;
+    case WLZ_GREY_UBYTE:
+      for(k = 0; k < cnt; ++k)
+      {
+	outbuf.p.ubp[off + k] = (WlzUByte )(blk[k] / factor);
+      }
+      break;
+    case WLZ_GREY_FLOAT:
+      for(k = 0; k < cnt; ++k)
+      {
+	outbuf.p.flp[off + k] = (float )(blk[k] / factor);
+      }
+      break;
+    case WLZ_GREY_DOUBLE:
+      for(k = 0; k < cnt; ++k)
+      {
+	outbuf.p.dbp[off + k] = blk[k] / factor;
+      }
+      break;
+    case WLZ_GREY_RGBA:
+      for(k = 0; k < cnt; ++k)
+      {
+	red = (WlzUInt )WLZ_CLAMP(blk[k] / factor, 0, 255);
+	WLZ_RGBA_RGBA_SET(outbuf.p.rgbp[off + k], red, red, red, 255);
+      }
+      break;
+    default:
+      errNum = WLZ_ERR_GREY_TYPE;
+      break;
+  }
+  return(errNum);
 }
@@ -44,10 +44,31 @@ static char _WlzGreyRange_c[] = "University of Edinburgh $Id$";
 #include <stdlib.h>
 #include <Wlz.h>
 
+static void			WlzGreyRangeRGBA(
+				  WlzUInt *min,
+				  WlzUInt *max,
+				  WlzUInt v);
+static void			WlzGreyRangeMerge(
+				  WlzPixelV *min,
+				  WlzPixelV *max,
+				  WlzPixelV pMin,
+				  WlzPixelV pMax);
+static WlzErrorNum		WlzGreyRangePart(
+				  WlzObject *obj,
+				  WlzIntervalScanPart *part,
+				  WlzPixelV *dstMin,
+				  WlzPixelV *dstMax,
+				  int *dstFound);
+
 /* function:     WlzGreyRange    */
 /*! 
 * \ingroup      WlzValuesFilters
 * \brief        compute grey-range of a pixel/voxel object.
+*		The object's intervals are partitioned using
+*		WlzMakeIntervalScanParts(), the range of each part is
+*		computed in parallel and the part ranges are then merged.
+*		The minimum and maximum values are only set if the
+*		object has at least one pixel/voxel value.
 *
 * \return       Woolz error number: WLZ_ERR_NONE, WLZ_ERR_OBJECT_NULL,
  WLZ_ERR_DOMAIN_NULL, WLZ_ERR_VALUES_NULL, WLZ_ERR_GREY_TYPE, 
@@ -62,18 +83,16 @@ WlzErrorNum WlzGreyRange(WlzObject	*obj,
 			 WlzPixelV	*min,
 			 WlzPixelV	*max)
 {
-  WlzGreyV		v;
-  WlzGreyP		g;
-  int			i, nplanes, init_flag;
-  WlzPixelV		lmin, lmax, Min, Max;
-  WlzIntervalWSpace	iwsp;
-  WlzGreyWSpace		gwsp;
-  WlzObject		tempobj;
-  WlzPlaneDomain	*planedm;
-  WlzValues 		*values;
-  WlzDomain		*domains;
-  WlzGreyType		gType;
-  WlzErrorNum		errNum;
+  int			i,
+  			init_flag = 0,
+			nParts = 0;
+  int			*pFound = NULL;
+  WlzPixelV		lmin,
+  			lmax;
+  WlzPixelV		*pMin = NULL,
+  			*pMax = NULL;
+  WlzIntervalScanPart	*parts = NULL;
+  WlzErrorNum		errNum = WLZ_ERR_NONE;
 
   /* check for NULL object */
   if( obj == NULL ){
@@ -91,315 +110,307 @@ WlzErrorNum WlzGreyRange(WlzObject	*obj,
     return( WLZ_ERR_VALUES_TYPE );
   }
     
-  init_flag = 0;
   switch( obj->type ){
 
   case WLZ_2D_DOMAINOBJ:
-    errNum = WlzInitGreyScan(obj, &iwsp, &gwsp);
-    if(errNum == WLZ_ERR_NONE) {
-      lmin.type = gwsp.pixeltype;
-      lmax.type = gwsp.pixeltype;
-      while( (errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE ){
-	g = gwsp.u_grintptr;
-	switch( gwsp.pixeltype ){
-
-	case WLZ_GREY_INT:
-	  for(i=0; i<iwsp.colrmn; i++){
-	    v.inv = *g.inp++;
-	    if( !init_flag ){
-	      lmin.v.inv = v.inv;
-	      lmax.v.inv = v.inv;
-	      init_flag = 1;
-	    }
-	    else if( v.inv > lmax.v.inv ){
-	      lmax.v.inv = v.inv;
-	    }
-	    else if( v.inv < lmin.v.inv ){
-	      lmin.v.inv = v.inv;
-	    }
-	  }
-	  break;
-
-	case WLZ_GREY_SHORT:
-	  for(i=0; i<iwsp.colrmn; i++){
-	    v.shv = *g.shp++;
-	    if( !init_flag ){
-	      lmin.v.shv = v.shv;
-	      lmax.v.shv = v.shv;
-	      init_flag = 1;
-	    }
-	    else if( v.shv > lmax.v.shv ){
-	      lmax.v.shv = v.shv;
-	    }
-	    else if( v.shv < lmin.v.shv ){
-	      lmin.v.shv = v.shv;
-	    }
-	  }
-	  break;
-
-	case WLZ_GREY_UBYTE:
-	  for(i=0; i<iwsp.colrmn; i++){
-	    v.ubv = *g.ubp++;
-	    if( !init_flag ){
-	      lmin.v.ubv = v.ubv;
-	      lmax.v.ubv = v.ubv;
-	      init_flag = 1;
-	    }
-	    else if( v.ubv > lmax.v.ubv ){
-	      lmax.v.ubv = v.ubv;
-	    }
-	    else if( v.ubv < lmin.v.ubv ){
-	      lmin.v.ubv = v.ubv;
-	    }
-	  }
-	  break;
+    break;
 
-	case WLZ_GREY_FLOAT:
-	  for(i=0; i<iwsp.colrmn; i++){
-	    v.flv = *g.flp++;
-	    if( !init_flag ){
-	      lmin.v.flv = v.flv;
-	      lmax.v.flv = v.flv;
-	      init_flag = 1;
-	    }
-	    else if( v.flv > lmax.v.flv ){
-	      lmax.v.flv = v.flv;
-	    }
-	    else if( v.flv < lmin.v.flv ){
-	      lmin.v.flv = v.flv;
-	    }
-	  }
-	  break;
+  case WLZ_3D_DOMAINOBJ:
+    if( obj->domain.p->type != WLZ_PLANEDOMAIN_DOMAIN ){
+      return( WLZ_ERR_PLANEDOMAIN_TYPE );
+    }
+    if( obj->values.vox->type != WLZ_VOXELVALUETABLE_GREY ){
+      return( WLZ_ERR_VOXELVALUES_TYPE );
+    }
+    break;
 
-	case WLZ_GREY_DOUBLE:
-	  for(i=0; i<iwsp.colrmn; i++){
-	    v.dbv = *g.dbp++;
-	    if( !init_flag ){
-	      lmin.v.dbv = v.dbv;
-	      lmax.v.dbv = v.dbv;
-	      init_flag = 1;
-	    }
-	    else if( v.dbv > lmax.v.dbv ){
-	      lmax.v.dbv = v.dbv;
-	    }
-	    else if( v.dbv < lmin.v.dbv ){
-	      lmin.v.dbv = v.dbv;
-	    }
-	  }
-	  break;
+  case WLZ_TRANS_OBJ:
+    return( WlzGreyRange(obj->values.obj, min, max) );
 
-	case WLZ_GREY_RGBA:
-	  for(i=0; i<iwsp.colrmn; i++){
-	    v.rgbv = *g.rgbp++;
-	    if( !init_flag ){
-	      lmin.v.rgbv = v.rgbv;
-	      lmax.v.rgbv = v.rgbv;
-	      init_flag = 1;
-	    }
-	    else {
-	      /* red */
-	      if( (v.rgbv&0xff) > (lmax.v.rgbv&0xff) ){
-		lmax.v.rgbv = (lmax.v.rgbv&0xffffff00) + (v.rgbv&0xff);
-	      }
-	      else if( (v.rgbv&0xff) < (lmin.v.rgbv&0xff) ){
-		lmin.v.rgbv = (lmin.v.rgbv&0xffffff00) + (v.rgbv&0xff);
-	      }
+  case WLZ_EMPTY_OBJ:
+    return WLZ_ERR_NONE;
 
-	      /* green */
-	      if( (v.rgbv&0xff00) > (lmax.v.rgbv&0xff00) ){
-		lmax.v.rgbv = (lmax.v.rgbv&0xffff00ff) + (v.rgbv&0xff00);
-	      }
-	      else if( (v.rgbv&0xff00) < (lmin.v.rgbv&0xff00) ){
-		lmin.v.rgbv = (lmin.v.rgbv&0xffff00ff) + (v.rgbv&0xff00);
-	      }
+  default:
+    return( WLZ_ERR_OBJECT_TYPE );
 
-	      /* blue */
-	      if( (v.rgbv&0xff0000) > (lmax.v.rgbv&0xff0000) ){
-		lmax.v.rgbv = (lmax.v.rgbv&0xff00ffff) + (v.rgbv&0xff0000);
-	      }
-	      else if( (v.rgbv&0xff0000) < (lmin.v.rgbv&0xff0000) ){
-		lmin.v.rgbv = (lmin.v.rgbv&0xff00ffff) + (v.rgbv&0xff0000);
-	      }
+  }
 
-	      /* alpha */
-	      if( (v.rgbv&0xff000000) > (lmax.v.rgbv&0xff000000) ){
-		lmax.v.rgbv = (lmax.v.rgbv&0xffffff00) + (v.rgbv&0xff000000);
-	      }
-	      else if( (v.rgbv&0xff000000) < (lmin.v.rgbv&0xff000000) ){
-		lmin.v.rgbv = (lmin.v.rgbv&0x00ffffff) + (v.rgbv&0xff000000);
-	      }
+  parts = WlzMakeIntervalScanParts(obj, 0, &nParts, &errNum);
+  if( (errNum == WLZ_ERR_NONE) && (nParts > 0) ){
+    if(((pFound = (int *)AlcMalloc(nParts * sizeof(int))) == NULL) ||
+       ((pMin = (WlzPixelV *)
+                AlcMalloc(2 * nParts * sizeof(WlzPixelV))) == NULL)){
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else {
+      pMax = pMin + nParts;
+    }
+  }
+  if( errNum == WLZ_ERR_NONE ){
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(i = 0; i < nParts; ++i){
+      if(errNum == WLZ_ERR_NONE){
+	WlzErrorNum errNum2;
+
+	errNum2 = WlzGreyRangePart(obj, parts + i, pMin + i, pMax + i,
+				   pFound + i);
+	if(errNum2 != WLZ_ERR_NONE){
+#ifdef _OPENMP
+#pragma omp critical (WlzGreyRange)
+#endif
+	  {
+	    if(errNum == WLZ_ERR_NONE){
+	      errNum = errNum2;
 	    }
 	  }
-	  break;
-
-	default:
-	  return( WLZ_ERR_GREY_TYPE );
-
 	}
       }
-      (void )WlzEndGreyScan(&iwsp, &gwsp);
-      if(errNum == WLZ_ERR_EOO)		/* Reset error from end of intervals */
-      {
-	errNum = WLZ_ERR_NONE;
-      }
     }
-    *min = lmin;
-    *max = lmax;
-    break;
-
-  case WLZ_3D_DOMAINOBJ:
-    planedm = obj->domain.p;
-    switch( planedm->type ){
-
-    case WLZ_PLANEDOMAIN_DOMAIN:
-      nplanes = planedm->lastpl - planedm->plane1 + 1;
-      domains = planedm->domains;
-      if( obj->values.vox->type != WLZ_VOXELVALUETABLE_GREY ){
-	return( WLZ_ERR_VOXELVALUES_TYPE );
-      }
-      values = obj->values.vox->values;
-      tempobj.type = WLZ_2D_DOMAINOBJ;
-      tempobj.plist = NULL;
-      tempobj.assoc = NULL;
-      for(i=0; i < nplanes; i++, domains++, values++){
-	if( (*domains).core == NULL || (*values).core == NULL ){
-	  continue;
-	}
-
-	tempobj.domain = *domains;
-	tempobj.values = *values;
-	errNum = WlzGreyRange(&tempobj, &Min, &Max);
-	if( errNum != WLZ_ERR_NONE ){
-	  return( errNum );
-	}
+  }
+  if( errNum == WLZ_ERR_NONE ){
+    for(i = 0; i < nParts; ++i){
+      if( pFound[i] ){
 	if( !init_flag ){
-	  lmin = Min;
-	  lmax = Max;
+	  lmin = pMin[i];
+	  lmax = pMax[i];
 	  init_flag = 1;
-	  continue;
 	}
-	
-	gType = WlzGreyTableTypeToGreyType((*values).v->type, &errNum);
-	if(errNum != WLZ_ERR_NONE)
-	{
-	  return(errNum);
+	else {
+	  WlzGreyRangeMerge(&lmin, &lmax, pMin[i], pMax[i]);
 	}
-	switch(gType){
+      }
+    }
+    if( init_flag ){
+      *min = lmin;
+      *max = lmax;
+    }
+  }
+  AlcFree(parts);
+  AlcFree(pFound);
+  AlcFree(pMin);
 
-	case WLZ_GREY_INT:
-	  if( Min.v.inv < lmin.v.inv ){
-	    lmin.v.inv = Min.v.inv;
-	  }
-	  if( Max.v.inv > lmax.v.inv ){
-	    lmax.v.inv = Max.v.inv;
-	  }
-	  break;
+  return( errNum );
+}
 
-	case WLZ_GREY_SHORT:
-	  if( Min.v.shv < lmin.v.shv ){
-	    lmin.v.shv = Min.v.shv;
-	  }
-	  if( Max.v.shv > lmax.v.shv ){
-	    lmax.v.shv = Max.v.shv;
-	  }
-	  break;
+/*!
+* \ingroup	WlzValuesFilters
+* \brief	Updates the independent per channel minimum and maximum of
+*		RGBA values using the given value.
+* \param	min			Minimum RGBA value.
+* \param	max			Maximum RGBA value.
+* \param	v			Given RGBA value.
+*/
+static void	WlzGreyRangeRGBA(WlzUInt *min, WlzUInt *max, WlzUInt v)
+{
+  int		sft;
 
-	case WLZ_GREY_UBYTE:
-	  if( Min.v.ubv < lmin.v.ubv ){
-	    lmin.v.ubv = Min.v.ubv;
-	  }
-	  if( Max.v.ubv > lmax.v.ubv ){
-	    lmax.v.ubv = Max.v.ubv;
-	  }
-	  break;
+  for(sft = 0; sft < 32; sft += 8){
+    WlzUInt	msk;
 
-	case WLZ_GREY_FLOAT:
-	  if( Min.v.flv < lmin.v.flv ){
-	    lmin.v.flv = Min.v.flv;
-	  }
-	  if( Max.v.flv > lmax.v.flv ){
-	    lmax.v.flv = Max.v.flv;
-	  }
-	  break;
+    msk = ((WlzUInt )0xff) << sft;
+    if( (v & msk) < (*min & msk) ){
+      *min = (*min & ~msk) | (v & msk);
+    }
+    if( (v & msk) > (*max & msk) ){
+      *max = (*max & ~msk) | (v & msk);
+    }
+  }
+}
+
+/*!
+* \ingroup	WlzValuesFilters
+* \brief	Merges the range of a part of an object into the range
+*		accumulated so far.
+* \param	min			Accumulated minimum value.
+* \param	max			Accumulated maximum value.
+* \param	pMin			Minimum value of the part.
+* \param	pMax			Maximum value of the part.
+*/
+static void	WlzGreyRangeMerge(WlzPixelV *min, WlzPixelV *max,
+				  WlzPixelV pMin, WlzPixelV pMax)
+{
+  switch(min->type){
+  case WLZ_GREY_INT:
+    min->v.inv = WLZ_MIN(min->v.inv, pMin.v.inv);
+    max->v.inv = WLZ_MAX(max->v.inv, pMax.v.inv);
+    break;
+  case WLZ_GREY_SHORT:
+    min->v.shv = WLZ_MIN(min->v.shv, pMin.v.shv);
+    max->v.shv = WLZ_MAX(max->v.shv, pMax.v.shv);
+    break;
+  case WLZ_GREY_UBYTE:
+    min->v.ubv = WLZ_MIN(min->v.ubv, pMin.v.ubv);
+    max->v.ubv = WLZ_MAX(max->v.ubv, pMax.v.ubv);
+    break;
+  case WLZ_GREY_FLOAT:
+    min->v.flv = WLZ_MIN(min->v.flv, pMin.v.flv);
+    max->v.flv = WLZ_MAX(max->v.flv, pMax.v.flv);
+    break;
+  case WLZ_GREY_DOUBLE:
+    min->v.dbv = WLZ_MIN(min->v.dbv, pMin.v.dbv);
+    max->v.dbv = WLZ_MAX(max->v.dbv, pMax.v.dbv);
+    break;
+  case WLZ_GREY_RGBA:
+    WlzGreyRangeRGBA(&(min->v.rgbv), &(max->v.rgbv), pMin.v.rgbv);
+    WlzGreyRangeRGBA(&(min->v.rgbv), &(max->v.rgbv), pMax.v.rgbv);
+    break;
+  default:
+    break;
+  }
+}
 
-	case WLZ_GREY_DOUBLE:
-	  if( Min.v.dbv < lmin.v.dbv ){
-	    lmin.v.dbv = Min.v.dbv;
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Computes the grey range of a single part of an object.
+* \param	obj			Given object.
+* \param	part			Part of the object.
+* \param	dstMin			Destination pointer for the
+*					minimum value.
+* \param	dstMax			Destination pointer for the
+*					maximum value.
+* \param	dstFound		Destination pointer set non-zero
+*					if the part had any values.
+*/
+static WlzErrorNum WlzGreyRangePart(WlzObject *obj,
+				    WlzIntervalScanPart *part,
+				    WlzPixelV *dstMin,
+				    WlzPixelV *dstMax,
+				    int *dstFound)
+{
+  int			i,
+  			init_flag = 0;
+  WlzGreyV		v;
+  WlzGreyP		g;
+  WlzPixelV		lmin,
+  			lmax;
+  WlzObject		tempobj;
+  WlzIntervalWSpace	iwsp;
+  WlzGreyWSpace		gwsp;
+  WlzErrorNum		errNum;
+
+  errNum = WlzInitGreyScanPart(obj, part, &tempobj, &iwsp, &gwsp,
+  			       WLZ_RASTERDIR_ILIC, 0);
+  if(errNum == WLZ_ERR_NONE) {
+    lmin.type = gwsp.pixeltype;
+    lmax.type = gwsp.pixeltype;
+    while( (errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE ){
+      g = gwsp.u_grintptr;
+      switch( gwsp.pixeltype ){
+
+      case WLZ_GREY_INT:
+	if( !init_flag ){
+	  lmin.v.inv = lmax.v.inv = *g.inp;
+	  init_flag = 1;
+	}
+	for(i=0; i<iwsp.colrmn; i++){
+	  v.inv = *g.inp++;
+	  if( v.inv < lmin.v.inv ){
+	    lmin.v.inv = v.inv;
 	  }
-	  if( Max.v.dbv > lmax.v.dbv ){
-	    lmax.v.dbv = Max.v.dbv;
+	  else if( v.inv > lmax.v.inv ){
+	    lmax.v.inv = v.inv;
 	  }
-	  break;
+	}
+	break;
 
-	case WLZ_GREY_RGBA:
-	  /* red */
-	  if( (Min.v.rgbv&0xff) < (lmin.v.rgbv&0xff) ){
-	    lmin.v.rgbv &= ~0xff;
-	    lmin.v.rgbv |= (Min.v.rgbv&0xff);
+      case WLZ_GREY_SHORT:
+	if( !init_flag ){
+	  lmin.v.shv = lmax.v.shv = *g.shp;
+	  init_flag = 1;
+	}
+	for(i=0; i<iwsp.colrmn; i++){
+	  v.shv = *g.shp++;
+	  if( v.shv < lmin.v.shv ){
+	    lmin.v.shv = v.shv;
 	  }
-	  if( (Max.v.rgbv&0xff) > (lmax.v.rgbv&0xff) ){
-	    lmin.v.rgbv &= ~0xff;
-	    lmin.v.rgbv |= (Max.v.rgbv&0xff);
+	  else if( v.shv > lmax.v.shv ){
+	    lmax.v.shv = v.shv;
 	  }
+	}
+	break;
 
-	  /* green */
-	  if( (Min.v.rgbv&0xff00) < (lmin.v.rgbv&0xff00) ){
-	    lmin.v.rgbv &= ~0xff00;
-	    lmin.v.rgbv |= (Min.v.rgbv&0xff00);
+      case WLZ_GREY_UBYTE:
+	if( !init_flag ){
+	  lmin.v.ubv = lmax.v.ubv = *g.ubp;
+	  init_flag = 1;
+	}
+	for(i=0; i<iwsp.colrmn; i++){
+	  v.ubv = *g.ubp++;
+	  if( v.ubv < lmin.v.ubv ){
+	    lmin.v.ubv = v.ubv;
 	  }
-	  if( (Max.v.rgbv&0xff00) > (lmax.v.rgbv&0xff00) ){
-	    lmin.v.rgbv &= ~0xff00;
-	    lmin.v.rgbv |= (Max.v.rgbv&0xff00);
+	  else if( v.ubv > lmax.v.ubv ){
+	    lmax.v.ubv = v.ubv;
 	  }
+	}
+	break;
 
-	  /* blue */
-	  if( (Min.v.rgbv&0xff0000) < (lmin.v.rgbv&0xff0000) ){
-	    lmin.v.rgbv &= ~0xff0000;
-	    lmin.v.rgbv |= (Min.v.rgbv&0xff0000);
+      case WLZ_GREY_FLOAT:
+	if( !init_flag ){
+	  lmin.v.flv = lmax.v.flv = *g.flp;
+	  init_flag = 1;
+	}
+	for(i=0; i<iwsp.colrmn; i++){
+	  v.flv = *g.flp++;
+	  if( v.flv < lmin.v.flv ){
+	    lmin.v.flv = v.flv;
 	  }
-	  if( (Max.v.rgbv&0xff0000) > (lmax.v.rgbv&0xff0000) ){
-	    lmin.v.rgbv &= ~0xff0000;
-	    lmin.v.rgbv |= (Max.v.rgbv&0xff0000);
+	  else if( v.flv > lmax.v.flv ){
+	    lmax.v.flv = v.flv;
 	  }
+	}
+	break;
 
-	  /* alpha */
-	  if( (Min.v.rgbv&0xff000000) < (lmin.v.rgbv&0xff000000) ){
-	    lmin.v.rgbv &= ~0xff000000;
-	    lmin.v.rgbv |= (Min.v.rgbv&0xff000000);
+      case WLZ_GREY_DOUBLE:
+	if( !init_flag ){
+	  lmin.v.dbv = lmax.v.dbv = *g.dbp;
+	  init_flag = 1;
+	}
+	for(i=0; i<iwsp.colrmn; i++){
+	  v.dbv = *g.dbp++;
+	  if( v.dbv < lmin.v.dbv ){
+	    lmin.v.dbv = v.dbv;
 	  }
-	  if( (Max.v.rgbv&0xff000000) > (lmax.v.rgbv&0xff000000) ){
-	    lmin.v.rgbv &= ~0xff000000;
-	    lmin.v.rgbv |= (Max.v.rgbv&0xff000000);
+	  else if( v.dbv > lmax.v.dbv ){
+	    lmax.v.dbv = v.dbv;
 	  }
+	}
+	break;
 
-	  break;
-
-	default:
-	  errNum = WLZ_ERR_GREY_TYPE;
-	  return(errNum);
-	  /* break; */
+      case WLZ_GREY_RGBA:
+	if( !init_flag ){
+	  lmin.v.rgbv = lmax.v.rgbv = *g.rgbp;
+	  init_flag = 1;
 	}
-      }
-      break;
+	for(i=0; i<iwsp.colrmn; i++){
+	  WlzGreyRangeRGBA(&(lmin.v.rgbv), &(lmax.v.rgbv), *g.rgbp++);
+	}
+	break;
 
-    default:
-      return( WLZ_ERR_PLANEDOMAIN_TYPE );
+      default:
+	errNum = WLZ_ERR_GREY_TYPE;
+	break;
 
+      }
+      if( errNum != WLZ_ERR_NONE ){
+	break;
+      }
+    }
+    (void )WlzEndGreyScan(&iwsp, &gwsp);
+    if(errNum == WLZ_ERR_EOO)		/* Reset error from end of intervals */
+    {
+      errNum = WLZ_ERR_NONE;
     }
-    *min = lmin;
-    *max = lmax;
-    break;
-
-  case WLZ_TRANS_OBJ:
-    return( WlzGreyRange(obj->values.obj, min, max) );
-
-  case WLZ_EMPTY_OBJ:
-    return WLZ_ERR_NONE;
-
-  default:
-    return( WLZ_ERR_OBJECT_TYPE );
-
   }
-
-  return( WLZ_ERR_NONE );
+  if( errNum == WLZ_ERR_NONE ){
+    *dstFound = init_flag;
+    if( init_flag ){
+      *dstMin = lmin;
+      *dstMax = lmax;
+    }
+  }
+  return( errNum );
 }
@@ -131,6 +131,48 @@ WlzInitGreyRasterScan(WlzObject 	*obj,
   return(WlzInitGreyWSpace(obj,iwsp,gwsp,tranpl));
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	As WlzInitGreyRasterScan(), but only initialises scanning
+*		of a single part of the object, as computed by
+*		WlzMakeIntervalScanParts(). Workspaces initialised for
+*		different parts may be used concurrently.
+*		WlzEndGreyScan() must be called when the scan of the
+*		part is complete.
+* \param	obj			Object from which the parts were
+*					computed.
+* \param	part			The part to be scanned.
+* \param	obj2D			Storage for a 2D object which is
+*					set to the part's plane of a 3D
+*					object, this must remain valid
+*					until the scan is complete.
+*					May be NULL for 2D objects.
+* \param	iwsp			Interval scanning workspace.
+* \param	gwsp			Grey value table scanning workspace.
+* \param	raster			Direction for the raster scan.
+* \param	tranpl			Flag to allow overwriting of
+*					grey-values.
+*/
+WlzErrorNum
+WlzInitGreyScanPart(WlzObject		*obj,
+		    WlzIntervalScanPart	*part,
+		    WlzObject		*obj2D,
+		    WlzIntervalWSpace	*iwsp,
+		    WlzGreyWSpace	*gwsp,
+		    WlzRasterDir	raster,
+		    int			tranpl)
+{
+  WlzErrorNum	errNum;
+
+  if((errNum = WlzInitRasterScanPart(obj, part, obj2D,
+  				     iwsp, raster)) != WLZ_ERR_NONE)
+  {
+    return(errNum);
+  }
+  return(WlzInitGreyWSpace(iwsp->objaddr, iwsp, gwsp, tranpl));
+}
+
 /*! 
 * \return       Woolz error code.
 * \ingroup      WlzValuesUtils
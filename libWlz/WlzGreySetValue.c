@@ -43,10 +43,18 @@ static char _WlzGreySetValue_c[] = "University of Edinburgh $Id$";
 #include <Wlz.h>
 
 
+static WlzErrorNum		WlzGreySetValuePart(
+				  WlzObject *obj,
+				  WlzIntervalScanPart *part,
+				  WlzPixelV val);
+
 /*! 
 * \return       Woolz error code.
 * \ingroup      WlzValuesUtils
 * \brief        Set the grey value of every pixel/voxel to the given value.
+*		The object's intervals are partitioned using
+*		WlzMakeIntervalScanParts() and the parts are set in
+*		parallel.
 * \param    	obj				Input object.
 * \param    	val				New grey value.
 */
@@ -54,13 +62,9 @@ WlzErrorNum WlzGreySetValue(
   WlzObject	*obj,
   WlzPixelV	val)
 {
-  WlzIntervalWSpace	iwsp;
-  WlzGreyWSpace		gwsp;
-  WlzGreyP		gptr;
-  WlzPixelV		tmpVal;
-  WlzDomain		*domains;
-  WlzValues		*values;
-  int			i, nplanes;
+  int			i,
+  			nParts = 0;
+  WlzIntervalScanPart	*parts = NULL;
   WlzErrorNum		errNum=WLZ_ERR_NONE;
 
   /* check object */
@@ -96,55 +100,7 @@ WlzErrorNum WlzGreySetValue(
       else if( obj->values.core->type != WLZ_VOXELVALUETABLE_GREY ){
 	errNum = WLZ_ERR_VALUES_TYPE;
       }
-      else {
-	/* set range of each plane if non-empty - indicated by NULL */
-	domains = obj->domain.p->domains;
-	values = obj->values.vox->values;
-	nplanes = obj->domain.p->lastpl - obj->domain.p->plane1 + 1;
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-	for(i = 0; i < nplanes; ++i)
-	{
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    WlzDomain    *doms;
-	    WlzValues    *vals;
-	    WlzErrorNum  errNum2D = WLZ_ERR_NONE;
-
-	    doms = domains + i;
-	    vals = values + i;
-	    if(((*doms).core != NULL) && ((*vals).core != NULL))
-	    {
-	      WlzObject *obj2D = NULL;
-
-	      if((obj2D = WlzAssignObject(
-		      WlzMakeMain(WLZ_2D_DOMAINOBJ, *doms, *vals,
-			NULL, NULL,
-			&errNum2D), NULL)) != NULL)
-	      {
-		errNum2D = WlzGreySetValue(obj2D, val);
-	        (void )WlzFreeObj(obj2D);
-	      }
-#ifdef _OPENMP
-	      {
-		if(errNum2D != WLZ_ERR_NONE)
-		{
-#pragma omp critical
-		  {
-		    if(errNum == WLZ_ERR_NONE)
-		    {
-		      errNum = errNum2D;
-		    }
-		  }
-		}
-	      }
-#endif
-	    }
-	  }
-	}
-      }
-      return errNum;
+      break;
 
     case WLZ_TRANS_OBJ:
       return WlzGreySetValue(obj->values.obj, val);
@@ -159,8 +115,59 @@ WlzErrorNum WlzGreySetValue(
   }
 
   if( errNum == WLZ_ERR_NONE ){
-    errNum = WlzInitGreyScan(obj, &iwsp, &gwsp);
+    parts = WlzMakeIntervalScanParts(obj, 0, &nParts, &errNum);
+  }
+  if( errNum == WLZ_ERR_NONE ){
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(i = 0; i < nParts; ++i){
+      if(errNum == WLZ_ERR_NONE){
+	WlzErrorNum errNum2;
+
+	errNum2 = WlzGreySetValuePart(obj, parts + i, val);
+	if(errNum2 != WLZ_ERR_NONE){
+#ifdef _OPENMP
+#pragma omp critical (WlzGreySetValue)
+#endif
+	  {
+	    if(errNum == WLZ_ERR_NONE){
+	      errNum = errNum2;
+	    }
+	  }
+	}
+      }
+    }
   }
+  AlcFree(parts);
+
+  return errNum;
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	Sets the grey value of every pixel/voxel within a single
+*		part of an object to the given value.
+* \param	obj				Input object.
+* \param	part				Part of the object to set.
+* \param	val				New grey value.
+*/
+static WlzErrorNum WlzGreySetValuePart(
+  WlzObject		*obj,
+  WlzIntervalScanPart	*part,
+  WlzPixelV		val)
+{
+  int			i;
+  WlzObject		obj2D;
+  WlzIntervalWSpace	iwsp;
+  WlzGreyWSpace		gwsp;
+  WlzGreyP		gptr;
+  WlzPixelV		tmpVal;
+  WlzErrorNum		errNum;
+
+  errNum = WlzInitGreyScanPart(obj, part, &obj2D, &iwsp, &gwsp,
+			       WLZ_RASTERDIR_ILIC, 0);
   if( errNum == WLZ_ERR_NONE ){
     WlzValueConvertPixel(&tmpVal, val, gwsp.pixeltype);
     while( (errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE ){
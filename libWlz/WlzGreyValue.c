@@ -42,11 +42,36 @@ static char _WlzGreyValue_c[] = "University of Edinburgh $Id$";
 
 #include <stdlib.h>
 #include <limits.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include <Wlz.h>
 #ifndef WLZ_FAST_CODE
 #define WLZ_FAST_CODE
 #endif
 
+/*!
+* \struct	_WlzGreyValueNKey
+* \ingroup	WlzAccess
+* \brief	Sort key used to order the positions given to
+* 		WlzGreyValueGetN().
+*/
+typedef struct _WlzGreyValueNKey
+{
+  WlzLong	k0;			/*!< Primary key, the tile index
+  					     for tiled values, otherwise
+					     the plane. */
+  WlzLong	k1;			/*!< Secondary key, the position
+  					     within the tile or plane. */
+  int		idx;			/*!< Index of the position. */
+} WlzGreyValueNKey;
+
+static int			WlzGreyValueNKeyCmp(
+				  const void *p0,
+				  const void *p1);
+static double			WlzGreyValueToD(
+				  WlzGreyType gType,
+				  WlzGreyV gV);
 static void			WlzGreyValueSetBkdP(
 				  WlzGreyV *gVP,
 				  WlzGreyP *gPP,
@@ -73,16 +98,21 @@ static void			WlzGreyValueComputeGreyP2D(
 static void			WlzGreyValueComputeGreyPTiled2D(
 				  WlzGreyP *baseGVP,
 				  size_t *offset,
-				  WlzTiledValues *tVal,
+				  WlzGreyValueWSpace *gVWSp,
 				  int line,
 				  int kol);
 static void			WlzGreyValueComputeGreyPTiled3D(
 				  WlzGreyP *baseGVP,
 				  size_t *offset,
-				  WlzTiledValues *tVal,
+				  WlzGreyValueWSpace *gVWSp,
 				  int plane,
 				  int line,
 				  int kol);
+static void			WlzGreyValueTilesRelease(
+				  WlzGreyValueWSpace *gVWSp);
+static WlzErrorNum		WlzGreyValueTileTouch(
+				  WlzGreyValueWSpace *gVWSp,
+				  size_t idx);
 static void			WlzGreyValueGet2D1(
 				  WlzGreyValueWSpace *gVWSp,
 				  int line,
@@ -452,14 +482,175 @@ void		WlzGreyValueFreeWSp(WlzGreyValueWSpace *gVWSp)
 	    gVWSp));
   if(gVWSp)
   {
-    (void )WlzFreeAffineTransform(gVWSp->invTrans);
-    AlcFree((void *)(gVWSp->gTabTypes3D));
+    WlzGreyValueTilesRelease(gVWSp);
+    if(gVWSp->parent == NULL)
+    {
+      (void )WlzFreeAffineTransform(gVWSp->invTrans);
+      AlcFree((void *)(gVWSp->gTabTypes3D));
+    }
     AlcFree(gVWSp);
   }
   WLZ_DBG((WLZ_DBG_LVL_FN|WLZ_DBG_LVL_1),
   	  ("WlzGreyValueFreeWSp FX\n"));
 }
 
+/*!
+* \return	New grey value work space or NULL on error.
+* \ingroup	WlzAccess
+* \brief	Creates a lightweight clone of the given grey value work
+* 		space. The clone has it's own current plane and grey
+* 		pointers and values, so it may be used concurrently with
+* 		the given work space, but it shares the given work space's
+* 		plane table type cache and inverse transform. The given
+* 		work space must not be freed until all of it's clones
+* 		have been freed.
+* \param	gVWSp			Given grey value work space.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzGreyValueWSpace *WlzGreyValueCloneWSp(WlzGreyValueWSpace *gVWSp,
+				WlzErrorNum *dstErr)
+{
+  WlzGreyValueWSpace *cWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(gVWSp == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if((cWSp = (WlzGreyValueWSpace *)
+                  AlcMalloc(sizeof(WlzGreyValueWSpace))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    *cWSp = *gVWSp;
+    cWSp->nTile = 0;
+    cWSp->parent = (gVWSp->parent)? gVWSp->parent: gVWSp;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(cWSp);
+}
+
+/*!
+* \return	New grey value work space pool or NULL on error.
+* \ingroup	WlzAccess
+* \brief	Creates a pool of grey value work spaces for the given
+* 		object, with one work space per thread. A single work
+* 		space is created (see WlzGreyValueMakeWSp()) and the per
+* 		thread work spaces are cloned from it (see
+* 		WlzGreyValueCloneWSp()). Within a parallel region each
+* 		thread should get it's work space using
+* 		WlzGreyValueWSpPoolGet().
+* \param	obj			Given object.
+* \param	nWSp			Number of work spaces, if less than
+* 					one then the maximum number of
+* 					threads is used.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzGreyValueWSpPool *WlzGreyValueMakeWSpPool(WlzObject *obj, int nWSp,
+				WlzErrorNum *dstErr)
+{
+  WlzGreyValueWSpPool *pool = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(nWSp < 1)
+  {
+#ifdef _OPENMP
+    nWSp = omp_get_max_threads();
+#else
+    nWSp = 1;
+#endif
+  }
+  if(((pool = (WlzGreyValueWSpPool *)
+              AlcCalloc(1, sizeof(WlzGreyValueWSpPool))) == NULL) ||
+     ((pool->wSp = (WlzGreyValueWSpace **)
+                   AlcCalloc(nWSp, sizeof(WlzGreyValueWSpace *))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    pool->nWSp = nWSp;
+    pool->shared = WlzGreyValueMakeWSp(obj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idx;
+
+    for(idx = 0; idx < nWSp; ++idx)
+    {
+      if((pool->wSp[idx] = WlzGreyValueCloneWSp(pool->shared,
+                                                &errNum)) == NULL)
+      {
+        break;
+      }
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    WlzGreyValueFreeWSpPool(pool);
+    pool = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(pool);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Frees a grey value work space pool created by
+* 		WlzGreyValueMakeWSpPool().
+* \param	pool			Given grey value work space pool.
+*/
+void		WlzGreyValueFreeWSpPool(WlzGreyValueWSpPool *pool)
+{
+  if(pool)
+  {
+    if(pool->wSp)
+    {
+      int	idx;
+
+      for(idx = 0; idx < pool->nWSp; ++idx)
+      {
+        WlzGreyValueFreeWSp(pool->wSp[idx]);
+      }
+      AlcFree(pool->wSp);
+    }
+    WlzGreyValueFreeWSp(pool->shared);
+    AlcFree(pool);
+  }
+}
+
+/*!
+* \return	Grey value work space for the calling thread or NULL if
+* 		the pool has too few work spaces.
+* \ingroup	WlzAccess
+* \brief	Gets the grey value work space of the calling thread
+* 		from the given pool.
+* \param	pool			Given grey value work space pool.
+*/
+WlzGreyValueWSpace *WlzGreyValueWSpPoolGet(WlzGreyValueWSpPool *pool)
+{
+  int		thrId = 0;
+  WlzGreyValueWSpace *gVWSp = NULL;
+
+#ifdef _OPENMP
+  thrId = omp_get_thread_num();
+#endif
+  if(pool && (thrId < pool->nWSp))
+  {
+    gVWSp = pool->wSp[thrId];
+  }
+  return(gVWSp);
+}
+
 /*!
 * \return	void
 * \ingroup	WlzAccess
@@ -476,6 +667,7 @@ void		WlzGreyValueGet(WlzGreyValueWSpace *gVWSp,
 {
   if(gVWSp)
   {
+    WlzGreyValueTilesRelease(gVWSp);
     switch(gVWSp->objType)
     {
       case WLZ_2D_DOMAINOBJ:
@@ -542,6 +734,7 @@ void		WlzGreyValueGetCon(WlzGreyValueWSpace *gVWSp,
 {
   if(gVWSp)
   {
+    WlzGreyValueTilesRelease(gVWSp);
     if(gVWSp->invTrans)
     {
       WlzGreyValueGetTransCon(gVWSp, (int )plane, (int )line, (int )kol);
@@ -701,6 +894,185 @@ double		WlzGreyValueGetD(WlzGreyValueWSpace *gVWSp,
   return(val);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzAccess
+* \brief	Gets the grey values at each of the given positions
+* 		in the object with which the given work space was
+* 		initialised. The values are the same as would be given by
+* 		calling WlzGreyValueGetD() (nearest neighbour
+* 		interpolation) or WlzGreyValueGetCon() followed by linear
+* 		or tri-linear interpolation for each position in turn,
+* 		but the positions are visited in order of plane and line
+* 		(or of tile for tiled values) so that the work space's
+* 		plane and tile state changes as little as possible.
+* 		Linear interpolation is not supported for RGBA values.
+* \param	gVWSp			Grey value work space.
+* \param	nPos			Number of positions.
+* \param	pos			Array of positions, for 2D objects
+* 					the z coordinates are ignored.
+* \param	interp			Interpolation, which must be either
+* 					WLZ_INTERPOLATION_NEAREST or
+* 					WLZ_INTERPOLATION_LINEAR.
+* \param	dst			Destination array for the nPos values.
+*/
+WlzErrorNum	WlzGreyValueGetN(WlzGreyValueWSpace *gVWSp,
+				 int nPos, WlzDVertex3 *pos,
+				 WlzInterpolationType interp, double *dst)
+{
+  int		idN;
+  WlzGreyValueNKey *keys = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(gVWSp == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(nPos < 0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((nPos > 0) && ((pos == NULL) || (dst == NULL)))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if((interp != WLZ_INTERPOLATION_NEAREST) &&
+          (interp != WLZ_INTERPOLATION_LINEAR))
+  {
+    errNum = WLZ_ERR_INTERPOLATION_TYPE;
+  }
+  else if((interp == WLZ_INTERPOLATION_LINEAR) &&
+          (gVWSp->gType == WLZ_GREY_RGBA))
+  {
+    errNum = WLZ_ERR_GREY_TYPE;
+  }
+  else if((keys = (WlzGreyValueNKey *)
+                  AlcMalloc(nPos * sizeof(WlzGreyValueNKey))) == NULL)
+  {
+    if(nPos > 0)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (nPos > 0))
+  {
+    int		tW = 0;
+
+    /* Sort the positions by tile or plane and then line. */
+    if((gVWSp->gTabType == WLZ_GREY_TAB_TILED) && (gVWSp->invTrans == NULL))
+    {
+      tW = gVWSp->values.t->tileWidth;
+    }
+    for(idN = 0; idN < nPos; ++idN)
+    {
+      WlzLong	x,
+      		y,
+		z = 0;
+
+      if(interp == WLZ_INTERPOLATION_NEAREST)
+      {
+        x = WLZ_NINT(pos[idN].vtX);
+        y = WLZ_NINT(pos[idN].vtY);
+	if(gVWSp->objType == WLZ_3D_DOMAINOBJ)
+	{
+          z = WLZ_NINT(pos[idN].vtZ);
+	}
+      }
+      else
+      {
+        x = (WlzLong )floor(pos[idN].vtX);
+        y = (WlzLong )floor(pos[idN].vtY);
+	if(gVWSp->objType == WLZ_3D_DOMAINOBJ)
+	{
+          z = (WlzLong )floor(pos[idN].vtZ);
+	}
+      }
+      /* Offset the coordinates so that they are all positive. */
+      x = WLZ_CLAMP(x + (1 << 20), 0, (1 << 21) - 1);
+      y = WLZ_CLAMP(y + (1 << 20), 0, (1 << 21) - 1);
+      z = WLZ_CLAMP(z + (1 << 20), 0, (1 << 21) - 1);
+      keys[idN].idx = idN;
+      if(tW > 0)
+      {
+        keys[idN].k0 = ((z / tW) << 42) | ((y / tW) << 21) | (x / tW);
+      }
+      else
+      {
+        keys[idN].k0 = z;
+      }
+      keys[idN].k1 = (z << 42) | (y << 21) | x;
+    }
+    qsort(keys, nPos, sizeof(WlzGreyValueNKey), WlzGreyValueNKeyCmp);
+    if(interp == WLZ_INTERPOLATION_NEAREST)
+    {
+      for(idN = 0; idN < nPos; ++idN)
+      {
+	WlzDVertex3 *p;
+
+	p = pos + keys[idN].idx;
+	WlzGreyValueGet(gVWSp, p->vtZ, p->vtY, p->vtX);
+	dst[keys[idN].idx] = WlzGreyValueToD(gVWSp->gType, gVWSp->gVal[0]);
+      }
+    }
+    else
+    {
+      int	nV;
+
+      nV = (gVWSp->objType == WLZ_3D_DOMAINOBJ)? 8: 4;
+      for(idN = 0; idN < nPos; ++idN)
+      {
+	int	idV;
+	double	sum;
+	WlzDVertex3 f0,
+		f1;
+	WlzDVertex3 *p;
+	double	v[8],
+		w[8];
+
+	p = pos + keys[idN].idx;
+	f0.vtX = floor(p->vtX);
+	f0.vtY = floor(p->vtY);
+	f0.vtZ = floor(p->vtZ);
+	WlzGreyValueGetCon(gVWSp, f0.vtZ, f0.vtY, f0.vtX);
+	f0.vtX = p->vtX - f0.vtX;
+	f0.vtY = p->vtY - f0.vtY;
+	f0.vtZ = p->vtZ - f0.vtZ;
+	f1.vtX = 1.0 - f0.vtX;
+	f1.vtY = 1.0 - f0.vtY;
+	f1.vtZ = 1.0 - f0.vtZ;
+	w[0] = f1.vtX * f1.vtY;
+	w[1] = f0.vtX * f1.vtY;
+	w[2] = f1.vtX * f0.vtY;
+	w[3] = f0.vtX * f0.vtY;
+	if(nV == 8)
+	{
+	  w[4] = w[0] * f0.vtZ;
+	  w[5] = w[1] * f0.vtZ;
+	  w[6] = w[2] * f0.vtZ;
+	  w[7] = w[3] * f0.vtZ;
+	  w[0] *= f1.vtZ;
+	  w[1] *= f1.vtZ;
+	  w[2] *= f1.vtZ;
+	  w[3] *= f1.vtZ;
+	}
+	for(idV = 0; idV < nV; ++idV)
+	{
+	  v[idV] = WlzGreyValueToD(gVWSp->gType, gVWSp->gVal[idV]);
+	}
+	/* Simple loop which the compiler may vectorise. */
+	sum = 0.0;
+	for(idV = 0; idV < nV; ++idV)
+	{
+	  sum += v[idV] * w[idV];
+	}
+	dst[keys[idN].idx] = sum;
+      }
+    }
+  }
+  AlcFree(keys);
+  return(errNum);
+}
+
 /*! 
 * \ingroup      WlzValuesUtils
 * \brief        Gets a single grey value/pointer for the given point
@@ -1014,8 +1386,7 @@ static void	WlzGreyValueComputeGreyP2D(WlzGreyP *baseGVP,
       }
       break;
     case WLZ_GREY_TAB_TILED:
-      WlzGreyValueComputeGreyPTiled2D(baseGVP, offset, gVWSp->values.t,
-                                      line, kol);
+      WlzGreyValueComputeGreyPTiled2D(baseGVP, offset, gVWSp, line, kol);
       break;
     default:
       break;
@@ -1037,12 +1408,14 @@ static void	WlzGreyValueComputeGreyP2D(WlzGreyP *baseGVP,
 * \param	kol			Column coordinate of point.
 */
 static void	WlzGreyValueComputeGreyPTiled2D(WlzGreyP *baseGVP,
-				size_t *offset, WlzTiledValues *tVal,
+				size_t *offset, WlzGreyValueWSpace *gVWSp,
 				int line, int kol)
 {
   WlzIVertex2 	rPos,
 		tIdx;
+  WlzTiledValues *tVal;
 
+  tVal = gVWSp->values.t;
   *offset = 0;
   (*baseGVP).v = NULL;
   rPos.vtX = kol - tVal->kol1;
@@ -1077,8 +1450,11 @@ static void	WlzGreyValueComputeGreyPTiled2D(WlzGreyP *baseGVP,
 	tOff.vtX = rPos.vtX % tVal->tileWidth;
 	tOff.vtY = rPos.vtY % tVal->tileWidth;
 	off = (tOff.vtY * tVal->tileWidth) + tOff.vtX;
-	(*baseGVP).v = tVal->tiles.v;
-	*offset = (idx * tVal->tileSz) + off;
+	if(WlzGreyValueTileTouch(gVWSp, idx) == WLZ_ERR_NONE)
+	{
+	  (*baseGVP).v = tVal->tiles.v;
+	  *offset = (idx * tVal->tileSz) + off;
+	}
       }
     }
   }
@@ -1100,12 +1476,14 @@ static void	WlzGreyValueComputeGreyPTiled2D(WlzGreyP *baseGVP,
 * \param	kol			Column coordinate of point.
 */
 static void	WlzGreyValueComputeGreyPTiled3D(WlzGreyP *baseGVP,
-				size_t *offset, WlzTiledValues *tVal,
+				size_t *offset, WlzGreyValueWSpace *gVWSp,
 				int plane, int line, int kol)
 {
   WlzIVertex3 	rPos,
 		tIdx;
+  WlzTiledValues *tVal;
 
+  tVal = gVWSp->values.t;
   *offset = 0;
   (*baseGVP).v = NULL;
   rPos.vtX = kol - tVal->kol1;
@@ -1151,8 +1529,11 @@ static void	WlzGreyValueComputeGreyPTiled3D(WlzGreyP *baseGVP,
 	  tOff.vtZ = rPos.vtZ % tVal->tileWidth;
 	  off = ((tOff.vtZ * tVal->tileWidth + tOff.vtY) * tVal->tileWidth) +
 	        tOff.vtX;
-	  (*baseGVP).v = tVal->tiles.v;
-	  *offset = (idx * tVal->tileSz) + off;
+	  if(WlzGreyValueTileTouch(gVWSp, idx) == WLZ_ERR_NONE)
+	  {
+	    (*baseGVP).v = tVal->tiles.v;
+	    *offset = (idx * tVal->tileSz) + off;
+	  }
 	}
       }
     }
@@ -1182,6 +1563,7 @@ static void	WlzGreyValueGet2D1(WlzGreyValueWSpace *gVWSp,
   WlzIntervalLine *itvLn;
 
   gVWSp->bkdFlag = 0;
+  baseGVP.v = NULL;
   if((gVWSp->iDom2D != NULL) && (gVWSp->values2D.core != NULL))
   {
     kol1 = gVWSp->iDom2D->kol1;
@@ -1202,10 +1584,12 @@ static void	WlzGreyValueGet2D1(WlzGreyValueWSpace *gVWSp,
       {
 	if(gVWSp->iDom2D->type == WLZ_INTERVALDOMAIN_RECT)
 	{
-	  valSet = 1;
 	  WlzGreyValueComputeGreyP2D(&baseGVP, &offset, gVWSp, line, kol);
-	  WlzGreyValueSetGreyP(gVWSp->gVal, gVWSp->gPtr, gVWSp->gType,
-			       baseGVP, offset);
+	  if((valSet = (baseGVP.v != NULL)) != 0)
+	  {
+	    WlzGreyValueSetGreyP(gVWSp->gVal, gVWSp->gPtr, gVWSp->gType,
+				 baseGVP, offset);
+	  }
 	}
 	else	          /* gVWSp->iDom2D->type == WLZ_INTERVALDOMAIN_INTVL */
 	{
@@ -1220,10 +1604,12 @@ static void	WlzGreyValueGet2D1(WlzGreyValueWSpace *gVWSp,
 	    }
 	    else if(kolRel <= itv->iright)
 	    {
-	      valSet = 1;
 	      WlzGreyValueComputeGreyP2D(&baseGVP, &offset, gVWSp, line, kol);
-	      WlzGreyValueSetGreyP(gVWSp->gVal, gVWSp->gPtr, gVWSp->gType,
-				   baseGVP, offset);
+	      if((valSet = (baseGVP.v != NULL)) != 0)
+	      {
+		WlzGreyValueSetGreyP(gVWSp->gVal, gVWSp->gPtr, gVWSp->gType,
+				     baseGVP, offset);
+	      }
 	      break;
 	    }
 	    ++itv;
@@ -1324,11 +1710,13 @@ static void	WlzGreyValueGet3DTiled(WlzGreyValueWSpace *gVWSp,
 	    size_t   	offset;
 	    WlzGreyP 	baseGVP;
 
-	    WlzGreyValueComputeGreyPTiled3D(&baseGVP, &offset,
-					    gVWSp->values.t,
+	    WlzGreyValueComputeGreyPTiled3D(&baseGVP, &offset, gVWSp,
 					    plane, line, kol);
-	    WlzGreyValueSetGreyP(gVWSp->gVal, gVWSp->gPtr, gVWSp->gType,
-				 baseGVP, offset);
+	    if((valSet = (baseGVP.v != NULL)) != 0)
+	    {
+	      WlzGreyValueSetGreyP(gVWSp->gVal, gVWSp->gPtr, gVWSp->gType,
+				   baseGVP, offset);
+	    }
 	  }
 	}
       }
@@ -1518,93 +1906,65 @@ static void	WlzGreyValueGet2DCon(WlzGreyValueWSpace *gVWSp,
 static void	WlzGreyValueGet3DCon(WlzGreyValueWSpace *gVWSp,
 				   int plane, int line, int kol)
 {
-  int		tI0,
-  		planeOff,
-		planeRel,
-		savePlane = 0;
-  WlzDomain	*domP;
-  WlzValues	*valP;
-  WlzObjectType	saveGTabType2D = WLZ_NULL;
-  WlzIntervalDomain *saveIDom2D = NULL;
-  WlzValues	saveValues2D;
-  int		planeSet[2];
-  WlzGreyP	saveGPtr[4];
-  WlzGreyV	saveGVal[4];
-
-  planeOff = 0;
-  while(planeOff < 2)
+  int		idV,
+  		planeOff;
+  unsigned	bkdFlag = 0;
+  WlzGreyP	gPtr[8];
+  WlzGreyV	gVal[8];
+
+  for(planeOff = 0; planeOff < 2; ++planeOff)
   {
-    planeSet[planeOff] = 0;
+    int		pl,
+    		planeRel,
+		planeSet = 0;
+
+    pl = plane + planeOff;
+    planeRel = pl - gVWSp->domain.p->plane1;
 #ifdef WLZ_FAST_CODE
-    if((unsigned int )(plane - gVWSp->domain.p->plane1 - 1) <=
-       (unsigned int )(gVWSp->domain.p->lastpl - gVWSp->domain.p->plane1 - 2))
+    if((unsigned int )planeRel <=
+       (unsigned int )(gVWSp->domain.p->lastpl - gVWSp->domain.p->plane1))
 #else
-    if((plane > gVWSp->domain.p->plane1) && (plane < gVWSp->domain.p->lastpl))
+    if((pl >= gVWSp->domain.p->plane1) && (pl <= gVWSp->domain.p->lastpl))
 #endif
     {
-      if(plane == gVWSp->plane)
-      {
-	WlzGreyValueGet2DCon(gVWSp, line, kol);
-	planeSet[planeOff] = 1;
-      }
-      else
+      WlzDomain	*domP;
+      WlzValues	*valP;
+
+      domP = gVWSp->domain.p->domains + planeRel;
+      valP = gVWSp->values.vox->values + planeRel;
+      if(((*domP).core != NULL) && ((*domP).core->type != WLZ_EMPTY_DOMAIN) &&
+         ((*valP).core != NULL) && ((*valP).core->type != WLZ_EMPTY_OBJ))
       {
-	planeRel = plane - gVWSp->domain.p->plane1;
-	domP = gVWSp->domain.p->domains + planeRel;
-	valP = gVWSp->values.vox->values + planeRel;
-	if(domP && valP)
+	if(pl != gVWSp->plane)
 	{
-          if(planeSet[0])
-	  {
-	    savePlane = gVWSp->plane;
-	    saveIDom2D = gVWSp->iDom2D;
-	    saveValues2D = gVWSp->values2D;
-	    saveGTabType2D = gVWSp->gTabType2D;
-	  }
-	  gVWSp->plane = plane;
+	  gVWSp->plane = pl;
 	  gVWSp->iDom2D = (*domP).i;
 	  gVWSp->values2D = (*valP);
 	  gVWSp->gTabType2D = gVWSp->gTabTypes3D[planeRel];
-	  WlzGreyValueGet2D1(gVWSp, line, kol);
-	  planeSet[planeOff] = 1;
 	}
-      }
-    }
-    if(planeOff == 0)
-    {
-      if(planeSet[0])
-      {
-	tI0 = 4;
-	while(--tI0 >= 0)
+	WlzGreyValueGet2DCon(gVWSp, line, kol);
+	for(idV = 0; idV < 4; ++idV)
 	{
-	  saveGPtr[tI0] = gVWSp->gPtr[tI0];
-	  saveGVal[tI0] = gVWSp->gVal[tI0];
+	  gPtr[(planeOff * 4) + idV] = gVWSp->gPtr[idV];
+	  gVal[(planeOff * 4) + idV] = gVWSp->gVal[idV];
 	}
-      }
-      else
-      {
-        WlzGreyValueSetBkdPN(saveGVal, saveGPtr,
-			     gVWSp->gType, gVWSp->gBkd, 4);
+	bkdFlag |= gVWSp->bkdFlag << (planeOff * 4);
+	planeSet = 1;
       }
     }
-    ++plane;
-    ++planeOff;
-  }
-  if(planeSet[0] && planeSet[1])
-  {
-    gVWSp->plane = savePlane;
-    gVWSp->iDom2D = saveIDom2D;
-    gVWSp->values2D = saveValues2D;
-    gVWSp->gTabType2D = saveGTabType2D;
+    if(planeSet == 0)
+    {
+      WlzGreyValueSetBkdPN(gVal + (planeOff * 4), gPtr + (planeOff * 4),
+			   gVWSp->gType, gVWSp->gBkd, 4);
+      bkdFlag |= 0xf << (planeOff * 4);
+    }
   }
-  tI0 = 4;
-  while(--tI0 >= 0)
+  for(idV = 0; idV < 8; ++idV)
   {
-    gVWSp->gPtr[tI0 + 4] = gVWSp->gPtr[tI0];
-    gVWSp->gPtr[tI0] = saveGPtr[tI0];
-    gVWSp->gVal[tI0 + 4] = gVWSp->gVal[tI0];
-    gVWSp->gVal[tI0] = saveGVal[tI0];
+    gVWSp->gPtr[idV] = gPtr[idV];
+    gVWSp->gVal[idV] = gVal[idV];
   }
+  gVWSp->bkdFlag = bkdFlag;
 }
 
 /*!
@@ -1635,7 +1995,7 @@ static void	WlzGreyValueGet3DConTiled(WlzGreyValueWSpace *gVWSp,
     pl = plane + idP;
     plRel = pl - gVWSp->domain.p->plane1;
 #ifdef WLZ_FAST_CODE
-    if((unsigned int )plRel >=
+    if((unsigned int )plRel <=
        (unsigned int )(gVWSp->domain.p->lastpl - gVWSp->domain.p->plane1))
 #else
     if((plRel >= 0) && (pl <= gVWSp->domain.p->lastpl))
@@ -1664,7 +2024,7 @@ static void	WlzGreyValueGet3DConTiled(WlzGreyValueWSpace *gVWSp,
 #endif
 	  {
 #ifdef WLZ_FAST_CODE
-	    if((unsigned int )(iDom->kol1 - kol - 1) <=
+	    if((unsigned int )(kol + 1 - iDom->kol1) <=
 	       (unsigned int )(iDom->lastkl - iDom->kol1 + 1))
 #else
 	    if((kol + 1 >= iDom->kol1) && (kol <= iDom->lastkl))
@@ -1698,6 +2058,7 @@ static void	WlzGreyValueGet3DConTiled(WlzGreyValueWSpace *gVWSp,
 		    valMsk |= ((klRel >= itv->ileft) |
 		               ((klRel < itv->iright) << 1)) << idV;
 		  }
+		  ++itv;
 		}
 	      }
 	    }
@@ -1745,9 +2106,20 @@ static void	WlzGreyValueGet3DConTiled(WlzGreyValueWSpace *gVWSp,
             rPos.vtX = kol - tVal->kol1 + idK;
 	    tIdx.vtX = tIdx.vtY + (rPos.vtX / tVal->tileWidth);
             tOff.vtX = tOff.vtY + (rPos.vtX % tVal->tileWidth);
-            offset = *(tVal->indices + tIdx.vtX) * tVal->tileSz + tOff.vtX;
-	    WlzGreyValueSetGreyP(gVWSp->gVal + idV, gVWSp->gPtr + idV,
-	                         gVWSp->gType, tVal->tiles, offset);
+            offset = *(tVal->indices + tIdx.vtX);
+	    if(WlzGreyValueTileTouch(gVWSp, offset) != WLZ_ERR_NONE)
+	    {
+	      /* The tile can't be decoded so use the background value. */
+	      valMsk &= ~(1 << idV);
+	      WlzGreyValueSetBkdPN(gVWSp->gVal + idV, gVWSp->gPtr + idV,
+				   gVWSp->gType, gVWSp->gBkd, 1);
+	    }
+	    else
+	    {
+	      offset = (offset * tVal->tileSz) + tOff.vtX;
+	      WlzGreyValueSetGreyP(gVWSp->gVal + idV, gVWSp->gPtr + idV,
+				   gVWSp->gType, tVal->tiles, offset);
+	    }
 	  }
 	  ++idV;
 	}
@@ -1841,3 +2213,125 @@ static void	WlzGreyValueGetTransCon(WlzGreyValueWSpace *gVWSp,
       break;
   }
 }
+
+/*!
+* \ingroup	WlzAccess
+* \brief	Releases the tiles of a tiled value table which are in
+* 		use by the work space's grey pointers (see
+* 		WlzGreyValueTileTouch()).
+* \param	gVWSp			Grey value work space.
+*/
+static void	WlzGreyValueTilesRelease(WlzGreyValueWSpace *gVWSp)
+{
+  int		idT;
+
+  for(idT = 0; idT < gVWSp->nTile; ++idT)
+  {
+    WlzTiledValuesCacheRelease(gVWSp->values.t, gVWSp->tile[idT]);
+  }
+  gVWSp->nTile = 0;
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzAccess
+* \brief	Touches a tile of the work space's tiled value table if
+* 		it has a cache (see WlzTiledValuesCacheTouch()). The tile
+* 		is then in use by the work space's grey pointers until
+* 		the next access or until the work space is freed.
+* \param	gVWSp			Grey value work space.
+* \param	idx			Index of the tile.
+*/
+static WlzErrorNum WlzGreyValueTileTouch(WlzGreyValueWSpace *gVWSp,
+				size_t idx)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(gVWSp->values.t->cache)
+  {
+    errNum = WlzTiledValuesCacheTouch(gVWSp->values.t, idx);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if(gVWSp->nTile < 8)
+      {
+	gVWSp->tile[gVWSp->nTile++] = idx;
+      }
+      else
+      {
+        WlzTiledValuesCacheRelease(gVWSp->values.t, idx);
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Sorting value for qsort().
+* \ingroup	WlzAccess
+* \brief	Compares the keys used to order positions in
+* 		WlzGreyValueGetN().
+* \param	p0			Used to pass the first key.
+* \param	p1			Used to pass the second key.
+*/
+static int	WlzGreyValueNKeyCmp(const void *p0, const void *p1)
+{
+  int		cmp;
+  const WlzGreyValueNKey *k0,
+  		*k1;
+
+  k0 = (const WlzGreyValueNKey *)p0;
+  k1 = (const WlzGreyValueNKey *)p1;
+  if(k0->k0 != k1->k0)
+  {
+    cmp = (k0->k0 < k1->k0)? -1: 1;
+  }
+  else if(k0->k1 != k1->k1)
+  {
+    cmp = (k0->k1 < k1->k1)? -1: 1;
+  }
+  else
+  {
+    cmp = k0->idx - k1->idx;
+  }
+  return(cmp);
+}
+
+/*!
+* \return	The grey value as a double.
+* \ingroup	WlzAccess
+* \brief	Converts a grey value of the given type to a double.
+* \param	gType			Grey type.
+* \param	gV			Grey value.
+*/
+static double	WlzGreyValueToD(WlzGreyType gType, WlzGreyV gV)
+{
+  double	val = 0.0;
+
+  switch(gType)
+  {
+    case WLZ_GREY_LONG:
+      val = gV.lnv;
+      break;
+    case WLZ_GREY_INT:
+      val = gV.inv;
+      break;
+    case WLZ_GREY_SHORT:
+      val = gV.shv;
+      break;
+    case WLZ_GREY_UBYTE:
+      val = gV.ubv;
+      break;
+    case WLZ_GREY_FLOAT:
+      val = gV.flv;
+      break;
+    case WLZ_GREY_DOUBLE:
+      val = gV.dbv;
+      break;
+    case WLZ_GREY_RGBA:
+      val = gV.rgbv;
+      break;
+    default:
+      break;
+  }
+  return(val);
+}
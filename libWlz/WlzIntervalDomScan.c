@@ -40,7 +40,18 @@ static char _WlzIntervalDomScan_c[] = "University of Edinburgh $Id$";
 */
 
 #include <stdlib.h>
+#include <string.h>
 #include <Wlz.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+static int			WlzIntervalScanPartNItv(
+				  WlzIntervalDomain *iDom,
+				  int ln);
+static int			WlzIntervalScanPartValidPlane(
+				  WlzObject *obj,
+				  int pIdx);
 
 /* function:     WlzInitRasterScan    */
 /*! 
@@ -441,3 +452,349 @@ WlzErrorNum 	WlzInitLineScan(WlzObject *obj, WlzIntervalWSpace *iwsp,
   }
   return(errNum);
 }
+
+/*!
+* \return	Array of scan parts or NULL on error or if the object has
+*		no intervals.
+* \ingroup	WlzDomainOps
+* \brief	Partitions the interval domain of the given object into
+*		parts which may be scanned independently, typically by
+*		separate threads. Each part is a contiguous range of lines
+*		within a single plane and the parts are chosen so that
+*		they have roughly equal numbers of intervals. For 3D
+*		objects planes with a NULL domain (or with a NULL value
+*		table when the object has non-tiled values) are skipped,
+*		as they would be by the sequential per-plane loops.
+*		The parts are ordered by plane and then by line and
+*		should be freed using AlcFree().
+*		Scanning of a part is initialised using either
+*		WlzInitRasterScanPart() or WlzInitGreyScanPart().
+* \param	obj			Given 2D or 3D domain object.
+* \param	nPart			Required number of parts, if
+*					\f$\leq\f$ zero then the number
+*					of parts is chosen to be a small
+*					multiple of the number of threads
+*					available. More parts than this
+*					may be returned because parts never
+*					span planes.
+* \param	dstNPart		Destination pointer for the number
+*					of parts, must not be NULL.
+* \param	dstErr			Destination error pointer, may
+*					be NULL.
+*/
+WlzIntervalScanPart *WlzMakeIntervalScanParts(WlzObject *obj, int nPart,
+				int *dstNPart, WlzErrorNum *dstErr)
+{
+  int		pIdx,
+  		nPln = 1,
+		nP = 0,
+		maxP = 0;
+  WlzLong	nItv = 0,
+  		maxItv;
+  WlzIntervalDomain *iDom;
+  WlzIntervalScanPart *parts = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(dstNPart == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(obj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else
+  {
+    switch(obj->type)
+    {
+      case WLZ_2D_DOMAINOBJ:
+	if(obj->domain.core == NULL)
+	{
+	  errNum = WLZ_ERR_DOMAIN_NULL;
+	}
+	else if((obj->domain.core->type != WLZ_INTERVALDOMAIN_INTVL) &&
+	        (obj->domain.core->type != WLZ_INTERVALDOMAIN_RECT))
+	{
+	  errNum = WLZ_ERR_DOMAIN_TYPE;
+	}
+	break;
+      case WLZ_3D_DOMAINOBJ:
+	if(obj->domain.core == NULL)
+	{
+	  errNum = WLZ_ERR_DOMAIN_NULL;
+	}
+	else if(obj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+	{
+	  errNum = WLZ_ERR_DOMAIN_TYPE;
+	}
+	else if((obj->values.core != NULL) &&
+	        (WlzGreyTableIsTiled(obj->values.core->type) == 0) &&
+		(obj->values.core->type != WLZ_VOXELVALUETABLE_GREY))
+	{
+	  errNum = WLZ_ERR_VALUES_TYPE;
+	}
+	else
+	{
+	  nPln = obj->domain.p->lastpl - obj->domain.p->plane1 + 1;
+	}
+	break;
+      case WLZ_EMPTY_OBJ:
+	nPln = 0;
+	break;
+      default:
+	errNum = WLZ_ERR_OBJECT_TYPE;
+	break;
+    }
+  }
+  /* Count the intervals of all the planes to be scanned. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(pIdx = 0; pIdx < nPln; ++pIdx)
+    {
+      if(WlzIntervalScanPartValidPlane(obj, pIdx))
+      {
+	int	ln;
+
+	iDom = (obj->type == WLZ_2D_DOMAINOBJ)?
+	       obj->domain.i: obj->domain.p->domains[pIdx].i;
+	for(ln = iDom->line1; ln <= iDom->lastln; ++ln)
+	{
+	  nItv += WlzIntervalScanPartNItv(iDom, ln);
+	}
+        ++maxP;
+      }
+    }
+    if(nPart <= 0)
+    {
+#ifdef _OPENMP
+      nPart = 4 * omp_get_max_threads();
+#else
+      nPart = 1;
+#endif
+    }
+    /* Parts never span planes, so there can be at most one more part
+     * per plane than requested, plus one for the workspace used while
+     * splitting. */
+    maxP += nPart + 1;
+  }
+  /* Split the lines of each plane into parts with (approximately)
+   * maxItv intervals. */
+  if((errNum == WLZ_ERR_NONE) && (nItv > 0))
+  {
+    maxItv = (nItv + nPart - 1) / nPart;
+    if((parts = (WlzIntervalScanPart *)
+                AlcMalloc(maxP * sizeof(WlzIntervalScanPart))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      for(pIdx = 0; pIdx < nPln; ++pIdx)
+      {
+	if(WlzIntervalScanPartValidPlane(obj, pIdx))
+	{
+	  int	ln,
+	  	pItv = 0;
+	  WlzIntervalScanPart *part;
+
+	  iDom = (obj->type == WLZ_2D_DOMAINOBJ)?
+		 obj->domain.i: obj->domain.p->domains[pIdx].i;
+	  part = parts + nP;
+	  part->plane = (obj->type == WLZ_2D_DOMAINOBJ)?
+	                0: obj->domain.p->plane1 + pIdx;
+	  part->line0 = iDom->line1;
+	  for(ln = iDom->line1; ln <= iDom->lastln; ++ln)
+	  {
+	    pItv += WlzIntervalScanPartNItv(iDom, ln);
+	    if((pItv >= maxItv) || (ln == iDom->lastln))
+	    {
+	      if(pItv > 0)
+	      {
+		part->line1 = ln;
+		part->nItv = pItv;
+		++nP;
+		part = parts + nP;
+		part->plane = parts[nP - 1].plane;
+		pItv = 0;
+	      }
+	      part->line0 = ln + 1;
+	    }
+	  }
+	}
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    *dstNPart = nP;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(parts);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzDomainOps
+* \brief	Initialises raster scanning of a single part of an
+*		object, as computed by WlzMakeIntervalScanParts(). Only the
+*		part's lines are scanned and the workspace's plane position
+*		is set to the part's plane. After initialisation the
+*		workspace is used in exactly the same way as one
+*		initialised by WlzInitRasterScan().
+* \param	obj			The object from which the parts
+*					were computed.
+* \param	part			The part to be scanned.
+* \param	obj2D			Storage for a 2D object which is
+*					set to the part's plane of a 3D
+*					object, this must remain valid
+*					until the scan is complete.
+*					May be NULL for 2D objects.
+* \param	iwsp			Interval scanning workspace.
+* \param	raster			Scanning direction.
+*/
+WlzErrorNum	WlzInitRasterScanPart(WlzObject *obj,
+				WlzIntervalScanPart *part, WlzObject *obj2D,
+				WlzIntervalWSpace *iwsp, WlzRasterDir raster)
+{
+  WlzObject	*sObj = NULL;
+  WlzIntervalDomain *iDom;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(obj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(obj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if((part == NULL) || (iwsp == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    switch(obj->type)
+    {
+      case WLZ_2D_DOMAINOBJ:
+	sObj = obj;
+	break;
+      case WLZ_3D_DOMAINOBJ:
+	if(obj2D == NULL)
+	{
+	  errNum = WLZ_ERR_PARAM_NULL;
+	}
+	else if(obj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+	{
+	  errNum = WLZ_ERR_DOMAIN_TYPE;
+	}
+	else if((part->plane < obj->domain.p->plane1) ||
+	        (part->plane > obj->domain.p->lastpl))
+	{
+	  errNum = WLZ_ERR_PARAM_DATA;
+	}
+	else
+	{
+	  int	pIdx;
+
+	  pIdx = part->plane - obj->domain.p->plane1;
+	  (void )memset(obj2D, 0, sizeof(WlzObject));
+	  obj2D->type = WLZ_2D_DOMAINOBJ;
+	  obj2D->domain = obj->domain.p->domains[pIdx];
+	  if(obj->values.core != NULL)
+	  {
+	    obj2D->values = (WlzGreyTableIsTiled(obj->values.core->type))?
+	                    obj->values: obj->values.vox->values[pIdx];
+	  }
+	  sObj = obj2D;
+	}
+	break;
+      default:
+	errNum = WLZ_ERR_OBJECT_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzInitRasterScan(sObj, iwsp, raster);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    iDom = iwsp->intdmn;
+    if((part->line0 < iDom->line1) || (part->line1 > iDom->lastln) ||
+       (part->line0 > part->line1))
+    {
+      errNum = WLZ_ERR_PARAM_DATA;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Restrict the scan to the part's lines, setting up the workspace
+     * just as WlzInitRasterScan() would for a domain with only these
+     * lines. */
+    iwsp->linbot = (iwsp->lineraster > 0)? part->line0: part->line1;
+    iwsp->linpos = iwsp->linbot - iwsp->lineraster;
+    iwsp->linrmn = part->line1 - part->line0 + 1;
+    if(iwsp->dmntype == WLZ_INTERVALDOMAIN_INTVL)
+    {
+      iwsp->intvln = iDom->intvlines + iwsp->linbot - iDom->line1 -
+                     iwsp->lineraster;
+    }
+    iwsp->plnpos = part->plane;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Number of intervals in the given line of the domain.
+* \ingroup	WlzDomainOps
+* \brief	Computes the number of intervals in a line of an interval
+*		domain, which is always one for rectangular domains.
+* \param	iDom			Given interval domain.
+* \param	ln			Line within the domain.
+*/
+static int	WlzIntervalScanPartNItv(WlzIntervalDomain *iDom, int ln)
+{
+  int		n;
+
+  n = (iDom->type == WLZ_INTERVALDOMAIN_RECT)?
+      1: iDom->intvlines[ln - iDom->line1].nintvs;
+  return(n);
+}
+
+/*!
+* \return	Non-zero if the plane should be scanned.
+* \ingroup	WlzDomainOps
+* \brief	Checks whether the plane with the given index should be
+*		included in the scan parts of an object. For 2D objects
+*		the (only) plane has index zero.
+* \param	obj			Given 2D or 3D domain object.
+* \param	pIdx			Plane index relative to the
+*					first plane of the object.
+*/
+static int	WlzIntervalScanPartValidPlane(WlzObject *obj, int pIdx)
+{
+  int		valid = 1;
+  WlzDomain	dom;
+
+  if(obj->type == WLZ_3D_DOMAINOBJ)
+  {
+    dom = obj->domain.p->domains[pIdx];
+    if((dom.core == NULL) ||
+       ((dom.core->type != WLZ_INTERVALDOMAIN_INTVL) &&
+        (dom.core->type != WLZ_INTERVALDOMAIN_RECT)))
+    {
+      valid = 0;
+    }
+    else if((obj->values.core != NULL) &&
+            (WlzGreyTableIsTiled(obj->values.core->type) == 0) &&
+	    (obj->values.vox->values[pIdx].core == NULL))
+    {
+      valid = 0;
+    }
+  }
+  return(valid);
+}
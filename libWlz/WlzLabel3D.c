@@ -50,7 +50,9 @@ static char _WlzLabel3D_c[] = "University of Edinburgh $Id$";
 * 		components of the given object.
 * \ingroup	WlzBinaryOps
 * \brief	Labels (segments) a 3D domain object into connected component
-* 		objects using their connectivity. 
+* 		objects using their connectivity. If no fragments are to
+* 		be ignored (ignLn \f$\leq\f$ 0) the labeling is done by
+* 		WlzLabelUF() and maxObj is not used.
 * \param	gObj		Given object to be labeled.
 * \param	maxObj		Maximum number of objects to be found in any
 * 				plane.
@@ -136,6 +138,23 @@ WlzObject			*WlzLabel3D(
 	break;
     }
   }
+  /* Without fragments to be ignored the union-find labeling finds the
+   * same components without making an object for each fragment. */
+  if((errNum == WLZ_ERR_NONE) && (ignLn <= 0))
+  {
+    lObj = WlzLabelUF(gObj, con, 0, &nObjs, &errNum);
+    if((errNum == WLZ_ERR_NONE) && (nObjs < 1))
+    {
+      (void )WlzFreeObj(lObj);
+      lObj = NULL;
+      errNum = WLZ_ERR_DOMAIN_DATA;
+    }
+    if(dstErr)
+    {
+      *dstErr = errNum;
+    }
+    return(lObj);
+  }
   /* Create a fragment objects table. */
   if(errNum == WLZ_ERR_NONE)
   {
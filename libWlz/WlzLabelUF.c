@@ -0,0 +1,1635 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzLabelUF_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         WlzLabelUF.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Labeling (segmentation) of 2D and 3D domain objects into
+* 		connected components using a union-find tree of the
+* 		intervals.
+*
+* 		The intervals of the object are first collected, in
+* 		raster order, into rows with one row per line of each
+* 		plane. Each interval is a node of a union-find tree and
+* 		the intervals of each row are joined to those of the
+* 		adjacent rows (the previous line of the same plane and,
+* 		for 3D objects, lines of the previous plane) with which
+* 		they are connected. The rows are partitioned into slabs
+* 		of whole planes (3D) or lines (2D) which are joined in
+* 		parallel, each slab using only the nodes of its own
+* 		intervals, and the slabs are then merged by joining
+* 		the rows on either side of each slab boundary. Finally
+* 		the components are numbered in the order of their first
+* 		interval in raster order.
+* \ingroup	WlzBinaryOps
+*/
+
+#include <limits.h>
+#include <float.h>
+#include <string.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <Wlz.h>
+
+/*!
+* \struct	_WlzLabelUFWSp
+* \ingroup	WlzBinaryOps
+* \brief	Work space for union-find labeling. The intervals hold
+* 		absolute column coordinates and those of row r are
+* 		itv[rowOff[r]] to itv[rowOff[r + 1] - 1], where the row
+* 		of line l in plane p is (p - plane1) * nLn + l - line1.
+*/
+typedef struct _WlzLabelUFWSp
+{
+  int		dim;		/*!< Dimension of the object, 2 or 3. */
+  int		plane1;		/*!< First plane. */
+  int		nPln;		/*!< Number of planes. */
+  int		line1;		/*!< First line. */
+  int		nLn;		/*!< Number of lines in each plane. */
+  int		nRow;		/*!< Number of rows (nPln * nLn). */
+  int		nItv;		/*!< Total number of intervals. */
+  int		nLbl;		/*!< Number of labeled components. */
+  int		*rowOff;	/*!< Offsets of the first interval of each
+  				     row, with nRow + 1 entries. */
+  int		*lbl;		/*!< Label of each interval, with labels
+  				     from 0 to nLbl - 1. */
+  WlzInterval	*itv;		/*!< Intervals with absolute columns. */
+  int		grey;		/*!< Non-zero if grey value statistics are
+  				     required. */
+  WlzGreyType	gType;		/*!< Grey type of the object's values. */
+  double	*gItv;		/*!< Minimum, maximum, sum and sum of
+  				     squares of the grey values of each
+				     interval if required. */
+  int		oLn;		/*!< Column offset for intervals on
+  				     adjacent lines of the same plane to
+				     be connected: 0 or 1. */
+  int		oPl[3];		/*!< Column offsets for intervals on the
+  				     previous, same and next line of the
+				     previous plane to be connected: 0, 1 or
+				     -1 for not connected. */
+} WlzLabelUFWSp;
+
+static void			WlzLabelUFFreeWSp(
+				  WlzLabelUFWSp *wSp);
+static void			WlzLabelUFJoinRows(
+				  AlcUFTree *uft,
+				  int base,
+				  WlzLabelUFWSp *wSp,
+				  int q,
+				  int r,
+				  int off);
+static void			WlzLabelUFJoin(
+				  AlcUFTree *uft,
+				  int base,
+				  WlzLabelUFWSp *wSp,
+				  int r,
+				  int qMin,
+				  int qMax);
+static WlzObject		*WlzLabelUFMakeCmp(
+				  WlzObject *gObj,
+				  WlzLabelUFWSp *wSp,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzLabelUFMakeIdx(
+				  WlzObject *gObj,
+				  WlzLabelUFWSp *wSp,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzLabelUFMakeObj(
+				  WlzObject *gObj,
+				  WlzLabelUFWSp *wSp,
+				  int *srt,
+				  int *srtRow,
+				  int n,
+				  WlzErrorNum *dstErr);
+static WlzIntervalDomain	*WlzLabelUFMakeIDom(
+				  WlzLabelUFWSp *wSp,
+				  int *srt,
+				  int *srtRow,
+				  int n,
+				  WlzErrorNum *dstErr);
+static void			WlzLabelUFGreyItv(
+				  double *g,
+				  WlzGreyWSpace *gWSp,
+				  int n);
+static WlzErrorNum		WlzLabelUFInit(
+				  WlzLabelUFWSp *wSp,
+				  WlzObject *gObj,
+				  WlzConnectType con,
+				  int grey);
+static WlzErrorNum		WlzLabelUFLabel(
+				  WlzLabelUFWSp *wSp,
+				  WlzObject *gObj,
+				  WlzConnectType con,
+				  int grey);
+static WlzLabelStats		*WlzLabelUFMakeStats(
+				  WlzLabelUFWSp *wSp,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzLabelUFScan(
+				  WlzLabelUFWSp *wSp,
+				  WlzObject *gObj);
+static WlzErrorNum		WlzLabelUFUnion(
+				  WlzLabelUFWSp *wSp);
+
+/*!
+* \return	New object or NULL on error.
+* \ingroup	WlzBinaryOps
+* \brief	Labels (segments) a 2D or 3D domain object into connected
+* 		components using a union-find tree of its intervals.
+* 		Unlike WlzLabel() there is no limit on the number of
+* 		components.
+*
+* 		If idxObj is zero the returned object is a compound array
+* 		(WLZ_COMPOUND_ARR_1) of domain objects, one for each
+* 		component in the order of their first interval in raster
+* 		order. These share the values of the given object.
+* 		If idxObj is non-zero the returned object is an index
+* 		object with the domain of the given object and with grey
+* 		values which are the component index plus one, so that
+* 		WlzIndexObjToCompound() returns an empty object at index
+* 		zero followed by the components. The grey type is the
+* 		smallest of WLZ_GREY_UBYTE, WLZ_GREY_SHORT or WLZ_GREY_INT
+* 		which can hold the number of components.
+* \param	gObj			Given 2D or 3D domain object.
+* \param	con			Connectivity, which may be 4 or 8
+* 					for 2D objects and 6, 18 or 26
+* 					for 3D objects. For 3D objects 4 and 8
+* 					are treated as 6 and 26, as in
+* 					WlzLabel3D().
+* \param	idxObj			Return an index object if non-zero,
+* 					otherwise a compound array object.
+* \param	dstNLbl			Destination pointer for the number of
+* 					components, may be NULL.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject			*WlzLabelUF(
+				  WlzObject *gObj,
+				  WlzConnectType con,
+				  int idxObj,
+				  int *dstNLbl,
+				  WlzErrorNum *dstErr)
+{
+  WlzObject	*rObj = NULL;
+  WlzLabelUFWSp	wSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  errNum = WlzLabelUFLabel(&wSp, gObj, con, 0);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(idxObj)
+    {
+      rObj = WlzLabelUFMakeIdx(gObj, &wSp, &errNum);
+    }
+    else
+    {
+      rObj = WlzLabelUFMakeCmp(gObj, &wSp, &errNum);
+    }
+  }
+  if(dstNLbl)
+  {
+    *dstNLbl = (errNum == WLZ_ERR_NONE)? wSp.nLbl: 0;
+  }
+  WlzLabelUFFreeWSp(&wSp);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
+
+/*!
+* \return	New table of component statistics or NULL on error.
+* \ingroup	WlzBinaryOps
+* \brief	Labels (segments) a 2D or 3D domain object into connected
+* 		components as WlzLabelUF() does, computing statistics
+* 		for each component from its intervals. The grey value
+* 		sums of each interval are computed as the intervals are
+* 		collected and the statistics of the components are then
+* 		accumulated from the labeled intervals in a single serial
+* 		pass. This avoids scanning each of the component objects again
+* 		with functions such as WlzArea(), WlzVolume(),
+* 		WlzCentreOfMass2D(), WlzBoundingBox3I() or
+* 		WlzGreyStats(). The statistics are indexed in the same
+* 		order as the components of the labeled object, which need
+* 		not be made. The table should be freed using
+* 		WlzFreeLabelStats().
+* \param	gObj			Given 2D or 3D domain object.
+* \param	con			Connectivity, see WlzLabelUF().
+* \param	grey			Compute grey value statistics if
+* 					non-zero, in which case the given
+* 					object must have grey values.
+* \param	idxObj			Make an index object rather than a
+* 					compound array object if non-zero,
+* 					see WlzLabelUF().
+* \param	dstObj			Destination pointer for the labeled
+* 					object, may be NULL in which case no
+* 					object is made.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzLabelStats			*WlzLabelUFStats(
+				  WlzObject *gObj,
+				  WlzConnectType con,
+				  int grey,
+				  int idxObj,
+				  WlzObject **dstObj,
+				  WlzErrorNum *dstErr)
+{
+  WlzObject	*rObj = NULL;
+  WlzLabelStats	*stats = NULL;
+  WlzLabelUFWSp	wSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  errNum = WlzLabelUFLabel(&wSp, gObj, con, grey);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    stats = WlzLabelUFMakeStats(&wSp, &errNum);
+  }
+  if((errNum == WLZ_ERR_NONE) && (dstObj != NULL))
+  {
+    if(idxObj)
+    {
+      rObj = WlzLabelUFMakeIdx(gObj, &wSp, &errNum);
+    }
+    else
+    {
+      rObj = WlzLabelUFMakeCmp(gObj, &wSp, &errNum);
+    }
+  }
+  WlzLabelUFFreeWSp(&wSp);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeLabelStats(stats);
+    stats = NULL;
+  }
+  if(dstObj)
+  {
+    *dstObj = rObj;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(stats);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzBinaryOps
+* \brief	Frees a table of component statistics made by
+* 		WlzLabelUFStats().
+* \param	stats			Given table, may be NULL.
+*/
+WlzErrorNum			WlzFreeLabelStats(
+				  WlzLabelStats *stats)
+{
+  if(stats)
+  {
+    AlcFree(stats->stat);
+    AlcFree(stats);
+  }
+  return(WLZ_ERR_NONE);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzBinaryOps
+* \brief	Initialises the work space, collects the intervals of the
+* 		given object and labels them. The work space should be
+* 		freed using WlzLabelUFFreeWSp() even on error.
+* \param	wSp			Work space.
+* \param	gObj			Given object.
+* \param	con			Given connectivity.
+* \param	grey			Non-zero if grey value statistics are
+* 					required.
+*/
+static WlzErrorNum		WlzLabelUFLabel(
+				  WlzLabelUFWSp *wSp,
+				  WlzObject *gObj,
+				  WlzConnectType con,
+				  int grey)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  errNum = WlzLabelUFInit(wSp, gObj, con, grey);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzLabelUFScan(wSp, gObj);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzLabelUFUnion(wSp);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzBinaryOps
+* \brief	Checks the given object and connectivity and initialises
+* 		the work space, which should be freed using
+* 		WlzLabelUFFreeWSp() even on error.
+* \param	wSp			Work space to initialise.
+* \param	gObj			Given object.
+* \param	con			Given connectivity.
+* \param	grey			Non-zero if grey value statistics are
+* 					required.
+*/
+static WlzErrorNum		WlzLabelUFInit(
+				  WlzLabelUFWSp *wSp,
+				  WlzObject *gObj,
+				  WlzConnectType con,
+				  int grey)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  (void )memset(wSp, 0, sizeof(WlzLabelUFWSp));
+  if(gObj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(gObj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else
+  {
+    switch(gObj->type)
+    {
+      case WLZ_2D_DOMAINOBJ:
+	switch(gObj->domain.core->type)
+	{
+	  case WLZ_INTERVALDOMAIN_INTVL: /* FALLTHROUGH */
+	  case WLZ_INTERVALDOMAIN_RECT:
+	    wSp->dim = 2;
+	    wSp->plane1 = 0;
+	    wSp->nPln = 1;
+	    wSp->line1 = gObj->domain.i->line1;
+	    wSp->nLn = gObj->domain.i->lastln - gObj->domain.i->line1 + 1;
+	    break;
+	  default:
+	    errNum = WLZ_ERR_DOMAIN_TYPE;
+	    break;
+	}
+	break;
+      case WLZ_3D_DOMAINOBJ:
+	if(gObj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+	{
+	  errNum = WLZ_ERR_DOMAIN_TYPE;
+	}
+	else if((gObj->values.core != NULL) &&
+	        (gObj->values.core->type != WLZ_VOXELVALUETABLE_GREY))
+	{
+	  errNum = WLZ_ERR_VALUES_TYPE;
+	}
+	else
+	{
+	  wSp->dim = 3;
+	  wSp->plane1 = gObj->domain.p->plane1;
+	  wSp->nPln = gObj->domain.p->lastpl - gObj->domain.p->plane1 + 1;
+	  wSp->line1 = gObj->domain.p->line1;
+	  wSp->nLn = gObj->domain.p->lastln - gObj->domain.p->line1 + 1;
+	}
+	break;
+      default:
+	errNum = WLZ_ERR_OBJECT_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((wSp->nPln < 1) || (wSp->nLn < 1))
+    {
+      errNum = WLZ_ERR_DOMAIN_DATA;
+    }
+    else
+    {
+      wSp->nRow = wSp->nPln * wSp->nLn;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    wSp->oPl[0] = wSp->oPl[1] = wSp->oPl[2] = -1;
+    if(wSp->dim == 2)
+    {
+      switch(con)
+      {
+	case WLZ_4_CONNECTED:
+	  wSp->oLn = 0;
+	  break;
+	case WLZ_8_CONNECTED:
+	  wSp->oLn = 1;
+	  break;
+	default:
+	  errNum = WLZ_ERR_PARAM_DATA;
+	  break;
+      }
+    }
+    else
+    {
+      switch(con)
+      {
+	case WLZ_4_CONNECTED: /* FALLTHROUGH */
+	case WLZ_6_CONNECTED:
+	  wSp->oLn = 0;
+	  wSp->oPl[1] = 0;
+	  break;
+	case WLZ_18_CONNECTED:
+	  wSp->oLn = 1;
+	  wSp->oPl[0] = wSp->oPl[2] = 0;
+	  wSp->oPl[1] = 1;
+	  break;
+	case WLZ_8_CONNECTED: /* FALLTHROUGH */
+	case WLZ_26_CONNECTED:
+	  wSp->oLn = 1;
+	  wSp->oPl[0] = wSp->oPl[1] = wSp->oPl[2] = 1;
+	  break;
+	default:
+	  errNum = WLZ_ERR_PARAM_DATA;
+	  break;
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && grey)
+  {
+    if(gObj->values.core == NULL)
+    {
+      errNum = WLZ_ERR_VALUES_NULL;
+    }
+    else
+    {
+      wSp->grey = 1;
+      wSp->gType = WlzGreyTypeFromObj(gObj, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      switch(wSp->gType)
+      {
+        case WLZ_GREY_INT:    /* FALLTHROUGH */
+        case WLZ_GREY_SHORT:  /* FALLTHROUGH */
+        case WLZ_GREY_UBYTE:  /* FALLTHROUGH */
+        case WLZ_GREY_FLOAT:  /* FALLTHROUGH */
+        case WLZ_GREY_DOUBLE: /* FALLTHROUGH */
+        case WLZ_GREY_RGBA:
+	  break;
+	default:
+	  errNum = WLZ_ERR_GREY_TYPE;
+	  break;
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((wSp->rowOff = (int *)AlcCalloc(wSp->nRow + 1, sizeof(int))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzBinaryOps
+* \brief	Frees the arrays of the given work space.
+* \param	wSp			Given work space.
+*/
+static void			WlzLabelUFFreeWSp(
+				  WlzLabelUFWSp *wSp)
+{
+  AlcFree(wSp->rowOff);
+  AlcFree(wSp->lbl);
+  AlcFree(wSp->itv);
+  AlcFree(wSp->gItv);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzBinaryOps
+* \brief	Collects the intervals of the given object into the rows
+* 		of the work space. The planes are scanned in parallel,
+* 		first counting the intervals of each row and then, after
+* 		the row offsets have been computed, copying them. If grey
+* 		value statistics are required they are computed for each
+* 		interval while copying.
+* \param	wSp			Work space.
+* \param	gObj			Given object.
+*/
+static WlzErrorNum		WlzLabelUFScan(
+				  WlzLabelUFWSp *wSp,
+				  WlzObject *gObj)
+{
+  int		pass,
+  		r;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  for(pass = 0; (errNum == WLZ_ERR_NONE) && (pass < 2); ++pass)
+  {
+    int		p;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(p = 0; p < wSp->nPln; ++p)
+    {
+      WlzDomain	dom2;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      dom2 = (wSp->dim == 2)? gObj->domain: gObj->domain.p->domains[p];
+      if((dom2.core != NULL) && (dom2.core->type != WLZ_EMPTY_DOMAIN))
+      {
+	int	grey;
+	WlzObject *obj2;
+	WlzValues val2;
+
+	val2.core = NULL;
+	grey = (pass == 1) && (wSp->gItv != NULL);
+	if(grey)
+	{
+	  val2 = (wSp->dim == 2)? gObj->values: gObj->values.vox->values[p];
+	}
+	obj2 = WlzAssignObject(
+	       WlzMakeMain(WLZ_2D_DOMAINOBJ, dom2, val2,
+			   NULL, NULL, &errNum2), NULL);
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  WlzIntervalWSpace iWSp;
+	  WlzGreyWSpace gWSp;
+
+	  if(grey)
+	  {
+	    errNum2 = WlzInitGreyScan(obj2, &iWSp, &gWSp);
+	  }
+	  else
+	  {
+	    errNum2 = WlzInitRasterScan(obj2, &iWSp, WLZ_RASTERDIR_ILIC);
+	  }
+	  if(errNum2 == WLZ_ERR_NONE)
+	  {
+	    int	r0;
+
+	    r0 = p * wSp->nLn - wSp->line1;
+	    if(pass == 0)
+	    {
+	      while((errNum2 = WlzNextInterval(&iWSp)) == WLZ_ERR_NONE)
+	      {
+		++(wSp->rowOff[r0 + iWSp.linpos + 1]);
+	      }
+	    }
+	    else
+	    {
+	      int	i;
+
+	      i = wSp->rowOff[p * wSp->nLn];
+	      while((errNum2 = (grey)? WlzNextGreyInterval(&iWSp):
+	                               WlzNextInterval(&iWSp)) == WLZ_ERR_NONE)
+	      {
+		wSp->itv[i].ileft = iWSp.lftpos;
+		wSp->itv[i].iright = iWSp.rgtpos;
+		if(grey)
+		{
+		  WlzLabelUFGreyItv(wSp->gItv + (4 * i), &gWSp, iWSp.colrmn);
+		}
+		++i;
+	      }
+	    }
+	    if(errNum2 == WLZ_ERR_EOO)
+	    {
+	      errNum2 = WLZ_ERR_NONE;
+	    }
+	    if(grey)
+	    {
+	      (void )WlzEndGreyScan(&iWSp, &gWSp);
+	    }
+	  }
+	}
+	(void )WlzFreeObj(obj2);
+      }
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzLabelUFScan)
+#endif
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	  }
+	}
+      }
+    }
+    if((errNum == WLZ_ERR_NONE) && (pass == 0))
+    {
+      for(r = 0; r < wSp->nRow; ++r)
+      {
+        wSp->rowOff[r + 1] += wSp->rowOff[r];
+      }
+      wSp->nItv = wSp->rowOff[wSp->nRow];
+      if(((wSp->itv = (WlzInterval *)
+                      AlcMalloc(sizeof(WlzInterval) *
+		                WLZ_MAX(wSp->nItv, 1))) == NULL) ||
+         (wSp->grey &&
+	  ((wSp->gItv = (double *)
+	                AlcMalloc(sizeof(double) * 4 *
+			          WLZ_MAX(wSp->nItv, 1))) == NULL)))
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzBinaryOps
+* \brief	Joins the connected intervals of two rows in the given
+* 		union-find tree.
+* \param	uft			Union-find tree.
+* \param	base			Index of the interval which is node
+* 					zero of the tree.
+* \param	wSp			Work space.
+* \param	q			Earlier row.
+* \param	r			Later row.
+* \param	off			Column offset for intervals to
+* 					be connected, 0 if they must overlap
+* 					and 1 if they may be diagonally
+* 					adjacent.
+*/
+static void			WlzLabelUFJoinRows(
+				  AlcUFTree *uft,
+				  int base,
+				  WlzLabelUFWSp *wSp,
+				  int q,
+				  int r,
+				  int off)
+{
+  int		i,
+  		j,
+		i1,
+		j1;
+  WlzInterval	*itv;
+
+  itv = wSp->itv;
+  i = wSp->rowOff[q];
+  i1 = wSp->rowOff[q + 1];
+  j = wSp->rowOff[r];
+  j1 = wSp->rowOff[r + 1];
+  while((i < i1) && (j < j1))
+  {
+    if(itv[i].iright + off < itv[j].ileft)
+    {
+      ++i;
+    }
+    else if(itv[j].iright + off < itv[i].ileft)
+    {
+      ++j;
+    }
+    else
+    {
+      AlcUFTreeUnion(uft, i - base, j - base);
+      if(itv[i].iright < itv[j].iright)
+      {
+        ++i;
+      }
+      else
+      {
+        ++j;
+      }
+    }
+  }
+}
+
+/*!
+* \ingroup	WlzBinaryOps
+* \brief	Joins the intervals of the given row to those of the
+* 		earlier rows with which they may be connected, but only
+* 		for the earlier rows q with \f$qMin \leq q < qMax\f$.
+* \param	uft			Union-find tree.
+* \param	base			Index of the interval which is node
+* 					zero of the tree.
+* \param	wSp			Work space.
+* \param	r			Given row.
+* \param	qMin			Minimum earlier row.
+* \param	qMax			Maximum earlier row plus one.
+*/
+static void			WlzLabelUFJoin(
+				  AlcUFTree *uft,
+				  int base,
+				  WlzLabelUFWSp *wSp,
+				  int r,
+				  int qMin,
+				  int qMax)
+{
+  int		l,
+  		q;
+
+  if(wSp->rowOff[r] < wSp->rowOff[r + 1])
+  {
+    l = r % wSp->nLn;
+    q = r - 1;
+    if((l > 0) && (q >= qMin) && (q < qMax))
+    {
+      WlzLabelUFJoinRows(uft, base, wSp, q, r, wSp->oLn);
+    }
+    if(r >= wSp->nLn)
+    {
+      int	d;
+
+      for(d = -1; d <= 1; ++d)
+      {
+	q = r - wSp->nLn + d;
+	if((wSp->oPl[d + 1] >= 0) && (l + d >= 0) && (l + d < wSp->nLn) &&
+	   (q >= qMin) && (q < qMax))
+	{
+	  WlzLabelUFJoinRows(uft, base, wSp, q, r, wSp->oPl[d + 1]);
+	}
+      }
+    }
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzBinaryOps
+* \brief	Builds the connectivity of the intervals and then labels
+* 		them. The rows are partitioned into slabs of whole planes
+* 		(3D) or lines (2D). The slabs are joined in parallel, each
+* 		using a union-find tree which is a view of the part of the
+* 		single tree holding the slab's own intervals, indexed from
+* 		the slab's first interval, so that no two threads modify
+* 		the same nodes. The rows at the start of each slab are
+* 		then joined to those of the previous slab.
+* \param	wSp			Work space.
+*/
+static WlzErrorNum		WlzLabelUFUnion(
+				  WlzLabelUFWSp *wSp)
+{
+  int		s,
+  		nSlab = 1,
+		nUnit,
+		unitRows;
+  AlcUFTree	*uft = NULL;
+  int		*rootLbl = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(wSp->nItv > 0)
+  {
+    if(((uft = AlcUFTreeNew(wSp->nItv, wSp->nItv)) == NULL) ||
+       ((wSp->lbl = (int *)AlcMalloc(sizeof(int) * wSp->nItv)) == NULL) ||
+       ((rootLbl = (int *)AlcMalloc(sizeof(int) * wSp->nItv)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (wSp->nItv > 0))
+  {
+    if(wSp->nPln > 1)
+    {
+      nUnit = wSp->nPln;
+      unitRows = wSp->nLn;
+    }
+    else
+    {
+      nUnit = wSp->nLn;
+      unitRows = 1;
+    }
+#ifdef _OPENMP
+    nSlab = WLZ_MIN(nUnit, omp_get_max_threads());
+#endif
+    uft->nCmp = 0;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(s = 0; s < nSlab; ++s)
+    {
+      int	i,
+      		r,
+      		r0,
+		r1,
+		base;
+      AlcUFTree	slab;
+
+      r0 = (int )(((long )s * nUnit) / nSlab) * unitRows;
+      r1 = (int )(((long )(s + 1) * nUnit) / nSlab) * unitRows;
+      base = wSp->rowOff[r0];
+      slab.maxNod = wSp->rowOff[r1] - base;
+      slab.pr = uft->pr + base;
+      slab.sz = uft->sz + base;
+      AlcUFTreeInit(&slab, slab.maxNod);
+      for(r = r0; r < r1; ++r)
+      {
+	WlzLabelUFJoin(&slab, base, wSp, r, r0, r1);
+      }
+      /* The slab's nodes are indexed from its first interval. */
+      for(i = 0; i < slab.nNod; ++i)
+      {
+        slab.pr[i] += base;
+      }
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      uft->nCmp += slab.nCmp;
+    }
+    for(s = 1; s < nSlab; ++s)
+    {
+      int	r,
+      		r0,
+		r1;
+
+      r0 = (int )(((long )s * nUnit) / nSlab) * unitRows;
+      r1 = WLZ_MIN(wSp->nRow, r0 + wSp->nLn + 1);
+      for(r = r0; r < r1; ++r)
+      {
+	WlzLabelUFJoin(uft, 0, wSp, r, 0, r0);
+      }
+    }
+  }
+  /* Number the components in the order of their first interval. */
+  if((errNum == WLZ_ERR_NONE) && (wSp->nItv > 0))
+  {
+    int		i;
+
+    for(i = 0; i < wSp->nItv; ++i)
+    {
+      rootLbl[i] = -1;
+    }
+    for(i = 0; i < wSp->nItv; ++i)
+    {
+      int	rt;
+
+      rt = AlcUFTreeFind(uft, i);
+      if(rootLbl[rt] < 0)
+      {
+	rootLbl[rt] = wSp->nLbl++;
+      }
+      wSp->lbl[i] = rootLbl[rt];
+    }
+  }
+  AlcFree(rootLbl);
+  AlcUFTreeFree(uft);
+  return(errNum);
+}
+
+/*!
+* \return	New index object or NULL on error.
+* \ingroup	WlzBinaryOps
+* \brief	Makes an index object with the domain of the given object
+* 		and grey values set to the label of each interval plus one.
+* 		The planes are filled in parallel.
+* \param	gObj			Given object.
+* \param	wSp			Work space with the labeled intervals.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject		*WlzLabelUFMakeIdx(
+				  WlzObject *gObj,
+				  WlzLabelUFWSp *wSp,
+				  WlzErrorNum *dstErr)
+{
+  WlzObject	*rObj = NULL;
+  WlzValues	val;
+  WlzPixelV	bgdV;
+  WlzObjectType	gTT;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  val.core = NULL;
+  if(wSp->nLbl < 1)
+  {
+    rObj = WlzMakeEmpty(&errNum);
+  }
+  else
+  {
+    if(wSp->nLbl <= 255)
+    {
+      bgdV.type = WLZ_GREY_UBYTE;
+      bgdV.v.ubv = 0;
+    }
+    else if(wSp->nLbl <= SHRT_MAX)
+    {
+      bgdV.type = WLZ_GREY_SHORT;
+      bgdV.v.shv = 0;
+    }
+    else
+    {
+      bgdV.type = WLZ_GREY_INT;
+      bgdV.v.inv = 0;
+    }
+    gTT = WlzGreyTableType(WLZ_GREY_TAB_RAGR, bgdV.type, NULL);
+    if(wSp->dim == 2)
+    {
+      val.v = WlzNewValueTb(gObj, gTT, bgdV, &errNum);
+    }
+    else
+    {
+      val.vox = WlzNewValuesVox(gObj, gTT, bgdV, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      rObj = WlzMakeMain(gObj->type, gObj->domain, val, NULL, NULL,
+                         &errNum);
+    }
+    else if(val.core != NULL)
+    {
+      if(wSp->dim == 2)
+      {
+	(void )WlzFreeValueTb(val.v);
+      }
+      else
+      {
+	(void )WlzFreeVoxelValueTb(val.vox);
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (wSp->nLbl > 0))
+  {
+    int		p;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(p = 0; p < wSp->nPln; ++p)
+    {
+      WlzDomain	dom2;
+      WlzValues	val2;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      if(wSp->dim == 2)
+      {
+        dom2 = gObj->domain;
+	val2 = val;
+      }
+      else
+      {
+        dom2 = gObj->domain.p->domains[p];
+	val2 = val.vox->values[p];
+      }
+      if((dom2.core != NULL) && (dom2.core->type != WLZ_EMPTY_DOMAIN) &&
+         (val2.core != NULL))
+      {
+	WlzObject *obj2;
+
+	obj2 = WlzAssignObject(
+	       WlzMakeMain(WLZ_2D_DOMAINOBJ, dom2, val2,
+			   NULL, NULL, &errNum2), NULL);
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  WlzIntervalWSpace iWSp;
+	  WlzGreyWSpace gWSp;
+
+	  errNum2 = WlzInitGreyScan(obj2, &iWSp, &gWSp);
+	  if(errNum2 == WLZ_ERR_NONE)
+	  {
+	    int	*lbl;
+
+	    lbl = wSp->lbl + wSp->rowOff[p * wSp->nLn];
+	    while((errNum2 = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+	    {
+	      int	i,
+	      		l;
+	      WlzGreyP	gP;
+
+	      l = *lbl++ + 1;
+	      gP = gWSp.u_grintptr;
+	      switch(gWSp.pixeltype)
+	      {
+		case WLZ_GREY_UBYTE:
+		  for(i = 0; i < iWSp.colrmn; ++i)
+		  {
+		    gP.ubp[i] = (WlzUByte )l;
+		  }
+		  break;
+		case WLZ_GREY_SHORT:
+		  for(i = 0; i < iWSp.colrmn; ++i)
+		  {
+		    gP.shp[i] = (short )l;
+		  }
+		  break;
+		default:
+		  for(i = 0; i < iWSp.colrmn; ++i)
+		  {
+		    gP.inp[i] = l;
+		  }
+		  break;
+	      }
+	    }
+	    if(errNum2 == WLZ_ERR_EOO)
+	    {
+	      errNum2 = WLZ_ERR_NONE;
+	    }
+	    (void )WlzEndGreyScan(&iWSp, &gWSp);
+	  }
+	}
+	(void )WlzFreeObj(obj2);
+      }
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzLabelUFMakeIdx)
+#endif
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	  }
+	}
+      }
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(rObj);
+    rObj = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
+
+/*!
+* \return	New compound array object or NULL on error.
+* \ingroup	WlzBinaryOps
+* \brief	Makes a compound array object with a domain object for
+* 		each label. The intervals are sorted by label, keeping
+* 		their raster order within each label, and then the
+* 		objects are made in parallel.
+* \param	gObj			Given object.
+* \param	wSp			Work space with the labeled intervals.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject		*WlzLabelUFMakeCmp(
+				  WlzObject *gObj,
+				  WlzLabelUFWSp *wSp,
+				  WlzErrorNum *dstErr)
+{
+  int		*srt = NULL,
+  		*srtRow = NULL,
+		*lblOff = NULL;
+  WlzCompoundArray *cObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  cObj = WlzMakeCompoundArray(WLZ_COMPOUND_ARR_1, 1, wSp->nLbl, NULL,
+                              gObj->type, &errNum);
+  if((errNum == WLZ_ERR_NONE) && (wSp->nLbl > 0))
+  {
+    if(((srt = (int *)AlcMalloc(sizeof(int) * wSp->nItv)) == NULL) ||
+       ((srtRow = (int *)AlcMalloc(sizeof(int) * wSp->nItv)) == NULL) ||
+       ((lblOff = (int *)AlcCalloc(wSp->nLbl + 1, sizeof(int))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (wSp->nLbl > 0))
+  {
+    int		i,
+    		r;
+
+    for(i = 0; i < wSp->nItv; ++i)
+    {
+      ++(lblOff[wSp->lbl[i] + 1]);
+    }
+    for(i = 0; i < wSp->nLbl; ++i)
+    {
+      lblOff[i + 1] += lblOff[i];
+    }
+    for(r = 0; r < wSp->nRow; ++r)
+    {
+      for(i = wSp->rowOff[r]; i < wSp->rowOff[r + 1]; ++i)
+      {
+	int	j;
+
+	j = lblOff[wSp->lbl[i]]++;
+	srt[j] = i;
+	srtRow[j] = r;
+      }
+    }
+    /* The offsets have been moved on to the start of the next label. */
+    for(i = wSp->nLbl; i > 0; --i)
+    {
+      lblOff[i] = lblOff[i - 1];
+    }
+    lblOff[0] = 0;
+    cObj->n = wSp->nLbl;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for(i = 0; i < wSp->nLbl; ++i)
+    {
+      if(errNum == WLZ_ERR_NONE)
+      {
+	WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+	cObj->o[i] = WlzAssignObject(
+		     WlzLabelUFMakeObj(gObj, wSp,
+		                       srt + lblOff[i], srtRow + lblOff[i],
+				       lblOff[i + 1] - lblOff[i], &errNum2),
+		     NULL);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzLabelUFMakeCmp)
+#endif
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+	}
+      }
+    }
+  }
+  AlcFree(srt);
+  AlcFree(srtRow);
+  AlcFree(lblOff);
+  if((errNum != WLZ_ERR_NONE) && (cObj != NULL))
+  {
+    (void )WlzFreeObj((WlzObject *)cObj);
+    cObj = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return((WlzObject *)cObj);
+}
+
+/*!
+* \return	New domain object or NULL on error.
+* \ingroup	WlzBinaryOps
+* \brief	Makes a domain object from the given intervals of a single
+* 		label, which share the values of the given object.
+* \param	gObj			Given object.
+* \param	wSp			Work space.
+* \param	srt			Indices of the intervals in raster
+* 					order.
+* \param	srtRow			Rows of the intervals.
+* \param	n			Number of intervals.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject		*WlzLabelUFMakeObj(
+				  WlzObject *gObj,
+				  WlzLabelUFWSp *wSp,
+				  int *srt,
+				  int *srtRow,
+				  int n,
+				  WlzErrorNum *dstErr)
+{
+  WlzObject	*rObj = NULL;
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dom.core = NULL;
+  val.core = NULL;
+  if(wSp->dim == 2)
+  {
+    dom.i = WlzLabelUFMakeIDom(wSp, srt, srtRow, n, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      val = gObj->values;
+    }
+  }
+  else
+  {
+    int		i,
+    		i0,
+		p,
+		p1,
+		pl,
+		l1,
+		ll,
+		k1,
+		lk;
+
+    p1 = srtRow[0] / wSp->nLn;
+    pl = srtRow[n - 1] / wSp->nLn;
+    l1 = ll = srtRow[0] % wSp->nLn;
+    k1 = wSp->itv[srt[0]].ileft;
+    lk = wSp->itv[srt[0]].iright;
+    for(i = 1; i < n; ++i)
+    {
+      int	l;
+      WlzInterval *itv;
+
+      l = srtRow[i] % wSp->nLn;
+      itv = wSp->itv + srt[i];
+      l1 = WLZ_MIN(l1, l);
+      ll = WLZ_MAX(ll, l);
+      k1 = WLZ_MIN(k1, itv->ileft);
+      lk = WLZ_MAX(lk, itv->iright);
+    }
+    dom.p = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
+			       wSp->plane1 + p1, wSp->plane1 + pl,
+			       wSp->line1 + l1, wSp->line1 + ll, k1, lk,
+			       &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      dom.p->voxel_size[0] = gObj->domain.p->voxel_size[0];
+      dom.p->voxel_size[1] = gObj->domain.p->voxel_size[1];
+      dom.p->voxel_size[2] = gObj->domain.p->voxel_size[2];
+    }
+    i0 = 0;
+    while((errNum == WLZ_ERR_NONE) && (i0 < n))
+    {
+      WlzDomain	dom2;
+
+      p = srtRow[i0] / wSp->nLn;
+      for(i = i0 + 1; (i < n) && (srtRow[i] / wSp->nLn == p); ++i)
+      {
+        /* Find the end of the intervals in this plane. */
+      }
+      dom2.i = WlzLabelUFMakeIDom(wSp, srt + i0, srtRow + i0, i - i0,
+                                  &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        dom.p->domains[p - p1] = WlzAssignDomain(dom2, NULL);
+      }
+      i0 = i;
+    }
+    if((errNum == WLZ_ERR_NONE) && (gObj->values.core != NULL))
+    {
+      WlzPixelV	bgdV;
+
+      bgdV = WlzGetBackground(gObj, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	val.vox = WlzMakeVoxelValueTb(WLZ_VOXELVALUETABLE_GREY,
+				      dom.p->plane1, dom.p->lastpl,
+				      bgdV, NULL, &errNum);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	for(p = p1; p <= pl; ++p)
+	{
+	  val.vox->values[p - p1] = WlzAssignValues(
+				    gObj->values.vox->values[p], NULL);
+	}
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rObj = WlzMakeMain(gObj->type, dom, val, NULL, NULL, &errNum);
+  }
+  if(rObj == NULL)
+  {
+    if(dom.core != NULL)
+    {
+      (void )WlzFreeDomain(dom);
+    }
+    if((wSp->dim == 3) && (val.core != NULL))
+    {
+      (void )WlzFreeVoxelValueTb(val.vox);
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
+
+/*!
+* \return	New interval domain or NULL on error.
+* \ingroup	WlzBinaryOps
+* \brief	Makes an interval domain from the given intervals, which
+* 		must all be in the same plane and in raster order.
+* \param	wSp			Work space.
+* \param	srt			Indices of the intervals.
+* \param	srtRow			Rows of the intervals.
+* \param	n			Number of intervals.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzIntervalDomain	*WlzLabelUFMakeIDom(
+				  WlzLabelUFWSp *wSp,
+				  int *srt,
+				  int *srtRow,
+				  int n,
+				  WlzErrorNum *dstErr)
+{
+  int		i,
+  		k1,
+		lk,
+		l1,
+		ll;
+  WlzInterval	*itv = NULL;
+  WlzIntervalDomain *iDom = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  l1 = wSp->line1 + srtRow[0] % wSp->nLn;
+  ll = wSp->line1 + srtRow[n - 1] % wSp->nLn;
+  k1 = wSp->itv[srt[0]].ileft;
+  lk = wSp->itv[srt[0]].iright;
+  for(i = 1; i < n; ++i)
+  {
+    k1 = WLZ_MIN(k1, wSp->itv[srt[i]].ileft);
+    lk = WLZ_MAX(lk, wSp->itv[srt[i]].iright);
+  }
+  iDom = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_INTVL, l1, ll, k1, lk,
+  			       &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((itv = (WlzInterval *)AlcMalloc(sizeof(WlzInterval) * n)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      iDom->freeptr = AlcFreeStackPush(iDom->freeptr, (void *)itv, NULL);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		i0;
+
+    for(i = 0; i < n; ++i)
+    {
+      itv[i].ileft = wSp->itv[srt[i]].ileft - k1;
+      itv[i].iright = wSp->itv[srt[i]].iright - k1;
+    }
+    i0 = 0;
+    while((errNum == WLZ_ERR_NONE) && (i0 < n))
+    {
+      for(i = i0 + 1; (i < n) && (srtRow[i] == srtRow[i0]); ++i)
+      {
+        /* Find the end of the intervals in this line. */
+      }
+      errNum = WlzMakeInterval(wSp->line1 + srtRow[i0] % wSp->nLn, iDom,
+                               i - i0, itv + i0);
+      i0 = i;
+    }
+  }
+  if((errNum != WLZ_ERR_NONE) && (iDom != NULL))
+  {
+    (void )WlzFreeIntervalDomain(iDom);
+    iDom = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(iDom);
+}
+
+/*!
+* \ingroup	WlzBinaryOps
+* \brief	Computes the minimum, maximum, sum and sum of squares of
+* 		the grey values of the current interval of a grey scan.
+* \param	g			Destination for the four values.
+* \param	gWSp			Grey work space of the scan.
+* \param	n			Number of values in the interval.
+*/
+static void			WlzLabelUFGreyItv(
+				  double *g,
+				  WlzGreyWSpace *gWSp,
+				  int n)
+{
+  int		i;
+  double	v,
+  		gMin,
+		gMax,
+		gSum = 0.0,
+		gSumSq = 0.0;
+  WlzGreyP	gP;
+
+  gP = gWSp->u_grintptr;
+  gMin = DBL_MAX;
+  gMax = -DBL_MAX;
+  for(i = 0; i < n; ++i)
+  {
+    switch(gWSp->pixeltype)
+    {
+      case WLZ_GREY_INT:
+	v = gP.inp[i];
+	break;
+      case WLZ_GREY_SHORT:
+	v = gP.shp[i];
+	break;
+      case WLZ_GREY_UBYTE:
+	v = gP.ubp[i];
+	break;
+      case WLZ_GREY_FLOAT:
+	v = gP.flp[i];
+	break;
+      case WLZ_GREY_DOUBLE:
+	v = gP.dbp[i];
+	break;
+      case WLZ_GREY_RGBA:
+	v = WLZ_RGBA_MODULUS(gP.rgbp[i]);
+	break;
+      default:
+	v = 0.0;
+	break;
+    }
+    if(v < gMin)
+    {
+      gMin = v;
+    }
+    if(v > gMax)
+    {
+      gMax = v;
+    }
+    gSum += v;
+    gSumSq += v * v;
+  }
+  g[0] = gMin;
+  g[1] = gMax;
+  g[2] = gSum;
+  g[3] = gSumSq;
+}
+
+/*!
+* \return	New table of component statistics or NULL on error.
+* \ingroup	WlzBinaryOps
+* \brief	Accumulates the statistics of each component from its
+* 		labeled intervals. The sums of the coordinates are
+* 		accumulated relative to the first plane, line and column
+* 		of the object so that the central moments can be computed
+* 		from them without significant loss of precision.
+* \param	wSp			Work space with the labeled intervals.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzLabelStats		*WlzLabelUFMakeStats(
+				  WlzLabelUFWSp *wSp,
+				  WlzErrorNum *dstErr)
+{
+  int		k0 = 0;
+  double	*sum = NULL;
+  WlzLabelStats	*stats = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const int	nSum = 9;
+
+  if(((stats = (WlzLabelStats *)
+               AlcCalloc(1, sizeof(WlzLabelStats))) == NULL) ||
+     ((stats->stat = (WlzLabelStat *)
+                     AlcCalloc(WLZ_MAX(wSp->nLbl, 1),
+		               sizeof(WlzLabelStat))) == NULL) ||
+     ((sum = (double *)AlcCalloc(nSum * WLZ_MAX(wSp->nLbl, 1),
+     				 sizeof(double))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		i,
+    		r;
+
+    stats->nLbl = wSp->nLbl;
+    stats->grey = wSp->grey;
+    stats->gType = (wSp->grey)? wSp->gType: WLZ_GREY_ERROR;
+    for(i = 0; i < wSp->nItv; ++i)
+    {
+      k0 = (i == 0)? wSp->itv[0].ileft: WLZ_MIN(k0, wSp->itv[i].ileft);
+    }
+    for(r = 0; r < wSp->nRow; ++r)
+    {
+      int	x,
+		y,
+		z;
+
+      y = wSp->line1 + (r % wSp->nLn);
+      z = (wSp->dim == 2)? 0: wSp->plane1 + (r / wSp->nLn);
+      for(i = wSp->rowOff[r]; i < wSp->rowOff[r + 1]; ++i)
+      {
+	int	l;
+	double	n,
+		u0,
+		u1,
+		v,
+		w,
+		su,
+		suu;
+	double	*s;
+	WlzLabelStat *st;
+
+	l = wSp->lbl[i];
+	st = stats->stat + l;
+	s = sum + (nSum * l);
+	x = wSp->itv[i].ileft;
+	n = wSp->itv[i].iright - x + 1;
+	u0 = x - k0;
+	u1 = u0 + n - 1;
+	v = r % wSp->nLn;
+	w = r / wSp->nLn;
+	su = 0.5 * n * (u0 + u1);
+	suu = ((u1 * (u1 + 1.0) * (2.0 * u1 + 1.0)) -
+	       ((u0 - 1.0) * u0 * (2.0 * u0 - 1.0))) / 6.0;
+	if(st->vol < 0.5)
+	{
+	  st->bBox.xMin = x;
+	  st->bBox.xMax = wSp->itv[i].iright;
+	  st->bBox.yMin = st->bBox.yMax = y;
+	  st->bBox.zMin = st->bBox.zMax = z;
+	  if(wSp->grey)
+	  {
+	    st->gMin = wSp->gItv[4 * i];
+	    st->gMax = wSp->gItv[4 * i + 1];
+	  }
+	}
+	else
+	{
+	  st->bBox.xMin = WLZ_MIN(st->bBox.xMin, x);
+	  st->bBox.xMax = WLZ_MAX(st->bBox.xMax, wSp->itv[i].iright);
+	  st->bBox.yMax = WLZ_MAX(st->bBox.yMax, y);
+	  st->bBox.zMax = z;
+	  if(wSp->grey)
+	  {
+	    st->gMin = WLZ_MIN(st->gMin, wSp->gItv[4 * i]);
+	    st->gMax = WLZ_MAX(st->gMax, wSp->gItv[4 * i + 1]);
+	  }
+	}
+	st->bBox.yMin = WLZ_MIN(st->bBox.yMin, y);
+	st->vol += n;
+	s[0] += su;				/* x */
+	s[1] += n * v;				/* y */
+	s[2] += n * w;				/* z */
+	s[3] += suu;				/* xx */
+	s[4] += n * v * v;			/* yy */
+	s[5] += n * w * w;			/* zz */
+	s[6] += su * v;				/* xy */
+	s[7] += su * w;				/* xz */
+	s[8] += n * v * w;			/* yz */
+	if(wSp->grey)
+	{
+	  st->gSum += wSp->gItv[4 * i + 2];
+	  st->gSumSq += wSp->gItv[4 * i + 3];
+	}
+      }
+    }
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(i = 0; i < wSp->nLbl; ++i)
+    {
+      double	n;
+      double	*s;
+      WlzDVertex3 c;
+      WlzLabelStat *st;
+
+      st = stats->stat + i;
+      s = sum + (nSum * i);
+      n = st->vol;
+      c.vtX = s[0] / n;
+      c.vtY = s[1] / n;
+      c.vtZ = s[2] / n;
+      st->mom[0] = (s[3] / n) - (c.vtX * c.vtX);
+      st->mom[1] = (s[4] / n) - (c.vtY * c.vtY);
+      st->mom[2] = (s[5] / n) - (c.vtZ * c.vtZ);
+      st->mom[3] = (s[6] / n) - (c.vtX * c.vtY);
+      st->mom[4] = (s[7] / n) - (c.vtX * c.vtZ);
+      st->mom[5] = (s[8] / n) - (c.vtY * c.vtZ);
+      st->cen.vtX = c.vtX + k0;
+      st->cen.vtY = c.vtY + wSp->line1;
+      st->cen.vtZ = (wSp->dim == 2)? 0.0: c.vtZ + wSp->plane1;
+      if(wSp->grey)
+      {
+	st->gMean = st->gSum / n;
+	st->gStdDev = (n > 1.0)?
+		      sqrt((st->gSumSq - (st->gSum * st->gSum / n)) /
+		           (n - 1.0)): 0.0;
+      }
+    }
+  }
+  AlcFree(sum);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeLabelStats(stats);
+    stats = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(stats);
+}
@@ -139,6 +139,12 @@ extern WlzObject		*WlzGetProjectionFromObject(
 				  Wlz3DProjectionIntFn intFunc,
 				  void *intFuncData,
 				  WlzErrorNum *dstErr);
+extern WlzObject		*WlzProjectObjRays(
+				  WlzObject *obj,
+				  WlzThreeDViewStruct *vStr,
+				  WlzProjectRayMode mode,
+				  double depth,
+				  WlzErrorNum *dstErr);
 #endif /* WLZ_EXT_BIND */
 
 /************************************************************************
@@ -166,6 +172,12 @@ extern WlzObject 		*WlzGetSubSectionFromObject(
 				  WlzInterpolationType	interp,
 				  WlzObject	**maskRtn,
 				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzGetSectionsFromObject(
+				  WlzObject *obj,
+				  int nView,
+				  WlzThreeDViewStruct **views,
+				  WlzInterpolationType interp,
+				  WlzObject **dstSecs);
 #endif
 
 /************************************************************************
@@ -472,6 +484,14 @@ extern WlzDVertex3     		WlzAffineTransformVertexD3(
 				  WlzAffineTransform *trans,
 				  WlzDVertex3 srcVtx,
 				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzAffineTransformVerticesD2(
+				  WlzAffineTransform *tr,
+				  int nVtx,
+				  WlzDVertex2 *vtx);
+extern WlzErrorNum		WlzAffineTransformVerticesD3(
+				  WlzAffineTransform *tr,
+				  int nVtx,
+				  WlzDVertex3 *vtx);
 extern WlzFVertex2     		WlzAffineTransformVertexF2(
 				  WlzAffineTransform *trans,
 				  WlzFVertex2 srcVtx,
@@ -1016,6 +1036,22 @@ extern double          		WlzBasisFnValueMOSPhi(
 				  double r,
 				  double delta,
 				  double tau);
+extern WlzDVertex2		WlzBasisFnValueCS2D(
+				  WlzBasisFn *basisFn,
+				  WlzDVertex2 srcVx);
+extern WlzDVertex3		WlzBasisFnValueCS3D(
+				  WlzBasisFn *basisFn,
+				  WlzDVertex3 srcVx);
+extern WlzErrorNum		WlzBasisFnValues2D(
+				  WlzBasisFn *basisFn,
+				  int nVx,
+				  WlzDVertex2 *srcVx,
+				  WlzDVertex2 *dstVx);
+extern WlzErrorNum		WlzBasisFnValues3D(
+				  WlzBasisFn *basisFn,
+				  int nVx,
+				  WlzDVertex3 *srcVx,
+				  WlzDVertex3 *dstVx);
 #ifndef WLZ_EXT_BIND
 extern WlzBasisFn		*WlzBasisFnGauss2DFromCPts(
 				  int nPts,
@@ -1090,6 +1126,18 @@ extern WlzBasisFn 		*WlzBasisFnScalarMOS3DFromCPts(
 				  double *alpha,
 				  double *param,
 				  WlzErrorNum *dstErr);
+extern WlzBasisFn		*WlzBasisFnCS2DFromCPts(
+				  int nPts,
+				  WlzDVertex2 *dPts,
+				  WlzDVertex2 *sPts,
+				  double support,
+				  WlzErrorNum *dstErr);
+extern WlzBasisFn		*WlzBasisFnCS3DFromCPts(
+				  int nPts,
+				  WlzDVertex3 *dPts,
+				  WlzDVertex3 *sPts,
+				  double support,
+				  WlzErrorNum *dstErr);
 #endif
 
 /************************************************************************
@@ -1222,6 +1270,11 @@ extern WlzDVertex2		WlzBasisFnTransformVertexD(
 				  WlzBasisFnTransform *basisTr,
 			          WlzDVertex2 srcVxF,
 				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzBasisFnTransformVertices(
+				  WlzBasisFnTransform *basisTr,
+				  WlzVertexType vType,
+				  int nVtx,
+				  WlzVertexP vtx);
 extern WlzDVertex2     		WlzBasisFnTransformNormalD(
 				  WlzBasisFnTransform *basisTr,
 				  WlzDVertex2 srcVx,
@@ -1238,6 +1291,26 @@ extern WlzBasisFnTransform 	*WlzBasisFnTrFromCPts3D(
 				  WlzCMesh3D *mesh,
 				  WlzErrorNum *dstErr);
 
+/************************************************************************
+* WlzBasisFnTree.c							*
+************************************************************************/
+extern WlzBasisFnTree		*WlzBasisFnTreeMake(
+				  WlzBasisFn *basisFn,
+				  double tol,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzBasisFnTreeFree(
+				  WlzBasisFnTree *tree);
+extern WlzErrorNum		WlzBasisFnTreeValues2D(
+				  WlzBasisFnTree *tree,
+				  int nVx,
+				  WlzDVertex2 *srcVx,
+				  WlzDVertex2 *dstVx);
+extern WlzErrorNum		WlzBasisFnTreeValues3D(
+				  WlzBasisFnTree *tree,
+				  int nVx,
+				  WlzDVertex3 *srcVx,
+				  WlzDVertex3 *dstVx);
+
 /************************************************************************
 * WlzBoundaryUtils.c							*
 ************************************************************************/
@@ -1523,6 +1596,20 @@ extern WlzCMeshElm3D		*WlzCMeshNextElm3D(
 				  int all);
 #endif /* WLZ_EXT_BIND */
 
+/************************************************************************
+* WlzCMeshSnapshot.c							*
+************************************************************************/
+#ifndef WLZ_EXT_BIND
+extern WlzCMeshSnapshot		*WlzCMeshSnapshotMake(
+				  WlzCMeshP mesh,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzCMeshSnapshotFree(
+				  WlzCMeshSnapshot *snap);
+extern WlzErrorNum		WlzCMeshSnapshotSetNodPos(
+				  WlzCMeshP mesh,
+				  WlzCMeshSnapshot *snap);
+#endif /* WLZ_EXT_BIND */
+
 /************************************************************************
 * WlzCMeshSurfMap.c                                                   *
 ************************************************************************/
@@ -3614,6 +3701,14 @@ extern WlzErrorNum 		WlzInitGreyWSpace(
 				  WlzIntervalWSpace *iwsp,
 				  WlzGreyWSpace *gwsp,
 				  int tranpl);
+extern WlzErrorNum		WlzInitGreyScanPart(
+				  WlzObject *obj,
+				  WlzIntervalScanPart *part,
+				  WlzObject *obj2D,
+				  WlzIntervalWSpace *iwsp,
+				  WlzGreyWSpace *gwsp,
+				  WlzRasterDir raster,
+				  int tranpl);
 extern WlzErrorNum 		WlzNextGreyInterval(
 				  WlzIntervalWSpace *iwsp);
 extern WlzErrorNum 		WlzGreyInterval(
@@ -3714,6 +3809,17 @@ extern WlzGreyValueWSpace 	*WlzGreyValueMakeWSp(
 				  WlzErrorNum *dstErr);
 extern void 			WlzGreyValueFreeWSp(
 				  WlzGreyValueWSpace *gVWSp);
+extern WlzGreyValueWSpace 	*WlzGreyValueCloneWSp(
+				  WlzGreyValueWSpace *gVWSp,
+				  WlzErrorNum *dstErr);
+extern WlzGreyValueWSpPool	*WlzGreyValueMakeWSpPool(
+				  WlzObject *obj,
+				  int nWSp,
+				  WlzErrorNum *dstErr);
+extern void			WlzGreyValueFreeWSpPool(
+				  WlzGreyValueWSpPool *pool);
+extern WlzGreyValueWSpace	*WlzGreyValueWSpPoolGet(
+				  WlzGreyValueWSpPool *pool);
 extern void            		WlzGreyValueGet(
 				  WlzGreyValueWSpace *gVWSp,
 				  double plane,
@@ -3737,6 +3843,12 @@ extern double			WlzGreyValueGetD(
 				  double plane,
 				  double line,
 				  double kol);
+extern WlzErrorNum		WlzGreyValueGetN(
+				  WlzGreyValueWSpace *gVWSp,
+				  int nPos,
+				  WlzDVertex3 *pos,
+				  WlzInterpolationType interp,
+				  double *dst);
 extern void	                WlzGreyValueGetDir(
 				  WlzGreyValueWSpace *gVWSp,
 				  int plane,
@@ -3968,6 +4080,17 @@ extern WlzErrorNum 		WlzInitLineScan(
 				  WlzRasterDir raster,
 				  int scale,
 				  int firstline);
+extern WlzIntervalScanPart	*WlzMakeIntervalScanParts(
+				  WlzObject *obj,
+				  int nPart,
+				  int *dstNPart,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzInitRasterScanPart(
+				  WlzObject *obj,
+				  WlzIntervalScanPart *part,
+				  WlzObject *obj2D,
+				  WlzIntervalWSpace *iwsp,
+				  WlzRasterDir raster);
 
 /************************************************************************
 * WlzIntRescaleObj.c							*
@@ -4232,6 +4355,25 @@ extern WlzObject		*WlzLabel3D(
 				  WlzConnectType con,
 				  WlzErrorNum *dstErr);
 
+/************************************************************************
+* WlzLabelUF.c
+************************************************************************/
+extern WlzObject		*WlzLabelUF(
+				  WlzObject *gObj,
+				  WlzConnectType con,
+				  int idxObj,
+				  int *dstNLbl,
+				  WlzErrorNum *dstErr);
+extern WlzLabelStats		*WlzLabelUFStats(
+				  WlzObject *gObj,
+				  WlzConnectType con,
+				  int grey,
+				  int idxObj,
+				  WlzObject **dstObj,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzFreeLabelStats(
+				  WlzLabelStats *stats);
+
 /************************************************************************
 * WlzLaplacian.c							*
 ************************************************************************/
@@ -5454,6 +5596,13 @@ extern WlzObjectType		WlzReadObjType(
 extern WlzObject		*WlzReadObj(
 				  FILE *fP,
 			          WlzErrorNum *dstErr);
+extern WlzObject		*WlzReadObjMapped(
+				  FILE *fP,
+			          WlzErrorNum *dstErr);
+extern WlzObject		*WlzReadObjRegion(
+				  FILE *fP,
+				  WlzIBox3 box,
+			          WlzErrorNum *dstErr);
 #ifndef WLZ_EXT_BIND
 extern WlzMeshTransform3D 	*WlzReadMeshTransform3D(
 				  FILE *fP,
@@ -5735,6 +5884,30 @@ extern WlzObject 		*WlzSepTrans(
 				  WlzErrorNum *dstErr);
 #endif /* WLZ_EXT_BIND */
 
+/************************************************************************
+* WlzSectionCache.c							*
+************************************************************************/
+#ifndef WLZ_EXT_BIND
+extern WlzSectionCache		*WlzMakeSectionCache(
+				  unsigned int maxSec,
+				  size_t maxSz,
+				  double angQ,
+				  double distQ,
+				  double scaleQ,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzFreeSectionCache(
+				  WlzSectionCache *cache);
+extern WlzErrorNum		WlzSectionCacheRemoveObj(
+				  WlzSectionCache *cache,
+				  WlzObject *obj);
+extern WlzObject		*WlzSectionCacheGet(
+				  WlzSectionCache *cache,
+				  WlzObject *obj,
+				  WlzThreeDViewStruct *view,
+				  WlzInterpolationType interp,
+				  WlzErrorNum *dstErr);
+#endif /* WLZ_EXT_BIND */
+
 /************************************************************************
 * WlzSeqPar.c								*
 ************************************************************************/
@@ -6266,6 +6439,33 @@ extern void			WlzTiledValueBufferFlush(
 extern void			WlzTiledValueBufferFill(
 				  WlzTiledValueBuffer *tvb,
 				  WlzTiledValues *tv);
+extern WlzTiledValuesCache	*WlzMakeTiledValuesCache(
+				  unsigned int maxTiles,
+				  size_t maxSz,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzFreeTiledValuesCache(
+				  WlzTiledValuesCache *cache);
+extern WlzErrorNum		WlzTiledValuesCacheAttach(
+				  WlzTiledValues *tVal,
+				  WlzTiledValuesCache *cache);
+extern WlzErrorNum		WlzTiledValuesCachePrefetch(
+				  WlzTiledValues *tVal,
+				  WlzIBox3 box);
+extern WlzErrorNum		WlzTiledValuesCacheTouch(
+				  WlzTiledValues *tVal,
+				  size_t idx);
+extern void			WlzTiledValuesCacheRelease(
+				  WlzTiledValues *tVal,
+				  size_t idx);
+extern WlzErrorNum		WlzTiledValuesCompress(
+				  WlzTiledValues *tVal,
+				  WlzTiledCompression cmp,
+				  size_t **dstOff,
+				  WlzUByte **dstTiles);
+extern WlzErrorNum		WlzMakeTiledValuesCompressedTiles(
+				  WlzTiledValues *tVal,
+				  size_t *cTileOff,
+				  WlzUByte *cTiles);
 #endif /* WLZ_EXT_BIND */
 
 /************************************************************************
@@ -6884,6 +7084,9 @@ extern const char 		*WlzWindowFnName(
 extern WlzErrorNum 		WlzWriteObj(
 				  FILE *fp,
 			          WlzObject *obj);
+extern WlzErrorNum 		WlzWriteObjIndexed(
+				  FILE *fp,
+			          WlzObject *obj);
 
 #ifndef WLZ_EXT_BIND
 extern WlzErrorNum  		WlzWriteMeshTransform3D(
@@ -48,6 +48,11 @@ static char _WlzReadObj_c[] = "University of Edinburgh $Id$";
 #include <errno.h>
 #include <unistd.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#if defined(WLZ_USE_MMAP) && defined(HAVE_FMEMOPEN)
+#define WLZ_USE_PLANE_INDEX
 #endif
 
 /* #define WLZ_DEBUG_READOBJ */
@@ -57,26 +62,94 @@ static char _WlzReadObj_c[] = "University of Edinburgh $Id$";
 #define __x86
 #endif
 
+/*!
+* \struct	_WlzReadMap
+* \ingroup	WlzIO
+* \brief	A private memory mapping of a whole file from which value
+* 		tables are read by WlzReadObjMapped(). Each value table
+* 		that uses the mapping holds a link to it so that the mapping
+* 		is only removed when the last of these tables is freed.
+* 		If the file could not be mapped the base address is NULL
+* 		and values are read in the usual way.
+*/
+typedef struct _WlzReadMap
+{
+  int		linkcount;		/*!< Link count. */
+  void		*base;			/*!< Base address of the mapping. */
+  size_t	len;			/*!< Length of the mapping in bytes. */
+} WlzReadMap;
+
+static WlzObject 		*WlzReadObjMap(
+				  FILE *fp,
+				  WlzReadMap **map,
+				  WlzErrorNum *dstErr);
+static WlzReadMap 		*WlzReadMapGet(
+				  FILE *fP,
+				  WlzReadMap **map);
+static void	 		WlzReadMapUnlink(
+				  void *data);
+static WlzErrorNum		WlzReadGreyValuesMapped(
+				  FILE *fP,
+				  WlzObjectType tType,
+				  WlzObject *obj,
+				  WlzReadMap **map,
+				  int *dstMapped);
+static int			WlzReadPlaneIdxValid(
+				  int *pIdx,
+				  int nPln);
+static size_t			WlzReadGreyValuesFileSz(
+				  WlzGreyType gType,
+				  WlzGreyType pType,
+				  size_t nV);
+static size_t			WlzReadGreyValuesCount(
+				  WlzIntervalDomain *iDom);
+static WlzErrorNum		WlzReadIntervalDomainSkip(
+				  FILE *fP,
+				  size_t *dstNV);
+static int			WlzReadPlaneDomainIdx(
+				  FILE *fP,
+				  WlzPlaneDomain *pDom,
+				  int *pIdx);
+static int			WlzReadVoxelValuesIdx(
+				  FILE *fP,
+				  WlzObject *obj,
+				  WlzVoxelValues *vox);
+static WlzErrorNum		WlzReadPlaneDomainRegion(
+				  FILE *fP,
+				  WlzPlaneDomain *pDom,
+				  int *pIdx,
+				  WlzIBox3 *box,
+				  size_t **dstNV);
+
 static WlzIntervalDomain 	*WlzReadIntervalDomain(
 				  FILE *fp,
 				  WlzErrorNum *);
 static WlzPlaneDomain 		*WlzReadPlaneDomain(
 				  FILE *fp,
+				  WlzIBox3 *box,
+				  int *dstIdx,
+				  size_t **dstNV,
 				  WlzErrorNum *);
 static WlzErrorNum		WlzReadGreyValues(
 				  FILE *fp,
 				  WlzObjectType type,
-				  WlzObject *obj);
+				  WlzObject *obj,
+				  WlzReadMap **map);
 static WlzErrorNum		WlzReadRectVtb(
 				  FILE *fp,
 				  WlzObject *obj,
 				  WlzObjectType type);
 static WlzErrorNum 		WlzReadDomObjValues2D(
 				  FILE *fP,
-				  WlzObject *obj);
+				  WlzObject *obj,
+				  WlzReadMap **map);
 static WlzErrorNum 		WlzReadDomObjValues3D(
 				  FILE *fP,
-				  WlzObject *obj);
+				  WlzObject *obj,
+				  WlzReadMap **map,
+				  WlzIBox3 *box,
+				  int idx,
+				  size_t *nV);
 static WlzErrorNum 		WlzReadTiledValues(
 				  FILE *fP,
 				  WlzObject *obj,
@@ -85,7 +158,14 @@ static WlzErrorNum 		WlzReadTiledValues(
 				  int map);
 static WlzErrorNum		WlzReadVoxelValues(
 				  FILE *fp,
-				  WlzObject *obj);
+				  WlzObject *obj,
+				  WlzReadMap **map,
+				  WlzIBox3 *box,
+				  int idx,
+				  size_t *nV);
+static WlzErrorNum		WlzReadGreyValuesSkip(
+				  FILE *fP,
+				  size_t nV);
 static WlzProperty	 	WlzReadProperty(
 				  FILE *fp,
 				  WlzErrorNum *);
@@ -107,6 +187,7 @@ static WlzHistogramDomain 	*WlzReadHistogramDomain(
 static WlzObject 		*WlzReadCompoundA(
 				  FILE *fp,
 				  WlzObjectType type,
+				  WlzReadMap **map,
 				  WlzErrorNum *);
 static WlzAffineTransform 	*WlzReadAffineTransform(
 				  FILE *fp,
@@ -412,6 +493,185 @@ WlzObjectType	WlzReadObjType(FILE *fP, WlzErrorNum *dstErr)
 */
 WlzObject 	*WlzReadObj(FILE *fp, WlzErrorNum *dstErr)
 {
+  return(WlzReadObjMap(fp, NULL, dstErr));
+}
+
+/*!
+* \return	New Woolz object or NULL on error.
+* \ingroup	WlzIO
+* \brief	Reads a woolz object from the given input stream in the
+* 		same way as WlzReadObj(), but where possible the grey
+* 		values of rectangular and ragged rectangle value tables
+* 		(including those of the planes of a voxel value table) are
+* 		memory mapped directly from the file rather than being read
+* 		into allocated memory. This allows very large objects to
+* 		be opened rapidly with only the pages of values which are
+* 		accessed being read from the file.
+*
+* 		Values are mapped when the values are stored in the file
+* 		using the native byte order and the value table grey type
+* 		(ie without packing), and for ragged rectangle value tables
+* 		when no line of the domain has more than one interval. All
+* 		other value tables are read as by WlzReadObj().
+*
+* 		The mapping is private so the values of the returned object
+* 		may be modified without the file being changed. The mapping
+* 		is removed when the last value table that uses it is freed.
+* 		The file must be a seekable file opened for reading, if it
+* 		is not (eg a pipe) then the object is read as by
+* 		WlzReadObj().
+* \param	fp			Input file.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject 	*WlzReadObjMapped(FILE *fp, WlzErrorNum *dstErr)
+{
+  WlzObject	*obj;
+  WlzReadMap	*map = NULL;
+
+  obj = WlzReadObjMap(fp, &map, dstErr);
+  if(map != NULL)
+  {
+    WlzReadMapUnlink(map);
+  }
+  return(obj);
+}
+
+/*!
+* \return	New Woolz object or NULL on error.
+* \ingroup	WlzIO
+* \brief	Reads the part of a woolz object which lies within the
+* 		given region from the given input stream. The returned
+* 		object is that which would be given by reading the object
+* 		and then clipping it using WlzClipObjToBox3D(), but for
+* 		3D domain objects only the parts of the file needed for the
+* 		region are read.
+*
+* 		For 3D domain objects only the interval domains of the
+* 		planes within the region are built. With voxel value
+* 		tables only the grey values of these planes are read,
+* 		the domains and value tables of all other planes are
+* 		skipped. With tiled values, or without values, the
+* 		domains of all other planes are seeked past if the file
+* 		has a plane index (see WlzWriteObjIndexed()) and the
+* 		tiles are memory mapped, so only the tiles which are
+* 		accessed within the region are read. Empty objects and
+* 		2D domain objects are read in full and then clipped.
+* 		All other objects (eg contours, polygons, models and
+* 		compound objects) can not be clipped by
+* 		WlzClipObjToBox3D(), so for these the object is read
+* 		and freed and an error is returned, as is also the
+* 		case for 3D domain objects without an interval plane
+* 		domain.
+* \param	fP			Input file.
+* \param	box			Region to be read.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzReadObjRegion(FILE *fP, WlzIBox3 box, WlzErrorNum *dstErr)
+{
+  WlzObjectType	type;
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzObject	*obj = NULL,
+  		*rObj = NULL;
+  size_t	*nV = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dom.core = NULL;
+  val.core = NULL;
+  type = WlzReadObjType(fP, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(type == (WlzObjectType )EOF)
+    {
+      errNum = WLZ_ERR_READ_EOF;
+    }
+    else if(type == WLZ_3D_DOMAINOBJ)
+    {
+      if((dom.p = WlzReadPlaneDomain(fP, &box, NULL, &nV,
+                                     &errNum)) != NULL)
+      {
+	if((obj = WlzMakeMain(type, dom, val, NULL, NULL, &errNum)) == NULL)
+	{
+	  (void )WlzFreePlaneDomain(dom.p);
+	}
+	else if((errNum = WlzReadDomObjValues3D(fP, obj, NULL, &box, 0,
+	                                        nV)) == WLZ_ERR_NONE)
+	{
+	  obj->plist = WlzAssignPropertyList(WlzReadPropertyList(fP, NULL),
+					     NULL);
+	}
+      }
+      AlcFree(nV);
+    }
+    else
+    {
+      (void )ungetc(type, fP);
+      obj = WlzReadObj(fP, &errNum);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    obj = WlzAssignObject(obj, NULL);
+    if((obj->type == WLZ_3D_DOMAINOBJ) && (obj->values.core != NULL) &&
+       WlzGreyTableIsTiled(obj->values.core->type))
+    {
+      WlzObject	*dObj,
+      		*cObj = NULL;
+
+      /* Tiled values are shared by the clipped domain. */
+      if((dObj = WlzMakeMain(WLZ_3D_DOMAINOBJ, obj->domain, val,
+                             NULL, NULL, &errNum)) != NULL)
+      {
+        cObj = WlzAssignObject(WlzClipObjToBox3D(dObj, box, &errNum), NULL);
+	(void )WlzFreeObj(dObj);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	if(cObj->type == WLZ_3D_DOMAINOBJ)
+	{
+	  rObj = WlzMakeMain(WLZ_3D_DOMAINOBJ, cObj->domain, obj->values,
+			     NULL, NULL, &errNum);
+	}
+	else
+	{
+	  rObj = WlzMakeEmpty(&errNum);
+	}
+      }
+      (void )WlzFreeObj(cObj);
+    }
+    else
+    {
+      rObj = WlzClipObjToBox3D(obj, box, &errNum);
+    }
+    if((errNum == WLZ_ERR_NONE) && (rObj->type == WLZ_3D_DOMAINOBJ) &&
+       (rObj->plist == NULL))
+    {
+      rObj->plist = WlzAssignPropertyList(obj->plist, NULL);
+    }
+  }
+  (void )WlzFreeObj(obj);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
+
+/*!
+* \return	New Woolz object or NULL on error.
+* \ingroup	WlzIO
+* \brief	Reads a woolz object from the given input stream, optionally
+* 		memory mapping values (see WlzReadObjMapped()).
+* \param	fp			Input file.
+* \param	map			Destination pointer for a file mapping
+* 					if values are to be mapped, NULL
+* 					if values are not to be mapped.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzReadObjMap(FILE *fp, WlzReadMap **map,
+				WlzErrorNum *dstErr)
+{
+  int			idx = 0;
   WlzObjectType		type;
   WlzObject 		*obj;
   WlzDomain		domain;
@@ -448,7 +708,7 @@ WlzObject 	*WlzReadObj(FILE *fp, WlzErrorNum *dstErr)
 	   ((obj = WlzMakeMain(type, domain, values, NULL, NULL,
 			       &errNum)) != NULL))
 	{
-	  if((errNum = WlzReadDomObjValues2D(fp, obj)) == WLZ_ERR_NONE)
+	  if((errNum = WlzReadDomObjValues2D(fp, obj, map)) == WLZ_ERR_NONE)
 	  {
 	    obj->plist = WlzAssignPropertyList(WlzReadPropertyList(fp, NULL),
 					       NULL);
@@ -459,11 +719,13 @@ WlzObject 	*WlzReadObj(FILE *fp, WlzErrorNum *dstErr)
 	break;
 
       case WLZ_3D_DOMAINOBJ:
-	if(((domain.p = WlzReadPlaneDomain(fp, &errNum)) != NULL) &&
+	if(((domain.p = WlzReadPlaneDomain(fp, NULL, &idx, NULL,
+					   &errNum)) != NULL) &&
 	   ((obj = WlzMakeMain(type, domain, values, NULL, NULL,
 			       &errNum)) != NULL ))
 	{
-	  if((errNum = WlzReadDomObjValues3D(fp, obj)) == WLZ_ERR_NONE)
+	  if((errNum = WlzReadDomObjValues3D(fp, obj, map,
+	                                     NULL, idx, NULL)) == WLZ_ERR_NONE)
 	  {
 	    obj->plist = WlzAssignPropertyList(WlzReadPropertyList(fp, NULL),
 					       NULL);
@@ -475,7 +737,7 @@ WlzObject 	*WlzReadObj(FILE *fp, WlzErrorNum *dstErr)
 
       case WLZ_TRANS_OBJ:
 	if((domain.t = WlzReadAffineTransform(fp, &errNum)) != NULL){
-	  if((values.obj = WlzReadObj(fp, &errNum)) != NULL){
+	  if((values.obj = WlzReadObjMap(fp, map, &errNum)) != NULL){
 	    if((obj = WlzMakeMain(WLZ_TRANS_OBJ, domain, values,
 				  NULL, NULL, &errNum)) != NULL){
 	      obj->plist = WlzAssignPropertyList(WlzReadPropertyList(fp, NULL),
@@ -612,7 +874,7 @@ WlzObject 	*WlzReadObj(FILE *fp, WlzErrorNum *dstErr)
 
       case WLZ_COMPOUND_ARR_1:
       case WLZ_COMPOUND_ARR_2:
-	obj = (WlzObject *) WlzReadCompoundA(fp, type, &errNum);
+	obj = (WlzObject *) WlzReadCompoundA(fp, type, map, &errNum);
 	break;
 
       case WLZ_PROPERTY_OBJ:
@@ -670,20 +932,26 @@ static WlzErrorNum WlzReadInt(FILE *fP, int *iP, size_t nI)
   {
     errNum = WLZ_ERR_READ_INCOMPLETE;
   }
+#if defined (__sparc) || defined (__mips) || defined (__ppc)
   else
   {
-    int		i;
+    size_t	i;
+    unsigned int *uP;
 
+    /* Swap the whole buffer in a single tight loop of shifts and masks
+     * which the compiler can vectorise (or map to byte swap
+     * instructions). */
+    uP = (unsigned int *)iP;
     for(i = 0; i < nI; ++i)
     {
-      WlzGreyV	in,
-		out;
+      unsigned int u;
 
-      in.inv = iP[i];
-      WLZ_SWAP_IN_WORD(out, in);
-      iP[i] = out.inv;
+      u = uP[i];
+      uP[i] = ((u >> 24) & 0x000000ff) | ((u >>  8) & 0x0000ff00) |
+              ((u <<  8) & 0x00ff0000) | ((u << 24) & 0xff000000);
     }
   }
+#endif /* __sparc || __mips || __ppc */
   return(errNum);
 }
 
@@ -1187,7 +1455,9 @@ static WlzIntervalDomain *WlzReadIntervalDomain(FILE *fP,
 						WlzErrorNum *dstErr)
 {
   WlzObjectType		type;
-  int			i, l, l1, ll, k1, kl, nints;
+  int			l, l1, ll, k1, kl, nints;
+  int			bnd[4];
+  int			*nBuf = NULL;
   WlzIntervalDomain	*idmn=NULL;
   WlzIntervalLine 	*ivln;
   WlzInterval 		*itvl0,
@@ -1210,16 +1480,16 @@ type = (WlzObjectType) getc(fP);
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    l1 = getword(fP);
-    ll = getword(fP);
-    k1 = getword(fP);
-    kl = getword(fP);
-    if( feof(fP) != 0 )
+    if(WlzReadInt(fP, bnd, 4) != WLZ_ERR_NONE)
     {
       errNum = WLZ_ERR_READ_INCOMPLETE;
     }
     else
     {
+      l1 = bnd[0];
+      ll = bnd[1];
+      k1 = bnd[2];
+      kl = bnd[3];
       idmn = WlzMakeIntervalDomain(type, l1, ll, k1, kl, &errNum);
     }
   }
@@ -1228,19 +1498,28 @@ type = (WlzObjectType) getc(fP);
     switch (type) {
 
     case WLZ_INTERVALDOMAIN_INTVL:
-      nints = 0;
-      ivln = idmn->intvlines;
-      for (l=l1; l<=ll; l++) {
-	ivln->nintvs = getword(fP);
-	nints += ivln->nintvs;
-	ivln++;
+      /* Read the whole table of interval counts and then the whole table
+       * of interval end points in two block reads, rather than a word
+       * at a time. */
+      if((nBuf = (int *)AlcMalloc((ll - l1 + 1) * sizeof(int))) == NULL){
+	WlzFreeIntervalDomain(idmn);
+	idmn = NULL;
+	errNum = WLZ_ERR_MEM_ALLOC;
+	break;
       }
-      if( feof(fP) != 0 ){
+      if(WlzReadInt(fP, nBuf, ll - l1 + 1) != WLZ_ERR_NONE){
 	WlzFreeIntervalDomain(idmn);
 	idmn = NULL;
 	errNum = WLZ_ERR_READ_INCOMPLETE;
 	break;
       }
+      nints = 0;
+      ivln = idmn->intvlines;
+      for (l=l1; l<=ll; l++) {
+	ivln->nintvs = nBuf[l - l1];
+	nints += ivln->nintvs;
+	ivln++;
+      }
 
       if( nints == 0 ){
 	/* curious case of a no-intervals domain */
@@ -1260,14 +1539,9 @@ type = (WlzObjectType) getc(fP);
       ivln = idmn->intvlines;
       idmn->freeptr = AlcFreeStackPush(idmn->freeptr, (void *)itvl0, NULL);
 
-      for (i=0; i<nints; i++,itvl++) {
-	itvl->ileft = getword(fP);
-	itvl->iright = getword(fP);
-      }
-
-      itvl = itvl0;
-
-      if (feof(fP) != 0){
+      /* An interval is a pair of ints (ileft, iright) which matches the
+       * file layout, so the intervals are read directly into place. */
+      if(WlzReadInt(fP, (int *)itvl0, 2 * (size_t )nints) != WLZ_ERR_NONE){
 	WlzFreeIntervalDomain(idmn);
 	idmn = NULL;
 	errNum = WLZ_ERR_READ_INCOMPLETE;
@@ -1292,6 +1566,7 @@ type = (WlzObjectType) getc(fP);
       break;
     }
   }
+  AlcFree(nBuf);
 
   if( dstErr ){
     *dstErr = errNum;
@@ -1299,23 +1574,141 @@ type = (WlzObjectType) getc(fP);
   return(idmn);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Skips over an interval domain in the input file without
+* 		building it, counting the values that a grey value table
+* 		with the domain would have (see WlzReadGreyValuesCount()).
+* 		This allows the value tables of planes which are not
+* 		wanted to be skipped.
+* \param	fP			Input file.
+* \param	dstNV			Destination pointer for the number
+* 					of values, set to zero for a NULL
+* 					domain.
+*/
+static WlzErrorNum WlzReadIntervalDomainSkip(FILE *fP, size_t *dstNV)
+{
+  int		l,
+  		type,
+		nLn,
+		nItv = 0;
+  int		bnd[4];
+  int		*nBuf = NULL,
+  		*iBuf = NULL;
+  size_t	nV = 0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((type = getc(fP)) == EOF)
+  {
+    errNum = WLZ_ERR_READ_INCOMPLETE;
+  }
+  else if(type != WLZ_NULL)
+  {
+    if(WlzReadInt(fP, bnd, 4) != WLZ_ERR_NONE)
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+    else if((bnd[1] < bnd[0]) || (bnd[3] < bnd[2]))
+    {
+      errNum = WLZ_ERR_DOMAIN_DATA;
+    }
+    else
+    {
+      nLn = bnd[1] - bnd[0] + 1;
+      switch(type)
+      {
+	case WLZ_INTERVALDOMAIN_INTVL:
+	  if((nBuf = (int *)AlcMalloc(nLn * sizeof(int))) == NULL)
+	  {
+	    errNum = WLZ_ERR_MEM_ALLOC;
+	  }
+	  else if(WlzReadInt(fP, nBuf, nLn) != WLZ_ERR_NONE)
+	  {
+	    errNum = WLZ_ERR_READ_INCOMPLETE;
+	  }
+	  else
+	  {
+	    for(l = 0; l < nLn; ++l)
+	    {
+	      if(nBuf[l] < 0)
+	      {
+		errNum = WLZ_ERR_DOMAIN_DATA;
+		break;
+	      }
+	      nItv += nBuf[l];
+	    }
+	  }
+	  if((errNum == WLZ_ERR_NONE) && (nItv > 0))
+	  {
+	    if((iBuf = (int *)AlcMalloc(2 * nItv * sizeof(int))) == NULL)
+	    {
+	      errNum = WLZ_ERR_MEM_ALLOC;
+	    }
+	    else if(WlzReadInt(fP, iBuf, 2 * (size_t )nItv) != WLZ_ERR_NONE)
+	    {
+	      errNum = WLZ_ERR_READ_INCOMPLETE;
+	    }
+	    else
+	    {
+	      for(l = 0; l < nItv; ++l)
+	      {
+		nV += iBuf[2 * l + 1] - iBuf[2 * l] + 1;
+	      }
+	    }
+	  }
+	  break;
+	case WLZ_INTERVALDOMAIN_RECT:
+	  nV = (size_t )(bnd[3] - bnd[2] + 1) * (size_t )nLn;
+	  break;
+	default:
+	  errNum = WLZ_ERR_DOMAIN_TYPE;
+	  break;
+      }
+    }
+  }
+  AlcFree(nBuf);
+  AlcFree(iBuf);
+  *dstNV = nV;
+  return(errNum);
+}
+
 /*!
 * \return	New plane domain.
 * \ingroup	WlzIO
 * \brief	Reads a Woolz plane domain from the given file.
+* 		If a region is given then only the interval domains of
+* 		planes within the region are read, see
+* 		WlzReadPlaneDomainRegion().
 * \param	fp			Given file.
+* \param	box			Region to be read, NULL for all
+* 					planes.
+* \param	dstIdx			Destination pointer, set non-zero if
+* 					the plane domain has a valid plane
+* 					index, may be NULL.
+* \param	dstNV			Destination pointer for the number of
+* 					values of the planes outside of the
+* 					region, only used if a region is
+* 					given, may be NULL.
 * \param	dstErr			Destination error pointer, may be NULL.
 */
 static WlzPlaneDomain *WlzReadPlaneDomain(FILE *fp,
+					  WlzIBox3 *box,
+					  int *dstIdx,
+					  size_t **dstNV,
 					  WlzErrorNum *dstErr)
 {
   WlzObjectType		type;
   WlzDomain		domain, *domains = NULL;
   WlzPlaneDomain	*planedm=NULL;
   int			i, nplanes = 0;
+  int			*pIdx = NULL;
   int			p1, pl, l1, ll, k1, kl;
   WlzErrorNum		errNum=WLZ_ERR_NONE;
 
+  if(dstIdx){
+    *dstIdx = 0;
+  }
   type = (WlzObjectType) getc(fp);
 
 
@@ -1355,18 +1748,34 @@ static WlzPlaneDomain *WlzReadPlaneDomain(FILE *fp,
       (planedm->voxel_size)[2] = getfloat(fp);
       nplanes = pl - p1 + 1;
 
-      /* object format includes redundant plane positions -
-	 read and discard */
-      for(i=0; i < nplanes; i++)
+      /* object format includes redundant plane positions - these
+	 are either unused or a plane index (see WlzWriteObjIndexed()) */
+      if((pIdx = (int *)AlcMalloc(nplanes * sizeof(int))) == NULL)
       {
-	(void) getfloat(fp);
+	WlzFreePlaneDomain(planedm);
+	planedm = NULL;
+	errNum = WLZ_ERR_MEM_ALLOC;
       }
-      if(feof(fp) != 0)
+      else if((WlzReadInt(fp, pIdx, nplanes) != WLZ_ERR_NONE) ||
+              (feof(fp) != 0))
       {
 	WlzFreePlaneDomain(planedm);
 	planedm = NULL;
 	errNum = WLZ_ERR_READ_INCOMPLETE;
       }
+      else
+      {
+	/* plane index sizes are written negated, anything else (eg the
+	   dummy plane positions of older files) is not an index */
+	for(i = 0; i < nplanes; i++)
+	{
+	  pIdx[i] = (pIdx[i] < 0)? -pIdx[i]: 0;
+	}
+	if(dstIdx && (type == WLZ_PLANEDOMAIN_DOMAIN))
+	{
+	  *dstIdx = WlzReadPlaneIdxValid(pIdx, nplanes);
+	}
+      }
     }
   }
 
@@ -1374,6 +1783,13 @@ static WlzPlaneDomain *WlzReadPlaneDomain(FILE *fp,
     switch (type) {
 
     case WLZ_PLANEDOMAIN_DOMAIN:
+      if(box != NULL){
+	errNum = WlzReadPlaneDomainRegion(fp, planedm, pIdx, box, dstNV);
+	break;
+      }
+      else if(WlzReadPlaneDomainIdx(fp, planedm, pIdx)){
+        break;
+      }
       for(i=0; i < nplanes; i++, domains++){
 	if((domain.i = WlzReadIntervalDomain(fp, &errNum)) != NULL){
 	  *domains = WlzAssignDomain(domain, NULL);
@@ -1452,6 +1868,7 @@ static WlzPlaneDomain *WlzReadPlaneDomain(FILE *fp,
     }
   }
 
+  AlcFree(pIdx);
   if( dstErr ){
     *dstErr = errNum;
   }
@@ -1466,9 +1883,11 @@ static WlzPlaneDomain *WlzReadPlaneDomain(FILE *fp,
 * \param	type			Type encoding grey and table type.
 * \param	obj			Object defining the domain of the
 *					grey values.
+* \param	map			File mapping for mapped values, may
+*					be NULL if values are not mapped.
 */
 static WlzErrorNum WlzReadGreyValues(FILE *fp, WlzObjectType type,
-				     WlzObject *obj)
+				     WlzObject *obj, WlzReadMap **map)
 {
   WlzGreyType		gtype;
   WlzIntervalWSpace 	iwsp;
@@ -1520,6 +1939,14 @@ static WlzErrorNum WlzReadGreyValues(FILE *fp, WlzObjectType type,
   if( errNum != WLZ_ERR_NONE ){
     return errNum;
   }
+  if( map != NULL ){
+    int		mapped = 0;
+
+    errNum = WlzReadGreyValuesMapped(fp, type, obj, map, &mapped);
+    if( (errNum != WLZ_ERR_NONE) || mapped ){
+      return errNum;
+    }
+  }
 
   l1 = obj->domain.i->line1;
   ll = obj->domain.i->lastln;
@@ -2045,50 +2472,832 @@ static WlzErrorNum WlzReadRectVtb(FILE 		*fp,
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzIO
-* \brief	Reads a Woolz 2D value table for a 2D domain object.
-* 		This function reads the grey value table type and then
-* 		calls the appropriate function to complete the read.
+* \brief	Attempts to read a rectangular or ragged rectangle grey value
+* 		table by memory mapping its values from the file. The grey
+* 		table type has already been read and established (by
+* 		WlzReadGreyValues()). If the values can not be mapped then
+* 		the file position is restored and the destination mapped
+* 		flag is cleared so that the values can be read in the
+* 		usual way.
 * \param	fP			Input file.
+* \param	tType			Grey table type.
 * \param	obj			Object defining the domain of the
-*					grey values. The domain is known to
-*					be non NULL.
+*					grey values.
+* \param	map			File mapping.
+* \param	dstMapped		Destination pointer for a flag which
+* 					is set non-zero if the values were
+* 					mapped.
 */
-static WlzErrorNum WlzReadDomObjValues2D(FILE *fP, WlzObject *obj)
+static WlzErrorNum WlzReadGreyValuesMapped(FILE *fP, WlzObjectType tType,
+					   WlzObject *obj, WlzReadMap **map,
+					   int *dstMapped)
 {
-  WlzObjectType	type;
+  int		mapped = 0;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
-
-  type = (WlzObjectType )getc(fP);
-  if(type == (WlzObjectType )EOF)
-  {
-    errNum = WLZ_ERR_READ_INCOMPLETE;
-  }
-  else if(type == WLZ_NULL)
+#ifdef WLZ_USE_MMAP
+  int		native = 0;
+  long		pos = -1;
+  WlzGreyType	gType;
+  WlzObjectType	tbType;
+  WlzIntervalDomain *iDom;
+
+  iDom = obj->domain.i;
+  gType = WlzGreyTableTypeToGreyType(tType, NULL);
+  tbType = WlzGreyTableTypeToTableType(tType, NULL);
+  /* Values can only be mapped if they are stored in the file with the
+   * native byte order. */
+  switch(gType)
   {
-    obj->values.core = NULL;
+    case WLZ_GREY_UBYTE:
+      native = 1;
+      break;
+#if defined (__x86) || defined (__alpha)
+    case WLZ_GREY_SHORT:  /* FALLTHROUGH */
+    case WLZ_GREY_INT:    /* FALLTHROUGH */
+    case WLZ_GREY_DOUBLE: /* FALLTHROUGH */
+    case WLZ_GREY_RGBA:
+      native = 1;
+      break;
+#endif /* __x86 || __alpha */
+    default:
+      break;
   }
-  else
+  /* Ragged rectangle values are only contiguous in the file with the
+   * same layout as in memory if no line has more than one interval. */
+  if(native && (tbType == WLZ_GREY_TAB_RAGR))
   {
-    switch(type)
+    int		l,
+    		nLn;
+
+    nLn = iDom->lastln - iDom->line1 + 1;
+    for(l = 0; l < nLn; ++l)
     {
-      case WLZ_VALUETABLE_TILED_INT:    /* FALLTHROUGH */
-      case WLZ_VALUETABLE_TILED_SHORT:  /* FALLTHROUGH */
-      case WLZ_VALUETABLE_TILED_UBYTE:  /* FALLTHROUGH */
-      case WLZ_VALUETABLE_TILED_FLOAT:  /* FALLTHROUGH */
-      case WLZ_VALUETABLE_TILED_DOUBLE: /* FALLTHROUGH */
-      case WLZ_VALUETABLE_TILED_RGBA:
-	errNum = WlzReadTiledValues(fP, obj, 2, type, 1);
-	break;
-      default:
-        errNum = WlzReadGreyValues(fP, type, obj);
+      if(iDom->intvlines[l].nintvs > 1)
+      {
+        native = 0;
 	break;
+      }
     }
   }
-  return(errNum);
-}
+  if(native &&
+     ((pos = ftell(fP)) >= 0) &&
+     (WlzReadMapGet(fP, map) != NULL) && ((*map)->base != NULL))
+  {
+    long	off;
+    size_t	gSz,
+    		nV = 0;
+    WlzGreyType	packing;
+    WlzPixelV	bgd;
 
-/*!
-* \return	Woolz error code.
+    packing = (WlzGreyType )getc(fP);
+    bgd.type = gType;
+    switch(gType)
+    {
+      case WLZ_GREY_INT:
+	bgd.v.inv = getword(fP);
+	break;
+      case WLZ_GREY_SHORT:
+	bgd.v.shv = (short )getword(fP);
+	break;
+      case WLZ_GREY_UBYTE:
+	bgd.v.ubv = (WlzUByte )getword(fP);
+	break;
+      case WLZ_GREY_DOUBLE:
+	bgd.v.dbv = getdouble(fP);
+	break;
+      case WLZ_GREY_RGBA:
+	bgd.v.rgbv = (WlzUInt )getword(fP);
+	break;
+      default:
+	break;
+    }
+    gSz = WlzGreySize(gType);
+    if(tbType == WLZ_GREY_TAB_RECT)
+    {
+      nV = (size_t )(iDom->lastkl - iDom->kol1 + 1) *
+	   (size_t )(iDom->lastln - iDom->line1 + 1);
+    }
+    else
+    {
+      int	l,
+      		nLn;
+
+      nLn = iDom->lastln - iDom->line1 + 1;
+      for(l = 0; l < nLn; ++l)
+      {
+        if(iDom->intvlines[l].nintvs > 0)
+	{
+	  nV += iDom->intvlines[l].intvs[0].iright -
+	        iDom->intvlines[l].intvs[0].ileft + 1;
+	}
+      }
+    }
+    off = ftell(fP);
+    if((packing == gType) && (feof(fP) == 0) && (off >= 0) &&
+       ((off % gSz) == 0) && ((size_t )off + (nV * gSz) <= (*map)->len))
+    {
+      WlzValues	values;
+      WlzGreyP	gP;
+
+      values.core = NULL;
+      gP.ubp = (WlzUByte *)((*map)->base) + off;
+      if(tbType == WLZ_GREY_TAB_RECT)
+      {
+	values.r = WlzMakeRectValueTb(tType, iDom->line1, iDom->lastln,
+				      iDom->kol1,
+				      iDom->lastkl - iDom->kol1 + 1,
+				      bgd, gP.inp, &errNum);
+      }
+      else
+      {
+        values.v = WlzMakeValueTb(tType, iDom->line1, iDom->lastln,
+				  iDom->kol1, bgd, obj, &errNum);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  int	l;
+
+	  values.v->width = iDom->lastkl - iDom->kol1 + 1;
+	  for(l = iDom->line1; l <= iDom->lastln; ++l)
+	  {
+	    WlzIntervalLine *itvLn;
+
+	    itvLn = iDom->intvlines + l - iDom->line1;
+	    if(itvLn->nintvs > 0)
+	    {
+	      int	k0,
+	      		k1;
+
+	      k0 = iDom->kol1 + itvLn->intvs[0].ileft;
+	      k1 = iDom->kol1 + itvLn->intvs[0].iright;
+	      (void )WlzMakeValueLine(values.v, l, k0, k1, gP.inp);
+	      gP.ubp += (k1 - k0 + 1) * gSz;
+	    }
+	  }
+	}
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	/* The value table holds a link to the mapping which is released
+	 * when the value table's free stack is freed. */
+	values.v->freeptr = AlcFreeStackPushFn(values.v->freeptr, *map,
+					       WlzReadMapUnlink, NULL);
+	if(values.v->freeptr == NULL)
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+	else
+	{
+	  ++((*map)->linkcount);
+	}
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+        obj->values = WlzAssignValues(values, NULL);
+	if(fseek(fP, off + (long )(nV * gSz), SEEK_SET) != 0)
+	{
+	  errNum = WLZ_ERR_READ_INCOMPLETE;
+	}
+	mapped = 1;
+      }
+      else if(values.core != NULL)
+      {
+        (void )WlzFreeValues(values);
+      }
+    }
+    else if(fseek(fP, pos, SEEK_SET) != 0)
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+  }
+#endif /* WLZ_USE_MMAP */
+  *dstMapped = mapped;
+  return(errNum);
+}
+
+/*!
+* \return	The file mapping or NULL if the file can not be mapped.
+* \ingroup	WlzIO
+* \brief	Gets the mapping of the given file, creating it on the
+* 		first call. If the file can not be mapped then a mapping
+* 		with a NULL base address is created so that further
+* 		attempts to map the file are avoided.
+* \param	fP			Input file.
+* \param	map			File mapping pointer.
+*/
+static WlzReadMap *WlzReadMapGet(FILE *fP, WlzReadMap **map)
+{
+#ifdef WLZ_USE_MMAP
+  if((*map == NULL) &&
+     ((*map = (WlzReadMap *)AlcCalloc(1, sizeof(WlzReadMap))) != NULL))
+  {
+    int		fd;
+    struct stat	sBuf;
+
+    (*map)->linkcount = 1;
+    fd = fileno(fP);
+    if((fd >= 0) && (fstat(fd, &sBuf) == 0) && S_ISREG(sBuf.st_mode) &&
+       (sBuf.st_size > 0))
+    {
+      void	*base;
+
+      base = mmap(NULL, sBuf.st_size, PROT_READ | PROT_WRITE,
+		  MAP_PRIVATE | MAP_FILE | MAP_NORESERVE, fd, 0);
+      if(base != MAP_FAILED)
+      {
+        (*map)->base = base;
+	(*map)->len = sBuf.st_size;
+      }
+    }
+  }
+#endif /* WLZ_USE_MMAP */
+  return(*map);
+}
+
+/*!
+* \ingroup	WlzIO
+* \brief	Removes a link to the given file mapping, unmapping the
+* 		file and freeing the mapping when there are no more links.
+* 		The signature of this function allows it to be used by
+* 		AlcFreeStackPushFn().
+* \param	data			File mapping.
+*/
+static void	WlzReadMapUnlink(void *data)
+{
+  WlzReadMap	*map;
+
+  if(((map = (WlzReadMap *)data) != NULL) && (--(map->linkcount) <= 0))
+  {
+#ifdef WLZ_USE_MMAP
+    if(map->base != NULL)
+    {
+      (void )munmap(map->base, map->len);
+    }
+#endif /* WLZ_USE_MMAP */
+    AlcFree(map);
+  }
+}
+
+/*!
+* \return	Non-zero if the plane index appears valid.
+* \ingroup	WlzIO
+* \brief	Checks that a plane index read from the plane position
+* 		slots of a plane domain is plausible. Each interval domain
+* 		is written as either a single (WLZ_NULL) byte or as a type
+* 		byte followed by it's four bounds, so a valid index has no
+* 		entries of zero (not an index) or between 2 and 16.
+* \param	pIdx			Plane index.
+* \param	nPln			Number of planes.
+*/
+static int	WlzReadPlaneIdxValid(int *pIdx, int nPln)
+{
+  int		p;
+
+  for(p = 0; p < nPln; ++p)
+  {
+    if((pIdx[p] != 1) && (pIdx[p] < 17))
+    {
+      break;
+    }
+  }
+  return((nPln > 0) && (p == nPln));
+}
+
+/*!
+* \return	Number of bytes used to store the grey value table in a
+* 		file or zero if this can not be determined.
+* \ingroup	WlzIO
+* \brief	Computes the number of bytes used to store a 2D grey
+* 		value table including it's grey type and packing bytes,
+* 		background and values. This allows value tables to be
+* 		located without reading them.
+* \param	gType			Grey type read from the file.
+* \param	pType			Packing type read from the file.
+* \param	nV			Number of values in the value table
+* 					(see WlzReadGreyValuesCount()).
+*/
+static size_t	WlzReadGreyValuesFileSz(WlzGreyType gType,
+				        WlzGreyType pType,
+				        size_t nV)
+{
+  size_t	sz = 0,
+		vSz = 0,
+		bSz = 4;
+
+  switch(gType)
+  {
+    case WLZ_GREY_INT:
+      if((pType == WLZ_GREY_INT) || (pType == WLZ_GREY_SHORT) ||
+	 (pType == WLZ_GREY_UBYTE))
+      {
+	vSz = WlzGreySize(pType);
+      }
+      break;
+    case WLZ_GREY_SHORT:
+      if((pType == WLZ_GREY_SHORT) || (pType == WLZ_GREY_UBYTE))
+      {
+	vSz = WlzGreySize(pType);
+      }
+      break;
+    case WLZ_GREY_UBYTE:
+      vSz = 1;
+      break;
+    case WLZ_GREY_FLOAT: /* FALLTHROUGH */
+    case WLZ_GREY_RGBA:
+      vSz = 4;
+      break;
+    case WLZ_GREY_DOUBLE:
+      vSz = 8;
+      bSz = 8;
+      break;
+    default:
+      break;
+  }
+  if((vSz > 0) && (nV > 0))
+  {
+    sz = 2 + bSz + (nV * vSz);
+  }
+  return(sz);
+}
+
+/*!
+* \return	Number of values covered by the interval domain or zero
+* 		if the domain is NULL or of an unknown type.
+* \ingroup	WlzIO
+* \brief	Counts the values of a 2D grey value table with the given
+* 		interval domain.
+* \param	iDom			Interval domain of the value table.
+*/
+static size_t	WlzReadGreyValuesCount(WlzIntervalDomain *iDom)
+{
+  size_t	nV = 0;
+
+  if(iDom != NULL)
+  {
+    switch(iDom->type)
+    {
+      case WLZ_INTERVALDOMAIN_RECT:
+	nV = (size_t )(iDom->lastkl - iDom->kol1 + 1) *
+	     (size_t )(iDom->lastln - iDom->line1 + 1);
+	break;
+      case WLZ_INTERVALDOMAIN_INTVL:
+	{
+	  int	l,
+		i,
+		nLn;
+
+	  nLn = iDom->lastln - iDom->line1 + 1;
+	  for(l = 0; l < nLn; ++l)
+	  {
+	    WlzIntervalLine *itvLn;
+
+	    itvLn = iDom->intvlines + l;
+	    for(i = 0; i < itvLn->nintvs; ++i)
+	    {
+	      nV += itvLn->intvs[i].iright - itvLn->intvs[i].ileft + 1;
+	    }
+	  }
+	}
+	break;
+      default:
+        break;
+    }
+  }
+  return(nV);
+}
+
+/*!
+* \return	Non-zero if the domains were read using the plane index.
+* \ingroup	WlzIO
+* \brief	Reads the interval domains of an interval plane domain
+* 		concurrently using a plane index (see WlzWriteObjIndexed()).
+* 		The plane index gives the number of bytes used to store
+* 		each of the plane's interval domains, from which the
+* 		offset of each plane's domain is known. The file is memory
+* 		mapped and each plane's domain is read from the mapped file
+* 		in parallel. If there is no valid plane index or if the
+* 		file can not be mapped, zero is returned with the file
+* 		position unchanged so that the domains may be read
+* 		sequentially. An index which is found to be invalid while
+* 		reading the domains is also handled in this way.
+* \param	fP			Input file positioned at the first
+* 					plane's interval domain.
+* \param	pDom			Plane domain with the plane bounds
+* 					set.
+* \param	pIdx			Plane index as read from the file.
+*/
+static int	WlzReadPlaneDomainIdx(FILE *fP, WlzPlaneDomain *pDom,
+				      int *pIdx)
+{
+  int		done = 0;
+#ifdef WLZ_USE_PLANE_INDEX
+  int		p,
+  		nPln,
+		nBad = 0;
+  long		pos;
+  size_t	*off = NULL;
+  WlzReadMap	*map = NULL;
+
+  nPln = pDom->lastpl - pDom->plane1 + 1;
+  if((nPln > 1) && WlzReadPlaneIdxValid(pIdx, nPln) &&
+     ((pos = ftell(fP)) >= 0) &&
+     ((off = (size_t *)AlcMalloc((nPln + 1) * sizeof(size_t))) != NULL))
+  {
+    off[0] = pos;
+    for(p = 0; p < nPln; ++p)
+    {
+      off[p + 1] = off[p] + pIdx[p];
+    }
+    if((WlzReadMapGet(fP, &map) != NULL) && (map->base != NULL) &&
+       (off[nPln] <= map->len))
+    {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(+:nBad)
+#endif
+      for(p = 0; p < nPln; ++p)
+      {
+	FILE		*mFP;
+	WlzDomain	dom;
+	WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+
+	dom.core = NULL;
+	if((mFP = fmemopen((WlzUByte *)(map->base) + off[p],
+			   pIdx[p], "rb")) == NULL)
+	{
+	  errNum2 = WLZ_ERR_READ_INCOMPLETE;
+	}
+	else
+	{
+	  dom.i = WlzReadIntervalDomain(mFP, &errNum2);
+	  if(errNum2 == WLZ_ERR_EOO)
+	  {
+	    errNum2 = WLZ_ERR_NONE;
+	  }
+	  else if((errNum2 == WLZ_ERR_NONE) && (ftell(mFP) != pIdx[p]))
+	  {
+	    errNum2 = WLZ_ERR_READ_INCOMPLETE;
+	  }
+	  (void )fclose(mFP);
+	}
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  if(dom.core != NULL)
+	  {
+	    pDom->domains[p] = WlzAssignDomain(dom, NULL);
+	  }
+	}
+	else
+	{
+	  (void )WlzFreeIntervalDomain(dom.i);
+	  ++nBad;
+	}
+      }
+      if(nBad == 0)
+      {
+        done = (fseek(fP, off[nPln], SEEK_SET) == 0);
+      }
+      if(!done)
+      {
+	/* Index is not valid so free any domains read and restore the
+	 * file position for a sequential read. */
+        for(p = 0; p < nPln; ++p)
+	{
+	  (void )WlzFreeDomain(pDom->domains[p]);
+	  pDom->domains[p].core = NULL;
+	}
+	(void )fseek(fP, pos, SEEK_SET);
+      }
+    }
+  }
+  AlcFree(off);
+  if(map != NULL)
+  {
+    WlzReadMapUnlink(map);
+  }
+#endif /* WLZ_USE_PLANE_INDEX */
+  return(done);
+}
+
+/*!
+* \return	Non-zero if the values were read using a plane index.
+* \ingroup	WlzIO
+* \brief	Reads the grey values of the planes of a voxel value
+* 		table concurrently. The offset of each plane's values in
+* 		the file is found by scanning the plane's value table
+* 		header and computing the number of bytes used to store
+* 		its values from the plane's domain. Each plane's values are
+* 		then read in parallel from the memory mapped file. If this
+* 		is not possible zero is returned with the file position
+* 		unchanged so that the values may be read sequentially.
+* \param	fP			Input file positioned at the first
+* 					plane's value table.
+* \param	obj			Object with interval plane domain.
+* \param	vox			Voxel value table with the background
+* 					value already read.
+*/
+static int	WlzReadVoxelValuesIdx(FILE *fP, WlzObject *obj,
+				      WlzVoxelValues *vox)
+{
+  int		done = 0;
+#ifdef WLZ_USE_PLANE_INDEX
+  int		p,
+  		nPln,
+		nBad = 0;
+  long		pos;
+  size_t	*off = NULL;
+  WlzReadMap	*map = NULL;
+  WlzPlaneDomain *pDom;
+
+  pDom = obj->domain.p;
+  nPln = pDom->lastpl - pDom->plane1 + 1;
+  if((nPln > 1) && ((pos = ftell(fP)) >= 0) &&
+     (WlzReadMapGet(fP, &map) != NULL) && (map->base != NULL) &&
+     ((off = (size_t *)AlcMalloc((nPln + 1) * sizeof(size_t))) != NULL))
+  {
+    WlzUByte	*base;
+
+    /* Scan the value table headers to find the offset of each plane's
+     * values. */
+    base = (WlzUByte *)(map->base);
+    off[0] = pos;
+    for(p = 0; p < nPln; ++p)
+    {
+      size_t	sz = 1,
+      		nV;
+
+      nV = WlzReadGreyValuesCount(pDom->domains[p].i);
+      if((off[p] + 2 > map->len) ||
+         ((base[off[p]] != WLZ_NULL) &&
+          ((sz = WlzReadGreyValuesFileSz((WlzGreyType )(base[off[p]]),
+	                                 (WlzGreyType )(base[off[p] + 1]),
+				         nV)) == 0)))
+      {
+        break;
+      }
+      off[p + 1] = off[p] + sz;
+    }
+    if((p == nPln) && (off[nPln] <= map->len))
+    {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(+:nBad)
+#endif
+      for(p = 0; p < nPln; ++p)
+      {
+	FILE		*mFP;
+	WlzObject	*tObj;
+	WlzValues	nullVal;
+	WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+
+	nullVal.core = NULL;
+	if((tObj = WlzMakeMain(WLZ_2D_DOMAINOBJ, pDom->domains[p], nullVal,
+			       NULL, NULL, &errNum2)) != NULL)
+	{
+	  if((mFP = fmemopen(base + off[p], off[p + 1] - off[p],
+			     "rb")) == NULL)
+	  {
+	    errNum2 = WLZ_ERR_READ_INCOMPLETE;
+	  }
+	  else
+	  {
+	    WlzObjectType gtt;
+
+	    gtt = (WlzObjectType )getc(mFP);
+	    errNum2 = WlzReadGreyValues(mFP, gtt, tObj, NULL);
+	    if((errNum2 == WLZ_ERR_NONE) &&
+	       (ftell(mFP) != (long )(off[p + 1] - off[p])))
+	    {
+	      errNum2 = WLZ_ERR_READ_INCOMPLETE;
+	    }
+	    (void )fclose(mFP);
+	  }
+	  if((errNum2 == WLZ_ERR_NONE) && (tObj->values.core != NULL))
+	  {
+	    vox->values[p] = WlzAssignValues(tObj->values, NULL);
+	  }
+	  (void )WlzFreeObj(tObj);
+	}
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+	  ++nBad;
+	}
+      }
+      if(nBad == 0)
+      {
+        done = (fseek(fP, off[nPln], SEEK_SET) == 0);
+      }
+      if(done)
+      {
+	/* Reset the voxel table background as for a sequential read. */
+	for(p = 0; p < nPln; ++p)
+	{
+	  if(vox->values[p].core != NULL)
+	  {
+	    switch(WlzGreyTableTypeToTableType(vox->values[p].core->type,
+	                                       NULL))
+	    {
+	      case WLZ_GREY_TAB_RAGR:
+		vox->bckgrnd = vox->values[p].v->bckgrnd;
+		break;
+	      case WLZ_GREY_TAB_RECT:
+		vox->bckgrnd = vox->values[p].r->bckgrnd;
+		break;
+	      case WLZ_GREY_TAB_INTL:
+		vox->bckgrnd = vox->values[p].i->bckgrnd;
+		break;
+	      default:
+		break;
+	    }
+	  }
+	}
+      }
+      else
+      {
+	/* Free any values read and restore the file position for a
+	 * sequential read. */
+        for(p = 0; p < nPln; ++p)
+	{
+	  (void )WlzFreeValues(vox->values[p]);
+	  vox->values[p].core = NULL;
+	}
+	(void )fseek(fP, pos, SEEK_SET);
+      }
+    }
+  }
+  AlcFree(off);
+  if(map != NULL)
+  {
+    WlzReadMapUnlink(map);
+  }
+#endif /* WLZ_USE_PLANE_INDEX */
+  return(done);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Reads the interval domains of only those planes of an
+* 		interval plane domain which intersect the given region,
+* 		the domains of all other planes are left NULL.
+* 		If the plane domain is followed by a voxel value table then
+* 		the domains of the other planes are skipped while counting
+* 		their values, so that their value tables can be skipped
+* 		too. Otherwise, if the file has a valid plane index (see
+* 		WlzWriteObjIndexed()), the file is seeked past the domains
+* 		of the other planes without reading them.
+* \param	fP			Input file positioned at the first
+* 					plane's interval domain.
+* \param	pDom			Plane domain with the plane bounds
+* 					set.
+* \param	pIdx			Plane index as read from the file.
+* \param	box			Region to be read.
+* \param	dstNV			Destination pointer for an array with
+* 					the number of values of each plane
+* 					outside of the region, set to NULL if
+* 					the values were not counted. The array
+* 					should be freed using AlcFree(). May
+* 					be NULL.
+*/
+static WlzErrorNum WlzReadPlaneDomainRegion(FILE *fP, WlzPlaneDomain *pDom,
+					    int *pIdx, WlzIBox3 *box,
+					    size_t **dstNV)
+{
+  int		p,
+  		p0,
+		p1,
+		nPln,
+		seek = 0;
+  long		pos,
+  		skip = 0;
+  size_t	*nV = NULL;
+  WlzDomain	dom;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nPln = pDom->lastpl - pDom->plane1 + 1;
+  p0 = WLZ_CLAMP(box->zMin - pDom->plane1, 0, nPln);
+  p1 = WLZ_CLAMP(box->zMax - pDom->plane1 + 1, p0, nPln);
+  if(WlzReadPlaneIdxValid(pIdx, nPln) && ((pos = ftell(fP)) >= 0))
+  {
+    int		vType = EOF;
+
+    /* Use the plane index to peek at the type of the value table which
+     * follows the plane domain. */
+    for(p = 0; p < nPln; ++p)
+    {
+      skip += pIdx[p];
+    }
+    if(fseek(fP, skip, SEEK_CUR) == 0)
+    {
+      vType = getc(fP);
+    }
+    if(fseek(fP, pos, SEEK_SET) != 0)
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+    seek = (vType != EOF) && (vType != WLZ_VOXELVALUETABLE_GREY);
+    skip = 0;
+  }
+  if((errNum == WLZ_ERR_NONE) && (seek == 0))
+  {
+    if((nV = (size_t *)AlcCalloc(nPln, sizeof(size_t))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  for(p = 0; (errNum == WLZ_ERR_NONE) && (p < nPln); ++p)
+  {
+    if((p >= p0) && (p < p1))
+    {
+      if((skip > 0) && (fseek(fP, skip, SEEK_CUR) != 0))
+      {
+        errNum = WLZ_ERR_READ_INCOMPLETE;
+      }
+      else
+      {
+	skip = 0;
+	if((dom.i = WlzReadIntervalDomain(fP, &errNum)) != NULL)
+	{
+	  pDom->domains[p] = WlzAssignDomain(dom, NULL);
+	}
+	else if(errNum == WLZ_ERR_EOO)
+	{
+	  errNum = WLZ_ERR_NONE;
+	}
+      }
+    }
+    else if(seek)
+    {
+      skip += pIdx[p];
+    }
+    else
+    {
+      errNum = WlzReadIntervalDomainSkip(fP, nV + p);
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (skip > 0) &&
+     (fseek(fP, skip, SEEK_CUR) != 0))
+  {
+    errNum = WLZ_ERR_READ_INCOMPLETE;
+  }
+  if(dstNV)
+  {
+    *dstNV = nV;
+  }
+  else
+  {
+    AlcFree(nV);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Reads a Woolz 2D value table for a 2D domain object.
+* 		This function reads the grey value table type and then
+* 		calls the appropriate function to complete the read.
+* \param	fP			Input file.
+* \param	obj			Object defining the domain of the
+*					grey values. The domain is known to
+*					be non NULL.
+* \param	map			File mapping for mapped values, may
+*					be NULL if values are not mapped.
+*/
+static WlzErrorNum WlzReadDomObjValues2D(FILE *fP, WlzObject *obj,
+					 WlzReadMap **map)
+{
+  WlzObjectType	type;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  type = (WlzObjectType )getc(fP);
+  if(type == (WlzObjectType )EOF)
+  {
+    errNum = WLZ_ERR_READ_INCOMPLETE;
+  }
+  else if(type == WLZ_NULL)
+  {
+    obj->values.core = NULL;
+  }
+  else
+  {
+    switch(type)
+    {
+      case WLZ_VALUETABLE_TILED_INT:    /* FALLTHROUGH */
+      case WLZ_VALUETABLE_TILED_SHORT:  /* FALLTHROUGH */
+      case WLZ_VALUETABLE_TILED_UBYTE:  /* FALLTHROUGH */
+      case WLZ_VALUETABLE_TILED_FLOAT:  /* FALLTHROUGH */
+      case WLZ_VALUETABLE_TILED_DOUBLE: /* FALLTHROUGH */
+      case WLZ_VALUETABLE_TILED_RGBA:
+	errNum = WlzReadTiledValues(fP, obj, 2, type, 1);
+	break;
+      default:
+        errNum = WlzReadGreyValues(fP, type, obj, map);
+	break;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
 * \ingroup	WlzIO
 * \brief	Reads a Woolz 3D value table for a 3D domain object.
 * 		This function reads the grey value table type and then
@@ -2097,8 +3306,20 @@ static WlzErrorNum WlzReadDomObjValues2D(FILE *fP, WlzObject *obj)
 * \param	obj			Object defining the domain of the
 *					grey values. The domain is known to
 *					be non NULL.
+* \param	map			File mapping for mapped values, may
+*					be NULL if values are not mapped.
+* \param	box			If non-NULL only the voxel value
+* 					tables of planes intersecting this
+* 					region are read.
+* \param	idx			Non-zero if the object's plane domain
+* 					had a valid plane index.
+* \param	nV			Number of values of each plane outside
+* 					of the region as given by
+* 					WlzReadPlaneDomain(), may be NULL.
 */
-static WlzErrorNum WlzReadDomObjValues3D(FILE *fP, WlzObject *obj)
+static WlzErrorNum WlzReadDomObjValues3D(FILE *fP, WlzObject *obj,
+					 WlzReadMap **map, WlzIBox3 *box,
+					 int idx, size_t *nV)
 {
   WlzObjectType	type;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -2117,7 +3338,7 @@ static WlzErrorNum WlzReadDomObjValues3D(FILE *fP, WlzObject *obj)
     switch(type)
     {
       case WLZ_VOXELVALUETABLE_GREY:
-        errNum = WlzReadVoxelValues(fP, obj);
+        errNum = WlzReadVoxelValues(fP, obj, map, box, idx, nV);
 	break;
       case WLZ_VALUETABLE_TILED_INT:    /* FALLTHROUGH */
       case WLZ_VALUETABLE_TILED_SHORT:  /* FALLTHROUGH */
@@ -2149,13 +3370,15 @@ static WlzErrorNum WlzReadDomObjValues3D(FILE *fP, WlzObject *obj)
 * 					encodes both the grey type and the
 * 					value table type.
 * \param	map			If non zero the tiles are memory
-* 					mapped rather than read.
+* 					mapped rather than read. This is
+* 					ignored if the tiles are compressed.
 */
 static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
 				      int dim, WlzObjectType type,
 				      int map)
 {
   WlzGreyType	gType;
+  WlzTiledCompression cmp = WLZ_TILED_COMPRESS_NONE;
   WlzTiledValues *tVal = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
@@ -2164,10 +3387,21 @@ static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
   {
     int		tDim;
 
-    if((tDim = getc(fP)) != dim)
+    /* The high bits of the dimension byte encode the compression. */
+    tDim = getc(fP);
+    if((tDim == EOF) || ((tDim & 0x0f) != dim))
     {
       errNum = WLZ_ERR_READ_INCOMPLETE;
     }
+    else
+    {
+      cmp = (WlzTiledCompression )(tDim >> 4);
+      if((cmp != WLZ_TILED_COMPRESS_NONE) &&
+         (cmp != WLZ_TILED_COMPRESS_DELTA_RLE))
+      {
+        errNum = WLZ_ERR_VALUES_DATA;
+      }
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -2176,6 +3410,7 @@ static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
   if(errNum == WLZ_ERR_NONE)
   {
     tVal->type = type;
+    tVal->compression = cmp;
     tVal->dim = dim;
     tVal->kol1 = getword(fP);
     tVal->lastkl = getword(fP);
@@ -2243,7 +3478,68 @@ static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
 
     gSz = WlzGreySize(gType);
     tSz = tVal->numTiles * tVal->tileSz;
-    if(map == 0)
+    if(cmp != WLZ_TILED_COMPRESS_NONE)
+    {
+      size_t	*cOff = NULL;
+      WlzUByte	*cTiles = NULL;
+
+      /* Compressed tile sizes are followed by the compressed tiles. */
+      if(fseek(fP, tVal->tileOffset, SEEK_SET) != 0)
+      {
+	errNum = WLZ_ERR_READ_INCOMPLETE;
+      }
+      else if((cOff = (size_t *)
+                      AlcMalloc((tVal->numTiles + 1) * sizeof(size_t))) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+        size_t	idx;
+
+	cOff[0] = 0;
+	for(idx = 0; idx < tVal->numTiles; ++idx)
+	{
+	  size_t cSz;
+
+	  cSz = (unsigned int )getword(fP);
+	  if((cSz == 0) || (cSz > tVal->tileSz * gSz))
+	  {
+	    errNum = WLZ_ERR_READ_INCOMPLETE;
+	    break;
+	  }
+	  cOff[idx + 1] = cOff[idx] + cSz;
+	}
+	if(feof(fP))
+	{
+	  errNum = WLZ_ERR_READ_INCOMPLETE;
+	}
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+        size_t	cSz;
+
+	cSz = cOff[tVal->numTiles];
+	if((cTiles = (WlzUByte *)AlcMalloc(cSz)) == NULL)
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+	else if(fread(cTiles, 1, cSz, fP) != cSz)
+	{
+	  errNum = WLZ_ERR_READ_INCOMPLETE;
+	}
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+        errNum = WlzMakeTiledValuesCompressedTiles(tVal, cOff, cTiles);
+      }
+      if(errNum != WLZ_ERR_NONE)
+      {
+        AlcFree(cOff);
+	AlcFree(cTiles);
+      }
+    }
+    else if(map == 0)
     {
       tVal->fd = -1;
       if((tVal->tiles.v = AlcMalloc(tSz * gSz)) == NULL)
@@ -2292,6 +3588,12 @@ static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
 	  tVal->tiles.v = NULL;
 	  errNum = WLZ_ERR_READ_INCOMPLETE;
 	}
+	else
+	{
+	  /* Leave the file positioned after the tiles, as when they are
+	   * read, so that any following property list can be read. */
+	  (void )fseek(fP, tVal->tileOffset + (long )(tSz * gSz), SEEK_SET);
+	}
       }
 #else /* WLZ_USE_MMAP */
       tVal->tiles.v = NULL;
@@ -2360,6 +3662,41 @@ static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
   return(errNum);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Skips over a 2D grey value table in the input file without
+* 		reading it's values.
+* \param	fP			Input file.
+* \param	nV			Number of values in the value table.
+*/
+static WlzErrorNum WlzReadGreyValuesSkip(FILE *fP, size_t nV)
+{
+  int		gType,
+  		pType;
+  size_t	sz;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((gType = getc(fP)) == EOF)
+  {
+    errNum = WLZ_ERR_READ_INCOMPLETE;
+  }
+  else if(gType != WLZ_NULL)
+  {
+    pType = getc(fP);
+    if((sz = WlzReadGreyValuesFileSz((WlzGreyType )gType,
+                                     (WlzGreyType )pType, nV)) == 0)
+    {
+      errNum = WLZ_ERR_VALUES_TYPE;
+    }
+    else if(fseek(fP, (long )(sz - 2), SEEK_CUR) != 0)
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+  }
+  return(errNum);
+}
+
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzIO
@@ -2368,10 +3705,27 @@ static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
 * \param	fp			Input file.
 * \param	obj			Object defining the domain of the
 *					grey values.
+* \param	map			File mapping for mapped values, may
+*					be NULL if values are not mapped.
+* \param	box			If non-NULL only the value tables of
+* 					planes intersecting this region are
+* 					read, those of all other planes are
+* 					skipped.
+* \param	idx			Non-zero if the object's plane domain
+* 					had a valid plane index, in which
+* 					case the planes' values may be read
+* 					concurrently.
+* \param	nV			Number of values of each plane outside
+* 					of the region, used to skip their
+* 					value tables. If NULL the numbers of
+* 					values are found from the planes'
+* 					domains.
 */
-static WlzErrorNum WlzReadVoxelValues(FILE *fp, WlzObject *obj)
+static WlzErrorNum WlzReadVoxelValues(FILE *fp, WlzObject *obj,
+				      WlzReadMap **map, WlzIBox3 *box,
+				      int idx, size_t *nV)
 {
-  int 			i, nplanes;
+  int 			i, nplanes, p0 = 0, p1;
   WlzObject 		*tmpobj;
   WlzDomain 		*domains;
   WlzValues		*values, value;
@@ -2402,15 +3756,34 @@ static WlzErrorNum WlzReadVoxelValues(FILE *fp, WlzObject *obj)
   else {
     return errNum;
   }
+  p1 = nplanes;
+  if(box != NULL){
+    p0 = WLZ_CLAMP(box->zMin - planedm->plane1, 0, nplanes);
+    p1 = WLZ_CLAMP(box->zMax - planedm->plane1 + 1, p0, nplanes);
+  }
+  else if(idx && (map == NULL) &&
+          (planedm->type == WLZ_PLANEDOMAIN_DOMAIN) &&
+	  WlzReadVoxelValuesIdx(fp, obj, voxtab)){
+    /* All the planes have been read using the plane index. */
+    nplanes = 0;
+  }
 
   for(i=0; i < nplanes; i++, values++, domains++){
     (*values).core = NULL;
-    if((tmpobj = WlzMakeMain(WLZ_2D_DOMAINOBJ, *domains, *values,
-			     NULL, NULL, &errNum)) != NULL){
+    if((i < p0) || (i >= p1)){
+      errNum = WlzReadGreyValuesSkip(fp, (nV != NULL)? nV[i]:
+				     WlzReadGreyValuesCount((*domains).i));
+      if(errNum != WLZ_ERR_NONE){
+	break;
+      }
+    }
+    else if((tmpobj = WlzMakeMain(WLZ_2D_DOMAINOBJ, *domains, *values,
+				  NULL, NULL, &errNum)) != NULL){
       WlzObjectType gtt;
 
       gtt = (WlzObjectType )getc(fp);
-      if( (errNum = WlzReadGreyValues(fp, gtt, tmpobj)) == WLZ_ERR_NONE ){
+      if( (errNum = WlzReadGreyValues(fp, gtt, tmpobj,
+                                      map)) == WLZ_ERR_NONE ){
 	*values = WlzAssignValues(tmpobj->values, NULL);
 	/* reset voxel-table background */
 	if( (*values).core != NULL ){
@@ -3129,10 +4502,13 @@ static WlzHistogramDomain *WlzReadHistogramDomain(FILE *fp,
 * \brief	Reads a Woolz compund object.
 * \param	fp			Input file.
 * \param	type			Object type as read by WlzReadObj().
+* \param	map			File mapping for mapped values, may
+*					be NULL if values are not mapped.
 * \param	dstErr			Destination error pointer, may be NULL.
 */
 static WlzObject *WlzReadCompoundA(FILE			*fp,
 				   WlzObjectType	type,
+				   WlzReadMap		**map,
 				   WlzErrorNum		*dstErr)
 {
   WlzCompoundArray	*c=NULL;
@@ -3158,7 +4534,7 @@ static WlzObject *WlzReadCompoundA(FILE			*fp,
   if((errNum == WLZ_ERR_NONE) &&
      ((c = WlzMakeCompoundArray(type, 1, n, NULL, otype, &errNum)) != NULL)){
     for(i=0; (i<n) && (errNum == WLZ_ERR_NONE); i++){
-      c->o[i] = WlzAssignObject(WlzReadObj(fp, &errNum), NULL);
+      c->o[i] = WlzAssignObject(WlzReadObjMap(fp, map, &errNum), NULL);
     }
     if( errNum == WLZ_ERR_NONE ){
       c->plist = WlzAssignPropertyList(WlzReadPropertyList(fp, NULL), NULL);
@@ -3468,7 +4844,7 @@ static Wlz3DWarpTrans *WlzRead3DWarpTrans(FILE *fp, WlzErrorNum *dstErr)
   }
 
   if( errNum == WLZ_ERR_NONE ){
-    if( (obj->pdom = WlzReadPlaneDomain(fp, &errNum)) == NULL ){
+    if( (obj->pdom = WlzReadPlaneDomain(fp, NULL, NULL, NULL, &errNum)) == NULL ){
       AlcFree((void *) obj);
       obj = NULL;
     }
@@ -45,6 +45,22 @@ static char _WlzRegCCor_c[] = "University of Edinburgh $Id$";
 #include <Wlz.h>
 
 /* #define WLZ_REGCCOR_DEBUG */
+
+/*!
+* \struct	_WlzRegCCorPlans
+* \brief	Fourier transform plans for the padded array sizes used
+* 		while registering a pair of objects, so that a plan is
+* 		made once for each size rather than for each cross
+* 		correlation.
+* 		Typedef: ::WlzRegCCorPlans
+*/
+typedef struct _WlzRegCCorPlans
+{
+  int		nPlan;			/*!< Number of plans. */
+  int		maxPlan;		/*!< Space allocated for plans. */
+  AlgFourPlan	**plan;			/*!< The plans. */
+} WlzRegCCorPlans;
+
 static WlzObject 		*WlzRegCCorNormaliseObj2D(
 				  WlzObject *obj,
 				  int inv,
@@ -69,6 +85,7 @@ static WlzAffineTransform 	*WlzRegCCorObjs2D(
 				  double *dstCCor,
 				  WlzErrorNum *dstErr);
 static WlzAffineTransform 	*WlzRegCCorObjs2D1(
+				  WlzRegCCorPlans *plans,
 				  WlzObject *tObj,
 				  WlzObject *sObj,
 				  WlzAffineTransform *initTr,
@@ -82,6 +99,7 @@ static WlzAffineTransform 	*WlzRegCCorObjs2D1(
 				  double *dstCCor,
 				  WlzErrorNum *dstErr);
 static WlzDVertex2		WlzRegCCorObjs2DTran(
+				  WlzRegCCorPlans *plans,
 				  WlzObject *tObj,
 				  WlzObject *sObj,
 				  WlzAffineTransform *initTr,
@@ -91,6 +109,7 @@ static WlzDVertex2		WlzRegCCorObjs2DTran(
 				  double *dstCCor,
 				  WlzErrorNum *dstErr);
 static double			WlzRegCCorObjs2DRot(
+				  WlzRegCCorPlans *plans,
 				  WlzObject *tObj,
 				  WlzObject *sObj,
 				  WlzAffineTransform *initTr,
@@ -98,6 +117,12 @@ static double			WlzRegCCorObjs2DRot(
 				  WlzWindowFnType winFn,
 				  int noise,
 				  WlzErrorNum *dstErr);
+static AlgFourPlan		*WlzRegCCorPlanGet(
+				  WlzRegCCorPlans *plans,
+				  WlzIVertex2 sz,
+				  WlzErrorNum *dstErr);
+static void			WlzRegCCorPlansFree(
+				  WlzRegCCorPlans *plans);
 
 /*!
 * \return	Affine transform which brings the two objects into register.
@@ -409,12 +434,15 @@ static WlzAffineTransform *WlzRegCCorObjs2D(WlzObject *tObj, WlzObject *sObj,
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   WlzAffineTransformPrim trPrim;
   WlzPixelV	zeroBgd;
+  WlzRegCCorPlans plans;
   const int	samFacStep = 4,
   		maxSam = 16,
   		minSamSz = 100;
 
   zeroBgd.type = WLZ_GREY_INT;
   zeroBgd.v.inv = 0;
+  plans.nPlan = plans.maxPlan = 0;
+  plans.plan = NULL;
   gV[0].type = gV[1].type = gV[2].type = gV[3].type = WLZ_GREY_DOUBLE;
   /* Compute the number of x4 subsampling operations to use. */
   sBox = WlzBoundingBox2I(sObj, &errNum);
@@ -512,7 +540,8 @@ static WlzAffineTransform *WlzRegCCorObjs2D(WlzObject *tObj, WlzObject *sObj,
       /* Compute registration transform. */
       if(errNum == WLZ_ERR_NONE)
       {
-	samRegTr1 = WlzRegCCorObjs2D1(*(sTObj + samIdx), *(sSObj + samIdx),
+	samRegTr1 = WlzRegCCorObjs2D1(&plans,
+				      *(sTObj + samIdx), *(sSObj + samIdx),
 				      samRegTr0,
 				      trType, sMaxTran, sMaxRot, maxItr,
 				      winFn, noise,
@@ -558,6 +587,7 @@ static WlzAffineTransform *WlzRegCCorObjs2D(WlzObject *tObj, WlzObject *sObj,
     }
     regTr = samRegTr0;
   }
+  WlzRegCCorPlansFree(&plans);
   AlcFree(samFac);
   /* Free subsampled objects. */
   if(sTObj)
@@ -590,6 +620,7 @@ static WlzAffineTransform *WlzRegCCorObjs2D(WlzObject *tObj, WlzObject *sObj,
 *               frequency domain cross correlation.  An affine transform
 *               is computed, which when applied to the source object
 *               takes it into register with the target object.
+* \param	plans			Fourier transform plans.
 * \param	tObj			The target object. Must have
 *                                       been assigned.
 * \param	sObj			The source object to be
@@ -617,7 +648,8 @@ static WlzAffineTransform *WlzRegCCorObjs2D(WlzObject *tObj, WlzObject *sObj,
 * \param	dstErr			Destination error pointer,
 *                                       may be NULL.
 */
-static WlzAffineTransform *WlzRegCCorObjs2D1(WlzObject *tObj, WlzObject *sObj,
+static WlzAffineTransform *WlzRegCCorObjs2D1(WlzRegCCorPlans *plans,
+					     WlzObject *tObj, WlzObject *sObj,
 					     WlzAffineTransform *initTr,
 					     WlzTransformType trType,
 					     WlzDVertex2 maxTran,
@@ -639,8 +671,8 @@ static WlzAffineTransform *WlzRegCCorObjs2D1(WlzObject *tObj, WlzObject *sObj,
   const double	tranTol = 0.5;
 
   /* Register for translation. */
-  tran = WlzRegCCorObjs2DTran(tObj, sObj, initTr, maxTran, winFn, noise,
-  			      &cCor, &errNum);
+  tran = WlzRegCCorObjs2DTran(plans, tObj, sObj, initTr, maxTran,
+  			      winFn, noise, &cCor, &errNum);
   if(errNum == WLZ_ERR_NONE)
   {
     tTr0 = WlzAffineTransformFromPrimVal(WLZ_TRANSFORM_2D_AFFINE,
@@ -672,7 +704,7 @@ static WlzAffineTransform *WlzRegCCorObjs2D1(WlzObject *tObj, WlzObject *sObj,
 	  ((maxItr < 0) || (itr++ < maxItr)))
     {
       /* Register for rotation. */
-      rot = WlzRegCCorObjs2DRot(tObj, sObj, curTr, 
+      rot = WlzRegCCorObjs2DRot(plans, tObj, sObj, curTr, 
 				maxRot, winFn, noise, &errNum);
       if(errNum == WLZ_ERR_NONE)
       {
@@ -694,8 +726,8 @@ static WlzAffineTransform *WlzRegCCorObjs2D1(WlzObject *tObj, WlzObject *sObj,
       /* Register for translation. */
       if(errNum == WLZ_ERR_NONE)
       {
-	tran = WlzRegCCorObjs2DTran(tObj, sObj, curTr, maxTran, winFn, noise,
-				    &cCor, &errNum);
+	tran = WlzRegCCorObjs2DTran(plans, tObj, sObj, curTr, maxTran,
+				    winFn, noise, &cCor, &errNum);
       }
       if(errNum == WLZ_ERR_NONE)
       {
@@ -744,6 +776,7 @@ static WlzAffineTransform *WlzRegCCorObjs2D1(WlzObject *tObj, WlzObject *sObj,
 *               frequency domain cross correlation, to find
 *               the translation which has the highest cross
 *               correlation value.
+* \param	plans			Fourier transform plans.
 * \param	tObj			The target object. Must have
 *                                       been assigned.
 * \param	sObj			The source object to be
@@ -761,7 +794,8 @@ static WlzAffineTransform *WlzRegCCorObjs2D1(WlzObject *tObj, WlzObject *sObj,
 * \param	dstErr			Destination error pointer,
 *                                       may be NULL.
 */
-static WlzDVertex2 WlzRegCCorObjs2DTran(WlzObject *tObj, WlzObject *sObj,
+static WlzDVertex2 WlzRegCCorObjs2DTran(WlzRegCCorPlans *plans,
+					WlzObject *tObj, WlzObject *sObj,
 					WlzAffineTransform *initTr,
 					WlzDVertex2 maxTran,
 					WlzWindowFnType winFn, int noise,
@@ -782,6 +816,7 @@ static WlzDVertex2 WlzRegCCorObjs2DTran(WlzObject *tObj, WlzObject *sObj,
   WlzDVertex2	dstTran;
   WlzObject	*oObj[2],
   		*pObj[2];
+  AlgFourPlan	*plan = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   dstTran.vtX = 0.0;
@@ -846,8 +881,8 @@ static WlzDVertex2 WlzRegCCorObjs2DTran(WlzObject *tObj, WlzObject *sObj,
     aOrg.vtY = aBox.yMin;
     aSz.vtX = aBox.xMax - aBox.xMin + 1;
     aSz.vtY = aBox.yMax - aBox.yMin + 1;
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&(aSz.vtX), aSz.vtX);
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&(aSz.vtY), aSz.vtY);
+    aSz.vtX = AlgFourNextFastSize(aSz.vtX);
+    aSz.vtY = AlgFourNextFastSize(aSz.vtY);
     oIdx = 0;
     while((errNum == WLZ_ERR_NONE) && (oIdx < 2))
     {
@@ -907,7 +942,11 @@ static WlzDVertex2 WlzRegCCorObjs2DTran(WlzObject *tObj, WlzObject *sObj,
   /* Cross correlate. */
   if(errNum == WLZ_ERR_NONE)
   {
-    (void )AlgCrossCorrelate2D(oAr[0], oAr[1], aSz.vtX, aSz.vtY);
+    plan = WlzRegCCorPlanGet(plans, aSz, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    (void )AlgCrossCorrelate2DPlan(plan, oAr[0], oAr[1]);
     AlgCrossCorrPeakXY(&(tran.vtX), &(tran.vtY), &cCor, oAr[0],
 		       aSz.vtX, aSz.vtY, maxTran.vtX, maxTran.vtY);
   }
@@ -975,6 +1014,7 @@ static WlzDVertex2 WlzRegCCorObjs2DTran(WlzObject *tObj, WlzObject *sObj,
 *               the angle of rotation about the given centre of rotation
 *               which has the highest cross correlation value.
 *		The rotation is always about the objects cente of mass.
+* \param	plans			Fourier transform plans.
 * \param	tObj			The target object. Must have
 *                                       been assigned.
 * \param	sObj			The source object to be
@@ -989,7 +1029,8 @@ static WlzDVertex2 WlzRegCCorObjs2DTran(WlzObject *tObj, WlzObject *sObj,
 * \param	dstErr			Destination error pointer,
 *                                       may be NULL.
 */
-static double	WlzRegCCorObjs2DRot(WlzObject *tObj, WlzObject *sObj,
+static double	WlzRegCCorObjs2DRot(WlzRegCCorPlans *plans,
+				    WlzObject *tObj, WlzObject *sObj,
 				    WlzAffineTransform *initTr, double maxRot,
 				    WlzWindowFnType winFn, int noise,
 				    WlzErrorNum *dstErr)
@@ -1011,6 +1052,7 @@ static double	WlzRegCCorObjs2DRot(WlzObject *tObj, WlzObject *sObj,
   WlzObject	*oObj[2],
   		*pObj[2],
 		*wObj[2];
+  AlgFourPlan	*plan = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   const int	rotCnt = 500;
   const double	distInc = 1.0;
@@ -1107,8 +1149,8 @@ static double	WlzRegCCorObjs2DRot(WlzObject *tObj, WlzObject *sObj,
     aOrg.vtY = aBox.yMin;
     aSz.vtX = aBox.xMax - aBox.xMin + 1;
     aSz.vtY = aBox.yMax - aBox.yMin + 1;
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&(aSz.vtX), aSz.vtX);
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&(aSz.vtY), aSz.vtY);
+    aSz.vtX = AlgFourNextFastSize(aSz.vtX);
+    aSz.vtY = AlgFourNextFastSize(aSz.vtY);
     oIdx = 0;
     while((errNum == WLZ_ERR_NONE) && (oIdx < 2))
     {
@@ -1146,7 +1188,11 @@ static double	WlzRegCCorObjs2DRot(WlzObject *tObj, WlzObject *sObj,
   /* Cross correlate. */
   if(errNum == WLZ_ERR_NONE)
   {
-    (void )AlgCrossCorrelate2D(oAr[0], oAr[1], aSz.vtX, aSz.vtY);
+    plan = WlzRegCCorPlanGet(plans, aSz, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    (void )AlgCrossCorrelate2DPlan(plan, oAr[0], oAr[1]);
     AlgCrossCorrPeakXY(&(rot.vtX), &(rot.vtY), NULL, oAr[0],
 		       aSz.vtX, aSz.vtY, rotPad.vtX, rotPad.vtY);
     dstRot = rot.vtY * angInc;
@@ -1199,3 +1245,90 @@ static double	WlzRegCCorObjs2DRot(WlzObject *tObj, WlzObject *sObj,
   }
   return(dstRot);
 }
+
+/*!
+* \return	Plan for the given size or NULL on error.
+* \ingroup	WlzRegistration
+* \brief	Gets a two dimensional real Fourier transform plan for
+* 		the given array size, making it and adding it to the
+* 		given plans if there is not already a plan for the size.
+* 		The plan is owned by the plans and is freed by
+* 		WlzRegCCorPlansFree().
+* \param	plans			Fourier transform plans.
+* \param	sz			Array size.
+* \param	dstErr			Destination error pointer,
+*                                       may be NULL.
+*/
+static AlgFourPlan *WlzRegCCorPlanGet(WlzRegCCorPlans *plans,
+				      WlzIVertex2 sz, WlzErrorNum *dstErr)
+{
+  int		idx;
+  AlgFourPlan	*plan = NULL;
+  AlgError	algErr = ALG_ERR_NONE;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  for(idx = 0; idx < plans->nPlan; ++idx)
+  {
+    if((plans->plan[idx]->num[0] == sz.vtX) &&
+       (plans->plan[idx]->num[1] == sz.vtY))
+    {
+      plan = plans->plan[idx];
+      break;
+    }
+  }
+  if(plan == NULL)
+  {
+    if(plans->nPlan >= plans->maxPlan)
+    {
+      AlgFourPlan **newPlan;
+
+      if((newPlan = (AlgFourPlan **)
+		    AlcRealloc(plans->plan, (plans->maxPlan + 8) *
+		                            sizeof(AlgFourPlan *))) == NULL)
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+	plans->plan = newPlan;
+	plans->maxPlan += 8;
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      plan = AlgFourPlanMake(2, 1, sz.vtX, sz.vtY, 1, &algErr);
+      if(algErr == ALG_ERR_NONE)
+      {
+        plans->plan[plans->nPlan++] = plan;
+      }
+      else
+      {
+        errNum = WlzErrorFromAlg(algErr);
+      }
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(plan);
+}
+
+/*!
+* \ingroup	WlzRegistration
+* \brief	Frees the Fourier transform plans made by
+* 		WlzRegCCorPlanGet(), but not the given plans structure.
+* \param	plans			Fourier transform plans.
+*/
+static void	WlzRegCCorPlansFree(WlzRegCCorPlans *plans)
+{
+  int		idx;
+
+  for(idx = 0; idx < plans->nPlan; ++idx)
+  {
+    AlgFourPlanFree(plans->plan[idx]);
+  }
+  AlcFree(plans->plan);
+  plans->nPlan = plans->maxPlan = 0;
+  plans->plan = NULL;
+}
@@ -42,6 +42,9 @@ static char _WlzRsvFilter_c[] = "University of Edinburgh $Id$";
 
 #include <stdio.h>
 #include <float.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include <Wlz.h>
 
 /* These tests are for debuging only. */
@@ -49,6 +52,13 @@ static char _WlzRsvFilter_c[] = "University of Edinburgh $Id$";
 /* #define WLZ_RSVFILTER_TEST_2D */
 /* #define WLZ_RSVFILTER_TEST_3D */
 
+/* Minimum number of columns in a block when filtering through the lines
+ * of a 2D object in parallel. */
+#define WLZ_RSVFILTER_BLK_MIN	(64)
+/* Approximate number of bytes for the working buffers of a band of lines
+ * when filtering through the planes of a 3D object. */
+#define WLZ_RSVFILTER_BAND_BYTES (1048576)
+
 static WlzObject *WlzRsvFilterObj2DX(WlzObject *, WlzRsvFilter *,
 				     WlzErrorNum *);
 static WlzObject *WlzRsvFilterObj2DY(WlzObject *, WlzRsvFilter *,
@@ -57,6 +67,21 @@ static WlzObject *WlzRsvFilterObj3DXY(WlzObject *, WlzRsvFilter *,
 			              int, WlzErrorNum *);
 static WlzObject *WlzRsvFilterObj3DZ(WlzObject *, WlzRsvFilter *,
 				     WlzErrorNum *);
+static WlzErrorNum WlzRsvFilterObj2DXPart(WlzObject *srcObj,
+				          WlzObject *dstObj,
+					  WlzRsvFilter *ftr,
+					  WlzIntervalScanPart *part);
+static WlzErrorNum WlzRsvFilterObj2DYBlk(WlzObject *srcObj,
+					 WlzObject *dstObj,
+					 WlzRsvFilter *ftr,
+					 int blkKol0, int blkKol1);
+static WlzErrorNum WlzRsvFilterObj3DZBand(WlzObject *srcObj,
+					  WlzObject *dstObj,
+					  WlzRsvFilter *ftr,
+					  int bandLn0, int bandLn1);
+static WlzGreyType WlzRsvFilterDstGreyType(WlzGreyType srcGType,
+					   WlzErrorNum *dstErr);
+static int	WlzRsvFilterNThreads(void);
 static void	WlzRsvFilterFilterBufXF(WlzRsvFilter *,
 				      double *, double *, double *,
 				      int);
@@ -70,6 +95,13 @@ static void	WlzRsvFilterFilterBufZF(WlzRsvFilter *ftr,
 					WlzIVertex3 bufPos,
 					int itvLen,
 					int goingUp);
+static void	WlzRsvFilterFilterItvF(WlzRsvFilter *ftr,
+				       double *dP0, double *dP1, double *dP2,
+				       double *fP0, double *fP1, double *fP2,
+				       WlzUByte *iP1, WlzUByte *iP2,
+				       int kol, int itvLen, int goingUp);
+static int	WlzRsvFilterItvRun(WlzUByte *iP1, WlzUByte *iP2,
+				   int kol, int cnt);
 
 /*!
 * \return	void
@@ -503,39 +535,93 @@ WlzErrorNum	WlzRsvFilterBuffer(WlzRsvFilter *ftr, double *datBuf,
   return(errNum);
 }
 
+/*!
+* \return	Number of consecutive columns, starting at the given
+* 		column, which are within both of the previous rows.
+* \ingroup	WlzValueFilters
+* \brief	Finds the length of the run of columns (at most cnt)
+* 		for which the previous two rows (lines or planes) of
+* 		the vertical IIR filter are set in the within interval
+* 		bit buffers. Whole bytes of set bits are skipped eight
+* 		columns at a time.
+* \param	iP1			Bit buffer for the previous row.
+* \param	iP2			Bit buffer for the row before the
+* 					previous row.
+* \param	kol			First column relative to the
+* 					buffer origin.
+* \param	cnt			Maximum run length.
+*/
+static int	WlzRsvFilterItvRun(WlzUByte *iP1, WlzUByte *iP2,
+				   int kol, int cnt)
+{
+  int		iBO,
+  		iBS,
+		run = 0;
+  WlzUByte	msk;
+
+  while(run < cnt)
+  {
+    iBO = (kol + run) >> 3;
+    iBS = (kol + run) & 7;
+    msk = *(iP1 + iBO) & *(iP2 + iBO);
+    if((iBS == 0) && (msk == 0xff) && (cnt - run >= 8))
+    {
+      run += 8;
+    }
+    else if((msk & (1 << iBS)) != 0)
+    {
+      ++run;
+    }
+    else
+    {
+      break;
+    }
+  }
+  return(run);
+}
+
 /*!
 * \return	void
 * \ingroup	WlzValueFilters
-* \brief	Filters a single interval using a vertical IIR filter
-*               defined by the filter coefficients and double precision
-*               arithmetic.
+* \brief	Filters a single interval of a row (line or plane) using
+* 		a vertical IIR filter defined by the filter coefficients
+* 		and double precision arithmetic. The columns of the
+* 		interval are independent of each other, so runs of
+* 		columns for which the two previous rows are within the
+* 		domain are filtered by simple loops over the columns
+* 		which the compiler is able to vectorise. Only columns
+* 		at the start of a column of the domain are handled one
+* 		at a time.
 * \note         See the double precision horizontal function for
 *               simple code.
 * \param	ftr			The filter.
-* \param	wrkBuf			Working buffer.
-* \param	srcBuf			Source buffer.
-* \param	itvBuf			Within interval bit buffer.
-* \param	bufPos			Position within the buffer.
+* \param	dP0			Source data for this row.
+* \param	dP1			Source data for the previous row.
+* \param	dP2			Source data for the row before the
+* 					previous row.
+* \param	fP0			Working data for this row.
+* \param	fP1			Working data for the previous row.
+* \param	fP2			Working data for the row before the
+* 					previous row.
+* \param	iP1			Bit buffer for the previous row.
+* \param	iP2			Bit buffer for the row before the
+* 					previous row.
+* \param	kol			First column of the interval relative
+* 					to the buffer origin, the data
+* 					pointers are for this column.
 * \param	itvLen			Interval length.
 * \param	goingUp			Non-zero if going up through
-*                                       the lines (ie raster direction
-*                                       is WLZ_RASTERDIR_DLIC).
+*                                       the rows.
 */
-static void	WlzRsvFilterFilterBufYF(WlzRsvFilter *ftr,
-				      double **wrkBuf, double **srcBuf,
-				      WlzUByte **itvBuf,
-				      WlzIVertex2 bufPos, int itvLen,
-				      int goingUp)
+static void	WlzRsvFilterFilterItvF(WlzRsvFilter *ftr,
+				       double *dP0, double *dP1, double *dP2,
+				       double *fP0, double *fP1, double *fP2,
+				       WlzUByte *iP1, WlzUByte *iP2,
+				       int kol, int itvLen, int goingUp)
 {
-  int		cnt0,
-		cnt1,
-		kol,
-		iBM,
-		iBO,
-		iBS,
-  		idL0,
-		idL1,
-		idL2;
+  int		idK,
+  		cnt,
+		run;
   double	a0,
   		a1,
 		a2,
@@ -544,144 +630,121 @@ static void	WlzRsvFilterFilterBufYF(WlzRsvFilter *ftr,
 		b1,
 		c,
 		d0,
-		d1,
-		d2,
 		f0,
-		f1,
-		f2;
-  WlzUByte	*iBP1,
-  		*iBP2,
-  		*iP1,
-  		*iP2;
-  double	*dP0,
-  		*dP1,
-		*dP2,
-		*fP0,
-		*fP1,
-		*fP2;
+		f1;
 
-  if(goingUp)
-  {
-    idL0 = (bufPos.vtY + 3 + 0) % 3;
-    idL1 = (bufPos.vtY + 3 + 1) % 3;
-    idL2 = (bufPos.vtY + 3 + 2) % 3;
-    a2 = ftr->a[2];
-    a3 = ftr->a[3];
-  }
-  else
-  {
-    idL0 = (bufPos.vtY + 3 - 0) % 3;
-    idL1 = (bufPos.vtY + 3 - 1) % 3;
-    idL2 = (bufPos.vtY + 3 - 2) % 3;
-    a0 = ftr->a[0];
-    a1 = ftr->a[1];
-  }
+  a0 = ftr->a[0];
+  a1 = ftr->a[1];
+  a2 = ftr->a[2];
+  a3 = ftr->a[3];
   b0 = ftr->b[0];
   b1 = ftr->b[1];
   c = ftr->c;
-  kol = bufPos.vtX;
-  iP1 = *(itvBuf + idL1);
-  iP2 = *(itvBuf + idL2);
-  dP0 = *(srcBuf + idL0) + kol;
-  fP0 = *(wrkBuf + idL0) + kol;
-  dP1 = *(srcBuf + idL1) + kol;
-  fP1 = *(wrkBuf + idL1) + kol;
-  dP2 = *(srcBuf + idL2) + kol;
-  fP2 = *(wrkBuf + idL2) + kol;
-  cnt0 = itvLen;
-  if(goingUp)
+  cnt = itvLen;
+  while(cnt > 0)
   {
-    while(cnt0 > 0)
+    run = WlzRsvFilterItvRun(iP1, iP2, kol, cnt);
+    if(run > 0)
     {
-      iBO = kol >> 3;
-      iBS = kol & 7;
-      iBP1 = iP1 + iBO;
-      iBP2 = iP2 + iBO;
-      if((iBS == 0) && ((*iBP1 & *iBP2) == 0xff) && (cnt0 >= 8))
+      if(goingUp)
       {
-	cnt1 = 8;
-	while(cnt1-- > 0)
+	for(idK = 0; idK < run; ++idK)
 	{
-	  f0 = *fP0;
-	  *fP0 = (a2 * *dP1++) + (a3 * *dP2++) - (b0 * *fP1++) - (b1 * *fP2);
-	  *fP2++ = c * (f0 + *fP0++);
+	  f0 = fP0[idK];
+	  f1 = (a2 * dP1[idK]) + (a3 * dP2[idK]) -
+	       (b0 * fP1[idK]) - (b1 * fP2[idK]);
+	  fP0[idK] = f1;
+	  fP2[idK] = c * (f0 + f1);
 	}
-	kol += 8;
-	cnt0 -= 8;
       }
       else
       {
-	d0 = *dP0;
-	f0 = *fP0;
-	iBM = 1 << iBS;
-	if(((*iBP1 & iBM) == 0) || ((*iBP2 & iBM) == 0))
-	{
-	  d1 = d0;
-	  d2 = d0;
-	  f1 = f2 = ((a2 * a3) * d0) / (b0 + b1 + 1);
-	}
-	else
+	for(idK = 0; idK < run; ++idK)
 	{
-	  d1 = *dP1;
-	  d2 = *dP2;
-	  f1 = *fP1;
-	  f2 = *fP2;
+	  fP0[idK] = (a0 * dP0[idK]) + (a1 * dP1[idK]) -
+		     (b0 * fP1[idK]) - (b1 * fP2[idK]);
 	}
-	++dP0;
-	++dP1;
-	++dP2;
-	++fP1;
-	*fP0 = (a2 * d1) + (a3 * d2) - (b0 * f1) - (b1 * f2);
-	*fP2++ = c * (f0 + *fP0++);
-	--cnt0;
-	++kol; 
       }
     }
-  }
-  else
-  {
-    while(cnt0 > 0)
+    else
     {
-      iBO = kol >> 3;
-      iBS = kol & 7;
-      iBP1 = iP1 + iBO;
-      iBP2 = iP2 + iBO; 
-      if((iBS == 0) && ((*iBP1 & *iBP2) == 0xff) && (cnt0 >= 8))
+      /* First row of a column in the domain, so initialise the filter
+       * from this row's data. */
+      run = 1;
+      d0 = *dP0;
+      if(goingUp)
       {
-        cnt1 = 8;
-	while(cnt1-- > 0)
-	{
-	  *fP0++ = (a0 * *dP0++) + (a1 * *dP1++) -
-	  	   (b0 * *fP1++) - (b1 * *fP2++);
-	}
-	kol += 8;
-	cnt0 -= 8;
+	f0 = *fP0;
+	f1 = ((a2 * a3) * d0) / (b0 + b1 + 1);
+	*fP0 = (a2 * d0) + (a3 * d0) - (b0 * f1) - (b1 * f1);
+	*fP2 = c * (f0 + *fP0);
       }
       else
       {
-	d0 = *dP0;
-	iBM = 1 << iBS;
-	if(((*iBP1 & iBM) == 0) || ((*iBP2 & iBM) == 0))
-	{
-	  d1 = d0;
-	  f1 = f2 = ((a0 + a1) * d0) / (b0 + b1 + 1);
-	}
-	else
-	{
-	  d1 = *dP1;
-	  f1 = *fP1;
-	  f2 = *fP2;
-	}
-	++dP0;
-	++dP1;
-	++fP1;
-	++fP2;
-	*fP0++ = (a0 * d0) + (a1 * d1) - (b0 * f1) - (b1 * f2);
-	--cnt0;
-	++kol;
+	f1 = ((a0 + a1) * d0) / (b0 + b1 + 1);
+	*fP0 = (a0 * d0) + (a1 * d0) - (b0 * f1) - (b1 * f1);
       }
     }
+    dP0 += run;
+    dP1 += run;
+    dP2 += run;
+    fP0 += run;
+    fP1 += run;
+    fP2 += run;
+    kol += run;
+    cnt -= run;
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValueFilters
+* \brief	Filters a single interval using a vertical IIR filter
+*               defined by the filter coefficients and double precision
+*               arithmetic.
+* \note         See the double precision horizontal function for
+*               simple code.
+* \param	ftr			The filter.
+* \param	wrkBuf			Working buffer.
+* \param	srcBuf			Source buffer.
+* \param	itvBuf			Within interval bit buffer.
+* \param	bufPos			Position within the buffer.
+* \param	itvLen			Interval length.
+* \param	goingUp			Non-zero if going up through
+*                                       the lines (ie raster direction
+*                                       is WLZ_RASTERDIR_DLIC).
+*/
+static void	WlzRsvFilterFilterBufYF(WlzRsvFilter *ftr,
+				      double **wrkBuf, double **srcBuf,
+				      WlzUByte **itvBuf,
+				      WlzIVertex2 bufPos, int itvLen,
+				      int goingUp)
+{
+  int		kol,
+  		idL0,
+		idL1,
+		idL2;
+
+  if(goingUp)
+  {
+    idL0 = (bufPos.vtY + 3 + 0) % 3;
+    idL1 = (bufPos.vtY + 3 + 1) % 3;
+    idL2 = (bufPos.vtY + 3 + 2) % 3;
+  }
+  else
+  {
+    idL0 = (bufPos.vtY + 3 - 0) % 3;
+    idL1 = (bufPos.vtY + 3 - 1) % 3;
+    idL2 = (bufPos.vtY + 3 - 2) % 3;
   }
+  kol = bufPos.vtX;
+  WlzRsvFilterFilterItvF(ftr,
+  			 *(srcBuf + idL0) + kol, *(srcBuf + idL1) + kol,
+			 *(srcBuf + idL2) + kol,
+			 *(wrkBuf + idL0) + kol, *(wrkBuf + idL1) + kol,
+			 *(wrkBuf + idL2) + kol,
+			 *(itvBuf + idL1), *(itvBuf + idL2),
+			 kol, itvLen, goingUp);
 }
 
 /*!
@@ -709,165 +772,100 @@ static void	WlzRsvFilterFilterBufZF(WlzRsvFilter *ftr,
 					int itvLen,
 					int goingUp)
 {
-  int		cnt0,
-		cnt1,
-		kol,
+  int		kol,
 		lin,
-		iBM,
-		iBO,
-		iBS,
   		idP0,
 		idP1,
 		idP2;
-  double	a0,
-  		a1,
-		a2,
-		a3,
-		b0,
-		b1,
-		c,
-		d0,
-		d1,
-		d2,
-		f0,
-		f1,
-		f2;
-  WlzUByte	*iBP1,
-  		*iBP2,
-  		*iP1,
-  		*iP2;
-  double	*dP0,
-  		*dP1,
-		*dP2,
-		*fP0,
-		*fP1,
-		*fP2;
 
   if(goingUp)
   {
     idP0 = (bufPos.vtZ + 3 + 0) % 3;
     idP1 = (bufPos.vtZ + 3 + 1) % 3;
     idP2 = (bufPos.vtZ + 3 + 2) % 3;
-    a2 = ftr->a[2];
-    a3 = ftr->a[3];
   }
   else
   {
     idP0 = (bufPos.vtZ + 3 - 0) % 3;
     idP1 = (bufPos.vtZ + 3 - 1) % 3;
     idP2 = (bufPos.vtZ + 3 - 2) % 3;
-    a0 = ftr->a[0];
-    a1 = ftr->a[1];
   }
-  b0 = ftr->b[0];
-  b1 = ftr->b[1];
-  c = ftr->c;
   kol = bufPos.vtX;
   lin = bufPos.vtY;
-  iP1 = *(*(itvBuf + idP1) + lin);
-  iP2 = *(*(itvBuf + idP2) + lin);
-  dP0 = *(*(srcBuf + idP0) + lin) + kol;
-  fP0 = *(*(wrkBuf + idP0) + lin) + kol;
-  dP1 = *(*(srcBuf + idP1) + lin) + kol;
-  fP1 = *(*(wrkBuf + idP1) + lin) + kol;
-  dP2 = *(*(srcBuf + idP2) + lin) + kol;
-  fP2 = *(*(wrkBuf + idP2) + lin) + kol;
-  cnt0 = itvLen;
-  if(goingUp)
+  WlzRsvFilterFilterItvF(ftr,
+  			 *(*(srcBuf + idP0) + lin) + kol,
+			 *(*(srcBuf + idP1) + lin) + kol,
+			 *(*(srcBuf + idP2) + lin) + kol,
+  			 *(*(wrkBuf + idP0) + lin) + kol,
+			 *(*(wrkBuf + idP1) + lin) + kol,
+			 *(*(wrkBuf + idP2) + lin) + kol,
+			 *(*(itvBuf + idP1) + lin), *(*(itvBuf + idP2) + lin),
+			 kol, itvLen, goingUp);
+}
+
+/*!
+* \return	Grey type for the filtered object.
+* \ingroup	WlzValueFilters
+* \brief	Finds the grey type of a filtered object given the grey
+* 		type of the object being filtered. Unsigned byte values
+* 		are promoted to short.
+* \param	srcGType		Grey type of the given object.
+* \param	dstErr			Destination error pointer, may
+*                                       be null.
+*/
+static WlzGreyType WlzRsvFilterDstGreyType(WlzGreyType srcGType,
+					   WlzErrorNum *dstErr)
+{
+  WlzGreyType	dstGType = WLZ_GREY_ERROR;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  switch(srcGType)
+  {
+    /* Promote grey type for destination object. */
+    case WLZ_GREY_UBYTE: /* FALLTHROUGH */
+    case WLZ_GREY_SHORT:
+      dstGType = WLZ_GREY_SHORT;
+      break;
+    case WLZ_GREY_INT:
+      dstGType = WLZ_GREY_INT;
+      break;
+    case WLZ_GREY_FLOAT:
+      dstGType = WLZ_GREY_FLOAT;
+      break;
+    case WLZ_GREY_DOUBLE:
+      dstGType = WLZ_GREY_DOUBLE;
+      break;
+    case WLZ_GREY_RGBA: /* RGBA to be done RAB */
+    default:
+      errNum = WLZ_ERR_GREY_TYPE;
+      break;
+  }
+  if(dstErr)
   {
-    while(cnt0 > 0)
-    {
-      iBO = kol >> 3;
-      iBS = kol & 7;
-      iBP1 = iP1 + iBO;
-      iBP2 = iP2 + iBO;
-      if((iBS == 0) && ((*iBP1 & *iBP2) == 0xff) && (cnt0 >= 8))
-      {
-	cnt1 = 8;
-	while(cnt1-- > 0)
-	{
-	  f0 = *fP0;
-	  *fP0 = (a2 * *dP1++) + (a3 * *dP2++) - (b0 * *fP1++) - (b1 * *fP2);
-	  *fP2++ = c * (f0 + *fP0++);
-	}
-	kol += 8;
-	cnt0 -= 8;
-      }
-      else
-      {
-	d0 = *dP0;
-	f0 = *fP0;
-	iBM = 1 << iBS;
-	if(((*iBP1 & iBM) == 0) || ((*iBP2 & iBM) == 0))
-	{
-	  d1 = d0;
-	  d2 = d0;
-	  f1 = ((a2 * a3) * d0) / (b0 + b1 + 1);
-	  f2 = ((a2 * a3) * d2) / (b0 + b1 + 1);
-	}
-	else
-	{
-	  f1 = *fP1;
-	  f2 = *fP2;
-	  d1 = *dP1;
-	  d2 = *dP2;
-	}
-	++dP0;
-	++dP1;
-	++dP2;
-	++fP1;
-	*fP0 = (a2 * d1) + (a3 * d2) - (b0 * f1) - (b1 * f2);
-	*fP2++ = c * (f0 + *fP0++);
-	--cnt0;
-	++kol; 
-      }
-    }
+    *dstErr = errNum;
   }
-  else
+  return(dstGType);
+}
+
+/*!
+* \return	Number of threads available for filtering.
+* \ingroup	WlzValueFilters
+* \brief	Finds the number of threads which may be used to filter
+* 		an object. This is one if already within a parallel
+* 		region, so that the planes of a 3D object may be
+* 		filtered in parallel without nesting.
+*/
+static int	WlzRsvFilterNThreads(void)
+{
+  int		nThr = 1;
+
+#ifdef _OPENMP
+  if(!omp_in_parallel())
   {
-    while(cnt0 > 0)
-    {
-      iBO = kol >> 3;
-      iBS = kol & 7;
-      iBP1 = iP1 + iBO;
-      iBP2 = iP2 + iBO; 
-      if((iBS == 0) && ((*iBP1 & *iBP2) == 0xff) && (cnt0 >= 8))
-      {
-        cnt1 = 8;
-	while(cnt1-- > 0)
-	{
-	  *fP0++ = (a0 * *dP0++) + (a1 * *dP1++) -
-	  	   (b0 * *fP1++) - (b1 * *fP2++);
-	}
-	kol += 8;
-	cnt0 -= 8;
-      }
-      else
-      {
-	d0 = *dP0;
-	iBM = 1 << iBS;
-	if(((*iBP1 & iBM) == 0) || ((*iBP2 & iBM) == 0))
-	{
-	  d1 = d0;
-	  f1 = ((a0 + a1) * d0) / (b0 + b1 + 1);
-	  f2 = ((a0 + a1) * d0) / (b0 + b1 + 1);
-	}
-	else
-	{
-	  d1 = *dP1;
-	  f1 = *fP1;
-	  f2 = *fP2;
-	}
-	++dP0;
-	++dP1;
-	++fP1;
-	++fP2;
-	*fP0++ = (a0 * d0) + (a1 * d1) - (b0 * f1) - (b1 * f2);
-	--cnt0;
-	++kol;
-      }
-    }
+    nThr = omp_get_max_threads();
   }
+#endif
+  return(nThr);
 }
 
 /*!
@@ -877,6 +875,9 @@ static void	WlzRsvFilterFilterBufZF(WlzRsvFilter *ftr,
 *               2D domain object with grey values using either double
 *               precision floating point arithmetic or fixed
 *               point arithmetic.
+*               The lines are filtered independently, so the object
+*               is split into parts (see WlzMakeIntervalScanParts())
+*               which are filtered in parallel.
 *               It is assumed that the object type has already been
 *               checked, the domain and values are non-null.
 * \param	srcObj			Given 2D domain object.
@@ -887,25 +888,16 @@ static void	WlzRsvFilterFilterBufZF(WlzRsvFilter *ftr,
 static WlzObject *WlzRsvFilterObj2DX(WlzObject *srcObj, WlzRsvFilter *ftr,
 				     WlzErrorNum *dstErr)
 {
-  int		bufSz,
-		bufSpace,
-		itvLen;
-  WlzGreyType	bufType,
-  		srcGType,
+  int		idP,
+  		nParts = 0;
+  WlzGreyType	srcGType,
   		dstGType;
   WlzObjectType	vType;
-  WlzGreyP	bufGP;
   WlzPixelV	bgdPix;
   WlzDomain	srcDom;
   WlzValues	dstVal;
   WlzObject	*dstObj = NULL;
-  void		*lnBuf0 = NULL,
-  		*lnBuf1 = NULL,
-  		*datBuf = NULL;
-  WlzIntervalWSpace srcIWSp,
-  		dstIWSp;
-  WlzGreyWSpace srcGWSp,
-  		dstGWSp;
+  WlzIntervalScanPart *parts = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   /* Gather information about the source object. */
@@ -920,27 +912,7 @@ static WlzObject *WlzRsvFilterObj2DX(WlzObject *srcObj, WlzRsvFilter *ftr,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    switch(srcGType)
-    {
-      /* Promote grey type for destination object. */
-      case WLZ_GREY_UBYTE: /* FALLTHROUGH */
-      case WLZ_GREY_SHORT:
-        dstGType = WLZ_GREY_SHORT;
-	break;
-      case WLZ_GREY_INT:
-	dstGType = WLZ_GREY_INT;
-        break;
-      case WLZ_GREY_FLOAT:
-        dstGType = WLZ_GREY_FLOAT;
-	break;
-      case WLZ_GREY_DOUBLE:
-        dstGType = WLZ_GREY_DOUBLE;
-	break;
-      case WLZ_GREY_RGBA: /* RGBA to be done RAB */
-      default:
-        errNum = WLZ_ERR_GREY_TYPE;
-	break;
-    }
+    dstGType = WlzRsvFilterDstGreyType(srcGType, &errNum);
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -961,66 +933,41 @@ static WlzObject *WlzRsvFilterObj2DX(WlzObject *srcObj, WlzRsvFilter *ftr,
     dstObj= WlzMakeMain(srcObj->type, srcDom, dstVal, srcObj->plist,
 			NULL, &errNum);
   }
-  /* Make the working buffers. */
   if(errNum == WLZ_ERR_NONE)
   {
-    bufSz = srcDom.i->lastkl - srcDom.i->kol1 + 1;
-    bufSpace = sizeof(double) * bufSz;
-    if(((datBuf = AlcMalloc(bufSpace)) == NULL) ||
-       ((lnBuf0 = AlcMalloc(bufSpace)) == NULL) ||
-       ((lnBuf1 = AlcMalloc(bufSpace)) ==  NULL))
-    {
-      errNum = WLZ_ERR_MEM_ALLOC;
-    }
+    parts = WlzMakeIntervalScanParts(srcObj,
+    				     (WlzRsvFilterNThreads() > 1)? 0: 1,
+				     &nParts, &errNum);
   }
-  /* Work down through the object from the first line to last. */
+  /* Filter the parts of the object. */
   if(errNum == WLZ_ERR_NONE)
   {
-    bufType = WLZ_GREY_DOUBLE;
-    bufGP.dbp = (double *)datBuf;
-    if(((errNum = WlzInitGreyRasterScan(srcObj, &srcIWSp, &srcGWSp,
-    					WLZ_RASTERDIR_ILIC,
-					0)) == WLZ_ERR_NONE) &&
-       ((errNum = WlzInitGreyRasterScan(dstObj, &dstIWSp, &dstGWSp,
-       					WLZ_RASTERDIR_ILIC,
-					0)) == WLZ_ERR_NONE))
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idP = 0; idP < nParts; ++idP)
     {
-      while((errNum == WLZ_ERR_NONE) &&
-            ((errNum = WlzNextGreyInterval(&srcIWSp)) == WLZ_ERR_NONE) &&
-	    ((errNum = WlzNextGreyInterval(&dstIWSp)) == WLZ_ERR_NONE))
+      if(errNum == WLZ_ERR_NONE)
       {
-	/* Copy interval to working buffer. */
-	itvLen = srcIWSp.rgtpos - srcIWSp.lftpos + 1;
-	WlzValueCopyGreyToGrey(bufGP, 0, bufType,
-			       srcGWSp.u_grintptr, 0, srcGWSp.pixeltype,
-			       itvLen);
-	/* Apply filter. */
-	WlzRsvFilterFilterBufXF(ftr, (double *)datBuf,
-			        (double *)lnBuf0, (double *)lnBuf1,
-				itvLen);
-	/* Clamp data from buffer into the dst interval. */
-	WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0, dstGWSp.pixeltype,
-			          bufGP, 0, bufType, itvLen);
+	WlzErrorNum errNum2;
+
+	errNum2 = WlzRsvFilterObj2DXPart(srcObj, dstObj, ftr, parts + idP);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzRsvFilterObj2DX)
+#endif
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+	}
       }
     }
-    if(errNum == WLZ_ERR_EOO)
-    {
-      errNum = WLZ_ERR_NONE;
-    }
-  }
-  /* Free buffers. */
-  if(datBuf)
-  {
-    AlcFree(datBuf);
-  }
-  if(lnBuf0)
-  {
-    AlcFree(lnBuf0);
-  }
-  if(lnBuf1)
-  {
-    AlcFree(lnBuf1);
   }
+  AlcFree(parts);
   if(errNum != WLZ_ERR_NONE)
   {
     if(dstObj)
@@ -1037,49 +984,118 @@ static WlzObject *WlzRsvFilterObj2DX(WlzObject *srcObj, WlzRsvFilter *ftr,
 }
 
 /*!
-* \return	The filtered object, or NULL on error.
+* \return	Woolz error code.
 * \ingroup	WlzValueFilters
-* \brief	Applies a recursive filter through the rows and columns
-*               of the given 2D domain object with grey values using
-*               either double precision floating point arithmetic or
-*               fixed point arithmetic.
-*               It is assumed that the object type has already been
-*               checked, the domain and values are non-null.
+* \brief	Applies a recursive filter along the lines of a single
+* 		part of a 2D domain object, writing the filtered values
+* 		into the destination object.
 * \param	srcObj			Given 2D domain object.
+* \param	dstObj			Destination object which has the
+* 					same domain as the given object.
 * \param	ftr			Recursive filter.
-* \param	dstErr			Destination error pointer, may
-*                                       be null.
+* \param	part			The part of the object to filter.
 */
-static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
-			             WlzErrorNum *dstErr)
+static WlzErrorNum WlzRsvFilterObj2DXPart(WlzObject *srcObj,
+				          WlzObject *dstObj,
+					  WlzRsvFilter *ftr,
+					  WlzIntervalScanPart *part)
 {
-  int		idD,
-  		idN,
-		bufLnIdx,
-		dstLnIdx,
-  		itvLen,
-		itvBufWidth;
-  WlzRasterDir	rasDir;
-  WlzGreyType	bufType,
-  		srcGType,
+  int		bufSz,
+		bufSpace,
+		itvLen;
+  WlzGreyType	bufType;
+  WlzGreyP	bufGP;
+  double	*lnBuf0 = NULL,
+  		*lnBuf1 = NULL,
+		*datBuf = NULL;
+  WlzIntervalWSpace srcIWSp,
+  		dstIWSp;
+  WlzGreyWSpace srcGWSp,
+  		dstGWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  /* Make the working buffers. */
+  bufSz = srcObj->domain.i->lastkl - srcObj->domain.i->kol1 + 1;
+  bufSpace = sizeof(double) * bufSz;
+  if(((datBuf = (double *)AlcMalloc(bufSpace)) == NULL) ||
+     ((lnBuf0 = (double *)AlcMalloc(bufSpace)) == NULL) ||
+     ((lnBuf1 = (double *)AlcMalloc(bufSpace)) ==  NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  /* Work down through the part from it's first line to it's last. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    bufType = WLZ_GREY_DOUBLE;
+    bufGP.dbp = datBuf;
+    if(((errNum = WlzInitGreyScanPart(srcObj, part, NULL,
+    				      &srcIWSp, &srcGWSp,
+    				      WLZ_RASTERDIR_ILIC, 0)) == WLZ_ERR_NONE) &&
+       ((errNum = WlzInitGreyScanPart(dstObj, part, NULL,
+       				      &dstIWSp, &dstGWSp,
+       				      WLZ_RASTERDIR_ILIC, 0)) == WLZ_ERR_NONE))
+    {
+      while((errNum == WLZ_ERR_NONE) &&
+            ((errNum = WlzNextGreyInterval(&srcIWSp)) == WLZ_ERR_NONE) &&
+	    ((errNum = WlzNextGreyInterval(&dstIWSp)) == WLZ_ERR_NONE))
+      {
+	/* Copy interval to working buffer. */
+	itvLen = srcIWSp.rgtpos - srcIWSp.lftpos + 1;
+	WlzValueCopyGreyToGrey(bufGP, 0, bufType,
+			       srcGWSp.u_grintptr, 0, srcGWSp.pixeltype,
+			       itvLen);
+	/* Apply filter. */
+	WlzRsvFilterFilterBufXF(ftr, datBuf, lnBuf0, lnBuf1, itvLen);
+	/* Clamp data from buffer into the dst interval. */
+	WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0, dstGWSp.pixeltype,
+			          bufGP, 0, bufType, itvLen);
+      }
+      (void )WlzEndGreyScan(&srcIWSp, &srcGWSp);
+      (void )WlzEndGreyScan(&dstIWSp, &dstGWSp);
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  AlcFree(datBuf);
+  AlcFree(lnBuf0);
+  AlcFree(lnBuf1);
+  return(errNum);
+}
+
+
+/*!
+* \return	The filtered object, or NULL on error.
+* \ingroup	WlzValueFilters
+* \brief	Applies a recursive filter through the rows and columns
+*               of the given 2D domain object with grey values using
+*               either double precision floating point arithmetic or
+*               fixed point arithmetic.
+*               The columns are filtered independently, so the
+*               columns of the object are split into blocks which are
+*               filtered in parallel.
+*               It is assumed that the object type has already been
+*               checked, the domain and values are non-null.
+* \param	srcObj			Given 2D domain object.
+* \param	ftr			Recursive filter.
+* \param	dstErr			Destination error pointer, may
+*                                       be null.
+*/
+static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
+			             WlzErrorNum *dstErr)
+{
+  int		idB,
+  		nBlk,
+		blkSz,
+		width;
+  WlzGreyType	srcGType,
 		dstGType;
-  WlzIVertex2	bufPos,
-  		bufSz;
-  WlzGreyP	dstBufGP,
-  		srcBufGP,
-  		wrkBufGP;
   WlzObjectType	vType;
   WlzPixelV	bgdPix;
   WlzDomain	srcDom;
   WlzValues	dstVal;
   WlzObject	*dstObj = NULL;
-  void		**srcBuf = NULL,
-  		**wrkBuf = NULL;
-  WlzUByte	**itvBuf = NULL;
-  WlzIntervalWSpace srcIWSp,
-  		dstIWSp;
-  WlzGreyWSpace srcGWSp,
-  		dstGWSp;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   /* Gather information about the source object. */
@@ -1094,27 +1110,7 @@ static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    switch(srcGType)
-    {
-      /* Promote grey type for destination object. */
-      case WLZ_GREY_UBYTE: /* FALLTHROUGH */
-      case WLZ_GREY_SHORT:
-        dstGType = WLZ_GREY_SHORT;
-	break;
-      case WLZ_GREY_INT:
-	dstGType = WLZ_GREY_INT;
-        break;
-      case WLZ_GREY_FLOAT:
-        dstGType = WLZ_GREY_FLOAT;
-	break;
-      case WLZ_GREY_DOUBLE:
-        dstGType = WLZ_GREY_DOUBLE;
-	break;
-      case WLZ_GREY_RGBA: /* RGBA to be done RAB */
-      default:
-        errNum = WLZ_ERR_GREY_TYPE;
-	break;
-    }
+    dstGType = WlzRsvFilterDstGreyType(srcGType, &errNum);
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -1135,26 +1131,119 @@ static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
     dstObj= WlzMakeMain(srcObj->type, srcDom, dstVal, srcObj->plist,
 			NULL, &errNum);
   }
-  /* Make the buffers. */
+  /* Filter blocks of columns, each of which is a multiple of eight
+   * columns wide (except for the last) and with at least
+   * WLZ_RSVFILTER_BLK_MIN columns. */
   if(errNum == WLZ_ERR_NONE)
   {
-    bufSz.vtX = srcDom.i->lastkl - srcDom.i->kol1 + 1;
-    bufSz.vtY = 3;
-    if(AlcBit2Malloc(&itvBuf, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE)
+    width = srcDom.i->lastkl - srcDom.i->kol1 + 1;
+    nBlk = WlzRsvFilterNThreads();
+    if(nBlk * WLZ_RSVFILTER_BLK_MIN > width)
     {
-      errNum = WLZ_ERR_MEM_ALLOC;
+      nBlk = (width + WLZ_RSVFILTER_BLK_MIN - 1) / WLZ_RSVFILTER_BLK_MIN;
+    }
+    blkSz = (((width + nBlk - 1) / nBlk) + 7) & ~7;
+    nBlk = (width + blkSz - 1) / blkSz;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(idB = 0; idB < nBlk; ++idB)
+    {
+      if(errNum == WLZ_ERR_NONE)
+      {
+        int	kol0,
+		kol1;
+	WlzErrorNum errNum2;
+
+	kol0 = idB * blkSz;
+	kol1 = ALG_MIN(kol0 + blkSz, width) - 1;
+	errNum2 = WlzRsvFilterObj2DYBlk(srcObj, dstObj, ftr, kol0, kol1);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzRsvFilterObj2DY)
+#endif
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+	}
+      }
     }
   }
-  if(errNum == WLZ_ERR_NONE)
+  if(errNum != WLZ_ERR_NONE)
   {
-    bufType = WLZ_GREY_DOUBLE;
-    if((AlcDouble2Malloc((double ***)&srcBuf,
-			 bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc((double ***)&wrkBuf,
-			 bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
+    if(dstObj)
     {
-      errNum = WLZ_ERR_MEM_ALLOC;
+      (void )WlzFreeObj(dstObj);
     }
+    dstObj = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(dstObj);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValueFilters
+* \brief	Applies a recursive filter through the rows of a block
+* 		of columns of a 2D domain object, writing the filtered
+* 		values into the destination object. All the intervals
+* 		of the object are scanned but only those parts of them
+* 		which are within the block are filtered.
+* \param	srcObj			Given 2D domain object.
+* \param	dstObj			Destination object which has the
+* 					same domain as the given object.
+* \param	ftr			Recursive filter.
+* \param	blkKol0			First column of the block relative
+* 					to the first column of the object.
+* \param	blkKol1			Last column of the block relative
+* 					to the first column of the object.
+*/
+static WlzErrorNum WlzRsvFilterObj2DYBlk(WlzObject *srcObj,
+					 WlzObject *dstObj,
+					 WlzRsvFilter *ftr,
+					 int blkKol0, int blkKol1)
+{
+  int		idD,
+  		idN,
+		bufLnIdx,
+		dstLnIdx,
+		itvOff,
+  		itvLen,
+		itvBufWidth;
+  WlzRasterDir	rasDir;
+  WlzGreyType	bufType;
+  WlzIVertex2	bufPos,
+  		bufSz;
+  WlzGreyP	dstBufGP,
+  		srcBufGP,
+  		wrkBufGP;
+  WlzDomain	srcDom;
+  double	**srcBuf = NULL,
+  		**wrkBuf = NULL;
+  WlzUByte	**itvBuf = NULL;
+  WlzIntervalWSpace srcIWSp,
+  		dstIWSp;
+  WlzGreyWSpace srcGWSp,
+  		dstGWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  /* Make the buffers. */
+  srcDom = srcObj->domain;
+  bufSz.vtX = blkKol1 - blkKol0 + 1;
+  bufSz.vtY = 3;
+  bufType = WLZ_GREY_DOUBLE;
+  if((AlcBit2Malloc(&itvBuf, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&srcBuf, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&wrkBuf, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
   }
   /* Work down and then back up through the object. */
   if(errNum == WLZ_ERR_NONE)
@@ -1180,8 +1269,6 @@ static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
 	      ((errNum = WlzNextGreyInterval(&srcIWSp)) == WLZ_ERR_NONE) &&
 	      ((errNum = WlzNextGreyInterval(&dstIWSp)) == WLZ_ERR_NONE))
 	{
-	  itvLen = srcIWSp.rgtpos - srcIWSp.lftpos + 1;
-	  bufPos.vtX = srcIWSp.lftpos - srcDom.i->kol1;
 	  /* Process any lines between this and the last. */
 	  if(srcIWSp.nwlpos > 0)
 	  {
@@ -1194,35 +1281,40 @@ static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
 	    }
 	    dstLnIdx = (bufPos.vtY + 3 + ((idD)? 2: - 2)) % 3;
 	  }
+	  /* Find the part of the interval within this block. */
+	  bufPos.vtX = srcIWSp.lftpos - srcDom.i->kol1;
+	  itvOff = ALG_MAX(bufPos.vtX, blkKol0) - bufPos.vtX;
+	  itvLen = ALG_MIN(srcIWSp.rgtpos - srcDom.i->kol1, blkKol1) -
+	           (bufPos.vtX + itvOff) + 1;
+	  if(itvLen <= 0)
+	  {
+	    continue;
+	  }
+	  bufPos.vtX += itvOff - blkKol0;
 	  /* Copy interval to buffer. */
-	  srcBufGP.dbp = *((double **)srcBuf + bufLnIdx);
-	  wrkBufGP.dbp = *((double **)wrkBuf + bufLnIdx);
-	  dstBufGP.dbp = *((double **)wrkBuf + dstLnIdx);
+	  srcBufGP.dbp = *(srcBuf + bufLnIdx);
+	  wrkBufGP.dbp = *(wrkBuf + bufLnIdx);
+	  dstBufGP.dbp = *(wrkBuf + dstLnIdx);
 	  WlzBitLnSetItv(*(itvBuf + bufLnIdx),
 	  		 bufPos.vtX, bufPos.vtX + itvLen - 1, bufSz.vtX);
 	  WlzValueCopyGreyToGrey(srcBufGP, bufPos.vtX, bufType,
-				 srcGWSp.u_grintptr, 0, srcGWSp.pixeltype,
-				 itvLen);
+				 srcGWSp.u_grintptr, itvOff,
+				 srcGWSp.pixeltype, itvLen);
 	  if(rasDir == WLZ_RASTERDIR_DLIC)
 	  {
 	    WlzValueCopyGreyToGrey(wrkBufGP, bufPos.vtX, bufType,
-	    			   dstGWSp.u_grintptr, 0, dstGWSp.pixeltype,
-				   itvLen);
+	    			   dstGWSp.u_grintptr, itvOff,
+				   dstGWSp.pixeltype, itvLen);
 	  }
 	  /* Apply filter to this interval. */
-	  WlzRsvFilterFilterBufYF(ftr, (double **)wrkBuf, (double **)srcBuf,
+	  WlzRsvFilterFilterBufYF(ftr, wrkBuf, srcBuf,
 				itvBuf, bufPos, itvLen, idD);
 	  /* Clamp data buffer into the dst interval. */
-	  if(rasDir == WLZ_RASTERDIR_ILIC)
-	  {
-	    WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0, dstGWSp.pixeltype,
-				      wrkBufGP, bufPos.vtX, bufType, itvLen);
-	  }
-	  else
-	  {
-	    WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0, dstGWSp.pixeltype,
-				      dstBufGP, bufPos.vtX, bufType, itvLen);
-	  }
+	  WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, itvOff,
+	  			    dstGWSp.pixeltype,
+				    (rasDir == WLZ_RASTERDIR_ILIC)?
+				    wrkBufGP: dstBufGP,
+				    bufPos.vtX, bufType, itvLen);
 	}
       }
       if(errNum == WLZ_ERR_EOO)
@@ -1238,27 +1330,16 @@ static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
   }
   if(srcBuf)
   {
-    Alc2Free(srcBuf);
+    Alc2Free((void **)srcBuf);
   }
   if(wrkBuf)
   {
-    Alc2Free(wrkBuf);
-  }
-  if(errNum != WLZ_ERR_NONE)
-  {
-    if(dstObj)
-    {
-      (void )WlzFreeObj(dstObj);
-    }
-    dstObj = NULL;
-  }
-  if(dstErr)
-  {
-    *dstErr = errNum;
+    Alc2Free((void **)wrkBuf);
   }
-  return(dstObj);
+  return(errNum);
 }
 
+
 /*!
 * \return	The filtered object, or NULL on error.
 * \ingroup	WlzValueFilters
@@ -1266,7 +1347,8 @@ static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
 *               through the columns of the given 3D domain
 *               object with grey values using either double
 *               precision floating point arithmetic or fixed
-*               point arithmetic.
+*               point arithmetic. The planes are filtered in
+*               parallel.
 *               It is assumed that the object type has already been
 *               checked, the domain and values are non-null.
 * \param	srcObj			Given object.
@@ -1278,21 +1360,15 @@ static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
 static WlzObject *WlzRsvFilterObj3DXY(WlzObject *srcObj, WlzRsvFilter *ftr,
 			              int actionMsk, WlzErrorNum *dstErr)
 {
-  int		nPlanes;
-  WlzObject	*srcObj2D,
-  		*dstObj2D,
-		*dstObj = NULL;
-  WlzDomain 	*srcDom2D;
-  WlzValues	*srcVal2D,
-  		*dstVal2D;
+  int		idP,
+  		nPlanes;
+  WlzObject	*dstObj = NULL;
   WlzDomain	srcDom;
   WlzValues	dstVal;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   dstVal.core = NULL;
   srcDom = srcObj->domain;
-  srcDom2D = srcDom.p->domains;
-  srcVal2D = srcObj->values.vox->values;
   nPlanes = srcDom.p->lastpl - srcDom.p->plane1 + 1;
   dstVal.vox = WlzMakeVoxelValueTb(srcObj->values.vox->type,
 				   srcDom.p->plane1, srcDom.p->lastpl,
@@ -1300,43 +1376,50 @@ static WlzObject *WlzRsvFilterObj3DXY(WlzObject *srcObj, WlzRsvFilter *ftr,
 				   NULL, &errNum);
   if(errNum == WLZ_ERR_NONE)
   {
-    dstVal2D = dstVal.vox->values;
     dstObj = WlzMakeMain(srcObj->type, srcDom, dstVal, NULL, NULL, &errNum);
   }
-  while((errNum == WLZ_ERR_NONE) &&
-        (nPlanes-- > 0))
+  if(errNum == WLZ_ERR_NONE)
   {
-    srcObj2D = NULL;
-    dstObj2D = NULL;
-    if(srcDom2D->core)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idP = 0; idP < nPlanes; ++idP)
     {
-      dstObj2D = NULL;
-      srcObj2D = WlzAssignObject(
-      		 WlzMakeMain(WLZ_2D_DOMAINOBJ, *srcDom2D++, *srcVal2D++,
-			     NULL, NULL, &errNum), NULL);
-      if(errNum == WLZ_ERR_NONE)
-      {
-	dstObj2D = WlzAssignObject(
-		   WlzRsvFilterObj(srcObj2D, ftr, actionMsk, &errNum), NULL);
-      }
-      if(errNum == WLZ_ERR_NONE)
+      if((errNum == WLZ_ERR_NONE) && (srcDom.p->domains[idP].core != NULL))
       {
-	*dstVal2D = WlzAssignValues(dstObj2D->values, NULL);
-      }
-      if(srcObj2D)
-      {
-        WlzFreeObj(srcObj2D);
-      }
-      if(dstObj2D)
-      {
-        WlzFreeObj(dstObj2D);
+	WlzObject *srcObj2D,
+		  *dstObj2D = NULL;
+	WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+	srcObj2D = WlzAssignObject(
+		   WlzMakeMain(WLZ_2D_DOMAINOBJ, srcDom.p->domains[idP],
+			       srcObj->values.vox->values[idP],
+			       NULL, NULL, &errNum2), NULL);
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  dstObj2D = WlzAssignObject(
+		     WlzRsvFilterObj(srcObj2D, ftr, actionMsk, &errNum2), NULL);
+	}
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  dstVal.vox->values[idP] = WlzAssignValues(dstObj2D->values, NULL);
+	}
+	(void )WlzFreeObj(srcObj2D);
+	(void )WlzFreeObj(dstObj2D);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzRsvFilterObj3DXY)
+#endif
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+	}
       }
     }
-    else
-    {
-      dstVal2D->core = NULL;
-    }
-    ++dstVal2D;
   }
   if(errNum != WLZ_ERR_NONE)
   {
@@ -1348,6 +1431,7 @@ static WlzObject *WlzRsvFilterObj3DXY(WlzObject *srcObj, WlzRsvFilter *ftr,
     {
       WlzFreeVoxelValueTb(dstVal.vox);
     }
+    dstObj = NULL;
   }
   if(dstErr)
   {
@@ -1356,6 +1440,7 @@ static WlzObject *WlzRsvFilterObj3DXY(WlzObject *srcObj, WlzRsvFilter *ftr,
   return(dstObj);
 }
 
+
 /*!
 * \return	The filtered object, or NULL on error.
 * \ingroup	WlzValueFilters
@@ -1363,6 +1448,11 @@ static WlzObject *WlzRsvFilterObj3DXY(WlzObject *srcObj, WlzRsvFilter *ftr,
 *               given 3D domain object with grey values using either
 *               double precision floating point arithmetic or fixed
 *               point arithmetic.
+*               The voxel columns are filtered independently, so the
+*               lines of the object are split into bands which are
+*               filtered in parallel. The bands are small enough
+*               for their (three plane) working buffers to remain
+*               in cache while filtering through the planes.
 *               It is assumed that the object type has already been
 *               checked, the domain and values are non-null.
 * \param	srcObj			Given object.
@@ -1373,47 +1463,24 @@ static WlzObject *WlzRsvFilterObj3DXY(WlzObject *srcObj, WlzRsvFilter *ftr,
 static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
 				     WlzErrorNum *dstErr)
 {
-  int		tI0,
-  		idD,
-		idN,
+  int		idB,
   		idP,
-		itvLen,
-		dstPnIdx,
-		bufPlIdx,
+		nBand,
+		bandSz,
   		nPlanes,
-		itvBufArea;
-  WlzIVertex3	bufPos,
-  		bufSz;
+		nLines,
+		width;
   WlzDomain	srcDom;
-  WlzValues	tVal0,
-  		srcVal,
+  WlzValues	srcVal,
 		dstVal;
   WlzObjectType	dstValTbType2D;
   WlzGreyType	tmpGType,
-		bufType,
   		srcGType = WLZ_GREY_ERROR,
   		dstGType = WLZ_GREY_ERROR;
-  WlzGreyP	dstBufGP,
-  		srcBufGP,
-  		wrkBufGP;
-  void		***srcBuf = NULL,
-  		***wrkBuf = NULL;
-  void		**srcBuf2D,
-		**dstBuf2D,
-  		**wrkBuf2D;
-  WlzUByte	***itvBuf = NULL;
-  WlzUByte	**itvBuf2D;
   WlzDomain	*srcDom2D;
-  WlzValues	*srcVal2D,
-  		*dstVal2D;
-  WlzObject	*srcObj2D,
-  		*dstObj2D,
-		*dstObj = NULL;
+  WlzValues	*srcVal2D;
+  WlzObject	*dstObj = NULL;
   WlzPixelV	bgdPix;
-  WlzIntervalWSpace srcIWSp,
-  		dstIWSp;
-  WlzGreyWSpace srcGWSp,
-  		dstGWSp;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   dstVal.core = NULL;
@@ -1472,62 +1539,15 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
     }
     else
     {
-      /* Promote grey type for destination object. */
-      switch(srcGType)
-      {
-	case WLZ_GREY_UBYTE: /* FALLTHROUGH */
-	case WLZ_GREY_SHORT:
-	  dstGType = WLZ_GREY_SHORT;
-	  break;
-	case WLZ_GREY_INT:
-	  dstGType = WLZ_GREY_INT;
-	  break;
-	case WLZ_GREY_FLOAT:
-	  dstGType = WLZ_GREY_FLOAT;
-	  break;
-	case WLZ_GREY_DOUBLE:
-	  dstGType = WLZ_GREY_DOUBLE;
-	  break;
-        case WLZ_GREY_RGBA: /* RGBA to be done RAB */
-	default:
-	  errNum = WLZ_ERR_GREY_TYPE;
-	  break;
-      }
+      dstGType = WlzRsvFilterDstGreyType(srcGType, &errNum);
       if(errNum == WLZ_ERR_NONE)
       {
         dstValTbType2D = WlzGreyTableType(WLZ_GREY_TAB_RAGR, dstGType,
 					  &errNum);
 
       }
-      /* Make buffers. */
-      if(errNum == WLZ_ERR_NONE)
-      {
-	bufSz.vtX = srcDom.p->lastkl - srcDom.p->kol1 + 1;
-	bufSz.vtY = srcDom.p->lastln - srcDom.p->line1 + 1;
-	bufSz.vtZ = 3;
-	tI0 = (bufSz.vtX + 7) / 8;
-	itvBufArea = tI0 * bufSz.vtY;
-	if(AlcBit3Malloc(&itvBuf, bufSz.vtZ, bufSz.vtY,
-			 bufSz.vtX) != ALC_ER_NONE)
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
-      }
-      if(errNum == WLZ_ERR_NONE)
-      {
-	bufType = WLZ_GREY_DOUBLE;
-	if((AlcDouble3Malloc((double ****)&srcBuf,
-			     bufSz.vtZ, bufSz.vtY,
-			     bufSz.vtX) != ALC_ER_NONE) ||
-	   (AlcDouble3Malloc((double ****)&wrkBuf,
-			     bufSz.vtZ, bufSz.vtY,
-			     bufSz.vtX) != ALC_ER_NONE))
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
-      }
       /* Make destination object with it's own voxel value table but with a
-       * shared domain. The 2D values are created/added later. */
+       * shared domain. */
       if(errNum == WLZ_ERR_NONE)
       {
 	dstVal.vox = WlzMakeVoxelValueTb(WLZ_VOXELVALUETABLE_GREY,
@@ -1539,139 +1559,94 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
 	dstObj= WlzMakeMain(srcObj->type, srcDom, dstVal, srcObj->plist,
 			    NULL, &errNum);
       }
-      /* Work down and then back up through the object's planes. */
+      /* Make the destination object's 2D value tables, these are needed
+       * by all the bands. */
       if(errNum == WLZ_ERR_NONE)
       {
-	idD = 0;
-	while((errNum == WLZ_ERR_NONE) && (idD < 2))
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+	for(idP = 0; idP < nPlanes; ++idP)
 	{
-	  /* Initialise buffers. */
-	  for(idN = 0; idN < 3; ++idN)
-	  {
-	    WlzValueSetUByte(**(itvBuf + idN), 0, itvBufArea);
-	  }
-	  idP = 0;
-	  bufPos.vtZ = (idD == 0)? 0: nPlanes - 1;
-	  while((errNum == WLZ_ERR_NONE) && (idP < nPlanes))
+	  if((errNum == WLZ_ERR_NONE) &&
+	     (srcDom.p->domains[idP].core != NULL))
 	  {
-	    bufPlIdx = (bufPos.vtZ + 3 + 0) % 3;
-	    dstPnIdx = (bufPos.vtZ + 3 + 2) % 3;
-	    srcDom2D = srcDom.p->domains + bufPos.vtZ;
-	    srcVal2D = srcVal.vox->values + bufPos.vtZ;
-	    dstVal2D = dstVal.vox->values + bufPos.vtZ;
-	    itvBuf2D = *(itvBuf + bufPlIdx);
-	    srcBuf2D = *(srcBuf + bufPlIdx); 
-	    wrkBuf2D = *(wrkBuf + bufPlIdx);
-	    dstBuf2D = *(wrkBuf + dstPnIdx);
-	    /* Clear this plane's interval buffer bit mask. */
-	    WlzValueSetUByte(*itvBuf2D, 0, itvBufArea);
-	    /* Process non-empty planes. */
-	    if(srcDom2D->core)
+	    WlzObject	*srcObj2D;
+	    WlzValues	tVal;
+	    WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+
+	    srcObj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, srcDom.p->domains[idP],
+				   srcVal.vox->values[idP], NULL, NULL,
+				   &errNum2);
+	    if(errNum2 == WLZ_ERR_NONE)
 	    {
-	      /* Make a 2D object from current source plane. */
-	      srcObj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, *srcDom2D, *srcVal2D,
-				     NULL, NULL, &errNum);
-	      if((errNum == WLZ_ERR_NONE) && (idD == 0))
+	      tVal.v = WlzNewValueTb(srcObj2D, dstValTbType2D, bgdPix,
+	      			     &errNum2);
+	    }
+	    if(errNum2 == WLZ_ERR_NONE)
+	    {
+	      dstVal.vox->values[idP] = WlzAssignValues(tVal, NULL);
+	    }
+	    (void )WlzFreeObj(srcObj2D);
+	    if(errNum2 != WLZ_ERR_NONE)
+	    {
+#ifdef _OPENMP
+#pragma omp critical (WlzRsvFilterObj3DZ)
+#endif
 	      {
-		/* If first pass through object (going down through planes)
-		 * then make a new 2D value table. */
-		tVal0.v  = WlzNewValueTb(srcObj2D, dstValTbType2D,
-					 bgdPix, &errNum);
 		if(errNum == WLZ_ERR_NONE)
 		{
-		  *dstVal2D = WlzAssignValues(tVal0, NULL);
+		  errNum = errNum2;
 		}
 	      }
-	      /* Make a 2D object from destination plane. */
-	      dstObj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, *srcDom2D, *dstVal2D,
-				     NULL, NULL, &errNum);
-	      /* Process each interval of this plane. */
-	      if(((errNum = WlzInitGreyScan(srcObj2D, &srcIWSp,
-	      				    &srcGWSp)) == WLZ_ERR_NONE) &&
-	         ((errNum = WlzInitGreyScan(dstObj2D, &dstIWSp,
-	      				    &dstGWSp)) == WLZ_ERR_NONE))
+	    }
+	  }
+	}
+      }
+      /* Filter through the planes in bands of lines. */
+      if(errNum == WLZ_ERR_NONE)
+      {
+	width = srcDom.p->lastkl - srcDom.p->kol1 + 1;
+	nLines = srcDom.p->lastln - srcDom.p->line1 + 1;
+	bandSz = ALG_MAX(1, WLZ_RSVFILTER_BAND_BYTES /
+			    (6 * sizeof(double) * width));
+	nBand = WlzRsvFilterNThreads();
+	if(nBand > 1)
+	{
+	  bandSz = ALG_MIN(bandSz, (nLines + (4 * nBand) - 1) / (4 * nBand));
+	}
+	nBand = (nLines + bandSz - 1) / bandSz;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+	for(idB = 0; idB < nBand; ++idB)
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    int		lin0,
+	    		lin1;
+	    WlzErrorNum	errNum2;
+
+	    lin0 = srcDom.p->line1 + (idB * bandSz);
+	    lin1 = ALG_MIN(lin0 + bandSz - 1, srcDom.p->lastln);
+	    errNum2 = WlzRsvFilterObj3DZBand(srcObj, dstObj, ftr, lin0, lin1);
+	    if(errNum2 != WLZ_ERR_NONE)
+	    {
+#ifdef _OPENMP
+#pragma omp critical (WlzRsvFilterObj3DZ)
+#endif
 	      {
-		while((errNum == WLZ_ERR_NONE) &&
-		      ((errNum = WlzNextGreyInterval(
-		      			&srcIWSp)) == WLZ_ERR_NONE) &&
-		      ((errNum = WlzNextGreyInterval(
-		      			&dstIWSp)) == WLZ_ERR_NONE))
-		{
-		  itvLen = srcIWSp.rgtpos - srcIWSp.lftpos + 1;
-		  bufPos.vtX = srcIWSp.lftpos - srcDom.p->kol1;
-		  bufPos.vtY = srcIWSp.linpos - srcDom.p->line1;
-		  /* Copy interval to buffer. */
-		  srcBufGP.dbp = *((double **)srcBuf2D + bufPos.vtY);
-		  wrkBufGP.dbp = *((double **)wrkBuf2D + bufPos.vtY);
-		  dstBufGP.dbp = *((double **)dstBuf2D + bufPos.vtY);
-		  WlzBitLnSetItv(*(itvBuf2D + bufPos.vtY),
-		  		 bufPos.vtX, bufPos.vtX + itvLen - 1,
-				 bufSz.vtX);
-		  WlzValueCopyGreyToGrey(srcBufGP, bufPos.vtX, bufType,
-		  			 srcGWSp.u_grintptr, 0,
-					 srcGWSp.pixeltype,
-					 itvLen);
-		  if(idD)
-		  {
-		    WlzValueCopyGreyToGrey(wrkBufGP, bufPos.vtX, bufType,
-					   dstGWSp.u_grintptr, 0,
-					   dstGWSp.pixeltype,
-					   itvLen);
-		  }
-		  /* Apply filter to this interval. */
-		  WlzRsvFilterFilterBufZF(ftr, (double ***)wrkBuf,
-					  (double ***)srcBuf, itvBuf,
-					  bufPos, itvLen, idD);
-		  /* Clamp data buffer back into the destination plane. */
-		  if(idD == 0)
-		  {
-		    WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0,
-					      dstGWSp.pixeltype,
-					      wrkBufGP, bufPos.vtX, bufType,
-					      itvLen);
-		  }
-		  else
-		  {
-		    WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0,
-					      dstGWSp.pixeltype,
-					      dstBufGP, bufPos.vtX, bufType,
-					      itvLen);
-		  }
-		}
-		if(errNum == WLZ_ERR_EOO)
+		if(errNum == WLZ_ERR_NONE)
 		{
-		  errNum = WLZ_ERR_NONE;
+		  errNum = errNum2;
 		}
 	      }
-	      if(srcObj2D)
-	      {
-	        WlzFreeObj(srcObj2D);
-	      }
-	      if(dstObj2D)
-	      {
-	        WlzFreeObj(dstObj2D);
-	      }
 	    }
-	    ++idP;
-	    bufPos.vtZ -= (idD * 2) - 1; /* ++ for idD == 0, -- for idD == 1 */
 	  }
-	  ++idD;
 	}
       }
     }
   }
-  if(itvBuf)
-  {
-    Alc3Free((void ***)itvBuf);
-  }
-  if(srcBuf)
-  {
-    Alc3Free(srcBuf);
-  }
-  if(wrkBuf)
-  {
-    Alc3Free(wrkBuf);
-  }
   if(errNum != WLZ_ERR_NONE)
   {
     if(dstObj)
@@ -1691,6 +1666,178 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
   return(dstObj);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValueFilters
+* \brief	Applies a recursive filter through the planes of a band
+* 		of lines of a 3D domain object, writing the filtered
+* 		values into the destination object.
+* \param	srcObj			Given 3D domain object.
+* \param	dstObj			Destination object which has the
+* 					same domain as the given object
+* 					and 2D value tables for all the
+* 					planes with a non-NULL domain.
+* \param	ftr			Recursive filter.
+* \param	bandLn0			First line of the band.
+* \param	bandLn1			Last line of the band.
+*/
+static WlzErrorNum WlzRsvFilterObj3DZBand(WlzObject *srcObj,
+					  WlzObject *dstObj,
+					  WlzRsvFilter *ftr,
+					  int bandLn0, int bandLn1)
+{
+  int		idD,
+		idN,
+  		idP,
+		itvLen,
+		dstPnIdx,
+		bufPlIdx,
+  		nPlanes,
+		itvBufArea;
+  WlzIVertex3	bufPos,
+  		bufSz;
+  WlzGreyType	bufType;
+  WlzGreyP	dstBufGP,
+  		srcBufGP,
+  		wrkBufGP;
+  WlzPlaneDomain *srcPDom;
+  WlzIntervalDomain *srcIDom;
+  double	***srcBuf = NULL,
+  		***wrkBuf = NULL;
+  double	**srcBuf2D,
+		**dstBuf2D,
+  		**wrkBuf2D;
+  WlzUByte	***itvBuf = NULL;
+  WlzUByte	**itvBuf2D;
+  WlzObject	srcObj2D,
+  		dstObj2D;
+  WlzIntervalScanPart part;
+  WlzIntervalWSpace srcIWSp,
+  		dstIWSp;
+  WlzGreyWSpace srcGWSp,
+  		dstGWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  /* Make buffers. */
+  srcPDom = srcObj->domain.p;
+  nPlanes = srcPDom->lastpl - srcPDom->plane1 + 1;
+  bufSz.vtX = srcPDom->lastkl - srcPDom->kol1 + 1;
+  bufSz.vtY = bandLn1 - bandLn0 + 1;
+  bufSz.vtZ = 3;
+  bufType = WLZ_GREY_DOUBLE;
+  itvBufArea = ((bufSz.vtX + 7) / 8) * bufSz.vtY;
+  if((AlcBit3Malloc(&itvBuf, bufSz.vtZ, bufSz.vtY,
+		    bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble3Malloc(&srcBuf, bufSz.vtZ, bufSz.vtY,
+		       bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble3Malloc(&wrkBuf, bufSz.vtZ, bufSz.vtY,
+		       bufSz.vtX) != ALC_ER_NONE))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  /* Work down and then back up through the object's planes. */
+  idD = 0;
+  while((errNum == WLZ_ERR_NONE) && (idD < 2))
+  {
+    /* Initialise buffers. */
+    for(idN = 0; idN < 3; ++idN)
+    {
+      WlzValueSetUByte(**(itvBuf + idN), 0, itvBufArea);
+    }
+    idP = 0;
+    bufPos.vtZ = (idD == 0)? 0: nPlanes - 1;
+    while((errNum == WLZ_ERR_NONE) && (idP < nPlanes))
+    {
+      bufPlIdx = (bufPos.vtZ + 3 + 0) % 3;
+      dstPnIdx = (bufPos.vtZ + 3 + 2) % 3;
+      itvBuf2D = *(itvBuf + bufPlIdx);
+      srcBuf2D = *(srcBuf + bufPlIdx); 
+      wrkBuf2D = *(wrkBuf + bufPlIdx);
+      dstBuf2D = *(wrkBuf + dstPnIdx);
+      /* Clear this plane's interval buffer bit mask. */
+      WlzValueSetUByte(*itvBuf2D, 0, itvBufArea);
+      /* Process the lines of the band in non-empty planes. */
+      srcIDom = srcPDom->domains[bufPos.vtZ].i;
+      if(srcIDom != NULL)
+      {
+        part.plane = srcPDom->plane1 + bufPos.vtZ;
+	part.line0 = ALG_MAX(bandLn0, srcIDom->line1);
+	part.line1 = ALG_MIN(bandLn1, srcIDom->lastln);
+	part.nItv = 0;
+      }
+      if((srcIDom != NULL) && (part.line0 <= part.line1))
+      {
+	if(((errNum = WlzInitGreyScanPart(srcObj, &part, &srcObj2D,
+					  &srcIWSp, &srcGWSp,
+					  WLZ_RASTERDIR_ILIC,
+					  0)) == WLZ_ERR_NONE) &&
+	   ((errNum = WlzInitGreyScanPart(dstObj, &part, &dstObj2D,
+					  &dstIWSp, &dstGWSp,
+					  WLZ_RASTERDIR_ILIC,
+					  0)) == WLZ_ERR_NONE))
+	{
+	  while((errNum == WLZ_ERR_NONE) &&
+		((errNum = WlzNextGreyInterval(&srcIWSp)) == WLZ_ERR_NONE) &&
+		((errNum = WlzNextGreyInterval(&dstIWSp)) == WLZ_ERR_NONE))
+	  {
+	    itvLen = srcIWSp.rgtpos - srcIWSp.lftpos + 1;
+	    bufPos.vtX = srcIWSp.lftpos - srcPDom->kol1;
+	    bufPos.vtY = srcIWSp.linpos - bandLn0;
+	    /* Copy interval to buffer. */
+	    srcBufGP.dbp = *(srcBuf2D + bufPos.vtY);
+	    wrkBufGP.dbp = *(wrkBuf2D + bufPos.vtY);
+	    dstBufGP.dbp = *(dstBuf2D + bufPos.vtY);
+	    WlzBitLnSetItv(*(itvBuf2D + bufPos.vtY),
+			   bufPos.vtX, bufPos.vtX + itvLen - 1,
+			   bufSz.vtX);
+	    WlzValueCopyGreyToGrey(srcBufGP, bufPos.vtX, bufType,
+				   srcGWSp.u_grintptr, 0,
+				   srcGWSp.pixeltype,
+				   itvLen);
+	    if(idD)
+	    {
+	      WlzValueCopyGreyToGrey(wrkBufGP, bufPos.vtX, bufType,
+				     dstGWSp.u_grintptr, 0,
+				     dstGWSp.pixeltype,
+				     itvLen);
+	    }
+	    /* Apply filter to this interval. */
+	    WlzRsvFilterFilterBufZF(ftr, wrkBuf, srcBuf, itvBuf,
+				    bufPos, itvLen, idD);
+	    /* Clamp data buffer back into the destination plane. */
+	    WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0,
+				      dstGWSp.pixeltype,
+				      (idD == 0)? wrkBufGP: dstBufGP,
+				      bufPos.vtX, bufType, itvLen);
+	  }
+	  (void )WlzEndGreyScan(&srcIWSp, &srcGWSp);
+	  (void )WlzEndGreyScan(&dstIWSp, &dstGWSp);
+	}
+	if(errNum == WLZ_ERR_EOO)
+	{
+	  errNum = WLZ_ERR_NONE;
+	}
+      }
+      ++idP;
+      bufPos.vtZ -= (idD * 2) - 1; /* ++ for idD == 0, -- for idD == 1 */
+    }
+    ++idD;
+  }
+  if(itvBuf)
+  {
+    Alc3Free((void ***)itvBuf);
+  }
+  if(srcBuf)
+  {
+    Alc3Free((void ***)srcBuf);
+  }
+  if(wrkBuf)
+  {
+    Alc3Free((void ***)wrkBuf);
+  }
+  return(errNum);
+}
+
 #ifdef WLZ_RSVFILTER_TEST_1D
 int		main(int argc, char *argv[])
 {
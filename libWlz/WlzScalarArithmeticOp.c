@@ -57,17 +57,29 @@ static WlzObject 		*WlzScalarMulAdd3D(
 				  WlzPixelV a,
 				  WlzGreyType rGType,
 				  WlzErrorNum *dstErr);
-static WlzErrorNum 		WlzScalarMulAddSet2D(
+static WlzErrorNum 		WlzScalarMulAddSet(
 				  WlzObject *rObj,
 				  WlzObject *iObj,
 				  double m,
 				  double a);
+static WlzErrorNum 		WlzScalarMulAddSetPart(
+				  WlzObject *rObj,
+				  WlzObject *iObj,
+				  WlzIntervalScanPart *part,
+				  int bufLen,
+				  double m,
+				  double a);
 static WlzErrorNum 		WlzGreyIncValuesInDomain2D(
 				  WlzObject *gObj,
 				  WlzObject *dObj);
 static WlzErrorNum 		WlzGreyIncValuesInDomain3D(
 				  WlzObject *gObj,
 				  WlzObject *dObj);
+static WlzErrorNum 		WlzGreyIncValuesSet(
+				  WlzObject *obj);
+static WlzErrorNum 		WlzGreyIncValuesPart(
+				  WlzObject *obj,
+				  WlzIntervalScanPart *part);
 
 /*!
 * \return	Woolz error code.
@@ -127,7 +139,10 @@ WlzErrorNum	WlzGreyIncValuesInDomain(WlzObject *gObj, WlzObject *dObj)
 * 		the domain of the second object. The domain of the first
 * 		object must cover that of the second.
 *		Because this is a static object it is assumed that the
-*		two 3D objects are known to be valid.
+*		two 3D objects are known to be valid. A temporary object
+*		is made with the domain of the second object and a voxel
+*		value table which shares the plane values of the first,
+*		its values are then incremented by WlzGreyIncValuesSet().
 * \param	gObj		First object.
 * \param	dObj		Second object.
 */
@@ -136,8 +151,11 @@ static WlzErrorNum WlzGreyIncValuesInDomain3D(WlzObject *gObj, WlzObject *dObj)
   WlzPlaneDomain *gPD,
   		 *dPD;
   WlzVoxelValues *gVV;
+  WlzValues	tVal;
+  WlzObject	*tObj = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
+  tVal.core = NULL;
   gPD = gObj->domain.p;
   gVV = gObj->values.vox;
   dPD = dObj->domain.p;
@@ -147,53 +165,34 @@ static WlzErrorNum WlzGreyIncValuesInDomain3D(WlzObject *gObj, WlzObject *dObj)
   }
   else
   {
-    int		p,
-		p0,
-		p1;
+    tVal.vox = WlzMakeVoxelValueTb(WLZ_VOXELVALUETABLE_GREY,
+    				   dPD->plane1, dPD->lastpl,
+				   gVV->bckgrnd, NULL, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		p;
 
-    p0 = ALG_MAX(dPD->plane1, gPD->plane1);
-    p1 = ALG_MIN(dPD->lastpl, gPD->lastpl);
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for(p = p0; p <= p1; ++p)
+    for(p = dPD->plane1; p <= dPD->lastpl; ++p)
     {
-      if(errNum == WLZ_ERR_NONE)
-      {
-	WlzDomain    *doms;
-	WlzValues    *vals;
-	WlzErrorNum  errNum2D = WLZ_ERR_NONE;
-
-	doms = dPD->domains + p - dPD->plane1;
-	vals = gVV->values + p - gPD->plane1;;
-	if(((*doms).core != NULL) && ((*vals).core != NULL))
-	{
-	  WlzObject    *obj2D = NULL;
-
-	  if((obj2D = WlzAssignObject(
-		      WlzMakeMain(WLZ_2D_DOMAINOBJ, *doms, *vals, NULL, NULL,
-		                  &errNum2D), NULL)) != NULL)
-	  {
-	    errNum2D = WlzGreyIncValues2D(obj2D);
-	    (void )WlzFreeObj(obj2D);
-	  }
-	    if(errNum2D != WLZ_ERR_NONE)
-	  {
-#ifdef _OPENMP
-#pragma omp critical
-	    {
-#endif
-	      if(errNum == WLZ_ERR_NONE)
-	      {
-		errNum = errNum2D;
-	      }
-#ifdef _OPENMP
-	    }
-#endif
-	  }
-	}
-      }
+      tVal.vox->values[p - dPD->plane1] =
+          WlzAssignValues(gVV->values[p - gPD->plane1], NULL);
     }
+    tObj = WlzAssignObject(
+	   WlzMakeMain(WLZ_3D_DOMAINOBJ, dObj->domain, tVal, NULL, NULL,
+	               &errNum), NULL);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzGreyIncValuesSet(tObj);
+  }
+  if(tObj)
+  {
+    (void )WlzFreeObj(tObj);
+  }
+  else if(tVal.core)
+  {
+    (void )WlzFreeVoxelValueTb(tVal.vox);
   }
   return(errNum);
 }
@@ -219,7 +218,7 @@ static WlzErrorNum WlzGreyIncValuesInDomain2D(WlzObject *gObj, WlzObject *dObj)
 	             &errNum), NULL);
   if(errNum == WLZ_ERR_NONE)
   {
-    errNum = WlzGreyIncValues2D(tObj);
+    errNum = WlzGreyIncValuesSet(tObj);
     (void )WlzFreeObj(tObj);
   }
   return(errNum);
@@ -233,11 +232,75 @@ static WlzErrorNum WlzGreyIncValuesInDomain2D(WlzObject *gObj, WlzObject *dObj)
 */
 WlzErrorNum 	WlzGreyIncValues2D(WlzObject *obj)
 {
+  return(WlzGreyIncValuesSet(obj));
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzArithmetic
+* \brief	Increments all values within the given 2D or 3D object.
+* 		The domain is partitioned using WlzMakeIntervalScanParts()
+* 		and the parts are incremented in parallel.
+* \param	obj		Given object.
+*/
+static WlzErrorNum WlzGreyIncValuesSet(WlzObject *obj)
+{
+  int		idP,
+  		nParts = 0;
+  WlzIntervalScanPart *parts = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  parts = WlzMakeIntervalScanParts(obj, 0, &nParts, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idP = 0; idP < nParts; ++idP)
+    {
+      if(errNum == WLZ_ERR_NONE)
+      {
+	WlzErrorNum errNum2;
+
+	errNum2 = WlzGreyIncValuesPart(obj, parts + idP);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzGreyIncValuesSet)
+#endif
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+	}
+      }
+    }
+  }
+  AlcFree(parts);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzArithmetic
+* \brief	Increments all values within a single part of the given
+* 		object, see WlzGreyIncValuesSet().
+* \param	obj		Given object from which the parts were
+* 				computed.
+* \param	part		Part to be incremented.
+*/
+static WlzErrorNum WlzGreyIncValuesPart(WlzObject *obj,
+				        WlzIntervalScanPart *part)
+{
+  WlzObject	obj2D;
   WlzGreyWSpace gWSp;
-  WlzIntervalWSpace iWSp;
+  WlzIntervalWSpace iWSp = {0};
   WlzErrorNum   errNum = WLZ_ERR_NONE;
 
-  errNum = WlzInitGreyScan(obj, &iWSp, &gWSp);
+  errNum = WlzInitGreyScanPart(obj, part, &obj2D, &iWSp, &gWSp,
+  			       WLZ_RASTERDIR_ILIC, 0);
   if(errNum == WLZ_ERR_NONE)
   {
     while((errNum == WLZ_ERR_NONE) &&
@@ -700,7 +763,7 @@ static WlzObject *WlzScalarMulAdd2D(WlzObject *iObj, WlzPixelV m, WlzPixelV a,
       case WLZ_GREY_DOUBLE:
 	WlzValueConvertPixel(&m, m, WLZ_GREY_DOUBLE);
 	WlzValueConvertPixel(&a, a, WLZ_GREY_DOUBLE);
-	errNum = WlzScalarMulAddSet2D(rObj, iObj, m.v.dbv, a.v.dbv);
+	errNum = WlzScalarMulAddSet(rObj, iObj, m.v.dbv, a.v.dbv);
 	break;
       default:
         errNum = WLZ_ERR_GREY_TYPE;
@@ -759,75 +822,27 @@ static WlzObject *WlzScalarMulAdd3D(WlzObject *iObj, WlzPixelV m, WlzPixelV a,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    int		idP,
-    		plMin,
-    		plMax;
-    WlzPlaneDomain *iPDom;
-    WlzVoxelValues *iVox,
-    		*rVox;
-
-    iPDom = iObj->domain.p;
-    iVox = iObj->values.vox;
-    rVox = rValues.vox;
-    plMin = iPDom->plane1;
-    plMax = iPDom->lastpl;
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for(idP = plMin; idP <= plMax; ++idP)
-    {
-      WlzErrorNum errNum2D = WLZ_ERR_NONE;
-
-      if(errNum == WLZ_ERR_NONE)
-      {
-	int	      idO;
-	WlzDomain *iDom2D;
-	WlzValues *iVal2D,
-		  *rVal2D;
-
-	idO = idP - iPDom->plane1;
-	iDom2D = iPDom->domains + idO;
-	iVal2D = iVox->values + idO;
-	rVal2D = rVox->values + idO;
-	if(((*iDom2D).core != NULL) && ((*iVal2D).core != NULL) &&
-	   ((*rVal2D).core != NULL))
-	{
-	  WlzObject *iObj2D = NULL,
-		    *rObj2D = NULL;
-	  
-	  if((iObj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, *iDom2D, *iVal2D,
-				   NULL, NULL, &errNum2D)) != NULL)
-	  {
-	    rObj2D = WlzScalarMulAdd2D(iObj2D, m, a, rGType, &errNum2D);
-	  }
-	  if(errNum2D == WLZ_ERR_NONE)
-	  {
-	    *rVal2D = WlzAssignValues(rObj2D->values, NULL);
-	  }
-	  (void )WlzFreeObj(iObj2D);
-	  (void )WlzFreeObj(rObj2D);
-	}
-      }
-      if(errNum2D != WLZ_ERR_NONE)
-      {
-#ifdef _OPENMP
-#pragma omp critical
-	{
-#endif
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    errNum = errNum2D;
-	  }
-#ifdef _OPENMP
-	}
-#endif
-      }
-    }
+    rObj = WlzMakeMain(WLZ_3D_DOMAINOBJ, iObj->domain, rValues,
+    		       iObj->plist, iObj->assoc, &errNum);
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    rObj = WlzMakeMain(WLZ_3D_DOMAINOBJ, iObj->domain, rValues,
-    		       iObj->plist, iObj->assoc, &errNum);
+    switch(rGType)
+    {
+      case WLZ_GREY_INT:   /* FALLTHROUGH */
+      case WLZ_GREY_SHORT: /* FALLTHROUGH */
+      case WLZ_GREY_UBYTE: /* FALLTHROUGH */
+      case WLZ_GREY_RGBA:  /* FALLTHROUGH */
+      case WLZ_GREY_FLOAT: /* FALLTHROUGH */
+      case WLZ_GREY_DOUBLE:
+	WlzValueConvertPixel(&m, m, WLZ_GREY_DOUBLE);
+	WlzValueConvertPixel(&a, a, WLZ_GREY_DOUBLE);
+	errNum = WlzScalarMulAddSet(rObj, iObj, m.v.dbv, a.v.dbv);
+	break;
+      default:
+        errNum = WLZ_ERR_GREY_TYPE;
+	break;
+    }
   }
   if(errNum != WLZ_ERR_NONE)
   {
@@ -853,144 +868,216 @@ static WlzObject *WlzScalarMulAdd3D(WlzObject *iObj, WlzPixelV m, WlzPixelV a,
 * \ingroup	WlzArithmetic
 * \brief	Sets the values of the return object from the input object
 * 		using simple linear scaling, see WlzScalarMulAdd(). The
-* 		objects are known to be 2D, have the same domain.
+* 		objects are known to be both 2D or both 3D and to have
+* 		the same domain.
+* 		The domain is partitioned using WlzMakeIntervalScanParts()
+* 		and the parts are set in parallel.
 * \param	rObj
 * \param	iObj
 * \param	m
 * \param	a
 */
-static WlzErrorNum WlzScalarMulAddSet2D(WlzObject *rObj, WlzObject *iObj,
+static WlzErrorNum WlzScalarMulAddSet(WlzObject *rObj, WlzObject *iObj,
 				     double m, double a)
 {
-  int		bufLen;
-  WlzGreyWSpace iGWSp,
-  		rGWSp;
-  WlzIntervalWSpace iIWSp = {0},
-  		    rIWSp = {0};
+  int		idP,
+  		bufLen,
+  		nParts = 0;
+  WlzIntervalScanPart *parts = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  bufLen = iObj->domain.i->lastkl - iObj->domain.i->kol1 + 1;
-  if((bufLen != iObj->domain.i->lastkl - iObj->domain.i->kol1 + 1) ||
-     (bufLen < 0))
+  if(iObj->type == WLZ_2D_DOMAINOBJ)
+  {
+    bufLen = iObj->domain.i->lastkl - iObj->domain.i->kol1 + 1;
+  }
+  else
+  {
+    bufLen = iObj->domain.p->lastkl - iObj->domain.p->kol1 + 1;
+  }
+  if(bufLen < 0)
   {
     errNum = WLZ_ERR_DOMAIN_DATA;
   }
   else if(bufLen > 0)
   {
+    parts = WlzMakeIntervalScanParts(iObj, 0, &nParts, &errNum);
     if(errNum == WLZ_ERR_NONE)
     {
-      errNum = WlzInitGreyScan(iObj, &iIWSp, &iGWSp);
-    }
-    if(errNum == WLZ_ERR_NONE)
-    {
-      errNum = WlzInitGreyScan(rObj, &rIWSp, &rGWSp);
-    }
-    if(errNum == WLZ_ERR_NONE)
-    {
-      double	*buf = NULL;
-
-      if((buf = AlcMalloc(sizeof(double) * bufLen)) == NULL)
-      {
-        errNum = WLZ_ERR_MEM_ALLOC;
-      }
-      else
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for(idP = 0; idP < nParts; ++idP)
       {
-	while((errNum = WlzNextGreyInterval(&iIWSp)) == WLZ_ERR_NONE)
+	if(errNum == WLZ_ERR_NONE)
 	{
-	  int	t,
-	  	idN,
-	  	itvLen;
-	  double f;
-
+	  WlzErrorNum errNum2;
 
-	  itvLen = iIWSp.colrmn;
-	  (void )WlzNextGreyInterval(&rIWSp);
-	  switch(iGWSp.pixeltype)
-	  {
-	    case WLZ_GREY_INT:
-	      WlzValueCopyIntToDouble(buf, iGWSp.u_grintptr.inp, itvLen);
-	      break;
-	    case WLZ_GREY_SHORT:
-	      WlzValueCopyShortToDouble(buf, iGWSp.u_grintptr.shp, itvLen);
-	      break;
-	    case WLZ_GREY_UBYTE:
-	      WlzValueCopyUByteToDouble(buf, iGWSp.u_grintptr.ubp, itvLen);
-	      break;
-	    case WLZ_GREY_FLOAT:
-	      WlzValueCopyFloatToDouble(buf, iGWSp.u_grintptr.flp, itvLen);
-	      break;
-	    case WLZ_GREY_DOUBLE:
-	      WlzValueCopyDoubleToDouble(buf, iGWSp.u_grintptr.dbp, itvLen);
-	      break;
-	    case WLZ_GREY_RGBA:
-	      WlzValueCopyRGBAToDouble(buf, iGWSp.u_grintptr.rgbp, itvLen);
-	      break;
-	    default:
-	      break;
-	  }
-	  switch(rGWSp.pixeltype)
+	  errNum2 = WlzScalarMulAddSetPart(rObj, iObj, parts + idP, bufLen,
+	                                   m, a);
+	  if(errNum2 != WLZ_ERR_NONE)
 	  {
-	    case WLZ_GREY_UBYTE:
-	      for(idN = 0; idN < itvLen; ++idN)
-	      {
-		f = (buf[idN] * m) + a;
-		f = WLZ_CLAMP(f, 0, 255);
-		rGWSp.u_grintptr.ubp[idN] = WLZ_NINT(f);
-	      }
-	      break;
-	    case WLZ_GREY_SHORT:
-	      for(idN = 0; idN < itvLen; ++idN)
-	      {
-		f = (buf[idN] * m) + a;
-		f = WLZ_CLAMP(f, SHRT_MIN, SHRT_MAX);
-		rGWSp.u_grintptr.shp[idN] = WLZ_NINT(f);
-	      }
-	      break;
-	    case WLZ_GREY_INT:
-	      for(idN = 0; idN < itvLen; ++idN)
+#ifdef _OPENMP
+#pragma omp critical (WlzScalarMulAddSet)
+#endif
+	    {
+	      if(errNum == WLZ_ERR_NONE)
 	      {
-		f = (buf[idN] * m) + a;
-		f = WLZ_CLAMP(f, INT_MIN, INT_MAX);
-		rGWSp.u_grintptr.inp[idN] = WLZ_NINT(f);
+		errNum = errNum2;
 	      }
-	      break;
-	    case WLZ_GREY_RGBA:
-	      for(idN = 0; idN < itvLen; ++idN)
-	      {
-		WlzUInt	u;
+	    }
+	  }
+	}
+      }
+    }
+    AlcFree(parts);
+  }
+  return(errNum);
+}
 
-		f = (buf[idN] * m) + a;
-		f = WLZ_CLAMP(f, 0, 255);
-		t = WLZ_NINT(f);
-                WLZ_RGBA_RGBA_SET(u, t, t, t, 255);
-		rGWSp.u_grintptr.inp[idN] = u;
-	      }
-	    case WLZ_GREY_FLOAT:
-	      for(idN = 0; idN < itvLen; ++idN)
-	      {
-		double	t;
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzArithmetic
+* \brief	Sets the values of the return object from the input object
+* 		within a single part of their common domain, see
+* 		WlzScalarMulAddSet().
+* \param	rObj			Return object.
+* \param	iObj			Input object from which the parts
+* 					were computed.
+* \param	part			Part to be set.
+* \param	bufLen			Length of the working buffer
+* 					required, which is the width of
+* 					the domain.
+* \param	m			Multiplier.
+* \param	a			Additive offset.
+*/
+static WlzErrorNum WlzScalarMulAddSetPart(WlzObject *rObj, WlzObject *iObj,
+				     WlzIntervalScanPart *part, int bufLen,
+				     double m, double a)
+{
+  double	*buf = NULL;
+  WlzObject	iObj2D,
+  		rObj2D;
+  WlzGreyWSpace iGWSp,
+  		rGWSp;
+  WlzIntervalWSpace iIWSp = {0},
+  		    rIWSp = {0};
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-		t = (buf[idN] * m) + a;
-		rGWSp.u_grintptr.flp[idN] = WLZ_CLAMP(t, -(FLT_MAX), FLT_MAX);
-	      }
-	      break;
-	    case WLZ_GREY_DOUBLE:
-	      for(idN = 0; idN < itvLen; ++idN)
-	      {
-		rGWSp.u_grintptr.dbp[idN] = (buf[idN] * m) + a;
-	      }
-	      break;
-	    default:
-	      break;
-	  }
+  errNum = WlzInitGreyScanPart(iObj, part, &iObj2D, &iIWSp, &iGWSp,
+  			       WLZ_RASTERDIR_ILIC, 0);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzInitGreyScanPart(rObj, part, &rObj2D, &rIWSp, &rGWSp,
+    				 WLZ_RASTERDIR_ILIC, 0);
+    if(errNum != WLZ_ERR_NONE)
+    {
+      (void )WlzEndGreyScan(&iIWSp, &iGWSp);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((buf = AlcMalloc(sizeof(double) * bufLen)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      while((errNum = WlzNextGreyInterval(&iIWSp)) == WLZ_ERR_NONE)
+      {
+	int	t,
+		idN,
+		itvLen;
+	double f;
+
+
+	itvLen = iIWSp.colrmn;
+	(void )WlzNextGreyInterval(&rIWSp);
+	switch(iGWSp.pixeltype)
+	{
+	  case WLZ_GREY_INT:
+	    WlzValueCopyIntToDouble(buf, iGWSp.u_grintptr.inp, itvLen);
+	    break;
+	  case WLZ_GREY_SHORT:
+	    WlzValueCopyShortToDouble(buf, iGWSp.u_grintptr.shp, itvLen);
+	    break;
+	  case WLZ_GREY_UBYTE:
+	    WlzValueCopyUByteToDouble(buf, iGWSp.u_grintptr.ubp, itvLen);
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    WlzValueCopyFloatToDouble(buf, iGWSp.u_grintptr.flp, itvLen);
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    WlzValueCopyDoubleToDouble(buf, iGWSp.u_grintptr.dbp, itvLen);
+	    break;
+	  case WLZ_GREY_RGBA:
+	    WlzValueCopyRGBAToDouble(buf, iGWSp.u_grintptr.rgbp, itvLen);
+	    break;
+	  default:
+	    break;
 	}
-	if(errNum == WLZ_ERR_EOO)
+	switch(rGWSp.pixeltype)
 	{
-	  errNum = WLZ_ERR_NONE;
+	  case WLZ_GREY_UBYTE:
+	    for(idN = 0; idN < itvLen; ++idN)
+	    {
+	      f = (buf[idN] * m) + a;
+	      f = WLZ_CLAMP(f, 0, 255);
+	      rGWSp.u_grintptr.ubp[idN] = WLZ_NINT(f);
+	    }
+	    break;
+	  case WLZ_GREY_SHORT:
+	    for(idN = 0; idN < itvLen; ++idN)
+	    {
+	      f = (buf[idN] * m) + a;
+	      f = WLZ_CLAMP(f, SHRT_MIN, SHRT_MAX);
+	      rGWSp.u_grintptr.shp[idN] = WLZ_NINT(f);
+	    }
+	    break;
+	  case WLZ_GREY_INT:
+	    for(idN = 0; idN < itvLen; ++idN)
+	    {
+	      f = (buf[idN] * m) + a;
+	      f = WLZ_CLAMP(f, INT_MIN, INT_MAX);
+	      rGWSp.u_grintptr.inp[idN] = WLZ_NINT(f);
+	    }
+	    break;
+	  case WLZ_GREY_RGBA:
+	    for(idN = 0; idN < itvLen; ++idN)
+	    {
+	      WlzUInt	u;
+
+	      f = (buf[idN] * m) + a;
+	      f = WLZ_CLAMP(f, 0, 255);
+	      t = WLZ_NINT(f);
+	      WLZ_RGBA_RGBA_SET(u, t, t, t, 255);
+	      rGWSp.u_grintptr.inp[idN] = u;
+	    }
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    for(idN = 0; idN < itvLen; ++idN)
+	    {
+	      double	t;
+
+	      t = (buf[idN] * m) + a;
+	      rGWSp.u_grintptr.flp[idN] = WLZ_CLAMP(t, -(FLT_MAX), FLT_MAX);
+	    }
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    for(idN = 0; idN < itvLen; ++idN)
+	    {
+	      rGWSp.u_grintptr.dbp[idN] = (buf[idN] * m) + a;
+	    }
+	    break;
+	  default:
+	    break;
 	}
       }
-      AlcFree(buf);
+      if(errNum == WLZ_ERR_EOO)
+      {
+	errNum = WLZ_ERR_NONE;
+      }
     }
+    AlcFree(buf);
     (void )WlzEndGreyScan(&iIWSp, &iGWSp);
     (void )WlzEndGreyScan(&rIWSp, &rGWSp);
   }
@@ -0,0 +1,542 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzSectionCache_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzSectionCache.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	A cache of sections cut from 3D objects, keyed on
+* 		quantised view parameters.
+* \ingroup	WlzSectionTransform
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <Wlz.h>
+
+/*!
+* \struct	_WlzSectionCacheEntry
+* \ingroup	WlzSectionTransform
+* \brief	Entry in a section cache which identifies a single
+* 		section by the object it was cut from, the quantised
+* 		view parameters and the interpolation. The view mode
+* 		dependent parameters and the voxel rescaling are not
+* 		quantised.
+*/
+typedef struct _WlzSectionCacheEntry
+{
+  WlzSectionCache *cache;		/*!< The cache holding the entry. */
+  WlzObject	*obj;			/*!< Object the section was cut
+  					     from. */
+  WlzObject	*sec;			/*!< The section. */
+  int		theta;			/*!< Quantised theta. */
+  int		phi;			/*!< Quantised phi. */
+  int		zeta;			/*!< Quantised zeta. */
+  int		dist;			/*!< Quantised distance. */
+  int		scale;			/*!< Quantised scale. */
+  WlzIVertex3	fixed;			/*!< Quantised fixed point. */
+  WlzThreeDViewMode viewMode;		/*!< View mode. */
+  WlzInterpolationType interp;		/*!< Interpolation. */
+  int		voxelRescaleFlg;	/*!< Voxel rescaling mode. */
+  double	voxelSize[3];		/*!< Voxel size. */
+  WlzDVertex3	up;			/*!< Up vector. */
+  WlzDVertex3	fixed2;			/*!< Second fixed point. */
+  double	fixedLineAngle;		/*!< Angle of fixed line. */
+} WlzSectionCacheEntry;
+
+static unsigned int		WlzSectionCacheKey(
+				  AlcLRUCache *lru,
+				  void *entry);
+static int			WlzSectionCacheCmp(
+				  const void *entry0,
+				  const void *entry1);
+static void			WlzSectionCacheUnlink(
+				  AlcLRUCache *lru,
+				  void *entry);
+static void			WlzSectionCacheEntrySet(
+				  WlzSectionCacheEntry *ent,
+				  WlzSectionCache *cache,
+				  WlzObject *obj,
+				  WlzThreeDViewStruct *view,
+				  WlzInterpolationType interp);
+static size_t			WlzSectionCacheSecSz(
+				  WlzObject *sec);
+
+/*!
+* \return	New section cache or NULL on error.
+* \ingroup	WlzSectionTransform
+* \brief	Allocates a new section cache for use with
+* 		WlzSectionCacheGet(). The cache limits the total
+* 		size of the sections that it holds, with the least
+* 		recently used sections being evicted as required.
+* 		Views are matched after quantising their angles,
+* 		distance, fixed point and scale using the given quanta,
+* 		so that views which differ by less than the quanta share
+* 		a section. The new cache has a link count of one for the
+* 		caller's reference, which should be released using
+* 		WlzFreeSectionCache().
+* \param	maxSec			Maximum number of cached sections.
+* \param	maxSz			Maximum total size (bytes) of the
+* 					cached sections.
+* \param	angQ			Quantum for the view angles theta,
+* 					phi and zeta (radians).
+* \param	distQ			Quantum for the view distance and
+* 					fixed point.
+* \param	scaleQ			Quantum for the view scale.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzSectionCache	*WlzMakeSectionCache(unsigned int maxSec, size_t maxSz,
+				double angQ, double distQ, double scaleQ,
+				WlzErrorNum *dstErr)
+{
+  WlzSectionCache *cache = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((maxSec == 0) || (maxSz == 0) ||
+     (angQ < DBL_EPSILON) || (distQ < DBL_EPSILON) || (scaleQ < DBL_EPSILON))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((cache = (WlzSectionCache *)
+                   AlcCalloc(1, sizeof(WlzSectionCache))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else if((cache->lru = AlcLRUCacheNew(maxSec, maxSz,
+  				       WlzSectionCacheKey,
+				       WlzSectionCacheCmp,
+				       WlzSectionCacheUnlink,
+				       NULL)) == NULL)
+  {
+    AlcFree(cache);
+    cache = NULL;
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    cache->linkcount = 1;
+    cache->angQ = angQ;
+    cache->distQ = distQ;
+    cache->scaleQ = scaleQ;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(cache);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzSectionTransform
+* \brief	Releases a reference to a section cache. When the last
+* 		reference is released all of the cached sections are
+* 		freed along with the cache.
+* \param	cache			Given cache.
+*/
+WlzErrorNum	WlzFreeSectionCache(WlzSectionCache *cache)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(cache == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(WlzUnlink(&(cache->linkcount), &errNum))
+  {
+    AlcLRUCacheFree(cache->lru, 1);
+    AlcFree(cache);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzSectionTransform
+* \brief	Removes all sections cut from the given object from the
+* 		cache. This should be called if the object's domain or
+* 		values are modified, since the cache only holds a
+* 		reference to the object and can not detect changes to
+* 		it. If the given object is NULL then all sections are
+* 		removed from the cache.
+* \param	cache			Given cache.
+* \param	obj			Given object, may be NULL.
+*/
+WlzErrorNum	WlzSectionCacheRemoveObj(WlzSectionCache *cache,
+				WlzObject *obj)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(cache == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+#ifdef _OPENMP
+#pragma omp critical (WlzSectionCache)
+#endif
+    {
+      AlcLRUCItem *item,
+		  *next;
+
+      item = cache->lru->rankHead;
+      while(item)
+      {
+	WlzSectionCacheEntry *ent;
+
+	next = item->rankNxt;
+	ent = (WlzSectionCacheEntry *)(item->entry);
+	if((obj == NULL) || (ent->obj == obj))
+	{
+	  AlcLRUCEntryRemoveWithKey(cache->lru, item->key, ent);
+	}
+	item = next;
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Section through the given object, or NULL on error.
+* \ingroup	WlzSectionTransform
+* \brief	Gets a section through the given object using the given
+* 		cache. If a section has already been cut from the object
+* 		with the same interpolation and a view which matches
+* 		the given view after quantisation then the cached section
+* 		is returned, otherwise a new section is cut and added to
+* 		the cache.
+* 		The angles, distance, fixed point and scale of the given
+* 		view are snapped to the quanta of the cache before the
+* 		section is cut, so the returned section is that for the
+* 		snapped view rather than the given view. The given view
+* 		need not have been initialised and is not modified.
+* 		The returned section is shared with the cache and has
+* 		already been assigned, so the caller must free it
+* 		using WlzFreeObj() and must not modify it. The cache also
+* 		holds a reference to the given object until the section
+* 		is evicted, see WlzSectionCacheRemoveObj().
+* 		If the cache is NULL the section is cut using the given
+* 		view (which must have been initialised) and assigned,
+* 		without quantisation.
+* 		This function is safe to call concurrently, but the
+* 		sections of concurrent misses are cut in parallel and
+* 		only the first of any duplicates is kept in the cache.
+* \param	cache			Given cache, may be NULL.
+* \param	obj			Given object.
+* \param	view			Given view.
+* \param	interp			Interpolation, should be either
+* 					WLZ_INTERPOLATION_NEAREST or
+* 					WLZ_INTERPOLATION_LINEAR.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzSectionCacheGet(WlzSectionCache *cache, WlzObject *obj,
+				WlzThreeDViewStruct *view,
+				WlzInterpolationType interp,
+				WlzErrorNum *dstErr)
+{
+  unsigned int	key;
+  WlzObject	*sec = NULL;
+  WlzSectionCacheEntry ent;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(obj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(view == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(view->type != WLZ_3D_VIEW_STRUCT)
+  {
+    errNum = WLZ_ERR_PARAM_TYPE;
+  }
+  else if(cache == NULL)
+  {
+    sec = WlzAssignObject(
+          WlzGetSectionFromObject(obj, view, interp, &errNum), NULL);
+  }
+  else
+  {
+    WlzSectionCacheEntry *found;
+
+    WlzSectionCacheEntrySet(&ent, cache, obj, view, interp);
+    key = WlzSectionCacheKey(cache->lru, &ent);
+#ifdef _OPENMP
+#pragma omp critical (WlzSectionCache)
+#endif
+    {
+      if((found = (WlzSectionCacheEntry *)
+                  AlcLRUCEntryGetWithKey(cache->lru, key, &ent)) != NULL)
+      {
+	++(cache->hits);
+        sec = WlzAssignObject(found->sec, NULL);
+      }
+      else
+      {
+        ++(cache->misses);
+      }
+    }
+    if(sec == NULL)
+    {
+      WlzThreeDViewStruct *qView;
+
+      /* Cut the section using a copy of the view with its parameters
+       * snapped to the quanta. */
+      qView = WlzMake3DViewStructCopy(view, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	qView->theta = ent.theta * cache->angQ;
+	qView->phi = ent.phi * cache->angQ;
+	qView->zeta = ent.zeta * cache->angQ;
+	qView->dist = ent.dist * cache->distQ;
+	qView->scale = ent.scale * cache->scaleQ;
+	qView->fixed.vtX = ent.fixed.vtX * cache->distQ;
+	qView->fixed.vtY = ent.fixed.vtY * cache->distQ;
+	qView->fixed.vtZ = ent.fixed.vtZ * cache->distQ;
+	errNum = WlzInit3DViewStruct(qView, obj);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  sec = WlzAssignObject(
+	        WlzGetSectionFromObject(obj, qView, interp, &errNum), NULL);
+	}
+	(void )WlzFree3DViewStruct(qView);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	size_t	  sz;
+        WlzSectionCacheEntry *newEnt;
+
+	sz = WlzSectionCacheSecSz(sec);
+	if((newEnt = (WlzSectionCacheEntry *)
+	             AlcMalloc(sizeof(WlzSectionCacheEntry))) != NULL)
+	{
+	  int	  newFlg = 0;
+	  AlcLRUCItem *item;
+	  WlzObject *dupSec = NULL;
+
+	  *newEnt = ent;
+	  newEnt->obj = WlzAssignObject(obj, NULL);
+	  newEnt->sec = WlzAssignObject(sec, NULL);
+#ifdef _OPENMP
+#pragma omp critical (WlzSectionCache)
+#endif
+	  {
+	    item = AlcLRUCEntryAddWithKey(cache->lru, sz, newEnt, key,
+	                                  &newFlg);
+	    if(item && (newFlg == 0))
+	    {
+	      /* Another thread added the same section first. */
+	      dupSec = WlzAssignObject(
+	               ((WlzSectionCacheEntry *)(item->entry))->sec, NULL);
+	    }
+	  }
+	  if(newFlg == 0)
+	  {
+	    (void )WlzFreeObj(newEnt->sec);
+	    (void )WlzFreeObj(newEnt->obj);
+	    AlcFree(newEnt);
+	  }
+	  if(dupSec)
+	  {
+	    (void )WlzFreeObj(sec);
+	    sec = dupSec;
+	  }
+	}
+      }
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(sec);
+}
+
+/*!
+* \ingroup	WlzSectionTransform
+* \brief	Sets the fields of a section cache entry from the given
+* 		object, view and interpolation, quantising the view
+* 		parameters using the cache's quanta. The section of the
+* 		entry is set to NULL and no references are taken.
+* \param	ent			Entry to set.
+* \param	cache			Given cache.
+* \param	obj			Given object.
+* \param	view			Given view.
+* \param	interp			Given interpolation.
+*/
+static void	WlzSectionCacheEntrySet(WlzSectionCacheEntry *ent,
+				WlzSectionCache *cache, WlzObject *obj,
+				WlzThreeDViewStruct *view,
+				WlzInterpolationType interp)
+{
+  (void )memset(ent, 0, sizeof(WlzSectionCacheEntry));
+  ent->cache = cache;
+  ent->obj = obj;
+  ent->sec = NULL;
+  ent->theta = WLZ_NINT(view->theta / cache->angQ);
+  ent->phi = WLZ_NINT(view->phi / cache->angQ);
+  ent->zeta = WLZ_NINT(view->zeta / cache->angQ);
+  ent->dist = WLZ_NINT(view->dist / cache->distQ);
+  ent->scale = WLZ_NINT(view->scale / cache->scaleQ);
+  ent->fixed.vtX = WLZ_NINT(view->fixed.vtX / cache->distQ);
+  ent->fixed.vtY = WLZ_NINT(view->fixed.vtY / cache->distQ);
+  ent->fixed.vtZ = WLZ_NINT(view->fixed.vtZ / cache->distQ);
+  ent->viewMode = view->view_mode;
+  ent->interp = interp;
+  ent->voxelRescaleFlg = view->voxelRescaleFlg;
+  ent->voxelSize[0] = view->voxelSize[0];
+  ent->voxelSize[1] = view->voxelSize[1];
+  ent->voxelSize[2] = view->voxelSize[2];
+  ent->up = view->up;
+  ent->fixed2 = view->fixed_2;
+  ent->fixedLineAngle = view->fixed_line_angle;
+}
+
+/*!
+* \return	Approximate size of the section in bytes.
+* \ingroup	WlzSectionTransform
+* \brief	Computes the approximate size of a section for use in
+* 		limiting the total size of the cached sections. For
+* 		domain objects this is the size of the values within
+* 		the bounding box, for all others a nominal size is used.
+* \param	sec			Given section.
+*/
+static size_t	WlzSectionCacheSecSz(WlzObject *sec)
+{
+  size_t	sz;
+
+  sz = sizeof(WlzObject) + sizeof(WlzIntervalDomain);
+  if(sec && (sec->type == WLZ_2D_DOMAINOBJ) && sec->domain.core)
+  {
+    size_t	gSz = 0;
+    WlzIntervalDomain *iDom;
+
+    iDom = sec->domain.i;
+    if(sec->values.core)
+    {
+      gSz = WlzGreySize(WlzGreyTypeFromObj(sec, NULL));
+    }
+    sz += (size_t )(iDom->lastln - iDom->line1 + 1) *
+          ((size_t )(iDom->lastkl - iDom->kol1 + 1) * gSz +
+	   sizeof(WlzInterval));
+  }
+  return(sz);
+}
+
+/*!
+* \return	Key for the cache entry.
+* \ingroup	WlzSectionTransform
+* \brief	Computes a section cache key from the object and
+* 		quantised view parameters of a cache entry.
+* \param	lru			The LRU cache (unused).
+* \param	entry			The cache entry.
+*/
+static unsigned int WlzSectionCacheKey(AlcLRUCache *lru, void *entry)
+{
+  unsigned int	key;
+  WlzSectionCacheEntry *ent;
+
+  ent = (WlzSectionCacheEntry *)entry;
+  key = (unsigned int )((size_t )(ent->obj) >> 4) * 2654435761U;
+  key = (key ^ (unsigned int )(ent->theta)) * 16777619U;
+  key = (key ^ (unsigned int )(ent->phi)) * 16777619U;
+  key = (key ^ (unsigned int )(ent->zeta)) * 16777619U;
+  key = (key ^ (unsigned int )(ent->dist)) * 16777619U;
+  key = (key ^ (unsigned int )(ent->scale)) * 16777619U;
+  key = (key ^ (unsigned int )(ent->fixed.vtX)) * 16777619U;
+  key = (key ^ (unsigned int )(ent->fixed.vtY)) * 16777619U;
+  key = (key ^ (unsigned int )(ent->fixed.vtZ)) * 16777619U;
+  key ^= ((unsigned int )(ent->interp) << 8) | (unsigned int )(ent->viewMode);
+  return(key);
+}
+
+/*!
+* \return	Zero iff the entries match.
+* \ingroup	WlzSectionTransform
+* \brief	Compares two section cache entries.
+* \param	entry0			First cache entry.
+* \param	entry1			Second cache entry.
+*/
+static int	WlzSectionCacheCmp(const void *entry0, const void *entry1)
+{
+  const WlzSectionCacheEntry *ent0,
+  				*ent1;
+
+  ent0 = (const WlzSectionCacheEntry *)entry0;
+  ent1 = (const WlzSectionCacheEntry *)entry1;
+  return((ent0->obj != ent1->obj) ||
+         (ent0->theta != ent1->theta) ||
+         (ent0->phi != ent1->phi) ||
+         (ent0->zeta != ent1->zeta) ||
+         (ent0->dist != ent1->dist) ||
+         (ent0->scale != ent1->scale) ||
+         (ent0->fixed.vtX != ent1->fixed.vtX) ||
+         (ent0->fixed.vtY != ent1->fixed.vtY) ||
+         (ent0->fixed.vtZ != ent1->fixed.vtZ) ||
+         (ent0->viewMode != ent1->viewMode) ||
+         (ent0->interp != ent1->interp) ||
+         (ent0->voxelRescaleFlg != ent1->voxelRescaleFlg) ||
+         (ent0->voxelSize[0] != ent1->voxelSize[0]) ||
+         (ent0->voxelSize[1] != ent1->voxelSize[1]) ||
+         (ent0->voxelSize[2] != ent1->voxelSize[2]) ||
+         (ent0->up.vtX != ent1->up.vtX) ||
+         (ent0->up.vtY != ent1->up.vtY) ||
+         (ent0->up.vtZ != ent1->up.vtZ) ||
+         (ent0->fixed2.vtX != ent1->fixed2.vtX) ||
+         (ent0->fixed2.vtY != ent1->fixed2.vtY) ||
+         (ent0->fixed2.vtZ != ent1->fixed2.vtZ) ||
+         (ent0->fixedLineAngle != ent1->fixedLineAngle));
+}
+
+/*!
+* \ingroup	WlzSectionTransform
+* \brief	Called when a section is removed from a section cache.
+* 		The cache's references to the section and the object
+* 		it was cut from are released and the entry freed.
+* \param	lru			The LRU cache (unused).
+* \param	entry			The cache entry.
+*/
+static void	WlzSectionCacheUnlink(AlcLRUCache *lru, void *entry)
+{
+  WlzSectionCacheEntry *ent;
+
+  ent = (WlzSectionCacheEntry *)entry;
+  ++(ent->cache->evictions);
+  (void )WlzFreeObj(ent->sec);
+  (void )WlzFreeObj(ent->obj);
+  AlcFree(ent);
+}
@@ -40,126 +40,1535 @@ static char _WlzTiledValues_c[] = "University of Edinburgh $Id$";
 */
 
 #include <stdlib.h>
+#include <string.h>
 #include <limits.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include <Wlz.h>
 
-#ifdef HAVE_MMAP
-#define WLZ_USE_MMAP
-#include <unistd.h>
-#include <fcntl.h>
-#include <sys/mman.h>
+#ifdef HAVE_MMAP
+#define WLZ_USE_MMAP
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+
+/* The use of Hilbert order for tiles need some testing before
+real use. */
+/* #define WLZ_TILES_USE_HILBERT */
+
+/*!
+* \struct	_WlzTiledValuesCacheEntry
+* \ingroup	WlzValuesUtils
+* \brief	Entry in a tiled values cache which identifies a single
+* 		tile of a tiled value table.
+*/
+typedef struct _WlzTiledValuesCacheEntry
+{
+  WlzTiledValues *tVal;			/*!< The tiled value table. */
+  size_t	idx;			/*!< Index of the tile. */
+  struct _WlzTiledValuesCacheEntry *next; /*!< Next entry in the cache's
+  					     list of evicted compressed
+					     tiles. */
+} WlzTiledValuesCacheEntry;
+
+static unsigned int		WlzTiledValuesCacheKey(
+				  AlcLRUCache *lru,
+				  void *entry);
+static int			WlzTiledValuesCacheCmp(
+				  const void *entry0,
+				  const void *entry1);
+static void			WlzTiledValuesCacheUnlink(
+				  AlcLRUCache *lru,
+				  void *entry);
+static void			WlzTiledValuesCacheDetach(
+				  WlzTiledValues *tVal);
+static void			WlzTiledValuesCacheReleaseEvicted(
+				  WlzTiledValuesCacheEntry *ent);
+static WlzErrorNum		WlzTiledValuesCTileStateMake(
+				  WlzTiledValues *tVal);
+static void			WlzTiledValuesCTileStateFree(
+				  WlzTiledValues *tVal);
+static void			WlzTiledValuesCTileLock(
+				  WlzTiledValues *tVal,
+				  size_t idx);
+static void			WlzTiledValuesCTileUnlock(
+				  WlzTiledValues *tVal,
+				  size_t idx);
+static WlzUByte			*WlzTiledValuesTileData(
+				  WlzTiledValues *tVal,
+				  size_t idx,
+				  size_t *dstSz);
+static WlzUByte			*WlzTiledValuesTileEncode(
+				  WlzUByte *buf,
+				  WlzUByte *src,
+				  size_t nV,
+				  size_t gSz,
+				  size_t *dstSz);
+static WlzErrorNum		WlzTiledValuesTileWriteBack(
+				  WlzTiledValues *tVal,
+				  size_t idx,
+				  WlzUByte **dstData,
+				  size_t *dstSz);
+static size_t			WlzTiledValuesTileCompress(
+				  WlzUByte *dst,
+				  WlzUByte *tmp,
+				  WlzUByte *src,
+				  size_t nV,
+				  size_t gSz);
+static WlzErrorNum		WlzTiledValuesTileDecode(
+				  WlzTiledValues *tVal,
+				  size_t idx);
+#ifdef WLZ_USE_MMAP
+static void			WlzTiledValuesTileAdvise(
+				  WlzTiledValues *tVal,
+				  size_t idx,
+				  int advice);
+#endif /* WLZ_USE_MMAP */
+static WlzObject  		*WlzMakeTiledValuesObj2D(
+				  WlzObject *gObj,
+				  size_t tileSz,
+				  int setTiles,
+				  WlzGreyType gType,
+				  WlzPixelV bgdV,
+				  WlzErrorNum *dstErr);
+static WlzObject  		*WlzMakeTiledValuesObj3D(
+				  WlzObject *gObj,
+				  size_t tileSz,
+				  int setTiles,
+				  WlzGreyType gType,
+				  WlzPixelV bgdV,
+				  WlzErrorNum *dstErr);
+
+/*!
+* \return	New tiled values.
+* \ingroup	WlzAllocation
+* \brief	Allocates a new tiled value table, but without allocating
+* 		any indices or tiles.
+* \param	dim			Dimension.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzTiledValues	*WlzMakeTiledValues(int dim, WlzErrorNum *dstErr)
+{
+  WlzTiledValues *tVal = NULL;
+  WlzErrorNum   errNum = WLZ_ERR_NONE;
+
+  if(dim < 0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if(((tVal = (WlzTiledValues *)
+                   AlcCalloc(sizeof(WlzTiledValues), 1)) == NULL) ||
+          ((tVal->nIdx = (int *)AlcCalloc(sizeof(int), dim)) == NULL))
+  {
+    AlcFree(tVal);
+    tVal = NULL;
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    tVal->fd = -1;
+    tVal->type = WLZ_VALUETABLE_TILED_INT;
+    tVal->dim = dim;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(tVal);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzAllocation
+* \brief	Frees a tiled value table.
+* \param	tVal			The tiled value table to free.
+*/
+WlzErrorNum	WlzFreeTiledValues(WlzTiledValues *tVal)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tVal == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if(WlzGreyTableIsTiled(tVal->type) == 0)
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  else
+  {
+    if(WlzUnlink(&(tVal->linkcount), &errNum))
+    {
+      if(tVal->cache)
+      {
+        WlzTiledValuesCacheDetach(tVal);
+      }
+      AlcFree(tVal->indices);
+      AlcFree(tVal->nIdx);
+      if(tVal->tiles.v)
+      {
+#ifdef WLZ_USE_MMAP
+	if(tVal->cTiles)
+	{
+	  (void )munmap(tVal->tiles.v, tVal->numTiles * tVal->tileSz *
+	                WlzGreySize(WlzGreyTableTypeToGreyType(tVal->type,
+			                                       NULL)));
+	}
+	else if(tVal->fd >= 0)
+	{
+	  size_t        gSz,
+	  		tSz;
+	  WlzGreyType	gType;
+
+	  gType = WlzGreyTableTypeToGreyType(tVal->type, &errNum);
+	  gSz = WlzGreySize(gType);
+	  tSz = tVal->numTiles * tVal->tileSz;
+	  (void )munmap(tVal->tiles.v, tSz * gSz);
+	  (void )close(tVal->fd);
+	}
+	else
+	{
+#endif /* WLZ_USE_MMAP */
+          AlcFree(tVal->tiles.v);
+#ifdef WLZ_USE_MMAP
+	}
+#endif /* WLZ_USE_MMAP */
+      }
+      WlzTiledValuesCTileStateFree(tVal);
+      AlcFree(tVal->cTileOff);
+      AlcFree(tVal->cTiles);
+      AlcFree(tVal);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	Compresses all the tiles of a tiled value table, without
+* 		modifying the value table. Tiles which do not compress are
+* 		stored as they are, with a compressed size equal to the
+* 		uncompressed size. If the tiles of the value table are
+* 		held compressed then the tiles which have been decoded are
+* 		compressed again from their (possibly modified) values and
+* 		the compressed data of all other tiles is copied.
+* \param	tVal			Given tiled value table with tiles.
+* \param	cmp			Required compression, which must
+* 					not be WLZ_TILED_COMPRESS_NONE.
+* \param	dstOff			Destination pointer for the offsets
+* 					of the compressed tiles, the compressed
+* 					size of tile i being (*dstOff)[i + 1] -
+* 					(*dstOff)[i].
+* \param	dstTiles		Destination pointer for the compressed
+* 					tile data.
+*/
+WlzErrorNum	WlzTiledValuesCompress(WlzTiledValues *tVal,
+				WlzTiledCompression cmp, size_t **dstOff,
+				WlzUByte **dstTiles)
+{
+  size_t	gSz = 0,
+  		tBSz,
+		cBSz,
+		cMax = 0;
+  size_t	*off = NULL;
+  WlzUByte	*cTiles = NULL,
+  		*tmp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tVal == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if(WlzGreyTableIsTiled(tVal->type) == 0)
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  else if(cmp != WLZ_TILED_COMPRESS_DELTA_RLE)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((tVal->tiles.v == NULL) || (tVal->numTiles < 1))
+  {
+    errNum = WLZ_ERR_VALUES_DATA;
+  }
+  else
+  {
+    gSz = WlzGreySize(WlzGreyTableTypeToGreyType(tVal->type, &errNum));
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tBSz = tVal->tileSz * gSz;
+    cBSz = tBSz + ((tBSz + 127) / 128);
+    cMax = tVal->numTiles * tBSz;
+    if(((off = (size_t *)
+               AlcMalloc((tVal->numTiles + 1) * sizeof(size_t))) == NULL) ||
+       ((tmp = (WlzUByte *)AlcMalloc(tBSz + cBSz)) == NULL) ||
+       ((cTiles = (WlzUByte *)AlcMalloc(cMax)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    size_t	idx;
+
+    off[0] = 0;
+    for(idx = 0; idx < tVal->numTiles; ++idx)
+    {
+      size_t	cSz;
+      WlzUByte	*src;
+
+      if(tVal->cTiles && !(tVal->cTileState[idx].valid))
+      {
+        src = WlzTiledValuesTileData(tVal, idx, &cSz);
+      }
+      else
+      {
+	src = WlzTiledValuesTileEncode(tmp, tVal->tiles.ubp + (idx * tBSz),
+				       tVal->tileSz, gSz, &cSz);
+      }
+      (void )memcpy(cTiles + off[idx], src, cSz);
+      off[idx + 1] = off[idx] + cSz;
+    }
+    /* The compressed tiles can't be larger than the tiles. */
+    if(off[tVal->numTiles] < cMax)
+    {
+      WlzUByte	*cT;
+
+      if((cT = (WlzUByte *)AlcRealloc(cTiles,
+                                      off[tVal->numTiles])) != NULL)
+      {
+        cTiles = cT;
+      }
+    }
+  }
+  AlcFree(tmp);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    *dstOff = off;
+    *dstTiles = cTiles;
+  }
+  else
+  {
+    AlcFree(off);
+    AlcFree(cTiles);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzAllocation
+* \brief	Sets the tiles of a tiled value table to be the given
+* 		compressed tiles, which are then decoded as they are
+* 		accessed. Any existing tiles of the value table are freed.
+* 		Memory for the decoded tiles is reserved using an anonymous
+* 		memory mapping and a cache is attached to the value table
+* 		(see WlzTiledValuesCacheAttach()) which holds all of the
+* 		tiles. This default cache may be replaced by a bounded cache
+* 		to limit the number of decoded tiles in memory.
+* 		If memory mapping is not available then all of the tiles
+* 		are decoded immediately.
+* 		On success the value table takes ownership of the given
+* 		offsets and compressed tiles.
+* \param	tVal			Given tiled value table with it's
+* 					tile index and compression set.
+* \param	cTileOff		Offsets of the compressed tiles,
+* 					with numTiles + 1 entries.
+* \param	cTiles			Compressed tiles.
+*/
+WlzErrorNum	WlzMakeTiledValuesCompressedTiles(WlzTiledValues *tVal,
+				size_t *cTileOff, WlzUByte *cTiles)
+{
+  size_t	tSz = 0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tVal == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if((cTileOff == NULL) || (cTiles == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(WlzGreyTableIsTiled(tVal->type) == 0)
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  else if(tVal->compression != WLZ_TILED_COMPRESS_DELTA_RLE)
+  {
+    errNum = WLZ_ERR_VALUES_DATA;
+  }
+  else
+  {
+    tSz = tVal->numTiles * tVal->tileSz *
+          WlzGreySize(WlzGreyTableTypeToGreyType(tVal->type, &errNum));
+  }
+  if((errNum == WLZ_ERR_NONE) && (tVal->tiles.v != NULL))
+  {
+    /* Free the existing tiles. */
+    if(tVal->cache)
+    {
+      WlzTiledValuesCacheDetach(tVal);
+    }
+#ifdef WLZ_USE_MMAP
+    if((tVal->cTiles != NULL) || (tVal->fd >= 0))
+    {
+      (void )munmap(tVal->tiles.v, tSz);
+      if(tVal->fd >= 0)
+      {
+        (void )close(tVal->fd);
+	tVal->fd = -1;
+      }
+    }
+    else
+#endif /* WLZ_USE_MMAP */
+    {
+      AlcFree(tVal->tiles.v);
+    }
+    tVal->tiles.v = NULL;
+    WlzTiledValuesCTileStateFree(tVal);
+    AlcFree(tVal->cTileOff);
+    AlcFree(tVal->cTiles);
+    tVal->cTileOff = NULL;
+    tVal->cTiles = NULL;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef WLZ_USE_MMAP
+    WlzTiledValuesCache *cache = NULL;
+
+    tVal->tiles.v = mmap(NULL, tSz, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+			 -1, 0);
+    if(tVal->tiles.v == MAP_FAILED)
+    {
+      tVal->tiles.v = NULL;
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else if((errNum = WlzTiledValuesCTileStateMake(tVal)) != WLZ_ERR_NONE)
+    {
+      (void )munmap(tVal->tiles.v, tSz);
+      tVal->tiles.v = NULL;
+    }
+    else
+    {
+      tVal->cTileOff = cTileOff;
+      tVal->cTiles = cTiles;
+      if(((cache = WlzMakeTiledValuesCache(tVal->numTiles, tSz + 1,
+                                           &errNum)) != NULL) &&
+         ((errNum = WlzTiledValuesCacheAttach(tVal, cache)) == WLZ_ERR_NONE))
+      {
+        (void )WlzFreeTiledValuesCache(cache);
+      }
+      if(errNum != WLZ_ERR_NONE)
+      {
+	(void )munmap(tVal->tiles.v, tSz);
+	WlzTiledValuesCTileStateFree(tVal);
+	tVal->tiles.v = NULL;
+	tVal->cTileOff = NULL;
+	tVal->cTiles = NULL;
+	if(cache)
+	{
+	  (void )WlzFreeTiledValuesCache(cache);
+	}
+      }
+    }
+#else /* WLZ_USE_MMAP */
+    if((tVal->tiles.v = AlcMalloc(tSz)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      size_t	idx;
+
+      tVal->cTileOff = cTileOff;
+      tVal->cTiles = cTiles;
+      for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < tVal->numTiles); ++idx)
+      {
+        errNum = WlzTiledValuesTileDecode(tVal, idx);
+      }
+      tVal->cTileOff = NULL;
+      tVal->cTiles = NULL;
+      if(errNum == WLZ_ERR_NONE)
+      {
+        AlcFree(cTileOff);
+	AlcFree(cTiles);
+      }
+      else
+      {
+        AlcFree(tVal->tiles.v);
+	tVal->tiles.v = NULL;
+      }
+    }
+#endif /* WLZ_USE_MMAP */
+  }
+  return(errNum);
+}
+
+/*!
+* \return	New tiled values cache or NULL on error.
+* \ingroup	WlzAllocation
+* \brief	Allocates a new tiled values cache which may be attached
+* 		to any number of memory mapped tiled value tables using
+* 		WlzTiledValuesCacheAttach(). The cache limits the total
+* 		size of the tiles that are held in memory for the attached
+* 		tables, with the least recently used tiles being evicted
+* 		as required. The new cache has a link count of one for
+* 		the caller's reference, which should be released using
+* 		WlzFreeTiledValuesCache().
+* \param	maxTiles		Maximum number of cached tiles.
+* \param	maxSz			Maximum total size (bytes) of the
+* 					cached tiles.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzTiledValuesCache *WlzMakeTiledValuesCache(unsigned int maxTiles,
+				size_t maxSz, WlzErrorNum *dstErr)
+{
+  WlzTiledValuesCache *cache = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((maxTiles == 0) || (maxSz == 0))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((cache = (WlzTiledValuesCache *)
+                   AlcCalloc(1, sizeof(WlzTiledValuesCache))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else if((cache->lru = AlcLRUCacheNew(maxTiles, maxSz,
+  				       WlzTiledValuesCacheKey,
+				       WlzTiledValuesCacheCmp,
+				       WlzTiledValuesCacheUnlink,
+				       NULL)) == NULL)
+  {
+    AlcFree(cache);
+    cache = NULL;
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    cache->linkcount = 1;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(cache);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzAllocation
+* \brief	Releases a reference to a tiled values cache. The cache is
+* 		only freed once it is no longer attached to any tiled value
+* 		tables.
+* \param	cache			Given cache.
+*/
+WlzErrorNum	WlzFreeTiledValuesCache(WlzTiledValuesCache *cache)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(cache == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(WlzUnlink(&(cache->linkcount), &errNum))
+  {
+    WlzTiledValuesCacheEntry *ent;
+
+    AlcLRUCacheFree(cache->lru, 1);
+    while((ent = (WlzTiledValuesCacheEntry *)(cache->evicted)) != NULL)
+    {
+      cache->evicted = ent->next;
+      AlcFree(ent);
+    }
+    AlcFree(cache);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	Attaches a tile cache to a tiled value table, replacing
+* 		any cache already attached to it. If the given cache is
+* 		NULL then any existing cache is detached. The tiles of
+* 		the value table must be memory mapped (see WlzReadObj()),
+* 		since the cache bounds memory use by releasing the pages
+* 		of evicted tiles, which are then read again from the file
+* 		if they are accessed. Alternatively the tiles may be held
+* 		compressed, in which case evicted tiles are compressed
+* 		again, keeping any changes to their values, and then
+* 		decoded again if they are accessed. A value table with
+* 		compressed tiles always has a cache, so for these the cache
+* 		may be replaced but not detached. Compressed tiles which
+* 		are in use (see WlzTiledValuesCacheTouch()) are not
+* 		released until they are no longer in use, even if they
+* 		have been evicted.
+* 		One cache may be shared by many value tables, each of
+* 		which holds a reference to the cache until it is freed or
+* 		detached from the cache.
+* \param	tVal			Given tiled value table.
+* \param	cache			Given cache, may be NULL.
+*/
+WlzErrorNum	WlzTiledValuesCacheAttach(WlzTiledValues *tVal,
+				WlzTiledValuesCache *cache)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tVal == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if(WlzGreyTableIsTiled(tVal->type) == 0)
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  else if((cache != NULL) && (tVal->cTiles == NULL) &&
+          ((tVal->fd < 0) || (tVal->tiles.v == NULL)))
+  {
+    errNum = WLZ_ERR_VALUES_DATA;
+  }
+  else if((cache == NULL) && (tVal->cTiles != NULL))
+  {
+    /* Compressed tiles are only decoded through the cache. */
+    errNum = WLZ_ERR_VALUES_DATA;
+  }
+  else if(tVal->cache != cache)
+  {
+    if(tVal->cache)
+    {
+      WlzTiledValuesCacheDetach(tVal);
+    }
+    if(cache)
+    {
+      ++(cache->linkcount);
+      tVal->cache = cache;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	Prefetches the tiles of a tiled value table which intersect
+* 		the given box. The tiles are entered into the value table's
+* 		cache and the pages of the tiles are requested from the
+* 		file asynchronously. If there is no cache attached to the
+* 		value table then this function does nothing.
+* \param	tVal			Given tiled value table.
+* \param	box			Box with absolute coordinates, for 2D
+* 					value tables the plane coordinates
+* 					are ignored.
+*/
+WlzErrorNum	WlzTiledValuesCachePrefetch(WlzTiledValues *tVal,
+				WlzIBox3 box)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tVal == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if(WlzGreyTableIsTiled(tVal->type) == 0)
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  else if(tVal->cache)
+  {
+    int		tx,
+    		ty,
+		tz;
+    WlzIBox3	tBox;
+
+    /* Compute the range of tile indices intersecting the box. */
+    box.xMin = WLZ_MAX(box.xMin, tVal->kol1) - tVal->kol1;
+    box.yMin = WLZ_MAX(box.yMin, tVal->line1) - tVal->line1;
+    box.xMax = WLZ_MIN(box.xMax, tVal->lastkl) - tVal->kol1;
+    box.yMax = WLZ_MIN(box.yMax, tVal->lastln) - tVal->line1;
+    if(tVal->dim == 2)
+    {
+      box.zMin = box.zMax = 0;
+    }
+    else
+    {
+      box.zMin = WLZ_MAX(box.zMin, tVal->plane1) - tVal->plane1;
+      box.zMax = WLZ_MIN(box.zMax, tVal->lastpl) - tVal->plane1;
+    }
+    tBox.xMin = box.xMin / tVal->tileWidth;
+    tBox.yMin = box.yMin / tVal->tileWidth;
+    tBox.zMin = box.zMin / tVal->tileWidth;
+    tBox.xMax = box.xMax / tVal->tileWidth;
+    tBox.yMax = box.yMax / tVal->tileWidth;
+    tBox.zMax = box.zMax / tVal->tileWidth;
+    if((box.xMin <= box.xMax) && (box.yMin <= box.yMax) &&
+       (box.zMin <= box.zMax))
+    {
+      for(tz = tBox.zMin; (errNum == WLZ_ERR_NONE) && (tz <= tBox.zMax);
+          ++tz)
+      {
+	for(ty = tBox.yMin; (errNum == WLZ_ERR_NONE) && (ty <= tBox.yMax);
+	    ++ty)
+	{
+	  size_t	i;
+
+	  i = (((tVal->dim == 2)? 0: tz * tVal->nIdx[1]) + ty) *
+	      tVal->nIdx[0];
+	  for(tx = tBox.xMin; (errNum == WLZ_ERR_NONE) && (tx <= tBox.xMax);
+	      ++tx)
+	  {
+	    size_t	idx;
+
+	    idx = *(tVal->indices + i + tx);
+	    if((idx < tVal->numTiles) &&
+	       ((errNum = WlzTiledValuesCacheTouch(tVal,
+	                                           idx)) == WLZ_ERR_NONE))
+	    {
+#ifdef WLZ_USE_MMAP
+	      WlzTiledValuesTileAdvise(tVal, idx, MADV_WILLNEED);
+#endif /* WLZ_USE_MMAP */
+	      WlzTiledValuesCacheRelease(tVal, idx);
+	    }
+	  }
+	}
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	Records an access to a tile of a tiled value table which
+* 		has a cache attached. If the tile is in the cache it becomes
+* 		the most recently used, otherwise it is added to the cache,
+* 		which may cause the least recently used tiles to be evicted.
+* 		If the tiles are held compressed then a tile which has not
+* 		been decoded is decoded while holding the tile's lock,
+* 		with any other thread which accesses the tile waiting on
+* 		the lock until it has been decoded. If the tile can not be
+* 		decoded it is removed from the cache and an error is
+* 		returned. Compressed tiles which have been evicted are
+* 		written back and released before returning.
+* 		On success a compressed tile is in use until a matching
+* 		call to WlzTiledValuesCacheRelease(), and it is not
+* 		released even if it is evicted while it is in use.
+* 		This function is called by the tiled value access functions
+* 		and is safe to call concurrently.
+* \param	tVal			Given tiled value table.
+* \param	idx			Index of the tile (ie the value in
+* 					the tile index table).
+*/
+WlzErrorNum	WlzTiledValuesCacheTouch(WlzTiledValues *tVal, size_t idx)
+{
+  WlzTiledValuesCache *cache;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((cache = tVal->cache) != NULL)
+  {
+    unsigned int key;
+    WlzTiledCTile *cT = NULL;
+    WlzTiledValuesCacheEntry ent,
+    		*evicted;
+
+    ent.tVal = tVal;
+    ent.idx = idx;
+    ent.next = NULL;
+    key = WlzTiledValuesCacheKey(cache->lru, &ent);
+    if(tVal->cTileState)
+    {
+      cT = tVal->cTileState + idx;
+    }
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValuesCache)
+#endif
+    {
+      if(AlcLRUCEntryGetWithKey(cache->lru, key, &ent) != NULL)
+      {
+	++(cache->hits);
+      }
+      else
+      {
+	size_t	  tSz;
+	WlzTiledValuesCacheEntry *newEnt;
+
+	++(cache->misses);
+	tSz = tVal->tileSz *
+	      WlzGreySize(WlzGreyTableTypeToGreyType(tVal->type, NULL));
+	if((newEnt = (WlzTiledValuesCacheEntry *)
+		     AlcMalloc(sizeof(WlzTiledValuesCacheEntry))) != NULL)
+	{
+	  *newEnt = ent;
+	  if(AlcLRUCEntryAddWithKey(cache->lru, tSz, newEnt, key,
+	                            NULL) == NULL)
+	  {
+	    AlcFree(newEnt);
+	  }
+	}
+	if(cT)
+	{
+	  /* An evicted tile which has not yet been released is kept. */
+	  cT->evicted = 0;
+	}
+      }
+      if(cT)
+      {
+	++(cT->use);
+      }
+      evicted = (WlzTiledValuesCacheEntry *)(cache->evicted);
+      cache->evicted = NULL;
+    }
+    if(cT)
+    {
+      /* The tile's lock is held while it is decoded or written back,
+       * so other threads which access the tile wait on the lock rather
+       * than on the cache's critical section. */
+      WlzTiledValuesCTileLock(tVal, idx);
+      if(cT->valid == 0)
+      {
+	errNum = WlzTiledValuesTileDecode(tVal, idx);
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValuesCache)
+#endif
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    cT->valid = 1;
+	  }
+	  else
+	  {
+	    --(cT->use);
+	    AlcLRUCEntryRemoveWithKey(cache->lru, key, &ent);
+	  }
+	}
+      }
+      WlzTiledValuesCTileUnlock(tVal, idx);
+    }
+    if(evicted)
+    {
+      WlzTiledValuesCacheReleaseEvicted(evicted);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzValuesUtils
+* \brief	Records the end of a use of a tile of a tiled value table
+* 		which was started by WlzTiledValuesCacheTouch(). If the
+* 		tiles are held compressed and the tile was evicted from
+* 		the cache while it was in use then, when it is no longer
+* 		in use, it is written back and released by a following
+* 		access. This function is safe to call concurrently.
+* \param	tVal			Given tiled value table.
+* \param	idx			Index of the tile (ie the value in
+* 					the tile index table).
+*/
+void		WlzTiledValuesCacheRelease(WlzTiledValues *tVal, size_t idx)
+{
+  if(tVal->cache && tVal->cTileState)
+  {
+    WlzTiledCTile *cT;
+    WlzTiledValuesCache *cache;
+
+    cache = tVal->cache;
+    cT = tVal->cTileState + idx;
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValuesCache)
+#endif
+    {
+      if((cT->use > 0) && (--(cT->use) == 0) && cT->evicted)
+      {
+	WlzTiledValuesCacheEntry *ent;
+
+	if((ent = (WlzTiledValuesCacheEntry *)
+		  AlcMalloc(sizeof(WlzTiledValuesCacheEntry))) != NULL)
+	{
+	  ent->tVal = tVal;
+	  ent->idx = idx;
+	  ent->next = (WlzTiledValuesCacheEntry *)(cache->evicted);
+	  cache->evicted = ent;
+	}
+      }
+    }
+  }
+}
+
+/*!
+* \return	Key for the cache entry.
+* \ingroup	WlzValuesUtils
+* \brief	Computes a tiled values cache key from the value table and
+* 		tile index of a cache entry.
+* \param	lru			The LRU cache (unused).
+* \param	entry			The cache entry.
+*/
+static unsigned int WlzTiledValuesCacheKey(AlcLRUCache *lru, void *entry)
+{
+  WlzTiledValuesCacheEntry *ent;
+
+  ent = (WlzTiledValuesCacheEntry *)entry;
+  return((unsigned int )(ent->idx) ^
+         ((unsigned int )((size_t )(ent->tVal) >> 4) * 2654435761U));
+}
+
+/*!
+* \return	Zero iff the entries match.
+* \ingroup	WlzValuesUtils
+* \brief	Compares two tiled values cache entries.
+* \param	entry0			First cache entry.
+* \param	entry1			Second cache entry.
+*/
+static int	WlzTiledValuesCacheCmp(const void *entry0, const void *entry1)
+{
+  const WlzTiledValuesCacheEntry *ent0,
+  				*ent1;
+
+  ent0 = (const WlzTiledValuesCacheEntry *)entry0;
+  ent1 = (const WlzTiledValuesCacheEntry *)entry1;
+  return((ent0->tVal != ent1->tVal) || (ent0->idx != ent1->idx));
+}
+
+/*!
+* \ingroup	WlzValuesUtils
+* \brief	Called when a tile is removed from a tiled values cache.
+* 		The pages of a memory mapped tile are released and the
+* 		entry freed. A decoded compressed tile is instead marked
+* 		as evicted and it's entry is added to the cache's list of
+* 		evicted tiles, so that it can be written back and released
+* 		outside of the cache's critical section.
+* \param	lru			The LRU cache (unused).
+* \param	entry			The cache entry.
+*/
+static void	WlzTiledValuesCacheUnlink(AlcLRUCache *lru, void *entry)
+{
+  WlzTiledValuesCacheEntry *ent;
+  WlzTiledValuesCache *cache;
+
+  ent = (WlzTiledValuesCacheEntry *)entry;
+  cache = ent->tVal->cache;
+  if(ent->tVal->cTileState == NULL)
+  {
+    ++(cache->evictions);
+#ifdef WLZ_USE_MMAP
+    WlzTiledValuesTileAdvise(ent->tVal, ent->idx, MADV_DONTNEED);
+#endif /* WLZ_USE_MMAP */
+  }
+  else
+  {
+    WlzTiledCTile *cT;
+
+    cT = ent->tVal->cTileState + ent->idx;
+    if(cT->valid && (cT->evicted == 0))
+    {
+      ++(cache->evictions);
+      cT->evicted = 1;
+      ent->next = (WlzTiledValuesCacheEntry *)(cache->evicted);
+      cache->evicted = ent;
+      ent = NULL;
+    }
+  }
+  AlcFree(ent);
+}
+
+/*!
+* \ingroup	WlzValuesUtils
+* \brief	Writes back and releases the given list of evicted
+* 		compressed tiles, freeing the list's entries. Each tile
+* 		which is still evicted, decoded and not in use is
+* 		compressed again (see WlzTiledValuesTileWriteBack()) and
+* 		if it has been modified the new compressed tile is kept.
+* 		If the tile has not been accessed since it was evicted
+* 		it's pages are then released, otherwise it is left
+* 		decoded. The tile's lock is held throughout, so that
+* 		other threads which access the tile wait on it.
+* \param	ent			First entry of the list.
+*/
+static void	WlzTiledValuesCacheReleaseEvicted(
+				WlzTiledValuesCacheEntry *ent)
+{
+  while(ent)
+  {
+    int		claim = 0,
+    		release = 0;
+    size_t	sz = 0;
+    WlzUByte	*data = NULL;
+    WlzTiledCTile *cT;
+    WlzTiledValuesCacheEntry *next;
+
+    next = ent->next;
+    cT = ent->tVal->cTileState + ent->idx;
+    WlzTiledValuesCTileLock(ent->tVal, ent->idx);
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValuesCache)
+#endif
+    {
+      claim = cT->evicted && cT->valid && (cT->use == 0);
+    }
+    if(claim)
+    {
+      WlzErrorNum errNum;
+
+      errNum = WlzTiledValuesTileWriteBack(ent->tVal, ent->idx, &data, &sz);
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValuesCache)
+#endif
+      {
+	if(data)
+	{
+	  AlcFree(cT->data);
+	  cT->data = data;
+	  cT->sz = sz;
+	}
+	if((errNum == WLZ_ERR_NONE) && cT->evicted && (cT->use == 0))
+	{
+	  cT->valid = 0;
+	  cT->evicted = 0;
+	  release = 1;
+	}
+      }
+#ifdef WLZ_USE_MMAP
+      if(release)
+      {
+	WlzTiledValuesTileAdvise(ent->tVal, ent->idx, MADV_DONTNEED);
+      }
+#endif /* WLZ_USE_MMAP */
+    }
+    WlzTiledValuesCTileUnlock(ent->tVal, ent->idx);
+    AlcFree(ent);
+    ent = next;
+  }
+}
+
+/*!
+* \ingroup	WlzValuesUtils
+* \brief	Detaches the cache from the given tiled value table,
+* 		removing all of the table's tiles from the cache.
+* \param	tVal			Given tiled value table.
+*/
+static void	WlzTiledValuesCacheDetach(WlzTiledValues *tVal)
+{
+  WlzTiledValuesCache *cache;
+
+  cache = tVal->cache;
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValuesCache)
 #endif
+  {
+    AlcLRUCItem	*item,
+    		*next;
 
-/* The use of Hilbert order for tiles need some testing before
-real use. */
-/* #define WLZ_TILES_USE_HILBERT */
+    item = cache->lru->rankHead;
+    while(item)
+    {
+      WlzTiledValuesCacheEntry *ent;
 
-static WlzObject  		*WlzMakeTiledValuesObj2D(
-				  WlzObject *gObj,
-				  size_t tileSz,
-				  int setTiles,
-				  WlzGreyType gType,
-				  WlzPixelV bgdV,
-				  WlzErrorNum *dstErr);
-static WlzObject  		*WlzMakeTiledValuesObj3D(
-				  WlzObject *gObj,
-				  size_t tileSz,
-				  int setTiles,
-				  WlzGreyType gType,
-				  WlzPixelV bgdV,
-				  WlzErrorNum *dstErr);
+      next = item->rankNxt;
+      ent = (WlzTiledValuesCacheEntry *)(item->entry);
+      if(ent->tVal == tVal)
+      {
+        AlcLRUCEntryRemoveWithKey(cache->lru, item->key, ent);
+      }
+      item = next;
+    }
+    if(tVal->cTileState)
+    {
+      WlzTiledValuesCacheEntry *ent,
+      		**prv;
+
+      /* Remove the table's tiles from the list of evicted tiles, these
+       * tiles are left decoded. */
+      prv = (WlzTiledValuesCacheEntry **)&(cache->evicted);
+      while((ent = *prv) != NULL)
+      {
+	if(ent->tVal == tVal)
+	{
+	  tVal->cTileState[ent->idx].evicted = 0;
+	  *prv = ent->next;
+	  AlcFree(ent);
+	}
+	else
+	{
+	  prv = &(ent->next);
+	}
+      }
+    }
+  }
+  tVal->cache = NULL;
+  (void )WlzFreeTiledValuesCache(cache);
+}
 
 /*!
-* \return	New tiled values.
+* \return	Woolz error code.
 * \ingroup	WlzAllocation
-* \brief	Allocates a new tiled value table, but without allocating
-* 		any indices or tiles.
-* \param	dim			Dimension.
-* \param	dstErr			Destination error pointer, may be NULL.
+* \brief	Allocates the state of each of the compressed tiles of a
+* 		tiled value table and, when OpenMP is used, a lock for
+* 		each of the tiles.
+* \param	tVal			Given tiled value table.
 */
-WlzTiledValues	*WlzMakeTiledValues(int dim, WlzErrorNum *dstErr)
+static WlzErrorNum WlzTiledValuesCTileStateMake(WlzTiledValues *tVal)
 {
-  WlzTiledValues *tVal = NULL;
-  WlzErrorNum   errNum = WLZ_ERR_NONE;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  if(dim < 0)
+  tVal->cTileLock = NULL;
+  if((tVal->cTileState = (WlzTiledCTile *)
+                         AlcCalloc(tVal->numTiles,
+			           sizeof(WlzTiledCTile))) == NULL)
   {
-    errNum = WLZ_ERR_PARAM_DATA;
+    errNum = WLZ_ERR_MEM_ALLOC;
   }
-  else if(((tVal = (WlzTiledValues *)
-                   AlcCalloc(sizeof(WlzTiledValues), 1)) == NULL) ||
-          ((tVal->nIdx = (int *)AlcCalloc(sizeof(int), dim)) == NULL))
+#ifdef _OPENMP
+  else if((tVal->cTileLock = AlcMalloc(tVal->numTiles *
+                                       sizeof(omp_lock_t))) == NULL)
   {
-    AlcFree(tVal);
-    tVal = NULL;
+    AlcFree(tVal->cTileState);
+    tVal->cTileState = NULL;
     errNum = WLZ_ERR_MEM_ALLOC;
   }
   else
   {
-    tVal->fd = -1;
-    tVal->type = WLZ_VALUETABLE_TILED_INT;
-    tVal->dim = dim;
+    size_t	idx;
+    omp_lock_t	*lock;
+
+    lock = (omp_lock_t *)(tVal->cTileLock);
+    for(idx = 0; idx < tVal->numTiles; ++idx)
+    {
+      omp_init_lock(lock + idx);
+    }
   }
-  if(dstErr)
+#endif /* _OPENMP */
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzAllocation
+* \brief	Frees the state and locks of the compressed tiles of a
+* 		tiled value table, including any written back tiles.
+* \param	tVal			Given tiled value table.
+*/
+static void	WlzTiledValuesCTileStateFree(WlzTiledValues *tVal)
+{
+  size_t	idx;
+
+  if(tVal->cTileState)
   {
-    *dstErr = errNum;
+    for(idx = 0; idx < tVal->numTiles; ++idx)
+    {
+      AlcFree(tVal->cTileState[idx].data);
+    }
+    AlcFree(tVal->cTileState);
+    tVal->cTileState = NULL;
   }
-  return(tVal);
+#ifdef _OPENMP
+  if(tVal->cTileLock)
+  {
+    omp_lock_t	*lock;
+
+    lock = (omp_lock_t *)(tVal->cTileLock);
+    for(idx = 0; idx < tVal->numTiles; ++idx)
+    {
+      omp_destroy_lock(lock + idx);
+    }
+    AlcFree(tVal->cTileLock);
+  }
+#endif /* _OPENMP */
+  tVal->cTileLock = NULL;
+}
+
+/*!
+* \ingroup	WlzValuesUtils
+* \brief	Sets the lock of a compressed tile, waiting until the
+* 		lock is available. The lock must not be set while in the
+* 		WlzTiledValuesCache critical section, although the
+* 		critical section may be entered while the lock is held.
+* \param	tVal			Given tiled value table.
+* \param	idx			Index of the tile.
+*/
+static void	WlzTiledValuesCTileLock(WlzTiledValues *tVal, size_t idx)
+{
+#ifdef _OPENMP
+  if(tVal->cTileLock)
+  {
+    omp_set_lock((omp_lock_t *)(tVal->cTileLock) + idx);
+  }
+#endif /* _OPENMP */
+}
+
+/*!
+* \ingroup	WlzValuesUtils
+* \brief	Unsets the lock of a compressed tile.
+* \param	tVal			Given tiled value table.
+* \param	idx			Index of the tile.
+*/
+static void	WlzTiledValuesCTileUnlock(WlzTiledValues *tVal, size_t idx)
+{
+#ifdef _OPENMP
+  if(tVal->cTileLock)
+  {
+    omp_unset_lock((omp_lock_t *)(tVal->cTileLock) + idx);
+  }
+#endif /* _OPENMP */
+}
+
+/*!
+* \return	The compressed tile.
+* \ingroup	WlzValuesUtils
+* \brief	Gets the current compressed data of a single tile of a
+* 		tiled value table with compressed tiles. This is the
+* 		written back tile if the tile has been modified, otherwise
+* 		it is the original compressed tile.
+* \param	tVal			Given tiled value table with
+* 					compressed tiles.
+* \param	idx			Index of the tile.
+* \param	dstSz			Destination pointer for the size
+* 					of the compressed tile.
+*/
+static WlzUByte	*WlzTiledValuesTileData(WlzTiledValues *tVal, size_t idx,
+				        size_t *dstSz)
+{
+  WlzUByte	*data;
+
+  if(tVal->cTileState && tVal->cTileState[idx].data)
+  {
+    data = tVal->cTileState[idx].data;
+    *dstSz = tVal->cTileState[idx].sz;
+  }
+  else
+  {
+    data = tVal->cTiles + tVal->cTileOff[idx];
+    *dstSz = tVal->cTileOff[idx + 1] - tVal->cTileOff[idx];
+  }
+  return(data);
+}
+
+/*!
+* \return	The compressed tile, which is either within the given
+* 		buffer or the given tile itself.
+* \ingroup	WlzValuesUtils
+* \brief	Compresses a single tile (see WlzTiledValuesTileCompress())
+* 		unless compression would not reduce it's size, in which
+* 		case the tile is used as it is.
+* \param	buf			Workspace with space for n +
+* 					n + ((n + 127) / 128) bytes, where n
+* 					is the number of bytes in the tile.
+* \param	src			The tile.
+* \param	nV			Number of values in the tile.
+* \param	gSz			Number of bytes per value.
+* \param	dstSz			Destination pointer for the size
+* 					of the compressed tile.
+*/
+static WlzUByte	*WlzTiledValuesTileEncode(WlzUByte *buf, WlzUByte *src,
+				          size_t nV, size_t gSz,
+					  size_t *dstSz)
+{
+  size_t	n,
+  		cSz;
+  WlzUByte	*data;
+
+  n = nV * gSz;
+  cSz = WlzTiledValuesTileCompress(buf + n, buf, src, nV, gSz);
+  if(cSz >= n)
+  {
+    data = src;
+    *dstSz = n;
+  }
+  else
+  {
+    data = buf + n;
+    *dstSz = cSz;
+  }
+  return(data);
 }
 
 /*!
 * \return	Woolz error code.
-* \ingroup	WlzAllocation
-* \brief	Frees a tiled value table.
-* \param	tVal			The tiled value table to free.
+* \ingroup	WlzValuesUtils
+* \brief	Compresses a single decoded tile of a tiled value table
+* 		with compressed tiles again and compares it with the
+* 		tile's current compressed data. If the tile has been
+* 		modified a copy of the new compressed tile is returned,
+* 		which the caller should then keep in the tile's state.
+* \param	tVal			Given tiled value table with
+* 					compressed tiles.
+* \param	idx			Index of the tile.
+* \param	dstData			Destination pointer for the new
+* 					compressed tile, set to NULL if the
+* 					tile has not been modified.
+* \param	dstSz			Destination pointer for the size of
+* 					the new compressed tile.
 */
-WlzErrorNum	WlzFreeTiledValues(WlzTiledValues *tVal)
+static WlzErrorNum WlzTiledValuesTileWriteBack(WlzTiledValues *tVal,
+				size_t idx, WlzUByte **dstData,
+				size_t *dstSz)
 {
+  size_t	gSz,
+  		n,
+		cSz,
+		oSz;
+  WlzUByte	*buf,
+  		*src,
+		*data = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  if(tVal == NULL)
+  gSz = WlzGreySize(WlzGreyTableTypeToGreyType(tVal->type, NULL));
+  n = tVal->tileSz * gSz;
+  if((buf = (WlzUByte *)AlcMalloc(n + n + ((n + 127) / 128))) == NULL)
   {
-    errNum = WLZ_ERR_VALUES_NULL;
+    errNum = WLZ_ERR_MEM_ALLOC;
   }
-  else if(WlzGreyTableIsTiled(tVal->type) == 0)
+  else
   {
-    errNum = WLZ_ERR_VALUES_TYPE;
+    WlzUByte	*org;
+
+    src = WlzTiledValuesTileEncode(buf, tVal->tiles.ubp + (idx * n),
+                                   tVal->tileSz, gSz, &cSz);
+    org = WlzTiledValuesTileData(tVal, idx, &oSz);
+    if((cSz != oSz) || (memcmp(src, org, cSz) != 0))
+    {
+      if((data = (WlzUByte *)AlcMalloc(cSz)) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+        (void )memcpy(data, src, cSz);
+	*dstSz = cSz;
+      }
+    }
+    AlcFree(buf);
+  }
+  *dstData = data;
+  return(errNum);
+}
+
+/*!
+* \return	Number of bytes in the compressed tile.
+* \ingroup	WlzValuesUtils
+* \brief	Compresses a single tile using WLZ_TILED_COMPRESS_DELTA_RLE
+* 		compression. The values are treated as unsigned integers
+* 		with their bytes in order of increasing significance and
+* 		the differences between successive values are computed.
+* 		The bytes of the differences are then grouped by
+* 		significance, so that for most images the more significant
+* 		bytes form long runs, and these are then run length
+* 		encoded. In the run length encoding a control byte c
+* 		less than 128 is followed by c + 1 literal bytes, otherwise
+* 		it is followed by a single byte which is repeated c - 125
+* 		times.
+* \param	dst			Destination for the compressed tile
+* 					with space for at least
+* 					n + ((n + 127) / 128) bytes, where n
+* 					is the number of bytes in the tile.
+* \param	tmp			Workspace with space for the tile.
+* \param	src			The tile.
+* \param	nV			Number of values in the tile.
+* \param	gSz			Number of bytes per value.
+*/
+static size_t	WlzTiledValuesTileCompress(WlzUByte *dst, WlzUByte *tmp,
+				           WlzUByte *src, size_t nV,
+					   size_t gSz)
+{
+  size_t	i,
+  		n,
+		nD = 0;
+  unsigned long long v0 = 0;
+
+  /* Delta encode and group bytes by significance. */
+  for(i = 0; i < nV; ++i)
+  {
+    size_t	b;
+    unsigned long long d,
+    		v1 = 0;
+
+    for(b = 0; b < gSz; ++b)
+    {
+      v1 |= (unsigned long long )(src[(i * gSz) + b]) << (8 * b);
+    }
+    d = v1 - v0;
+    v0 = v1;
+    for(b = 0; b < gSz; ++b)
+    {
+      tmp[(b * nV) + i] = (WlzUByte )((d >> (8 * b)) & 0xff);
+    }
+  }
+  /* Run length encode. */
+  n = nV * gSz;
+  i = 0;
+  while(i < n)
+  {
+    size_t	r = 1;
+
+    while((i + r < n) && (r < 130) && (tmp[i + r] == tmp[i]))
+    {
+      ++r;
+    }
+    if(r >= 3)
+    {
+      dst[nD++] = (WlzUByte )(r + 125);
+      dst[nD++] = tmp[i];
+      i += r;
+    }
+    else
+    {
+      size_t	i0;
+
+      i0 = i;
+      while((i < n) && (i - i0 < 128) &&
+            !((i + 2 < n) && (tmp[i] == tmp[i + 1]) &&
+	      (tmp[i] == tmp[i + 2])))
+      {
+        ++i;
+      }
+      dst[nD++] = (WlzUByte )(i - i0 - 1);
+      (void )memcpy(dst + nD, tmp + i0, i - i0);
+      nD += i - i0;
+    }
+  }
+  return(nD);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	Decodes a single compressed tile of a tiled value table
+* 		into the tile's place in the tiles (see
+* 		WlzTiledValuesTileCompress()).
+* \param	tVal			Given tiled value table with
+* 					compressed tiles.
+* \param	idx			Index of the tile.
+*/
+static WlzErrorNum WlzTiledValuesTileDecode(WlzTiledValues *tVal, size_t idx)
+{
+  size_t	gSz,
+  		nV,
+  		n,
+		cSz;
+  WlzUByte	*src,
+  		*dst;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  gSz = WlzGreySize(WlzGreyTableTypeToGreyType(tVal->type, NULL));
+  nV = tVal->tileSz;
+  n = nV * gSz;
+  src = WlzTiledValuesTileData(tVal, idx, &cSz);
+  dst = tVal->tiles.ubp + (idx * n);
+  if(cSz == n)
+  {
+    /* Tile is not compressed. */
+    (void )memcpy(dst, src, n);
   }
   else
   {
-    if(WlzUnlink(&(tVal->linkcount), &errNum))
+    size_t	i = 0,
+    		j = 0;
+    WlzUByte	*tmp;
+
+    if((tmp = (WlzUByte *)AlcMalloc(n)) == NULL)
     {
-      AlcFree(tVal->indices);
-      AlcFree(tVal->nIdx);
-      if(tVal->tiles.v)
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      while((i < cSz) && (errNum == WLZ_ERR_NONE))
       {
-#ifdef WLZ_USE_MMAP
-	if(tVal->fd >= 0)
-	{
-	  size_t        gSz,
-	  		tSz;
-	  WlzGreyType	gType;
+	size_t	c;
 
-	  gType = WlzGreyTableTypeToGreyType(tVal->type, &errNum);
-	  gSz = WlzGreySize(gType);
-	  tSz = tVal->numTiles * tVal->tileSz;
-	  (void )munmap(tVal->tiles.v, tSz * gSz);
-	  (void )close(tVal->fd);
+	c = src[i++];
+	if(c < 128)
+	{
+	  if((j + c + 1 > n) || (i + c + 1 > cSz))
+	  {
+	    errNum = WLZ_ERR_VALUES_DATA;
+	  }
+	  else
+	  {
+	    (void )memcpy(tmp + j, src + i, c + 1);
+	    i += c + 1;
+	    j += c + 1;
+	  }
 	}
 	else
 	{
-#endif /* WLZ_USE_MMAP */
-          AlcFree(tVal->tiles.v);
-#ifdef WLZ_USE_MMAP
+	  c -= 125;
+	  if((j + c > n) || (i >= cSz))
+	  {
+	    errNum = WLZ_ERR_VALUES_DATA;
+	  }
+	  else
+	  {
+	    (void )memset(tmp + j, src[i++], c);
+	    j += c;
+	  }
 	}
-#endif /* WLZ_USE_MMAP */
       }
-      AlcFree(tVal);
+      if((errNum == WLZ_ERR_NONE) && (j != n))
+      {
+        errNum = WLZ_ERR_VALUES_DATA;
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	unsigned long long v = 0;
+
+	for(i = 0; i < nV; ++i)
+	{
+	  size_t	b;
+	  unsigned long long d = 0;
+
+	  for(b = 0; b < gSz; ++b)
+	  {
+	    d |= (unsigned long long )(tmp[(b * nV) + i]) << (8 * b);
+	  }
+	  v += d;
+	  for(b = 0; b < gSz; ++b)
+	  {
+	    dst[(i * gSz) + b] = (WlzUByte )((v >> (8 * b)) & 0xff);
+	  }
+	}
+      }
+      AlcFree(tmp);
     }
   }
   return(errNum);
 }
 
+#ifdef WLZ_USE_MMAP
+/*!
+* \ingroup	WlzValuesUtils
+* \brief	Gives advice about the use of the pages of a memory
+* 		mapped tile. Only whole pages within the tile are
+* 		given advice about.
+* \param	tVal			Given tiled value table.
+* \param	idx			Index of the tile.
+* \param	advice			Advice for madvise(2).
+*/
+static void	WlzTiledValuesTileAdvise(WlzTiledValues *tVal, size_t idx,
+				         int advice)
+{
+  size_t	gSz,
+  		pgSz;
+  WlzUByte	*p0,
+  		*p1;
+
+  gSz = WlzGreySize(WlzGreyTableTypeToGreyType(tVal->type, NULL));
+  pgSz = (size_t )sysconf(_SC_PAGESIZE);
+  p0 = tVal->tiles.ubp + (idx * tVal->tileSz * gSz);
+  p1 = p0 + (tVal->tileSz * gSz);
+  p0 = (WlzUByte *)((((size_t )p0 + pgSz - 1) / pgSz) * pgSz);
+  p1 = (WlzUByte *)(((size_t )p1 / pgSz) * pgSz);
+  if(p1 > p0)
+  {
+    (void )madvise(p0, p1 - p0, advice);
+  }
+}
+#endif /* WLZ_USE_MMAP */
+
 /*!
 * \return	New tiled object or NULL on error.
 * \ingroup	WlzAllocation
@@ -279,7 +1688,11 @@ int		WlzTiledValuesMode(WlzTiledValues *tv, WlzErrorNum *dstErr)
   else
   {
 #ifdef WLZ_USE_MMAP
-    if((tv->fd < 0) && (tv->tiles.v != NULL))
+    if(tv->cTiles != NULL)
+    {
+      flags = WLZ_IOFLAGS_READ;
+    }
+    else if((tv->fd < 0) && (tv->tiles.v != NULL))
     {
       flags = WLZ_IOFLAGS_READ | WLZ_IOFLAGS_WRITE;
     }
@@ -423,14 +1836,17 @@ void		WlzTiledValueBufferFlush(WlzTiledValueBuffer *tvb,
       to = kol % tv->tileWidth;
       io = tvb->lo + to;
       ii = *(tv->indices + tvb->li + ti);
-      if(ii > 0)
+      rmn = tvb->kl[1] - kol + 1;
+      itc = tv->tileWidth - to;
+      if(itc > rmn)
+      {
+	itc = rmn;
+      }
+      /* Values are not written to tiles which can't be decoded. */
+      if((ii < tv->numTiles) &&
+         ((tv->cache == NULL) ||
+	  (WlzTiledValuesCacheTouch(tv, ii) == WLZ_ERR_NONE)))
       {
-	rmn = tvb->kl[1] - kol + 1;
-	itc = tv->tileWidth - to;
-	if(itc > rmn)
-	{
-	  itc = rmn;
-	}
 	switch(tvb->gtype)
 	{
 	  case WLZ_GREY_LONG:
@@ -527,6 +1943,10 @@ void		WlzTiledValueBufferFlush(WlzTiledValueBuffer *tvb,
 	  default:
 	    break;
 	}
+	if(tv->cache)
+	{
+	  WlzTiledValuesCacheRelease(tv, ii);
+	}
       }
       kol += itc;
     }
@@ -582,6 +2002,12 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
       }
       io = tvb->lo + to[0];
       ii = *(tv->indices + tvb->li + ti[0]);
+      if((ii >= 0) && tv->cache &&
+         (WlzTiledValuesCacheTouch(tv, ii) != WLZ_ERR_NONE))
+      {
+	/* The tile can't be decoded so use the background value. */
+        ii = -1;
+      }
       switch(tvb->gtype)
       {
 	case WLZ_GREY_LONG:
@@ -755,6 +2181,10 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 	default:
 	  break;
       }
+      if((ii >= 0) && tv->cache)
+      {
+	WlzTiledValuesCacheRelease(tv, ii);
+      }
       kol += itc;
     }
   }
@@ -3026,6 +3026,97 @@ typedef struct _WlzIndexedValues
   AlcVector     *values;                /*!< The indexed values. */
 } WlzIndexedValues;
 
+/*!
+* \enum		_WlzTiledCompression
+* \ingroup	WlzType
+* \brief	Compression of the tiles of a tiled value table.
+*		Typedef: ::WlzTiledCompression.
+*/
+typedef enum _WlzTiledCompression
+{
+  WLZ_TILED_COMPRESS_NONE = 0,		/*!< Tiles are not compressed. */
+  WLZ_TILED_COMPRESS_DELTA_RLE = 1	/*!< Each tile is compressed
+  					     independently by taking the
+					     differences between successive
+					     values, grouping the bytes of
+					     the differences by significance
+					     and then run length encoding
+					     them. */
+} WlzTiledCompression;
+
+/*!
+* \struct	_WlzTiledCTile
+* \ingroup	WlzType
+* \brief	The state of a single compressed tile of a tiled value
+* 		table with compressed tiles.
+*		Typedef: ::WlzTiledCTile.
+*
+* 		A tile is valid when it has been decoded into the tiles
+* 		of the value table. Each tile has a lock which is held
+* 		while it is being decoded, or while it is being written
+* 		back after it has been evicted from the value table's
+* 		cache (see WlzTiledValues::cTileLock). When a tile is
+* 		written back it is compressed again and if it has been
+* 		modified the new compressed tile replaces the original.
+* 		A tile is in use from when it is touched until it is
+* 		released (see WlzTiledValuesCacheTouch() and
+* 		WlzTiledValuesCacheRelease()) and is not written back
+* 		while it is in use.
+*/
+typedef struct _WlzTiledCTile
+{
+  unsigned char	valid;			/*!< Non-zero if the tile has been
+  					     decoded. */
+  unsigned char	evicted;		/*!< Non-zero if the tile has been
+  					     evicted from the cache and is
+					     waiting to be written back and
+					     released. */
+  unsigned int	use;			/*!< Number of current uses of the
+  					     tile. */
+  size_t	sz;			/*!< Size of the written back
+  					     compressed tile. */
+  WlzUByte	*data;			/*!< The written back compressed
+  					     tile, NULL if the tile has not
+					     been modified. */
+} WlzTiledCTile;
+
+/*!
+* \struct	_WlzTiledValuesCache
+* \ingroup	WlzType
+* \brief	A bounded least recently used cache for the tiles of
+* 		one or more memory mapped tiled value tables.
+*		Typedef: ::WlzTiledValuesCache.
+*
+* 		Tiles are entered into the cache as they are accessed
+* 		and when the total size of the cached tiles would exceed
+* 		the maximum size the least recently used tiles are
+* 		evicted, releasing their pages. The counters may be read
+* 		to monitor the cache's effectiveness.
+*/
+typedef struct _WlzTiledValuesCache
+{
+  int		linkcount;		/*!< Link count, incremented for each
+  					     tiled value table using the
+					     cache. */
+  size_t	hits;			/*!< Number of tile accesses for
+  					     tiles already in the cache. */
+  size_t	misses;			/*!< Number of tile accesses for
+  					     tiles not in the cache. */
+  size_t	evictions;		/*!< Number of tiles removed from
+  					     the cache. */
+#ifndef WLZ_EXT_BIND
+  AlcLRUCache	*lru;			/*!< Cache of the tiles, with the
+  					     cache size being the total
+					     size (bytes) of the cached
+					     tiles. */
+#else
+  void		*lru;
+#endif
+  void		*evicted;		/*!< List of evicted compressed tiles
+  					     waiting to be written back and
+					     released. */
+} WlzTiledValuesCache;
+
 /*!
 * \struct       _WlzTiledValues
 * \ingroup      WlzType
@@ -3077,6 +3168,14 @@ typedef struct _WlzIndexedValues
 * 		the file was opened in write or append mode. The function
 * 		WlzTiledValuesMode() may also be used to determine the
 * 		appropriate access mode(s) for the values table.
+*
+* 		The tiles may instead be held compressed (see
+* 		::WlzTiledCompression), in which case each tile is decoded
+* 		when it is first accessed and the number of decoded tiles
+* 		held in memory is bounded by the value table's tile cache.
+* 		Decoded tiles which are evicted from the cache are
+* 		compressed again, so that any changes to their values
+* 		are kept.
 */
 typedef struct _WlzTiledValues
 {
@@ -3110,6 +3209,29 @@ typedef struct _WlzTiledValues
   					     file to the tiles. This may be
 					     set even if not memory mapped. */
   WlzGreyP 	tiles;			/*!< The tiles. */
+  WlzTiledValuesCache *cache;		/*!< Optional tile cache for
+  					     memory mapped tiles, NULL
+					     if the tiles are not cached. */
+  WlzTiledCompression compression;	/*!< Compression used for the
+  					     tiles when they are written
+					     to a file. */
+  size_t	*cTileOff;		/*!< Offsets of the compressed tiles
+  					     within the compressed tile data,
+					     with numTiles + 1 entries. NULL
+					     unless the tiles are held
+					     compressed and decoded when
+					     accessed. */
+  WlzUByte	*cTiles;		/*!< Compressed tile data, NULL
+  					     unless the tiles are held
+					     compressed. */
+  WlzTiledCTile	*cTileState;		/*!< State of each of the compressed
+  					     tiles, NULL unless the tiles are
+					     held compressed. */
+  void		*cTileLock;		/*!< Locks (omp_lock_t) for each of
+  					     the compressed tiles, NULL
+					     unless the tiles are held
+					     compressed and OpenMP is
+					     used. */
 } WlzTiledValues;
 
 /*!
@@ -4196,6 +4318,44 @@ typedef union _WlzCMeshP
   WlzCMesh3D	*m3;
 } WlzCMeshP;
 
+/*!
+* \struct	_WlzCMeshSnapshot
+* \ingroup	WlzMesh
+* \brief	A compact read-only snapshot of a 2D or 3D conforming
+* 		mesh with the node positions held as contiguous
+* 		coordinate arrays, the element nodes as arrays of node
+* 		indices and the node adjacency in compressed sparse row
+* 		form. Nodes and elements are indexed by their mesh
+* 		indices. See WlzCMeshSnapshotMake().
+* 		Typedef: ::WlzCMeshSnapshot.
+*/
+typedef struct _WlzCMeshSnapshot
+{
+  WlzObjectType	type;			/*!< Type of the mesh snapshot,
+  					     either WLZ_CMESH_2D or
+					     WLZ_CMESH_3D. */
+  int		nNod;			/*!< Number of node entries, ie the
+  					     maximum node index + 1. */
+  int		nElm;			/*!< Number of element entries, ie
+  					     the maximum element index + 1. */
+  int		nElmNod;		/*!< Number of nodes per element,
+  					     3 for 2D and 4 for 3D. */
+  double	*pos[3];		/*!< Node column, line and (3D only)
+  					     plane coordinates, each an
+					     array of nNod values. */
+  unsigned int	*nodFlags;		/*!< Node flags. */
+  WlzUByte	*nodValid;		/*!< Non-zero for valid nodes and
+  					     zero for deleted nodes. */
+  int		*nbrOff;		/*!< Offsets into the neighbour
+  					     array, nNod + 1 values. */
+  int		*nbr;			/*!< Neighbour node indices, one for
+  					     each edge use directed from
+					     the node. */
+  int		*elmNod;		/*!< Element node indices, nElmNod
+  					     for each element, -1 for
+					     deleted elements. */
+} WlzCMeshSnapshot;
+
 /************************************************************************
 * Functions
 ************************************************************************/
@@ -4231,6 +4391,9 @@ typedef enum _WlzFnType
   WLZ_FN_SCALAR_SQRT,		        /*!< Square root (x^-1/2). */
   WLZ_FN_SCALAR_INVSQRT,		/*!< Inverse square root (x^-1/2). */
   WLZ_FN_SCALAR_SQR,			/*!< Square (x * x). */
+  WLZ_FN_BASIS_2DCS,			/*!< Compactly supported (Wendland)
+  					     basis function. */
+  WLZ_FN_BASIS_3DCS,
   WLZ_FN_COUNT				/*!< Not a function but the number
   					     of functions. Keep this the
 					     last of the enums! */
@@ -4335,8 +4498,103 @@ typedef struct _WlzBasisFn
 					     Athough the number of control
 					     points may vary the number of
 					     mesh nodes must remain constant. */
+  double	evalTol;		/*!< If greater than zero, the
+  					     absolute error which is
+					     permitted when the basis function
+					     is evaluated for arrays of
+					     vertices, allowing clusters of
+					     distant control points to be
+					     approximated using a
+					     ::WlzBasisFnTree. If zero all
+					     control points are evaluated
+					     exactly. */
+  struct _WlzBasisFnTree *evalTree;	/*!< Basis function tree made when
+  					     the basis function is first
+					     evaluated with a non-zero
+					     evaluation tolerance, it is
+					     freed with the basis function
+					     and may be NULL. */
 } WlzBasisFn;
 
+/*!
+* \struct	_WlzBasisFnTreeNode
+* \ingroup	WlzFunction
+* \brief	A node of a basis function tree. Each node represents
+*		a cluster of control points by an enclosing sphere,
+*		with the moments of the cluster's basis function
+*		coefficients about the sphere's centre held by the tree.
+*		Typedef: ::WlzBasisFnTreeNode.
+*/
+typedef struct _WlzBasisFnTreeNode
+{
+  int		idx[2];			/*!< Index of the node's first control
+  					     point and one past its last
+					     control point in the tree's
+					     control point arrays. */
+  int		child[2];		/*!< Indices of the child nodes, both
+  					     are -1 for leaf nodes. */
+  double	rad;			/*!< Radius of the enclosing sphere. */
+  double	cen[3];			/*!< Centre of the enclosing sphere. */
+  double	wAbs;			/*!< Sum of the maximum absolute
+  					     coefficient components. */
+  double	wRadN;			/*!< Sum of the maximum absolute
+  					     coefficient components multiplied
+					     by the control point distances
+					     from the centre raised to the
+					     power of the expansion order
+					     plus one. */
+  double	accDist;		/*!< Minimum distance between a vertex
+  					     and the enclosing sphere for
+					     which the node's expansion is
+					     within its share of the error
+					     tolerance. */
+} WlzBasisFnTreeNode;
+
+/*!
+* \struct	_WlzBasisFnTree
+* \ingroup	WlzFunction
+* \brief	A binary space partitioning tree of the control points of
+*		a radial basis function, used to evaluate the basis
+*		function to within a given absolute error by approximating
+*		the contribution of clusters of distant control points
+*		using Taylor expansions about the cluster centres.
+*		Typedef: ::WlzBasisFnTree.
+*/
+typedef struct _WlzBasisFnTree
+{
+  WlzFnType	type;			/*!< The basis function type. */
+  int		dim;			/*!< Dimension, 2 or 3. */
+  int		order;			/*!< Order of the expansions. */
+  int		nTerm;			/*!< Number of expansion terms. */
+  int		nPts;			/*!< Number of control points. */
+  int		nNod;			/*!< Number of nodes, with the root
+  					     node first. */
+  double	delta;			/*!< Basis function parameter, unused
+  					     for thin plate splines. */
+  double	tol;			/*!< Absolute error tolerance. */
+  double	poly[12];		/*!< Reduced polynomial coefficients,
+  					     with index 3 * i + j for term i
+					     (constant, x, y, z) and component
+					     j. */
+  int		*trm;			/*!< Expansion terms, with four values
+  					     for each: the x, y and z exponents
+					     of the term's monomial and the
+					     power of the squared distance. */
+  double	*trmK;			/*!< Constant factor of each term. */
+  double	*pts;			/*!< Control points, ordered so that
+  					     those of each node are contiguous,
+					     with the x coordinates of all the
+					     points followed by the y and then
+					     the z coordinates. */
+  double	*wts;			/*!< Basis function coefficients in the
+  					     same order and layout as the
+					     control points. */
+  double	*mom;			/*!< Moments of the coefficients, with
+  					     dim values for each term of each
+					     node. */
+  WlzBasisFnTreeNode *nod;		/*!< Array of nodes. */
+} WlzBasisFnTree;
+
 /*!
 * \struct	_WlzThreshCbStr
 * \ingroup	WlzType
@@ -4759,6 +5017,27 @@ typedef struct _WlzIntervalWSpace
   					     workspace. */
 } WlzIntervalWSpace;
 
+/*!
+* \struct	_WlzIntervalScanPart
+* \ingroup      WlzAccess
+* \brief	A part of an object's interval domain which may be scanned
+*		independently of the object's other parts. A part is a
+*		contiguous range of lines within a single plane, so that
+*		the parts of an object may be scanned in parallel, each
+*		with it's own interval and grey workspaces.
+*		See WlzMakeIntervalScanParts().
+*		Typedef: ::WlzIntervalScanPart.
+*/
+typedef struct _WlzIntervalScanPart
+{
+  int		plane;			/*!< Plane of the part, always zero
+  					     for 2D objects. */
+  int		line0;			/*!< First line of the part. */
+  int		line1;			/*!< Last line of the part. */
+  int		nItv;			/*!< Number of intervals in the
+  					     part. */
+} WlzIntervalScanPart;
+
 /************************************************************************
 * Standard workspace for grey value table manipulations 		
 ************************************************************************/
@@ -4878,8 +5157,40 @@ typedef struct _WlzGreyValueWSpace
 					     which values are background.
 					     Value is 0 if there are no
 					     background values. */
+  int		nTile;			/*!< Number of tiles of a tiled
+  					     value table which are in use
+					     by the grey pointers. */
+  size_t	tile[8];		/*!< Indices of the tiles in use by
+  					     the grey pointers, which are
+					     released by the next access or
+					     when the work space is freed. */
+  struct _WlzGreyValueWSpace *parent;	/*!< Work space from which this
+  					     work space was cloned, in which
+					     case gTabTypes3D and invTrans
+					     are shared with (and owned by)
+					     the parent. NULL if not a
+					     clone. */
 } WlzGreyValueWSpace;
 
+/*!
+* \struct	_WlzGreyValueWSpPool
+* \ingroup	WlzAccess
+* \brief	A pool of grey value work spaces for concurrent random
+* 		access to the grey values of an object, with one work
+* 		space per thread. The work spaces are clones of a single
+* 		shared work space, so the per thread set up cost is small.
+*		Typedef: ::WlzGreyValueWSpPool.
+*/
+typedef struct _WlzGreyValueWSpPool
+{
+  int		nWSp;			/*!< Number of per thread work
+  					     spaces. */
+  WlzGreyValueWSpace *shared;		/*!< Shared work space from which
+  					     the per thread work spaces
+					     are cloned. */
+  WlzGreyValueWSpace **wSp;		/*!< Per thread work spaces. */
+} WlzGreyValueWSpPool;
+
 /************************************************************************
 * File I/O flags
 ************************************************************************/
@@ -5222,6 +5533,42 @@ typedef struct _WlzThreeDViewStruct
 					  voxel size rescaling */
 } WlzThreeDViewStruct;
 
+/*!
+* \struct	_WlzSectionCache
+* \ingroup	WlzSectionTransform
+* \brief	A cache of sections cut from 3D objects, see
+* 		WlzSectionCacheGet(). Sections are keyed by the object
+* 		they were cut from, the interpolation and the view
+* 		parameters, with the angles, distance, fixed point and
+* 		scale quantised. The total size of the cached sections
+* 		is limited, with the least recently used sections being
+* 		evicted as required.
+*		Typedef: ::WlzSectionCache.
+*/
+typedef struct _WlzSectionCache
+{
+  int		linkcount;		/*!< Link count. */
+  double	angQ;			/*!< Quantum for the view angles
+  					     theta, phi and zeta (radians). */
+  double	distQ;			/*!< Quantum for the view distance
+  					     and fixed point. */
+  double	scaleQ;			/*!< Quantum for the view scale. */
+  size_t	hits;			/*!< Number of sections found in the
+  					     cache. */
+  size_t	misses;			/*!< Number of sections not found
+  					     in the cache. */
+  size_t	evictions;		/*!< Number of sections removed from
+  					     the cache. */
+#ifndef WLZ_EXT_BIND
+  AlcLRUCache	*lru;			/*!< Cache of the sections, with the
+  					     cache size being the total
+					     size (bytes) of the cached
+					     sections. */
+#else
+  void		*lru;
+#endif
+} WlzSectionCache;
+
 /*!
 * \typedef	WlzProjectIntMode
 * \ingroup	WlzTransform
@@ -5236,6 +5583,20 @@ typedef enum	_WlzProjectIntMode
   					     dependant density. */
 } WlzProjectIntMode;
 
+/*!
+* \typedef	WlzProjectRayMode
+* \ingroup	WlzTransform
+* \brief	3D to 2D projection modes for projections which combine
+* 		the voxel values along rays, see WlzProjectObjRays().
+*/
+typedef enum	_WlzProjectRayMode
+{
+  WLZ_PROJECT_RAY_MODE_MAX,		/*!< Maximum intensity. */
+  WLZ_PROJECT_RAY_MODE_MIN,		/*!< Minimum intensity. */
+  WLZ_PROJECT_RAY_MODE_MEAN,		/*!< Mean intensity. */
+  WLZ_PROJECT_RAY_MODE_SUM		/*!< Integrated intensity. */
+} WlzProjectRayMode;
+
 /*!
 * \enum         _WlzKrigModelFnType
 * \ingroup      WlzType
@@ -5279,6 +5640,56 @@ typedef struct _WlzKrigModelFn
                                         /*!< Function pointer. */
 } WlzKrigModelFn;
 
+/*!
+* \struct	_WlzLabelStat
+* \ingroup	WlzBinaryOps
+* \brief	Statistics of a single connected component accumulated
+* 		from its labeled intervals, see WlzLabelUFStats(). For 2D objects
+* 		the z coordinates and moments are all zero.
+*		Typedef: ::WlzLabelStat.
+*/
+typedef struct _WlzLabelStat
+{
+  double	vol;			/*!< Area or volume, ie the number
+  					     of pixels or voxels. */
+  WlzIBox3	bBox;			/*!< Bounding box. */
+  WlzDVertex3	cen;			/*!< Centroid (the centre of mass
+  					     ignoring grey values). */
+  double	mom[6];			/*!< Second order central moments
+  					     xx, yy, zz, xy, xz and yz,
+					     each divided by the volume. */
+  double	gMin;			/*!< Minimum grey value. */
+  double	gMax;			/*!< Maximum grey value. */
+  double	gSum;			/*!< Sum of grey values. */
+  double	gSumSq;			/*!< Sum of squared grey values. */
+  double	gMean;			/*!< Mean grey value. */
+  double	gStdDev;		/*!< Standard deviation of the grey
+  					     values as computed by
+					     WlzGreyStats(). */
+} WlzLabelStat;
+
+/*!
+* \struct	_WlzLabelStats
+* \ingroup	WlzBinaryOps
+* \brief	Table of statistics for the connected components of
+* 		a labeled object, indexed by component, see
+* 		WlzLabelUFStats().
+*		Typedef: ::WlzLabelStats.
+*/
+typedef struct _WlzLabelStats
+{
+  int		nLbl;			/*!< Number of components. */
+  int		grey;			/*!< Non-zero if the grey value
+  					     statistics have been computed. */
+  WlzGreyType	gType;			/*!< Grey type of the labeled object
+  					     if the grey value statistics have
+					     been computed. RGBA values use
+					     their modulus, as in
+					     WlzGreyStats(). */
+  WlzLabelStat	*stat;			/*!< Statistics for each
+  					     component. */
+} WlzLabelStats;
+
 
 #ifndef WLZ_EXT_BIND
 #ifdef  __cplusplus
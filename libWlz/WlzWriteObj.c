@@ -57,7 +57,14 @@ static WlzErrorNum		WlzWriteIntervalDomain(
 				  WlzIntervalDomain *itvl);
 static WlzErrorNum   		WlzWritePlaneDomain(
 				  FILE *fP,
-				  WlzPlaneDomain *planedm);
+				  WlzPlaneDomain *planedm,
+				  int planeIdx);
+static WlzErrorNum		WlzWriteObjFn(
+				  FILE *fP,
+				  WlzObject *obj,
+				  int planeIdx);
+static size_t			WlzIntervalDomainFileSz(
+				  WlzIntervalDomain *iDom);
 static WlzErrorNum		WlzWritePropertyList(
 				  FILE *fP,
 				  WlzPropertyList *pList);
@@ -88,7 +95,8 @@ static WlzErrorNum		WlzWriteHistogramDomain(
 				  WlzHistogramDomain *hist);
 static WlzErrorNum		WlzWriteCompoundA(
 				  FILE *fP,
-				  WlzCompoundArray *c);
+				  WlzCompoundArray *c,
+				  int planeIdx);
 static WlzErrorNum		WlzWriteAffineTransform(
 				  FILE *fP,
 				  WlzAffineTransform *trans);
@@ -345,6 +353,41 @@ static int putdouble(double d, FILE *fP)
 * \param    	obj			Ptr to top-level object to be written.
 */
 WlzErrorNum	WlzWriteObj(FILE *fP, WlzObject *obj)
+{
+  return(WlzWriteObjFn(fP, obj, 0));
+}
+
+/*!
+* \return       Woolz error number code.
+* \ingroup      WlzIO
+* \brief        Writes an object to a file stream in the same way as
+* 		WlzWriteObj() but with a plane index for any 3D domain
+* 		objects which have an interval plane domain.
+*
+* 		The plane index records the number of bytes used to store
+* 		each plane's interval domain. It is written in place of
+* 		the (unused) plane positions of the plane domain so files
+* 		with a plane index remain readable by any version of
+* 		WlzReadObj(). When a plane index is present WlzReadObj()
+* 		may use it to read the planes of the object concurrently.
+* \param    	fP			File pointer for output.
+* \param    	obj			Ptr to top-level object to be written.
+*/
+WlzErrorNum	WlzWriteObjIndexed(FILE *fP, WlzObject *obj)
+{
+  return(WlzWriteObjFn(fP, obj, 1));
+}
+
+/*!
+* \return       Woolz error number code.
+* \ingroup      WlzIO
+* \brief        Writes an object to a file stream, optionally with plane
+* 		indices (see WlzWriteObjIndexed()).
+* \param    	fP			File pointer for output.
+* \param    	obj			Ptr to top-level object to be written.
+* \param	planeIdx		Write plane indices if non-zero.
+*/
+static WlzErrorNum WlzWriteObjFn(FILE *fP, WlzObject *obj, int planeIdx)
 {
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
@@ -396,7 +439,7 @@ WlzErrorNum	WlzWriteObj(FILE *fP, WlzObject *obj)
 	}
 	break;
       case WLZ_3D_DOMAINOBJ:
-	errNum = WlzWritePlaneDomain(fP, obj->domain.p);
+	errNum = WlzWritePlaneDomain(fP, obj->domain.p, planeIdx);
 	if(errNum == WLZ_ERR_NONE)
         {
 	  if((obj->values.core == NULL) ||
@@ -417,7 +460,8 @@ WlzErrorNum	WlzWriteObj(FILE *fP, WlzObject *obj)
       case WLZ_TRANS_OBJ:
 	if(((errNum = WlzWriteAffineTransform(fP,
 				obj->domain.t)) == WLZ_ERR_NONE) &&
-	   ((errNum = WlzWriteObj(fP, obj->values.obj)) == WLZ_ERR_NONE))
+	   ((errNum = WlzWriteObjFn(fP, obj->values.obj,
+	                            planeIdx)) == WLZ_ERR_NONE))
 	{
 	  errNum = WlzWritePropertyList(fP, obj->plist);
 	}
@@ -482,7 +526,7 @@ WlzErrorNum	WlzWriteObj(FILE *fP, WlzObject *obj)
 	break;
       case WLZ_COMPOUND_ARR_1: /* FALLTHROUGH */
       case WLZ_COMPOUND_ARR_2:
-	errNum = WlzWriteCompoundA(fP, (WlzCompoundArray *)obj);
+	errNum = WlzWriteCompoundA(fP, (WlzCompoundArray *)obj, planeIdx);
 	break;
       case WLZ_PROPERTY_OBJ:
 	errNum = WlzWritePropertyList(fP, obj->plist);
@@ -1064,14 +1108,51 @@ static WlzErrorNum WlzWriteIntervalDomain(FILE *fP, WlzIntervalDomain *itvl)
   return(errNum);
 }
 
+/*!
+* \return	Number of bytes.
+* \ingroup	WlzIO
+* \brief	Computes the number of bytes that WlzWriteIntervalDomain()
+* 		will write for the given interval domain.
+* \param	iDom			Given interval domain, may be NULL.
+*/
+static size_t	WlzIntervalDomainFileSz(WlzIntervalDomain *iDom)
+{
+  size_t	sz = 1;
+
+  if(iDom != NULL)
+  {
+    sz += 4 * 4;
+    if(iDom->type == WLZ_INTERVALDOMAIN_INTVL)
+    {
+      int	l,
+      		nLn;
+
+      nLn = iDom->lastln - iDom->line1 + 1;
+      sz += 4 * nLn;
+      for(l = 0; l < nLn; ++l)
+      {
+        sz += 8 * iDom->intvlines[l].nintvs;
+      }
+    }
+  }
+  return(sz);
+}
+
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzIO
 * \brief	Writes a plane domain to the given file.
+* 		If a plane index is requested and the plane domain is
+* 		an interval plane domain, then the size in bytes of each
+* 		plane's interval domain as written to the file is written
+* 		(negated) in place of the plane positions (see
+* 		WlzWriteObjIndexed()).
 * \param	fP			Given file.
 * \param	planedm			Palne domain.
+* \param	planeIdx		Write a plane index if non-zero.
 */
-static WlzErrorNum WlzWritePlaneDomain(FILE *fP, WlzPlaneDomain *planedm)
+static WlzErrorNum WlzWritePlaneDomain(FILE *fP, WlzPlaneDomain *planedm,
+				       int planeIdx)
 {
   int		i,
   		nplanes;
@@ -1103,14 +1184,49 @@ static WlzErrorNum WlzWritePlaneDomain(FILE *fP, WlzPlaneDomain *planedm)
     }
     else
     {
-      /* write dummy values of plane positions for backward
-	 compatibility - should go on file-format revision */
       nplanes = planedm->lastpl - planedm->plane1 + 1;
-      for(i = 0; (i < nplanes) && (errNum == WLZ_ERR_NONE); i++)
+      if(planeIdx && (planedm->type == WLZ_PLANEDOMAIN_DOMAIN))
       {
-	if(!putfloat(dummy_float, fP))
+        /* Check that all the plane sizes can be represented, if not
+	 * then no plane index is written. */
+	domains = planedm->domains;
+	for(i = 0; i < nplanes; i++)
 	{
-	  errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	  if(WlzIntervalDomainFileSz(domains[i].i) > INT_MAX)
+	  {
+	    planeIdx = 0;
+	    break;
+	  }
+	}
+      }
+      else
+      {
+        planeIdx = 0;
+      }
+      if(planeIdx)
+      {
+	/* write the plane index in place of the unused plane positions,
+	   the sizes are negated so that they can not be mistaken for
+	   the dummy plane positions written by earlier versions */
+	domains = planedm->domains;
+	for(i = 0; (i < nplanes) && (errNum == WLZ_ERR_NONE); i++)
+	{
+	  if(!putword(-(int )WlzIntervalDomainFileSz(domains[i].i), fP))
+	  {
+	    errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	  }
+	}
+      }
+      else
+      {
+	/* write dummy values of plane positions for backward
+	   compatibility - should go on file-format revision */
+	for(i = 0; (i < nplanes) && (errNum == WLZ_ERR_NONE); i++)
+	{
+	  if(!putfloat(dummy_float, fP))
+	  {
+	    errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	  }
 	}
       }
     }
@@ -2003,8 +2119,10 @@ static WlzErrorNum WlzWriteHistogramDomain(FILE *fP, WlzHistogramDomain *hist)
 * \brief	Writes a compound array object to the given file.
 * \param	fP			Given file.
 * \param	c			Compound array object.
+* \param	planeIdx		Write plane indices if non-zero.
 */
-static WlzErrorNum WlzWriteCompoundA(FILE *fP, WlzCompoundArray *c)
+static WlzErrorNum WlzWriteCompoundA(FILE *fP, WlzCompoundArray *c,
+				     int planeIdx)
 {
   int 		i;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -2028,7 +2146,7 @@ static WlzErrorNum WlzWriteCompoundA(FILE *fP, WlzCompoundArray *c)
       }
       else
       {
-	errNum = WlzWriteObj(fP, c->o[i]);
+	errNum = WlzWriteObjFn(fP, c->o[i], planeIdx);
       }
     }
   }
@@ -2236,7 +2354,7 @@ static WlzErrorNum WlzWrite3DWarpTrans(FILE *fP, Wlz3DWarpTrans *obj)
   {
     errNum = WLZ_ERR_WRITE_INCOMPLETE;
   }
-  else if(!WlzWritePlaneDomain(fP, obj->pdom))
+  else if(!WlzWritePlaneDomain(fP, obj->pdom, 0))
   {
     errNum = WLZ_ERR_WRITE_INCOMPLETE;
   }
@@ -3327,6 +3445,10 @@ static WlzErrorNum WlzWriteIndexedValues(FILE *fP, WlzObject *obj)
 * \param	fP			Given file pointer.
 * \param	obj			Object with an tiled value table
 * 					that's to be written to the file.
+* 		If the value table has a compression set and has tiles
+* 		then the tiles are written compressed, with the compression
+* 		encoded in the high bits of the dimension byte and the
+* 		compressed size of each tile preceding the compressed tiles.
 * \param	writeTiles		Write tiles even if no tiles are
 * 					allocated for the valuetable.
 */
@@ -3334,6 +3456,7 @@ static WlzErrorNum WlzWriteTiledValueTable(FILE *fP, WlzObject *obj,
 					   int writeTiles)
 {
   long		tMrk;
+  WlzTiledCompression cmp = WLZ_TILED_COMPRESS_NONE;
   WlzGreyType   gType;
   WlzTiledValues *tVal = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -3349,7 +3472,11 @@ static WlzErrorNum WlzWriteTiledValueTable(FILE *fP, WlzObject *obj,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    putc(tVal->dim, fP);
+    if(tVal->tiles.v != NULL)
+    {
+      cmp = tVal->compression;
+    }
+    putc(tVal->dim | (cmp << 4), fP);
     putword(tVal->kol1, fP);
     putword(tVal->lastkl, fP);
     putword(tVal->line1, fP);
@@ -3399,7 +3526,55 @@ static WlzErrorNum WlzWriteTiledValueTable(FILE *fP, WlzObject *obj,
 
     gSz = WlzGreySize(gType);
     tSz = tVal->numTiles * tVal->tileSz;
-    if(tVal->tiles.v != NULL)
+    if(cmp != WLZ_TILED_COMPRESS_NONE)
+    {
+      size_t	*cOff;
+      WlzUByte	*cTiles;
+
+      /* Compressed tiles are compressed again from any decoded tiles,
+       * since their values may have been modified. */
+      errNum = WlzTiledValuesCompress(tVal, cmp, &cOff, &cTiles);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	size_t	idx;
+
+	for(idx = 0; idx < tVal->numTiles; ++idx)
+	{
+	  putword((unsigned int )(cOff[idx + 1] - cOff[idx]), fP);
+	}
+	if(fwrite(cTiles, 1, cOff[tVal->numTiles], fP) !=
+	   cOff[tVal->numTiles])
+	{
+	  errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	}
+	AlcFree(cOff);
+	AlcFree(cTiles);
+      }
+    }
+    else if(tVal->cTiles != NULL)
+    {
+      size_t	idx;
+
+      /* Compressed tiles are decoded one at a time as they are written. */
+      for(idx = 0; idx < tVal->numTiles; ++idx)
+      {
+        if((errNum = WlzTiledValuesCacheTouch(tVal, idx)) != WLZ_ERR_NONE)
+	{
+	  break;
+	}
+	if(fwrite(tVal->tiles.ubp + (idx * tVal->tileSz * gSz),
+	          gSz, tVal->tileSz, fP) != tVal->tileSz)
+	{
+	  errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	}
+	WlzTiledValuesCacheRelease(tVal, idx);
+	if(errNum != WLZ_ERR_NONE)
+	{
+	  break;
+	}
+      }
+    }
+    else if(tVal->tiles.v != NULL)
     {
       if(fwrite(tVal->tiles.v, gSz, tSz, fP) != tSz)
       {